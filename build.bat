@@ -100,9 +100,14 @@ if not "%no_meta%"=="1" (
 :: --- Build Everything (@build_targets) --------------------------------------
 pushd build
 if "%raddbg%"=="1"                     set didbuild=1 && %compile%             ..\src\raddbg\raddbg_main.c                                                  %compile_link% %out%raddbg.exe || exit /b 1
+if "%raddbg_bench%"=="1"               set didbuild=1 && %compile%             ..\src\raddbg_bench\raddbg_bench_main.c                                      %compile_link% %out%raddbg_bench.exe || exit /b 1
+if "%raddbg_agent%"=="1"               set didbuild=1 && %compile%             ..\src\raddbg_agent\raddbg_agent_main.c                                      %compile_link% %out%raddbg_agent.exe || exit /b 1
+if "%test_x64%"=="1"                   set didbuild=1 && %compile%             ..\src\tests\test_x64.c                                                      %compile_link% %out%test_x64.exe || exit /b 1
 if "%rdi_from_pdb%"=="1"               set didbuild=1 && %compile%             ..\src\rdi_from_pdb\rdi_from_pdb_main.c                                      %compile_link% %out%rdi_from_pdb.exe || exit /b 1
 if "%rdi_from_dwarf%"=="1"             set didbuild=1 && %compile%             ..\src\rdi_from_dwarf\rdi_from_dwarf.c                                       %compile_link% %out%rdi_from_dwarf.exe || exit /b 1
 if "%rdi_dump%"=="1"                   set didbuild=1 && %compile%             ..\src\rdi_dump\rdi_dump_main.c                                              %compile_link% %out%rdi_dump.exe || exit /b 1
+if "%rdi_symbolize%"=="1"              set didbuild=1 && %compile%             ..\src\rdi_symbolize\rdi_symbolize_main.c                                    %compile_link% %out%rdi_symbolize.exe || exit /b 1
+if "%rdi_bench%"=="1"                  set didbuild=1 && %compile%             ..\src\rdi_bench\rdi_bench_main.c                                            %compile_link% %out%rdi_bench.exe || exit /b 1
 if "%rdi_breakpad_from_pdb%"=="1"      set didbuild=1 && %compile%             ..\src\rdi_breakpad_from_pdb\rdi_breakpad_from_pdb_main.c                    %compile_link% %out%rdi_breakpad_from_pdb.exe || exit /b 1
 if "%ryan_scratch%"=="1"               set didbuild=1 && %compile%             ..\src\scratch\ryan_scratch.c                                                %compile_link% %out%ryan_scratch.exe || exit /b 1
 if "%cpp_tests%"=="1"                  set didbuild=1 && %compile%             ..\src\scratch\i_hate_c_plus_plus.cpp                                        %compile_link% %out%cpp_tests.exe || exit /b 1
@@ -200,9 +200,14 @@ function build_dll()
 
 cd build
 [[ -n "${raddbg}"                ]] && build_single ../src/raddbg/raddbg_main.c                               raddbg.exe
+[[ -n "${raddbg_bench}"          ]] && build_single ../src/raddbg_bench/raddbg_bench_main.c                   raddbg_bench.exe
+[[ -n "${raddbg_agent}"          ]] && build_single ../src/raddbg_agent/raddbg_agent_main.c                   raddbg_agent.exe
+[[ -n "${test_x64}"              ]] && build_single ../src/tests/test_x64.c                                   test_x64.exe
 [[ -n "${rdi_from_pdb}"          ]] && build_single ../src/rdi_from_pdb/rdi_from_pdb_main.c                   rdi_from_pdb.exe
 [[ -n "${rdi_from_dwarf}"        ]] && build_single ../src/rdi_from_dwarf/rdi_from_dwarf.c                    rdi_from_dwarf.exe
 [[ -n "${rdi_dump}"              ]] && build_single ../src/rdi_dump/rdi_dump_main.c                           rdi_dump.exe
+[[ -n "${rdi_symbolize}"         ]] && build_single ../src/rdi_symbolize/rdi_symbolize_main.c                 rdi_symbolize.exe
+[[ -n "${rdi_bench}"             ]] && build_single ../src/rdi_bench/rdi_bench_main.c                         rdi_bench.exe
 [[ -n "${rdi_breakpad_from_pdb}" ]] && build_single ../src/rdi_breakpad_from_pdb/rdi_breakpad_from_pdb_main.c rdi_breakpad_from_pdb.exe
 [[ -n "${ryan_scratch}"          ]] && build_single ../src/scratch/ryan_scratch.c                             ryan_scratch.exe
 [[ -n "${cpp_tests}"             ]] && build_single ../src/scratch/i_hate_c_plus_plus.cpp                     cpp_tests.exe
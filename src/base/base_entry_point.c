@@ -36,6 +36,9 @@ main_thread_base_entry_point(void (*entry_point)(CmdLine *cmdline), char **argum
 #if defined(DASM_CACHE_H) && !defined(DASM_INIT_MANUAL)
   dasm_init();
 #endif
+#if defined(FLOW_CACHE_H) && !defined(FLOW_INIT_MANUAL)
+  flow_init();
+#endif
 #if defined(DI_H) && !defined(DI_INIT_MANUAL)
   di_init();
 #endif
@@ -51,6 +54,12 @@ main_thread_base_entry_point(void (*entry_point)(CmdLine *cmdline), char **argum
 #if defined(CTRL_CORE_H) && !defined(CTRL_INIT_MANUAL)
   ctrl_init();
 #endif
+#if defined(CTRL_REMOTE_H) && !defined(CTRL_REMOTE_INIT_MANUAL)
+  ctrl_remote_init();
+#endif
+#if defined(LINK_CACHE_H) && !defined(LNK_INIT_MANUAL)
+  lnk_init();
+#endif
 #if defined(OS_GRAPHICAL_H) && !defined(OS_GFX_INIT_MANUAL)
   os_graphical_init();
 #endif
@@ -507,6 +507,255 @@ ctrl_event_from_serialized_string(Arena *arena, String8 string)
   return event;
 }
 
+//- rjf: batched serialization
+
+internal U64
+ctrl_varint_write(U8 *dst, U64 x)
+{
+  U64 size = 0;
+  for(;;)
+  {
+    U8 byte = (U8)(x & 0x7f);
+    x >>= 7;
+    if(x != 0)
+    {
+      byte |= 0x80;
+    }
+    dst[size] = byte;
+    size += 1;
+    if(x == 0)
+    {
+      break;
+    }
+  }
+  return size;
+}
+
+internal U64
+ctrl_varint_read(String8 string, U64 off, U64 *x_out)
+{
+  U64 x = 0;
+  U64 size = 0;
+  for(U64 shift = 0; off+size < string.size && shift < 64; shift += 7)
+  {
+    U8 byte = string.str[off+size];
+    size += 1;
+    x |= (U64)(byte & 0x7f) << shift;
+    if(!(byte & 0x80))
+    {
+      break;
+    }
+  }
+  *x_out = x;
+  return size;
+}
+
+internal void
+ctrl_event_batch_fields_from_event(U64 *fields, CTRL_Event *event)
+{
+  fields[0]  = (U64)event->kind;
+  fields[1]  = (U64)event->cause;
+  fields[2]  = (U64)event->exception_kind;
+  fields[3]  = event->msg_id;
+  fields[4]  = event->machine_id;
+  fields[5]  = event->entity.u64[0];
+  fields[6]  = event->parent.u64[0];
+  fields[7]  = (U64)event->arch;
+  fields[8]  = event->u64_code;
+  fields[9]  = (U64)event->entity_id;
+  fields[10] = event->vaddr_rng.min;
+  fields[11] = event->vaddr_rng.max;
+  fields[12] = event->rip_vaddr;
+  fields[13] = event->stack_base;
+  fields[14] = event->tls_root;
+  fields[15] = event->timestamp;
+  fields[16] = (U64)event->exception_code;
+}
+
+internal void
+ctrl_event_from_event_batch_fields(CTRL_Event *event, U64 *fields)
+{
+  event->kind           = (CTRL_EventKind)fields[0];
+  event->cause          = (CTRL_EventCause)fields[1];
+  event->exception_kind = (CTRL_ExceptionKind)fields[2];
+  event->msg_id         = fields[3];
+  event->machine_id     = fields[4];
+  event->entity.u64[0]  = fields[5];
+  event->parent.u64[0]  = fields[6];
+  event->arch           = (Architecture)fields[7];
+  event->u64_code       = fields[8];
+  event->entity_id      = (U32)fields[9];
+  event->vaddr_rng.min  = fields[10];
+  event->vaddr_rng.max  = fields[11];
+  event->rip_vaddr      = fields[12];
+  event->stack_base     = fields[13];
+  event->tls_root       = fields[14];
+  event->timestamp      = fields[15];
+  event->exception_code = (U32)fields[16];
+}
+
+internal String8
+ctrl_serialized_string_from_event_list(Arena *arena, CTRL_EventNode **first_node_inout, U64 max)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  U8 *buffer = push_array_no_zero(scratch.arena, U8, max);
+  U64 buffer_size = 0;
+  U64 string_slots_count = 1024;
+  CTRL_EventBatchStringNode **string_slots = push_array(scratch.arena, CTRL_EventBatchStringNode *, string_slots_count);
+  U64 strings_count = 0;
+  U64 prev_fields[CTRL_EVENT_BATCH_FIELD_COUNT] = {0};
+  CTRL_EventNode *n = *first_node_inout;
+  for(;n != 0; n = n->next)
+  {
+    CTRL_Event *event = &n->v;
+    
+    //- rjf: encode mask & field deltas
+    U8 header[(CTRL_EVENT_BATCH_FIELD_COUNT+1)*10];
+    U64 header_size = 0;
+    U64 fields[CTRL_EVENT_BATCH_FIELD_COUNT];
+    ctrl_event_batch_fields_from_event(fields, event);
+    U64 mask = 0;
+    for(U64 idx = 0; idx < CTRL_EVENT_BATCH_FIELD_COUNT; idx += 1)
+    {
+      if(fields[idx] != prev_fields[idx])
+      {
+        mask |= (1ull<<idx);
+      }
+    }
+    if(event->string.size != 0)
+    {
+      mask |= CTRL_EVENT_BATCH_HAS_STRING_BIT;
+    }
+    header_size += ctrl_varint_write(header+header_size, mask);
+    for(U64 idx = 0; idx < CTRL_EVENT_BATCH_FIELD_COUNT; idx += 1)
+    {
+      if(mask & (1ull<<idx))
+      {
+        S64 delta = (S64)(fields[idx] - prev_fields[idx]);
+        U64 zigzag = ((U64)delta << 1) ^ (U64)(delta >> 63);
+        header_size += ctrl_varint_write(header+header_size, zigzag);
+      }
+    }
+    
+    //- rjf: encode string reference - (idx<<1) for previously-seen strings,
+    // (idx<<1)|1 followed by size & data for new strings
+    String8 string = event->string;
+    CTRL_EventBatchStringNode *string_node = 0;
+    U64 string_slot_idx = 0;
+    U8 string_header[20];
+    U64 string_header_size = 0;
+    if(string.size != 0)
+    {
+      string_slot_idx = ctrl_hash_from_string(string)%string_slots_count;
+      for(CTRL_EventBatchStringNode *sn = string_slots[string_slot_idx]; sn != 0; sn = sn->next)
+      {
+        if(str8_match(sn->string, string, 0))
+        {
+          string_node = sn;
+          break;
+        }
+      }
+      if(string_node != 0)
+      {
+        string_header_size += ctrl_varint_write(string_header, string_node->idx<<1);
+        string.size = 0;
+      }
+      else
+      {
+        // rjf: clamp string to what can fit in an otherwise-empty batch
+        U64 fixed_size = header_size + 20;
+        if(fixed_size + string.size > max)
+        {
+          string.size = (max > fixed_size ? max - fixed_size : 0);
+        }
+        string_header_size += ctrl_varint_write(string_header, (strings_count<<1)|1);
+        string_header_size += ctrl_varint_write(string_header+string_header_size, string.size);
+      }
+    }
+    
+    //- rjf: doesn't fit -> end batch here
+    U64 event_size = header_size + string_header_size + string.size;
+    if(buffer_size + event_size > max)
+    {
+      break;
+    }
+    
+    //- rjf: commit
+    MemoryCopy(buffer+buffer_size, header, header_size);
+    buffer_size += header_size;
+    MemoryCopy(buffer+buffer_size, string_header, string_header_size);
+    buffer_size += string_header_size;
+    MemoryCopy(buffer+buffer_size, string.str, string.size);
+    buffer_size += string.size;
+    if(event->string.size != 0 && string_node == 0)
+    {
+      string_node = push_array(scratch.arena, CTRL_EventBatchStringNode, 1);
+      string_node->string = event->string;
+      string_node->idx = strings_count;
+      SLLStackPush(string_slots[string_slot_idx], string_node);
+      strings_count += 1;
+    }
+    MemoryCopy(prev_fields, fields, sizeof(fields));
+  }
+  *first_node_inout = n;
+  String8 result = push_str8_copy(arena, str8(buffer, buffer_size));
+  scratch_end(scratch);
+  return result;
+}
+
+internal CTRL_EventList
+ctrl_event_list_from_serialized_string(Arena *arena, String8 string)
+{
+  // NOTE: strings in the resultant events point into `string`, and are
+  // not separately allocated.
+  Temp scratch = scratch_begin(&arena, 1);
+  CTRL_EventList events = {0};
+  U64 strings_cap = string.size/2 + 1;
+  String8 *strings = push_array_no_zero(scratch.arena, String8, strings_cap);
+  U64 strings_count = 0;
+  U64 fields[CTRL_EVENT_BATCH_FIELD_COUNT] = {0};
+  for(U64 off = 0; off < string.size;)
+  {
+    U64 mask = 0;
+    off += ctrl_varint_read(string, off, &mask);
+    for(U64 idx = 0; idx < CTRL_EVENT_BATCH_FIELD_COUNT; idx += 1)
+    {
+      if(mask & (1ull<<idx))
+      {
+        U64 zigzag = 0;
+        off += ctrl_varint_read(string, off, &zigzag);
+        S64 delta = (S64)(zigzag >> 1) ^ -(S64)(zigzag & 1);
+        fields[idx] += (U64)delta;
+      }
+    }
+    CTRL_Event *event = ctrl_event_list_push(arena, &events);
+    ctrl_event_from_event_batch_fields(event, fields);
+    if(mask & CTRL_EVENT_BATCH_HAS_STRING_BIT)
+    {
+      U64 ref = 0;
+      off += ctrl_varint_read(string, off, &ref);
+      if(ref & 1)
+      {
+        U64 size = 0;
+        off += ctrl_varint_read(string, off, &size);
+        event->string = str8_substr(string, r1u64(off, off+size));
+        off += event->string.size;
+        if(strings_count < strings_cap)
+        {
+          strings[strings_count] = event->string;
+          strings_count += 1;
+        }
+      }
+      else if((ref>>1) < strings_count)
+      {
+        event->string = strings[ref>>1];
+      }
+    }
+  }
+  scratch_end(scratch);
+  return events;
+}
+
 ////////////////////////////////
 //~ rjf: Entity Type Functions
 
@@ -807,10 +1056,89 @@ ctrl_entity_child_from_kind(CTRL_Entity *parent, CTRL_EntityKind kind)
 internal void
 ctrl_entity_store_apply_events(CTRL_EntityStore *store, CTRL_EventList *list)
 {
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: determine which string-equipping events are superseded later in
+  // this list - either by a later string for the same entity slot, or by the
+  // entity ending - so that their strings are never allocated in the store.
+  // slot 0 is an entity's own string, slot 1 is its debug info path's.
+  B8 *event_string_is_dead = push_array(scratch.arena, B8, list->count);
+  {
+    typedef struct KeyNode KeyNode;
+    struct KeyNode
+    {
+      KeyNode *next;
+      CTRL_MachineID machine_id;
+      DMN_Handle handle;
+      U64 slot;
+    };
+    CTRL_EventNode **nodes = push_array_no_zero(scratch.arena, CTRL_EventNode *, list->count);
+    {
+      U64 idx = 0;
+      for(CTRL_EventNode *n = list->first; n != 0; n = n->next, idx += 1)
+      {
+        nodes[idx] = n;
+      }
+    }
+    U64 key_slots_count = list->count + 1;
+    KeyNode **key_slots = push_array(scratch.arena, KeyNode *, key_slots_count);
+    for(U64 rev_idx = 0; rev_idx < list->count; rev_idx += 1)
+    {
+      U64 event_idx = list->count - 1 - rev_idx;
+      CTRL_Event *event = &nodes[event_idx]->v;
+      U64 string_slot = max_U64;
+      B32 ends_entity = 0;
+      switch(event->kind)
+      {
+        default:{}break;
+        case CTRL_EventKind_ThreadName:
+        case CTRL_EventKind_NewModule:{string_slot = 0;}break;
+        case CTRL_EventKind_ModuleDebugInfoPathChange:{string_slot = 1;}break;
+        case CTRL_EventKind_EndProc:
+        case CTRL_EventKind_EndThread:
+        case CTRL_EventKind_EndModule:{ends_entity = 1;}break;
+      }
+      if(string_slot != max_U64 || ends_entity)
+      {
+        U64 hash = ctrl_hash_from_machine_id_handle(event->machine_id, event->entity);
+        KeyNode **slot = &key_slots[hash%key_slots_count];
+        for(U64 key_slot = 0; key_slot < 2; key_slot += 1)
+        {
+          if(ends_entity || key_slot == string_slot)
+          {
+            B32 found = 0;
+            for(KeyNode *k = *slot; k != 0; k = k->next)
+            {
+              if(k->machine_id == event->machine_id && dmn_handle_match(k->handle, event->entity) && k->slot == key_slot)
+              {
+                found = 1;
+                break;
+              }
+            }
+            if(found && !ends_entity)
+            {
+              event_string_is_dead[event_idx] = 1;
+            }
+            else if(!found)
+            {
+              KeyNode *k = push_array(scratch.arena, KeyNode, 1);
+              k->machine_id = event->machine_id;
+              k->handle = event->entity;
+              k->slot = key_slot;
+              SLLStackPush(*slot, k);
+            }
+          }
+        }
+      }
+    }
+  }
+  
   //- rjf: scan events & construct entities
-  for(CTRL_EventNode *n = list->first; n != 0; n = n->next)
+  U64 event_idx = 0;
+  for(CTRL_EventNode *n = list->first; n != 0; n = n->next, event_idx += 1)
   {
     CTRL_Event *event = &n->v;
+    B32 string_is_dead = event_string_is_dead[event_idx];
     switch(event->kind)
     {
       default:{}break;
@@ -819,6 +1147,10 @@ ctrl_entity_store_apply_events(CTRL_EntityStore *store, CTRL_EventList *list)
       case CTRL_EventKind_NewProc:
       {
         CTRL_Entity *machine = ctrl_entity_from_machine_id_handle(store, event->machine_id, dmn_handle_zero());
+        if(machine == &ctrl_entity_nil)
+        {
+          machine = ctrl_entity_alloc(store, store->root, CTRL_EntityKind_Machine, event->arch, event->machine_id, dmn_handle_zero(), 0);
+        }
         CTRL_Entity *process = ctrl_entity_alloc(store, machine, CTRL_EntityKind_Process, event->arch, event->machine_id, event->entity, (U64)event->entity_id);
       }break;
       case CTRL_EventKind_EndProc:
@@ -850,20 +1182,24 @@ ctrl_entity_store_apply_events(CTRL_EntityStore *store, CTRL_EventList *list)
       }break;
       case CTRL_EventKind_ThreadName:
       {
-        CTRL_Entity *thread = ctrl_entity_from_machine_id_handle(store, event->machine_id, event->entity);
-        ctrl_entity_equip_string(store, thread, event->string);
+        if(!string_is_dead)
+        {
+          CTRL_Entity *thread = ctrl_entity_from_machine_id_handle(store, event->machine_id, event->entity);
+          ctrl_entity_equip_string(store, thread, event->string);
+        }
       }break;
       
       //- rjf: modules
       case CTRL_EventKind_NewModule:
       {
-        Temp scratch = scratch_begin(0, 0);
         CTRL_Entity *process = ctrl_entity_from_machine_id_handle(store, event->machine_id, event->parent);
         CTRL_Entity *module = ctrl_entity_alloc(store, process, CTRL_EntityKind_Module, event->arch, event->machine_id, event->entity, event->vaddr_rng.min);
-        ctrl_entity_equip_string(store, module, event->string);
+        if(!string_is_dead)
+        {
+          ctrl_entity_equip_string(store, module, event->string);
+        }
         module->timestamp = event->timestamp;
         module->vaddr_range = event->vaddr_rng;
-        scratch_end(scratch);
       }break;
       case CTRL_EventKind_EndModule:
       {
@@ -872,17 +1208,22 @@ ctrl_entity_store_apply_events(CTRL_EntityStore *store, CTRL_EventList *list)
       }break;
       case CTRL_EventKind_ModuleDebugInfoPathChange:
       {
-        CTRL_Entity *module = ctrl_entity_from_machine_id_handle(store, event->machine_id, event->entity);
-        CTRL_Entity *debug_info_path = ctrl_entity_child_from_kind(module, CTRL_EntityKind_DebugInfoPath);
-        if(debug_info_path == &ctrl_entity_nil)
+        if(!string_is_dead)
         {
-          debug_info_path = ctrl_entity_alloc(store, module, CTRL_EntityKind_DebugInfoPath, Architecture_Null, 0, dmn_handle_zero(), 0);
+          CTRL_Entity *module = ctrl_entity_from_machine_id_handle(store, event->machine_id, event->entity);
+          CTRL_Entity *debug_info_path = ctrl_entity_child_from_kind(module, CTRL_EntityKind_DebugInfoPath);
+          if(debug_info_path == &ctrl_entity_nil)
+          {
+            debug_info_path = ctrl_entity_alloc(store, module, CTRL_EntityKind_DebugInfoPath, Architecture_Null, 0, dmn_handle_zero(), 0);
+          }
+          ctrl_entity_equip_string(store, debug_info_path, event->string);
+          debug_info_path->timestamp = event->timestamp;
         }
-        ctrl_entity_equip_string(store, debug_info_path, event->string);
-        debug_info_path->timestamp = event->timestamp;
       }break;
     }
   }
+  
+  scratch_end(scratch);
 }
 
 ////////////////////////////////
@@ -938,6 +1279,10 @@ ctrl_init(void)
     ctrl_state->module_image_info_cache.stripes[idx].arena = arena_alloc();
     ctrl_state->module_image_info_cache.stripes[idx].rw_mutex = os_rw_mutex_alloc();
   }
+  ctrl_state->resolved_user_bp_cache.bp_set_arena = arena_alloc();
+  ctrl_state->resolved_user_bp_cache.arena = arena_alloc();
+  ctrl_state->resolved_user_bp_cache.slots_count = 256;
+  ctrl_state->resolved_user_bp_cache.slots = push_array(ctrl_state->resolved_user_bp_cache.arena, CTRL_ResolvedUserBreakpointCacheNode *, ctrl_state->resolved_user_bp_cache.slots_count);
   ctrl_state->u2c_ring_size = KB(64);
   ctrl_state->u2c_ring_base = push_array_no_zero(arena, U8, ctrl_state->u2c_ring_size);
   ctrl_state->u2c_ring_mutex = os_mutex_alloc();
@@ -989,6 +1334,22 @@ ctrl_set_wakeup_hook(CTRL_WakeupFunctionType *wakeup_hook)
   ctrl_state->wakeup_hook = wakeup_hook;
 }
 
+////////////////////////////////
+//~ rjf: Synthetic Machine Registration
+
+internal void
+ctrl_set_synthetic_machine(CTRL_SyntheticMachine *machine)
+{
+  MemoryCopyStruct(&ctrl_state->synthetic_machine, machine);
+}
+
+internal B32
+ctrl_machine_id_is_synthetic(CTRL_MachineID machine_id)
+{
+  B32 result = (machine_id != 0 && machine_id == ctrl_state->synthetic_machine.machine_id);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Process Memory Functions
 
@@ -1014,7 +1375,7 @@ ctrl_stored_hash_from_process_vaddr_range(CTRL_MachineID machine_id, DMN_Handle
 {
   U128 result = {0};
   U64 size = dim_1u64(range);
-  U64 pre_mem_gen = dmn_mem_gen();
+  U64 pre_mem_gen = ctrl_mem_gen_from_machine_id(machine_id);
   if(size != 0) for(;;)
   {
     CTRL_ProcessMemoryCache *cache = &ctrl_state->process_memory_cache;
@@ -1160,7 +1521,7 @@ ctrl_stored_hash_from_process_vaddr_range(CTRL_MachineID machine_id, DMN_Handle
       break;
     }
   }
-  U64 post_mem_gen = dmn_mem_gen();
+  U64 post_mem_gen = ctrl_mem_gen_from_machine_id(machine_id);
   if(post_mem_gen != pre_mem_gen && out_is_stale)
   {
     out_is_stale[0] = 1;
@@ -1363,6 +1724,49 @@ ctrl_read_cached_process_memory(CTRL_MachineID machine_id, DMN_Handle process, R
   return good;
 }
 
+//- rjf: process memory reading
+
+internal U64
+ctrl_process_read(CTRL_MachineID machine_id, DMN_Handle process, Rng1U64 range, void *dst)
+{
+  U64 result = 0;
+  B32 is_routed = 0;
+  if(ctrl_machine_id_is_synthetic(machine_id))
+  {
+    is_routed = 1;
+    result = ctrl_state->synthetic_machine.read_memory(process, range, dst);
+  }
+#if OS_FEATURE_SOCKET
+  if(!is_routed) OS_MutexScopeR(ctrl_remote_shared->clients_rw_mutex)
+  {
+    CTRL_RemoteClient *client = ctrl_remote_client_from_machine_id__locked(machine_id);
+    if(client != 0)
+    {
+      // rjf: remote reads are bounded per request - read in pieces, stopping
+      // at the first short one
+      is_routed = 1;
+      U64 endt_us = os_now_microseconds() + CTRL_REMOTE_ROUTED_READ_TIMEOUT_US;
+      for(U64 off = 0; range.min+off < range.max;)
+      {
+        U64 chunk_size = Min(range.max-(range.min+off), CTRL_REMOTE_MEM_READ_REQUEST_MAX);
+        U64 read_size = ctrl_remote_client_read_memory(client, process, r1u64(range.min+off, range.min+off+chunk_size), (U8 *)dst+off, endt_us);
+        off += read_size;
+        result = off;
+        if(read_size < chunk_size)
+        {
+          break;
+        }
+      }
+    }
+  }
+#endif
+  if(!is_routed)
+  {
+    result = dmn_process_read(process, range, dst);
+  }
+  return result;
+}
+
 //- rjf: process memory writing
 
 internal B32
@@ -1502,9 +1906,9 @@ ctrl_query_cached_reg_block_from_thread(Arena *arena, CTRL_EntityStore *store, C
     // rjf: copy from node
     if(node)
     {
-      U64 current_reg_gen = dmn_reg_gen();
+      U64 current_reg_gen = ctrl_reg_gen_from_machine_id(machine_id);
       B32 need_stale = 1;
-      if(node->reg_gen != current_reg_gen && dmn_thread_read_reg_block(thread, result))
+      if(node->reg_gen != current_reg_gen && ctrl_thread_read_reg_block(machine_id, thread, result))
       {
         OS_MutexScopeRWPromote(stripe->rw_mutex)
         {
@@ -1536,7 +1940,11 @@ ctrl_query_cached_reg_block_from_thread(Arena *arena, CTRL_EntityStore *store, C
 internal U64
 ctrl_query_cached_tls_root_vaddr_from_thread(CTRL_EntityStore *store, CTRL_MachineID machine_id, DMN_Handle thread)
 {
-  U64 result = dmn_tls_root_vaddr_from_thread(thread);
+  U64 result = 0;
+  if(!ctrl_machine_id_is_synthetic(machine_id))
+  {
+    result = dmn_tls_root_vaddr_from_thread(thread);
+  }
   return result;
 }
 
@@ -1564,6 +1972,44 @@ ctrl_query_cached_rsp_from_thread(CTRL_EntityStore *store, CTRL_MachineID machin
   return result;
 }
 
+//- rjf: thread register reading
+
+internal B32
+ctrl_thread_read_reg_block(CTRL_MachineID machine_id, DMN_Handle thread, void *block)
+{
+  B32 good = 0;
+  B32 is_routed = 0;
+  if(ctrl_machine_id_is_synthetic(machine_id))
+  {
+    is_routed = 1;
+    good = ctrl_state->synthetic_machine.read_reg_block(thread, block);
+  }
+#if OS_FEATURE_SOCKET
+  if(!is_routed) OS_MutexScopeR(ctrl_remote_shared->clients_rw_mutex)
+  {
+    CTRL_RemoteClient *client = ctrl_remote_client_from_machine_id__locked(machine_id);
+    if(client != 0)
+    {
+      Temp scratch = scratch_begin(0, 0);
+      is_routed = 1;
+      Architecture arch = Architecture_Null;
+      void *remote_block = ctrl_remote_client_reg_block_from_thread(scratch.arena, client, thread, &arch, os_now_microseconds() + CTRL_REMOTE_ROUTED_READ_TIMEOUT_US);
+      if(remote_block != 0)
+      {
+        MemoryCopy(block, remote_block, regs_block_size_from_architecture(arch));
+        good = 1;
+      }
+      scratch_end(scratch);
+    }
+  }
+#endif
+  if(!is_routed)
+  {
+    good = dmn_thread_read_reg_block(thread, block);
+  }
+  return good;
+}
+
 //- rjf: thread register writing
 
 internal B32
@@ -2711,6 +3157,62 @@ ctrl_reg_gen(void)
   return result;
 }
 
+internal U64
+ctrl_mem_gen_from_machine_id(CTRL_MachineID machine_id)
+{
+  U64 result = 0;
+  B32 is_routed = 0;
+  if(ctrl_machine_id_is_synthetic(machine_id))
+  {
+    is_routed = 1;
+    result = 1;
+  }
+#if OS_FEATURE_SOCKET
+  if(!is_routed) OS_MutexScopeR(ctrl_remote_shared->clients_rw_mutex)
+  {
+    CTRL_RemoteClient *client = ctrl_remote_client_from_machine_id__locked(machine_id);
+    if(client != 0)
+    {
+      is_routed = 1;
+      result = ctrl_remote_client_gen(client);
+    }
+  }
+#endif
+  if(!is_routed)
+  {
+    result = dmn_mem_gen();
+  }
+  return result;
+}
+
+internal U64
+ctrl_reg_gen_from_machine_id(CTRL_MachineID machine_id)
+{
+  U64 result = 0;
+  B32 is_routed = 0;
+  if(ctrl_machine_id_is_synthetic(machine_id))
+  {
+    is_routed = 1;
+    result = 1;
+  }
+#if OS_FEATURE_SOCKET
+  if(!is_routed) OS_MutexScopeR(ctrl_remote_shared->clients_rw_mutex)
+  {
+    CTRL_RemoteClient *client = ctrl_remote_client_from_machine_id__locked(machine_id);
+    if(client != 0)
+    {
+      is_routed = 1;
+      result = ctrl_remote_client_gen(client);
+    }
+  }
+#endif
+  if(!is_routed)
+  {
+    result = dmn_reg_gen();
+  }
+  return result;
+}
+
 //- rjf: name -> register/alias hash tables, for eval
 
 internal EVAL_String2NumMap *
@@ -2734,31 +3236,73 @@ internal B32
 ctrl_u2c_push_msgs(CTRL_MsgList *msgs, U64 endt_us)
 {
   Temp scratch = scratch_begin(0, 0);
-  String8 msgs_srlzed_baked = ctrl_serialized_string_from_msg_list(scratch.arena, msgs);
-  B32 good = 0;
-  OS_MutexScope(ctrl_state->u2c_ring_mutex) for(;;)
+  B32 good = 1;
+  
+  //- rjf: messages addressed to remote machines -> send to their clients; the
+  // rest go to the local control thread
+  CTRL_MsgList local_msgs = *msgs;
+#if OS_FEATURE_SOCKET
+  OS_MutexScopeR(ctrl_remote_shared->clients_rw_mutex) if(ctrl_remote_shared->first_client != 0)
   {
-    U64 unconsumed_size = (ctrl_state->u2c_ring_write_pos-ctrl_state->u2c_ring_read_pos);
-    U64 available_size = ctrl_state->u2c_ring_size-unconsumed_size;
-    if(available_size >= sizeof(U64) + msgs_srlzed_baked.size)
+    MemoryZeroStruct(&local_msgs);
+    for(CTRL_RemoteClient *client = ctrl_remote_shared->first_client; client != 0; client = client->next)
     {
-      ctrl_state->u2c_ring_write_pos += ring_write_struct(ctrl_state->u2c_ring_base, ctrl_state->u2c_ring_size, ctrl_state->u2c_ring_write_pos, &msgs_srlzed_baked.size);
-      ctrl_state->u2c_ring_write_pos += ring_write(ctrl_state->u2c_ring_base, ctrl_state->u2c_ring_size, ctrl_state->u2c_ring_write_pos, msgs_srlzed_baked.str, msgs_srlzed_baked.size);
-      ctrl_state->u2c_ring_write_pos += 7;
-      ctrl_state->u2c_ring_write_pos -= ctrl_state->u2c_ring_write_pos%8;
-      good = 1;
-      break;
+      CTRL_MsgList client_msgs = {0};
+      for(CTRL_MsgNode *n = msgs->first; n != 0; n = n->next)
+      {
+        if(n->v.machine_id == client->machine_id)
+        {
+          CTRL_Msg *msg = ctrl_msg_list_push(scratch.arena, &client_msgs);
+          MemoryCopyStruct(msg, &n->v);
+        }
+      }
+      if(client_msgs.count != 0 && !ctrl_remote_client_push_msgs(client, &client_msgs))
+      {
+        good = 0;
+      }
     }
-    if(os_now_microseconds() >= endt_us)
+    for(CTRL_MsgNode *n = msgs->first; n != 0; n = n->next)
     {
-      break;
+      if(ctrl_remote_client_from_machine_id__locked(n->v.machine_id) == 0)
+      {
+        CTRL_Msg *msg = ctrl_msg_list_push(scratch.arena, &local_msgs);
+        MemoryCopyStruct(msg, &n->v);
+      }
     }
-    os_condition_variable_wait(ctrl_state->u2c_ring_cv, ctrl_state->u2c_ring_mutex, endt_us);
   }
-  if(good)
+#endif
+  
+  //- rjf: local messages -> write to ring
+  if(local_msgs.count != 0 || msgs->count == 0)
   {
-    os_condition_variable_broadcast(ctrl_state->u2c_ring_cv);
+    String8 msgs_srlzed_baked = ctrl_serialized_string_from_msg_list(scratch.arena, &local_msgs);
+    B32 local_good = 0;
+    OS_MutexScope(ctrl_state->u2c_ring_mutex) for(;;)
+    {
+      U64 unconsumed_size = (ctrl_state->u2c_ring_write_pos-ctrl_state->u2c_ring_read_pos);
+      U64 available_size = ctrl_state->u2c_ring_size-unconsumed_size;
+      if(available_size >= sizeof(U64) + msgs_srlzed_baked.size)
+      {
+        ctrl_state->u2c_ring_write_pos += ring_write_struct(ctrl_state->u2c_ring_base, ctrl_state->u2c_ring_size, ctrl_state->u2c_ring_write_pos, &msgs_srlzed_baked.size);
+        ctrl_state->u2c_ring_write_pos += ring_write(ctrl_state->u2c_ring_base, ctrl_state->u2c_ring_size, ctrl_state->u2c_ring_write_pos, msgs_srlzed_baked.str, msgs_srlzed_baked.size);
+        ctrl_state->u2c_ring_write_pos += 7;
+        ctrl_state->u2c_ring_write_pos -= ctrl_state->u2c_ring_write_pos%8;
+        local_good = 1;
+        break;
+      }
+      if(os_now_microseconds() >= endt_us)
+      {
+        break;
+      }
+      os_condition_variable_wait(ctrl_state->u2c_ring_cv, ctrl_state->u2c_ring_mutex, endt_us);
+    }
+    if(local_good)
+    {
+      os_condition_variable_broadcast(ctrl_state->u2c_ring_cv);
+    }
+    good = (good && local_good);
   }
+  
   scratch_end(scratch);
   return good;
 }
@@ -2798,18 +3342,18 @@ ctrl_c2u_push_events(CTRL_EventList *events)
   if(events->count != 0) ProfScope("ctrl_c2u_push_events")
   {
     ctrl_entity_store_apply_events(ctrl_state->ctrl_thread_entity_store, events);
-    for(CTRL_EventNode *n = events->first; n != 0; n = n ->next)
+    for(CTRL_EventNode *n = events->first; n != 0;)
     {
       Temp scratch = scratch_begin(0, 0);
-      String8 event_srlzed = ctrl_serialized_string_from_event(scratch.arena, &n->v, ctrl_state->c2u_ring_size-sizeof(U64));
+      String8 batch_srlzed = ctrl_serialized_string_from_event_list(scratch.arena, &n, ctrl_state->c2u_ring_size-sizeof(U64));
       OS_MutexScope(ctrl_state->c2u_ring_mutex) for(;;)
       {
         U64 unconsumed_size = (ctrl_state->c2u_ring_write_pos-ctrl_state->c2u_ring_read_pos);
         U64 available_size = ctrl_state->c2u_ring_size-unconsumed_size;
-        if(available_size >= sizeof(U64) + event_srlzed.size)
+        if(available_size >= sizeof(U64) + batch_srlzed.size)
         {
-          ctrl_state->c2u_ring_write_pos += ring_write_struct(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_write_pos, &event_srlzed.size);
-          ctrl_state->c2u_ring_write_pos += ring_write(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_write_pos, event_srlzed.str, event_srlzed.size);
+          ctrl_state->c2u_ring_write_pos += ring_write_struct(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_write_pos, &batch_srlzed.size);
+          ctrl_state->c2u_ring_write_pos += ring_write(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_write_pos, batch_srlzed.str, batch_srlzed.size);
           ctrl_state->c2u_ring_write_pos += 7;
           ctrl_state->c2u_ring_write_pos -= ctrl_state->c2u_ring_write_pos%8;
           break;
@@ -2831,7 +3375,9 @@ ctrl_c2u_pop_events(Arena *arena)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(&arena, 1);
-  CTRL_EventList events = {0};
+  
+  //- rjf: pull all batches out of the ring
+  String8List batches = {0};
   OS_MutexScope(ctrl_state->c2u_ring_mutex) for(;;)
   {
     U64 unconsumed_size = (ctrl_state->c2u_ring_write_pos-ctrl_state->c2u_ring_read_pos);
@@ -2839,14 +3385,13 @@ ctrl_c2u_pop_events(Arena *arena)
     {
       U64 size_to_decode = 0;
       ctrl_state->c2u_ring_read_pos += ring_read_struct(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_read_pos, &size_to_decode);
-      String8 event_srlzed = {0};
-      event_srlzed.size = size_to_decode;
-      event_srlzed.str = push_array_no_zero(scratch.arena, U8, event_srlzed.size);
-      ctrl_state->c2u_ring_read_pos += ring_read(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_read_pos, event_srlzed.str, event_srlzed.size);
+      String8 batch_srlzed = {0};
+      batch_srlzed.size = size_to_decode;
+      batch_srlzed.str = push_array_no_zero(arena, U8, batch_srlzed.size);
+      ctrl_state->c2u_ring_read_pos += ring_read(ctrl_state->c2u_ring_base, ctrl_state->c2u_ring_size, ctrl_state->c2u_ring_read_pos, batch_srlzed.str, batch_srlzed.size);
       ctrl_state->c2u_ring_read_pos += 7;
       ctrl_state->c2u_ring_read_pos -= ctrl_state->c2u_ring_read_pos%8;
-      CTRL_Event *new_event = ctrl_event_list_push(arena, &events);
-      *new_event = ctrl_event_from_serialized_string(arena, event_srlzed);
+      str8_list_push(scratch.arena, &batches, batch_srlzed);
     }
     else
     {
@@ -2854,6 +3399,15 @@ ctrl_c2u_pop_events(Arena *arena)
     }
   }
   os_condition_variable_broadcast(ctrl_state->c2u_ring_cv);
+  
+  //- rjf: decode batches - event strings point into the batch data, which
+  // was read directly into the output arena
+  CTRL_EventList events = {0};
+  for(String8Node *n = batches.first; n != 0; n = n->next)
+  {
+    CTRL_EventList batch_events = ctrl_event_list_from_serialized_string(arena, n->string);
+    ctrl_event_list_concat_in_place(&events, &batch_events);
+  }
   scratch_end(scratch);
   ProfEnd();
   return events;
@@ -2958,99 +3512,285 @@ ctrl_thread__entry_point(void *p)
 //- rjf: breakpoint resolution
 
 internal void
-ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_MachineID machine_id, DMN_Handle process, DMN_Handle module, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out)
+ctrl_thread__user_bp_set_update(CTRL_UserBreakpointList *user_bps)
 {
-  Temp scratch = scratch_begin(&arena, 1);
-  DI_Scope *di_scope = di_scope_open();
-  CTRL_Entity *module_entity = ctrl_entity_from_machine_id_handle(ctrl_state->ctrl_thread_entity_store, machine_id, module);
-  CTRL_Entity *debug_info_path_entity = ctrl_entity_child_from_kind(module_entity, CTRL_EntityKind_DebugInfoPath);
-  DI_Key dbgi_key = {debug_info_path_entity->string, debug_info_path_entity->timestamp};
-  RDI_Parsed *rdi = di_rdi_from_key(di_scope, &dbgi_key, max_U64);
-  U64 base_vaddr = module_entity->vaddr_range.min;
-  for(CTRL_UserBreakpointNode *n = user_bps->first; n != 0; n = n->next)
+  CTRL_ResolvedUserBreakpointCache *cache = &ctrl_state->resolved_user_bp_cache;
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: hash everything which affects resolution
+  U128 hash = {0};
   {
-    CTRL_UserBreakpoint *bp = &n->v;
-    switch(bp->kind)
+    String8List srl = {0};
+    for(CTRL_UserBreakpointNode *n = user_bps->first; n != 0; n = n->next)
     {
-      default:{}break;
+      CTRL_UserBreakpoint *bp = &n->v;
+      str8_serial_push_struct(scratch.arena, &srl, &bp->kind);
+      str8_serial_push_struct(scratch.arena, &srl, &bp->pt.line);
+      str8_serial_push_struct(scratch.arena, &srl, &bp->u64);
+      str8_serial_push_struct(scratch.arena, &srl, &bp->string.size);
+      str8_serial_push_data(scratch.arena, &srl, bp->string.str, bp->string.size);
+    }
+    hash = hs_hash_from_data(str8_list_join(scratch.arena, &srl, 0));
+  }
+  
+  //- rjf: set changed -> bump generation, drop stale resolutions, regroup
+  if(cache->bp_set_gen == 0 || !u128_match(hash, cache->bp_set_hash))
+  {
+    cache->bp_set_hash = hash;
+    cache->bp_set_gen += 1;
+    arena_clear(cache->arena);
+    cache->slots = push_array(cache->arena, CTRL_ResolvedUserBreakpointCacheNode *, cache->slots_count);
+    arena_clear(cache->bp_set_arena);
+    cache->bp_set_count = user_bps->count;
+    cache->bp_set = push_array(cache->bp_set_arena, CTRL_UserBreakpoint, cache->bp_set_count);
+    cache->first_file_group = 0;
+    cache->symbol_bp_idxs = push_array(cache->bp_set_arena, U64, cache->bp_set_count);
+    cache->symbol_bp_idxs_count = 0;
+    
+    //- rjf: copy set; normalize each file path once; group by file
+    U64 group_slots_count = 256;
+    CTRL_UserBreakpointFileGroup **group_slots = push_array(scratch.arena, CTRL_UserBreakpointFileGroup *, group_slots_count);
+    CTRL_UserBreakpointFileGroup **bp_groups = push_array(scratch.arena, CTRL_UserBreakpointFileGroup *, cache->bp_set_count);
+    U64 bp_idx = 0;
+    for(CTRL_UserBreakpointNode *n = user_bps->first; n != 0; n = n->next, bp_idx += 1)
+    {
+      CTRL_UserBreakpoint *bp = &cache->bp_set[bp_idx];
+      MemoryCopyStruct(bp, &n->v);
+      bp->string = push_str8_copy(cache->bp_set_arena, n->v.string);
+      bp->condition = push_str8_copy(cache->bp_set_arena, n->v.condition);
+      switch(bp->kind)
+      {
+        default:{}break;
+        case CTRL_UserBreakpointKind_FileNameAndLineColNumber:
+        {
+          String8 file_path_normalized = push_str8_copy(scratch.arena, bp->string);
+          for(U64 idx = 0; idx < file_path_normalized.size; idx += 1)
+          {
+            file_path_normalized.str[idx] = char_to_lower(file_path_normalized.str[idx]);
+            file_path_normalized.str[idx] = char_to_correct_slash(file_path_normalized.str[idx]);
+          }
+          U64 slot_idx = ctrl_hash_from_string(file_path_normalized)%group_slots_count;
+          CTRL_UserBreakpointFileGroup *group = 0;
+          for(CTRL_UserBreakpointFileGroup *g = group_slots[slot_idx]; g != 0; g = g->next)
+          {
+            if(str8_match(g->file_path_normalized, file_path_normalized, 0))
+            {
+              group = g;
+              break;
+            }
+          }
+          if(group == 0)
+          {
+            group = push_array(cache->bp_set_arena, CTRL_UserBreakpointFileGroup, 1);
+            group->file_path_normalized = push_str8_copy(cache->bp_set_arena, file_path_normalized);
+            SLLStackPush(group_slots[slot_idx], group);
+          }
+          group->bp_idxs_cap += 1;
+          bp_groups[bp_idx] = group;
+        }break;
+        case CTRL_UserBreakpointKind_SymbolNameAndOffset:
+        {
+          cache->symbol_bp_idxs[cache->symbol_bp_idxs_count] = bp_idx;
+          cache->symbol_bp_idxs_count += 1;
+        }break;
+      }
+    }
+    
+    //- rjf: fill groups' breakpoint indices, link groups into one list
+    for(U64 slot_idx = 0; slot_idx < group_slots_count; slot_idx += 1)
+    {
+      for(CTRL_UserBreakpointFileGroup *g = group_slots[slot_idx], *next = 0; g != 0; g = next)
+      {
+        next = g->next;
+        g->bp_idxs = push_array(cache->bp_set_arena, U64, g->bp_idxs_cap);
+        SLLStackPush(cache->first_file_group, g);
+      }
+    }
+    for(U64 idx = 0; idx < cache->bp_set_count; idx += 1)
+    {
+      CTRL_UserBreakpointFileGroup *group = bp_groups[idx];
+      if(group != 0)
+      {
+        group->bp_idxs[group->bp_idxs_count] = idx;
+        group->bp_idxs_count += 1;
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+}
+
+internal CTRL_ResolvedUserBreakpointCacheNode *
+ctrl_thread__resolved_user_bps_from_dbgi_key(DI_Key *dbgi_key)
+{
+  CTRL_ResolvedUserBreakpointCache *cache = &ctrl_state->resolved_user_bp_cache;
+  U64 hash = ctrl_hash_from_string(dbgi_key->path) ^ dbgi_key->min_timestamp;
+  U64 slot_idx = hash%cache->slots_count;
+  
+  //- rjf: find existing resolution for this debug info & set
+  CTRL_ResolvedUserBreakpointCacheNode *node = 0;
+  for(CTRL_ResolvedUserBreakpointCacheNode *n = cache->slots[slot_idx]; n != 0; n = n->next)
+  {
+    if(n->bp_set_gen == cache->bp_set_gen &&
+       n->dbgi_timestamp == dbgi_key->min_timestamp &&
+       str8_match(n->dbgi_path, dbgi_key->path, 0))
+    {
+      node = n;
+      break;
+    }
+  }
+  
+  //- rjf: none -> resolve whole set against debug info; each distinct file is
+  // looked up & has its line map parsed once, for all breakpoints in it
+  if(node == 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    DI_Scope *di_scope = di_scope_open();
+    RDI_Parsed *rdi = di_rdi_from_key(di_scope, dbgi_key, max_U64);
+    if(rdi != &di_rdi_parsed_nil)
+    {
+      U64 resolved_bps_cap = 64;
+      U64 resolved_bps_count = 0;
+      CTRL_ResolvedUserBreakpoint *resolved_bps = push_array_no_zero(scratch.arena, CTRL_ResolvedUserBreakpoint, resolved_bps_cap);
+#define CTRL_ResolvedBpPush(idx, v) do\
+      {\
+        if(resolved_bps_count == resolved_bps_cap)\
+        {\
+          CTRL_ResolvedUserBreakpoint *new_resolved_bps = push_array_no_zero(scratch.arena, CTRL_ResolvedUserBreakpoint, resolved_bps_cap*2);\
+          MemoryCopy(new_resolved_bps, resolved_bps, sizeof(resolved_bps[0])*resolved_bps_count);\
+          resolved_bps = new_resolved_bps;\
+          resolved_bps_cap *= 2;\
+        }\
+        resolved_bps[resolved_bps_count].bp_idx = (idx);\
+        resolved_bps[resolved_bps_count].voff = (v);\
+        resolved_bps_count += 1;\
+      }while(0)
       
       //- rjf: file:line-based breakpoints
-      case CTRL_UserBreakpointKind_FileNameAndLineColNumber:
+      RDI_ParsedNameMap *src_map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_NormalSourcePaths);
+      for(CTRL_UserBreakpointFileGroup *group = cache->first_file_group; group != 0; group = group->next)
       {
-        // rjf: unpack & normalize
-        TxtPt pt = bp->pt;
-        String8 filename = bp->string;
-        String8 filename_normalized = push_str8_copy(scratch.arena, filename);
-        for(U64 idx = 0; idx < filename_normalized.size; idx += 1)
-        {
-          filename_normalized.str[idx] = char_to_lower(filename_normalized.str[idx]);
-          filename_normalized.str[idx] = char_to_correct_slash(filename_normalized.str[idx]);
-        }
-        
         // rjf: filename -> src_id
         U32 src_id = 0;
+        RDI_NameMapNode *map_node = rdi_name_map_lookup(rdi, src_map, group->file_path_normalized.str, group->file_path_normalized.size);
+        if(map_node != 0)
         {
-          RDI_NameMap *mapptr = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_NormalSourcePaths);
-          if(mapptr != 0)
+          U32 id_count = 0;
+          U32 *ids = rdi_matches_from_map_node(rdi, map_node, &id_count);
+          if(id_count > 0)
           {
-            RDI_ParsedNameMap map = {0};
-            rdi_parsed_from_name_map(rdi, mapptr, &map);
-            RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, filename_normalized.str, filename_normalized.size);
-            if(node != 0)
-            {
-              U32 id_count = 0;
-              U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
-              if(id_count > 0)
-              {
-                src_id = ids[0];
-              }
-            }
+            src_id = ids[0];
           }
         }
         
-        // rjf: src_id * pt -> push
+        // rjf: src_id * lines -> voffs
+        if(src_id != 0)
         {
           RDI_SourceFile *src = rdi_element_from_name_idx(rdi, SourceFiles, src_id);
           RDI_SourceLineMap *src_line_map = rdi_element_from_name_idx(rdi, SourceLineMaps, src->source_line_map_idx);
           RDI_ParsedSourceLineMap line_map = {0};
           rdi_parsed_from_source_line_map(rdi, src_line_map, &line_map);
-          U32 voff_count = 0;
-          U64 *voffs = rdi_line_voffs_from_num(&line_map, pt.line, &voff_count);
-          for(U32 i = 0; i < voff_count; i += 1)
+          for(U64 idx = 0; idx < group->bp_idxs_count; idx += 1)
           {
-            U64 vaddr = voffs[i] + base_vaddr;
-            DMN_Trap trap = {process, vaddr, (U64)bp};
-            dmn_trap_chunk_list_push(arena, traps_out, 256, &trap);
+            U64 bp_idx = group->bp_idxs[idx];
+            U32 voff_count = 0;
+            U64 *voffs = rdi_line_voffs_from_num(&line_map, cache->bp_set[bp_idx].pt.line, &voff_count);
+            for(U32 i = 0; i < voff_count; i += 1)
+            {
+              CTRL_ResolvedBpPush(bp_idx, voffs[i]);
+            }
           }
         }
-      }break;
+      }
       
       //- rjf: symbol:voff-based breakpoints
-      case CTRL_UserBreakpointKind_SymbolNameAndOffset:
-      {
-        String8 symbol_name = bp->string;
-        U64 voff = bp->u64;
-        RDI_NameMap *mapptr = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_Procedures);
-        RDI_ParsedNameMap map = {0};
-        rdi_parsed_from_name_map(rdi, mapptr, &map);
-        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, symbol_name.str, symbol_name.size);
-        if(node != 0)
+      RDI_ParsedNameMap *procedure_map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_Procedures);
+      for(U64 idx = 0; idx < cache->symbol_bp_idxs_count; idx += 1)
+      {
+        U64 bp_idx = cache->symbol_bp_idxs[idx];
+        CTRL_UserBreakpoint *bp = &cache->bp_set[bp_idx];
+        RDI_NameMapNode *map_node = rdi_name_map_lookup(rdi, procedure_map, bp->string.str, bp->string.size);
+        if(map_node != 0)
         {
           U32 id_count = 0;
-          U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
+          U32 *ids = rdi_matches_from_map_node(rdi, map_node, &id_count);
           for(U32 match_i = 0; match_i < id_count; match_i += 1)
           {
             RDI_Procedure *procedure = rdi_element_from_name_idx(rdi, Procedures, ids[match_i]);
             U64 proc_voff = rdi_first_voff_from_procedure(rdi, procedure);
-            U64 proc_vaddr = proc_voff + base_vaddr;
-            DMN_Trap trap = {process, proc_vaddr + voff, (U64)bp};
-            dmn_trap_chunk_list_push(arena, traps_out, 256, &trap);
+            CTRL_ResolvedBpPush(bp_idx, proc_voff + bp->u64);
           }
         }
-      }break;
+      }
+#undef CTRL_ResolvedBpPush
+      
+      //- rjf: store
+      node = push_array(cache->arena, CTRL_ResolvedUserBreakpointCacheNode, 1);
+      SLLStackPush(cache->slots[slot_idx], node);
+      node->dbgi_path = push_str8_copy(cache->arena, dbgi_key->path);
+      node->dbgi_timestamp = dbgi_key->min_timestamp;
+      node->bp_set_gen = cache->bp_set_gen;
+      node->resolved_bps_count = resolved_bps_count;
+      node->resolved_bps = push_array_no_zero(cache->arena, CTRL_ResolvedUserBreakpoint, resolved_bps_count);
+      MemoryCopy(node->resolved_bps, resolved_bps, sizeof(resolved_bps[0])*resolved_bps_count);
+    }
+    di_scope_close(di_scope);
+    scratch_end(scratch);
+  }
+  
+  return node;
+}
+
+internal B32
+ctrl_thread__dbgi_key_has_resolved_user_bps(DI_Key *dbgi_key)
+{
+  CTRL_ResolvedUserBreakpointCache *cache = &ctrl_state->resolved_user_bp_cache;
+  B32 result = 0;
+  if(cache->slots != 0)
+  {
+    U64 hash = ctrl_hash_from_string(dbgi_key->path) ^ dbgi_key->min_timestamp;
+    U64 slot_idx = hash%cache->slots_count;
+    for(CTRL_ResolvedUserBreakpointCacheNode *n = cache->slots[slot_idx]; n != 0; n = n->next)
+    {
+      if(n->bp_set_gen == cache->bp_set_gen &&
+         n->dbgi_timestamp == dbgi_key->min_timestamp &&
+         str8_match(n->dbgi_path, dbgi_key->path, 0))
+      {
+        result = (n->resolved_bps_count != 0);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+internal void
+ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_MachineID machine_id, DMN_Handle process, DMN_Handle module, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  ctrl_thread__user_bp_set_update(user_bps);
+  CTRL_Entity *module_entity = ctrl_entity_from_machine_id_handle(ctrl_state->ctrl_thread_entity_store, machine_id, module);
+  CTRL_Entity *debug_info_path_entity = ctrl_entity_child_from_kind(module_entity, CTRL_EntityKind_DebugInfoPath);
+  DI_Key dbgi_key = {debug_info_path_entity->string, debug_info_path_entity->timestamp};
+  CTRL_ResolvedUserBreakpointCacheNode *resolved = ctrl_thread__resolved_user_bps_from_dbgi_key(&dbgi_key);
+  if(resolved != 0 && resolved->resolved_bps_count != 0)
+  {
+    // rjf: resolved voffs refer to breakpoints by index - map back to this
+    // list's nodes, which are what traps are tagged with
+    CTRL_UserBreakpoint **bps = push_array_no_zero(scratch.arena, CTRL_UserBreakpoint *, user_bps->count);
+    U64 bp_idx = 0;
+    for(CTRL_UserBreakpointNode *n = user_bps->first; n != 0; n = n->next, bp_idx += 1)
+    {
+      bps[bp_idx] = &n->v;
+    }
+    U64 base_vaddr = module_entity->vaddr_range.min;
+    for(U64 idx = 0; idx < resolved->resolved_bps_count; idx += 1)
+    {
+      CTRL_ResolvedUserBreakpoint *resolved_bp = &resolved->resolved_bps[idx];
+      DMN_Trap trap = {process, base_vaddr + resolved_bp->voff, (U64)bps[resolved_bp->bp_idx]};
+      dmn_trap_chunk_list_push(arena, traps_out, 256, &trap);
     }
   }
-  di_scope_close(di_scope);
   scratch_end(scratch);
 }
 
@@ -3378,6 +4118,63 @@ ctrl_thread__module_close(CTRL_MachineID machine_id, DMN_Handle module)
   }
 }
 
+//- rjf: debug info prefetching
+
+internal void
+ctrl_thread__prefetch_stop_debug_info(CTRL_MachineID machine_id, DMN_Handle process, DMN_Handle thread)
+{
+  Temp scratch = scratch_begin(0, 0);
+  CTRL_EntityStore *store = ctrl_state->ctrl_thread_entity_store;
+  CTRL_Entity *process_entity = ctrl_entity_from_machine_id_handle(store, machine_id, process);
+  
+  //- rjf: gather rips - whole call stack of stopped thread, tops of all others
+  U64 rips_count = 0;
+  U64 rips_cap = 64;
+  U64 *rips = push_array(scratch.arena, U64, rips_cap);
+  {
+    CTRL_Unwind unwind = ctrl_unwind_from_thread(scratch.arena, store, machine_id, thread, os_now_microseconds()+5000);
+    CTRL_Entity *thread_entity = ctrl_entity_from_machine_id_handle(store, machine_id, thread);
+    for(U64 idx = 0; idx < unwind.frames.count && rips_count < rips_cap; idx += 1)
+    {
+      rips[rips_count] = regs_rip_from_arch_block(thread_entity->arch, unwind.frames.v[idx].regs);
+      rips_count += 1;
+    }
+    for(CTRL_Entity *t = process_entity->first; t != &ctrl_entity_nil && rips_count < rips_cap; t = t->next)
+    {
+      if(t->kind == CTRL_EntityKind_Thread && !dmn_handle_match(t->handle, thread))
+      {
+        rips[rips_count] = ctrl_query_cached_rip_from_thread(store, machine_id, t->handle);
+        rips_count += 1;
+      }
+    }
+  }
+  
+  //- rjf: rips -> modules -> prefetch debug info; warms if already parsed
+  for(CTRL_Entity *m = process_entity->first; m != &ctrl_entity_nil; m = m->next)
+  {
+    if(m->kind != CTRL_EntityKind_Module)
+    {
+      continue;
+    }
+    B32 on_stack = 0;
+    for(U64 idx = 0; idx < rips_count; idx += 1)
+    {
+      if(contains_1u64(m->vaddr_range, rips[idx]))
+      {
+        on_stack = 1;
+        break;
+      }
+    }
+    if(on_stack)
+    {
+      CTRL_Entity *debug_info_path = ctrl_entity_child_from_kind(m, CTRL_EntityKind_DebugInfoPath);
+      DI_Key dbgi_key = {debug_info_path->string, debug_info_path->timestamp};
+      di_prefetch(&dbgi_key, DI_Priority_CallStack);
+    }
+  }
+  scratch_end(scratch);
+}
+
 //- rjf: attached process running/event gathering
 
 internal DMN_Event *
@@ -3476,12 +4273,10 @@ ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg,
                 CTRL_Entity *dbg_path = ctrl_entity_child_from_kind(module, CTRL_EntityKind_DebugInfoPath);
                 DI_Key dbgi_key = {dbg_path->string, dbg_path->timestamp};
                 RDI_Parsed *rdi = di_rdi_from_key(di_scope, &dbgi_key, max_U64);
-                RDI_NameMap *unparsed_map = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_GlobalVariables);
                 {
-                  RDI_ParsedNameMap map = {0};
-                  rdi_parsed_from_name_map(rdi, unparsed_map, &map);
+                  RDI_ParsedNameMap *map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_GlobalVariables);
                   String8 name = str8_lit("__asan_shadow_memory_dynamic_address");
-                  RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name.str, name.size);
+                  RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, name.str, name.size);
                   if(node != 0)
                   {
                     U32 id_count = 0;
@@ -3687,6 +4482,29 @@ ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg,
       out_evt2->string     = initial_debug_info_path;
       DI_Key initial_dbgi_key = {initial_debug_info_path, debug_info_timestamp};
       di_open(&initial_dbgi_key);
+      
+      // rjf: raise prefetch priority for a process' executable (its first
+      // module), & for modules which user breakpoints resolved into last time
+      {
+        B32 is_first_module = 1;
+        CTRL_Entity *process_entity = ctrl_entity_from_machine_id_handle(ctrl_state->ctrl_thread_entity_store, CTRL_MachineID_Local, event->process);
+        for(CTRL_Entity *m = process_entity->first; m != &ctrl_entity_nil; m = m->next)
+        {
+          if(m->kind == CTRL_EntityKind_Module && !dmn_handle_match(m->handle, event->module))
+          {
+            is_first_module = 0;
+            break;
+          }
+        }
+        if(is_first_module)
+        {
+          di_prefetch(&initial_dbgi_key, DI_Priority_Executable);
+        }
+        else if(ctrl_thread__dbgi_key_has_resolved_user_bps(&initial_dbgi_key))
+        {
+          di_prefetch(&initial_dbgi_key, DI_Priority_Breakpoints);
+        }
+      }
     }break;
     case DMN_EventKind_ExitProcess:
     {
@@ -4334,9 +5152,7 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
         CTRL_Entity *dbg_path = ctrl_entity_child_from_kind(module, CTRL_EntityKind_DebugInfoPath);
         DI_Key dbgi_key = {dbg_path->string, dbg_path->timestamp};
         RDI_Parsed *rdi = di_rdi_from_key(di_scope, &dbgi_key, max_U64);
-        RDI_NameMap *unparsed_map = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_Procedures);
-        RDI_ParsedNameMap map = {0};
-        rdi_parsed_from_name_map(rdi, unparsed_map, &map);
+        RDI_ParsedNameMap *map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_Procedures);
         
         //- rjf: add traps for user-specified entry points on this message, if specified
         B32 entries_found = 0;
@@ -4347,7 +5163,7 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
             U32 procedure_id = 0;
             {
               String8 name = n->string;
-              RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name.str, name.size);
+              RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, name.str, name.size);
               U32 id_count = 0;
               U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
               if(id_count > 0)
@@ -4376,7 +5192,7 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
               U32 procedure_id = 0;
               {
                 String8 name = e->string;
-                RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name.str, name.size);
+                RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, name.str, name.size);
                 U32 id_count = 0;
                 U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
                 if(id_count > 0)
@@ -4404,7 +5220,7 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
             U32 procedure_id = 0;
             {
               String8 name = n->string;
-              RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name.str, name.size);
+              RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, name.str, name.size);
               U32 id_count = 0;
               U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
               if(id_count > 0)
@@ -4433,12 +5249,20 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
             str8_lit("main"),
             str8_lit("wmain"),
           };
+          U8 *names[ArrayCount(hi_entry_points)] = {0};
+          U64 name_sizes[ArrayCount(hi_entry_points)] = {0};
+          RDI_NameMapNode *nodes[ArrayCount(hi_entry_points)] = {0};
+          for(U64 idx = 0; idx < ArrayCount(hi_entry_points); idx += 1)
+          {
+            names[idx] = hi_entry_points[idx].str;
+            name_sizes[idx] = hi_entry_points[idx].size;
+          }
+          rdi_name_map_lookup_batch(rdi, map, names, name_sizes, ArrayCount(hi_entry_points), nodes);
           for(U64 idx = 0; idx < ArrayCount(hi_entry_points); idx += 1)
           {
             U32 procedure_id = 0;
             {
-              String8 name = hi_entry_points[idx];
-              RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name.str, name.size);
+              RDI_NameMapNode *node = nodes[idx];
               U32 id_count = 0;
               U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
               if(id_count > 0)
@@ -4478,12 +5302,20 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
             str8_lit("mainCRTStartup"),
             str8_lit("wmainCRTStartup"),
           };
+          U8 *names[ArrayCount(lo_entry_points)] = {0};
+          U64 name_sizes[ArrayCount(lo_entry_points)] = {0};
+          RDI_NameMapNode *nodes[ArrayCount(lo_entry_points)] = {0};
+          for(U64 idx = 0; idx < ArrayCount(lo_entry_points); idx += 1)
+          {
+            names[idx] = lo_entry_points[idx].str;
+            name_sizes[idx] = lo_entry_points[idx].size;
+          }
+          rdi_name_map_lookup_batch(rdi, map, names, name_sizes, ArrayCount(lo_entry_points), nodes);
           for(U64 idx = 0; idx < ArrayCount(lo_entry_points); idx += 1)
           {
             U32 procedure_id = 0;
             {
-              String8 name = lo_entry_points[idx];
-              RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name.str, name.size);
+              RDI_NameMapNode *node = nodes[idx];
               U32 id_count = 0;
               U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
               if(id_count > 0)
@@ -4641,8 +5473,8 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
               parse_ctx.type_graph = tg_graph_begin(bit_size_from_arch(arch)/8, 256);
               parse_ctx.regs_map = ctrl_string2reg_from_arch(arch);
               parse_ctx.reg_alias_map = ctrl_string2alias_from_arch(arch);
-              parse_ctx.locals_map = eval_push_locals_map_from_rdi_voff(temp.arena, rdi, thread_rip_voff);
-              parse_ctx.member_map = eval_push_member_map_from_rdi_voff(temp.arena, rdi, thread_rip_voff);
+              parse_ctx.locals_map = 0;
+              parse_ctx.member_map = 0;
             }
             EVAL_TokenArray tokens = eval_token_array_from_text(temp.arena, string);
             EVAL_ParseResult parse = eval_parse_expr_from_text_tokens(temp.arena, &parse_ctx, string, &tokens);
@@ -5006,6 +5838,7 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     event->vaddr_rng = r1u64(stop_event->address, stop_event->address);
     event->rip_vaddr = stop_event->instruction_pointer;
     ctrl_c2u_push_events(&evts);
+    ctrl_thread__prefetch_stop_debug_info(CTRL_MachineID_Local, stop_event->process, stop_event->thread);
   }
   
   log_infof("}\n\n");
@@ -5079,6 +5912,7 @@ ctrl_thread__single_step(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     event->vaddr_rng = r1u64(stop_event->address, stop_event->address);
     event->rip_vaddr = stop_event->instruction_pointer;
     ctrl_c2u_push_events(&evts);
+    ctrl_thread__prefetch_stop_debug_info(CTRL_MachineID_Local, stop_event->process, stop_event->thread);
   }
   
   scratch_end(scratch);
@@ -5193,7 +6027,7 @@ ctrl_mem_stream_thread__entry_point(void *p)
     Arena *range_arena = 0;
     void *range_base = 0;
     U64 zero_terminated_size = 0;
-    U64 pre_read_mem_gen = dmn_mem_gen();
+    U64 pre_read_mem_gen = ctrl_mem_gen_from_machine_id(machine_id);
     U64 post_read_mem_gen = 0;
     if(got_task && pre_read_mem_gen != preexisting_mem_gen)
     {
@@ -5211,7 +6045,7 @@ ctrl_mem_stream_thread__entry_point(void *p)
         U64 retry_count = 0;
         for(Rng1U64 vaddr_range_clamped_retry = vaddr_range_clamped; retry_count < 64; retry_count += 1)
         {
-          bytes_read = dmn_process_read(process, vaddr_range_clamped_retry, range_base);
+          bytes_read = ctrl_process_read(machine_id, process, vaddr_range_clamped_retry, range_base);
           if(bytes_read == 0 && vaddr_range_clamped_retry.max > vaddr_range_clamped_retry.min)
           {
             U64 diff = (vaddr_range_clamped_retry.max-vaddr_range_clamped_retry.min)/2;
@@ -5250,7 +6084,7 @@ ctrl_mem_stream_thread__entry_point(void *p)
           }
         }
       }
-      post_read_mem_gen = dmn_mem_gen();
+      post_read_mem_gen = ctrl_mem_gen_from_machine_id(machine_id);
     }
     
     //- rjf: read successful -> submit to hash store
@@ -397,6 +397,25 @@ struct CTRL_EventList
   U64 count;
 };
 
+//- rjf: batched event encoding
+//
+// NOTE: Batches encode each event as a varint mask of which fields
+// differ from the previous event in the batch, followed by each differing
+// field as a zigzag varint delta from its previous value, followed by the
+// event's string (if any). Strings are interned per batch - the first
+// occurrence is written inline, later ones by index.
+
+#define CTRL_EVENT_BATCH_FIELD_COUNT 17
+#define CTRL_EVENT_BATCH_HAS_STRING_BIT (1ull<<CTRL_EVENT_BATCH_FIELD_COUNT)
+
+typedef struct CTRL_EventBatchStringNode CTRL_EventBatchStringNode;
+struct CTRL_EventBatchStringNode
+{
+  CTRL_EventBatchStringNode *next;
+  String8 string;
+  U64 idx;
+};
+
 ////////////////////////////////
 //~ rjf: Process Memory Cache Types
 
@@ -545,12 +564,89 @@ struct CTRL_ModuleImageInfoCache
   CTRL_ModuleImageInfoCacheStripe *stripes;
 };
 
+////////////////////////////////
+//~ rjf: User Breakpoint Resolution Cache Types
+
+// NOTE: Module-dependent user breakpoints are resolved in bulk - the set
+// of breakpoints is normalized & grouped by source file once per change (each
+// change bumps the set's generation), and the resulting voffs for a given
+// debug info file are cached per (debug info key, set generation). Modules
+// sharing debug info - or the same module, loaded again - reuse the voffs.
+// Only touched by the ctrl thread.
+
+typedef struct CTRL_UserBreakpointFileGroup CTRL_UserBreakpointFileGroup;
+struct CTRL_UserBreakpointFileGroup
+{
+  CTRL_UserBreakpointFileGroup *next;
+  String8 file_path_normalized;
+  U64 *bp_idxs;
+  U64 bp_idxs_count;
+  U64 bp_idxs_cap;
+};
+
+typedef struct CTRL_ResolvedUserBreakpoint CTRL_ResolvedUserBreakpoint;
+struct CTRL_ResolvedUserBreakpoint
+{
+  U64 bp_idx;
+  U64 voff;
+};
+
+typedef struct CTRL_ResolvedUserBreakpointCacheNode CTRL_ResolvedUserBreakpointCacheNode;
+struct CTRL_ResolvedUserBreakpointCacheNode
+{
+  CTRL_ResolvedUserBreakpointCacheNode *next;
+  String8 dbgi_path;
+  U64 dbgi_timestamp;
+  U64 bp_set_gen;
+  CTRL_ResolvedUserBreakpoint *resolved_bps;
+  U64 resolved_bps_count;
+};
+
+typedef struct CTRL_ResolvedUserBreakpointCache CTRL_ResolvedUserBreakpointCache;
+struct CTRL_ResolvedUserBreakpointCache
+{
+  // rjf: current breakpoint set
+  Arena *bp_set_arena;
+  U128 bp_set_hash;
+  U64 bp_set_gen;
+  U64 bp_set_count;
+  CTRL_UserBreakpoint *bp_set;
+  CTRL_UserBreakpointFileGroup *first_file_group;
+  U64 *symbol_bp_idxs;
+  U64 symbol_bp_idxs_count;
+  
+  // rjf: resolved voffs, per debug info
+  Arena *arena;
+  U64 slots_count;
+  CTRL_ResolvedUserBreakpointCacheNode **slots;
+};
+
 ////////////////////////////////
 //~ rjf: Wakeup Hook Function Types
 
 #define CTRL_WAKEUP_FUNCTION_DEF(name) void name(void)
 typedef CTRL_WAKEUP_FUNCTION_DEF(CTRL_WakeupFunctionType);
 
+////////////////////////////////
+//~ rjf: Synthetic Machine Types
+//
+// NOTE: A synthetic machine's process memory & thread registers are served by
+// callbacks, rather than by the demon, so that the frontend can be driven
+// without a live target (e.g. by benchmarks). Its entities are introduced by
+// pushing events for them. Its state never changes, so its memory & register
+// generations are constant.
+
+typedef U64 CTRL_SyntheticReadMemoryFunctionType(DMN_Handle process, Rng1U64 range, void *dst);
+typedef B32 CTRL_SyntheticReadRegBlockFunctionType(DMN_Handle thread, void *reg_block);
+
+typedef struct CTRL_SyntheticMachine CTRL_SyntheticMachine;
+struct CTRL_SyntheticMachine
+{
+  CTRL_MachineID machine_id;
+  CTRL_SyntheticReadMemoryFunctionType *read_memory;
+  CTRL_SyntheticReadRegBlockFunctionType *read_reg_block;
+};
+
 ////////////////////////////////
 //~ rjf: Main State Types
 
@@ -559,6 +655,7 @@ struct CTRL_State
 {
   Arena *arena;
   CTRL_WakeupFunctionType *wakeup_hook;
+  CTRL_SyntheticMachine synthetic_machine;
   
   // rjf: name -> register/alias hash tables for eval
   EVAL_String2NumMap arch_string2reg_tables[Architecture_COUNT];
@@ -568,6 +665,7 @@ struct CTRL_State
   CTRL_ProcessMemoryCache process_memory_cache;
   CTRL_ThreadRegCache thread_reg_cache;
   CTRL_ModuleImageInfoCache module_image_info_cache;
+  CTRL_ResolvedUserBreakpointCache resolved_user_bp_cache;
   
   // rjf: user -> ctrl msg ring buffer
   U64 u2c_ring_size;
@@ -682,6 +780,14 @@ internal void ctrl_event_list_concat_in_place(CTRL_EventList *dst, CTRL_EventLis
 internal String8 ctrl_serialized_string_from_event(Arena *arena, CTRL_Event *event, U64 max);
 internal CTRL_Event ctrl_event_from_serialized_string(Arena *arena, String8 string);
 
+//- rjf: batched serialization
+internal U64 ctrl_varint_write(U8 *dst, U64 x);
+internal U64 ctrl_varint_read(String8 string, U64 off, U64 *x_out);
+internal void ctrl_event_batch_fields_from_event(U64 *fields, CTRL_Event *event);
+internal void ctrl_event_from_event_batch_fields(CTRL_Event *event, U64 *fields);
+internal String8 ctrl_serialized_string_from_event_list(Arena *arena, CTRL_EventNode **first_node_inout, U64 max);
+internal CTRL_EventList ctrl_event_list_from_serialized_string(Arena *arena, String8 string);
+
 ////////////////////////////////
 //~ rjf: Entity Type Functions
 
@@ -718,6 +824,12 @@ internal void ctrl_init(void);
 
 internal void ctrl_set_wakeup_hook(CTRL_WakeupFunctionType *wakeup_hook);
 
+////////////////////////////////
+//~ rjf: Synthetic Machine Registration
+
+internal void ctrl_set_synthetic_machine(CTRL_SyntheticMachine *machine);
+internal B32 ctrl_machine_id_is_synthetic(CTRL_MachineID machine_id);
+
 ////////////////////////////////
 //~ rjf: Process Memory Functions
 
@@ -734,6 +846,9 @@ internal CTRL_ProcessMemorySlice ctrl_query_cached_zero_terminated_data_from_pro
 internal B32 ctrl_read_cached_process_memory(CTRL_MachineID machine_id, DMN_Handle process, Rng1U64 range, B32 *is_stale_out, void *out, U64 endt_us);
 #define ctrl_read_cached_process_memory_struct(machine_id, process, vaddr, is_stale_out, ptr, endt_us) ctrl_read_cached_process_memory((machine_id), (process), r1u64((vaddr), (vaddr)+(sizeof(*(ptr)))), (is_stale_out), (ptr), (endt_us))
 
+//- rjf: process memory reading
+internal U64 ctrl_process_read(CTRL_MachineID machine_id, DMN_Handle process, Rng1U64 range, void *dst);
+
 //- rjf: process memory writing
 internal B32 ctrl_process_write(CTRL_MachineID machine_id, DMN_Handle process, Rng1U64 range, void *src);
 
@@ -746,6 +861,9 @@ internal U64 ctrl_query_cached_tls_root_vaddr_from_thread(CTRL_EntityStore *stor
 internal U64 ctrl_query_cached_rip_from_thread(CTRL_EntityStore *store, CTRL_MachineID machine_id, DMN_Handle thread);
 internal U64 ctrl_query_cached_rsp_from_thread(CTRL_EntityStore *store, CTRL_MachineID machine_id, DMN_Handle thread);
 
+//- rjf: thread register reading
+internal B32 ctrl_thread_read_reg_block(CTRL_MachineID machine_id, DMN_Handle thread, void *block);
+
 //- rjf: thread register writing
 internal B32 ctrl_thread_write_reg_block(CTRL_MachineID machine_id, DMN_Handle thread, void *block);
 
@@ -786,6 +904,8 @@ internal void ctrl_halt(void);
 internal U64 ctrl_run_gen(void);
 internal U64 ctrl_mem_gen(void);
 internal U64 ctrl_reg_gen(void);
+internal U64 ctrl_mem_gen_from_machine_id(CTRL_MachineID machine_id);
+internal U64 ctrl_reg_gen_from_machine_id(CTRL_MachineID machine_id);
 
 //- rjf: name -> register/alias hash tables, for eval
 internal EVAL_String2NumMap *ctrl_string2reg_from_arch(Architecture arch);
@@ -806,6 +926,9 @@ internal CTRL_EventList ctrl_c2u_pop_events(Arena *arena);
 internal void ctrl_thread__entry_point(void *p);
 
 //- rjf: breakpoint resolution
+internal void ctrl_thread__user_bp_set_update(CTRL_UserBreakpointList *user_bps);
+internal CTRL_ResolvedUserBreakpointCacheNode *ctrl_thread__resolved_user_bps_from_dbgi_key(DI_Key *dbgi_key);
+internal B32 ctrl_thread__dbgi_key_has_resolved_user_bps(DI_Key *dbgi_key);
 internal void ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_MachineID machine_id, DMN_Handle process, DMN_Handle module, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out);
 internal void ctrl_thread__append_resolved_process_user_bp_traps(Arena *arena, CTRL_MachineID machine_id, DMN_Handle process, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out);
 
@@ -813,6 +936,9 @@ internal void ctrl_thread__append_resolved_process_user_bp_traps(Arena *arena, C
 internal void ctrl_thread__module_open(CTRL_MachineID machine_id, DMN_Handle process, DMN_Handle module, Rng1U64 vaddr_range, String8 path);
 internal void ctrl_thread__module_close(CTRL_MachineID machine_id, DMN_Handle module);
 
+//- rjf: debug info prefetching
+internal void ctrl_thread__prefetch_stop_debug_info(CTRL_MachineID machine_id, DMN_Handle process, DMN_Handle thread);
+
 //- rjf: attached process running/event gathering
 internal DMN_Event *ctrl_thread__next_dmn_event(Arena *arena, DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg, DMN_RunCtrls *run_ctrls, CTRL_Spoof *spoof);
 
@@ -2,3 +2,6 @@
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
 #include "ctrl_core.c"
+#if OS_FEATURE_SOCKET
+#include "remote/ctrl_remote.c"
+#endif
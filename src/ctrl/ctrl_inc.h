@@ -73,5 +73,8 @@
 // the pre-spoof return address, and resume execution.
 
 #include "ctrl_core.h"
+#if OS_FEATURE_SOCKET
+#include "remote/ctrl_remote.h"
+#endif
 
 #endif // CTRL_INC_H
@@ -0,0 +1,983 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Globals
+
+global CTRL_RemoteAgent *ctrl_remote_agent = 0;
+global CTRL_RemoteAgentTarget ctrl_remote_agent_demon_target =
+{
+  dmn_process_read,
+  dmn_arch_from_thread,
+  dmn_thread_read_reg_block,
+};
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void
+ctrl_remote_init(void)
+{
+  Arena *arena = arena_alloc();
+  ctrl_remote_shared = push_array(arena, CTRL_RemoteShared, 1);
+  ctrl_remote_shared->arena = arena;
+  ctrl_remote_shared->clients_rw_mutex = os_rw_mutex_alloc();
+}
+
+////////////////////////////////
+//~ rjf: Frame Encoding/Decoding
+
+internal void
+ctrl_remote_record_list_push(Arena *arena, String8List *frame, CTRL_RemoteRecordKind kind, U64 id, String8 payload)
+{
+  CTRL_RemoteRecordHeader *header = push_array(arena, CTRL_RemoteRecordHeader, 1);
+  header->kind = (U32)kind;
+  header->size = (U32)payload.size;
+  header->id   = id;
+  str8_list_push(arena, frame, str8_struct(header));
+  if(payload.size != 0)
+  {
+    str8_list_push(arena, frame, payload);
+  }
+}
+
+internal B32
+ctrl_remote_record_from_frame(String8 frame, U64 *off, CTRL_RemoteRecord *record_out)
+{
+  B32 result = 0;
+  CTRL_RemoteRecordHeader header = {0};
+  if(*off + sizeof(header) <= frame.size)
+  {
+    MemoryCopy(&header, frame.str + *off, sizeof(header));
+    U64 payload_off = *off + sizeof(header);
+    if(header.size <= frame.size - payload_off)
+    {
+      record_out->kind    = (CTRL_RemoteRecordKind)header.kind;
+      record_out->id      = header.id;
+      record_out->payload = str8(frame.str + payload_off, header.size);
+      *off = payload_off + header.size;
+      result = 1;
+    }
+  }
+  return result;
+}
+
+internal B32
+ctrl_remote_write_frame(OS_Socket *socket, OS_Handle write_mutex, String8List *frame)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8 frame_joined = str8_list_join(scratch.arena, frame, 0);
+  B32 result = 0;
+  OS_MutexScope(write_mutex)
+  {
+    result = os_socket_write_string(socket, frame_joined);
+  }
+  scratch_end(scratch);
+  return result;
+}
+
+internal B32
+ctrl_remote_write_frame_if_full(OS_Socket *socket, OS_Handle write_mutex, String8List *frame, U64 next_payload_size)
+{
+  B32 result = 1;
+  if(frame->node_count != 0 && frame->total_size + sizeof(CTRL_RemoteRecordHeader) + next_payload_size > CTRL_REMOTE_FRAME_MAX)
+  {
+    result = ctrl_remote_write_frame(socket, write_mutex, frame);
+    MemoryZeroStruct(frame);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Agent
+
+internal CTRL_WAKEUP_FUNCTION_DEF(ctrl_remote_agent_wakeup_hook)
+{
+  CTRL_RemoteAgent *agent = ctrl_remote_agent;
+  if(agent != 0)
+  {
+    OS_MutexScope(agent->wakeup_mutex)
+    {
+      agent->wakeup_count += 1;
+    }
+    os_condition_variable_broadcast(agent->wakeup_cv);
+  }
+}
+
+internal U64
+ctrl_remote_agent_read_memory(CTRL_RemoteAgentTarget *target, DMN_Handle process, Rng1U64 range, void *out)
+{
+  U8 *data = (U8 *)out;
+  U64 size = dim_1u64(range);
+  U64 read_size = target->read_memory(process, range, data);
+  
+  // rjf: whole-range reads fail if any page is unreadable - retry
+  // page-by-page from the page of the first unread byte, until one fails. that
+  // page may begin before an unaligned range, so never start before the range.
+  if(read_size < size)
+  {
+    U64 page_vaddr = AlignDownPow2(range.min + read_size, CTRL_REMOTE_PAGE_SIZE);
+    read_size = Max(page_vaddr, range.min) - range.min;
+    for(;read_size < size;)
+    {
+      U64 vaddr = range.min + read_size;
+      U64 chunk_size = Min(size - read_size, AlignDownPow2(vaddr, CTRL_REMOTE_PAGE_SIZE) + CTRL_REMOTE_PAGE_SIZE - vaddr);
+      if(target->read_memory(process, r1u64(vaddr, vaddr+chunk_size), data+read_size) != chunk_size)
+      {
+        break;
+      }
+      read_size += chunk_size;
+    }
+  }
+  return read_size;
+}
+
+internal void
+ctrl_remote_agent_serve(OS_Socket *socket, String8 token, CTRL_RemoteAgentTarget *target)
+{
+  //- rjf: set up agent; route ctrl wakeups to the event thread, which is
+  // started once the client has authenticated
+  Arena *arena = arena_alloc();
+  CTRL_RemoteAgent *agent = push_array(arena, CTRL_RemoteAgent, 1);
+  agent->arena = arena;
+  agent->socket = socket;
+  agent->token = push_str8_copy(arena, token);
+  agent->target = (target != 0 ? *target : ctrl_remote_agent_demon_target);
+  agent->write_mutex = os_mutex_alloc();
+  agent->wakeup_mutex = os_mutex_alloc();
+  agent->wakeup_cv = os_condition_variable_alloc();
+  ctrl_remote_agent = agent;
+  ctrl_set_wakeup_hook(ctrl_remote_agent_wakeup_hook);
+
+  //- rjf: serve requests - every record in an incoming frame is handled, and
+  // responses are sent back in as few frames as fit
+  Temp scratch = scratch_begin(0, 0);
+  for(B32 done = 0; !done;)
+  {
+    temp_end(scratch);
+    String8 frame = os_socket_read(scratch.arena, socket, CTRL_REMOTE_FRAME_MAX);
+    if(frame.size == 0)
+    {
+      break;
+    }
+    String8List responses = {0};
+    CTRL_RemoteRecord record = {0};
+    for(U64 off = 0; !done && ctrl_remote_record_from_frame(frame, &off, &record);)
+    {
+      //- rjf: nothing but a hello is accepted from an unauthenticated client
+      if(!agent->authenticated && record.kind != CTRL_RemoteRecordKind_Hello)
+      {
+        done = 1;
+        break;
+      }
+      
+      //- rjf: handle record, producing at most one response
+      CTRL_RemoteRecordKind response_kind = CTRL_RemoteRecordKind_Null;
+      String8 response = {0};
+      switch(record.kind)
+      {
+        default:{}break;
+
+        //- rjf: handshake / teardown - the token is compared in full, whatever
+        // the first mismatching byte is
+        case CTRL_RemoteRecordKind_Hello:
+        {
+          U64 version = 0;
+          U64 token_off = str8_deserial_read_struct(record.payload, 0, &version);
+          String8 client_token = str8_skip(record.payload, token_off);
+          B32 token_good = (token_off != 0 && agent->token.size != 0 && client_token.size == agent->token.size);
+          U8 token_diff = 0;
+          for(U64 idx = 0; token_good && idx < agent->token.size; idx += 1)
+          {
+            token_diff |= (client_token.str[idx] ^ agent->token.str[idx]);
+          }
+          if(version == CTRL_REMOTE_PROTOCOL_VERSION && token_good && token_diff == 0)
+          {
+            U64 *our_version = push_array(scratch.arena, U64, 1);
+            *our_version = CTRL_REMOTE_PROTOCOL_VERSION;
+            response_kind = CTRL_RemoteRecordKind_Hello;
+            response = str8_struct(our_version);
+            if(!agent->authenticated)
+            {
+              agent->authenticated = 1;
+              agent->event_thread = os_launch_thread(ctrl_remote_agent_event_thread__entry_point, agent, 0);
+            }
+          }
+          else
+          {
+            response_kind = CTRL_RemoteRecordKind_Bye;
+            done = 1;
+          }
+        }break;
+        case CTRL_RemoteRecordKind_Bye:
+        {
+          response_kind = CTRL_RemoteRecordKind_Bye;
+          done = 1;
+        }break;
+        case CTRL_RemoteRecordKind_Ping:
+        {
+          response_kind = CTRL_RemoteRecordKind_Pong;
+          response = record.payload;
+        }break;
+
+        //- rjf: messages -> local ctrl thread; everything on this machine is
+        // local to the agent, whatever id the client uses for it
+        case CTRL_RemoteRecordKind_Msgs:
+        {
+          CTRL_MsgList msgs = ctrl_msg_list_from_serialized_string(scratch.arena, record.payload);
+          for(CTRL_MsgNode *n = msgs.first; n != 0; n = n->next)
+          {
+            n->v.machine_id = CTRL_MachineID_Local;
+            for(CTRL_MachineIDHandlePairNode *pair_n = n->v.freeze_state_threads.first; pair_n != 0; pair_n = pair_n->next)
+            {
+              pair_n->v.machine_id = CTRL_MachineID_Local;
+            }
+          }
+          ctrl_u2c_push_msgs(&msgs, max_U64);
+        }break;
+
+        //- rjf: memory reads - reply with the longest readable prefix
+        case CTRL_RemoteRecordKind_MemReadReq:
+        {
+          CTRL_RemoteMemReadReq req = {0};
+          str8_deserial_read_struct(record.payload, 0, &req);
+          U64 size = Min(dim_1u64(req.vaddr_range), CTRL_REMOTE_MEM_READ_REQUEST_MAX);
+          U8 *data = push_array_no_zero(scratch.arena, U8, size);
+          U64 read_size = ctrl_remote_agent_read_memory(&agent->target, req.process, r1u64(req.vaddr_range.min, req.vaddr_range.min+size), data);
+          response_kind = CTRL_RemoteRecordKind_MemReadResp;
+          response = str8(data, read_size);
+        }break;
+
+        //- rjf: register blocks
+        case CTRL_RemoteRecordKind_RegBlockReq:
+        {
+          DMN_Handle thread = {0};
+          str8_deserial_read_struct(record.payload, 0, &thread);
+          Architecture arch = agent->target.arch_from_thread(thread);
+          U64 block_size = regs_block_size_from_architecture(arch);
+          String8List parts = {0};
+          U64 *arch_u64 = push_array(scratch.arena, U64, 1);
+          *arch_u64 = (U64)arch;
+          void *block = push_array(scratch.arena, U8, block_size);
+          if(block_size != 0 && agent->target.read_reg_block(thread, block))
+          {
+            str8_list_push(scratch.arena, &parts, str8_struct(arch_u64));
+            str8_list_push(scratch.arena, &parts, str8((U8 *)block, block_size));
+          }
+          response_kind = CTRL_RemoteRecordKind_RegBlockResp;
+          response = str8_list_join(scratch.arena, &parts, 0);
+        }break;
+      }
+      
+      //- rjf: queue response, first sending what's queued if it would overflow
+      if(response_kind != CTRL_RemoteRecordKind_Null)
+      {
+        if(!ctrl_remote_write_frame_if_full(socket, agent->write_mutex, &responses, response.size))
+        {
+          done = 1;
+        }
+        ctrl_remote_record_list_push(scratch.arena, &responses, response_kind, record.id, response);
+      }
+    }
+    if(responses.node_count != 0 && !ctrl_remote_write_frame(socket, agent->write_mutex, &responses))
+    {
+      break;
+    }
+  }
+  scratch_end(scratch);
+
+  //- rjf: tear down event thread
+  OS_MutexScope(agent->wakeup_mutex)
+  {
+    agent->done = 1;
+  }
+  os_condition_variable_broadcast(agent->wakeup_cv);
+  if(agent->event_thread.u64[0] != 0)
+  {
+    os_thread_wait(agent->event_thread, max_U64);
+    os_release_thread_handle(agent->event_thread);
+  }
+  ctrl_set_wakeup_hook(0);
+  ctrl_remote_agent = 0;
+  os_condition_variable_release(agent->wakeup_cv);
+  os_mutex_release(agent->wakeup_mutex);
+  os_mutex_release(agent->write_mutex);
+  arena_release(arena);
+}
+
+internal void
+ctrl_remote_agent_event_thread__entry_point(void *p)
+{
+  CTRL_RemoteAgent *agent = (CTRL_RemoteAgent *)p;
+  ThreadNameF("[ctrl] remote agent event thread");
+  Temp scratch = scratch_begin(0, 0);
+  U64 last_wakeup_count = 0;
+  for(B32 done = 0; !done;)
+  {
+    temp_end(scratch);
+
+    //- rjf: wait for ctrl thread to produce events
+    OS_MutexScope(agent->wakeup_mutex)
+    {
+      for(;agent->wakeup_count == last_wakeup_count && !agent->done;)
+      {
+        os_condition_variable_wait(agent->wakeup_cv, agent->wakeup_mutex, max_U64);
+      }
+      last_wakeup_count = agent->wakeup_count;
+      done = agent->done;
+    }
+
+    //- rjf: send everything available as event batches, in as few frames as
+    // fit
+    CTRL_EventList events = ctrl_c2u_pop_events(scratch.arena);
+    String8List frame = {0};
+    for(CTRL_EventNode *n = events.first; n != 0;)
+    {
+      String8 batch = ctrl_serialized_string_from_event_list(scratch.arena, &n, CTRL_REMOTE_EVENT_BATCH_MAX);
+      ctrl_remote_write_frame_if_full(agent->socket, agent->write_mutex, &frame, batch.size);
+      ctrl_remote_record_list_push(scratch.arena, &frame, CTRL_RemoteRecordKind_Events, 0, batch);
+    }
+    if(frame.node_count != 0)
+    {
+      ctrl_remote_write_frame(agent->socket, agent->write_mutex, &frame);
+    }
+  }
+  scratch_end(scratch);
+}
+
+////////////////////////////////
+//~ rjf: Client
+
+//- rjf: connection
+
+internal CTRL_RemoteClient *
+ctrl_remote_client_connect(String8 ip, String8 port, String8 token, CTRL_MachineID machine_id, CTRL_WakeupFunctionType *wakeup_hook, U64 endt_us)
+{
+  Arena *arena = arena_alloc();
+  CTRL_RemoteClient *client = push_array(arena, CTRL_RemoteClient, 1);
+  client->arena = arena;
+  client->machine_id = machine_id;
+  client->wakeup_hook = wakeup_hook;
+  client->write_mutex = os_mutex_alloc();
+  client->mutex = os_mutex_alloc();
+  client->cv = os_condition_variable_alloc();
+  client->next_request_id = 1;
+  client->events_arena = arena_alloc();
+  client->gen = 1;
+  client->cache_arena = arena_alloc();
+  client->page_slots = push_array(client->cache_arena, CTRL_RemotePageNode *, CTRL_REMOTE_PAGE_SLOTS_COUNT);
+  client->cache_gen = client->gen;
+
+  //- rjf: connect, start reading, shake hands
+  os_socket_connect(&client->socket, ip, port);
+  B32 good = (os_socket_status(&client->socket, OS_SocketStatus_Connected) && token.size <= CTRL_REMOTE_TOKEN_SIZE_MAX);
+  if(good)
+  {
+    client->connected = 1;
+    client->reader_thread = os_launch_thread(ctrl_remote_client_reader_thread__entry_point, client, 0);
+    Temp scratch = scratch_begin(0, 0);
+    U64 version = CTRL_REMOTE_PROTOCOL_VERSION;
+    String8List hello = {0};
+    str8_list_push(scratch.arena, &hello, str8_struct(&version));
+    str8_list_push(scratch.arena, &hello, token);
+    String8List frame = {0};
+    ctrl_remote_record_list_push(scratch.arena, &frame, CTRL_RemoteRecordKind_Hello, 0, str8_list_join(scratch.arena, &hello, 0));
+    good = ctrl_remote_write_frame(&client->socket, client->write_mutex, &frame);
+    OS_MutexScope(client->mutex)
+    {
+      for(;good && client->connected && client->agent_version == 0 && os_now_microseconds() < endt_us;)
+      {
+        os_condition_variable_wait(client->cv, client->mutex, endt_us);
+      }
+      good = (good && client->connected && client->agent_version == CTRL_REMOTE_PROTOCOL_VERSION);
+    }
+    scratch_end(scratch);
+  }
+
+  //- rjf: success -> register, so that anything addressed to this machine is
+  // routed here
+  if(good)
+  {
+    OS_MutexScopeW(ctrl_remote_shared->clients_rw_mutex)
+    {
+      DLLPushBack(ctrl_remote_shared->first_client, ctrl_remote_shared->last_client, client);
+    }
+  }
+  
+  //- rjf: failure -> tear down
+  else
+  {
+    ctrl_remote_client_disconnect(client);
+    client = 0;
+  }
+  return client;
+}
+
+internal void
+ctrl_remote_client_disconnect(CTRL_RemoteClient *client)
+{
+  //- rjf: unregister - routed reads & pushes hold the registry lock while they
+  // use the client, so none are in flight past this point
+  OS_MutexScopeW(ctrl_remote_shared->clients_rw_mutex)
+  {
+    for(CTRL_RemoteClient *c = ctrl_remote_shared->first_client; c != 0; c = c->next)
+    {
+      if(c == client)
+      {
+        DLLRemove(ctrl_remote_shared->first_client, ctrl_remote_shared->last_client, client);
+        break;
+      }
+    }
+  }
+  
+  //- rjf: say goodbye, then shut the socket down, so the reader thread's
+  // blocking read returns whether or not the agent answers
+  if(client->reader_thread.u64[0] != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8List frame = {0};
+    ctrl_remote_record_list_push(scratch.arena, &frame, CTRL_RemoteRecordKind_Bye, 0, str8_zero());
+    ctrl_remote_write_frame(&client->socket, client->write_mutex, &frame);
+    scratch_end(scratch);
+    os_socket_shutdown(&client->socket);
+    os_thread_wait(client->reader_thread, max_U64);
+    os_release_thread_handle(client->reader_thread);
+  }
+
+  //- rjf: release
+  os_socket_close(&client->socket);
+  os_condition_variable_release(client->cv);
+  os_mutex_release(client->mutex);
+  os_mutex_release(client->write_mutex);
+  arena_release(client->cache_arena);
+  arena_release(client->events_arena);
+  arena_release(client->arena);
+}
+
+internal B32
+ctrl_remote_client_is_connected(CTRL_RemoteClient *client)
+{
+  B32 result = 0;
+  OS_MutexScope(client->mutex)
+  {
+    result = client->connected;
+  }
+  return result;
+}
+
+internal CTRL_RemoteClientStats
+ctrl_remote_client_stats(CTRL_RemoteClient *client)
+{
+  CTRL_RemoteClientStats result = {0};
+  OS_MutexScope(client->mutex)
+  {
+    result = client->stats;
+  }
+  return result;
+}
+
+internal U64
+ctrl_remote_client_gen(CTRL_RemoteClient *client)
+{
+  U64 result = 0;
+  OS_MutexScope(client->mutex)
+  {
+    result = client->gen;
+  }
+  return result;
+}
+
+//- rjf: registry
+
+internal CTRL_RemoteClient *
+ctrl_remote_client_from_machine_id__locked(CTRL_MachineID machine_id)
+{
+  CTRL_RemoteClient *result = 0;
+  for(CTRL_RemoteClient *c = ctrl_remote_shared->first_client; c != 0; c = c->next)
+  {
+    if(c->machine_id == machine_id)
+    {
+      result = c;
+      break;
+    }
+  }
+  return result;
+}
+
+//- rjf: messages & events
+
+internal B32
+ctrl_remote_client_push_msgs(CTRL_RemoteClient *client, CTRL_MsgList *msgs)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8 msgs_srlzed = ctrl_serialized_string_from_msg_list(scratch.arena, msgs);
+  B32 good = (sizeof(CTRL_RemoteRecordHeader) + msgs_srlzed.size <= CTRL_REMOTE_FRAME_MAX);
+  if(good)
+  {
+    String8List frame = {0};
+    ctrl_remote_record_list_push(scratch.arena, &frame, CTRL_RemoteRecordKind_Msgs, 0, msgs_srlzed);
+    OS_MutexScope(client->mutex)
+    {
+      client->gen += 1;
+      client->stats.frames_sent += 1;
+    }
+    good = ctrl_remote_write_frame(&client->socket, client->write_mutex, &frame);
+  }
+  scratch_end(scratch);
+  return good;
+}
+
+internal CTRL_EventList
+ctrl_remote_client_pop_events(Arena *arena, CTRL_RemoteClient *client)
+{
+  //- rjf: pull all batches, copied into the output arena
+  String8List batches = {0};
+  OS_MutexScope(client->mutex)
+  {
+    for(String8Node *n = client->event_batches.first; n != 0; n = n->next)
+    {
+      str8_list_push(arena, &batches, push_str8_copy(arena, n->string));
+    }
+    MemoryZeroStruct(&client->event_batches);
+    arena_clear(client->events_arena);
+  }
+
+  //- rjf: decode batches - event strings point into the batch data; entities
+  // on the agent's machine are tagged with this client's machine id
+  CTRL_EventList events = {0};
+  for(String8Node *n = batches.first; n != 0; n = n->next)
+  {
+    CTRL_EventList batch_events = ctrl_event_list_from_serialized_string(arena, n->string);
+    ctrl_event_list_concat_in_place(&events, &batch_events);
+  }
+  for(CTRL_EventNode *n = events.first; n != 0; n = n->next)
+  {
+    n->v.machine_id = client->machine_id;
+  }
+  return events;
+}
+
+//- rjf: cache helpers
+
+internal void
+ctrl_remote_client_cache_reset_if_stale__locked(CTRL_RemoteClient *client)
+{
+  if(client->pending_mem_read_count == 0 &&
+     (client->cache_gen != client->gen || client->page_count >= CTRL_REMOTE_PAGE_CACHE_CAP))
+  {
+    arena_clear(client->cache_arena);
+    client->page_slots = push_array(client->cache_arena, CTRL_RemotePageNode *, CTRL_REMOTE_PAGE_SLOTS_COUNT);
+    client->page_count = 0;
+    client->first_reg_block = 0;
+    client->cache_gen = client->gen;
+  }
+}
+
+internal CTRL_RemotePageNode *
+ctrl_remote_client_page_from_vaddr__locked(CTRL_RemoteClient *client, DMN_Handle process, U64 vaddr)
+{
+  U64 hash = ctrl_hash_from_machine_id_handle(CTRL_MachineID_Local, process) ^ (vaddr/CTRL_REMOTE_PAGE_SIZE)*0x9e3779b97f4a7c15ull;
+  U64 slot_idx = hash%CTRL_REMOTE_PAGE_SLOTS_COUNT;
+  CTRL_RemotePageNode *page = 0;
+  for(CTRL_RemotePageNode *n = client->page_slots[slot_idx]; n != 0; n = n->next)
+  {
+    if(n->vaddr == vaddr && dmn_handle_match(n->process, process))
+    {
+      page = n;
+      break;
+    }
+  }
+  if(page == 0)
+  {
+    page = push_array_no_zero(client->cache_arena, CTRL_RemotePageNode, 1);
+    page->next = client->page_slots[slot_idx];
+    page->process = process;
+    page->vaddr = vaddr;
+    page->gen = 0;
+    page->valid_size = 0;
+    page->is_pending = 0;
+    client->page_slots[slot_idx] = page;
+    client->page_count += 1;
+  }
+  return page;
+}
+
+//- rjf: requests
+
+internal CTRL_RemoteRequest *
+ctrl_remote_client_request_alloc__locked(CTRL_RemoteClient *client, CTRL_RemoteRecordKind kind)
+{
+  CTRL_RemoteRequest *request = client->free_request;
+  if(request != 0)
+  {
+    SLLStackPop(client->free_request);
+  }
+  else
+  {
+    request = push_array_no_zero(client->arena, CTRL_RemoteRequest, 1);
+  }
+  MemoryZeroStruct(request);
+  request->kind = kind;
+  request->id = client->next_request_id;
+  client->next_request_id += 1;
+  DLLPushBack(client->first_request, client->last_request, request);
+  return request;
+}
+
+internal void
+ctrl_remote_client_request_release__locked(CTRL_RemoteClient *client, CTRL_RemoteRequest *request)
+{
+  DLLRemove(client->first_request, client->last_request, request);
+  SLLStackPush(client->free_request, request);
+}
+
+internal String8
+ctrl_remote_client_request_roundtrip(Arena *arena, CTRL_RemoteClient *client, CTRL_RemoteRecordKind kind, String8 payload, U64 endt_us)
+{
+  String8 result = {0};
+  Temp scratch = scratch_begin(&arena, 1);
+
+  //- rjf: register request
+  CTRL_RemoteRequest *request = 0;
+  String8List frame = {0};
+  OS_MutexScope(client->mutex) if(client->connected && sizeof(CTRL_RemoteRecordHeader) + payload.size <= CTRL_REMOTE_FRAME_MAX)
+  {
+    request = ctrl_remote_client_request_alloc__locked(client, kind);
+    request->arena = arena;
+    client->stats.frames_sent += 1;
+    ctrl_remote_record_list_push(scratch.arena, &frame, kind, request->id, payload);
+  }
+
+  //- rjf: send, wait for response; the reader thread copies the response
+  // into `arena` while this thread waits
+  if(request != 0)
+  {
+    ctrl_remote_write_frame(&client->socket, client->write_mutex, &frame);
+    OS_MutexScope(client->mutex)
+    {
+      for(;!request->done && os_now_microseconds() < endt_us;)
+      {
+        os_condition_variable_wait(client->cv, client->mutex, endt_us);
+      }
+      result = request->response;
+      ctrl_remote_client_request_release__locked(client, request);
+    }
+  }
+
+  scratch_end(scratch);
+  return result;
+}
+
+//- rjf: memory & registers
+
+internal U64
+ctrl_remote_client_read_memory(CTRL_RemoteClient *client, DMN_Handle process, Rng1U64 range, void *out, U64 endt_us)
+{
+  U64 result = 0;
+  if(range.max > range.min)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    range.max = range.min + Min(dim_1u64(range), CTRL_REMOTE_MEM_READ_REQUEST_MAX);
+    U64 first_page_vaddr = AlignDownPow2(range.min, CTRL_REMOTE_PAGE_SIZE);
+    U64 opl_page_vaddr = AlignDownPow2(range.max-1, CTRL_REMOTE_PAGE_SIZE) + CTRL_REMOTE_PAGE_SIZE;
+    for(B32 done = 0; !done;)
+    {
+      String8List frame = {0};
+      OS_MutexScope(client->mutex)
+      {
+        ctrl_remote_client_cache_reset_if_stale__locked(client);
+
+        //- rjf: scan pages - start fetching stale pages, coalescing runs of
+        // contiguous stale pages into single requests; pages another reader
+        // is already fetching are waited on
+        B32 all_ready = 1;
+        CTRL_RemoteRequest *run = 0;
+        for(U64 vaddr = first_page_vaddr; vaddr != opl_page_vaddr; vaddr += CTRL_REMOTE_PAGE_SIZE)
+        {
+          CTRL_RemotePageNode *page = ctrl_remote_client_page_from_vaddr__locked(client, process, vaddr);
+          if(page->is_pending)
+          {
+            all_ready = 0;
+            run = 0;
+          }
+          else if(page->gen != client->gen && !client->connected)
+          {
+            page->gen = client->gen;
+            page->valid_size = 0;
+            run = 0;
+          }
+          else if(page->gen != client->gen)
+          {
+            all_ready = 0;
+            page->is_pending = 1;
+            page->gen = client->gen;
+            page->valid_size = 0;
+            client->stats.page_misses += 1;
+            if(run != 0 && run->mem_read.vaddr_range.max == vaddr)
+            {
+              run->mem_read.vaddr_range.max += CTRL_REMOTE_PAGE_SIZE;
+            }
+            else
+            {
+              run = ctrl_remote_client_request_alloc__locked(client, CTRL_RemoteRecordKind_MemReadReq);
+              run->mem_read.process = process;
+              run->mem_read.vaddr_range = r1u64(vaddr, vaddr + CTRL_REMOTE_PAGE_SIZE);
+              client->pending_mem_read_count += 1;
+              client->stats.mem_read_requests += 1;
+              ctrl_remote_record_list_push(scratch.arena, &frame, CTRL_RemoteRecordKind_MemReadReq, run->id, str8_struct(&run->mem_read));
+            }
+          }
+          else
+          {
+            client->stats.page_hits += 1;
+            run = 0;
+          }
+        }
+
+        //- rjf: all pages ready -> copy out the readable prefix of the range
+        if(all_ready)
+        {
+          done = 1;
+          for(U64 vaddr = first_page_vaddr; vaddr != opl_page_vaddr; vaddr += CTRL_REMOTE_PAGE_SIZE)
+          {
+            CTRL_RemotePageNode *page = ctrl_remote_client_page_from_vaddr__locked(client, process, vaddr);
+            U64 copy_min = Max(range.min, vaddr) - vaddr;
+            U64 copy_max = Min(range.max - vaddr, CTRL_REMOTE_PAGE_SIZE);
+            U64 copy_opl = Min(copy_max, page->valid_size);
+            if(copy_opl > copy_min)
+            {
+              MemoryCopy((U8 *)out + result, page->data + copy_min, copy_opl - copy_min);
+              result += copy_opl - copy_min;
+            }
+            if(copy_opl < copy_max)
+            {
+              break;
+            }
+          }
+        }
+
+        //- rjf: waiting on other fetches -> wait for the reader thread
+        else if(frame.node_count == 0)
+        {
+          if(os_now_microseconds() >= endt_us)
+          {
+            done = 1;
+          }
+          else
+          {
+            os_condition_variable_wait(client->cv, client->mutex, endt_us);
+          }
+        }
+
+        //- rjf: fetches started -> count frame
+        else
+        {
+          client->stats.frames_sent += 1;
+        }
+      }
+
+      //- rjf: send all new fetches as a single frame
+      if(frame.node_count != 0)
+      {
+        ctrl_remote_write_frame(&client->socket, client->write_mutex, &frame);
+      }
+    }
+    scratch_end(scratch);
+  }
+  return result;
+}
+
+internal void *
+ctrl_remote_client_reg_block_from_thread(Arena *arena, CTRL_RemoteClient *client, DMN_Handle thread, Architecture *arch_out, U64 endt_us)
+{
+  void *result = 0;
+  Architecture arch = Architecture_Null;
+
+  //- rjf: try cache
+  U64 gen = 0;
+  OS_MutexScope(client->mutex)
+  {
+    ctrl_remote_client_cache_reset_if_stale__locked(client);
+    gen = client->gen;
+    for(CTRL_RemoteRegBlockNode *n = client->first_reg_block; n != 0; n = n->next)
+    {
+      if(n->gen == gen && dmn_handle_match(n->thread, thread))
+      {
+        arch = n->arch;
+        result = push_str8_copy(arena, n->block).str;
+        break;
+      }
+    }
+    if(result != 0)
+    {
+      client->stats.reg_block_hits += 1;
+    }
+    else
+    {
+      client->stats.reg_block_misses += 1;
+    }
+  }
+
+  //- rjf: miss -> ask agent; store result if target state hasn't moved since
+  if(result == 0)
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    String8 response = ctrl_remote_client_request_roundtrip(scratch.arena, client, CTRL_RemoteRecordKind_RegBlockReq, str8_struct(&thread), endt_us);
+    U64 response_arch = 0;
+    U64 block_off = str8_deserial_read_struct(response, 0, &response_arch);
+    String8 block = str8_skip(response, block_off);
+    if(block_off != 0 && block.size != 0 && block.size == regs_block_size_from_architecture((Architecture)response_arch))
+    {
+      arch = (Architecture)response_arch;
+      result = push_str8_copy(arena, block).str;
+      OS_MutexScope(client->mutex) if(client->gen == gen && client->cache_gen == gen)
+      {
+        CTRL_RemoteRegBlockNode *node = push_array(client->cache_arena, CTRL_RemoteRegBlockNode, 1);
+        SLLStackPush(client->first_reg_block, node);
+        node->thread = thread;
+        node->gen = gen;
+        node->arch = arch;
+        node->block = push_str8_copy(client->cache_arena, block);
+      }
+    }
+    scratch_end(scratch);
+  }
+
+  if(arch_out != 0)
+  {
+    *arch_out = arch;
+  }
+  return result;
+}
+
+internal B32
+ctrl_remote_client_ping(CTRL_RemoteClient *client, U64 endt_us)
+{
+  Temp scratch = scratch_begin(0, 0);
+  U64 stamp = os_now_microseconds();
+  String8 response = ctrl_remote_client_request_roundtrip(scratch.arena, client, CTRL_RemoteRecordKind_Ping, str8_struct(&stamp), endt_us);
+  B32 result = str8_match(response, str8_struct(&stamp), 0);
+  scratch_end(scratch);
+  return result;
+}
+
+//- rjf: reader thread
+
+internal void
+ctrl_remote_client_reader_thread__entry_point(void *p)
+{
+  CTRL_RemoteClient *client = (CTRL_RemoteClient *)p;
+  ThreadNameF("[ctrl] remote client reader thread");
+  Temp scratch = scratch_begin(0, 0);
+  for(B32 done = 0; !done;)
+  {
+    temp_end(scratch);
+    String8 frame = os_socket_read(scratch.arena, &client->socket, CTRL_REMOTE_FRAME_MAX);
+    if(frame.size == 0)
+    {
+      break;
+    }
+    B32 got_events = 0;
+    OS_MutexScope(client->mutex)
+    {
+      client->stats.frames_received += 1;
+      CTRL_RemoteRecord record = {0};
+      for(U64 off = 0; ctrl_remote_record_from_frame(frame, &off, &record);)
+      {
+        //- rjf: find matching request
+        CTRL_RemoteRequest *request = 0;
+        if(record.id != 0)
+        {
+          for(CTRL_RemoteRequest *r = client->first_request; r != 0; r = r->next)
+          {
+            if(r->id == record.id)
+            {
+              request = r;
+              break;
+            }
+          }
+        }
+
+        //- rjf: apply record
+        switch(record.kind)
+        {
+          default:{}break;
+          case CTRL_RemoteRecordKind_Hello:
+          {
+            str8_deserial_read_struct(record.payload, 0, &client->agent_version);
+          }break;
+          case CTRL_RemoteRecordKind_Bye:
+          {
+            done = 1;
+          }break;
+          case CTRL_RemoteRecordKind_Events:
+          {
+            str8_list_push(client->events_arena, &client->event_batches, push_str8_copy(client->events_arena, record.payload));
+            client->gen += 1;
+            got_events = 1;
+          }break;
+          case CTRL_RemoteRecordKind_Pong:
+          case CTRL_RemoteRecordKind_RegBlockResp:
+          case CTRL_RemoteRecordKind_MemReadResp:
+          if(request != 0 && request->arena != 0)
+          {
+            // rjf: round trips - response copied out to the waiter
+            request->response = push_str8_copy(request->arena, record.payload);
+            request->done = 1;
+          }
+          else if(request != 0 && record.kind == CTRL_RemoteRecordKind_MemReadResp && request->kind == CTRL_RemoteRecordKind_MemReadReq)
+          {
+            // rjf: page fetches - response filled into the page cache
+            Rng1U64 vaddr_range = request->mem_read.vaddr_range;
+            for(U64 vaddr = vaddr_range.min; vaddr < vaddr_range.max; vaddr += CTRL_REMOTE_PAGE_SIZE)
+            {
+              CTRL_RemotePageNode *page = ctrl_remote_client_page_from_vaddr__locked(client, request->mem_read.process, vaddr);
+              U64 payload_off = vaddr - vaddr_range.min;
+              page->valid_size = (payload_off < record.payload.size) ? Min(record.payload.size - payload_off, CTRL_REMOTE_PAGE_SIZE) : 0;
+              MemoryCopy(page->data, record.payload.str + payload_off, page->valid_size);
+              page->is_pending = 0;
+            }
+            client->pending_mem_read_count -= 1;
+            ctrl_remote_client_request_release__locked(client, request);
+          }break;
+        }
+      }
+      os_condition_variable_broadcast(client->cv);
+    }
+    if(got_events && client->wakeup_hook != 0)
+    {
+      client->wakeup_hook();
+    }
+  }
+  scratch_end(scratch);
+
+  //- rjf: disconnected -> fail everything still in flight
+  OS_MutexScope(client->mutex)
+  {
+    client->connected = 0;
+    for(CTRL_RemoteRequest *r = client->first_request, *next = 0; r != 0; r = next)
+    {
+      next = r->next;
+      if(r->kind == CTRL_RemoteRecordKind_MemReadReq && r->arena == 0)
+      {
+        for(U64 vaddr = r->mem_read.vaddr_range.min; vaddr < r->mem_read.vaddr_range.max; vaddr += CTRL_REMOTE_PAGE_SIZE)
+        {
+          CTRL_RemotePageNode *page = ctrl_remote_client_page_from_vaddr__locked(client, r->mem_read.process, vaddr);
+          page->valid_size = 0;
+          page->is_pending = 0;
+        }
+        client->pending_mem_read_count -= 1;
+        ctrl_remote_client_request_release__locked(client, r);
+      }
+      else
+      {
+        r->done = 1;
+      }
+    }
+    os_condition_variable_broadcast(client->cv);
+  }
+  if(client->wakeup_hook != 0)
+  {
+    client->wakeup_hook();
+  }
+}
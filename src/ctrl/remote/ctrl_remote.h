@@ -0,0 +1,291 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef CTRL_REMOTE_H
+#define CTRL_REMOTE_H
+
+// NOTE: This layer carries the ctrl user <-> ctrl thread boundary over a
+// socket, so that the demon & ctrl thread can run on the target machine (the
+// "agent"), while the frontend runs elsewhere (the "client").
+//
+// Both directions send frames; a frame is one os_socket message, containing a
+// sequence of records. Each record has a small header (kind, payload size,
+// request id), followed by its payload. Anything produced together is sent
+// together - all events popped in one wakeup, all responses to one incoming
+// frame, and all missing-page requests for one memory read go out as a single
+// frame, so the number of round trips is bounded by the number of user-level
+// operations, not by the number of records.
+//
+// Requests are pipelined - a client never waits for one response before
+// sending the next request. Responses are matched to requests by id.
+//
+// A client must present the agent's token in its hello before anything else
+// is accepted; the agent drops the connection otherwise. Frames are bounded by
+// CTRL_REMOTE_FRAME_MAX in both directions, and senders split their output
+// into several frames to stay within it.
+//
+// The client keeps a page cache for target memory & a cache of register
+// blocks. Both are keyed by a generation which is bumped whenever messages are
+// sent to the agent or events arrive from it, i.e. whenever target state may
+// have changed. A memory read which misses coalesces contiguous missing pages
+// into one request, and pages already being fetched by another reader are
+// waited on, rather than requested again.
+//
+// Connected clients are registered by machine id, so that the control layer's
+// entry points (message pushes, memory & register reads) can route anything
+// addressed to a remote machine to its client.
+
+////////////////////////////////
+//~ rjf: Protocol Constants
+
+#define CTRL_REMOTE_PROTOCOL_VERSION 1
+#define CTRL_REMOTE_PAGE_SIZE KB(4)
+#define CTRL_REMOTE_PAGE_SLOTS_COUNT 1024
+#define CTRL_REMOTE_PAGE_CACHE_CAP 4096
+#define CTRL_REMOTE_MEM_READ_REQUEST_MAX MB(1)
+#define CTRL_REMOTE_EVENT_BATCH_MAX KB(64)
+#define CTRL_REMOTE_TOKEN_SIZE_MAX 256
+#define CTRL_REMOTE_FRAME_MAX (CTRL_REMOTE_MEM_READ_REQUEST_MAX + KB(64))
+#define CTRL_REMOTE_ROUTED_READ_TIMEOUT_US 1000000
+
+////////////////////////////////
+//~ rjf: Protocol Types
+
+typedef enum CTRL_RemoteRecordKind
+{
+  CTRL_RemoteRecordKind_Null,
+  CTRL_RemoteRecordKind_Hello,        // both ways: U64 protocol version; client -> agent: then the agent's token
+  CTRL_RemoteRecordKind_Bye,          // both ways: no payload; ends the session
+  CTRL_RemoteRecordKind_Ping,         // client -> agent: any payload
+  CTRL_RemoteRecordKind_Pong,         // agent -> client: ping's payload
+  CTRL_RemoteRecordKind_Msgs,         // client -> agent: serialized CTRL_MsgList
+  CTRL_RemoteRecordKind_Events,       // agent -> client: serialized CTRL_Event batch
+  CTRL_RemoteRecordKind_MemReadReq,   // client -> agent: CTRL_RemoteMemReadReq
+  CTRL_RemoteRecordKind_MemReadResp,  // agent -> client: bytes read, from the start of the requested range
+  CTRL_RemoteRecordKind_RegBlockReq,  // client -> agent: DMN_Handle of thread
+  CTRL_RemoteRecordKind_RegBlockResp, // agent -> client: U64 architecture, then the register block
+  CTRL_RemoteRecordKind_COUNT
+}
+CTRL_RemoteRecordKind;
+
+typedef struct CTRL_RemoteRecordHeader CTRL_RemoteRecordHeader;
+struct CTRL_RemoteRecordHeader
+{
+  U32 kind;
+  U32 size;
+  U64 id;
+};
+
+typedef struct CTRL_RemoteMemReadReq CTRL_RemoteMemReadReq;
+struct CTRL_RemoteMemReadReq
+{
+  DMN_Handle process;
+  Rng1U64 vaddr_range;
+};
+
+typedef struct CTRL_RemoteRecord CTRL_RemoteRecord;
+struct CTRL_RemoteRecord
+{
+  CTRL_RemoteRecordKind kind;
+  U64 id;
+  String8 payload;
+};
+
+////////////////////////////////
+//~ rjf: Agent Types
+
+// rjf: where the agent reads target state from - the demon, unless replaced
+// (e.g. by a synthetic target for self-tests)
+typedef U64 CTRL_RemoteAgentReadMemoryFunctionType(DMN_Handle process, Rng1U64 range, void *dst);
+typedef Architecture CTRL_RemoteAgentArchFromThreadFunctionType(DMN_Handle thread);
+typedef B32 CTRL_RemoteAgentReadRegBlockFunctionType(DMN_Handle thread, void *reg_block);
+
+typedef struct CTRL_RemoteAgentTarget CTRL_RemoteAgentTarget;
+struct CTRL_RemoteAgentTarget
+{
+  CTRL_RemoteAgentReadMemoryFunctionType *read_memory;
+  CTRL_RemoteAgentArchFromThreadFunctionType *arch_from_thread;
+  CTRL_RemoteAgentReadRegBlockFunctionType *read_reg_block;
+};
+
+typedef struct CTRL_RemoteAgent CTRL_RemoteAgent;
+struct CTRL_RemoteAgent
+{
+  Arena *arena;
+  OS_Socket *socket;
+  String8 token;
+  CTRL_RemoteAgentTarget target;
+  B32 authenticated;
+  OS_Handle write_mutex;
+  OS_Handle wakeup_mutex;
+  OS_Handle wakeup_cv;
+  U64 wakeup_count;
+  B32 done;
+  OS_Handle event_thread;
+};
+
+////////////////////////////////
+//~ rjf: Client Types
+
+typedef struct CTRL_RemotePageNode CTRL_RemotePageNode;
+struct CTRL_RemotePageNode
+{
+  CTRL_RemotePageNode *next;
+  DMN_Handle process;
+  U64 vaddr;
+  U64 gen;
+  U64 valid_size;
+  B32 is_pending;
+  U8 data[CTRL_REMOTE_PAGE_SIZE];
+};
+
+typedef struct CTRL_RemoteRegBlockNode CTRL_RemoteRegBlockNode;
+struct CTRL_RemoteRegBlockNode
+{
+  CTRL_RemoteRegBlockNode *next;
+  DMN_Handle thread;
+  U64 gen;
+  Architecture arch;
+  String8 block;
+};
+
+typedef struct CTRL_RemoteRequest CTRL_RemoteRequest;
+struct CTRL_RemoteRequest
+{
+  CTRL_RemoteRequest *next;
+  CTRL_RemoteRequest *prev;
+  CTRL_RemoteRecordKind kind;
+  U64 id;
+
+  // rjf: page fetches - filled into page cache
+  CTRL_RemoteMemReadReq mem_read;
+
+  // rjf: round trips (everything with an arena, including uncached memory
+  // reads) - response copied into waiter's arena
+  Arena *arena;
+  B32 done;
+  String8 response;
+};
+
+typedef struct CTRL_RemoteClientStats CTRL_RemoteClientStats;
+struct CTRL_RemoteClientStats
+{
+  U64 frames_sent;
+  U64 frames_received;
+  U64 mem_read_requests;
+  U64 page_hits;
+  U64 page_misses;
+  U64 reg_block_hits;
+  U64 reg_block_misses;
+};
+
+typedef struct CTRL_RemoteClient CTRL_RemoteClient;
+struct CTRL_RemoteClient
+{
+  CTRL_RemoteClient *next;
+  CTRL_RemoteClient *prev;
+  Arena *arena;
+  CTRL_MachineID machine_id;
+  CTRL_WakeupFunctionType *wakeup_hook;
+  OS_Socket socket;
+  OS_Handle write_mutex;
+  OS_Handle reader_thread;
+
+  // rjf: shared state (guarded by mutex)
+  OS_Handle mutex;
+  OS_Handle cv;
+  B32 connected;
+  U64 agent_version;
+  U64 next_request_id;
+  CTRL_RemoteRequest *first_request;
+  CTRL_RemoteRequest *last_request;
+  CTRL_RemoteRequest *free_request;
+  U64 pending_mem_read_count;
+  Arena *events_arena;
+  String8List event_batches;
+  CTRL_RemoteClientStats stats;
+
+  // rjf: caches (guarded by mutex)
+  U64 gen;
+  U64 cache_gen;
+  Arena *cache_arena;
+  CTRL_RemotePageNode **page_slots;
+  U64 page_count;
+  CTRL_RemoteRegBlockNode *first_reg_block;
+};
+
+////////////////////////////////
+//~ rjf: Shared State
+
+typedef struct CTRL_RemoteShared CTRL_RemoteShared;
+struct CTRL_RemoteShared
+{
+  Arena *arena;
+  
+  // rjf: connected clients, by machine id (guarded by clients_rw_mutex)
+  OS_Handle clients_rw_mutex;
+  CTRL_RemoteClient *first_client;
+  CTRL_RemoteClient *last_client;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global CTRL_RemoteShared *ctrl_remote_shared = 0;
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void ctrl_remote_init(void);
+
+////////////////////////////////
+//~ rjf: Frame Encoding/Decoding
+
+internal void ctrl_remote_record_list_push(Arena *arena, String8List *frame, CTRL_RemoteRecordKind kind, U64 id, String8 payload);
+internal B32 ctrl_remote_record_from_frame(String8 frame, U64 *off, CTRL_RemoteRecord *record_out);
+internal B32 ctrl_remote_write_frame(OS_Socket *socket, OS_Handle write_mutex, String8List *frame);
+internal B32 ctrl_remote_write_frame_if_full(OS_Socket *socket, OS_Handle write_mutex, String8List *frame, U64 next_payload_size);
+
+////////////////////////////////
+//~ rjf: Agent
+
+internal CTRL_WAKEUP_FUNCTION_DEF(ctrl_remote_agent_wakeup_hook);
+internal U64 ctrl_remote_agent_read_memory(CTRL_RemoteAgentTarget *target, DMN_Handle process, Rng1U64 range, void *out);
+internal void ctrl_remote_agent_serve(OS_Socket *socket, String8 token, CTRL_RemoteAgentTarget *target);
+internal void ctrl_remote_agent_event_thread__entry_point(void *p);
+
+////////////////////////////////
+//~ rjf: Client
+
+//- rjf: connection
+internal CTRL_RemoteClient *ctrl_remote_client_connect(String8 ip, String8 port, String8 token, CTRL_MachineID machine_id, CTRL_WakeupFunctionType *wakeup_hook, U64 endt_us);
+internal void ctrl_remote_client_disconnect(CTRL_RemoteClient *client);
+internal B32 ctrl_remote_client_is_connected(CTRL_RemoteClient *client);
+internal CTRL_RemoteClientStats ctrl_remote_client_stats(CTRL_RemoteClient *client);
+internal U64 ctrl_remote_client_gen(CTRL_RemoteClient *client);
+
+//- rjf: registry
+internal CTRL_RemoteClient *ctrl_remote_client_from_machine_id__locked(CTRL_MachineID machine_id);
+
+//- rjf: messages & events
+internal B32 ctrl_remote_client_push_msgs(CTRL_RemoteClient *client, CTRL_MsgList *msgs);
+internal CTRL_EventList ctrl_remote_client_pop_events(Arena *arena, CTRL_RemoteClient *client);
+
+//- rjf: cache helpers
+internal void ctrl_remote_client_cache_reset_if_stale__locked(CTRL_RemoteClient *client);
+internal CTRL_RemotePageNode *ctrl_remote_client_page_from_vaddr__locked(CTRL_RemoteClient *client, DMN_Handle process, U64 vaddr);
+
+//- rjf: requests
+internal CTRL_RemoteRequest *ctrl_remote_client_request_alloc__locked(CTRL_RemoteClient *client, CTRL_RemoteRecordKind kind);
+internal void ctrl_remote_client_request_release__locked(CTRL_RemoteClient *client, CTRL_RemoteRequest *request);
+internal String8 ctrl_remote_client_request_roundtrip(Arena *arena, CTRL_RemoteClient *client, CTRL_RemoteRecordKind kind, String8 payload, U64 endt_us);
+
+//- rjf: memory & registers
+internal U64 ctrl_remote_client_read_memory(CTRL_RemoteClient *client, DMN_Handle process, Rng1U64 range, void *out, U64 endt_us);
+internal void *ctrl_remote_client_reg_block_from_thread(Arena *arena, CTRL_RemoteClient *client, DMN_Handle thread, Architecture *arch_out, U64 endt_us);
+internal B32 ctrl_remote_client_ping(CTRL_RemoteClient *client, U64 endt_us);
+
+//- rjf: reader thread
+internal void ctrl_remote_client_reader_thread__entry_point(void *p);
+
+#endif // CTRL_REMOTE_H
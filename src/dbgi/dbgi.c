@@ -90,10 +90,19 @@ di_init(void)
   di_shared->u2p_ring_cv = os_condition_variable_alloc();
   di_shared->u2p_ring_size = KB(64);
   di_shared->u2p_ring_base = push_array_no_zero(arena, U8, di_shared->u2p_ring_size);
+  di_shared->prefetch_arena = arena_alloc();
   di_shared->p2u_ring_mutex = os_mutex_alloc();
   di_shared->p2u_ring_cv = os_condition_variable_alloc();
   di_shared->p2u_ring_size = KB(64);
   di_shared->p2u_ring_base = push_array_no_zero(arena, U8, di_shared->p2u_ring_size);
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8 user_program_data_path = os_string_from_system_path(scratch.arena, OS_SystemPath_UserProgramData);
+    di_shared->rdi_cache_folder = push_str8f(arena, "%S/%s", user_program_data_path, DI_RDI_CACHE_FOLDER_NAME);
+    di_shared->rdi_cache_size_cap = DI_RDI_CACHE_SIZE_CAP;
+    di_shared->rdi_cache_mutex = os_mutex_alloc();
+    scratch_end(scratch);
+  }
   di_shared->parse_thread_count = Max(2, os_logical_core_count()/2);
   di_shared->parse_threads = push_array(arena, OS_Handle, di_shared->parse_thread_count);
   for(U64 idx = 0; idx < di_shared->parse_thread_count; idx += 1)
@@ -330,7 +339,8 @@ di_open(DI_Key *key)
         node->ref_count += 1;
         if(node->ref_count == 1)
         {
-          di_u2p_enqueue_key(&key_normalized, max_U64);
+          ins_atomic_u64_inc_eval(&di_shared->open_count);
+          di_u2p_enqueue_prefetch_key(&key_normalized, DI_Priority_Background);
         }
       }
     }
@@ -373,6 +383,11 @@ di_close(DI_Key *key)
           //- rjf: release
           if(node->ref_count == 0 && ins_atomic_u64_eval(&node->touch_count) == 0)
           {
+            ins_atomic_u64_dec_eval(&di_shared->open_count);
+            if(node->parse_done)
+            {
+              ins_atomic_u64_dec_eval(&di_shared->parsed_count);
+            }
             di_string_release__stripe_mutex_w_guarded(stripe, node->key.path);
             if(node->file_base != 0)
             {
@@ -463,6 +478,497 @@ di_rdi_from_key(DI_Scope *scope, DI_Key *key, U64 endt_us)
   return result;
 }
 
+////////////////////////////////
+//~ rjf: Prefetching
+
+internal void
+di_prefetch(DI_Key *key, DI_Priority priority)
+{
+  if(key->path.size != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    DI_Key key_normalized = di_normalized_key_from_key(scratch.arena, key);
+    U64 hash = di_hash_from_key(&key_normalized);
+    U64 slot_idx = hash%di_shared->slots_count;
+    U64 stripe_idx = slot_idx%di_shared->stripes_count;
+    DI_Slot *slot = &di_shared->slots[slot_idx];
+    DI_Stripe *stripe = &di_shared->stripes[stripe_idx];
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      DI_Node *node = di_node_from_key_slot__stripe_mutex_r_guarded(slot, &key_normalized);
+      if(node != 0 && node->parse_done)
+      {
+        if(priority >= DI_Priority_CallStack)
+        {
+          di_warm_stop_sections__stripe_mutex_r_guarded(node);
+        }
+      }
+      else if(node != 0)
+      {
+        if(priority >= DI_Priority_CallStack)
+        {
+          node->warm_requested = 1;
+        }
+        di_u2p_enqueue_prefetch_key(&key_normalized, priority);
+      }
+    }
+    scratch_end(scratch);
+  }
+}
+
+internal void
+di_warm_stop_sections__stripe_mutex_r_guarded(DI_Node *node)
+{
+  // NOTE: these are the sections read when symbolizing & evaluating at a
+  // stop - vaddr -> unit/scope/procedure/line lookups, & locals. Decompressed
+  // debug info lives in memory already, so only mapped files are warmed.
+  local_persist RDI_SectionKind stop_section_kinds[] =
+  {
+    RDI_SectionKind_Units,
+    RDI_SectionKind_UnitVMap,
+    RDI_SectionKind_UnitVMapPages,
+    RDI_SectionKind_Procedures,
+    RDI_SectionKind_Scopes,
+    RDI_SectionKind_ScopeVOffData,
+    RDI_SectionKind_ScopeVMap,
+    RDI_SectionKind_ScopeVMapPages,
+    RDI_SectionKind_InlineSites,
+    RDI_SectionKind_LineTables,
+    RDI_SectionKind_Locals,
+    RDI_SectionKind_LocationBlocks,
+    RDI_SectionKind_LocationData,
+    RDI_SectionKind_StringTable,
+  };
+  if(node->arena == 0 && node->file_base != 0)
+  {
+    RDI_Parsed *rdi = &node->rdi;
+    for(U64 idx = 0; idx < ArrayCount(stop_section_kinds); idx += 1)
+    {
+      RDI_SectionKind kind = stop_section_kinds[idx];
+      if(kind < rdi->sections_count)
+      {
+        RDI_Section *section = &rdi->sections[kind];
+        if(section->encoding == RDI_SectionEncoding_Unpacked &&
+           section->off + section->encoded_size <= node->file_props.size)
+        {
+          os_file_map_view_hint((U8 *)node->file_base + section->off, section->encoded_size, OS_FileMapHintFlag_WillNeed);
+        }
+      }
+    }
+  }
+}
+
+internal DI_LoadProgress
+di_load_progress(void)
+{
+  DI_LoadProgress progress = {0};
+  progress.open_count = ins_atomic_u64_eval(&di_shared->open_count);
+  progress.parsed_count = ins_atomic_u64_eval(&di_shared->parsed_count);
+  OS_MutexScope(di_shared->u2p_ring_mutex)
+  {
+    progress.queued_count = di_shared->prefetch_count;
+  }
+  return progress;
+}
+
+////////////////////////////////
+//~ rjf: Converted RDI Cache
+
+internal DI_PDBIdentity
+di_pdb_identity_from_file(OS_Handle file)
+{
+  // NOTE: the GUID & age live at the start of the PDB info stream
+  // (stream 1). Rather than reading the whole MSF stream directory, only the
+  // few 4-byte words needed to find that stream's first block are read, so
+  // this costs a handful of small reads regardless of the PDB's size.
+  DI_PDBIdentity identity = {0};
+  U64 file_size = os_properties_from_file(file).size;
+  U8 header_data[MSF_MSF70_MAGIC_SIZE + sizeof(MSF_Header70)] = {0};
+  B32 good = (os_file_read(file, r1u64(0, sizeof(header_data)), header_data) == sizeof(header_data) &&
+              MemoryMatch(header_data, msf_msf70_magic, MSF_MSF70_MAGIC_SIZE));
+  MSF_Header70 *header = (MSF_Header70 *)(header_data + MSF_MSF70_MAGIC_SIZE);
+  U64 block_size = header->block_size;
+  good = good && (512 <= block_size && block_size <= MB(1) && IsPow2(block_size));
+  
+  //- rjf: directory offset -> file offset
+#define DI_PDBFileU32(off, out) do\
+  {\
+    U32 v__ = 0;\
+    good = good && ((off)+4 <= file_size && os_file_read(file, r1u64((off), (off)+4), &v__) == 4);\
+    (out) = v__;\
+  }while(0)
+#define DI_PDBDirectoryU32(dir_off, out) do\
+  {\
+    U64 dir_block_idx__ = (dir_off)/block_size;\
+    U64 map_off__ = dir_block_idx__*4;\
+    U32 map_block__ = 0;\
+    U32 dir_block__ = 0;\
+    DI_PDBFileU32(MSF_MSF70_MAGIC_SIZE + OffsetOf(MSF_Header70, directory_super_map) + (map_off__/block_size)*4, map_block__);\
+    DI_PDBFileU32((U64)map_block__*block_size + map_off__%block_size, dir_block__);\
+    DI_PDBFileU32((U64)dir_block__*block_size + (dir_off)%block_size, (out));\
+  }while(0)
+  
+  //- rjf: find info stream's first block
+  U32 stream_count = 0;
+  U32 stream0_size = 0;
+  U32 stream1_size = 0;
+  U32 stream1_first_block = 0;
+  DI_PDBDirectoryU32(0, stream_count);
+  good = good && (stream_count >= 2 && 4 + 4*(U64)stream_count <= header->directory_size);
+  DI_PDBDirectoryU32(4, stream0_size);
+  DI_PDBDirectoryU32(8, stream1_size);
+  good = good && (stream1_size != max_U32 && stream1_size >= 28);
+  if(good)
+  {
+    U64 stream0_block_count = (stream0_size == max_U32) ? 0 : CeilIntegerDiv(stream0_size, block_size);
+    U64 stream1_block_list_off = 4 + 4*(U64)stream_count + 4*stream0_block_count;
+    DI_PDBDirectoryU32(stream1_block_list_off, stream1_first_block);
+  }
+#undef DI_PDBDirectoryU32
+#undef DI_PDBFileU32
+  
+  //- rjf: read info header - version, timestamp, age, guid
+  if(good)
+  {
+    U8 info[28] = {0};
+    U64 info_off = (U64)stream1_first_block*block_size;
+    good = (os_file_read(file, r1u64(info_off, info_off + sizeof(info)), info) == sizeof(info));
+    U32 version = *(U32 *)(info + 0);
+    if(good && version >= 20000404)
+    {
+      identity.valid = 1;
+      identity.age = *(U32 *)(info + 8);
+      MemoryCopy(identity.guid, info + 12, sizeof(identity.guid));
+    }
+  }
+  return identity;
+}
+
+internal String8
+di_rdi_cache_path_from_pdb_identity(Arena *arena, String8 pdb_path, DI_PDBIdentity *identity)
+{
+  U8 *g = identity->guid;
+  String8 name = str8_skip_last_slash(str8_chop_last_dot(pdb_path));
+  String8 result = push_str8f(arena, "%S/%S_%08X%04X%04X%02X%02X%02X%02X%02X%02X%02X%02X%X_v%u_%u.%u.%u.rdi",
+                              di_shared->rdi_cache_folder,
+                              name,
+                              *(U32 *)(g+0), *(U16 *)(g+4), *(U16 *)(g+6),
+                              g[8], g[9], g[10], g[11], g[12], g[13], g[14], g[15],
+                              identity->age,
+                              (U32)RDI_ENCODING_VERSION,
+                              BUILD_VERSION_MAJOR, BUILD_VERSION_MINOR, BUILD_VERSION_PATCH);
+  return result;
+}
+
+internal String8
+di_rdi_cache_unpacked_path_from_file(Arena *arena, String8 rdi_path, FileProperties *props)
+{
+  // NOTE: keyed by the compressed file's identity, rather than its contents,
+  // so that finding an already-published image doesn't read the whole file.
+  Temp scratch = scratch_begin(&arena, 1);
+  String8 key = push_str8f(scratch.arena, "%S|%I64x|%I64x", rdi_path, props->size, props->modified);
+  U128 hash = hs_hash_from_data(key);
+  String8 name = str8_skip_last_slash(str8_chop_last_dot(rdi_path));
+  String8 result = push_str8f(arena, "%S/%S_%016I64x%016I64x_v%u.unpacked.rdi",
+                              di_shared->rdi_cache_folder,
+                              name,
+                              hash.u64[0], hash.u64[1],
+                              (U32)RDI_ENCODING_VERSION);
+  scratch_end(scratch);
+  return result;
+}
+
+internal U128
+di_rdi_cache_hash_from_file_path(String8 path)
+{
+  U128 result = {0};
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, path);
+  OS_Handle file_map = os_file_map_open(OS_AccessFlag_Read, file);
+  FileProperties props = os_properties_from_file(file);
+  void *base = os_file_map_view_open_hinted(file_map, OS_AccessFlag_Read, r1u64(0, props.size), OS_FileMapHintFlag_Sequential);
+  if(base != 0)
+  {
+    result = hs_hash_from_data(str8((U8 *)base, props.size));
+    os_file_map_view_close(file_map, base);
+  }
+  if(!os_handle_match(file_map, os_handle_zero()))
+  {
+    os_file_map_close(file_map);
+  }
+  os_file_close(file);
+  return result;
+}
+
+internal B32
+di_rdi_sections_are_in_bounds(RDI_Section *sections, U64 sections_count, U64 file_size)
+{
+  B32 result = 1;
+  for(U64 idx = 0; result && idx < sections_count; idx += 1)
+  {
+    result = (sections[idx].off <= file_size && sections[idx].encoded_size <= file_size - sections[idx].off);
+  }
+  return result;
+}
+
+internal B32
+di_rdi_file_path_is_valid(String8 path)
+{
+  // NOTE: an incomplete file (e.g. left by a converter which was killed, or
+  // ran out of disk space) may have a good header, but its section table or
+  // sections run past the end of the file.
+  Temp scratch = scratch_begin(0, 0);
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, path);
+  U64 file_size = os_properties_from_file(file).size;
+  RDI_Header header = {0};
+  B32 result = (os_file_read(file, r1u64(0, sizeof(header)), &header) == sizeof(header) &&
+                header.magic == RDI_MAGIC_CONSTANT &&
+                header.encoding_version == RDI_ENCODING_VERSION);
+  U64 sections_off = header.data_section_off;
+  U64 sections_size = (U64)header.data_section_count*sizeof(RDI_Section);
+  result = result && (sections_off <= file_size && sections_size <= file_size - sections_off);
+  if(result)
+  {
+    RDI_Section *sections = push_array_no_zero(scratch.arena, RDI_Section, header.data_section_count);
+    result = (os_file_read(file, r1u64(sections_off, sections_off + sections_size), sections) == sections_size &&
+              di_rdi_sections_are_in_bounds(sections, header.data_section_count, file_size));
+  }
+  os_file_close(file);
+  scratch_end(scratch);
+  return result;
+}
+
+internal void
+di_rdi_cache_touch(String8 rdi_path)
+{
+  // NOTE: last-use times are kept in a small sidecar file, rather than in
+  // the RDI's own timestamps - the RDI may be mapped by other instances, &
+  // access times are commonly disabled.
+  Temp scratch = scratch_begin(0, 0);
+  DenseTime now = dense_time_from_date_time(os_now_universal_time());
+  String8 used_path = push_str8f(scratch.arena, "%S.used", rdi_path);
+  os_write_data_to_file_path(used_path, str8_struct(&now));
+  scratch_end(scratch);
+}
+
+internal void
+di_rdi_cache_make_folder(void)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8 user_program_data_path = os_string_from_system_path(scratch.arena, OS_SystemPath_UserProgramData);
+  os_make_directory(push_str8f(scratch.arena, "%S/raddbg", user_program_data_path));
+  os_make_directory(di_shared->rdi_cache_folder);
+  scratch_end(scratch);
+}
+
+internal U64
+di_rdi_cache_seconds_from_dense_time(DenseTime time)
+{
+  // NOTE: dense times pack every month into 31 days, so they cannot be
+  // subtracted directly - this converts to seconds since 0000-03-01 on the
+  // proleptic Gregorian calendar instead
+  DateTime date_time = date_time_from_dense_time(time);
+  U64 year = date_time.year - (date_time.mon < 2);
+  U64 mon_from_mar = (date_time.mon + 10) % 12;
+  U64 days = year*365 + year/4 - year/100 + year/400 + (153*mon_from_mar + 2)/5 + date_time.day;
+  U64 result = ((days*24 + date_time.hour)*60 + date_time.min)*60 + date_time.sec;
+  return result;
+}
+
+internal String8
+di_rdi_cache_temp_path_from_path(Arena *arena, String8 rdi_path)
+{
+  String8 result = push_str8f(arena, "%S.%x.%I64x.tmp", rdi_path, os_get_pid(), os_now_microseconds());
+  return result;
+}
+
+internal B32
+di_rdi_cache_publish(String8 rdi_path, String8 temp_path)
+{
+  // NOTE: another instance may have published the same file meanwhile;
+  // its contents are identical, so either copy is fine.
+  B32 published = 0;
+  if(di_rdi_file_path_is_valid(temp_path))
+  {
+    published = os_move_file_path(rdi_path, temp_path);
+  }
+  if(!published)
+  {
+    os_delete_file_at_path(temp_path);
+  }
+  B32 result = di_rdi_file_path_is_valid(rdi_path);
+  if(published)
+  {
+    di_rdi_cache_touch(rdi_path);
+    di_rdi_cache_evict(rdi_path);
+  }
+  return result;
+}
+
+internal int
+di_qsort_compare_rdi_cache_entries__last_used(DI_RDICacheEntry *a, DI_RDICacheEntry *b)
+{
+  int result = 0;
+  if(a->last_used < b->last_used)
+  {
+    result = -1;
+  }
+  else if(a->last_used > b->last_used)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal void
+di_rdi_cache_evict(String8 keep_rdi_path)
+{
+  Temp scratch = scratch_begin(0, 0);
+  OS_MutexScope(di_shared->rdi_cache_mutex)
+  {
+    //- rjf: gather all converted files & their last-use times; delete stale
+    // temporary files along the way
+    U64 now_sec = di_rdi_cache_seconds_from_dense_time(dense_time_from_date_time(os_now_universal_time()));
+    U64 temp_stale_sec = DI_RDI_CACHE_TEMP_STALE_HOURS*60*60;
+    U64 entries_count = 0;
+    U64 entries_cap = 256;
+    DI_RDICacheEntry *entries = push_array(scratch.arena, DI_RDICacheEntry, entries_cap);
+    U64 total_size = 0;
+    OS_FileIter *it = os_file_iter_begin(scratch.arena, di_shared->rdi_cache_folder, OS_FileIterFlag_SkipFolders);
+    for(OS_FileInfo info = {0}; os_file_iter_next(scratch.arena, it, &info);)
+    {
+      if(str8_match(str8_skip_last_dot(info.name), str8_lit("tmp"), StringMatchFlag_CaseInsensitive))
+      {
+        U64 modified_sec = di_rdi_cache_seconds_from_dense_time(info.props.modified);
+        if(modified_sec + temp_stale_sec < now_sec)
+        {
+          os_delete_file_at_path(push_str8f(scratch.arena, "%S/%S", di_shared->rdi_cache_folder, info.name));
+        }
+      }
+      else if(str8_match(str8_skip_last_dot(info.name), str8_lit("rdi"), StringMatchFlag_CaseInsensitive))
+      {
+        if(entries_count == entries_cap)
+        {
+          DI_RDICacheEntry *new_entries = push_array(scratch.arena, DI_RDICacheEntry, entries_cap*2);
+          MemoryCopy(new_entries, entries, sizeof(entries[0])*entries_count);
+          entries = new_entries;
+          entries_cap *= 2;
+        }
+        DI_RDICacheEntry *entry = &entries[entries_count];
+        entries_count += 1;
+        entry->name = info.name;
+        entry->size = info.props.size;
+        entry->last_used = info.props.modified;
+        String8 used_path = push_str8f(scratch.arena, "%S/%S.used", di_shared->rdi_cache_folder, info.name);
+        OS_Handle used_file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, used_path);
+        DenseTime last_used = 0;
+        if(os_file_read(used_file, r1u64(0, sizeof(last_used)), &last_used) == sizeof(last_used))
+        {
+          entry->last_used = last_used;
+        }
+        os_file_close(used_file);
+        total_size += entry->size;
+      }
+    }
+    os_file_iter_end(it);
+    
+    //- rjf: over cap -> delete least-recently-used, until under
+    if(total_size > di_shared->rdi_cache_size_cap)
+    {
+      qsort(entries, entries_count, sizeof(entries[0]), (int (*)(const void *, const void *))di_qsort_compare_rdi_cache_entries__last_used);
+      String8 keep_name = str8_skip_last_slash(keep_rdi_path);
+      for(U64 idx = 0; idx < entries_count && total_size > di_shared->rdi_cache_size_cap; idx += 1)
+      {
+        if(str8_match(entries[idx].name, keep_name, 0))
+        {
+          continue;
+        }
+        String8 rdi_path = push_str8f(scratch.arena, "%S/%S", di_shared->rdi_cache_folder, entries[idx].name);
+        String8 used_path = push_str8f(scratch.arena, "%S.used", rdi_path);
+        if(os_delete_file_at_path(rdi_path))
+        {
+          os_delete_file_at_path(used_path);
+          total_size -= entries[idx].size;
+        }
+      }
+    }
+  }
+  scratch_end(scratch);
+}
+
+internal B32
+di_rdi_convert_from_pdb(String8 pdb_path, String8 rdi_path, B32 rdi_path_is_cached, B32 compress)
+{
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: push conversion task begin event
+  {
+    DI_Event event = {DI_EventKind_ConversionStarted};
+    event.string = rdi_path;
+    di_p2u_push_event(&event);
+  }
+  
+  //- rjf: cached -> convert into a temporary file, unique to this
+  // process & thread, in the cache folder (so it can be renamed into place)
+  String8 out_path = rdi_path;
+  if(rdi_path_is_cached)
+  {
+    di_rdi_cache_make_folder();
+    out_path = di_rdi_cache_temp_path_from_path(scratch.arena, rdi_path);
+  }
+  
+  //- rjf: kick off process
+  OS_Handle process = {0};
+  B32 process_launched = 0;
+  {
+    OS_LaunchOptions opts = {0};
+    opts.path = os_string_from_system_path(scratch.arena, OS_SystemPath_Binary);
+    opts.inherit_env = 1;
+    opts.consoleless = 1;
+    str8_list_pushf(scratch.arena, &opts.cmd_line, "raddbg");
+    str8_list_pushf(scratch.arena, &opts.cmd_line, "--convert");
+    str8_list_pushf(scratch.arena, &opts.cmd_line, "--quiet");
+    if(compress)
+    {
+      str8_list_pushf(scratch.arena, &opts.cmd_line, "--compress");
+    }
+    //str8_list_pushf(scratch.arena, &opts.cmd_line, "--capture");
+    str8_list_pushf(scratch.arena, &opts.cmd_line, "--pdb:%S", pdb_path);
+    str8_list_pushf(scratch.arena, &opts.cmd_line, "--out:%S", out_path);
+    process_launched = os_launch_process(&opts, &process);
+  }
+  
+  //- rjf: wait for process to complete - only a converter which exited
+  // cleanly has written a complete file
+  B32 result = 0;
+  if(process_launched)
+  {
+    U64 exit_code = 0;
+    for(;!os_process_wait_exit_code(process, os_now_microseconds()+1000, &exit_code);){}
+    os_process_release_handle(process);
+    result = (exit_code == 0);
+  }
+  
+  //- rjf: failed -> discard output; cached -> publish
+  if(!result)
+  {
+    os_delete_file_at_path(out_path);
+  }
+  else if(rdi_path_is_cached)
+  {
+    result = di_rdi_cache_publish(rdi_path, out_path);
+  }
+  
+  //- rjf: push conversion task end event
+  {
+    DI_Event event = {DI_EventKind_ConversionEnded};
+    event.string = rdi_path;
+    di_p2u_push_event(&event);
+  }
+  
+  scratch_end(scratch);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Parse Threads
 
@@ -497,6 +1003,52 @@ di_u2p_enqueue_key(DI_Key *key, U64 endt_us)
   return sent;
 }
 
+internal void
+di_u2p_enqueue_prefetch_key(DI_Key *key, DI_Priority priority)
+{
+  OS_MutexScope(di_shared->u2p_ring_mutex)
+  {
+    //- rjf: find existing queued prefetch; drop it if it's of lower priority
+    DI_PrefetchNode *node = 0;
+    B32 found = 0;
+    for(DI_Priority p = (DI_Priority)0; p < DI_Priority_COUNT && !found; p = (DI_Priority)(p+1))
+    {
+      DI_PrefetchList *list = &di_shared->prefetch_lists[p];
+      for(DI_PrefetchNode *n = list->first; n != 0; n = n->next)
+      {
+        if(di_key_match(&n->key, key))
+        {
+          found = 1;
+          if(n->priority < priority)
+          {
+            DLLRemove(list->first, list->last, n);
+            list->count -= 1;
+            di_shared->prefetch_count -= 1;
+          }
+          else
+          {
+            node = n;
+          }
+          break;
+        }
+      }
+    }
+    
+    //- rjf: none -> queue at requested priority
+    if(node == 0)
+    {
+      node = push_array(di_shared->prefetch_arena, DI_PrefetchNode, 1);
+      node->key = di_key_copy(di_shared->prefetch_arena, key);
+      node->priority = priority;
+      DI_PrefetchList *list = &di_shared->prefetch_lists[priority];
+      DLLPushBack(list->first, list->last, node);
+      list->count += 1;
+      di_shared->prefetch_count += 1;
+    }
+  }
+  os_condition_variable_broadcast(di_shared->u2p_ring_cv);
+}
+
 internal void
 di_u2p_dequeue_key(Arena *arena, DI_Key *out_key)
 {
@@ -506,13 +1058,34 @@ di_u2p_dequeue_key(Arena *arena, DI_Key *out_key)
     if(unconsumed_size >= sizeof(out_key->path.size) + sizeof(out_key->min_timestamp))
     {
       di_shared->u2p_ring_read_pos += ring_read_struct(di_shared->u2p_ring_base, di_shared->u2p_ring_size, di_shared->u2p_ring_read_pos, &out_key->path.size);
-      out_key->path.str = push_array(arena, U8, out_key->path.size);
+      out_key->path.str = push_array(arena, U8, out_key->path.size+1);
       di_shared->u2p_ring_read_pos += ring_read(di_shared->u2p_ring_base, di_shared->u2p_ring_size, di_shared->u2p_ring_read_pos, out_key->path.str, out_key->path.size);
       di_shared->u2p_ring_read_pos += ring_read_struct(di_shared->u2p_ring_base, di_shared->u2p_ring_size, di_shared->u2p_ring_read_pos, &out_key->min_timestamp);
       di_shared->u2p_ring_read_pos += 7;
       di_shared->u2p_ring_read_pos -= di_shared->u2p_ring_read_pos%8;
       break;
     }
+    if(di_shared->prefetch_count != 0)
+    {
+      DI_PrefetchNode *node = 0;
+      for(DI_Priority p = (DI_Priority)(DI_Priority_COUNT-1); node == 0; p = (DI_Priority)(p-1))
+      {
+        DI_PrefetchList *list = &di_shared->prefetch_lists[p];
+        if(list->first != 0)
+        {
+          node = list->first;
+          DLLRemove(list->first, list->last, node);
+          list->count -= 1;
+        }
+      }
+      di_shared->prefetch_count -= 1;
+      *out_key = di_key_copy(arena, &node->key);
+      if(di_shared->prefetch_count == 0)
+      {
+        arena_clear(di_shared->prefetch_arena);
+      }
+      break;
+    }
     os_condition_variable_wait(di_shared->u2p_ring_cv, di_shared->u2p_ring_mutex, max_U64);
   }
   os_condition_variable_broadcast(di_shared->u2p_ring_cv);
@@ -603,7 +1176,7 @@ di_parse_thread__entry_point(void *p)
       DI_Node *node = di_node_from_key_slot__stripe_mutex_r_guarded(slot, &key);
       if(node != 0)
       {
-        got_task = !ins_atomic_u64_eval_cond_assign(&node->is_working, 1, 0);
+        got_task = (!node->parse_done && !ins_atomic_u64_eval_cond_assign(&node->is_working, 1, 0));
       }
     }
     
@@ -616,13 +1189,14 @@ di_parse_thread__entry_point(void *p)
     B32 og_is_elf    = 0;
     B32 og_is_rdi    = 0;
     FileProperties og_props = {0};
+    DI_PDBIdentity og_pdb_identity = {0};
     if(got_task) ProfScope("analyze %.*s", str8_varg(og_path))
     {
+      // NOTE: only the first few bytes are needed to sniff the format -
+      // read just those, rather than mapping what may be a multi-GB file.
       OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, og_path);
-      OS_Handle file_map = os_file_map_open(OS_AccessFlag_Read, file);
-      FileProperties props = og_props = os_properties_from_file(file);
-      void *base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, props.size));
-      String8 data = str8((U8 *)base, props.size);
+      og_props = os_properties_from_file(file);
+      String8 data = os_string_from_file_range(scratch.arena, file, r1u64(0, 64));
       if(!og_format_is_known)
       {
         String8 msf20_magic = str8_lit("Microsoft C/C++ program database 2.00\r\n\x1aJG\0\0");
@@ -634,6 +1208,7 @@ di_parse_thread__entry_point(void *p)
         {
           og_format_is_known = 1;
           og_is_pdb = 1;
+          og_pdb_identity = di_pdb_identity_from_file(file);
         }
       }
       if(!og_format_is_known)
@@ -664,21 +1239,27 @@ di_parse_thread__entry_point(void *p)
           og_is_pe = 1;
         }
       }
-      os_file_map_view_close(file_map, base);
-      os_file_map_close(file_map);
       os_file_close(file);
     }
     
     ////////////////////////////
-    //- rjf: given O.G. path & analysis, determine RDI path
+    //- rjf: given O.G. path & analysis, determine RDI path - PDBs with a
+    // readable identity go to the content-addressed cache; others (old MSF 2.0
+    // PDBs) are converted next to the PDB, as before
     //
     String8 rdi_path = {0};
+    B32 rdi_path_is_cached = 0;
     if(got_task)
     {
       if(og_is_rdi)
       {
         rdi_path = og_path;
       }
+      else if(og_format_is_known && og_is_pdb && og_pdb_identity.valid)
+      {
+        rdi_path = di_rdi_cache_path_from_pdb_identity(scratch.arena, og_path, &og_pdb_identity);
+        rdi_path_is_cached = 1;
+      }
       else if(og_format_is_known && og_is_pdb)
       {
         rdi_path = push_str8f(scratch.arena, "%S.rdi", str8_chop_last_dot(og_path));
@@ -686,48 +1267,23 @@ di_parse_thread__entry_point(void *p)
     }
     
     ////////////////////////////
-    //- rjf: check if rdi file is up-to-date
+    //- rjf: check if rdi file is up-to-date - RDIs loaded directly are their
+    // own source, & cached files are named by their source's contents & the
+    // converter version, so any valid one is current; others must be newer
+    // than the source, & of our encoding version
     //
     B32 rdi_file_is_up_to_date = 0;
-    if(got_task)
-    {
-      if(rdi_path.size != 0) ProfScope("check %.*s is up-to-date", str8_varg(rdi_path))
-      {
-        FileProperties props = os_properties_from_file_path(rdi_path);
-        rdi_file_is_up_to_date = (props.modified > og_props.modified);
-      }
-    }
-    
-    ////////////////////////////
-    //- rjf: if raddbg file is up to date based on timestamp, check the
-    // encoding generation number & size, to see if we need to regenerate it
-    // regardless
-    //
-    if(got_task && rdi_file_is_up_to_date) ProfScope("check %.*s version matches our's", str8_varg(rdi_path))
+    if(got_task && rdi_path.size != 0)
     {
-      OS_Handle file = {0};
-      OS_Handle file_map = {0};
-      FileProperties file_props = {0};
-      void *file_base = 0;
-      file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, rdi_path);
-      file_map = os_file_map_open(OS_AccessFlag_Read, file);
-      file_props = os_properties_from_file(file);
-      file_base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, file_props.size));
-      if(sizeof(RDI_Header) <= file_props.size)
+      if(og_is_rdi || rdi_path_is_cached) ProfScope("check %.*s is valid", str8_varg(rdi_path))
       {
-        RDI_Header *header = (RDI_Header*)file_base;
-        if(header->encoding_version != RDI_ENCODING_VERSION)
-        {
-          rdi_file_is_up_to_date = 0;
-        }
+        rdi_file_is_up_to_date = di_rdi_file_path_is_valid(rdi_path);
       }
-      else
+      else ProfScope("check %.*s is up-to-date", str8_varg(rdi_path))
       {
-        rdi_file_is_up_to_date = 0;
+        FileProperties props = os_properties_from_file_path(rdi_path);
+        rdi_file_is_up_to_date = (props.modified > og_props.modified && di_rdi_file_path_is_valid(rdi_path));
       }
-      os_file_map_view_close(file_map, file_base);
-      os_file_map_close(file_map);
-      os_file_close(file);
     }
     
     ////////////////////////////
@@ -748,53 +1304,7 @@ di_parse_thread__entry_point(void *p)
     {
       if(og_is_pdb)
       {
-        //- rjf: push conversion task begin event
-        {
-          DI_Event event = {DI_EventKind_ConversionStarted};
-          event.string = rdi_path;
-          di_p2u_push_event(&event);
-        }
-        
-        //- rjf: kick off process
-        OS_Handle process = {0};
-        {
-          OS_LaunchOptions opts = {0};
-          opts.path = os_string_from_system_path(scratch.arena, OS_SystemPath_Binary);
-          opts.inherit_env = 1;
-          opts.consoleless = 1;
-          str8_list_pushf(scratch.arena, &opts.cmd_line, "raddbg");
-          str8_list_pushf(scratch.arena, &opts.cmd_line, "--convert");
-          str8_list_pushf(scratch.arena, &opts.cmd_line, "--quiet");
-          if(should_compress)
-          {
-            str8_list_pushf(scratch.arena, &opts.cmd_line, "--compress");
-          }
-          //str8_list_pushf(scratch.arena, &opts.cmd_line, "--capture");
-          str8_list_pushf(scratch.arena, &opts.cmd_line, "--pdb:%S", og_path);
-          str8_list_pushf(scratch.arena, &opts.cmd_line, "--out:%S", rdi_path);
-          os_launch_process(&opts, &process);
-        }
-        
-        //- rjf: wait for process to complete
-        {
-          U64 start_wait_t = os_now_microseconds();
-          for(;;)
-          {
-            B32 wait_done = os_process_wait(process, os_now_microseconds()+1000);
-            if(wait_done)
-            {
-              rdi_file_is_up_to_date = 1;
-              break;
-            }
-          }
-        }
-        
-        //- rjf: push conversion task end event
-        {
-          DI_Event event = {DI_EventKind_ConversionEnded};
-          event.string = rdi_path;
-          di_p2u_push_event(&event);
-        }
+        rdi_file_is_up_to_date = di_rdi_convert_from_pdb(og_path, rdi_path, rdi_path_is_cached, should_compress);
       }
       else
       {
@@ -809,32 +1319,59 @@ di_parse_thread__entry_point(void *p)
     }
     
     ////////////////////////////
-    //- rjf: got task -> open file
+    //- rjf: using cached file -> mark as recently used
+    //
+    if(got_task && rdi_path_is_cached && rdi_file_is_up_to_date)
+    {
+      di_rdi_cache_touch(rdi_path);
+    }
+    
+    ////////////////////////////
+    //- rjf: got task -> open file & do initial parse of rdi. a cached file may
+    // be evicted or replaced by another instance between the check above &
+    // this open, so what was opened is validated again - if it's not good, it
+    // is converted again & reopened, once.
     //
     OS_Handle file = {0};
     OS_Handle file_map = {0};
     FileProperties file_props = {0};
     void *file_base = 0;
-    if(got_task)
+    RDI_Parsed rdi_parsed_maybe_compressed = di_rdi_parsed_nil;
+    for(U64 attempt_idx = 0; got_task && attempt_idx < 2; attempt_idx += 1)
     {
       file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, rdi_path);
       file_map = os_file_map_open(OS_AccessFlag_Read, file);
       file_props = os_properties_from_file(file);
-      file_base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, file_props.size));
-    }
-    
-    ////////////////////////////
-    //- rjf: do initial parse of rdi
-    //
-    RDI_Parsed rdi_parsed_maybe_compressed = di_rdi_parsed_nil;
-    if(got_task)
-    {
+      file_base = os_file_map_view_open_hinted(file_map, OS_AccessFlag_Read, r1u64(0, file_props.size), OS_FileMapHintFlag_Random);
       RDI_ParseStatus parse_status = rdi_parse((U8 *)file_base, file_props.size, &rdi_parsed_maybe_compressed);
-      (void)parse_status;
+      B32 file_is_good = (parse_status == RDI_ParseStatus_Good);
+      if(file_is_good || !rdi_path_is_cached || !og_is_pdb || attempt_idx != 0)
+      {
+        break;
+      }
+      if(file_base != 0)
+      {
+        os_file_map_view_close(file_map, file_base);
+      }
+      if(!os_handle_match(file_map, os_handle_zero()))
+      {
+        os_file_map_close(file_map);
+      }
+      os_file_close(file);
+      file = os_handle_zero();
+      file_map = os_handle_zero();
+      MemoryZeroStruct(&file_props);
+      file_base = 0;
+      rdi_file_is_up_to_date = di_rdi_convert_from_pdb(og_path, rdi_path, rdi_path_is_cached, should_compress);
     }
     
     ////////////////////////////
-    //- rjf: decompress & re-parse, if necessary
+    //- rjf: decompress & re-parse, if necessary - decompressed images are
+    // published to the cache folder, named by the compressed file's identity,
+    // & mapped read-only from there, so all instances loading the same
+    // compressed file share one copy through the OS' page cache, & only the
+    // first one pays for decompression. if the image can't be published, fall
+    // back to decompressing into memory private to this instance.
     //
     Arena *rdi_parsed_arena = 0;
     RDI_Parsed rdi_parsed = rdi_parsed_maybe_compressed;
@@ -843,11 +1380,86 @@ di_parse_thread__entry_point(void *p)
       U64 decompressed_size = rdi_decompressed_size_from_parsed(&rdi_parsed_maybe_compressed);
       if(decompressed_size > file_props.size)
       {
-        rdi_parsed_arena = arena_alloc();
-        U8 *decompressed_data = push_array_no_zero(rdi_parsed_arena, U8, decompressed_size);
-        rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi_parsed_maybe_compressed);
-        RDI_ParseStatus parse_status = rdi_parse(decompressed_data, decompressed_size, &rdi_parsed);
-        (void)parse_status;
+        //- rjf: determine path of unpacked image
+        String8 unpacked_path = di_rdi_cache_unpacked_path_from_file(scratch.arena, rdi_path, &file_props);
+        B32 unpacked_is_published = (di_rdi_file_path_is_valid(unpacked_path) &&
+                                     os_properties_from_file_path(unpacked_path).size == decompressed_size);
+        
+        //- rjf: not yet published -> decompress, & publish, once the written
+        // file is known to match the decompressed image
+        U8 *decompressed_data = 0;
+        if(!unpacked_is_published) ProfScope("decompress %.*s", str8_varg(rdi_path))
+        {
+          // NOTE: decompression streams through the file once - switch the
+          // view from lookup-style access to aggressive readahead.
+          os_file_map_view_hint(file_base, file_props.size, OS_FileMapHintFlag_Sequential);
+          rdi_parsed_arena = arena_alloc();
+          decompressed_data = push_array_no_zero(rdi_parsed_arena, U8, decompressed_size);
+          rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi_parsed_maybe_compressed);
+          U128 image_hash = hs_hash_from_data(str8(decompressed_data, decompressed_size));
+          di_rdi_cache_make_folder();
+          String8 temp_path = di_rdi_cache_temp_path_from_path(scratch.arena, unpacked_path);
+          B32 temp_is_good = (os_write_data_to_file_path(temp_path, str8(decompressed_data, decompressed_size)) &&
+                              u128_match(di_rdi_cache_hash_from_file_path(temp_path), image_hash));
+          if(temp_is_good)
+          {
+            unpacked_is_published = (di_rdi_cache_publish(unpacked_path, temp_path) &&
+                                     os_properties_from_file_path(unpacked_path).size == decompressed_size);
+          }
+          else
+          {
+            os_delete_file_at_path(temp_path);
+          }
+        }
+        
+        //- rjf: published -> map unpacked image in place of the compressed file
+        B32 unpacked_is_mapped = 0;
+        if(unpacked_is_published)
+        {
+          OS_Handle unpacked_file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, unpacked_path);
+          OS_Handle unpacked_file_map = os_file_map_open(OS_AccessFlag_Read, unpacked_file);
+          FileProperties unpacked_file_props = os_properties_from_file(unpacked_file);
+          void *unpacked_file_base = os_file_map_view_open_hinted(unpacked_file_map, OS_AccessFlag_Read, r1u64(0, unpacked_file_props.size), OS_FileMapHintFlag_Random);
+          if(unpacked_file_base != 0 &&
+             unpacked_file_props.size == decompressed_size &&
+             rdi_parse((U8 *)unpacked_file_base, unpacked_file_props.size, &rdi_parsed) == RDI_ParseStatus_Good)
+          {
+            unpacked_is_mapped = 1;
+            os_file_map_view_close(file_map, file_base);
+            os_file_map_close(file_map);
+            os_file_close(file);
+            file = unpacked_file;
+            file_map = unpacked_file_map;
+            file_props = unpacked_file_props;
+            file_base = unpacked_file_base;
+            di_rdi_cache_touch(unpacked_path);
+            if(rdi_parsed_arena != 0)
+            {
+              arena_release(rdi_parsed_arena);
+              rdi_parsed_arena = 0;
+            }
+          }
+          else
+          {
+            os_file_map_view_close(unpacked_file_map, unpacked_file_base);
+            os_file_map_close(unpacked_file_map);
+            os_file_close(unpacked_file);
+          }
+        }
+        
+        //- rjf: not mapped -> use private decompressed image
+        if(!unpacked_is_mapped)
+        {
+          if(decompressed_data == 0) ProfScope("decompress %.*s", str8_varg(rdi_path))
+          {
+            rdi_parsed_arena = arena_alloc();
+            decompressed_data = push_array_no_zero(rdi_parsed_arena, U8, decompressed_size);
+            rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi_parsed_maybe_compressed);
+          }
+          rdi_parsed = di_rdi_parsed_nil;
+          RDI_ParseStatus parse_status = rdi_parse(decompressed_data, decompressed_size, &rdi_parsed);
+          (void)parse_status;
+        }
       }
     }
     
@@ -867,6 +1479,11 @@ di_parse_thread__entry_point(void *p)
         node->arena = rdi_parsed_arena;
         node->rdi = rdi_parsed;
         node->parse_done = 1;
+        ins_atomic_u64_inc_eval(&di_shared->parsed_count);
+        if(node->warm_requested)
+        {
+          di_warm_stop_sections__stripe_mutex_r_guarded(node);
+        }
       }
     }
     os_condition_variable_broadcast(stripe->cv);
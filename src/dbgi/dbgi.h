@@ -4,6 +4,36 @@
 #ifndef DI_H
 #define DI_H
 
+////////////////////////////////
+//~ rjf: Converted RDI Cache Options
+
+// NOTE: PDBs are converted into a local, content-addressed cache folder,
+// rather than next to the PDB. Files are named by the PDB's GUID & age plus
+// the converter's version, so identical PDBs - in read-only symbol stores, on
+// network shares, or copied into many build folders - are converted once.
+// Conversions are written to a uniquely-named temporary file & published with
+// an atomic rename, so concurrent raddbg instances never observe partial files.
+// Only conversions which complete successfully are published. When the folder
+// exceeds its size cap, the least-recently-used files are deleted, as are
+// temporary files abandoned by killed converters or instances.
+//
+// Compressed RDIs are decompressed once into the same folder, named by a hash
+// of the compressed file's path, size, & modification time, & mapped read-only
+// from there - so all instances debugging the same binaries share one copy of
+// each decompressed image through the OS' page cache, which frees it when the
+// last mapping closes. Images are only published once the file written
+// matches what was decompressed.
+
+#if !defined(DI_RDI_CACHE_FOLDER_NAME)
+# define DI_RDI_CACHE_FOLDER_NAME "raddbg/rdi_cache"
+#endif
+#if !defined(DI_RDI_CACHE_SIZE_CAP)
+# define DI_RDI_CACHE_SIZE_CAP GB(16)
+#endif
+#if !defined(DI_RDI_CACHE_TEMP_STALE_HOURS)
+# define DI_RDI_CACHE_TEMP_STALE_HOURS 24
+#endif
+
 ////////////////////////////////
 //~ rjf: Cache Key Type
 
@@ -36,6 +66,50 @@ struct DI_KeyArray
   U64 count;
 };
 
+////////////////////////////////
+//~ rjf: Prefetch Types
+
+// NOTE: Opened debug info is parsed (& converted, if needed) in the
+// background, before anyone asks for it, in order of how likely it is to be
+// needed soon. Explicit requests (via di_rdi_from_key) always go first.
+// Prefetches of already-parsed debug info at CallStack priority or above warm
+// the OS page cache for the sections which are read at every stop.
+
+typedef enum DI_Priority
+{
+  DI_Priority_Background,  // loaded modules, by default
+  DI_Priority_Breakpoints, // modules which user breakpoints resolved into
+  DI_Priority_CallStack,   // modules on a stopped thread's call stack
+  DI_Priority_Executable,  // a process' executable
+  DI_Priority_COUNT
+}
+DI_Priority;
+
+typedef struct DI_PrefetchNode DI_PrefetchNode;
+struct DI_PrefetchNode
+{
+  DI_PrefetchNode *next;
+  DI_PrefetchNode *prev;
+  DI_Key key;
+  DI_Priority priority;
+};
+
+typedef struct DI_PrefetchList DI_PrefetchList;
+struct DI_PrefetchList
+{
+  DI_PrefetchNode *first;
+  DI_PrefetchNode *last;
+  U64 count;
+};
+
+typedef struct DI_LoadProgress DI_LoadProgress;
+struct DI_LoadProgress
+{
+  U64 open_count;    // debug info keys currently opened
+  U64 parsed_count;  // ...of which are parsed & ready
+  U64 queued_count;  // ...of which are queued for prefetching
+};
+
 ////////////////////////////////
 //~ rjf: Event Types
 
@@ -71,6 +145,25 @@ struct DI_EventList
   U64 count;
 };
 
+////////////////////////////////
+//~ rjf: Converted RDI Cache Types
+
+typedef struct DI_PDBIdentity DI_PDBIdentity;
+struct DI_PDBIdentity
+{
+  B32 valid;
+  U8 guid[16];
+  U32 age;
+};
+
+typedef struct DI_RDICacheEntry DI_RDICacheEntry;
+struct DI_RDICacheEntry
+{
+  String8 name;
+  U64 size;
+  DenseTime last_used;
+};
+
 ////////////////////////////////
 //~ rjf: Cache Types
 
@@ -107,6 +200,7 @@ struct DI_Node
   Arena *arena;
   RDI_Parsed rdi;
   B32 parse_done;
+  B32 warm_requested;
 };
 
 typedef struct DI_Slot DI_Slot;
@@ -174,6 +268,15 @@ struct DI_Shared
   U64 u2p_ring_write_pos;
   U64 u2p_ring_read_pos;
   
+  // rjf: user -> parse prefetch queue (guarded by u2p ring mutex)
+  Arena *prefetch_arena;
+  DI_PrefetchList prefetch_lists[DI_Priority_COUNT];
+  U64 prefetch_count;
+  
+  // rjf: progress counters
+  U64 open_count;
+  U64 parsed_count;
+  
   // rjf: parse -> user event ring
   OS_Handle p2u_ring_mutex;
   OS_Handle p2u_ring_cv;
@@ -182,6 +285,11 @@ struct DI_Shared
   U64 p2u_ring_write_pos;
   U64 p2u_ring_read_pos;
   
+  // rjf: converted rdi cache
+  String8 rdi_cache_folder;
+  U64 rdi_cache_size_cap;
+  OS_Handle rdi_cache_mutex;
+  
   // rjf: threads
   U64 parse_thread_count;
   OS_Handle *parse_threads;
@@ -240,10 +348,36 @@ internal void di_close(DI_Key *key);
 
 internal RDI_Parsed *di_rdi_from_key(DI_Scope *scope, DI_Key *key, U64 endt_us);
 
+////////////////////////////////
+//~ rjf: Prefetching
+
+internal void di_prefetch(DI_Key *key, DI_Priority priority);
+internal void di_warm_stop_sections__stripe_mutex_r_guarded(DI_Node *node);
+internal DI_LoadProgress di_load_progress(void);
+
+////////////////////////////////
+//~ rjf: Converted RDI Cache
+
+internal DI_PDBIdentity di_pdb_identity_from_file(OS_Handle file);
+internal String8 di_rdi_cache_path_from_pdb_identity(Arena *arena, String8 pdb_path, DI_PDBIdentity *identity);
+internal String8 di_rdi_cache_unpacked_path_from_file(Arena *arena, String8 rdi_path, FileProperties *props);
+internal U128 di_rdi_cache_hash_from_file_path(String8 path);
+internal B32 di_rdi_sections_are_in_bounds(RDI_Section *sections, U64 sections_count, U64 file_size);
+internal B32 di_rdi_file_path_is_valid(String8 path);
+internal void di_rdi_cache_touch(String8 rdi_path);
+internal void di_rdi_cache_make_folder(void);
+internal U64 di_rdi_cache_seconds_from_dense_time(DenseTime time);
+internal String8 di_rdi_cache_temp_path_from_path(Arena *arena, String8 rdi_path);
+internal B32 di_rdi_cache_publish(String8 rdi_path, String8 temp_path);
+internal int di_qsort_compare_rdi_cache_entries__last_used(DI_RDICacheEntry *a, DI_RDICacheEntry *b);
+internal void di_rdi_cache_evict(String8 keep_rdi_path);
+internal B32 di_rdi_convert_from_pdb(String8 pdb_path, String8 rdi_path, B32 rdi_path_is_cached, B32 compress);
+
 ////////////////////////////////
 //~ rjf: Parse Threads
 
 internal B32 di_u2p_enqueue_key(DI_Key *key, U64 endt_us);
+internal void di_u2p_enqueue_prefetch_key(DI_Key *key, DI_Priority priority);
 internal void di_u2p_dequeue_key(Arena *arena, DI_Key *out_key);
 
 internal void di_p2u_push_event(DI_Event *event);
@@ -686,154 +686,29 @@ df_string_from_cfg_node_key(DF_CfgNode *node, String8 key, StringMatchFlags flag
 ////////////////////////////////
 //~ rjf: Disassembling
 
-#include "third_party/udis86/config.h"
-#include "third_party/udis86/udis86.h"
-#include "third_party/udis86/libudis86/syn.h"
+// NOTE: stepping & control flow analysis only need the decoded facts
+// of each instruction, not its text, so this goes through the table-driven
+// x64 decoder rather than a full disassembler. DF_InstFlags share bit
+// positions with X64_InstFlags, minus the decoder-only bits.
+StaticAssert(DF_InstFlag_Call == X64_InstFlag_Call &&
+             DF_InstFlag_Branch == X64_InstFlag_Branch &&
+             DF_InstFlag_UnconditionalJump == X64_InstFlag_UnconditionalJump &&
+             DF_InstFlag_Return == X64_InstFlag_Return &&
+             DF_InstFlag_NonFlow == X64_InstFlag_NonFlow &&
+             DF_InstFlag_Repeats == X64_InstFlag_Repeats &&
+             DF_InstFlag_ChangesStackPointer == X64_InstFlag_ChangesStackPointer &&
+             DF_InstFlag_ChangesStackPointerVariably == X64_InstFlag_ChangesStackPointerVariably,
+             df_x64_inst_flag_check);
 
 internal DF_Inst
 df_single_inst_from_machine_code__x64(Arena *arena, U64 start_voff, String8 string)
 {
-  Architecture arch = Architecture_x64;
-  
-  //- rjf: prep ud state
-  struct ud ud_ctx_;
-  struct ud *ud_ctx = &ud_ctx_;
-  ud_init(ud_ctx);
-  ud_set_mode(ud_ctx, bit_size_from_arch(arch));
-  ud_set_pc(ud_ctx, start_voff);
-  ud_set_input_buffer(ud_ctx, string.str, string.size);
-  ud_set_vendor(ud_ctx, UD_VENDOR_ANY);
-  ud_set_syntax(ud_ctx, UD_SYN_INTEL);
-  
-  //- rjf: disassembly + get info
-  U32 bytes_disassembled = ud_disassemble(ud_ctx);
-  struct ud_operand *first_op = (struct ud_operand *)ud_insn_opr(ud_ctx, 0);
-  U64 rel_voff = (first_op != 0 && first_op->type == UD_OP_JIMM) ? ud_syn_rel_target(ud_ctx, first_op) : 0;
-  DF_InstFlags flags = 0;
-  enum ud_mnemonic_code code = ud_insn_mnemonic(ud_ctx);
-  switch(code)
-  {
-    case UD_Icall:
-    {
-      flags |= DF_InstFlag_Call;
-    }break;
-    
-    /* TODO(wonchun)
-  case UD_Iiretd:
-  case UD_Iiretw:
-    */
-    
-    case UD_Ija:
-    case UD_Ijae:
-    case UD_Ijb:
-    case UD_Ijbe:
-    case UD_Ijcxz:
-    case UD_Ijecxz:
-    case UD_Ijg:
-    case UD_Ijge:
-    case UD_Ijl:
-    case UD_Ijle:
-    {
-      flags |= DF_InstFlag_Branch;
-    }break;
-    
-    case UD_Ijmp:
-    {
-      flags |= DF_InstFlag_UnconditionalJump;
-    }break;
-    
-    case UD_Ijno:
-    case UD_Ijnp:
-    case UD_Ijns:
-    case UD_Ijnz:
-    case UD_Ijo:
-    case UD_Ijp:
-    case UD_Ijrcxz:
-    case UD_Ijs:
-    case UD_Ijz:
-    case UD_Iloop:
-    case UD_Iloope:
-    case UD_Iloopne:
-    {
-      flags |= DF_InstFlag_Branch;
-    }break;
-    
-    case UD_Iret:
-    case UD_Iretf:
-    {
-      flags |= DF_InstFlag_Return;
-    }break;
-    
-    /* TODO(wonchun)
-  case UD_Isyscall:
-  case UD_Isysenter:
-  case UD_Isysexit:
-  case UD_Isysret:
-  case UD_Ivmcall:
-  case UD_Ivmmcall:
-    */
-    default:
-    {
-      flags |= DF_InstFlag_NonFlow;
-    }break;
-  }
-  
-  //- rjf: check for stack pointer modifications
-  S64 sp_delta = 0;
-  {
-    struct ud_operand *dst_op = (struct ud_operand *)ud_insn_opr(ud_ctx, 0);
-    struct ud_operand *src_op = (struct ud_operand *)ud_insn_opr(ud_ctx, 1);
-    
-    // rjf: direct additions/subtractions to RSP
-    if(dst_op && src_op && dst_op->base == UD_R_RSP && dst_op->type == UD_OP_REG)
-    {
-      flags |= DF_InstFlag_ChangesStackPointer;
-      // TODO(rjf): does the library report constant changes to the stack pointer
-      // as UD_OP_CONST too? what does UD_OP_JIMM refer to?
-      if(src_op->base == UD_NONE && src_op->type == UD_OP_IMM && code == UD_Isub)
-      {
-        S64 sign = -1;
-        sp_delta = sign * src_op->lval.sqword;
-      }
-      else if(src_op->base == UD_NONE && src_op->type == UD_OP_IMM && code == UD_Iadd)
-      {
-        S64 sign = +1;
-        sp_delta = sign * src_op->lval.sqword;
-      }
-      else
-      {
-        flags |= DF_InstFlag_ChangesStackPointerVariably;
-      }
-    }
-    
-    // rjf: push/pop
-    if(code == UD_Ipush)
-    {
-      flags |= DF_InstFlag_ChangesStackPointer;
-      sp_delta = -8;
-    }
-    else if(code == UD_Ipop)
-    {
-      flags |= DF_InstFlag_ChangesStackPointer;
-      sp_delta = +8;
-    }
-    
-    // rjf: mark extra flags
-    if(ud_ctx->pfx_rep != 0 ||
-       ud_ctx->pfx_repe != 0 ||
-       ud_ctx->pfx_repne != 0)
-    {
-      flags |= DF_InstFlag_Repeats;
-    }
-  }
-  
-  //- rjf: fill+return
+  X64_Inst x64_inst = x64_inst_from_machine_code(start_voff, string);
   DF_Inst inst = {0};
-  inst.size = bytes_disassembled;
-  inst.string = push_str8_copy(arena, str8_cstring((char *)ud_insn_asm(ud_ctx)));
-  inst.rel_voff = rel_voff;
-  inst.sp_delta = sp_delta;
-  inst.flags = flags;
+  inst.flags    = (DF_InstFlags)(x64_inst.flags & 0xff);
+  inst.size     = x64_inst.size;
+  inst.rel_voff = x64_inst.rel_voff;
+  inst.sp_delta = x64_inst.sp_delta;
   return inst;
 }
 
@@ -1725,6 +1600,105 @@ df_entity_notify_mutation(DF_Entity *entity)
   }
 }
 
+//- rjf: entity lookup index maintenance
+
+internal U64
+df_hash_from_ctrl_machine_id_handle(CTRL_MachineID machine_id, DMN_Handle handle)
+{
+  U64 hash = df_hash_from_seed_string(df_hash_from_string(str8_struct(&machine_id)), str8_struct(&handle));
+  return hash;
+}
+
+internal void
+df_entity_index_insert(DF_EntityIndex *index, U64 hash, DF_Entity *entity)
+{
+  if(index->slots_count != 0)
+  {
+    DF_EntityIndexSlot *slot = &index->slots[hash%index->slots_count];
+    DF_EntityIndexNode *node = df_state->free_entity_index_node;
+    if(node != 0)
+    {
+      SLLStackPop(df_state->free_entity_index_node);
+    }
+    else
+    {
+      node = push_array_no_zero(df_state->arena, DF_EntityIndexNode, 1);
+    }
+    MemoryZeroStruct(node);
+    node->entity = entity;
+    DLLPushBack(slot->first, slot->last, node);
+  }
+}
+
+internal void
+df_entity_index_remove(DF_EntityIndex *index, U64 hash, DF_Entity *entity)
+{
+  if(index->slots_count != 0)
+  {
+    DF_EntityIndexSlot *slot = &index->slots[hash%index->slots_count];
+    for(DF_EntityIndexNode *n = slot->first; n != 0; n = n->next)
+    {
+      if(n->entity == entity)
+      {
+        DLLRemove(slot->first, slot->last, n);
+        SLLStackPush(df_state->free_entity_index_node, n);
+        break;
+      }
+    }
+  }
+}
+
+internal void
+df_entity_ctrl_index_insert(DF_Entity *entity)
+{
+  if(entity->flags & DF_EntityFlag_HasCtrlMachineID)
+  {
+    DMN_Handle handle = (entity->flags & DF_EntityFlag_HasCtrlHandle) ? entity->ctrl_handle : dmn_handle_zero();
+    df_entity_index_insert(&df_state->entity_ctrl_index, df_hash_from_ctrl_machine_id_handle(entity->ctrl_machine_id, handle), entity);
+  }
+}
+
+internal void
+df_entity_ctrl_index_remove(DF_Entity *entity)
+{
+  if(entity->flags & DF_EntityFlag_HasCtrlMachineID)
+  {
+    DMN_Handle handle = (entity->flags & DF_EntityFlag_HasCtrlHandle) ? entity->ctrl_handle : dmn_handle_zero();
+    df_entity_index_remove(&df_state->entity_ctrl_index, df_hash_from_ctrl_machine_id_handle(entity->ctrl_machine_id, handle), entity);
+  }
+}
+
+internal void
+df_entity_indices_rebuild(void)
+{
+  // rjf: clear all index slots
+  DF_EntityIndex *indices[] = {&df_state->entity_id_index, &df_state->entity_ctrl_index};
+  for(U64 index_idx = 0; index_idx < ArrayCount(indices); index_idx += 1)
+  {
+    DF_EntityIndex *index = indices[index_idx];
+    for(U64 slot_idx = 0; slot_idx < index->slots_count; slot_idx += 1)
+    {
+      DF_EntityIndexSlot *slot = &index->slots[slot_idx];
+      for(DF_EntityIndexNode *n = slot->first, *next = 0; n != 0; n = next)
+      {
+        next = n->next;
+        SLLStackPush(df_state->free_entity_index_node, n);
+      }
+      MemoryZeroStruct(slot);
+    }
+  }
+  
+  // rjf: re-insert all entities in the tree
+  for(DF_Entity *e = df_entity_root();
+      !df_entity_is_nil(e);
+      e = df_entity_rec_df_pre(e, &df_g_nil_entity).next)
+  {
+    df_entity_index_insert(&df_state->entity_id_index, df_hash_from_string(str8_struct(&e->id)), e);
+    df_entity_ctrl_index_insert(e);
+  }
+  df_state->module_index_cache.gen += 1;
+}
+
 //- rjf: entity allocation + tree forming
 
 internal DF_Entity *
@@ -1809,8 +1783,15 @@ df_entity_alloc(DF_StateDeltaHistory *hist, DF_Entity *parent, DF_EntityKind kin
   entity->generation += 1;
   entity->alloc_time_us = os_now_microseconds();
   
+  // rjf: insert into indices
+  df_entity_index_insert(&df_state->entity_id_index, df_hash_from_string(str8_struct(&entity->id)), entity);
+  
   // rjf: dirtify caches
   df_state->kind_alloc_gens[kind] += 1;
+  if(kind == DF_EntityKind_Module)
+  {
+    df_state->module_index_cache.gen += 1;
+  }
   df_entity_notify_mutation(entity);
   
   // rjf: log
@@ -1878,6 +1859,12 @@ df_entity_release(DF_StateDeltaHistory *hist, DF_Entity *entity)
     df_state_delta_history_push_struct_delta(hist, &df_state->kind_alloc_gens[task->e->kind]);
     df_state_delta_history_push_struct_delta(hist, &df_state->entities_free[free_list_idx]);
     df_set_thread_freeze_state(task->e, 0);
+    df_entity_index_remove(&df_state->entity_id_index, df_hash_from_string(str8_struct(&task->e->id)), task->e);
+    df_entity_ctrl_index_remove(task->e);
+    if(task->e->kind == DF_EntityKind_Module)
+    {
+      df_state->module_index_cache.gen += 1;
+    }
     SLLStackPush(df_state->entities_free[free_list_idx], task->e);
     df_state->entities_free_count += 1;
     df_state->entities_active_count -= 1;
@@ -1933,6 +1920,10 @@ df_entity_change_parent(DF_StateDeltaHistory *hist, DF_Entity *entity, DF_Entity
     DLLPushBack_NPZ(&df_g_nil_entity, new_parent->first, new_parent->last, entity, next, prev);
   }
   entity->parent = new_parent;
+  if(entity->kind == DF_EntityKind_Module)
+  {
+    df_state->module_index_cache.gen += 1;
+  }
   
   // rjf: notify
   df_entity_notify_mutation(entity);
@@ -2046,8 +2037,10 @@ internal void
 df_entity_equip_ctrl_machine_id(DF_Entity *entity, CTRL_MachineID machine_id)
 {
   df_require_entity_nonnil(entity, return);
+  df_entity_ctrl_index_remove(entity);
   entity->ctrl_machine_id = machine_id;
   entity->flags |= DF_EntityFlag_HasCtrlMachineID;
+  df_entity_ctrl_index_insert(entity);
   df_entity_notify_mutation(entity);
 }
 
@@ -2055,8 +2048,10 @@ internal void
 df_entity_equip_ctrl_handle(DF_Entity *entity, DMN_Handle handle)
 {
   df_require_entity_nonnil(entity, return);
+  df_entity_ctrl_index_remove(entity);
   entity->ctrl_handle = handle;
   entity->flags |= DF_EntityFlag_HasCtrlHandle;
+  df_entity_ctrl_index_insert(entity);
   df_entity_notify_mutation(entity);
 }
 
@@ -2102,6 +2097,10 @@ df_entity_equip_vaddr_rng(DF_Entity *entity, Rng1U64 range)
   df_require_entity_nonnil(entity, return);
   entity->vaddr_rng = range;
   entity->flags |= DF_EntityFlag_HasVAddrRng;
+  if(entity->kind == DF_EntityKind_Module)
+  {
+    df_state->module_index_cache.gen += 1;
+  }
   df_entity_notify_mutation(entity);
 }
 
@@ -2411,14 +2410,18 @@ internal DF_Entity *
 df_entity_from_id(DF_EntityID id)
 {
   DF_Entity *result = &df_g_nil_entity;
-  for(DF_Entity *e = df_entity_root();
-      !df_entity_is_nil(e);
-      e = df_entity_rec_df_pre(e, &df_g_nil_entity).next)
+  DF_EntityIndex *index = &df_state->entity_id_index;
+  if(index->slots_count != 0)
   {
-    if(e->id == id)
+    U64 hash = df_hash_from_string(str8_struct(&id));
+    DF_EntityIndexSlot *slot = &index->slots[hash%index->slots_count];
+    for(DF_EntityIndexNode *n = slot->first; n != 0; n = n->next)
     {
-      result = e;
-      break;
+      if(n->entity->id == id)
+      {
+        result = n->entity;
+        break;
+      }
     }
   }
   return result;
@@ -2428,14 +2431,19 @@ internal DF_Entity *
 df_machine_entity_from_machine_id(CTRL_MachineID machine_id)
 {
   DF_Entity *result = &df_g_nil_entity;
-  for(DF_Entity *e = df_entity_root();
-      !df_entity_is_nil(e);
-      e = df_entity_rec_df_pre(e, &df_g_nil_entity).next)
+  DF_EntityIndex *index = &df_state->entity_ctrl_index;
+  if(index->slots_count != 0)
   {
-    if(e->kind == DF_EntityKind_Machine && e->ctrl_machine_id == machine_id)
+    U64 hash = df_hash_from_ctrl_machine_id_handle(machine_id, dmn_handle_zero());
+    DF_EntityIndexSlot *slot = &index->slots[hash%index->slots_count];
+    for(DF_EntityIndexNode *n = slot->first; n != 0; n = n->next)
     {
-      result = e;
-      break;
+      DF_Entity *e = n->entity;
+      if(e->kind == DF_EntityKind_Machine && e->ctrl_machine_id == machine_id)
+      {
+        result = e;
+        break;
+      }
     }
   }
   if(df_entity_is_nil(result))
@@ -2450,14 +2458,15 @@ internal DF_Entity *
 df_entity_from_ctrl_handle(CTRL_MachineID machine_id, DMN_Handle handle)
 {
   DF_Entity *result = &df_g_nil_entity;
-  if(handle.u64[0] != 0)
+  DF_EntityIndex *index = &df_state->entity_ctrl_index;
+  if(handle.u64[0] != 0 && index->slots_count != 0)
   {
-    for(DF_Entity *e = df_entity_root();
-        !df_entity_is_nil(e);
-        e = df_entity_rec_df_pre(e, &df_g_nil_entity).next)
+    U64 hash = df_hash_from_ctrl_machine_id_handle(machine_id, handle);
+    DF_EntityIndexSlot *slot = &index->slots[hash%index->slots_count];
+    for(DF_EntityIndexNode *n = slot->first; n != 0; n = n->next)
     {
-      if(e->flags & DF_EntityFlag_HasCtrlMachineID &&
-         e->flags & DF_EntityFlag_HasCtrlHandle &&
+      DF_Entity *e = n->entity;
+      if(e->flags & DF_EntityFlag_HasCtrlHandle &&
          e->ctrl_machine_id == machine_id &&
          MemoryMatchStruct(&e->ctrl_handle, &handle))
       {
@@ -2725,6 +2734,72 @@ df_core_view_rule_spec_from_string(String8 string)
   return spec;
 }
 
+////////////////////////////////
+//~ rjf: Cached Control Flow Analysis
+
+internal DF_CtrlFlowInfo
+df_ctrl_flow_info_from_module_vaddr_range__cached(Arena *arena, DF_InstFlags exit_points_mask, DF_Entity *module, Architecture arch, Rng1U64 vaddr_range, B32 *good_out)
+{
+  DF_CtrlFlowInfo info = {0};
+  B32 good = 0;
+  
+  //- rjf: vaddr range => containing procedure's vaddr range
+  DF_Entity *process = df_entity_ancestor_from_kind(module, DF_EntityKind_Process);
+  DI_Key dbgi_key = df_dbgi_key_from_module(module);
+  Rng1U64 proc_voff_range = df_proc_voff_range_from_dbgi_key_voff(&dbgi_key, df_voff_from_vaddr(module, vaddr_range.min));
+  Rng1U64 proc_vaddr_range = df_vaddr_range_from_voff_range(module, proc_voff_range);
+  B32 proc_is_cacheable = (proc_voff_range.max != 0 &&
+                           dim_1u64(proc_vaddr_range) <= MB(1) &&
+                           proc_vaddr_range.min <= vaddr_range.min && vaddr_range.max <= proc_vaddr_range.max);
+  
+  //- rjf: procedure => cached flow info; only use the latest copy of the
+  // procedure's code bytes, as stepping must not run on stale analysis
+  if(proc_is_cacheable)
+  {
+    FLOW_Scope *flow_scope = flow_scope_open();
+    U128 key = ctrl_hash_store_key_from_process_vaddr_range(process->ctrl_machine_id, process->ctrl_handle, proc_vaddr_range, 0);
+    FLOW_Params params = {proc_vaddr_range, arch};
+    FLOW_Info flow_info = flow_info_from_hash_params(flow_scope, hs_hash_from_key(key, 0), &params);
+    U64 first_inst_idx = flow_inst_idx_from_vaddr(&flow_info, vaddr_range.min);
+    if(first_inst_idx < flow_info.insts.count &&
+       flow_info.vaddr_range.min + flow_info.insts.v[first_inst_idx].off == vaddr_range.min)
+    {
+      good = 1;
+      for(U64 idx = first_inst_idx; idx < flow_info.insts.count; idx += 1)
+      {
+        FLOW_Inst *inst = &flow_info.insts.v[idx];
+        U64 inst_vaddr = flow_info.vaddr_range.min + inst->off;
+        if(inst_vaddr >= vaddr_range.max)
+        {
+          break;
+        }
+        DF_InstFlags inst_flags = (DF_InstFlags)(inst->flags & 0xff);
+        info.cumulative_sp_delta += inst->sp_delta;
+        info.total_size += inst->size;
+        if(inst_flags & exit_points_mask)
+        {
+          DF_CtrlFlowPoint point = {0};
+          point.inst_flags = inst_flags;
+          point.vaddr = inst_vaddr;
+          point.jump_dest_vaddr = inst->jump_dest_vaddr;
+          point.expected_sp_delta = info.cumulative_sp_delta;
+          DF_CtrlFlowPointNode *node = push_array(arena, DF_CtrlFlowPointNode, 1);
+          node->v = point;
+          SLLQueuePush(info.exit_points.first, info.exit_points.last, node);
+          info.exit_points.count += 1;
+        }
+      }
+    }
+    flow_scope_close(flow_scope);
+  }
+  
+  if(good_out)
+  {
+    *good_out = good;
+  }
+  return info;
+}
+
 ////////////////////////////////
 //~ rjf: Stepping "Trap Net" Builders
 
@@ -2828,19 +2903,36 @@ df_trap_net_from_thread__step_over_inst(Arena *arena, DF_Entity *thread)
   
   // rjf: thread => unpacked info
   DF_Entity *process = df_entity_ancestor_from_kind(thread, DF_EntityKind_Process);
+  DF_Entity *module = df_module_from_thread(thread);
   Architecture arch = df_architecture_from_entity(thread);
   U64 ip_vaddr = ctrl_query_cached_rip_from_thread(df_state->ctrl_entity_store, thread->ctrl_machine_id, thread->ctrl_handle);
   
+  // rjf: ip => cached procedure ctrl flow analysis
+  B32 good_cached_ctrl_flow_info = 0;
+  DF_CtrlFlowInfo cached_ctrl_flow_info = df_ctrl_flow_info_from_module_vaddr_range__cached(scratch.arena, DF_InstFlag_Call|DF_InstFlag_Repeats, module, arch, r1u64(ip_vaddr, ip_vaddr+1), &good_cached_ctrl_flow_info);
+  
   // rjf: ip => machine code
   String8 machine_code = {0};
+  if(!good_cached_ctrl_flow_info)
   {
     Rng1U64 rng = r1u64(ip_vaddr, ip_vaddr+max_instruction_size_from_arch(arch));
     CTRL_ProcessMemorySlice machine_code_slice = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, rng, os_now_microseconds()+5000);
     machine_code = machine_code_slice.data;
   }
   
+  // rjf: build traps from cached analysis, if possible
+  if(good_cached_ctrl_flow_info)
+  {
+    // rjf: call => run until call returns
+    if(cached_ctrl_flow_info.exit_points.count != 0)
+    {
+      CTRL_Trap trap = {CTRL_TrapFlag_EndStepping, ip_vaddr+cached_ctrl_flow_info.total_size};
+      ctrl_trap_list_push(arena, &result, &trap);
+    }
+  }
+  
   // rjf: build traps if machine code was read successfully
-  if(machine_code.size != 0)
+  else if(machine_code.size != 0)
   {
     // rjf: decode instruction
     DF_Inst inst = df_single_inst_from_machine_code(scratch.arena, arch, ip_vaddr, machine_code);
@@ -2903,9 +2995,26 @@ df_trap_net_from_thread__step_over_line(Arena *arena, DF_Entity *thread)
   // rjf: line vaddr range => did we find anything successfully?
   B32 good_line_info = (line_vaddr_rng.max != 0);
   
+  // rjf: line vaddr range => cached procedure ctrl flow analysis
+  B32 good_cached_ctrl_flow_info = 0;
+  DF_CtrlFlowInfo ctrl_flow_info = {0};
+  if(good_line_info)
+  {
+    ctrl_flow_info = df_ctrl_flow_info_from_module_vaddr_range__cached(scratch.arena,
+                                                                       DF_InstFlag_Call|
+                                                                       DF_InstFlag_Branch|
+                                                                       DF_InstFlag_UnconditionalJump|
+                                                                       DF_InstFlag_ChangesStackPointer|
+                                                                       DF_InstFlag_Return,
+                                                                       module,
+                                                                       arch,
+                                                                       line_vaddr_rng,
+                                                                       &good_cached_ctrl_flow_info);
+  }
+  
   // rjf: line vaddr range => line's machine code
   String8 machine_code = {0};
-  if(good_line_info)
+  if(good_line_info && !good_cached_ctrl_flow_info)
   {
     CTRL_ProcessMemorySlice machine_code_slice = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, line_vaddr_rng, os_now_microseconds()+50000);
     machine_code = machine_code_slice.data;
@@ -2928,8 +3037,7 @@ df_trap_net_from_thread__step_over_line(Arena *arena, DF_Entity *thread)
   }
   
   // rjf: machine code => ctrl flow analysis
-  DF_CtrlFlowInfo ctrl_flow_info = {0};
-  if(good_line_info)
+  if(good_line_info && !good_cached_ctrl_flow_info)
   {
     ctrl_flow_info = df_ctrl_flow_info_from_arch_vaddr_code(scratch.arena,
                                                             DF_InstFlag_Call|
@@ -2940,6 +3048,9 @@ df_trap_net_from_thread__step_over_line(Arena *arena, DF_Entity *thread)
                                                             arch,
                                                             line_vaddr_rng.min,
                                                             machine_code);
+  }
+  if(good_line_info)
+  {
     LogInfoNamedBlockF("ctrl_flow_info")
     {
       log_infof("flags: %x\n", ctrl_flow_info.flags);
@@ -3059,17 +3170,33 @@ df_trap_net_from_thread__step_into_line(Arena *arena, DF_Entity *thread)
   // rjf: line vaddr range => did we find anything successfully?
   B32 good_line_info = (line_vaddr_rng.max != 0);
   
+  // rjf: line vaddr range => cached procedure ctrl flow analysis
+  B32 good_cached_ctrl_flow_info = 0;
+  DF_CtrlFlowInfo ctrl_flow_info = {0};
+  if(good_line_info)
+  {
+    ctrl_flow_info = df_ctrl_flow_info_from_module_vaddr_range__cached(scratch.arena,
+                                                                       DF_InstFlag_Call|
+                                                                       DF_InstFlag_Branch|
+                                                                       DF_InstFlag_UnconditionalJump|
+                                                                       DF_InstFlag_ChangesStackPointer|
+                                                                       DF_InstFlag_Return,
+                                                                       module,
+                                                                       arch,
+                                                                       line_vaddr_rng,
+                                                                       &good_cached_ctrl_flow_info);
+  }
+  
   // rjf: line vaddr range => line's machine code
   String8 machine_code = {0};
-  if(good_line_info)
+  if(good_line_info && !good_cached_ctrl_flow_info)
   {
     CTRL_ProcessMemorySlice machine_code_slice = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, line_vaddr_rng, os_now_microseconds()+5000);
     machine_code = machine_code_slice.data;
   }
   
   // rjf: machine code => ctrl flow analysis
-  DF_CtrlFlowInfo ctrl_flow_info = {0};
-  if(good_line_info)
+  if(good_line_info && !good_cached_ctrl_flow_info)
   {
     ctrl_flow_info = df_ctrl_flow_info_from_arch_vaddr_code(scratch.arena,
                                                             DF_InstFlag_Call|
@@ -3262,6 +3389,34 @@ df_symbol_name_from_process_vaddr(Arena *arena, DF_Entity *process, U64 vaddr)
   return result;
 }
 
+//- rjf: voff -> procedure range lookups
+
+internal Rng1U64
+df_proc_voff_range_from_dbgi_key_voff(DI_Key *dbgi_key, U64 voff)
+{
+  Rng1U64 result = {0};
+  DI_Scope *scope = di_scope_open();
+  RDI_Parsed *rdi = di_rdi_from_key(scope, dbgi_key, 0);
+  U64 scope_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_ScopeVMap, voff);
+  RDI_Scope *scope_ptr = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
+  RDI_Procedure *procedure = rdi_element_from_name_idx(rdi, Procedures, scope_ptr->proc_idx);
+  RDI_Scope *root_scope = rdi_element_from_name_idx(rdi, Scopes, procedure->root_scope_idx);
+  U64 scope_voffs_count = 0;
+  U64 *scope_voffs = rdi_table_from_name(rdi, ScopeVOffData, &scope_voffs_count);
+  U64 voff_range_opl = Min(root_scope->voff_range_opl, scope_voffs_count);
+  for(U64 idx = root_scope->voff_range_first; idx+1 < voff_range_opl; idx += 2)
+  {
+    Rng1U64 range = r1u64(scope_voffs[idx], scope_voffs[idx+1]);
+    if(contains_1u64(range, voff))
+    {
+      result = range;
+      break;
+    }
+  }
+  di_scope_close(scope);
+  return result;
+}
+
 //- rjf: src -> voff lookups
 
 internal DF_TextLineSrc2DasmInfoListArray
@@ -3296,10 +3451,8 @@ df_text_line_src2dasm_info_list_array_from_src_line_range(Arena *arena, DF_Entit
       U32 src_id = 0;
       if(rdi != &di_rdi_parsed_nil)
       {
-        RDI_NameMap *mapptr = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_NormalSourcePaths);
-        RDI_ParsedNameMap map = {0};
-        rdi_parsed_from_name_map(rdi, mapptr, &map);
-        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, file_path_normalized.str, file_path_normalized.size);
+        RDI_ParsedNameMap *map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_NormalSourcePaths);
+        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, file_path_normalized.str, file_path_normalized.size);
         if(node != 0)
         {
           U32 id_count = 0;
@@ -3465,10 +3618,8 @@ df_voff_from_dbgi_key_symbol_name(DI_Key *dbgi_key, String8 symbol_name)
           name_map_kind_idx += 1)
       {
         RDI_NameMapKind name_map_kind = name_map_kinds[name_map_kind_idx];
-        RDI_NameMap *name_map = rdi_element_from_name_idx(rdi, NameMaps, name_map_kind);
-        RDI_ParsedNameMap parsed_name_map = {0};
-        rdi_parsed_from_name_map(rdi, name_map, &parsed_name_map);
-        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &parsed_name_map, symbol_name.str, symbol_name.size);
+        RDI_ParsedNameMap *parsed_name_map = rdi_parsed_name_map_from_kind(rdi, name_map_kind);
+        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, parsed_name_map, symbol_name.str, symbol_name.size);
         
         // rjf: node -> num
         U64 entity_num = 0;
@@ -3533,10 +3684,8 @@ df_type_num_from_dbgi_key_name(DI_Key *dbgi_key, String8 name)
   U64 result = 0;
   {
     RDI_Parsed *rdi = di_rdi_from_key(scope, dbgi_key, 0);
-    RDI_NameMap *name_map = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_Types);
-    RDI_ParsedNameMap parsed_name_map = {0};
-    rdi_parsed_from_name_map(rdi, name_map, &parsed_name_map);
-    RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &parsed_name_map, name.str, name.size);
+    RDI_ParsedNameMap *parsed_name_map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_Types);
+    RDI_NameMapNode *node = rdi_name_map_lookup(rdi, parsed_name_map, name.str, name.size);
     U64 entity_num = 0;
     if(node != 0)
     {
@@ -3567,17 +3716,101 @@ df_type_num_from_dbgi_key_name(DI_Key *dbgi_key, String8 name)
 ////////////////////////////////
 //~ rjf: Process/Thread/Module Info Lookups
 
+internal int
+df_qsort_compare_modules_vaddr_rng_min(DF_Entity **a, DF_Entity **b)
+{
+  int result = 0;
+  if(a[0]->vaddr_rng.min < b[0]->vaddr_rng.min)
+  {
+    result = -1;
+  }
+  else if(a[0]->vaddr_rng.min > b[0]->vaddr_rng.min)
+  {
+    result = +1;
+  }
+  return result;
+}
+
 internal DF_Entity *
 df_module_from_process_vaddr(DF_Entity *process, U64 vaddr)
 {
   ProfBeginFunction();
   DF_Entity *module = &df_g_nil_entity;
-  for(DF_Entity *child = process->first; !df_entity_is_nil(child); child = child->next)
+  DF_ModuleIndexCache *cache = &df_state->module_index_cache;
+  if(!df_entity_is_nil(process) && cache->slots_count != 0)
   {
-    if(child->kind == DF_EntityKind_Module && contains_1u64(child->vaddr_rng, vaddr))
+    //- rjf: map process -> module index node
+    DF_Handle process_handle = df_handle_from_entity(process);
+    U64 hash = df_hash_from_string(str8_struct(&process_handle));
+    DF_ModuleIndexSlot *slot = &cache->slots[hash%cache->slots_count];
+    DF_ModuleIndexNode *node = 0;
+    for(DF_ModuleIndexNode *n = slot->first; n != 0; n = n->next)
     {
-      module = child;
-      break;
+      if(df_handle_match(n->process, process_handle))
+      {
+        node = n;
+        break;
+      }
+    }
+    if(node == 0)
+    {
+      node = cache->free_node;
+      if(node != 0)
+      {
+        SLLStackPop(cache->free_node);
+      }
+      else
+      {
+        node = push_array_no_zero(df_state->arena, DF_ModuleIndexNode, 1);
+      }
+      MemoryZeroStruct(node);
+      node->process = process_handle;
+      node->gen = cache->gen - 1;
+      node->arena = arena_alloc();
+      DLLPushBack(slot->first, slot->last, node);
+    }
+    
+    //- rjf: stale -> rebuild sorted module array
+    if(node->gen != cache->gen)
+    {
+      arena_clear(node->arena);
+      node->gen = cache->gen;
+      node->modules_count = 0;
+      for(DF_Entity *child = process->first; !df_entity_is_nil(child); child = child->next)
+      {
+        node->modules_count += (child->kind == DF_EntityKind_Module);
+      }
+      node->modules = push_array_no_zero(node->arena, DF_Entity *, node->modules_count);
+      U64 module_idx = 0;
+      for(DF_Entity *child = process->first; !df_entity_is_nil(child); child = child->next)
+      {
+        if(child->kind == DF_EntityKind_Module)
+        {
+          node->modules[module_idx] = child;
+          module_idx += 1;
+        }
+      }
+      qsort(node->modules, node->modules_count, sizeof(node->modules[0]), (int (*)(const void *, const void *))df_qsort_compare_modules_vaddr_rng_min);
+    }
+    
+    //- rjf: binary search for last module with vaddr_rng.min <= vaddr
+    U64 first = 0;
+    U64 opl = node->modules_count;
+    for(;first < opl;)
+    {
+      U64 mid = first + (opl - first)/2;
+      if(node->modules[mid]->vaddr_rng.min <= vaddr)
+      {
+        first = mid+1;
+      }
+      else
+      {
+        opl = mid;
+      }
+    }
+    if(first > 0 && contains_1u64(node->modules[first-1]->vaddr_rng, vaddr))
+    {
+      module = node->modules[first-1];
     }
   }
   ProfEnd();
@@ -4100,10 +4333,8 @@ df_eval_parse_ctx_from_src_loc(DI_Scope *scope, DF_Entity *file, TxtPt pt)
       B32 good_src_id = 0;
       U32 src_id = 0;
       {
-        RDI_NameMap *mapptr = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_NormalSourcePaths);
-        RDI_ParsedNameMap map = {0};
-        rdi_parsed_from_name_map(rdi, mapptr, &map);
-        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, file_path_normalized.str, file_path_normalized.size);
+        RDI_ParsedNameMap *map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_NormalSourcePaths);
+        RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, file_path_normalized.str, file_path_normalized.size);
         if(node != 0)
         {
           U32 id_count = 0;
@@ -5003,79 +5234,84 @@ df_filtered_data_members_from_members_cfg_table(Arena *arena, TG_MemberArray mem
   return filtered_members;
 }
 
-internal DF_EvalLinkBaseChunkList
-df_eval_link_base_chunk_list_from_eval(Arena *arena, TG_Graph *graph, RDI_Parsed *rdi, TG_Key link_member_type_key, U64 link_member_off, DF_CtrlCtx *ctrl_ctx, DF_Eval eval, U64 cap)
+internal DF_EvalLinkBaseArray
+df_eval_link_base_array_from_eval_idx_range(Arena *arena, TG_Graph *graph, RDI_Parsed *rdi, TG_Key link_member_type_key, U64 link_member_off, DF_CtrlCtx *ctrl_ctx, DF_Eval eval, Rng1U64 idx_range, U64 *total_count_out, B32 *is_complete_out)
 {
-  DF_EvalLinkBaseChunkList list = {0};
-  for(DF_Eval base_eval = eval, last_eval = zero_struct; list.count < cap;)
+  DF_EvalLinkBaseArray array = {0};
+  U64 total_count = 0;
+  B32 is_complete = 1;
+  DF_Entity *thread = df_entity_from_handle(ctrl_ctx->thread);
+  DF_Entity *process = thread->parent;
+  if(eval.offset != 0)
   {
-    // rjf: check this ptr's validity
-    if(base_eval.offset == 0 || (base_eval.offset == last_eval.offset && base_eval.mode == last_eval.mode))
+    //- rjf: the head of the chain may not be in memory (e.g. a register or an
+    // immediate), so it is always resolved directly. every link after it is
+    // addressed by the previous link's pointer value, so that chain is walked
+    // in the background by the link cache.
+    DF_EvalLinkBase head = {eval.mode, eval.offset};
+    U64 chain_first_vaddr = 0;
+    U64 chain_idx_off = 0;
+    if(eval.mode == EVAL_EvalMode_Addr)
     {
-      break;
+      chain_first_vaddr = eval.offset;
     }
-    
-    // rjf: gather
+    else
     {
-      DF_EvalLinkBaseChunkNode *chunk = list.last;
-      if(chunk == 0 || chunk->count == ArrayCount(chunk->b))
-      {
-        chunk = push_array_no_zero(arena, DF_EvalLinkBaseChunkNode, 1);
-        chunk->next = 0;
-        chunk->count = 0;
-        SLLQueuePush(list.first, list.last, chunk);
-      }
-      chunk->b[chunk->count].mode = base_eval.mode;
-      chunk->b[chunk->count].offset = base_eval.offset;
-      chunk->count += 1;
-      list.count += 1;
+      DF_Eval link_member_eval = {link_member_type_key, eval.mode, eval.offset + link_member_off};
+      DF_Eval link_member_value_eval = df_value_mode_eval_from_eval(graph, rdi, ctrl_ctx, link_member_eval);
+      chain_first_vaddr = link_member_value_eval.imm_u64;
+      chain_idx_off = 1;
     }
     
-    // rjf: grab link member
-    DF_Eval link_member_eval =
+    //- rjf: get chain info from link cache
+    LNK_Scope *lnk_scope = lnk_scope_open();
+    LNK_Params params = {0};
     {
-      link_member_type_key,
-      base_eval.mode,
-      base_eval.offset + link_member_off,
-    };
-    DF_Eval link_member_value_eval = df_value_mode_eval_from_eval(graph, rdi, ctrl_ctx, link_member_eval);
+      params.machine_id  = process->ctrl_machine_id;
+      params.process     = process->ctrl_handle;
+      params.first_vaddr = chain_first_vaddr;
+      params.link_off    = link_member_off;
+      params.link_size   = tg_byte_size_from_graph_rdi_key(graph, rdi, link_member_type_key);
+      params.mem_gen     = ctrl_mem_gen();
+    }
+    LNK_Info info = {0};
+    if(chain_first_vaddr != 0)
+    {
+      info = lnk_info_from_params(lnk_scope, &params);
+      is_complete = info.is_complete;
+    }
+    total_count = chain_idx_off + info.count;
     
-    // rjf: advance to next link
-    last_eval = base_eval;
-    base_eval.mode = EVAL_EvalMode_Addr;
-    base_eval.offset = link_member_value_eval.imm_u64;
-  }
-  return list;
-}
-
-internal DF_EvalLinkBase
-df_eval_link_base_from_chunk_list_index(DF_EvalLinkBaseChunkList *list, U64 idx)
-{
-  DF_EvalLinkBase result = zero_struct;
-  U64 scan_idx = 0;
-  for(DF_EvalLinkBaseChunkNode *chunk = list->first; chunk != 0; chunk = chunk->next)
-  {
-    U64 chunk_idx_opl = scan_idx+chunk->count;
-    if(scan_idx <= idx && idx < chunk_idx_opl)
+    //- rjf: fill requested window
+    Rng1U64 window = intersect_1u64(idx_range, r1u64(0, total_count));
+    array.count = dim_1u64(window);
+    array.v = push_array(arena, DF_EvalLinkBase, array.count);
+    U64 write_idx = 0;
+    if(chain_idx_off != 0 && window.min == 0 && array.count != 0)
     {
-      result = chunk->b[idx - scan_idx];
+      array.v[0] = head;
+      write_idx += 1;
     }
-    scan_idx = chunk_idx_opl;
+    if(write_idx < array.count)
+    {
+      Rng1U64 chain_window = r1u64(window.min + write_idx - chain_idx_off, window.max - chain_idx_off);
+      LNK_VAddrArray vaddrs = lnk_vaddr_array_from_params_idx_range(arena, lnk_scope, &params, chain_window);
+      for(U64 idx = 0; idx < vaddrs.count && write_idx < array.count; idx += 1, write_idx += 1)
+      {
+        array.v[write_idx].mode = EVAL_EvalMode_Addr;
+        array.v[write_idx].offset = vaddrs.v[idx];
+      }
+    }
+    array.count = write_idx;
+    lnk_scope_close(lnk_scope);
   }
-  return result;
-}
-
-internal DF_EvalLinkBaseArray
-df_eval_link_base_array_from_chunk_list(Arena *arena, DF_EvalLinkBaseChunkList *chunks)
-{
-  DF_EvalLinkBaseArray array = {0};
-  array.count = chunks->count;
-  array.v = push_array_no_zero(arena, DF_EvalLinkBase, array.count);
-  U64 idx = 0;
-  for(DF_EvalLinkBaseChunkNode *n = chunks->first; n != 0; n = n->next)
+  if(total_count_out != 0)
+  {
+    *total_count_out = total_count;
+  }
+  if(is_complete_out != 0)
   {
-    MemoryCopy(array.v + idx, n->b, n->count * sizeof(DF_EvalLinkBase));
-    idx += n->count;
+    *is_complete_out = is_complete;
   }
   return array;
 }
@@ -5397,11 +5633,11 @@ df_append_viz_blocks_for_parent__rec(Arena *arena, DI_Scope *scope, DF_EvalView
       link_member_is_good = 0;
     }
     
-    //- rjf: gather link bases
-    DF_EvalLinkBaseChunkList link_bases = {0};
+    //- rjf: gather link count
+    U64 link_count = 0;
     if(link_member_is_good)
     {
-      link_bases = df_eval_link_base_chunk_list_from_eval(scratch.arena, parse_ctx->type_graph, parse_ctx->rdi, link_member->type_key, link_member->off, ctrl_ctx, udt_eval, 512);
+      df_eval_link_base_array_from_eval_idx_range(scratch.arena, parse_ctx->type_graph, parse_ctx->rdi, link_member->type_key, link_member->off, ctrl_ctx, udt_eval, r1u64(0, 0), &link_count, 0);
     }
     
     //- rjf: build blocks for all links, split by sub-expansions
@@ -5414,15 +5650,15 @@ df_append_viz_blocks_for_parent__rec(Arena *arena, DI_Scope *scope, DF_EvalView
         last_vb->cfg_table = *cfg_table;
         last_vb->link_member_type_key = link_member->type_key;
         last_vb->link_member_off = link_member->off;
-        last_vb->visual_idx_range     = r1u64(0, link_bases.count);
-        last_vb->semantic_idx_range   = r1u64(0, link_bases.count);
+        last_vb->visual_idx_range     = r1u64(0, link_count);
+        last_vb->semantic_idx_range   = r1u64(0, link_count);
       }
       for(DF_ExpandNode *child = node->first; child != 0; child = child->next)
       {
         // rjf: unpack expansion info; skip out-of-bounds splits
         U64 child_num = child->key.child_num;
         U64 child_idx = child_num-1;
-        if(child_idx >= link_bases.count)
+        if(child_idx >= link_count)
         {
           continue;
         }
@@ -5431,7 +5667,12 @@ df_append_viz_blocks_for_parent__rec(Arena *arena, DI_Scope *scope, DF_EvalView
         last_vb = df_eval_viz_block_split_and_continue(arena, list_out, last_vb, child_idx);
         
         // rjf: find mode/offset of this link
-        DF_EvalLinkBase link_base = df_eval_link_base_from_chunk_list_index(&link_bases, child_idx);
+        DF_EvalLinkBaseArray link_bases = df_eval_link_base_array_from_eval_idx_range(scratch.arena, parse_ctx->type_graph, parse_ctx->rdi, link_member->type_key, link_member->off, ctrl_ctx, udt_eval, r1u64(child_idx, child_idx+1), 0, 0);
+        DF_EvalLinkBase link_base = zero_struct;
+        if(link_bases.count != 0)
+        {
+          link_base = link_bases.v[0];
+        }
         
         // rjf: recurse for sub-expansion
         {
@@ -6362,8 +6603,8 @@ df_query_cached_unwind_from_thread(DF_Entity *thread)
   CTRL_Unwind result = {0};
   if(thread->kind == DF_EntityKind_Thread)
   {
-    U64 reg_gen = ctrl_reg_gen();
-    U64 mem_gen = ctrl_mem_gen();
+    U64 reg_gen = ctrl_reg_gen_from_machine_id(thread->ctrl_machine_id);
+    U64 mem_gen = ctrl_mem_gen_from_machine_id(thread->ctrl_machine_id);
     DF_UnwindCache *cache = &df_state->unwind_cache;
     DF_Handle handle = df_handle_from_entity(thread);
     U64 hash = df_hash_from_string(str8_struct(&handle));
@@ -6679,6 +6920,12 @@ df_core_init(CmdLine *cmdln, DF_StateDeltaHistory *hist)
   df_state->entities_root = &df_g_nil_entity;
   df_state->entities_base = push_array(df_state->entities_arena, DF_Entity, 0);
   df_state->entities_count = 0;
+  df_state->entity_id_index.slots_count = 4096;
+  df_state->entity_id_index.slots = push_array(arena, DF_EntityIndexSlot, df_state->entity_id_index.slots_count);
+  df_state->entity_ctrl_index.slots_count = 4096;
+  df_state->entity_ctrl_index.slots = push_array(arena, DF_EntityIndexSlot, df_state->entity_ctrl_index.slots_count);
+  df_state->module_index_cache.slots_count = 256;
+  df_state->module_index_cache.slots = push_array(arena, DF_ModuleIndexSlot, df_state->module_index_cache.slots_count);
   df_state->ctrl_msg_arena = arena_alloc();
   df_state->ctrl_entity_store = ctrl_entity_store_alloc();
   df_state->ctrl_stop_arena = arena_alloc();
@@ -7852,10 +8099,12 @@ df_core_begin_frame(Arena *arena, DF_CmdList *cmds, F32 dt)
         case DF_CoreCmdKind_Undo:
         {
           df_state_delta_history_wind(df_state->hist, Side_Min);
+          df_entity_indices_rebuild();
         }break;
         case DF_CoreCmdKind_Redo:
         {
           df_state_delta_history_wind(df_state->hist, Side_Max);
+          df_entity_indices_rebuild();
         }break;
         
         //- rjf: files
@@ -9110,6 +9359,22 @@ df_core_end_frame(void)
     }
   }
   
+  //- rjf: garbage collect eliminated process module indices
+  for(U64 slot_idx = 0; slot_idx < df_state->module_index_cache.slots_count; slot_idx += 1)
+  {
+    DF_ModuleIndexSlot *slot = &df_state->module_index_cache.slots[slot_idx];
+    for(DF_ModuleIndexNode *n = slot->first, *next = 0; n != 0; n = next)
+    {
+      next = n->next;
+      if(df_entity_is_nil(df_entity_from_handle(n->process)))
+      {
+        DLLRemove(slot->first, slot->last, n);
+        arena_release(n->arena);
+        SLLStackPush(df_state->module_index_cache.free_node, n);
+      }
+    }
+  }
+  
   //- rjf: write config changes
   ProfScope("write config changes")
   {
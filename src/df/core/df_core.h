@@ -702,22 +702,6 @@ struct DF_EvalLinkBase
   U64 offset;
 };
 
-typedef struct DF_EvalLinkBaseChunkNode DF_EvalLinkBaseChunkNode;
-struct DF_EvalLinkBaseChunkNode
-{
-  DF_EvalLinkBaseChunkNode *next;
-  DF_EvalLinkBase b[64];
-  U64 count;
-};
-
-typedef struct DF_EvalLinkBaseChunkList DF_EvalLinkBaseChunkList;
-struct DF_EvalLinkBaseChunkList
-{
-  DF_EvalLinkBaseChunkNode *first;
-  DF_EvalLinkBaseChunkNode *last;
-  U64 count;
-};
-
 typedef struct DF_EvalLinkBaseArray DF_EvalLinkBaseArray;
 struct DF_EvalLinkBaseArray
 {
@@ -969,6 +953,60 @@ struct DF_EntityListCache
   DF_EntityList list;
 };
 
+//- rjf: entity lookup indices
+
+typedef struct DF_EntityIndexNode DF_EntityIndexNode;
+struct DF_EntityIndexNode
+{
+  DF_EntityIndexNode *next;
+  DF_EntityIndexNode *prev;
+  DF_Entity *entity;
+};
+
+typedef struct DF_EntityIndexSlot DF_EntityIndexSlot;
+struct DF_EntityIndexSlot
+{
+  DF_EntityIndexNode *first;
+  DF_EntityIndexNode *last;
+};
+
+typedef struct DF_EntityIndex DF_EntityIndex;
+struct DF_EntityIndex
+{
+  U64 slots_count;
+  DF_EntityIndexSlot *slots;
+};
+
+//- rjf: per-process module address range index cache
+
+typedef struct DF_ModuleIndexNode DF_ModuleIndexNode;
+struct DF_ModuleIndexNode
+{
+  DF_ModuleIndexNode *next;
+  DF_ModuleIndexNode *prev;
+  DF_Handle process;
+  U64 gen;
+  Arena *arena;
+  DF_Entity **modules; // NOTE: sorted by vaddr_rng.min
+  U64 modules_count;
+};
+
+typedef struct DF_ModuleIndexSlot DF_ModuleIndexSlot;
+struct DF_ModuleIndexSlot
+{
+  DF_ModuleIndexNode *first;
+  DF_ModuleIndexNode *last;
+};
+
+typedef struct DF_ModuleIndexCache DF_ModuleIndexCache;
+struct DF_ModuleIndexCache
+{
+  U64 gen;
+  U64 slots_count;
+  DF_ModuleIndexSlot *slots;
+  DF_ModuleIndexNode *free_node;
+};
+
 //- rjf: auto view rules hash table cache
 
 typedef struct DF_AutoViewRuleNode DF_AutoViewRuleNode;
@@ -1192,6 +1230,12 @@ struct DF_State
   B32 entities_mut_soft_halt;
   B32 entities_mut_dbg_info_map;
   
+  // rjf: entity lookup indices
+  DF_EntityIndex entity_id_index;
+  DF_EntityIndex entity_ctrl_index;
+  DF_EntityIndexNode *free_entity_index_node;
+  DF_ModuleIndexCache module_index_cache;
+  
   // rjf: entity query caches
   U64 kind_alloc_gens[DF_EntityKind_COUNT];
   DF_EntityListCache kind_caches[DF_EntityKind_COUNT];
@@ -1490,6 +1534,14 @@ internal void df_name_release(DF_StateDeltaHistory *hist, String8 string);
 //- rjf: entity mutation notification codepath
 internal void df_entity_notify_mutation(DF_Entity *entity);
 
+//- rjf: entity lookup index maintenance
+internal U64 df_hash_from_ctrl_machine_id_handle(CTRL_MachineID machine_id, DMN_Handle handle);
+internal void df_entity_index_insert(DF_EntityIndex *index, U64 hash, DF_Entity *entity);
+internal void df_entity_index_remove(DF_EntityIndex *index, U64 hash, DF_Entity *entity);
+internal void df_entity_ctrl_index_insert(DF_Entity *entity);
+internal void df_entity_ctrl_index_remove(DF_Entity *entity);
+internal void df_entity_indices_rebuild(void);
+
 //- rjf: entity allocation + tree forming
 internal DF_Entity *df_entity_alloc(DF_StateDeltaHistory *hist, DF_Entity *parent, DF_EntityKind kind);
 internal void df_entity_mark_for_deletion(DF_Entity *entity);
@@ -1556,6 +1608,11 @@ internal DF_CmdSpecList df_push_cmd_spec_list(Arena *arena);
 internal void df_register_core_view_rule_specs(DF_CoreViewRuleSpecInfoArray specs);
 internal DF_CoreViewRuleSpec *df_core_view_rule_spec_from_string(String8 string);
 
+////////////////////////////////
+//~ rjf: Cached Control Flow Analysis
+
+internal DF_CtrlFlowInfo df_ctrl_flow_info_from_module_vaddr_range__cached(Arena *arena, DF_InstFlags exit_points_mask, DF_Entity *module, Architecture arch, Rng1U64 vaddr_range, B32 *good_out);
+
 ////////////////////////////////
 //~ rjf: Stepping "Trap Net" Builders
 
@@ -1584,6 +1641,9 @@ internal Rng1U64 df_vaddr_range_from_voff_range(DF_Entity *module, Rng1U64 voff_
 internal String8 df_symbol_name_from_dbgi_key_voff(Arena *arena, DI_Key *dbgi_key, U64 voff);
 internal String8 df_symbol_name_from_process_vaddr(Arena *arena, DF_Entity *process, U64 vaddr);
 
+//- rjf: voff -> procedure range lookups
+internal Rng1U64 df_proc_voff_range_from_dbgi_key_voff(DI_Key *dbgi_key, U64 voff);
+
 //- rjf: src -> voff lookups
 internal DF_TextLineSrc2DasmInfoListArray df_text_line_src2dasm_info_list_array_from_src_line_range(Arena *arena, DF_Entity *file, Rng1S64 line_num_range);
 
@@ -1597,6 +1657,7 @@ internal U64 df_type_num_from_dbgi_key_name(DI_Key *dbgi_key, String8 name);
 ////////////////////////////////
 //~ rjf: Process/Thread/Module Info Lookups
 
+internal int df_qsort_compare_modules_vaddr_rng_min(DF_Entity **a, DF_Entity **b);
 internal DF_Entity *df_module_from_process_vaddr(DF_Entity *process, U64 vaddr);
 internal DF_Entity *df_module_from_thread(DF_Entity *thread);
 internal U64 df_tls_base_vaddr_from_process_root_rip(DF_Entity *process, U64 root_vaddr, U64 rip_vaddr);
@@ -1664,9 +1725,7 @@ internal B32 df_commit_eval_value(TG_Graph *graph, RDI_Parsed *rdi, DF_CtrlCtx *
 
 //- rjf: type helpers
 internal TG_MemberArray df_filtered_data_members_from_members_cfg_table(Arena *arena, TG_MemberArray members, DF_CfgTable *cfg);
-internal DF_EvalLinkBaseChunkList df_eval_link_base_chunk_list_from_eval(Arena *arena, TG_Graph *graph, RDI_Parsed *rdi, TG_Key link_member_type_key, U64 link_member_off, DF_CtrlCtx *ctrl_ctx, DF_Eval eval, U64 cap);
-internal DF_EvalLinkBase df_eval_link_base_from_chunk_list_index(DF_EvalLinkBaseChunkList *list, U64 idx);
-internal DF_EvalLinkBaseArray df_eval_link_base_array_from_chunk_list(Arena *arena, DF_EvalLinkBaseChunkList *chunks);
+internal DF_EvalLinkBaseArray df_eval_link_base_array_from_eval_idx_range(Arena *arena, TG_Graph *graph, RDI_Parsed *rdi, TG_Key link_member_type_key, U64 link_member_off, DF_CtrlCtx *ctrl_ctx, DF_Eval eval, Rng1U64 idx_range, U64 *total_count_out, B32 *is_complete_out);
 
 //- rjf: viz block collection building
 internal DF_EvalVizBlock *df_eval_viz_block_begin(Arena *arena, DF_EvalVizBlockKind kind, DF_ExpandKey parent_key, DF_ExpandKey key, S32 depth);
@@ -65,6 +65,23 @@ df_path_query_from_string(String8 string)
   return path_query;
 }
 
+#if OS_FEATURE_SYNC_STATS
+internal OS_SyncStats
+df_sync_stats_from_stripes(void *stripes, U64 stripes_count, U64 stripe_size, U64 rw_mutex_off)
+{
+  OS_SyncStats stats = {0};
+  for(U64 idx = 0; idx < stripes_count; idx += 1)
+  {
+    OS_Handle rw_mutex = *(OS_Handle *)((U8 *)stripes + idx*stripe_size + rw_mutex_off);
+    OS_SyncStats stripe_stats = os_sync_stats_from_handle(rw_mutex);
+    stats.acquire_count   += stripe_stats.acquire_count;
+    stats.contended_count += stripe_stats.contended_count;
+    stats.wait_us         += stripe_stats.wait_us;
+  }
+  return stats;
+}
+#endif
+
 ////////////////////////////////
 //~ rjf: View Type Functions
 
@@ -3450,6 +3467,7 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
   //
   UI_Box *autocomp_box = &ui_g_nil_box;
   UI_Box *hover_eval_box = &ui_g_nil_box;
+  U64 ui_build_begin_us = os_now_microseconds();
   ProfScope("build UI")
   {
     ////////////////////////////
@@ -3700,7 +3718,48 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
             ui_spacer(ui_em(2.f, 1.f));
             ui_labelf("Average UI Hash Chain Length: %f", avg_ui_hash_chain_length);
           }
+          ui_set_next_pref_width(ui_children_sum(1));
+          ui_set_next_pref_height(ui_children_sum(1));
+          UI_Row
+          {
+            ui_spacer(ui_em(2.f, 1.f));
+            ui_labelf("Build: %I64uus, Layout: %I64uus, Draw: %I64uus, Submit: %I64uus", window->last_ui_build_us, window->ui->last_build_layout_us, window->last_draw_build_us, window->last_submit_us);
+          }
+        }
+        
+        //- rjf: draw cache-layer lock contention stats
+#if OS_FEATURE_SYNC_STATS
+        {
+          struct
+          {
+            String8 name;
+            void *stripes;
+            U64 stripes_count;
+            U64 stripe_size;
+            U64 rw_mutex_off;
+          }
+          layers[] =
+          {
+            {str8_lit_comp("Debug Info"), di_shared ? di_shared->stripes : 0, di_shared ? di_shared->stripes_count : 0, sizeof(DI_Stripe), OffsetOf(DI_Stripe, rw_mutex)},
+            {str8_lit_comp("Hash Store"), hs_shared ? hs_shared->stripes : 0, hs_shared ? hs_shared->stripes_count : 0, sizeof(HS_Stripe), OffsetOf(HS_Stripe, rw_mutex)},
+            {str8_lit_comp("Text Cache"), txt_shared ? txt_shared->stripes : 0, txt_shared ? txt_shared->stripes_count : 0, sizeof(TXT_Stripe), OffsetOf(TXT_Stripe, rw_mutex)},
+            {str8_lit_comp("Flow Cache"), flow_shared ? flow_shared->stripes : 0, flow_shared ? flow_shared->stripes_count : 0, sizeof(FLOW_Stripe), OffsetOf(FLOW_Stripe, rw_mutex)},
+            {str8_lit_comp("Link Cache"), lnk_shared ? lnk_shared->stripes : 0, lnk_shared ? lnk_shared->stripes_count : 0, sizeof(LNK_Stripe), OffsetOf(LNK_Stripe, rw_mutex)},
+          };
+          ui_labelf("Lock Contention:");
+          for(U64 idx = 0; idx < ArrayCount(layers); idx += 1)
+          {
+            OS_SyncStats stats = df_sync_stats_from_stripes(layers[idx].stripes, layers[idx].stripes_count, layers[idx].stripe_size, layers[idx].rw_mutex_off);
+            ui_set_next_pref_width(ui_children_sum(1));
+            ui_set_next_pref_height(ui_children_sum(1));
+            UI_Row
+            {
+              ui_spacer(ui_em(2.f, 1.f));
+              ui_labelf("%S: %I64u acquires, %I64u contended, %I64uus waiting", layers[idx].name, stats.acquire_count, stats.contended_count, stats.wait_us);
+            }
+          }
         }
+#endif
         
         //- rjf: draw entity file tree
 #if 0
@@ -5143,6 +5202,13 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
                 ui_box_equip_display_string(box, task_text);
               }
             }
+            DI_LoadProgress dbgi_progress = di_load_progress();
+            if(dbgi_progress.parsed_count < dbgi_progress.open_count)
+            {
+              String8 task_text = push_str8f(scratch.arena, "Loading debug info (%I64u/%I64u)...", dbgi_progress.parsed_count, dbgi_progress.open_count);
+              UI_Box *box = ui_build_box_from_stringf(UI_BoxFlag_DrawText|UI_BoxFlag_DrawBorder|UI_BoxFlag_DrawBackground, "###dbgi_load_progress");
+              ui_box_equip_display_string(box, task_text);
+            }
             scratch_end(scratch);
           }
         }
@@ -7535,6 +7601,7 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
     }
   }
   ui_end_build();
+  ws->last_ui_build_us = os_now_microseconds() - ui_build_begin_us;
   
   //////////////////////////////
   //- rjf: ensure hover eval is in-bounds
@@ -7606,6 +7673,7 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
   //////////////////////////////
   //- rjf: draw UI
   //
+  U64 draw_build_begin_us = os_now_microseconds();
   ws->draw_bucket = d_bucket_make();
   D_BucketScope(ws->draw_bucket)
     ProfScope("draw UI")
@@ -7797,7 +7865,7 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
         if(!(box->flags & UI_BoxFlag_DisableTextTrunc))
         {
           max_x = (box->rect.x1-text_position.x);
-          ellipses_run = f_push_run_from_string(scratch.arena, box->font, box->font_size, 0, box->tab_size, 0, str8_lit("..."));
+          ellipses_run = f_push_cached_run_from_string(scratch.arena, box->font, box->font_size, 0, box->tab_size, 0, str8_lit("..."));
         }
         d_truncated_fancy_run_list(text_position, &box->display_string_runs, max_x, ellipses_run);
         if(box->flags & UI_BoxFlag_HasFuzzyMatchRanges)
@@ -8076,6 +8144,7 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
     
     scratch_end(scratch);
   }
+  ws->last_draw_build_us = os_now_microseconds() - draw_build_begin_us;
   
   //////////////////////////////
   //- rjf: show window after first frame
@@ -8769,16 +8838,20 @@ df_eval_viz_windowed_row_list_from_viz_block_list(Arena *arena, DI_Scope *scope,
       //
       case DF_EvalVizBlockKind_Links:
       {
-        DF_EvalLinkBaseChunkList link_base_chunks = df_eval_link_base_chunk_list_from_eval(scratch.arena, parse_ctx->type_graph, parse_ctx->rdi, block->link_member_type_key, block->link_member_off, ctrl_ctx, block->eval, 512);
-        DF_EvalLinkBaseArray link_bases = df_eval_link_base_array_from_chunk_list(scratch.arena, &link_base_chunks);
+        B32 links_are_complete = 0;
+        DF_EvalLinkBaseArray link_bases = df_eval_link_base_array_from_eval_idx_range(scratch.arena, parse_ctx->type_graph, parse_ctx->rdi, block->link_member_type_key, block->link_member_off, ctrl_ctx, block->eval, visible_idx_range, 0, &links_are_complete);
+        if(!links_are_complete)
+        {
+          df_gfx_request_frame();
+        }
         String8 node_type_string = tg_string_from_key(arena, parse_ctx->type_graph, parse_ctx->rdi, block->eval.type_key);
-        for(U64 idx = visible_idx_range.min; idx < visible_idx_range.max; idx += 1)
+        for(U64 idx = visible_idx_range.min; idx < visible_idx_range.min+link_bases.count; idx += 1)
         {
           // rjf: get key for this row
           DF_ExpandKey key = df_expand_key_make(df_hash_from_expand_key(block->parent_key), idx+1);
           
           // rjf: get link base
-          DF_EvalLinkBase *link_base = &link_bases.v[idx];
+          DF_EvalLinkBase *link_base = &link_bases.v[idx-visible_idx_range.min];
           
           // rjf: get eval for this link
           DF_Eval link_eval = zero_struct;
@@ -11888,7 +11961,7 @@ df_code_slice(DF_Window *ws, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, DF_
                     }
                     if(!mapped_special && token->kind == TXT_TokenKind_Identifier)
                     {
-                      U64 local_num = eval_num_from_string(parse_ctx->locals_map, token_string);
+                      U64 local_num = eval_local_num_from_ctx_name(parse_ctx, token_string);
                       if(local_num != 0)
                       {
                         mapped_special = 1;
@@ -12695,7 +12768,12 @@ df_code_label(F32 alpha, B32 indirection_size_change, Vec4F32 base_color, String
 {
   Temp scratch = scratch_begin(0, 0);
   D_FancyStringList fancy_strings = df_fancy_string_list_from_code_string(scratch.arena, alpha, indirection_size_change, base_color, string);
-  UI_Box *box = ui_build_box_from_key(UI_BoxFlag_DrawText, ui_key_zero());
+  
+  // NOTE: labels under keyed parents (e.g. watch & line edit values) are keyed
+  // too, so their token strings' hashes are kept across builds
+  UI_Key parent_key = ui_top_parent()->key;
+  UI_Key key = ui_key_match(parent_key, ui_key_zero()) ? ui_key_zero() : ui_key_from_string(parent_key, str8_lit("code_label"));
+  UI_Box *box = ui_build_box_from_key(UI_BoxFlag_DrawText, key);
   ui_box_equip_display_fancy_strings(box, ui_top_tab_size(), &fancy_strings);
   scratch_end(scratch);
   return box;
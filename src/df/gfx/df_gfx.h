@@ -614,6 +614,11 @@ struct DF_Window
   
   // rjf: per-frame drawing state
   D_Bucket *draw_bucket;
+  
+  // rjf: per-frame timing stats (microseconds)
+  U64 last_ui_build_us;
+  U64 last_draw_build_us;
+  U64 last_submit_us;
 };
 
 ////////////////////////////////
@@ -814,6 +819,9 @@ global DF_Handle df_g_last_drag_drop_prev_tab = {0};
 //~ rjf: Basic Helpers
 
 internal DF_PathQuery df_path_query_from_string(String8 string);
+#if OS_FEATURE_SYNC_STATS
+internal OS_SyncStats df_sync_stats_from_stripes(void *stripes, U64 stripes_count, U64 stripe_size, U64 rw_mutex_off);
+#endif
 
 ////////////////////////////////
 //~ rjf: View Type Functions
@@ -153,6 +153,36 @@ df_qsort_compare_entity_lister__strength(DF_EntityListerItem *a, DF_EntityLister
   return result;
 }
 
+internal int
+df_qsort_compare_memory_annotation__vaddr(DF_MemoryAnnotation *a, DF_MemoryAnnotation *b)
+{
+  int result = 0;
+  if(a->vaddr_range.min < b->vaddr_range.min)
+  {
+    result = -1;
+  }
+  else if(a->vaddr_range.min > b->vaddr_range.min)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal int
+df_qsort_compare_memory_annotation__precedence(DF_MemoryAnnotation *a, DF_MemoryAnnotation *b)
+{
+  int result = 0;
+  if(a->precedence < b->precedence)
+  {
+    result = -1;
+  }
+  else if(a->precedence > b->precedence)
+  {
+    result = +1;
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Command Lister
 
@@ -2068,6 +2098,75 @@ df_watch_view_build(DF_Window *ws, DF_Panel *panel, DF_View *view, DF_WatchViewS
   ProfEnd();
 }
 
+////////////////////////////////
+//~ rjf: Memory Views
+
+internal DF_MemoryAnnotationIndex
+df_memory_annotation_index_from_list(Arena *arena, DF_MemoryAnnotationList *list)
+{
+  DF_MemoryAnnotationIndex index = {0};
+  index.count = list->count;
+  index.v = push_array_no_zero(arena, DF_MemoryAnnotation, index.count);
+  index.vaddr_max_prefix = push_array_no_zero(arena, U64, index.count);
+  {
+    U64 idx = 0;
+    for(DF_MemoryAnnotationNode *n = list->first; n != 0; n = n->next, idx += 1)
+    {
+      index.v[idx] = n->v;
+      index.v[idx].precedence = idx;
+    }
+  }
+  qsort(index.v, index.count, sizeof(DF_MemoryAnnotation), (int (*)(const void *, const void *))df_qsort_compare_memory_annotation__vaddr);
+  U64 vaddr_max = 0;
+  for(U64 idx = 0; idx < index.count; idx += 1)
+  {
+    vaddr_max = Max(vaddr_max, index.v[idx].vaddr_range.max);
+    index.vaddr_max_prefix[idx] = vaddr_max;
+  }
+  return index;
+}
+
+internal DF_MemoryAnnotationArray
+df_memory_annotation_array_from_index_range(Arena *arena, DF_MemoryAnnotationIndex *index, Rng1U64 vaddr_range)
+{
+  DF_MemoryAnnotationArray result = {0};
+  
+  //- rjf: find first annotation which could end after the range's start
+  U64 first = 0;
+  {
+    U64 opl = index->count;
+    for(;first < opl;)
+    {
+      U64 mid = (first + opl)/2;
+      if(index->vaddr_max_prefix[mid] <= vaddr_range.min)
+      {
+        first = mid+1;
+      }
+      else
+      {
+        opl = mid;
+      }
+    }
+  }
+  
+  //- rjf: scan annotations starting before the range's end, gather overlapping
+  U64 opl = first;
+  for(;opl < index->count && index->v[opl].vaddr_range.min < vaddr_range.max; opl += 1);
+  result.v = push_array_no_zero(arena, DF_MemoryAnnotation, opl-first);
+  for(U64 idx = first; idx < opl; idx += 1)
+  {
+    if(index->v[idx].vaddr_range.max > vaddr_range.min)
+    {
+      result.v[result.count] = index->v[idx];
+      result.count += 1;
+    }
+  }
+  
+  //- rjf: sort by precedence
+  qsort(result.v, result.count, sizeof(DF_MemoryAnnotation), (int (*)(const void *, const void *))df_qsort_compare_memory_annotation__precedence);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Null @view_hook_impl
 
@@ -8264,6 +8363,14 @@ DF_VIEW_SETUP_FUNCTION_DEF(Memory)
     mv->num_columns = 16;
     mv->bytes_per_cell = 1;
     mv->last_viewed_memory_cache_arena = df_view_push_arena_ext(view);
+    mv->annotation_cache_arena = df_view_push_arena_ext(view);
+    Temp scratch = scratch_begin(0, 0);
+    for(U64 idx = 0; idx < ArrayCount(mv->byte_string_hashes); idx += 1)
+    {
+      String8 byte_string = push_str8f(scratch.arena, "%02x", (U8)idx);
+      mv->byte_string_hashes[idx] = f_run_cache_hash_from_string(byte_string);
+    }
+    scratch_end(scratch);
   }
 }
 
@@ -8514,7 +8621,8 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
       {
         text_color.w *= 0.5f;
       }
-      D_FancyString fstr = {font, push_str8f(scratch.arena, "%02x", byte), text_color, font_size, 0, 0};
+      String8 byte_string = push_str8f(scratch.arena, "%02x", byte);
+      D_FancyString fstr = {font, byte_string, text_color, font_size, 0, 0, mv->byte_string_hashes[idx]};
       d_fancy_string_list_push(scratch.arena, &byte_fancy_strings[idx], &fstr);
     }
   }
@@ -8522,11 +8630,10 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
   //////////////////////////////
   //- rjf: grab windowed memory
   //
-  U64 visible_memory_size = dim_1u64(viz_range_bytes);
   U8 *visible_memory = 0;
   {
     Rng1U64 chunk_aligned_range_bytes = r1u64(AlignDownPow2(viz_range_bytes.min, KB(4)), AlignPow2(viz_range_bytes.max, KB(4)));
-    U64 current_memgen_idx = ctrl_mem_gen();
+    U64 current_memgen_idx = ctrl_mem_gen_from_machine_id(process->ctrl_machine_id);
     B32 range_changed = (chunk_aligned_range_bytes.min != mv->last_viewed_memory_cache_range.min ||
                          chunk_aligned_range_bytes.max != mv->last_viewed_memory_cache_range.max);
     B32 mem_changed = (current_memgen_idx != mv->last_viewed_memory_cache_memgen_idx);
@@ -8537,8 +8644,8 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
       // rjf: try to read new memory for this range
       U64 bytes_to_read = dim_1u64(chunk_aligned_range_bytes);
       U8 *buffer = push_array_no_zero(scratch.arena, U8, bytes_to_read);
-      U64 half1_bytes_read = dmn_process_read(process->ctrl_handle, r1u64(chunk_aligned_range_bytes.min, chunk_aligned_range_bytes.min+bytes_to_read/2), buffer+0);
-      U64 half2_bytes_read = dmn_process_read(process->ctrl_handle, r1u64(chunk_aligned_range_bytes.min+bytes_to_read/2, chunk_aligned_range_bytes.max), buffer+bytes_to_read/2);
+      U64 half1_bytes_read = ctrl_process_read(process->ctrl_machine_id, process->ctrl_handle, r1u64(chunk_aligned_range_bytes.min, chunk_aligned_range_bytes.min+bytes_to_read/2), buffer+0);
+      U64 half2_bytes_read = ctrl_process_read(process->ctrl_machine_id, process->ctrl_handle, r1u64(chunk_aligned_range_bytes.min+bytes_to_read/2, chunk_aligned_range_bytes.max), buffer+bytes_to_read/2);
       
       // rjf: worked? -> clear cache & store
       if(half1_bytes_read+half2_bytes_read >= bytes_to_read)
@@ -8583,127 +8690,149 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
   }
   
   //////////////////////////////
-  //- rjf: grab annotations for windowed range of memory
+  //- rjf: build annotation index, if the cached index is stale
+  //
+  // NOTE: annotations (unwind frames, the thread's stack, locals) only
+  // change when the selected thread, unwind frame, registers, or memory do,
+  // so their index is only rebuilt when one of those changes, rather than on
+  // every frame. it spans all annotations, not just the visible ones, so
+  // scrolling does not invalidate it either.
   //
-  typedef struct Annotation Annotation;
-  struct Annotation
-  {
-    Annotation *next;
-    String8 name_string;
-    String8 kind_string;
-    String8 type_string;
-    Vec4F32 color;
-    Rng1U64 vaddr_range;
-  };
-  typedef struct AnnotationList AnnotationList;
-  struct AnnotationList
-  {
-    Annotation *first;
-    Annotation *last;
-  };
-  AnnotationList *visible_memory_annotations = push_array(scratch.arena, AnnotationList, visible_memory_size);
   {
-    CTRL_Unwind unwind = df_query_cached_unwind_from_thread(thread);
-    
-    //- rjf: fill unwind frame annotations
-    if(unwind.frames.count != 0)
-    {
-      U64 last_stack_top = regs_rsp_from_arch_block(thread->arch, unwind.frames.v[0].regs);
-      for(U64 idx = 1; idx < unwind.frames.count; idx += 1)
-      {
-        CTRL_UnwindFrame *f = &unwind.frames.v[idx];
-        U64 f_stack_top = regs_rsp_from_arch_block(thread->arch, f->regs);
-        Rng1U64 frame_vaddr_range = r1u64(last_stack_top, f_stack_top);
-        Rng1U64 frame_vaddr_range_in_viz = intersect_1u64(frame_vaddr_range, viz_range_bytes);
-        last_stack_top = f_stack_top;
-        if(dim_1u64(frame_vaddr_range_in_viz) != 0)
-        {
-          U64 f_rip = regs_rip_from_arch_block(thread->arch, f->regs);
-          DF_Entity *module = df_module_from_process_vaddr(process, f_rip);
-          DI_Key dbgi_key = df_dbgi_key_from_module(module);
-          U64 rip_voff = df_voff_from_vaddr(module, f_rip);
-          String8 symbol_name = df_symbol_name_from_dbgi_key_voff(scratch.arena, &dbgi_key, rip_voff);
-          Annotation *annotation = push_array(scratch.arena, Annotation, 1);
-          annotation->name_string = symbol_name.size != 0 ? symbol_name : str8_lit("[external code]");
-          annotation->kind_string = str8_lit("Call Stack Frame");
-          annotation->color = symbol_name.size != 0 ? df_rgba_from_theme_color(DF_ThemeColor_CodeFunction) : df_rgba_from_theme_color(DF_ThemeColor_WeakText);
-          annotation->vaddr_range = frame_vaddr_range;
-          for(U64 vaddr = frame_vaddr_range_in_viz.min; vaddr < frame_vaddr_range_in_viz.max; vaddr += 1)
-          {
-            U64 visible_byte_idx = vaddr - viz_range_bytes.min;
-            SLLQueuePush(visible_memory_annotations[visible_byte_idx].first, visible_memory_annotations[visible_byte_idx].last, annotation);
+    DF_Handle thread_handle = df_handle_from_entity(thread);
+    U64 reg_gen = ctrl_reg_gen_from_machine_id(thread->ctrl_machine_id);
+    U64 mem_gen = ctrl_mem_gen_from_machine_id(thread->ctrl_machine_id);
+    if(!df_handle_match(mv->annotation_cache_thread, thread_handle) ||
+       mv->annotation_cache_unwind_count != ctrl_ctx.unwind_count ||
+       mv->annotation_cache_reg_gen != reg_gen ||
+       mv->annotation_cache_mem_gen != mem_gen)
+    {
+      arena_clear(mv->annotation_cache_arena);
+      Arena *arena = mv->annotation_cache_arena;
+      DF_MemoryAnnotationList annotations = {0};
+      B32 annotations_complete = 1;
+      CTRL_Unwind unwind = df_query_cached_unwind_from_thread(thread);
+      DI_Scope *scope = di_scope_open();
+      
+      //- rjf: fill unwind frame annotations
+      if(unwind.frames.count != 0)
+      {
+        U64 last_stack_top = regs_rsp_from_arch_block(thread->arch, unwind.frames.v[0].regs);
+        for(U64 idx = 1; idx < unwind.frames.count; idx += 1)
+        {
+          CTRL_UnwindFrame *f = &unwind.frames.v[idx];
+          U64 f_stack_top = regs_rsp_from_arch_block(thread->arch, f->regs);
+          Rng1U64 frame_vaddr_range = r1u64(last_stack_top, f_stack_top);
+          last_stack_top = f_stack_top;
+          if(dim_1u64(frame_vaddr_range) != 0)
+          {
+            U64 f_rip = regs_rip_from_arch_block(thread->arch, f->regs);
+            DF_Entity *module = df_module_from_process_vaddr(process, f_rip);
+            DI_Key dbgi_key = df_dbgi_key_from_module(module);
+            U64 rip_voff = df_voff_from_vaddr(module, f_rip);
+            if(dbgi_key.path.size != 0 && di_rdi_from_key(scope, &dbgi_key, 0) == &di_rdi_parsed_nil)
+            {
+              annotations_complete = 0;
+            }
+            String8 symbol_name = df_symbol_name_from_dbgi_key_voff(arena, &dbgi_key, rip_voff);
+            DF_MemoryAnnotationNode *n = push_array(arena, DF_MemoryAnnotationNode, 1);
+            DF_MemoryAnnotation *annotation = &n->v;
+            annotation->name_string = symbol_name.size != 0 ? symbol_name : str8_lit("[external code]");
+            annotation->kind_string = str8_lit("Call Stack Frame");
+            annotation->color = symbol_name.size != 0 ? df_rgba_from_theme_color(DF_ThemeColor_CodeFunction) : df_rgba_from_theme_color(DF_ThemeColor_WeakText);
+            annotation->vaddr_range = frame_vaddr_range;
+            SLLQueuePush(annotations.first, annotations.last, n);
+            annotations.count += 1;
           }
         }
       }
-    }
-    
-    //- rjf: fill selected thread stack range annotation
-    if(unwind.frames.count > 0)
-    {
-      U64 stack_base_vaddr = thread->stack_base;
-      U64 stack_top_vaddr = regs_rsp_from_arch_block(thread->arch, unwind.frames.v[0].regs);
-      Rng1U64 stack_vaddr_range = r1u64(stack_base_vaddr, stack_top_vaddr);
-      Rng1U64 stack_vaddr_range_in_viz = intersect_1u64(stack_vaddr_range, viz_range_bytes);
-      if(dim_1u64(stack_vaddr_range_in_viz) != 0)
+      
+      //- rjf: fill selected thread stack range annotation
+      if(unwind.frames.count > 0)
       {
-        Annotation *annotation = push_array(scratch.arena, Annotation, 1);
-        annotation->name_string = df_display_string_from_entity(scratch.arena, thread);
-        annotation->kind_string = str8_lit("Stack");
-        annotation->color = thread->flags & DF_EntityFlag_HasColor ? df_rgba_from_entity(thread) : df_rgba_from_theme_color(DF_ThemeColor_PlainText);
-        annotation->vaddr_range = stack_vaddr_range;
-        for(U64 vaddr = stack_vaddr_range_in_viz.min; vaddr < stack_vaddr_range_in_viz.max; vaddr += 1)
+        U64 stack_base_vaddr = thread->stack_base;
+        U64 stack_top_vaddr = regs_rsp_from_arch_block(thread->arch, unwind.frames.v[0].regs);
+        Rng1U64 stack_vaddr_range = r1u64(stack_base_vaddr, stack_top_vaddr);
+        if(dim_1u64(stack_vaddr_range) != 0)
         {
-          U64 visible_byte_idx = vaddr - viz_range_bytes.min;
-          SLLQueuePush(visible_memory_annotations[visible_byte_idx].first, visible_memory_annotations[visible_byte_idx].last, annotation);
+          DF_MemoryAnnotationNode *n = push_array(arena, DF_MemoryAnnotationNode, 1);
+          DF_MemoryAnnotation *annotation = &n->v;
+          annotation->name_string = df_display_string_from_entity(arena, thread);
+          annotation->kind_string = str8_lit("Stack");
+          annotation->color = thread->flags & DF_EntityFlag_HasColor ? df_rgba_from_entity(thread) : df_rgba_from_theme_color(DF_ThemeColor_PlainText);
+          annotation->vaddr_range = stack_vaddr_range;
+          SLLQueuePush(annotations.first, annotations.last, n);
+          annotations.count += 1;
         }
       }
-    }
-    
-    //- rjf: fill local variable annotations
-    {
-      Vec4F32 color_gen_table[] =
-      {
-        df_rgba_from_theme_color(DF_ThemeColor_Thread0),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread1),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread2),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread3),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread4),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread5),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread6),
-        df_rgba_from_theme_color(DF_ThemeColor_Thread7),
-      };
-      DI_Scope *scope = di_scope_open();
-      U64 thread_rip_vaddr = df_query_cached_rip_from_thread_unwind(thread, ctrl_ctx.unwind_count);
-      EVAL_ParseCtx parse_ctx = df_eval_parse_ctx_from_process_vaddr(scope, process, thread_rip_vaddr);
-      RDI_Parsed *rdi = parse_ctx.rdi;
-      for(EVAL_String2NumMapNode *n = parse_ctx.locals_map->first; n != 0; n = n->order_next)
-      {
-        String8 local_name = n->string;
-        DF_Eval local_eval = df_eval_from_string(scratch.arena, scope, &ctrl_ctx, &parse_ctx, &eval_string2expr_map_nil, local_name);
-        if(local_eval.mode == EVAL_EvalMode_Addr)
-        {
-          TG_Kind local_eval_type_kind = tg_kind_from_key(local_eval.type_key);
-          U64 local_eval_type_size = tg_byte_size_from_graph_rdi_key(parse_ctx.type_graph, rdi, local_eval.type_key);
-          Rng1U64 vaddr_rng = r1u64(local_eval.offset, local_eval.offset+local_eval_type_size);
-          Rng1U64 vaddr_rng_in_visible = intersect_1u64(viz_range_bytes, vaddr_rng);
-          if(vaddr_rng_in_visible.max != vaddr_rng_in_visible.min)
-          {
-            Annotation *annotation = push_array(scratch.arena, Annotation, 1);
-            {
-              annotation->name_string = push_str8_copy(scratch.arena, local_name);
-              annotation->kind_string = str8_lit("Local");
-              annotation->type_string = tg_string_from_key(scratch.arena, parse_ctx.type_graph, parse_ctx.rdi, local_eval.type_key);
-              annotation->color = color_gen_table[(vaddr_rng.min/8)%ArrayCount(color_gen_table)];
-              annotation->vaddr_range = vaddr_rng;
-            }
-            for(U64 vaddr = vaddr_rng_in_visible.min; vaddr < vaddr_rng_in_visible.max; vaddr += 1)
+      
+      //- rjf: fill local variable annotations
+      {
+        Vec4F32 color_gen_table[] =
+        {
+          df_rgba_from_theme_color(DF_ThemeColor_Thread0),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread1),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread2),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread3),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread4),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread5),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread6),
+          df_rgba_from_theme_color(DF_ThemeColor_Thread7),
+        };
+        U64 thread_rip_vaddr = df_query_cached_rip_from_thread_unwind(thread, ctrl_ctx.unwind_count);
+        EVAL_ParseCtx parse_ctx = df_eval_parse_ctx_from_process_vaddr(scope, process, thread_rip_vaddr);
+        RDI_Parsed *rdi = parse_ctx.rdi;
+        DI_Key thread_dbgi_key = df_dbgi_key_from_module(df_module_from_process_vaddr(process, thread_rip_vaddr));
+        if(rdi == &di_rdi_parsed_nil && thread_dbgi_key.path.size != 0)
+        {
+          annotations_complete = 0;
+        }
+        for(EVAL_String2NumMapNode *n = parse_ctx.locals_map->first; n != 0; n = n->order_next)
+        {
+          String8 local_name = n->string;
+          DF_Eval local_eval = df_eval_from_string(scratch.arena, scope, &ctrl_ctx, &parse_ctx, &eval_string2expr_map_nil, local_name);
+          if(local_eval.mode == EVAL_EvalMode_Addr)
+          {
+            U64 local_eval_type_size = tg_byte_size_from_graph_rdi_key(parse_ctx.type_graph, rdi, local_eval.type_key);
+            Rng1U64 vaddr_rng = r1u64(local_eval.offset, local_eval.offset+local_eval_type_size);
+            if(vaddr_rng.max != vaddr_rng.min)
             {
-              SLLQueuePushFront(visible_memory_annotations[vaddr-viz_range_bytes.min].first, visible_memory_annotations[vaddr-viz_range_bytes.min].last, annotation);
+              DF_MemoryAnnotationNode *annotation_n = push_array(arena, DF_MemoryAnnotationNode, 1);
+              DF_MemoryAnnotation *annotation = &annotation_n->v;
+              {
+                annotation->name_string = push_str8_copy(arena, local_name);
+                annotation->kind_string = str8_lit("Local");
+                annotation->type_string = tg_string_from_key(arena, parse_ctx.type_graph, parse_ctx.rdi, local_eval.type_key);
+                annotation->color = color_gen_table[(vaddr_rng.min/8)%ArrayCount(color_gen_table)];
+                annotation->vaddr_range = vaddr_rng;
+              }
+              
+              // NOTE: locals take precedence over frames & stacks, with
+              // later locals taking precedence over earlier ones
+              SLLQueuePushFront(annotations.first, annotations.last, annotation_n);
+              annotations.count += 1;
             }
           }
         }
       }
+      
+      //- rjf: list -> index
+      mv->annotation_cache_index = df_memory_annotation_index_from_list(arena, &annotations);
       di_scope_close(scope);
+      
+      //- rjf: update cache stamps; if debug info was not yet loaded for some
+      // annotation, leave the stamps stale, so that it is rebuilt once loaded
+      if(annotations_complete && !df_ctrl_targets_running())
+      {
+        mv->annotation_cache_thread = thread_handle;
+        mv->annotation_cache_unwind_count = ctrl_ctx.unwind_count;
+        mv->annotation_cache_reg_gen = reg_gen;
+        mv->annotation_cache_mem_gen = mem_gen;
+      }
+      else
+      {
+        MemoryZeroStruct(&mv->annotation_cache_thread);
+      }
     }
   }
   
@@ -8897,6 +9026,8 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
       for(S64 row_idx = viz_range_rows.min; row_idx <= viz_range_rows.max; row_idx += 1)
     {
       Rng1U64 row_range_bytes = r1u64(row_idx*mv->num_columns, (row_idx+1)*mv->num_columns);
+      DF_MemoryAnnotationArray row_annotations = df_memory_annotation_array_from_index_range(scratch.arena, &mv->annotation_cache_index, row_range_bytes);
+      DF_MemoryAnnotation **cell_annotations = push_array_no_zero(scratch.arena, DF_MemoryAnnotation *, row_annotations.count);
       B32 row_is_boundary = 0;
       Vec4F32 row_boundary_color = {0};
       if(row_range_bytes.min%64 == 0)
@@ -8927,7 +9058,16 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
             U64 global_byte_idx = viz_range_bytes.min+visible_byte_idx;
             U64 global_byte_num = global_byte_idx+1;
             U8 byte_value = visible_memory[visible_byte_idx];
-            Annotation *annotation = visible_memory_annotations[visible_byte_idx].first;
+            U64 cell_annotations_count = 0;
+            for(U64 idx = 0; idx < row_annotations.count; idx += 1)
+            {
+              if(contains_1u64(row_annotations.v[idx].vaddr_range, global_byte_idx))
+              {
+                cell_annotations[cell_annotations_count] = &row_annotations.v[idx];
+                cell_annotations_count += 1;
+              }
+            }
+            DF_MemoryAnnotation *annotation = cell_annotations_count != 0 ? cell_annotations[0] : 0;
             UI_BoxFlags cell_flags = 0;
             Vec4F32 cell_border_rgba = {0};
             Vec4F32 cell_bg_rgba = {0};
@@ -8966,8 +9106,9 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
             ui_box_equip_display_fancy_strings(cell_box, 0, &byte_fancy_strings[byte_value]);
             {
               F32 off = 0;
-              for(Annotation *a = annotation; a != 0; a = a->next)
+              for(U64 idx = 0; idx < cell_annotations_count; idx += 1)
               {
+                DF_MemoryAnnotation *a = cell_annotations[idx];
                 if(global_byte_idx == a->vaddr_range.min) UI_Parent(row_overlay_box)
                 {
                   ui_set_next_background_color(annotation->color);
@@ -8986,8 +9127,9 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
             }
             if(annotation != 0 && mouse_hover_byte_num == global_byte_num) UI_Tooltip UI_FontSize(ui_top_font_size()) UI_PrefHeight(ui_px(ui_top_font_size()*1.75f, 1.f))
             {
-              for(Annotation *a = annotation; a != 0; a = a->next)
+              for(U64 idx = 0; idx < cell_annotations_count; idx += 1)
               {
+                DF_MemoryAnnotation *a = cell_annotations[idx];
                 UI_PrefWidth(ui_children_sum(1)) UI_Row UI_PrefWidth(ui_text_dim(10, 1))
                 {
                   UI_TextColor(a->color) UI_Font(font) ui_label(a->name_string);
@@ -8998,7 +9140,7 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
                   df_code_label(1.f, 1, df_rgba_from_theme_color(DF_ThemeColor_CodeType), a->type_string);
                 }
                 UI_TextColor(df_rgba_from_theme_color(DF_ThemeColor_WeakText)) ui_label(str8_from_memory_size(scratch.arena, dim_1u64(a->vaddr_range)));
-                if(a->next != 0)
+                if(idx+1 < cell_annotations_count)
                 {
                   ui_spacer(ui_em(1.5f, 1.f));
                 }
@@ -410,6 +410,51 @@ struct DF_DisasmViewState
 ////////////////////////////////
 //~ rjf: Memory @view_types
 
+typedef struct DF_MemoryAnnotation DF_MemoryAnnotation;
+struct DF_MemoryAnnotation
+{
+  String8 name_string;
+  String8 kind_string;
+  String8 type_string;
+  Vec4F32 color;
+  Rng1U64 vaddr_range;
+  U64 precedence;
+};
+
+typedef struct DF_MemoryAnnotationNode DF_MemoryAnnotationNode;
+struct DF_MemoryAnnotationNode
+{
+  DF_MemoryAnnotationNode *next;
+  DF_MemoryAnnotation v;
+};
+
+typedef struct DF_MemoryAnnotationList DF_MemoryAnnotationList;
+struct DF_MemoryAnnotationList
+{
+  DF_MemoryAnnotationNode *first;
+  DF_MemoryAnnotationNode *last;
+  U64 count;
+};
+
+typedef struct DF_MemoryAnnotationArray DF_MemoryAnnotationArray;
+struct DF_MemoryAnnotationArray
+{
+  DF_MemoryAnnotation *v;
+  U64 count;
+};
+
+// NOTE: annotations sorted by the start of their ranges, alongside the
+// running maximum of their range ends. because the running maximum never
+// decreases, the first annotation which could overlap some range can be
+// binary-searched, and only annotations starting before its end are scanned.
+typedef struct DF_MemoryAnnotationIndex DF_MemoryAnnotationIndex;
+struct DF_MemoryAnnotationIndex
+{
+  DF_MemoryAnnotation *v;
+  U64 *vaddr_max_prefix;
+  U64 count;
+};
+
 typedef struct DF_MemoryViewState DF_MemoryViewState;
 struct DF_MemoryViewState
 {
@@ -421,6 +466,17 @@ struct DF_MemoryViewState
   Rng1U64 last_viewed_memory_cache_range;
   U64 last_viewed_memory_cache_memgen_idx;
   
+  // rjf: annotation index cache
+  Arena *annotation_cache_arena;
+  DF_Handle annotation_cache_thread;
+  U64 annotation_cache_unwind_count;
+  U64 annotation_cache_reg_gen;
+  U64 annotation_cache_mem_gen;
+  DF_MemoryAnnotationIndex annotation_cache_index;
+  
+  // rjf: byte string run hashes (constant - computed at initialization)
+  U64 byte_string_hashes[256];
+  
   // rjf: control state
   U64 cursor;
   U64 mark;
@@ -445,6 +501,8 @@ internal int df_qsort_compare_file_info__size(DF_FileInfo *a, DF_FileInfo *b);
 internal int df_qsort_compare_process_info(DF_ProcessInfo *a, DF_ProcessInfo *b);
 internal int df_qsort_compare_cmd_lister__strength(DF_CmdListerItem *a, DF_CmdListerItem *b);
 internal int df_qsort_compare_entity_lister__strength(DF_EntityListerItem *a, DF_EntityListerItem *b);
+internal int df_qsort_compare_memory_annotation__vaddr(DF_MemoryAnnotation *a, DF_MemoryAnnotation *b);
+internal int df_qsort_compare_memory_annotation__precedence(DF_MemoryAnnotation *a, DF_MemoryAnnotation *b);
 
 ////////////////////////////////
 //~ rjf: Command Lister
@@ -502,4 +560,10 @@ internal void df_watch_view_init(DF_WatchViewState *ewv, DF_View *view, DF_Watch
 internal void df_watch_view_cmds(DF_Window *ws, DF_Panel *panel, DF_View *view, DF_WatchViewState *ewv, DF_CmdList *cmds);
 internal void df_watch_view_build(DF_Window *ws, DF_Panel *panel, DF_View *view, DF_WatchViewState *ewv, B32 modifiable, U32 default_radix, Rng2F32 rect);
 
+////////////////////////////////
+//~ rjf: Memory Views
+
+internal DF_MemoryAnnotationIndex df_memory_annotation_index_from_list(Arena *arena, DF_MemoryAnnotationList *list);
+internal DF_MemoryAnnotationArray df_memory_annotation_array_from_index_range(Arena *arena, DF_MemoryAnnotationIndex *index, Rng1U64 vaddr_range);
+
 #endif // DEBUG_FRONTEND_VIEWS_H
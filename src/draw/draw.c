@@ -95,7 +95,8 @@ d_fancy_run_list_from_fancy_string_list(Arena *arena, F32 tab_size_px, D_FancySt
   for(D_FancyStringNode *n = strs->first; n != 0; n = n->next)
   {
     D_FancyRunNode *dst_n = push_array(arena, D_FancyRunNode, 1);
-    dst_n->v.run = f_push_run_from_string(arena, n->v.font, n->v.size, base_align_px, tab_size_px, 0, n->v.string);
+    U64 string_hash = n->v.string_hash ? n->v.string_hash : f_run_cache_hash_from_string(n->v.string);
+    dst_n->v.run = f_push_cached_run_from_string_hash(arena, n->v.font, n->v.size, base_align_px, tab_size_px, 0, string_hash, n->v.string);
     dst_n->v.color = n->v.color;
     dst_n->v.underline_thickness = n->v.underline_thickness;
     dst_n->v.strikethrough_thickness = n->v.strikethrough_thickness;
@@ -725,7 +726,7 @@ internal void
 d_text(F_Tag font, F32 size, F32 base_align_px, F32 tab_size_px, Vec2F32 p, Vec4F32 color, String8 string)
 {
   Temp scratch = scratch_begin(0, 0);
-  F_Run run = f_push_run_from_string(scratch.arena, font, size, base_align_px, tab_size_px, 0, string);
+  F_Run run = f_push_cached_run_from_string(scratch.arena, font, size, base_align_px, tab_size_px, 0, string);
   d_text_run(p, color, run);
   scratch_end(scratch);
 }
@@ -746,8 +747,8 @@ internal void
 d_truncated_text(F_Tag font, F32 size, F32 base_align_px, F32 tab_size_px, Vec2F32 p, Vec4F32 color, F32 max_x, String8 string)
 {
   Temp scratch = scratch_begin(0, 0);
-  F_Run run = f_push_run_from_string(scratch.arena, font, size, base_align_px, tab_size_px, 0, string);
-  F_Run ellipses_run = f_push_run_from_string(scratch.arena, font, size, base_align_px, tab_size_px, 0, str8_lit("..."));
+  F_Run run = f_push_cached_run_from_string(scratch.arena, font, size, base_align_px, tab_size_px, 0, string);
+  F_Run ellipses_run = f_push_cached_run_from_string(scratch.arena, font, size, base_align_px, tab_size_px, 0, str8_lit("..."));
   d_truncated_text_run(p, color, max_x, run, ellipses_run);
   scratch_end(scratch);
 }
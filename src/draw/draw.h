@@ -16,6 +16,7 @@ struct D_FancyString
   F32 size;
   F32 underline_thickness;
   F32 strikethrough_thickness;
+  U64 string_hash; // NOTE: optional f_run_cache_hash_from_string(string), for callers which already have it - 0 -> computed
 };
 
 typedef struct D_FancyStringNode D_FancyStringNode;
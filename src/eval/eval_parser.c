@@ -176,6 +176,108 @@ eval_push_member_map_from_rdi_voff(Arena *arena, RDI_Parsed *rdi, U64 voff)
   return map;
 }
 
+////////////////////////////////
+//~ rjf: Debug-Info-Driven Direct Lookups
+
+internal U64
+eval_local_num_from_rdi_voff_name(RDI_Parsed *rdi, U64 voff, String8 name)
+{
+  U64 result = 0;
+  
+  //- rjf: voff -> tightest scope; voff-1 -> scope
+  U32 tightest_scope_idx = (U32)rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_ScopeVMap, voff);
+  U32 prev_scope_idx = tightest_scope_idx;
+  if(voff > 0)
+  {
+    prev_scope_idx = (U32)rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_ScopeVMap, voff-1);
+  }
+  
+  //- rjf: probe scopes in the same order as the locals map - tightest scope,
+  // scope at voff-1, then the tightest scope's parents
+  U32 local_idx = 0;
+  if(tightest_scope_idx != 0)
+  {
+    local_idx = rdi_local_idx_from_scope_name(rdi, tightest_scope_idx, name.str, name.size);
+  }
+  if(local_idx == 0 && prev_scope_idx != tightest_scope_idx && prev_scope_idx != 0)
+  {
+    local_idx = rdi_local_idx_from_scope_name(rdi, prev_scope_idx, name.str, name.size);
+  }
+  if(local_idx == 0 && tightest_scope_idx != 0)
+  {
+    RDI_Scope *tightest_scope = rdi_element_from_name_idx(rdi, Scopes, tightest_scope_idx);
+    for(U32 scope_idx = tightest_scope->parent_scope_idx, depth = 0;
+        scope_idx != 0 && local_idx == 0 && depth < 1024;
+        depth += 1)
+    {
+      RDI_Scope *scope = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
+      local_idx = rdi_local_idx_from_scope_name(rdi, scope_idx, name.str, name.size);
+      scope_idx = scope->parent_scope_idx;
+    }
+  }
+  
+  //- rjf: local idx -> num (matches locals map encoding)
+  if(local_idx != 0)
+  {
+    result = (U64)local_idx+1;
+  }
+  return result;
+}
+
+internal U64
+eval_member_num_from_rdi_voff_name(RDI_Parsed *rdi, U64 voff, String8 name)
+{
+  U64 result = 0;
+  
+  //- rjf: voff -> tightest scope -> procedure -> udt
+  RDI_Scope *tightest_scope = rdi_scope_from_voff(rdi, voff);
+  RDI_Procedure *procedure = rdi_element_from_name_idx(rdi, Procedures, tightest_scope->proc_idx);
+  U32 udt_idx = procedure->container_idx;
+  RDI_UDT *udt = rdi_element_from_name_idx(rdi, UDTs, udt_idx);
+  
+  //- rjf: udt -> data member
+  if(udt_idx != 0 && !(udt->flags & RDI_UDTFlag_EnumMembers))
+  {
+    U32 member_idx = rdi_member_idx_from_udt_name(rdi, udt_idx, name.str, name.size);
+    RDI_Member *m = rdi_element_from_name_idx(rdi, Members, member_idx);
+    if(member_idx != 0 && m->kind == RDI_MemberKind_DataField)
+    {
+      result = (U64)member_idx;
+    }
+  }
+  return result;
+}
+
+internal U64
+eval_local_num_from_ctx_name(EVAL_ParseCtx *ctx, String8 name)
+{
+  U64 result = 0;
+  if(ctx->locals_map != 0)
+  {
+    result = eval_num_from_string(ctx->locals_map, name);
+  }
+  else
+  {
+    result = eval_local_num_from_rdi_voff_name(ctx->rdi, ctx->ip_voff, name);
+  }
+  return result;
+}
+
+internal U64
+eval_member_num_from_ctx_name(EVAL_ParseCtx *ctx, String8 name)
+{
+  U64 result = 0;
+  if(ctx->member_map != 0)
+  {
+    result = eval_num_from_string(ctx->member_map, name);
+  }
+  else
+  {
+    result = eval_member_num_from_rdi_voff_name(ctx->rdi, ctx->ip_voff, name);
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Tokenization Functions
 
@@ -455,10 +557,8 @@ eval_leaf_type_from_name(RDI_Parsed *rdi, String8 name)
   TG_Key key = zero_struct;
   B32 found = 0;
   {
-    RDI_NameMap *name_map = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_Types);
-    RDI_ParsedNameMap parsed_name_map = {0};
-    rdi_parsed_from_name_map(rdi, name_map, &parsed_name_map);
-    RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &parsed_name_map, name.str, name.size);
+    RDI_ParsedNameMap *parsed_name_map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_Types);
+    RDI_NameMapNode *node = rdi_name_map_lookup(rdi, parsed_name_map, name.str, name.size);
     if(node != 0)
     {
       U32 match_count = 0;
@@ -843,7 +943,7 @@ eval_parse_expr_from_text_tokens__prec(Arena *arena, EVAL_ParseCtx *ctx, String8
           //- rjf: try members
           if(mapped_identifier == 0)
           {
-            U64 data_member_num = eval_num_from_string(ctx->member_map, token_string);
+            U64 data_member_num = eval_member_num_from_ctx_name(ctx, token_string);
             if(data_member_num != 0)
             {
               atom_implicit_member_name = token_string;
@@ -854,7 +954,7 @@ eval_parse_expr_from_text_tokens__prec(Arena *arena, EVAL_ParseCtx *ctx, String8
           //- rjf: try locals
           if(mapped_identifier == 0)
           {
-            U64 local_num = eval_num_from_string(ctx->locals_map, local_lookup_string);
+            U64 local_num = eval_local_num_from_ctx_name(ctx, local_lookup_string);
             if(local_num != 0)
             {
               mapped_identifier = 1;
@@ -937,17 +1037,15 @@ eval_parse_expr_from_text_tokens__prec(Arena *arena, EVAL_ParseCtx *ctx, String8
           //- rjf: try global variables
           if(mapped_identifier == 0)
           {
-            RDI_NameMap *name_map = rdi_element_from_name_idx(ctx->rdi, NameMaps, RDI_NameMapKind_GlobalVariables);
-            RDI_ParsedNameMap parsed_name_map = {0};
-            rdi_parsed_from_name_map(ctx->rdi, name_map, &parsed_name_map);
-            RDI_NameMapNode *node = rdi_name_map_lookup(ctx->rdi, &parsed_name_map, token_string.str, token_string.size);
+            RDI_ParsedNameMap *parsed_name_map = rdi_parsed_name_map_from_kind(ctx->rdi, RDI_NameMapKind_GlobalVariables);
+            RDI_NameMapNode *node = rdi_name_map_lookup(ctx->rdi, parsed_name_map, token_string.str, token_string.size);
             U32 matches_count = 0;
             U32 *matches = rdi_matches_from_map_node(ctx->rdi, node, &matches_count);
             for(String8Node *n = namespaceified_token_strings.first;
                 n != 0 && matches_count == 0;
                 n = n->next)
             {
-              node = rdi_name_map_lookup(ctx->rdi, &parsed_name_map, n->string.str, n->string.size);
+              node = rdi_name_map_lookup(ctx->rdi, parsed_name_map, n->string.str, n->string.size);
               matches_count = 0;
               matches = rdi_matches_from_map_node(ctx->rdi, node, &matches_count);
             }
@@ -973,17 +1071,15 @@ eval_parse_expr_from_text_tokens__prec(Arena *arena, EVAL_ParseCtx *ctx, String8
           //- rjf: try thread variables
           if(mapped_identifier == 0)
           {
-            RDI_NameMap *name_map = rdi_element_from_name_idx(ctx->rdi, NameMaps, RDI_NameMapKind_ThreadVariables);
-            RDI_ParsedNameMap parsed_name_map = {0};
-            rdi_parsed_from_name_map(ctx->rdi, name_map, &parsed_name_map);
-            RDI_NameMapNode *node = rdi_name_map_lookup(ctx->rdi, &parsed_name_map, token_string.str, token_string.size);
+            RDI_ParsedNameMap *parsed_name_map = rdi_parsed_name_map_from_kind(ctx->rdi, RDI_NameMapKind_ThreadVariables);
+            RDI_NameMapNode *node = rdi_name_map_lookup(ctx->rdi, parsed_name_map, token_string.str, token_string.size);
             U32 matches_count = 0;
             U32 *matches = rdi_matches_from_map_node(ctx->rdi, node, &matches_count);
             for(String8Node *n = namespaceified_token_strings.first;
                 n != 0 && matches_count == 0;
                 n = n->next)
             {
-              node = rdi_name_map_lookup(ctx->rdi, &parsed_name_map, n->string.str, n->string.size);
+              node = rdi_name_map_lookup(ctx->rdi, parsed_name_map, n->string.str, n->string.size);
               matches_count = 0;
               matches = rdi_matches_from_map_node(ctx->rdi, node, &matches_count);
             }
@@ -1005,17 +1101,15 @@ eval_parse_expr_from_text_tokens__prec(Arena *arena, EVAL_ParseCtx *ctx, String8
           //- rjf: try procedures
           if(mapped_identifier == 0)
           {
-            RDI_NameMap *name_map = rdi_element_from_name_idx(ctx->rdi, NameMaps, RDI_NameMapKind_Procedures);
-            RDI_ParsedNameMap parsed_name_map = {0};
-            rdi_parsed_from_name_map(ctx->rdi, name_map, &parsed_name_map);
-            RDI_NameMapNode *node = rdi_name_map_lookup(ctx->rdi, &parsed_name_map, token_string.str, token_string.size);
+            RDI_ParsedNameMap *parsed_name_map = rdi_parsed_name_map_from_kind(ctx->rdi, RDI_NameMapKind_Procedures);
+            RDI_NameMapNode *node = rdi_name_map_lookup(ctx->rdi, parsed_name_map, token_string.str, token_string.size);
             U32 matches_count = 0;
             U32 *matches = rdi_matches_from_map_node(ctx->rdi, node, &matches_count);
             for(String8Node *n = namespaceified_token_strings.first;
                 n != 0 && matches_count == 0;
                 n = n->next)
             {
-              node = rdi_name_map_lookup(ctx->rdi, &parsed_name_map, n->string.str, n->string.size);
+              node = rdi_name_map_lookup(ctx->rdi, parsed_name_map, n->string.str, n->string.size);
               matches_count = 0;
               matches = rdi_matches_from_map_node(ctx->rdi, node, &matches_count);
             }
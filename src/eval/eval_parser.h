@@ -71,6 +71,9 @@ struct EVAL_ParseCtx
   TG_Graph *type_graph;
   EVAL_String2NumMap *regs_map;
   EVAL_String2NumMap *reg_alias_map;
+  // NOTE: locals_map & member_map may be 0, in which case names are
+  // looked up by probing the RDI's per-scope & per-UDT name maps directly,
+  // without building a map per parse context.
   EVAL_String2NumMap *locals_map;
   EVAL_String2NumMap *member_map;
 };
@@ -88,6 +91,14 @@ global read_only EVAL_ParseResult eval_parse_result_nil = {0, &eval_expr_nil};
 internal EVAL_String2NumMap *eval_push_locals_map_from_rdi_voff(Arena *arena, RDI_Parsed *rdi, U64 voff);
 internal EVAL_String2NumMap *eval_push_member_map_from_rdi_voff(Arena *arena, RDI_Parsed *rdi, U64 voff);
 
+////////////////////////////////
+//~ rjf: Debug-Info-Driven Direct Lookups
+
+internal U64 eval_local_num_from_rdi_voff_name(RDI_Parsed *rdi, U64 voff, String8 name);
+internal U64 eval_member_num_from_rdi_voff_name(RDI_Parsed *rdi, U64 voff, String8 name);
+internal U64 eval_local_num_from_ctx_name(EVAL_ParseCtx *ctx, String8 name);
+internal U64 eval_member_num_from_ctx_name(EVAL_ParseCtx *ctx, String8 name);
+
 ////////////////////////////////
 //~ rjf: Tokenization Functions
 
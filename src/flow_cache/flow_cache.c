@@ -0,0 +1,403 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Parameter Type Functions
+
+internal B32
+flow_params_match(FLOW_Params *a, FLOW_Params *b)
+{
+  B32 result = (a->vaddr_range.min == b->vaddr_range.min &&
+                a->vaddr_range.max == b->vaddr_range.max &&
+                a->arch == b->arch);
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Value Bundle Functions
+
+internal FLOW_Info
+flow_info_from_arch_vaddr_data(Arena *arena, Architecture arch, U64 vaddr, String8 data)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  FLOW_Info info = {0};
+  info.vaddr_range = r1u64(vaddr, vaddr+data.size);
+  switch(arch)
+  {
+    default:{}break;
+    case Architecture_x64:
+    {
+      //- rjf: decode all instructions
+      FLOW_Inst *insts = push_array_no_zero(scratch.arena, FLOW_Inst, data.size);
+      U64 insts_count = 0;
+      for(U64 off = 0; off < data.size;)
+      {
+        X64_Inst x64_inst = x64_inst_from_machine_code(0, str8_skip(data, off));
+        if(x64_inst.size == 0)
+        {
+          break;
+        }
+        FLOW_Inst *inst = &insts[insts_count];
+        insts_count += 1;
+        inst->off             = (U32)off;
+        inst->size            = (U32)x64_inst.size;
+        inst->flags           = x64_inst.flags;
+        inst->sp_delta        = (S32)x64_inst.sp_delta;
+        inst->jump_dest_vaddr = 0;
+        if(x64_inst.rel_voff != 0)
+        {
+          inst->jump_dest_vaddr = (U64)(vaddr + off + (S64)((S32)x64_inst.rel_voff));
+        }
+        off += x64_inst.size;
+      }
+      
+      //- rjf: fill instructions
+      info.insts.count = insts_count;
+      info.insts.v = push_array_no_zero(arena, FLOW_Inst, info.insts.count);
+      MemoryCopy(info.insts.v, insts, sizeof(FLOW_Inst)*info.insts.count);
+    }break;
+  }
+  scratch_end(scratch);
+  return info;
+}
+
+internal U64
+flow_inst_idx_from_vaddr(FLOW_Info *info, U64 vaddr)
+{
+  U64 result = info->insts.count;
+  if(contains_1u64(info->vaddr_range, vaddr) && info->insts.count != 0)
+  {
+    U64 off = vaddr - info->vaddr_range.min;
+    U64 first = 0;
+    U64 opl = info->insts.count;
+    for(;first+1 < opl;)
+    {
+      U64 mid = (first+opl)/2;
+      if(info->insts.v[mid].off <= off)
+      {
+        first = mid;
+      }
+      else
+      {
+        opl = mid;
+      }
+    }
+    FLOW_Inst *inst = &info->insts.v[first];
+    if(inst->off <= off && off < inst->off+inst->size)
+    {
+      result = first;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void
+flow_init(void)
+{
+  Arena *arena = arena_alloc();
+  flow_shared = push_array(arena, FLOW_Shared, 1);
+  flow_shared->arena = arena;
+  flow_shared->slots_count = 1024;
+  flow_shared->stripes_count = Min(flow_shared->slots_count, os_logical_core_count());
+  flow_shared->slots = push_array(arena, FLOW_Slot, flow_shared->slots_count);
+  flow_shared->stripes = push_array(arena, FLOW_Stripe, flow_shared->stripes_count);
+  for(U64 idx = 0; idx < flow_shared->stripes_count; idx += 1)
+  {
+    flow_shared->stripes[idx].arena = arena_alloc();
+    flow_shared->stripes[idx].rw_mutex = os_rw_mutex_alloc();
+    flow_shared->stripes[idx].cv = os_condition_variable_alloc();
+  }
+  flow_shared->evictor_thread = os_launch_thread(flow_evictor_thread__entry_point, 0, 0);
+}
+
+////////////////////////////////
+//~ rjf: User Clock
+
+internal void
+flow_user_clock_tick(void)
+{
+  ins_atomic_u64_inc_eval(&flow_shared->user_clock_idx);
+}
+
+internal U64
+flow_user_clock_idx(void)
+{
+  U64 idx = ins_atomic_u64_eval(&flow_shared->user_clock_idx);
+  return idx;
+}
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+internal FLOW_Scope *
+flow_scope_open(void)
+{
+  if(flow_tctx == 0)
+  {
+    Arena *arena = arena_alloc();
+    flow_tctx = push_array(arena, FLOW_TCTX, 1);
+    flow_tctx->arena = arena;
+  }
+  U64 base_pos = arena_pos(flow_tctx->arena);
+  FLOW_Scope *scope = push_array(flow_tctx->arena, FLOW_Scope, 1);
+  scope->base_pos = base_pos;
+  return scope;
+}
+
+internal void
+flow_scope_close(FLOW_Scope *scope)
+{
+  for(FLOW_Touch *t = scope->top_touch, *next = 0; t != 0; t = next)
+  {
+    next = t->next;
+    U64 slot_idx = t->hash.u64[1]%flow_shared->slots_count;
+    U64 stripe_idx = slot_idx%flow_shared->stripes_count;
+    FLOW_Slot *slot = &flow_shared->slots[slot_idx];
+    FLOW_Stripe *stripe = &flow_shared->stripes[stripe_idx];
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(FLOW_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(t->hash, n->hash) && flow_params_match(&t->params, &n->params))
+        {
+          ins_atomic_u64_dec_eval(&n->scope_ref_count);
+          break;
+        }
+      }
+    }
+  }
+  arena_pop_to(flow_tctx->arena, scope->base_pos);
+}
+
+internal void
+flow_scope_touch_node__stripe_r_guarded(FLOW_Scope *scope, FLOW_Node *node)
+{
+  FLOW_Touch *touch = push_array(flow_tctx->arena, FLOW_Touch, 1);
+  ins_atomic_u64_inc_eval(&node->scope_ref_count);
+  ins_atomic_u64_eval_assign(&node->last_time_touched_us, os_now_microseconds());
+  ins_atomic_u64_eval_assign(&node->last_user_clock_idx_touched, flow_user_clock_idx());
+  touch->hash = node->hash;
+  MemoryCopyStruct(&touch->params, &node->params);
+  SLLStackPush(scope->top_touch, touch);
+}
+
+////////////////////////////////
+//~ rjf: Cache Lookups
+
+internal FLOW_Info
+flow_info_from_hash_params(FLOW_Scope *scope, U128 hash, FLOW_Params *params)
+{
+  FLOW_Info info = {0};
+  if(!u128_match(hash, u128_zero()))
+  {
+    U64 slot_idx = hash.u64[1]%flow_shared->slots_count;
+    U64 stripe_idx = slot_idx%flow_shared->stripes_count;
+    FLOW_Slot *slot = &flow_shared->slots[slot_idx];
+    FLOW_Stripe *stripe = &flow_shared->stripes[stripe_idx];
+    B32 found = 0;
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(FLOW_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(hash, n->hash) && flow_params_match(params, &n->params))
+        {
+          MemoryCopyStruct(&info, &n->info);
+          found = 1;
+          flow_scope_touch_node__stripe_r_guarded(scope, n);
+          break;
+        }
+      }
+    }
+    B32 node_is_new = 0;
+    if(!found)
+    {
+      OS_MutexScopeW(stripe->rw_mutex)
+      {
+        FLOW_Node *node = 0;
+        for(FLOW_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(u128_match(hash, n->hash) && flow_params_match(params, &n->params))
+          {
+            node = n;
+            break;
+          }
+        }
+        if(node == 0)
+        {
+          node = stripe->free_node;
+          if(node)
+          {
+            SLLStackPop(stripe->free_node);
+          }
+          else
+          {
+            node = push_array_no_zero(stripe->arena, FLOW_Node, 1);
+          }
+          MemoryZeroStruct(node);
+          DLLPushBack(slot->first, slot->last, node);
+          node->hash = hash;
+          MemoryCopyStruct(&node->params, params);
+          node->is_working = 1;
+          node->last_time_touched_us = os_now_microseconds();
+          node->last_user_clock_idx_touched = flow_user_clock_idx();
+          node_is_new = 1;
+        }
+      }
+    }
+    if(node_is_new)
+    {
+      Arena *task_arena = arena_alloc();
+      FLOW_BuildTaskIn *in = push_array(task_arena, FLOW_BuildTaskIn, 1);
+      in->hash = hash;
+      MemoryCopyStruct(&in->params, params);
+      TS_Ticket ticket = ts_kickoff(flow_build_task__entry_point, &task_arena, in);
+      OS_MutexScopeW(stripe->rw_mutex)
+      {
+        for(FLOW_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(u128_match(hash, n->hash) && flow_params_match(params, &n->params))
+          {
+            n->ticket = ticket;
+            break;
+          }
+        }
+      }
+    }
+  }
+  return info;
+}
+
+internal FLOW_Info
+flow_info_from_key_params(FLOW_Scope *scope, U128 key, FLOW_Params *params, U128 *hash_out)
+{
+  FLOW_Info result = {0};
+  for(U64 rewind_idx = 0; rewind_idx < 2; rewind_idx += 1)
+  {
+    U128 hash = hs_hash_from_key(key, rewind_idx);
+    result = flow_info_from_hash_params(scope, hash, params);
+    if(result.insts.count != 0)
+    {
+      if(hash_out)
+      {
+        *hash_out = hash;
+      }
+      break;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Build Tasks
+
+internal TS_TASK_FUNCTION_DEF(flow_build_task__entry_point)
+{
+  FLOW_BuildTaskIn *in = (FLOW_BuildTaskIn *)p;
+  HS_Scope *hs_scope = hs_scope_open();
+  
+  //- rjf: unpack hash
+  U64 slot_idx = in->hash.u64[1]%flow_shared->slots_count;
+  U64 stripe_idx = slot_idx%flow_shared->stripes_count;
+  FLOW_Slot *slot = &flow_shared->slots[slot_idx];
+  FLOW_Stripe *stripe = &flow_shared->stripes[stripe_idx];
+  
+  //- rjf: hash -> data -> info
+  String8 data = hs_data_from_hash(hs_scope, in->hash);
+  data = str8_prefix(data, dim_1u64(in->params.vaddr_range));
+  FLOW_Info info = flow_info_from_arch_vaddr_data(arena, in->params.arch, in->params.vaddr_range.min, data);
+  
+  //- rjf: commit results to cache
+  B32 committed = 0;
+  OS_MutexScopeW(stripe->rw_mutex)
+  {
+    for(FLOW_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->hash, in->hash) && flow_params_match(&n->params, &in->params))
+      {
+        n->info_arena = arena;
+        MemoryCopyStruct(&n->info, &info);
+        ins_atomic_u32_eval_assign(&n->is_working, 0);
+        ins_atomic_u64_inc_eval(&n->load_count);
+        committed = 1;
+        break;
+      }
+    }
+  }
+  
+  hs_scope_close(hs_scope);
+  if(!committed)
+  {
+    arena_release(arena);
+  }
+  
+  // NOTE: the result is only used by the evictor, to learn that this
+  // task's ticket has completed & can be joined.
+  return (void *)1;
+}
+
+////////////////////////////////
+//~ rjf: Evictor Thread
+
+internal void
+flow_evictor_thread__entry_point(void *p)
+{
+  ThreadNameF("[flow] evictor thread");
+  for(;;)
+  {
+    U64 check_time_us = os_now_microseconds();
+    U64 check_time_user_clocks = flow_user_clock_idx();
+    U64 evict_threshold_us = 10*1000000;
+    U64 evict_threshold_user_clocks = 10;
+    for(U64 slot_idx = 0; slot_idx < flow_shared->slots_count; slot_idx += 1)
+    {
+      U64 stripe_idx = slot_idx%flow_shared->stripes_count;
+      FLOW_Slot *slot = &flow_shared->slots[slot_idx];
+      FLOW_Stripe *stripe = &flow_shared->stripes[stripe_idx];
+      B32 slot_has_work = 0;
+      OS_MutexScopeR(stripe->rw_mutex)
+      {
+        for(FLOW_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(n->is_working == 0 && (n->ticket.u64[0] != 0 ||
+                                    (n->scope_ref_count == 0 &&
+                                     n->last_time_touched_us+evict_threshold_us <= check_time_us &&
+                                     n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
+                                     n->load_count != 0)))
+          {
+            slot_has_work = 1;
+            break;
+          }
+        }
+      }
+      if(slot_has_work) OS_MutexScopeW(stripe->rw_mutex)
+      {
+        for(FLOW_Node *n = slot->first, *next = 0; n != 0; n = next)
+        {
+          next = n->next;
+          if(n->is_working == 0 && n->ticket.u64[0] != 0 && ts_join(n->ticket, 0) != 0)
+          {
+            MemoryZeroStruct(&n->ticket);
+          }
+          if(n->scope_ref_count == 0 &&
+             n->last_time_touched_us+evict_threshold_us <= check_time_us &&
+             n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
+             n->load_count != 0 &&
+             n->is_working == 0 &&
+             n->ticket.u64[0] == 0)
+          {
+            DLLRemove(slot->first, slot->last, n);
+            if(n->info_arena != 0)
+            {
+              arena_release(n->info_arena);
+            }
+            SLLStackPush(stripe->free_node, n);
+          }
+        }
+      }
+    }
+    os_sleep_milliseconds(100);
+  }
+}
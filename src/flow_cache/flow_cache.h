@@ -0,0 +1,210 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef FLOW_CACHE_H
+#define FLOW_CACHE_H
+
+// NOTE: This layer caches the control flow structure of a procedure's
+// machine code - per-instruction lengths, flow flags, branch destinations &
+// stack pointer deltas.
+// Entries are keyed by the hash of the procedure's code bytes (as produced by
+// the hash store) and the procedure's virtual address range, and are built
+// in the background on the task system. Stepping through the same functions
+// repeatedly then no longer needs to re-read & re-decode the same bytes.
+
+////////////////////////////////
+//~ rjf: Parameters Bundle
+
+typedef struct FLOW_Params FLOW_Params;
+struct FLOW_Params
+{
+  Rng1U64 vaddr_range;
+  Architecture arch;
+};
+
+////////////////////////////////
+//~ rjf: Instruction Types
+
+typedef struct FLOW_Inst FLOW_Inst;
+struct FLOW_Inst
+{
+  U32 off;
+  U32 size;
+  X64_InstFlags flags;
+  S32 sp_delta;
+  U64 jump_dest_vaddr;
+};
+
+typedef struct FLOW_InstArray FLOW_InstArray;
+struct FLOW_InstArray
+{
+  FLOW_Inst *v;
+  U64 count;
+};
+
+////////////////////////////////
+//~ rjf: Value Bundle Type
+
+typedef struct FLOW_Info FLOW_Info;
+struct FLOW_Info
+{
+  Rng1U64 vaddr_range;
+  FLOW_InstArray insts;
+};
+
+////////////////////////////////
+//~ rjf: Cache Types
+
+typedef struct FLOW_Node FLOW_Node;
+struct FLOW_Node
+{
+  // rjf: links
+  FLOW_Node *next;
+  FLOW_Node *prev;
+  
+  // rjf: key
+  U128 hash;
+  FLOW_Params params;
+  
+  // rjf: value
+  Arena *info_arena;
+  FLOW_Info info;
+  
+  // rjf: task
+  TS_Ticket ticket;
+  
+  // rjf: metadata
+  B32 is_working;
+  U64 scope_ref_count;
+  U64 last_time_touched_us;
+  U64 last_user_clock_idx_touched;
+  U64 load_count;
+};
+
+typedef struct FLOW_Slot FLOW_Slot;
+struct FLOW_Slot
+{
+  FLOW_Node *first;
+  FLOW_Node *last;
+};
+
+typedef struct FLOW_Stripe FLOW_Stripe;
+struct FLOW_Stripe
+{
+  Arena *arena;
+  OS_Handle rw_mutex;
+  OS_Handle cv;
+  FLOW_Node *free_node;
+};
+
+////////////////////////////////
+//~ rjf: Scoped Access Types
+
+typedef struct FLOW_Touch FLOW_Touch;
+struct FLOW_Touch
+{
+  FLOW_Touch *next;
+  U128 hash;
+  FLOW_Params params;
+};
+
+typedef struct FLOW_Scope FLOW_Scope;
+struct FLOW_Scope
+{
+  FLOW_Scope *next;
+  FLOW_Touch *top_touch;
+  U64 base_pos;
+};
+
+////////////////////////////////
+//~ rjf: Build Task Types
+
+typedef struct FLOW_BuildTaskIn FLOW_BuildTaskIn;
+struct FLOW_BuildTaskIn
+{
+  U128 hash;
+  FLOW_Params params;
+};
+
+////////////////////////////////
+//~ rjf: Thread Context
+
+typedef struct FLOW_TCTX FLOW_TCTX;
+struct FLOW_TCTX
+{
+  Arena *arena;
+};
+
+////////////////////////////////
+//~ rjf: Shared State
+
+typedef struct FLOW_Shared FLOW_Shared;
+struct FLOW_Shared
+{
+  Arena *arena;
+  
+  // rjf: user clock
+  U64 user_clock_idx;
+  
+  // rjf: cache
+  U64 slots_count;
+  U64 stripes_count;
+  FLOW_Slot *slots;
+  FLOW_Stripe *stripes;
+  
+  // rjf: evictor thread
+  OS_Handle evictor_thread;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+thread_static FLOW_TCTX *flow_tctx = 0;
+global FLOW_Shared *flow_shared = 0;
+
+////////////////////////////////
+//~ rjf: Parameter Type Functions
+
+internal B32 flow_params_match(FLOW_Params *a, FLOW_Params *b);
+
+////////////////////////////////
+//~ rjf: Value Bundle Functions
+
+internal FLOW_Info flow_info_from_arch_vaddr_data(Arena *arena, Architecture arch, U64 vaddr, String8 data);
+internal U64 flow_inst_idx_from_vaddr(FLOW_Info *info, U64 vaddr);
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void flow_init(void);
+
+////////////////////////////////
+//~ rjf: User Clock
+
+internal void flow_user_clock_tick(void);
+internal U64 flow_user_clock_idx(void);
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+internal FLOW_Scope *flow_scope_open(void);
+internal void flow_scope_close(FLOW_Scope *scope);
+internal void flow_scope_touch_node__stripe_r_guarded(FLOW_Scope *scope, FLOW_Node *node);
+
+////////////////////////////////
+//~ rjf: Cache Lookups
+
+internal FLOW_Info flow_info_from_hash_params(FLOW_Scope *scope, U128 hash, FLOW_Params *params);
+internal FLOW_Info flow_info_from_key_params(FLOW_Scope *scope, U128 key, FLOW_Params *params, U128 *hash_out);
+
+////////////////////////////////
+//~ rjf: Build Tasks
+
+internal TS_TASK_FUNCTION_DEF(flow_build_task__entry_point);
+
+////////////////////////////////
+//~ rjf: Evictor Thread
+
+internal void flow_evictor_thread__entry_point(void *p);
+
+#endif // FLOW_CACHE_H
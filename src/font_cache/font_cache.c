@@ -459,6 +459,74 @@ f_atlas_region_release(F_Atlas *atlas, Rng2S16 region)
   ProfEnd();
 }
 
+internal Rng2S16
+f_atlas_region_alloc_and_fill(Vec2S16 raster_dim, void *raster_data, S16 *atlas_num_out)
+{
+  ProfBeginFunction();
+  
+  //- rjf: allocate portion of an atlas to upload the rasterization
+  S16 chosen_atlas_num = 0;
+  F_Atlas *chosen_atlas = 0;
+  Rng2S16 chosen_atlas_region = {0};
+  if(raster_dim.x != 0 && raster_dim.y != 0)
+  {
+    U64 num_atlases = 0;
+    for(F_Atlas *atlas = f_state->first_atlas;; atlas = atlas->next, num_atlases += 1)
+    {
+      // rjf: create atlas if needed
+      if(atlas == 0 && num_atlases < 16)
+      {
+        atlas = push_array(f_state->arena, F_Atlas, 1);
+        DLLPushBack(f_state->first_atlas, f_state->last_atlas, atlas);
+        atlas->root_dim = v2s16(1024, 1024);
+        atlas->root = push_array(f_state->arena, F_AtlasRegionNode, 1);
+        atlas->root->max_free_size[Corner_00] =
+          atlas->root->max_free_size[Corner_01] =
+          atlas->root->max_free_size[Corner_10] =
+          atlas->root->max_free_size[Corner_11] = v2s16(atlas->root_dim.x/2, atlas->root_dim.y/2);
+        atlas->texture = r_tex2d_alloc(R_ResourceKind_Dynamic, v2s32((S32)atlas->root_dim.x, (S32)atlas->root_dim.y), R_Tex2DFormat_RGBA8, 0);
+      }
+      
+      // rjf: allocate from atlas
+      if(atlas != 0)
+      {
+        Vec2S16 needed_dimensions = v2s16(raster_dim.x + 2, raster_dim.y + 2);
+        chosen_atlas_region = f_atlas_region_alloc(f_state->arena, atlas, needed_dimensions);
+        if(chosen_atlas_region.x1 != chosen_atlas_region.x0)
+        {
+          chosen_atlas = atlas;
+          chosen_atlas_num = (S32)num_atlases;
+          break;
+        }
+      }
+      else
+      {
+        break;
+      }
+    }
+  }
+  
+  //- rjf: upload rasterization to allocated region of atlas texture memory
+  if(chosen_atlas != 0)
+  {
+    Rng2S32 subregion =
+    {
+      chosen_atlas_region.x0 + 1,
+      chosen_atlas_region.y0 + 1,
+      chosen_atlas_region.x0 + raster_dim.x + 1,
+      chosen_atlas_region.y0 + raster_dim.y + 1
+    };
+    r_fill_tex2d_region(chosen_atlas->texture, subregion, raster_data);
+  }
+  
+  if(atlas_num_out != 0)
+  {
+    *atlas_num_out = chosen_atlas_num;
+  }
+  ProfEnd();
+  return chosen_atlas_region;
+}
+
 ////////////////////////////////
 //~ rjf: Piece Type Functions
 
@@ -515,39 +583,53 @@ f_piece_array_copy(Arena *arena, F_PieceArray *src)
 ////////////////////////////////
 //~ rjf: Rasterization Cache
 
+internal U64
+f_style_hash_from_tag_size(F_Tag tag, F32 size)
+{
+  U64 buffer[] =
+  {
+    tag.u64[0],
+    tag.u64[1],
+    (U64)round_f32(size),
+  };
+  U64 style_hash = f_little_hash_from_string(str8((U8 *)buffer, sizeof(buffer)));
+  return style_hash;
+}
+
 internal F_Hash2StyleRasterCacheNode *
-f_hash2style_from_tag_size(F_Tag tag, F32 size)
+f_hash2style_from_style_hash(U64 style_hash)
 {
-  //- rjf: tag * size -> style hash
-  U64 style_hash = {0};
+  F_Hash2StyleRasterCacheNode *hash2style_node = 0;
+  U64 slot_idx = style_hash%f_state->hash2style_slots_count;
+  F_Hash2StyleRasterCacheSlot *slot = &f_state->hash2style_slots[slot_idx];
+  for(F_Hash2StyleRasterCacheNode *n = slot->first;
+      n != 0;
+      n = n->hash_next)
   {
-    U64 buffer[] =
+    if(n->style_hash == style_hash)
     {
-      tag.u64[0],
-      tag.u64[1],
-      (U64)round_f32(size),
-    };
-    style_hash = f_little_hash_from_string(str8((U8 *)buffer, sizeof(buffer)));
+      hash2style_node = n;
+      break;
+    }
   }
+  return hash2style_node;
+}
+
+internal F_Hash2StyleRasterCacheNode *
+f_hash2style_from_tag_size(F_Tag tag, F32 size)
+{
+  //- rjf: tag * size -> style hash
+  U64 style_hash = f_style_hash_from_tag_size(tag, size);
   
   //- rjf: style hash -> style node
   F_Hash2StyleRasterCacheNode *hash2style_node = 0;
   {
     ProfBegin("style hash -> style node");
-    U64 slot_idx = style_hash%f_state->hash2style_slots_count;
-    F_Hash2StyleRasterCacheSlot *slot = &f_state->hash2style_slots[slot_idx];
-    for(F_Hash2StyleRasterCacheNode *n = slot->first;
-        n != 0;
-        n = n->hash_next)
-    {
-      if(n->style_hash == style_hash)
-      {
-        hash2style_node = n;
-        break;
-      }
-    }
+    hash2style_node = f_hash2style_from_style_hash(style_hash);
     if(Unlikely(hash2style_node == 0))
     {
+      U64 slot_idx = style_hash%f_state->hash2style_slots_count;
+      F_Hash2StyleRasterCacheSlot *slot = &f_state->hash2style_slots[slot_idx];
       F_Metrics metrics = f_metrics_from_tag_size(tag, size);
       hash2style_node = push_array(f_state->arena, F_Hash2StyleRasterCacheNode, 1);
       DLLPushBack_NP(slot->first, slot->last, hash2style_node, hash_next, hash_prev);
@@ -564,8 +646,44 @@ f_hash2style_from_tag_size(F_Tag tag, F32 size)
   return hash2style_node;
 }
 
+internal F_RasterCacheInfo *
+f_raster_cache_info_from_style_piece(F_Hash2StyleRasterCacheNode *hash2style_node, U64 piece_hash, String8 piece_substring)
+{
+  F_RasterCacheInfo *info = 0;
+  if(piece_substring.size == 1)
+  {
+    U8 byte = piece_substring.str[0];
+    if(hash2style_node->utf8_class1_direct_map_mask[byte/64] & (1ull<<(byte%64)))
+    {
+      info = &hash2style_node->utf8_class1_direct_map[byte];
+    }
+  }
+  else
+  {
+    U64 slot_idx = piece_hash%hash2style_node->hash2info_slots_count;
+    F_Hash2InfoRasterCacheSlot *slot = &hash2style_node->hash2info_slots[slot_idx];
+    for(F_Hash2InfoRasterCacheNode *node = slot->first; node != 0; node = node->hash_next)
+    {
+      if(node->hash == piece_hash)
+      {
+        info = &node->info;
+        break;
+      }
+    }
+  }
+  return info;
+}
+
 internal F_Run
 f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, String8 string)
+{
+  B32 pending = 0;
+  F_Run run = f_push_run_from_string__pending_out(arena, tag, size, base_align_px, tab_size_px, flags, string, &pending);
+  return run;
+}
+
+internal F_Run
+f_push_run_from_string__pending_out(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, String8 string, B32 *pending_out)
 {
   ProfBeginFunction();
   
@@ -575,6 +693,7 @@ f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32
   //- rjf: decode string & produce run pieces
   F_PieceChunkList piece_chunks = {0};
   Vec2F32 dim = {0};
+  B32 pending = 0;
   B32 font_handle_mapped_on_miss = 0;
   FP_Handle font_handle = {0};
   U64 piece_substring_start_idx = 0;
@@ -634,24 +753,16 @@ f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32
       if(piece_substring.size > 1)
       {
         piece_hash = f_little_hash_from_string(piece_substring);
-        U64 slot_idx = piece_hash%hash2style_node->hash2info_slots_count;
-        F_Hash2InfoRasterCacheSlot *slot = &hash2style_node->hash2info_slots[slot_idx];
-        for(F_Hash2InfoRasterCacheNode *node = slot->first; node != 0; node = node->hash_next)
-        {
-          if(node->hash == piece_hash)
-          {
-            info = &node->info;
-            break;
-          }
-        }
+        info = f_raster_cache_info_from_style_piece(hash2style_node, piece_hash, piece_substring);
       }
     }
     
-    //- rjf: no info found -> miss... fill this hash in the cache
+    //- rjf: no info found -> miss... measure advance now, rasterize on the
+    // raster threads, and fill the atlas region once results come back
+    F_RasterCacheInfo miss_info = {0};
     if(info == 0)
     {
-      ProfBegin("no info found -> miss... fill this hash in the cache");
-      Temp scratch = scratch_begin(&arena, 1);
+      ProfBegin("no info found -> miss... queue rasterization for this hash");
       
       // rjf: grab font handle for this tag if we don't have one already
       if(font_handle_mapped_on_miss == 0)
@@ -681,66 +792,16 @@ f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32
         }
       }
       
-      // rjf: call into font provider to rasterize this substring
-      FP_RasterResult raster = fp_raster(scratch.arena, font_handle, round_f32(size), FP_RasterMode_Sharp, piece_substring);
-      
-      // rjf: allocate portion of an atlas to upload the rasterization
-      S16 chosen_atlas_num = 0;
-      F_Atlas *chosen_atlas = 0;
-      Rng2S16 chosen_atlas_region = {0};
-      if(raster.atlas_dim.x != 0 && raster.atlas_dim.y != 0)
-      {
-        U64 num_atlases = 0;
-        for(F_Atlas *atlas = f_state->first_atlas;; atlas = atlas->next, num_atlases += 1)
-        {
-          // rjf: create atlas if needed
-          if(atlas == 0 && num_atlases < 16)
-          {
-            atlas = push_array(f_state->arena, F_Atlas, 1);
-            DLLPushBack(f_state->first_atlas, f_state->last_atlas, atlas);
-            atlas->root_dim = v2s16(1024, 1024);
-            atlas->root = push_array(f_state->arena, F_AtlasRegionNode, 1);
-            atlas->root->max_free_size[Corner_00] =
-              atlas->root->max_free_size[Corner_01] =
-              atlas->root->max_free_size[Corner_10] =
-              atlas->root->max_free_size[Corner_11] = v2s16(atlas->root_dim.x/2, atlas->root_dim.y/2);
-            atlas->texture = r_tex2d_alloc(R_ResourceKind_Dynamic, v2s32((S32)atlas->root_dim.x, (S32)atlas->root_dim.y), R_Tex2DFormat_RGBA8, 0);
-          }
-          
-          // rjf: allocate from atlas
-          if(atlas != 0)
-          {
-            Vec2S16 needed_dimensions = v2s16(raster.atlas_dim.x + 2, raster.atlas_dim.y + 2);
-            chosen_atlas_region = f_atlas_region_alloc(f_state->arena, atlas, needed_dimensions);
-            if(chosen_atlas_region.x1 != chosen_atlas_region.x0)
-            {
-              chosen_atlas = atlas;
-              chosen_atlas_num = (S32)num_atlases;
-              break;
-            }
-          }
-          else
-          {
-            break;
-          }
-        }
-      }
+      // rjf: placeholder info - correct advance, but no atlas region yet
+      miss_info.advance = fp_advance_from_font_size_string(font_handle, round_f32(size), piece_substring);
+      miss_info.flags |= F_RasterCacheInfoFlag_Pending;
+      info = &miss_info;
       
-      // rjf: upload rasterization to allocated region of atlas texture memory
-      if(chosen_atlas != 0)
-      {
-        Rng2S32 subregion =
-        {
-          chosen_atlas_region.x0 + 1,
-          chosen_atlas_region.y0 + 1,
-          chosen_atlas_region.x0 + raster.atlas_dim.x + 1,
-          chosen_atlas_region.y0 + raster.atlas_dim.y + 1
-        };
-        r_fill_tex2d_region(chosen_atlas->texture, subregion, raster.atlas);
-      }
-      
-      // rjf: allocate & fill & push node
+      // rjf: send request to raster threads; only commit to the cache if it
+      // was sent, so a full ring gets retried on a later frame
+      if(f_u2r_enqueue_req(hash2style_node->style_hash, piece_hash, font_handle, round_f32(size), piece_substring, 0))
       {
+        f_state->raster_pending_count += 1;
         if(piece_substring.size == 1)
         {
           info = &hash2style_node->utf8_class1_direct_map[piece_substring.str[0]];
@@ -755,22 +816,21 @@ f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32
           node->hash = piece_hash;
           info = &node->info;
         }
-        if(info != 0)
-        {
-          info->subrect = chosen_atlas_region;
-          info->atlas_num = chosen_atlas_num;
-          info->raster_dim = raster.atlas_dim;
-          info->advance = raster.advance;
-        }
+        MemoryCopyStruct(info, &miss_info);
       }
       
-      scratch_end(scratch);
       ProfEnd();
     }
     
     //- rjf: push piece for this raster portion
     if(info != 0)
     {
+      // rjf: note glyphs which have not landed in the atlas yet
+      if(info->flags & F_RasterCacheInfoFlag_Pending)
+      {
+        pending = 1;
+      }
+      
       // rjf: find atlas
       F_Atlas *atlas = 0;
       {
@@ -831,6 +891,7 @@ f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32
     run.ascent  = hash2style_node->ascent;
     run.descent = hash2style_node->descent;
   }
+  *pending_out = pending;
   
   ProfEnd();
   return run;
@@ -1012,6 +1073,172 @@ f_char_pos_from_tag_size_string_p(F_Tag tag, F32 size, F32 base_align_px, F32 ta
   return result;
 }
 
+////////////////////////////////
+//~ rjf: Run Cache
+
+internal U64
+f_run_cache_hash_from_string(String8 string)
+{
+  U64 result = f_little_hash_from_string(string);
+  return result;
+}
+
+internal F_Run
+f_push_cached_run_from_string_hash(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, U64 string_hash, String8 string)
+{
+  ProfBeginFunction();
+  
+  //- rjf: string hash * style -> run hash
+  // (alignment & tab size only matter for strings containing tabs, so they
+  // are checked per-node rather than folded into the hash)
+  U64 run_hash = 0;
+  {
+    U64 buffer[] =
+    {
+      string_hash,
+      tag.u64[0],
+      tag.u64[1],
+      (U64)round_f32(size*64.f),
+      (U64)flags,
+    };
+    run_hash = f_little_hash_from_string(str8((U8 *)buffer, sizeof(buffer)));
+  }
+  
+  //- rjf: run hash -> existing node
+  // (hashes & sizes are compared first, so only an actual hit - or a rare
+  // collision - pays for the full string comparison)
+  U64 slot_idx = run_hash%f_state->run_cache_slots_count;
+  F_RunCacheSlot *slot = &f_state->run_cache_slots[slot_idx];
+  F_RunCacheNode *node = 0;
+  for(F_RunCacheNode *n = slot->first; n != 0; n = n->hash_next)
+  {
+    if(n->hash == run_hash &&
+       n->string_hash == string_hash &&
+       n->string.size == string.size &&
+       f_tag_match(n->tag, tag) &&
+       n->size == size &&
+       n->flags == flags &&
+       (!n->has_tabs || (n->base_align_px == base_align_px && n->tab_size_px == tab_size_px)) &&
+       str8_match(n->string, string, 0))
+    {
+      node = n;
+      break;
+    }
+  }
+  
+  //- rjf: no node -> build run, & commit it to the cache if possible
+  F_Run run = {0};
+  if(node == 0)
+  {
+    B32 pending = 0;
+    run = f_push_run_from_string__pending_out(arena, tag, size, base_align_px, tab_size_px, flags, string, &pending);
+    
+    // rjf: pick storage block size class for pieces & string
+    U64 needed_size = sizeof(F_Piece)*run.pieces.count + string.size;
+    U64 block_size_class = 0;
+    for(;block_size_class < F_RUN_CACHE_BLOCK_SIZE_CLASS_COUNT && (64ull<<block_size_class) < needed_size; block_size_class += 1);
+    
+    // rjf: runs with glyphs still rasterizing will change once those land, and
+    // very large strings would thrash the cache - only commit the rest
+    if(!pending && string.size <= F_RUN_CACHE_MAX_STRING_SIZE && block_size_class < F_RUN_CACHE_BLOCK_SIZE_CLASS_COUNT)
+    {
+      U8 *block = (U8 *)f_state->run_cache_free_blocks[block_size_class];
+      if(block != 0)
+      {
+        SLLStackPop(f_state->run_cache_free_blocks[block_size_class]);
+      }
+      else
+      {
+        arena_push_align(f_state->arena, 8);
+        block = push_array_no_zero(f_state->arena, U8, 64ull<<block_size_class);
+      }
+      node = f_state->run_cache_free_node;
+      if(node != 0)
+      {
+        SLLStackPop_N(f_state->run_cache_free_node, hash_next);
+      }
+      else
+      {
+        node = push_array_no_zero(f_state->arena, F_RunCacheNode, 1);
+      }
+      MemoryZeroStruct(node);
+      DLLPushBack_NP(slot->first, slot->last, node, hash_next, hash_prev);
+      DLLPushFront_NP(f_state->run_cache_lru_first, f_state->run_cache_lru_last, node, lru_next, lru_prev);
+      f_state->run_cache_count += 1;
+      node->hash = run_hash;
+      node->string_hash = string_hash;
+      node->tag = tag;
+      node->size = size;
+      node->base_align_px = base_align_px;
+      node->tab_size_px = tab_size_px;
+      node->flags = flags;
+      node->has_tabs = (str8_find_needle(string, 0, str8_lit("\t"), 0) < string.size);
+      node->block_size_class = block_size_class;
+      node->last_frame_idx_touched = f_state->frame_idx;
+      node->run = run;
+      node->run.pieces.v = (F_Piece *)block;
+      MemoryCopy(node->run.pieces.v, run.pieces.v, sizeof(F_Piece)*run.pieces.count);
+      node->string.str = block + sizeof(F_Piece)*run.pieces.count;
+      node->string.size = string.size;
+      MemoryCopy(node->string.str, string.str, string.size);
+      run = node->run;
+    }
+  }
+  
+  //- rjf: existing node -> touch & return its run
+  else
+  {
+    node->last_frame_idx_touched = f_state->frame_idx;
+    if(node != f_state->run_cache_lru_first)
+    {
+      DLLRemove_NP(f_state->run_cache_lru_first, f_state->run_cache_lru_last, node, lru_next, lru_prev);
+      DLLPushFront_NP(f_state->run_cache_lru_first, f_state->run_cache_lru_last, node, lru_next, lru_prev);
+    }
+    run = node->run;
+  }
+  
+  ProfEnd();
+  return run;
+}
+
+internal F_Run
+f_push_cached_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, String8 string)
+{
+  U64 string_hash = f_run_cache_hash_from_string(string);
+  F_Run run = f_push_cached_run_from_string_hash(arena, tag, size, base_align_px, tab_size_px, flags, string_hash, string);
+  return run;
+}
+
+internal void
+f_run_cache_evict(void)
+{
+  ProfBeginFunction();
+  for(F_RunCacheNode *n = f_state->run_cache_lru_last, *prev = 0;
+      n != 0 && f_state->run_cache_count > F_RUN_CACHE_MAX_COUNT;
+      n = prev)
+  {
+    prev = n->lru_prev;
+    
+    // rjf: runs touched within the last two frames may still be referenced by
+    // ui build data - everything in front of this is at least as recent
+    if(n->last_frame_idx_touched+2 >= f_state->frame_idx)
+    {
+      break;
+    }
+    
+    // rjf: release
+    U64 slot_idx = n->hash%f_state->run_cache_slots_count;
+    F_RunCacheSlot *slot = &f_state->run_cache_slots[slot_idx];
+    DLLRemove_NP(slot->first, slot->last, n, hash_next, hash_prev);
+    DLLRemove_NP(f_state->run_cache_lru_first, f_state->run_cache_lru_last, n, lru_next, lru_prev);
+    F_RunCacheFreeBlock *block = (F_RunCacheFreeBlock *)n->run.pieces.v;
+    SLLStackPush(f_state->run_cache_free_blocks[n->block_size_class], block);
+    SLLStackPush_N(f_state->run_cache_free_node, n, hash_next);
+    f_state->run_cache_count -= 1;
+  }
+  ProfEnd();
+}
+
 ////////////////////////////////
 //~ rjf: Metrics
 
@@ -1037,6 +1264,181 @@ f_line_height_from_metrics(F_Metrics *metrics)
   return metrics->ascent + metrics->descent + metrics->line_gap;
 }
 
+////////////////////////////////
+//~ rjf: Asynchronous Rasterization
+
+internal B32
+f_u2r_enqueue_req(U64 style_hash, U64 piece_hash, FP_Handle font, F32 size, String8 piece_substring, U64 endt_us)
+{
+  B32 sent = 0;
+  OS_MutexScope(f_state->u2r_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = f_state->u2r_ring_write_pos - f_state->u2r_ring_read_pos;
+    U64 available_size = f_state->u2r_ring_size - unconsumed_size;
+    U64 needed_size = sizeof(style_hash) + sizeof(piece_hash) + sizeof(font) + sizeof(size) + sizeof(piece_substring.size) + piece_substring.size + 7;
+    if(available_size >= needed_size)
+    {
+      f_state->u2r_ring_write_pos += ring_write_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_write_pos, &style_hash);
+      f_state->u2r_ring_write_pos += ring_write_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_write_pos, &piece_hash);
+      f_state->u2r_ring_write_pos += ring_write_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_write_pos, &font);
+      f_state->u2r_ring_write_pos += ring_write_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_write_pos, &size);
+      f_state->u2r_ring_write_pos += ring_write_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_write_pos, &piece_substring.size);
+      f_state->u2r_ring_write_pos += ring_write(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_write_pos, piece_substring.str, piece_substring.size);
+      f_state->u2r_ring_write_pos += 7;
+      f_state->u2r_ring_write_pos -= f_state->u2r_ring_write_pos%8;
+      sent = 1;
+      break;
+    }
+    if(os_now_microseconds() >= endt_us)
+    {
+      break;
+    }
+    os_condition_variable_wait(f_state->u2r_ring_cv, f_state->u2r_ring_mutex, endt_us);
+  }
+  if(sent)
+  {
+    os_condition_variable_broadcast(f_state->u2r_ring_cv);
+  }
+  return sent;
+}
+
+internal void
+f_u2r_dequeue_req(Arena *arena, U64 *style_hash_out, U64 *piece_hash_out, FP_Handle *font_out, F32 *size_out, String8 *piece_substring_out)
+{
+  OS_MutexScope(f_state->u2r_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = f_state->u2r_ring_write_pos - f_state->u2r_ring_read_pos;
+    if(unconsumed_size >= sizeof(*style_hash_out) + sizeof(*piece_hash_out) + sizeof(*font_out) + sizeof(*size_out) + sizeof(piece_substring_out->size))
+    {
+      f_state->u2r_ring_read_pos += ring_read_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_read_pos, style_hash_out);
+      f_state->u2r_ring_read_pos += ring_read_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_read_pos, piece_hash_out);
+      f_state->u2r_ring_read_pos += ring_read_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_read_pos, font_out);
+      f_state->u2r_ring_read_pos += ring_read_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_read_pos, size_out);
+      f_state->u2r_ring_read_pos += ring_read_struct(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_read_pos, &piece_substring_out->size);
+      piece_substring_out->str = push_array_no_zero(arena, U8, piece_substring_out->size);
+      f_state->u2r_ring_read_pos += ring_read(f_state->u2r_ring_base, f_state->u2r_ring_size, f_state->u2r_ring_read_pos, piece_substring_out->str, piece_substring_out->size);
+      f_state->u2r_ring_read_pos += 7;
+      f_state->u2r_ring_read_pos -= f_state->u2r_ring_read_pos%8;
+      break;
+    }
+    os_condition_variable_wait(f_state->u2r_ring_cv, f_state->u2r_ring_mutex, max_U64);
+  }
+  os_condition_variable_broadcast(f_state->u2r_ring_cv);
+}
+
+internal void
+f_r2u_push_result(F_RasterResult *result)
+{
+  U64 raster_data_size = (U64)result->raster_dim.x*(U64)result->raster_dim.y*4;
+  U64 header_size = sizeof(result->style_hash) + sizeof(result->piece_hash) + sizeof(result->piece_substring.size) + result->piece_substring.size + sizeof(result->raster_dim) + sizeof(result->advance) + 7;
+  
+  //- rjf: rasterizations which could never fit in the ring are dropped,
+  // leaving only the advance & an empty region
+  if(header_size + raster_data_size > f_state->r2u_ring_size)
+  {
+    MemoryZeroStruct(&result->raster_dim);
+    raster_data_size = 0;
+  }
+  
+  OS_MutexScope(f_state->r2u_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = f_state->r2u_ring_write_pos - f_state->r2u_ring_read_pos;
+    U64 available_size = f_state->r2u_ring_size - unconsumed_size;
+    if(available_size >= header_size + raster_data_size)
+    {
+      f_state->r2u_ring_write_pos += ring_write_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, &result->style_hash);
+      f_state->r2u_ring_write_pos += ring_write_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, &result->piece_hash);
+      f_state->r2u_ring_write_pos += ring_write_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, &result->piece_substring.size);
+      f_state->r2u_ring_write_pos += ring_write(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, result->piece_substring.str, result->piece_substring.size);
+      f_state->r2u_ring_write_pos += ring_write_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, &result->raster_dim);
+      f_state->r2u_ring_write_pos += ring_write_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, &result->advance);
+      f_state->r2u_ring_write_pos += ring_write(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_write_pos, result->raster_data, raster_data_size);
+      f_state->r2u_ring_write_pos += 7;
+      f_state->r2u_ring_write_pos -= f_state->r2u_ring_write_pos%8;
+      break;
+    }
+    os_condition_variable_wait(f_state->r2u_ring_cv, f_state->r2u_ring_mutex, max_U64);
+  }
+  os_condition_variable_broadcast(f_state->r2u_ring_cv);
+}
+
+internal F_RasterResultList
+f_r2u_pop_results(Arena *arena, U64 budget_bytes)
+{
+  F_RasterResultList results = {0};
+  U64 popped_bytes = 0;
+  OS_MutexScope(f_state->r2u_ring_mutex) for(;popped_bytes < budget_bytes;)
+  {
+    F_RasterResult result = {0};
+    U64 unconsumed_size = f_state->r2u_ring_write_pos - f_state->r2u_ring_read_pos;
+    if(unconsumed_size < sizeof(result.style_hash) + sizeof(result.piece_hash) + sizeof(result.piece_substring.size))
+    {
+      break;
+    }
+    f_state->r2u_ring_read_pos += ring_read_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, &result.style_hash);
+    f_state->r2u_ring_read_pos += ring_read_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, &result.piece_hash);
+    f_state->r2u_ring_read_pos += ring_read_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, &result.piece_substring.size);
+    result.piece_substring.str = push_array_no_zero(arena, U8, result.piece_substring.size);
+    f_state->r2u_ring_read_pos += ring_read(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, result.piece_substring.str, result.piece_substring.size);
+    f_state->r2u_ring_read_pos += ring_read_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, &result.raster_dim);
+    f_state->r2u_ring_read_pos += ring_read_struct(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, &result.advance);
+    U64 raster_data_size = (U64)result.raster_dim.x*(U64)result.raster_dim.y*4;
+    result.raster_data = push_array_no_zero(arena, U8, raster_data_size);
+    f_state->r2u_ring_read_pos += ring_read(f_state->r2u_ring_base, f_state->r2u_ring_size, f_state->r2u_ring_read_pos, result.raster_data, raster_data_size);
+    f_state->r2u_ring_read_pos += 7;
+    f_state->r2u_ring_read_pos -= f_state->r2u_ring_read_pos%8;
+    F_RasterResultNode *n = push_array(arena, F_RasterResultNode, 1);
+    MemoryCopyStruct(&n->v, &result);
+    SLLQueuePush(results.first, results.last, n);
+    results.count += 1;
+    popped_bytes += raster_data_size + 1;
+  }
+  if(results.count != 0)
+  {
+    os_condition_variable_broadcast(f_state->r2u_ring_cv);
+  }
+  return results;
+}
+
+internal void
+f_raster_thread__entry_point(void *p)
+{
+  ThreadNameF("[f] raster #%I64u", (U64)p);
+  for(;;)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    
+    //- rjf: get next request
+    U64 style_hash = 0;
+    U64 piece_hash = 0;
+    FP_Handle font = {0};
+    F32 size = 0;
+    String8 piece_substring = {0};
+    f_u2r_dequeue_req(scratch.arena, &style_hash, &piece_hash, &font, &size, &piece_substring);
+    
+    //- rjf: rasterize
+    FP_RasterResult raster = fp_raster(scratch.arena, font, size, FP_RasterMode_Sharp, piece_substring);
+    
+    //- rjf: send result back to user thread
+    F_RasterResult result = {0};
+    result.style_hash      = style_hash;
+    result.piece_hash      = piece_hash;
+    result.piece_substring = piece_substring;
+    result.raster_dim      = raster.atlas_dim;
+    result.advance         = raster.advance;
+    result.raster_data     = (U8 *)raster.atlas;
+    f_r2u_push_result(&result);
+    
+    scratch_end(scratch);
+  }
+}
+
+internal U64
+f_pending_raster_count(void)
+{
+  return f_state->raster_pending_count;
+}
+
 ////////////////////////////////
 //~ rjf: Main Calls
 
@@ -1050,4 +1452,60 @@ f_init(void)
   f_state->font_hash_table = push_array(arena, F_FontHashSlot, f_state->font_hash_table_size);
   f_state->hash2style_slots_count = 1024;
   f_state->hash2style_slots = push_array(arena, F_Hash2StyleRasterCacheSlot, f_state->hash2style_slots_count);
+  f_state->run_cache_slots_count = 4096;
+  f_state->run_cache_slots = push_array(arena, F_RunCacheSlot, f_state->run_cache_slots_count);
+  f_state->u2r_ring_size = KB(64);
+  f_state->u2r_ring_base = push_array_no_zero(arena, U8, f_state->u2r_ring_size);
+  f_state->u2r_ring_cv = os_condition_variable_alloc();
+  f_state->u2r_ring_mutex = os_mutex_alloc();
+  f_state->r2u_ring_size = MB(4);
+  f_state->r2u_ring_base = push_array_no_zero(arena, U8, f_state->r2u_ring_size);
+  f_state->r2u_ring_cv = os_condition_variable_alloc();
+  f_state->r2u_ring_mutex = os_mutex_alloc();
+  f_state->raster_thread_count = Clamp(1, os_logical_core_count()-1, 4);
+  f_state->raster_threads = push_array(arena, OS_Handle, f_state->raster_thread_count);
+  for(U64 idx = 0; idx < f_state->raster_thread_count; idx += 1)
+  {
+    f_state->raster_threads[idx] = os_launch_thread(f_raster_thread__entry_point, (void *)idx, 0);
+  }
+}
+
+internal void
+f_begin_frame(void)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: bump frame counter & evict stale runs
+  f_state->frame_idx += 1;
+  f_run_cache_evict();
+  
+  //- rjf: gather finished rasterizations, up to this frame's upload budget
+  F_RasterResultList results = f_r2u_pop_results(scratch.arena, F_RASTER_UPLOAD_BUDGET_BYTES_PER_FRAME);
+  
+  //- rjf: upload rasterizations into atlases & fill pending cache infos
+  for(F_RasterResultNode *n = results.first; n != 0; n = n->next)
+  {
+    F_RasterResult *result = &n->v;
+    F_Hash2StyleRasterCacheNode *hash2style_node = f_hash2style_from_style_hash(result->style_hash);
+    F_RasterCacheInfo *info = 0;
+    if(hash2style_node != 0)
+    {
+      info = f_raster_cache_info_from_style_piece(hash2style_node, result->piece_hash, result->piece_substring);
+    }
+    if(info != 0 && info->flags & F_RasterCacheInfoFlag_Pending)
+    {
+      S16 atlas_num = 0;
+      Rng2S16 atlas_region = f_atlas_region_alloc_and_fill(result->raster_dim, result->raster_data, &atlas_num);
+      info->subrect    = atlas_region;
+      info->atlas_num  = atlas_num;
+      info->raster_dim = result->raster_dim;
+      info->advance    = result->advance;
+      info->flags     &= ~F_RasterCacheInfoFlag_Pending;
+    }
+    f_state->raster_pending_count -= 1;
+  }
+  
+  scratch_end(scratch);
+  ProfEnd();
 }
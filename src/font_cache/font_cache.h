@@ -98,12 +98,19 @@ struct F_FontHashSlot
 ////////////////////////////////
 //~ rjf: Rasterization Cache Types
 
+typedef U32 F_RasterCacheInfoFlags;
+enum
+{
+  F_RasterCacheInfoFlag_Pending = (1<<0),
+};
+
 typedef struct F_RasterCacheInfo F_RasterCacheInfo;
 struct F_RasterCacheInfo
 {
   Rng2S16 subrect;
   Vec2S16 raster_dim;
   S16 atlas_num;
+  F_RasterCacheInfoFlags flags;
   F32 advance;
 };
 
@@ -174,6 +181,72 @@ struct F_Atlas
   F_AtlasRegionNode *root;
 };
 
+////////////////////////////////
+//~ rjf: Run Cache Types
+
+typedef struct F_RunCacheNode F_RunCacheNode;
+struct F_RunCacheNode
+{
+  F_RunCacheNode *hash_next;
+  F_RunCacheNode *hash_prev;
+  F_RunCacheNode *lru_next;
+  F_RunCacheNode *lru_prev;
+  U64 hash;
+  U64 string_hash;
+  F_Tag tag;
+  F32 size;
+  F32 base_align_px;
+  F32 tab_size_px;
+  F_RunFlags flags;
+  B32 has_tabs;
+  String8 string;
+  F_Run run;
+  U64 block_size_class;
+  U64 last_frame_idx_touched;
+};
+
+typedef struct F_RunCacheSlot F_RunCacheSlot;
+struct F_RunCacheSlot
+{
+  F_RunCacheNode *first;
+  F_RunCacheNode *last;
+};
+
+typedef struct F_RunCacheFreeBlock F_RunCacheFreeBlock;
+struct F_RunCacheFreeBlock
+{
+  F_RunCacheFreeBlock *next;
+};
+
+////////////////////////////////
+//~ rjf: Asynchronous Rasterization Types
+
+typedef struct F_RasterResult F_RasterResult;
+struct F_RasterResult
+{
+  U64 style_hash;
+  U64 piece_hash;
+  String8 piece_substring;
+  Vec2S16 raster_dim;
+  F32 advance;
+  U8 *raster_data;
+};
+
+typedef struct F_RasterResultNode F_RasterResultNode;
+struct F_RasterResultNode
+{
+  F_RasterResultNode *next;
+  F_RasterResult v;
+};
+
+typedef struct F_RasterResultList F_RasterResultList;
+struct F_RasterResultList
+{
+  F_RasterResultNode *first;
+  F_RasterResultNode *last;
+  U64 count;
+};
+
 ////////////////////////////////
 //~ rjf: Metrics
 
@@ -186,6 +259,19 @@ struct F_Metrics
   F32 capital_height;
 };
 
+////////////////////////////////
+//~ rjf: Constants
+
+// rjf: maximum number of rasterized bytes uploaded into atlas textures per
+// frame - remaining results stay queued until the next frame
+#define F_RASTER_UPLOAD_BUDGET_BYTES_PER_FRAME KB(512)
+
+// rjf: run cache limits - runs are only evicted once no longer referenced by
+// the last two frames, so the count is a soft cap
+#define F_RUN_CACHE_MAX_COUNT 16384
+#define F_RUN_CACHE_MAX_STRING_SIZE 4096
+#define F_RUN_CACHE_BLOCK_SIZE_CLASS_COUNT 14
+
 ////////////////////////////////
 //~ rjf: Main State Type
 
@@ -205,6 +291,41 @@ struct F_State
   // rjf: atlas list
   F_Atlas *first_atlas;
   F_Atlas *last_atlas;
+  
+  // rjf: frame counter
+  U64 frame_idx;
+  
+  // rjf: shaped run cache
+  U64 run_cache_slots_count;
+  F_RunCacheSlot *run_cache_slots;
+  F_RunCacheNode *run_cache_lru_first;
+  F_RunCacheNode *run_cache_lru_last;
+  U64 run_cache_count;
+  F_RunCacheNode *run_cache_free_node;
+  F_RunCacheFreeBlock *run_cache_free_blocks[F_RUN_CACHE_BLOCK_SIZE_CLASS_COUNT];
+  
+  // rjf: user -> raster thread ring
+  U64 u2r_ring_size;
+  U8 *u2r_ring_base;
+  U64 u2r_ring_write_pos;
+  U64 u2r_ring_read_pos;
+  OS_Handle u2r_ring_cv;
+  OS_Handle u2r_ring_mutex;
+  
+  // rjf: raster thread -> user ring
+  U64 r2u_ring_size;
+  U8 *r2u_ring_base;
+  U64 r2u_ring_write_pos;
+  U64 r2u_ring_read_pos;
+  OS_Handle r2u_ring_cv;
+  OS_Handle r2u_ring_mutex;
+  
+  // rjf: raster threads
+  U64 raster_thread_count;
+  OS_Handle *raster_threads;
+  
+  // rjf: user-thread-only accounting of in-flight rasterizations
+  U64 raster_pending_count;
 };
 
 ////////////////////////////////
@@ -235,6 +356,7 @@ internal String8 f_path_from_tag(F_Tag tag);
 
 internal Rng2S16 f_atlas_region_alloc(Arena *arena, F_Atlas *atlas, Vec2S16 needed_size);
 internal void f_atlas_region_release(F_Atlas *atlas, Rng2S16 region);
+internal Rng2S16 f_atlas_region_alloc_and_fill(Vec2S16 raster_dim, void *raster_data, S16 *atlas_num_out);
 
 ////////////////////////////////
 //~ rjf: Piece Type Functions
@@ -247,7 +369,11 @@ internal F_PieceArray f_piece_array_copy(Arena *arena, F_PieceArray *src);
 ////////////////////////////////
 //~ rjf: Rasterization Cache
 
+internal U64 f_style_hash_from_tag_size(F_Tag tag, F32 size);
+internal F_Hash2StyleRasterCacheNode *f_hash2style_from_style_hash(U64 style_hash);
 internal F_Hash2StyleRasterCacheNode *f_hash2style_from_tag_size(F_Tag tag, F32 size);
+internal F_RasterCacheInfo *f_raster_cache_info_from_style_piece(F_Hash2StyleRasterCacheNode *hash2style_node, U64 piece_hash, String8 piece_substring);
+internal F_Run f_push_run_from_string__pending_out(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, String8 string, B32 *pending_out);
 internal F_Run f_push_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, String8 string);
 internal String8List f_wrapped_string_lines_from_font_size_string_max(Arena *arena, F_Tag font, F32 size, F32 base_align_px, F32 tab_size_px, String8 string, F32 max);
 internal Vec2F32 f_dim_from_tag_size_string(F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, String8 string);
@@ -255,15 +381,38 @@ internal Vec2F32 f_dim_from_tag_size_string_list(F_Tag tag, F32 size, F32 base_a
 internal F32 f_column_size_from_tag_size(F_Tag tag, F32 size);
 internal U64 f_char_pos_from_tag_size_string_p(F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, String8 string, F32 p);
 
+////////////////////////////////
+//~ rjf: Run Cache
+//
+// (cached runs are owned by the cache & stay valid for at least the next two
+// frames - copy pieces to keep them for longer. `arena` is only used for runs
+// which can't be cached, e.g. ones with glyphs still rasterizing)
+
+internal U64 f_run_cache_hash_from_string(String8 string);
+internal F_Run f_push_cached_run_from_string_hash(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, U64 string_hash, String8 string);
+internal F_Run f_push_cached_run_from_string(Arena *arena, F_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F_RunFlags flags, String8 string);
+internal void f_run_cache_evict(void);
+
 ////////////////////////////////
 //~ rjf: Metrics
 
 internal F_Metrics f_metrics_from_tag_size(F_Tag tag, F32 size);
 internal F32 f_line_height_from_metrics(F_Metrics *metrics);
 
+////////////////////////////////
+//~ rjf: Asynchronous Rasterization
+
+internal B32 f_u2r_enqueue_req(U64 style_hash, U64 piece_hash, FP_Handle font, F32 size, String8 piece_substring, U64 endt_us);
+internal void f_u2r_dequeue_req(Arena *arena, U64 *style_hash_out, U64 *piece_hash_out, FP_Handle *font_out, F32 *size_out, String8 *piece_substring_out);
+internal void f_r2u_push_result(F_RasterResult *result);
+internal F_RasterResultList f_r2u_pop_results(Arena *arena, U64 budget_bytes);
+internal void f_raster_thread__entry_point(void *p);
+internal U64 f_pending_raster_count(void);
+
 ////////////////////////////////
 //~ rjf: Main Calls
 
 internal void f_init(void);
+internal void f_begin_frame(void);
 
 #endif // FONT_CACHE_H
@@ -297,6 +297,34 @@ fp_metrics_from_font(FP_Handle handle)
   return result;
 }
 
+fp_hook F32
+fp_advance_from_font_size_string(FP_Handle font_handle, F32 size, String8 string)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  String32 string32 = str32_from_8(scratch.arena, string);
+  FP_DWrite_Font font = fp_dwrite_font_from_handle(font_handle);
+  F32 advance = 0;
+  if(font.face != 0)
+  {
+    DWRITE_FONT_METRICS font_metrics = {0};
+    IDWriteFontFace_GetMetrics(font.face, &font_metrics);
+    F32 design_units_per_em = (F32)font_metrics.designUnitsPerEm;
+    U64 glyphs_count = string32.size;
+    U16 *glyph_indices = push_array_no_zero(scratch.arena, U16, glyphs_count);
+    DWRITE_GLYPH_METRICS *glyphs_metrics = push_array_no_zero(scratch.arena, DWRITE_GLYPH_METRICS, glyphs_count);
+    IDWriteFontFace_GetGlyphIndices(font.face, string32.str, string32.size, glyph_indices);
+    IDWriteFontFace_GetGdiCompatibleGlyphMetrics(font.face, (96.f/72.f)*size, 1.f, 0, 1, glyph_indices, glyphs_count, glyphs_metrics, 0);
+    for(U64 idx = 0; idx < glyphs_count; idx += 1)
+    {
+      advance += (96.f/72.f) * size * glyphs_metrics[idx].advanceWidth / design_units_per_em;
+    }
+  }
+  scratch_end(scratch);
+  ProfEnd();
+  return advance;
+}
+
 fp_hook NO_ASAN FP_RasterResult
 fp_raster(Arena *arena, FP_Handle font_handle, F32 size, FP_RasterMode mode, String8 string)
 {
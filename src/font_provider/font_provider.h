@@ -56,6 +56,7 @@ fp_hook FP_Handle fp_font_open(String8 path);
 fp_hook FP_Handle fp_font_open_from_static_data_string(String8 *data_ptr);
 fp_hook void fp_font_close(FP_Handle handle);
 fp_hook FP_Metrics fp_metrics_from_font(FP_Handle font);
+fp_hook F32 fp_advance_from_font_size_string(FP_Handle font, F32 size, String8 string);
 fp_hook NO_ASAN FP_RasterResult fp_raster(Arena *arena, FP_Handle font, F32 size, FP_RasterMode mode, String8 string);
 
 #endif // FONT_PROVIDER_H
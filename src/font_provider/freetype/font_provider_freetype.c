@@ -6,6 +6,9 @@
 
 internal FT_Library freetype_instance = NULL;
 internal Arena* freetype_arena = NULL;
+// NOTE: FT_Face glyph slots are not thread safe, rasterization is
+// serialized so the font cache can raster from its worker threads.
+internal OS_Handle freetype_raster_mutex = {0};
 
 FreeType_FontFace
 freetype_face_from_handle(FP_Handle face)
@@ -26,6 +29,7 @@ fp_init(void)
 {
   // NOTE: There is an alternative function to manage memory manually with freetype
   freetype_arena = arena_alloc();
+  freetype_raster_mutex = os_mutex_alloc();
   FT_Init_FreeType(&freetype_instance);
 }
 
@@ -125,6 +129,10 @@ fp_metrics_from_font(FP_Handle font)
   TT_Header* header_tt = (TT_Header*)FT_Get_Sfnt_Table(face,  FT_SFNT_HEAD);
   TT_OS2* header_os2 = (TT_OS2*)FT_Get_Sfnt_Table(face,  FT_SFNT_OS2);
   AssertAlways(header_os2 != NULL);
+  if (header_tt != NULL)
+  {
+    result.design_units_per_em = (F32)header_tt->Units_Per_EM;
+  }
   result.ascent = header_os2->sTypoAscender;
   result.descent = header_os2->sTypoDescender;
   result.line_gap = header_os2->sTypoLineGap;
@@ -133,6 +141,19 @@ fp_metrics_from_font(FP_Handle font)
   return result;
 }
 
+fp_hook F32
+fp_advance_from_font_size_string(FP_Handle font, F32 size, String8 string)
+{
+  // NOTE: Mirrors the advance calculation in fp_raster, only reads
+  // immutable face data so it's safe to call alongside rasterization
+  F32 result = 0;
+  FreeType_FontFace face = freetype_face_from_handle(font);
+  if (face == 0 || face->units_per_EM == 0) { return result; }
+  F32 glyph_advance_width = (face->max_advance_width * (96.f/72.f) * size) / face->units_per_EM;
+  result = glyph_advance_width * string.size;
+  return result;
+}
+
 fp_hook NO_ASAN
 FP_RasterResult
 fp_raster(Arena *arena,
@@ -150,7 +171,8 @@ fp_raster(Arena *arena,
   FreeType_FontFace face = freetype_face_from_handle(font);
   if (face == 0) { return result; }
 
-  Temp scratch = scratch_begin(0, 0);
+  os_mutex_take(freetype_raster_mutex);
+  Temp scratch = scratch_begin(&arena, 1);
   U32* charmap_indices = push_array(scratch.arena, U32, 4+ string.size);
   F32 win32_magic_dimensions = (96.f/72.f);
   // Error counting
@@ -254,6 +276,7 @@ fp_raster(Arena *arena,
 
   } else { ++null_errors; }
   scratch_end(scratch);
+  os_mutex_drop(freetype_raster_mutex);
 
   return result;
 }
@@ -10,7 +10,7 @@
 #ifndef RDI_FORMAT_C
 #define RDI_FORMAT_C
 
-RDI_U16 rdi_section_element_size_table[37] =
+RDI_U16 rdi_section_element_size_table[44] =
 {
 sizeof(RDI_U8),
 sizeof(RDI_TopLevelInfo),
@@ -48,10 +48,17 @@ sizeof(RDI_U8),
 sizeof(RDI_NameMap),
 sizeof(RDI_NameMapBucket),
 sizeof(RDI_NameMapNode),
+sizeof(RDI_U32),
+sizeof(RDI_U32),
+sizeof(RDI_U32),
+sizeof(RDI_NameMap),
+sizeof(RDI_NameMap),
+sizeof(RDI_NameMapBucket),
+sizeof(RDI_NameMapNode),
 sizeof(RDI_U8),
 };
 
-RDI_U8 rdi_section_is_required_table[37] =
+RDI_U8 rdi_section_is_required_table[44] =
 {
 0,
 0,
@@ -90,6 +97,13 @@ RDI_U8 rdi_section_is_required_table[37] =
 0,
 0,
 0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
 };
 
 RDI_U8 rdi_eval_op_ctrlbits_table[45] =
@@ -52,7 +52,11 @@ typedef int64_t  RDI_S64;
 
 // \"raddbg\0\0\"
 #define RDI_MAGIC_CONSTANT   0x0000676264646172
-#define RDI_ENCODING_VERSION 7
+#define RDI_ENCODING_VERSION 8
+
+// vmap page directories: entry N = index of the vmap entry containing
+// voff (N << RDI_VMAP_PAGE_SIZE_LOG2)
+#define RDI_VMAP_PAGE_SIZE_LOG2 12
 
 ////////////////////////////////////////////////////////////////
 //~ Format Types & Functions
@@ -96,7 +100,14 @@ RDI_SectionKind_LocationData         = 0x0020,
 RDI_SectionKind_NameMaps             = 0x0021,
 RDI_SectionKind_NameMapBuckets       = 0x0022,
 RDI_SectionKind_NameMapNodes         = 0x0023,
-RDI_SectionKind_COUNT                = 0x0024,
+RDI_SectionKind_UnitVMapPages        = 0x0024,
+RDI_SectionKind_GlobalVMapPages      = 0x0025,
+RDI_SectionKind_ScopeVMapPages       = 0x0026,
+RDI_SectionKind_ScopeLocalNameMaps   = 0x0027,
+RDI_SectionKind_UDTMemberNameMaps    = 0x0028,
+RDI_SectionKind_NestedNameMapBuckets = 0x0029,
+RDI_SectionKind_NestedNameMapNodes   = 0x002A,
+RDI_SectionKind_COUNT                = 0x002B,
 } RDI_SectionKindEnum;
 
 typedef RDI_U32 RDI_SectionEncoding;
@@ -537,6 +548,13 @@ X(LocationData, location_data, RDI_U8)\
 X(NameMaps, name_maps, RDI_NameMap)\
 X(NameMapBuckets, name_map_buckets, RDI_NameMapBucket)\
 X(NameMapNodes, name_map_nodes, RDI_NameMapNode)\
+X(UnitVMapPages, unit_vmap_pages, RDI_U32)\
+X(GlobalVMapPages, global_vmap_pages, RDI_U32)\
+X(ScopeVMapPages, scope_vmap_pages, RDI_U32)\
+X(ScopeLocalNameMaps, scope_local_name_maps, RDI_NameMap)\
+X(UDTMemberNameMaps, udt_member_name_maps, RDI_NameMap)\
+X(NestedNameMapBuckets, nested_name_map_buckets, RDI_NameMapBucket)\
+X(NestedNameMapNodes, nested_name_map_nodes, RDI_NameMapNode)\
 
 #define RDI_SectionEncoding_XList \
 X(Unpacked)\
@@ -900,6 +918,7 @@ X(RDI_U32, node_count)\
 X(RDI_U32, string_idx)\
 X(RDI_U32, match_count)\
 X(RDI_U32, match_idx_or_idx_run_first)\
+X(RDI_U32, hash_tag)\
 
 #if !RDI_DISABLE_TABLE_INDEX_TYPECHECKING
 typedef struct RDI_U32_StringTable                 { RDI_U32 v; } RDI_U32_StringTable;
@@ -1284,6 +1303,7 @@ struct RDI_NameMapNode
 RDI_U32 string_idx;
 RDI_U32 match_count;
 RDI_U32 match_idx_or_idx_run_first;
+RDI_U32 hash_tag;
 };
 
 typedef RDI_TopLevelInfo                 RDI_SectionElementType_TopLevelInfo;
@@ -1321,6 +1341,13 @@ typedef RDI_U8                           RDI_SectionElementType_LocationData;
 typedef RDI_NameMap                      RDI_SectionElementType_NameMaps;
 typedef RDI_NameMapBucket                RDI_SectionElementType_NameMapBuckets;
 typedef RDI_NameMapNode                  RDI_SectionElementType_NameMapNodes;
+typedef RDI_U32                          RDI_SectionElementType_UnitVMapPages;
+typedef RDI_U32                          RDI_SectionElementType_GlobalVMapPages;
+typedef RDI_U32                          RDI_SectionElementType_ScopeVMapPages;
+typedef RDI_NameMap                      RDI_SectionElementType_ScopeLocalNameMaps;
+typedef RDI_NameMap                      RDI_SectionElementType_UDTMemberNameMaps;
+typedef RDI_NameMapBucket                RDI_SectionElementType_NestedNameMapBuckets;
+typedef RDI_NameMapNode                  RDI_SectionElementType_NestedNameMapNodes;
 
 RDI_PROC RDI_U64 rdi_hash(RDI_U8 *ptr, RDI_U64 size);
 RDI_PROC RDI_U32 rdi_size_from_basic_type_kind(RDI_TypeKind kind);
@@ -1329,8 +1356,8 @@ RDI_PROC RDI_EvalConversionKind rdi_eval_conversion_kind_from_typegroups(RDI_Eva
 RDI_PROC RDI_S32 rdi_eval_op_typegroup_are_compatible(RDI_EvalOp op, RDI_EvalTypeGroup group);
 RDI_PROC RDI_U8 *rdi_explanation_string_from_eval_conversion_kind(RDI_EvalConversionKind kind, RDI_U64 *size_out);
 
-extern RDI_U16 rdi_section_element_size_table[37];
-extern RDI_U8 rdi_section_is_required_table[37];
+extern RDI_U16 rdi_section_element_size_table[44];
+extern RDI_U8 rdi_section_is_required_table[44];
 extern RDI_U8 rdi_eval_op_ctrlbits_table[45];
 
 #endif // RDI_FORMAT_H
@@ -44,6 +44,13 @@ rdi_parse(RDI_U8 *data, RDI_U64 size, RDI_Parsed *out)
       dsecs = (RDI_Section*)(data + hdr->data_section_off);
       dsec_count = hdr->data_section_count;
     }
+    for(RDI_U32 idx = 0; dsecs != 0 && idx < dsec_count; idx += 1)
+    {
+      if(dsecs[idx].off > size || dsecs[idx].encoded_size > size - dsecs[idx].off)
+      {
+        dsecs = 0;
+      }
+    }
     if(dsecs == 0)
     {
       result = RDI_ParseStatus_InvalidDataSecionLayout;
@@ -82,6 +89,18 @@ rdi_parse(RDI_U8 *data, RDI_U64 size, RDI_Parsed *out)
     }
   }
   
+  //////////////////////////////
+  //- rjf: parse name maps up front; lookups hit these constantly
+  //
+  if(result == RDI_ParseStatus_Good)
+  {
+    for(RDI_NameMapKind k = (RDI_NameMapKind)(RDI_NameMapKind_NULL+1); k < RDI_NameMapKind_COUNT; k = (RDI_NameMapKind)(k+1))
+    {
+      RDI_NameMap *mapptr = rdi_element_from_name_idx(out, NameMaps, k);
+      rdi_parsed_from_name_map(out, mapptr, &out->name_maps[k]);
+    }
+  }
+  
   return result;
 }
 
@@ -161,7 +180,7 @@ rdi_string_from_idx(RDI_Parsed *rdi, RDI_U32 idx, RDI_U64 *len_out)
   {
     RDI_U64 string_offs_count = 0;
     RDI_U32 *string_offs = rdi_table_from_name(rdi, StringTable, &string_offs_count);
-    if(idx < string_offs_count)
+    if(idx+1 < string_offs_count)
     {
       RDI_U64 string_data_size = 0;
       RDI_U8 *string_data = rdi_table_from_name(rdi, StringData, &string_data_size);
@@ -237,32 +256,21 @@ rdi_line_info_idx_range_from_voff(RDI_ParsedLineTable *line_info, RDI_U64 voff,
   RDI_U64 n = 0;
   if(line_info->count > 0 && line_info->voffs[0] <= voff && voff < line_info->voffs[line_info->count - 1])
   {
-    //- rjf: find i such that: (vmap[i].voff <= voff) && (voff < vmap[i + 1].voff)
-    // assuming: (i < j) -> (vmap[i].voff < vmap[j].voff)
-    RDI_U32 first = 0;
-    RDI_U32 opl   = line_info->count;
-    for(;;)
+    //- rjf: find last i such that: (voffs[i] <= voff)
+    // assuming: (i < j) -> (voffs[i] <= voffs[j])
+    //
+    // NOTE: branchless - the range only shrinks by a data-dependent
+    // select, which compiles to a cmov, so there are no mispredicted branches
+    // on random lookups
+    RDI_U64 *base = line_info->voffs;
+    RDI_U64 n = line_info->count;
+    for(;n > 1;)
     {
-      RDI_U32 mid = (first + opl)/2;
-      if(line_info->voffs[mid] < voff)
-      {
-        first = mid;
-      }
-      else if(line_info->voffs[mid] > voff)
-      {
-        opl = mid;
-      }
-      else
-      {
-        first = mid;
-        break;
-      }
-      if(opl - first <= 1)
-      {
-        break;
-      }
+      RDI_U64 half = n/2;
+      base = (base[half] <= voff) ? base + half : base;
+      n -= half;
     }
-    result = (RDI_U64)first;
+    result = (RDI_U64)(base - line_info->voffs);
     
     //- rjf: scan leftward, to find shallowest line info matching this voff
     for(;result != 0;)
@@ -405,38 +413,58 @@ rdi_line_voffs_from_num(RDI_ParsedSourceLineMap *map, RDI_U32 linenum, RDI_U32 *
 
 //- vmap lookups
 
+RDI_PROC RDI_U64
+rdi_vmap_pos_from_voff_range(RDI_VMapEntry *vmap, RDI_U64 first, RDI_U64 opl, RDI_U64 voff)
+{
+  // assuming: (i < j) -> (vmap[i].voff <= vmap[j].voff), (vmap[first].voff <= voff)
+  // find last i in [first, opl) such that: (vmap[i].voff <= voff)
+  RDI_VMapEntry *base = vmap + first;
+  RDI_U64 n = opl - first;
+  for(;n > 1;)
+  {
+    RDI_U64 half = n/2;
+    base = (base[half].voff <= voff) ? base + half : base;
+    n -= half;
+  }
+  RDI_U64 result = (RDI_U64)(base - vmap);
+  return result;
+}
+
 RDI_PROC RDI_U64
 rdi_vmap_idx_from_voff(RDI_VMapEntry *vmap, RDI_U64 vmap_count, RDI_U64 voff)
 {
   RDI_U64 result = 0;
   if(vmap_count > 0 && vmap[0].voff <= voff && voff < vmap[vmap_count - 1].voff)
   {
-    // assuming: (i < j) -> (vmap[i].voff < vmap[j].voff)
-    // find i such that: (vmap[i].voff <= voff) && (voff < vmap[i + 1].voff)
-    RDI_U32 first = 0;
-    RDI_U32 opl   = vmap_count;
-    for(;;)
+    RDI_U64 pos = rdi_vmap_pos_from_voff_range(vmap, 0, vmap_count - 1, voff);
+    result = (RDI_U64)vmap[pos].idx;
+  }
+  return result;
+}
+
+RDI_PROC RDI_U64
+rdi_vmap_idx_from_voff_pages(RDI_VMapEntry *vmap, RDI_U64 vmap_count, RDI_U32 *pages, RDI_U64 pages_count, RDI_U64 voff)
+{
+  RDI_U64 result = 0;
+  if(vmap_count > 0 && vmap[0].voff <= voff && voff < vmap[vmap_count - 1].voff)
+  {
+    // rjf: narrow search to the entries between this voff's page & the next;
+    // fall back to the whole vmap if the directory doesn't cover this voff
+    RDI_U64 first = 0;
+    RDI_U64 opl = vmap_count - 1;
+    RDI_U64 page_idx = voff >> RDI_VMAP_PAGE_SIZE_LOG2;
+    if(page_idx + 1 < pages_count)
     {
-      RDI_U32 mid = (first + opl)/2;
-      if(vmap[mid].voff < voff)
+      RDI_U64 page_first = pages[page_idx];
+      RDI_U64 page_last = pages[page_idx + 1];
+      if(page_first <= page_last && page_last < vmap_count - 1 && vmap[page_first].voff <= voff)
       {
-        first = mid;
-      }
-      else if(vmap[mid].voff > voff)
-      {
-        opl = mid;
-      }
-      else
-      {
-        first = mid;
-        break;
-      }
-      if(opl - first <= 1)
-      {
-        break;
+        first = page_first;
+        opl = page_last + 1;
       }
     }
-    result = (RDI_U64)vmap[first].idx;
+    RDI_U64 pos = rdi_vmap_pos_from_voff_range(vmap, first, opl, voff);
+    result = (RDI_U64)vmap[pos].idx;
   }
   return result;
 }
@@ -446,7 +474,21 @@ rdi_vmap_idx_from_section_kind_voff(RDI_Parsed *rdi, RDI_SectionKind kind, RDI_U
 {
   RDI_U64 vmaps_count = 0;
   RDI_VMapEntry *vmaps = rdi_section_raw_table_from_kind(rdi, kind, &vmaps_count);
-  RDI_U64 result = rdi_vmap_idx_from_voff(vmaps, vmaps_count, voff);
+  RDI_SectionKind pages_kind = RDI_SectionKind_NULL;
+  switch(kind)
+  {
+    default:{}break;
+    case RDI_SectionKind_UnitVMap:  {pages_kind = RDI_SectionKind_UnitVMapPages;}break;
+    case RDI_SectionKind_GlobalVMap:{pages_kind = RDI_SectionKind_GlobalVMapPages;}break;
+    case RDI_SectionKind_ScopeVMap: {pages_kind = RDI_SectionKind_ScopeVMapPages;}break;
+  }
+  RDI_U64 pages_count = 0;
+  RDI_U32 *pages = 0;
+  if(pages_kind != RDI_SectionKind_NULL && pages_kind < rdi->sections_count)
+  {
+    pages = rdi_section_raw_table_from_kind(rdi, pages_kind, &pages_count);
+  }
+  RDI_U64 result = rdi_vmap_idx_from_voff_pages(vmaps, vmaps_count, pages, pages_count, voff);
   return result;
 }
 
@@ -480,46 +522,105 @@ rdi_parsed_from_name_map(RDI_Parsed *rdi, RDI_NameMap *mapptr, RDI_ParsedNameMap
   }
 }
 
+RDI_PROC void
+rdi_parsed_from_nested_name_map(RDI_Parsed *rdi, RDI_NameMap *mapptr, RDI_ParsedNameMap *out)
+{
+  out->buckets = 0;
+  out->nodes = 0;
+  out->bucket_count = 0;
+  out->node_count = 0;
+  if(mapptr != 0)
+  {
+    RDI_U64 all_buckets_count = 0;
+    RDI_NameMapBucket *all_buckets = rdi_table_from_name(rdi, NestedNameMapBuckets, &all_buckets_count);
+    RDI_U64 all_nodes_count = 0;
+    RDI_NameMapNode *all_nodes = rdi_table_from_name(rdi, NestedNameMapNodes, &all_nodes_count);
+    if((RDI_U64)mapptr->bucket_base_idx + mapptr->bucket_count <= all_buckets_count &&
+       (RDI_U64)mapptr->node_base_idx + mapptr->node_count <= all_nodes_count)
+    {
+      out->buckets = all_buckets+mapptr->bucket_base_idx;
+      out->nodes = all_nodes+mapptr->node_base_idx;
+      out->bucket_count = mapptr->bucket_count;
+      out->node_count = mapptr->node_count;
+    }
+  }
+}
+
+RDI_PROC RDI_ParsedNameMap *
+rdi_parsed_name_map_from_kind(RDI_Parsed *p, RDI_NameMapKind kind)
+{
+  RDI_ParsedNameMap *result = &p->name_maps[RDI_NameMapKind_NULL];
+  if(kind < RDI_NameMapKind_COUNT)
+  {
+    result = &p->name_maps[kind];
+  }
+  return result;
+}
+
 RDI_PROC RDI_NameMapNode*
 rdi_name_map_lookup(RDI_Parsed *p, RDI_ParsedNameMap *map, RDI_U8 *str, RDI_U64 len)
 {
   RDI_NameMapNode *result = 0;
-  if(map->bucket_count > 0)
-  {
-    RDI_NameMapBucket *buckets = map->buckets;
-    RDI_U64 bucket_count = map->bucket_count;
-    RDI_U64 hash = rdi_hash(str, len);
-    RDI_U64 bucket_index = hash%bucket_count;
-    RDI_NameMapBucket *bucket = map->buckets + bucket_index;
-    RDI_NameMapNode *node = map->nodes + bucket->first_node;
-    RDI_NameMapNode *node_opl = node + bucket->node_count;
-    for(;node < node_opl; node += 1)
+  rdi_name_map_lookup_batch(p, map, &str, &len, 1, &result);
+  return result;
+}
+
+RDI_PROC void
+rdi_name_map_lookup_batch(RDI_Parsed *p, RDI_ParsedNameMap *map, RDI_U8 **strs, RDI_U64 *lens, RDI_U64 count, RDI_NameMapNode **nodes_out)
+{
+  RDI_U64 string_offs_count = 0;
+  RDI_U32 *string_offs = rdi_table_from_name(p, StringTable, &string_offs_count);
+  RDI_U64 string_data_size = 0;
+  RDI_U8 *string_data = rdi_table_from_name(p, StringData, &string_data_size);
+  for(RDI_U64 idx = 0; idx < count; idx += 1)
+  {
+    RDI_U8 *str = strs[idx];
+    RDI_U64 len = lens[idx];
+    RDI_NameMapNode *result = 0;
+    if(map->bucket_count > 0)
     {
-      // extract a string from this node
-      RDI_U64 nlen = 0;
-      RDI_U8 *nstr = rdi_string_from_idx(p, node->string_idx, &nlen);
-      
-      // compare this to the needle string
-      RDI_S32 match = 0;
-      if(nlen == len)
-      {
-        RDI_U8 *a = str;
-        RDI_U8 *aopl = str + len;
-        RDI_U8 *b = nstr;
-        for (;a < aopl && *a == *b; a += 1, b += 1);
-        match = (a == aopl);
-      }
-      
-      // stop with a matching node in result
-      if(match)
+      RDI_U64 hash = rdi_hash(str, len);
+      RDI_U32 hash_tag = (RDI_U32)hash;
+      RDI_U64 bucket_index = hash%map->bucket_count;
+      RDI_NameMapBucket *bucket = map->buckets + bucket_index;
+      RDI_NameMapNode *node = map->nodes + bucket->first_node;
+      RDI_NameMapNode *node_opl = node + bucket->node_count;
+      for(;node < node_opl; node += 1)
       {
-        result = node;
-        break;
+        // skip nodes w/ mismatching hash tags, without touching their strings
+        if(node->hash_tag != hash_tag || node->string_idx+1 >= string_offs_count)
+        {
+          continue;
+        }
+        
+        // extract a string from this node
+        RDI_U32 off = string_offs[node->string_idx];
+        RDI_U32 opl = rdi_parse__min(string_offs[node->string_idx+1], string_data_size);
+        RDI_U64 nlen = (off <= opl) ? opl - off : 0;
+        RDI_U8 *nstr = string_data + off;
+        
+        // compare this to the needle string
+        RDI_S32 match = 0;
+        if(nlen == len)
+        {
+          RDI_U8 *a = str;
+          RDI_U8 *aopl = str + len;
+          RDI_U8 *b = nstr;
+          for(;a+8 <= aopl && rdi_u64_from_unaligned(a) == rdi_u64_from_unaligned(b); a += 8, b += 8);
+          for(;a < aopl && *a == *b; a += 1, b += 1);
+          match = (a == aopl);
+        }
+        
+        // stop with a matching node in result
+        if(match)
+        {
+          result = node;
+          break;
+        }
       }
-      
     }
+    nodes_out[idx] = result;
   }
-  return result;
 }
 
 RDI_PROC RDI_U32*
@@ -550,10 +651,8 @@ rdi_matches_from_map_node(RDI_Parsed *p, RDI_NameMapNode *node, RDI_U32 *n_out)
 RDI_PROC RDI_Procedure *
 rdi_procedure_from_name(RDI_Parsed *rdi, RDI_U8 *name, RDI_U64 name_size)
 {
-  RDI_NameMap *map = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_Procedures);
-  RDI_ParsedNameMap map_parsed = {0};
-  rdi_parsed_from_name_map(rdi, map, &map_parsed);
-  RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map_parsed, name, name_size);
+  RDI_ParsedNameMap *map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_Procedures);
+  RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, name, name_size);
   RDI_U32 id_count = 0;
   RDI_U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
   RDI_U32 procedure_idx = 0;
@@ -642,6 +741,90 @@ rdi_procedure_from_scope(RDI_Parsed *rdi, RDI_Scope *scope)
   return procedure;
 }
 
+RDI_PROC RDI_U32
+rdi_local_idx_from_scope_name(RDI_Parsed *rdi, RDI_U32 scope_idx, RDI_U8 *name, RDI_U64 name_size)
+{
+  RDI_U32 result = 0;
+  RDI_U64 maps_count = 0;
+  RDI_NameMap *maps = rdi_table_from_name(rdi, ScopeLocalNameMaps, &maps_count);
+  if(RDI_SectionKind_ScopeLocalNameMaps < rdi->sections_count && scope_idx < maps_count)
+  {
+    // baked per-scope map -> direct probe
+    RDI_ParsedNameMap map = {0};
+    rdi_parsed_from_nested_name_map(rdi, &maps[scope_idx], &map);
+    RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name, name_size);
+    if(node != 0)
+    {
+      result = node->match_idx_or_idx_run_first;
+    }
+  }
+  else
+  {
+    // no baked map -> scan scope's locals
+    RDI_Scope *scope = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
+    for(RDI_U32 local_idx = scope->local_first; local_idx < scope->local_first+scope->local_count; local_idx += 1)
+    {
+      RDI_Local *local = rdi_element_from_name_idx(rdi, Locals, local_idx);
+      RDI_U64 local_name_size = 0;
+      RDI_U8 *local_name = rdi_string_from_idx(rdi, local->name_string_idx, &local_name_size);
+      if(rdi_string_match(local_name, local_name_size, name, name_size))
+      {
+        result = local_idx;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+//- udts
+
+RDI_PROC RDI_U32
+rdi_member_idx_from_udt_name(RDI_Parsed *rdi, RDI_U32 udt_idx, RDI_U8 *name, RDI_U64 name_size)
+{
+  RDI_U32 result = 0;
+  RDI_U64 maps_count = 0;
+  RDI_NameMap *maps = rdi_table_from_name(rdi, UDTMemberNameMaps, &maps_count);
+  if(RDI_SectionKind_UDTMemberNameMaps < rdi->sections_count && udt_idx < maps_count)
+  {
+    // baked per-udt map -> direct probe
+    RDI_ParsedNameMap map = {0};
+    rdi_parsed_from_nested_name_map(rdi, &maps[udt_idx], &map);
+    RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map, name, name_size);
+    if(node != 0)
+    {
+      result = node->match_idx_or_idx_run_first;
+    }
+  }
+  else
+  {
+    // no baked map -> scan udt's members (or enum members)
+    RDI_UDT *udt = rdi_element_from_name_idx(rdi, UDTs, udt_idx);
+    for(RDI_U32 member_idx = udt->member_first; member_idx < udt->member_first+udt->member_count; member_idx += 1)
+    {
+      RDI_U32 member_name_string_idx = 0;
+      if(udt->flags & RDI_UDTFlag_EnumMembers)
+      {
+        RDI_EnumMember *member = rdi_element_from_name_idx(rdi, EnumMembers, member_idx);
+        member_name_string_idx = member->name_string_idx;
+      }
+      else
+      {
+        RDI_Member *member = rdi_element_from_name_idx(rdi, Members, member_idx);
+        member_name_string_idx = member->name_string_idx;
+      }
+      RDI_U64 member_name_size = 0;
+      RDI_U8 *member_name = rdi_string_from_idx(rdi, member_name_string_idx, &member_name_size);
+      if(rdi_string_match(member_name, member_name_size, name, name_size))
+      {
+        result = member_idx;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 //- units
 
 RDI_PROC RDI_Unit *
@@ -696,10 +879,8 @@ rdi_source_file_from_line(RDI_Parsed *rdi, RDI_Line *line)
 RDI_PROC RDI_SourceFile *
 rdi_source_file_from_normal_path(RDI_Parsed *rdi, RDI_U8 *name, RDI_U64 name_size)
 {
-  RDI_NameMap *map = rdi_element_from_name_idx(rdi, NameMaps, RDI_NameMapKind_NormalSourcePaths);
-  RDI_ParsedNameMap map_parsed = {0};
-  rdi_parsed_from_name_map(rdi, map, &map_parsed);
-  RDI_NameMapNode *node = rdi_name_map_lookup(rdi, &map_parsed, name, name_size);
+  RDI_ParsedNameMap *map = rdi_parsed_name_map_from_kind(rdi, RDI_NameMapKind_NormalSourcePaths);
+  RDI_NameMapNode *node = rdi_name_map_lookup(rdi, map, name, name_size);
   RDI_U32 id_count = 0;
   RDI_U32 *ids = rdi_matches_from_map_node(rdi, node, &id_count);
   RDI_U32 file_idx = 0;
@@ -788,3 +969,27 @@ rdi_cstring_length(char *cstr)
   for(;cstr[result] != 0; result += 1){}
   return result;
 }
+
+RDI_PROC RDI_S32
+rdi_string_match(RDI_U8 *a, RDI_U64 a_size, RDI_U8 *b, RDI_U64 b_size)
+{
+  RDI_S32 result = (a_size == b_size);
+  for(RDI_U64 idx = 0; result && idx < a_size; idx += 1)
+  {
+    result = (a[idx] == b[idx]);
+  }
+  return result;
+}
+
+RDI_PROC RDI_U64
+rdi_u64_from_unaligned(RDI_U8 *ptr)
+{
+  // NOTE: assembled from bytes, rather than loaded through an RDI_U64
+  // pointer, so that unaligned string data is read legally; compilers fold
+  // this into a single load.
+  RDI_U64 result = ((RDI_U64)ptr[0] <<  0 | (RDI_U64)ptr[1] <<  8 |
+                    (RDI_U64)ptr[2] << 16 | (RDI_U64)ptr[3] << 24 |
+                    (RDI_U64)ptr[4] << 32 | (RDI_U64)ptr[5] << 40 |
+                    (RDI_U64)ptr[6] << 48 | (RDI_U64)ptr[7] << 56);
+  return result;
+}
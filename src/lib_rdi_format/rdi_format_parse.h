@@ -54,6 +54,15 @@ typedef enum RDI_ParseStatus
 }
 RDI_ParseStatus;
 
+typedef struct RDI_ParsedNameMap RDI_ParsedNameMap;
+struct RDI_ParsedNameMap
+{
+  RDI_NameMapBucket *buckets;
+  RDI_NameMapNode *nodes;
+  RDI_U64 bucket_count;
+  RDI_U64 node_count;
+};
+
 typedef struct RDI_Parsed RDI_Parsed;
 struct RDI_Parsed
 {
@@ -61,6 +70,7 @@ struct RDI_Parsed
   RDI_U64 raw_data_size;
   RDI_Section *sections;
   RDI_U64 sections_count;
+  RDI_ParsedNameMap name_maps[RDI_NameMapKind_COUNT]; // NOTE: filled by rdi_parse
 };
 
 typedef struct RDI_ParsedLineTable RDI_ParsedLineTable;
@@ -95,15 +105,6 @@ struct RDI_ParsedSourceLineMap
   RDI_U64 voff_count;
 };
 
-typedef struct RDI_ParsedNameMap RDI_ParsedNameMap;
-struct RDI_ParsedNameMap
-{
-  RDI_NameMapBucket *buckets;
-  RDI_NameMapNode *nodes;
-  RDI_U64 bucket_count;
-  RDI_U64 node_count;
-};
-
 ////////////////////////////////
 //~ Global Nils
 
@@ -165,12 +166,17 @@ RDI_PROC void rdi_parsed_from_source_line_map(RDI_Parsed *rdi, RDI_SourceLineMap
 RDI_PROC RDI_U64 *rdi_line_voffs_from_num(RDI_ParsedSourceLineMap *map, RDI_U32 linenum, RDI_U32 *n_out);
 
 //- vmap lookups
+RDI_PROC RDI_U64 rdi_vmap_pos_from_voff_range(RDI_VMapEntry *vmap, RDI_U64 first, RDI_U64 opl, RDI_U64 voff);
 RDI_PROC RDI_U64 rdi_vmap_idx_from_voff(RDI_VMapEntry *vmap, RDI_U64 vmap_count, RDI_U64 voff);
+RDI_PROC RDI_U64 rdi_vmap_idx_from_voff_pages(RDI_VMapEntry *vmap, RDI_U64 vmap_count, RDI_U32 *pages, RDI_U64 pages_count, RDI_U64 voff);
 
 //- name maps
 RDI_PROC RDI_NameMap *rdi_name_map_from_kind(RDI_Parsed *p, RDI_NameMapKind kind);
-RDI_PROC void rdi_name_map_parse(RDI_Parsed* p, RDI_NameMap *mapptr, RDI_ParsedNameMap *out);
+RDI_PROC void rdi_parsed_from_name_map(RDI_Parsed *rdi, RDI_NameMap *mapptr, RDI_ParsedNameMap *out);
+RDI_PROC void rdi_parsed_from_nested_name_map(RDI_Parsed *rdi, RDI_NameMap *mapptr, RDI_ParsedNameMap *out);
+RDI_PROC RDI_ParsedNameMap *rdi_parsed_name_map_from_kind(RDI_Parsed *p, RDI_NameMapKind kind);
 RDI_PROC RDI_NameMapNode *rdi_name_map_lookup(RDI_Parsed *p, RDI_ParsedNameMap *map, RDI_U8 *str, RDI_U64 len);
+RDI_PROC void rdi_name_map_lookup_batch(RDI_Parsed *p, RDI_ParsedNameMap *map, RDI_U8 **strs, RDI_U64 *lens, RDI_U64 count, RDI_NameMapNode **nodes_out);
 RDI_PROC RDI_U32 *rdi_matches_from_map_node(RDI_Parsed *p, RDI_NameMapNode *node, RDI_U32 *n_out);
 
 ////////////////////////////////
@@ -190,6 +196,10 @@ RDI_PROC RDI_U64 rdi_first_voff_from_scope(RDI_Parsed *rdi, RDI_Scope *scope);
 RDI_PROC RDI_U64 rdi_opl_voff_from_scope(RDI_Parsed *rdi, RDI_Scope *scope);
 RDI_PROC RDI_Scope *rdi_scope_from_voff(RDI_Parsed *rdi, RDI_U64 voff);
 RDI_PROC RDI_Procedure *rdi_procedure_from_scope(RDI_Parsed *rdi, RDI_Scope *scope);
+RDI_PROC RDI_U32 rdi_local_idx_from_scope_name(RDI_Parsed *rdi, RDI_U32 scope_idx, RDI_U8 *name, RDI_U64 name_size);
+
+//- udts
+RDI_PROC RDI_U32 rdi_member_idx_from_udt_name(RDI_Parsed *rdi, RDI_U32 udt_idx, RDI_U8 *name, RDI_U64 name_size);
 
 //- units
 RDI_PROC RDI_Unit *rdi_unit_from_voff(RDI_Parsed *rdi, RDI_U64 voff);
@@ -220,5 +230,7 @@ RDI_PROC RDI_U8 *rdi_name_from_file_path_node(RDI_Parsed *rdi, RDI_FilePathNode
 
 #define rdi_parse__min(a,b) (((a)<(b))?(a):(b))
 RDI_PROC RDI_U64 rdi_cstring_length(char *cstr);
+RDI_PROC RDI_S32 rdi_string_match(RDI_U8 *a, RDI_U64 a_size, RDI_U8 *b, RDI_U64 b_size);
+RDI_PROC RDI_U64 rdi_u64_from_unaligned(RDI_U8 *ptr);
 
 #endif // RDI_FORMAT_PARSE_H
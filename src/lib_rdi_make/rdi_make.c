@@ -1245,10 +1245,35 @@ rdim_bake_vmap_from_markers(RDIM_Arena *arena, RDIM_VMapMarker *markers, RDIM_So
     vmap_entry_count = (RDI_U32)(vmap_out - vmap); // TODO(rjf): @u64_to_u32
   }
   
+  //- rjf: build page directory - for each page, the index of the entry which
+  // contains the page's first voff, so that lookups only need to search the
+  // entries between two neighboring pages. skipped when it would be much
+  // larger than the vmap itself (a few entries spread over a wide range).
+  RDI_U32 *pages = 0;
+  RDI_U64 pages_count = 0;
+  if(vmap_entry_count >= 2)
+  {
+    RDI_U64 pages_count_needed = (vmap[vmap_entry_count-1].voff >> RDI_VMAP_PAGE_SIZE_LOG2) + 2;
+    if(pages_count_needed*sizeof(RDI_U32) <= vmap_entry_count*sizeof(RDI_VMapEntry)*4)
+    {
+      pages_count = pages_count_needed;
+      pages = rdim_push_array_no_zero(arena, RDI_U32, pages_count);
+      RDI_U32 entry_idx = 0;
+      for(RDI_U64 page_idx = 0; page_idx < pages_count; page_idx += 1)
+      {
+        RDI_U64 page_voff = page_idx << RDI_VMAP_PAGE_SIZE_LOG2;
+        for(;entry_idx+2 < vmap_entry_count && vmap[entry_idx+1].voff <= page_voff;) entry_idx += 1;
+        pages[page_idx] = entry_idx;
+      }
+    }
+  }
+  
   //- rjf: fill result
   RDIM_BakeVMap result = {0};
   result.vmap = vmap;
   result.count = vmap_entry_count-1;
+  result.pages = pages;
+  result.pages_count = pages_count;
   rdim_scratch_end(scratch);
   return result;
 }
@@ -1315,71 +1340,120 @@ rdim_bake_string_chunk_list_sorted_from_unsorted(RDIM_Arena *arena, RDIM_BakeStr
   //- rjf: sort chunk node
   if(dst.first != 0)
   {
-    RDIM_Temp scratch = rdim_scratch_begin(&arena, 1);
-    typedef struct SortTask SortTask;
-    struct SortTask
+    rdim_bake_string_array_sort_in_place(dst.first->v, dst.first->count);
+  }
+  
+  return dst;
+}
+
+//- rjf: bake string sorting
+
+RDI_PROC RDI_S32
+rdim_bake_string_compare_from_off(RDIM_BakeString *a, RDIM_BakeString *b, RDI_U64 off)
+{
+  RDI_S32 result = 0;
+  RDI_U64 size = Min(a->string.size, b->string.size);
+  for(RDI_U64 idx = off; idx < size; idx += 1)
+  {
+    if(a->string.str[idx] != b->string.str[idx])
     {
-      SortTask *next;
-      RDI_U64 string_off;
-      RDIM_BakeString *v;
-      RDI_U64 count;
-    };
-    SortTask start_task = {0, 0, dst.first->v, dst.first->count};
-    SortTask *first_task = &start_task;
-    SortTask *last_task = &start_task;
+      result = (a->string.str[idx] < b->string.str[idx]) ? -1 : +1;
+      break;
+    }
+  }
+  if(result == 0 && a->string.size != b->string.size)
+  {
+    result = (a->string.size < b->string.size) ? -1 : +1;
+  }
+  return result;
+}
+
+RDI_PROC void
+rdim_bake_string_array_sort_in_place(RDIM_BakeString *v, RDI_U64 count)
+{
+  // NOTE: MSD radix sort. Each range is scattered into 257 buckets by
+  // the byte at the range's key offset - bucket 0 holds strings which end
+  // before that offset, so that shorter strings sort before their extensions,
+  // and so that it never needs further sorting. Small ranges are finished with
+  // an insertion sort, starting from the offset at which their keys may differ.
+  RDIM_Temp scratch = rdim_scratch_begin(0, 0);
+  typedef struct SortTask SortTask;
+  struct SortTask
+  {
+    SortTask *next;
+    RDI_U64 string_off;
+    RDIM_BakeString *v;
+    RDI_U64 count;
+  };
+  SortTask start_task = {0, 0, v, count};
+  SortTask *first_task = &start_task;
+  SortTask *last_task = &start_task;
+  RDIM_BakeString *tmp = rdim_push_array_no_zero(scratch.arena, RDIM_BakeString, count);
+  RDI_U64 *bucket_counts = rdim_push_array_no_zero(scratch.arena, RDI_U64, 257);
+  RDI_U64 *bucket_offs = rdim_push_array_no_zero(scratch.arena, RDI_U64, 257);
+  for(SortTask *t = first_task; t != 0; t = t->next)
+  {
+    //- rjf: small range -> insertion sort
+    if(t->count <= 16)
+    {
+      for(RDI_U64 idx = 1; idx < t->count; idx += 1)
+      {
+        RDIM_BakeString key = t->v[idx];
+        RDI_U64 dst_idx = idx;
+        for(;dst_idx > 0 && rdim_bake_string_compare_from_off(&t->v[dst_idx-1], &key, t->string_off) > 0; dst_idx -= 1)
+        {
+          t->v[dst_idx] = t->v[dst_idx-1];
+        }
+        t->v[dst_idx] = key;
+      }
+      continue;
+    }
+    
+    //- rjf: count elements per bucket
+    rdim_memzero(bucket_counts, sizeof(bucket_counts[0])*257);
+    for(RDI_U64 idx = 0; idx < t->count; idx += 1)
+    {
+      RDIM_String8 string = t->v[idx].string;
+      RDI_U64 bucket_idx = t->string_off < string.size ? (RDI_U64)string.str[t->string_off]+1 : 0;
+      bucket_counts[bucket_idx] += 1;
+    }
     
-    //- rjf: for each sort task range:
-    for(SortTask *t = first_task; t != 0; t = t->next)
+    //- rjf: scatter into temporary storage, copy back
     {
-      //- rjf: loop through range, drop each element into bucket according to byte in string at task offset
-      RDIM_BakeStringChunkList *buckets = rdim_push_array(scratch.arena, RDIM_BakeStringChunkList, 256);
-      for(RDI_U64 idx = 0; idx < t->count; idx += 1)
+      RDI_U64 off = 0;
+      for(RDI_U64 bucket_idx = 0; bucket_idx < 257; bucket_idx += 1)
       {
-        U8 byte = t->string_off < t->v[idx].string.size ? t->v[idx].string.str[t->string_off] : 0;
-        RDIM_BakeStringChunkList *bucket = &buckets[byte];
-        RDIM_BakeString *bstr = rdim_bake_string_chunk_list_push(scratch.arena, bucket, 8);
-        rdim_memcpy_struct(bstr, &t->v[idx]);
+        bucket_offs[bucket_idx] = off;
+        off += bucket_counts[bucket_idx];
       }
-      
-      //- rjf: in-place mutate the original source array to reflect the order per the buckets.
-      // build new sort tasks for buckets with many elements
+    }
+    for(RDI_U64 idx = 0; idx < t->count; idx += 1)
+    {
+      RDIM_String8 string = t->v[idx].string;
+      RDI_U64 bucket_idx = t->string_off < string.size ? (RDI_U64)string.str[t->string_off]+1 : 0;
+      tmp[bucket_offs[bucket_idx]] = t->v[idx];
+      bucket_offs[bucket_idx] += 1;
+    }
+    rdim_memcpy(t->v, tmp, sizeof(t->v[0])*t->count);
+    
+    //- rjf: push new tasks for each non-terminal bucket with >1 element
+    {
+      RDI_U64 bucket_base_idx = bucket_counts[0];
+      for(RDI_U64 bucket_idx = 1; bucket_idx < 257; bucket_idx += 1)
       {
-        RDI_U64 write_idx = 0;
-        for(U64 bucket_idx = 0; bucket_idx < 256; bucket_idx += 1)
+        if(bucket_counts[bucket_idx] > 1)
         {
-          // rjf: write each chunk node's array into original array, detect if there is size left to sort
-          RDI_U64 bucket_base_idx = write_idx;
-          RDI_U64 max_size_left_to_sort = 0;
-          for(RDIM_BakeStringChunkNode *n = buckets[bucket_idx].first; n != 0; n = n->next)
-          {
-            rdim_memcpy(t->v+write_idx, n->v, sizeof(n->v[0])*n->count);
-            write_idx += n->count;
-            for(RDI_U64 idx = 0; idx < n->count; idx += 1)
-            {
-              if(n->v[idx].string.size > t->string_off+1)
-              {
-                max_size_left_to_sort = Max(max_size_left_to_sort, (n->v[idx].string.size - t->string_off+1));
-              }
-            }
-          }
-          
-          // rjf: if any bucket has >1 element & has some amount of size left to sort, push new task for this
-          // bucket's region in the array, and for remainder of keys
-          if(buckets[bucket_idx].total_count > 1 && max_size_left_to_sort > 0)
-          {
-            SortTask *new_task = rdim_push_array(scratch.arena, SortTask, 1);
-            RDIM_SLLQueuePush(first_task, last_task, new_task);
-            new_task->string_off = t->string_off+1;
-            new_task->v = t->v + bucket_base_idx;
-            new_task->count = write_idx-bucket_base_idx;
-          }
+          SortTask *new_task = rdim_push_array(scratch.arena, SortTask, 1);
+          RDIM_SLLQueuePush(first_task, last_task, new_task);
+          new_task->string_off = t->string_off+1;
+          new_task->v = t->v + bucket_base_idx;
+          new_task->count = bucket_counts[bucket_idx];
         }
+        bucket_base_idx += bucket_counts[bucket_idx];
       }
     }
-    scratch_end(scratch);
   }
-  
-  return dst;
+  rdim_scratch_end(scratch);
 }
 
 //- rjf: bake string chunk list maps
@@ -1458,6 +1532,90 @@ rdim_bake_string_map_base_indices_from_map_loose(RDIM_Arena *arena, RDIM_BakeStr
   return indices;
 }
 
+//- rjf: bake string map partitions
+
+RDI_PROC RDIM_BakeStringMapPartition *
+rdim_bake_string_map_partitions_make(RDIM_Arena *arena, RDIM_BakeStringMapTopology *map_topology, RDI_U64 slots_per_partition, RDI_U64 *count_out)
+{
+  RDI_U64 partitions_count = (map_topology->slots_count + slots_per_partition - 1) / slots_per_partition;
+  RDIM_BakeStringMapPartition *partitions = rdim_push_array(arena, RDIM_BakeStringMapPartition, partitions_count);
+  for(RDI_U64 idx = 0; idx < partitions_count; idx += 1)
+  {
+    partitions[idx].slot_idx_first = idx*slots_per_partition;
+    partitions[idx].slot_idx_opl   = Min((idx+1)*slots_per_partition, map_topology->slots_count);
+  }
+  *count_out = partitions_count;
+  return partitions;
+}
+
+RDI_PROC void
+rdim_bake_string_map_partition_join_sort(RDIM_Arena *arena, RDIM_BakeStringMapLoose **src_maps, RDI_U64 src_maps_count, RDIM_BakeStringMapLoose *dst_map, RDIM_BakeStringMapPartition *partition)
+{
+  partition->string_count = 0;
+  partition->string_data_size = 0;
+  for(RDI_U64 slot_idx = partition->slot_idx_first; slot_idx < partition->slot_idx_opl; slot_idx += 1)
+  {
+    //- rjf: count strings for this slot across all source maps
+    RDI_U64 total_count = 0;
+    for(RDI_U64 src_idx = 0; src_idx < src_maps_count; src_idx += 1)
+    {
+      RDIM_BakeStringChunkList *src_slot = src_maps[src_idx]->slots[slot_idx];
+      if(src_slot != 0)
+      {
+        total_count += src_slot->total_count;
+      }
+    }
+    if(total_count == 0)
+    {
+      dst_map->slots[slot_idx] = 0;
+      continue;
+    }
+    
+    //- rjf: gather all strings for this slot into a single array
+    RDIM_BakeString *v = rdim_push_array_no_zero(arena, RDIM_BakeString, total_count);
+    RDI_U64 count = 0;
+    for(RDI_U64 src_idx = 0; src_idx < src_maps_count; src_idx += 1)
+    {
+      RDIM_BakeStringChunkList *src_slot = src_maps[src_idx]->slots[slot_idx];
+      if(src_slot != 0)
+      {
+        for(RDIM_BakeStringChunkNode *n = src_slot->first; n != 0; n = n->next)
+        {
+          rdim_memcpy(v+count, n->v, sizeof(n->v[0])*n->count);
+          count += n->count;
+        }
+      }
+    }
+    
+    //- rjf: sort, then drop duplicates (which are now adjacent) - each source
+    // map is deduplicated on insertion, but the same string may be in several
+    rdim_bake_string_array_sort_in_place(v, count);
+    RDI_U64 unique_count = 0;
+    for(RDI_U64 idx = 0; idx < count; idx += 1)
+    {
+      if(unique_count == 0 ||
+         v[unique_count-1].hash != v[idx].hash ||
+         !rdim_str8_match(v[unique_count-1].string, v[idx].string, 0))
+      {
+        v[unique_count] = v[idx];
+        partition->string_data_size += v[idx].string.size;
+        unique_count += 1;
+      }
+    }
+    partition->string_count += unique_count;
+    
+    //- rjf: fill destination slot with single chunk
+    RDIM_BakeStringChunkNode *node = rdim_push_array(arena, RDIM_BakeStringChunkNode, 1);
+    node->v = v;
+    node->count = unique_count;
+    node->cap = total_count;
+    RDIM_BakeStringChunkList *dst_slot = dst_map->slots[slot_idx] = rdim_push_array(arena, RDIM_BakeStringChunkList, 1);
+    RDIM_SLLQueuePush(dst_slot->first, dst_slot->last, node);
+    dst_slot->chunk_count = 1;
+    dst_slot->total_count = unique_count;
+  }
+}
+
 //- rjf: finalized bake string map
 
 RDI_PROC RDIM_BakeStringMapTight
@@ -1478,6 +1636,42 @@ rdim_bake_string_map_tight_from_loose(RDIM_Arena *arena, RDIM_BakeStringMapTopol
   return m;
 }
 
+RDI_PROC RDIM_BakeStringMapTight
+rdim_bake_string_map_tight_from_partitions(RDIM_Arena *arena, RDIM_BakeStringMapTopology *map_topology, RDIM_BakeStringMapPartition *partitions, RDI_U64 partitions_count)
+{
+  RDIM_BakeStringMapTight m = {0};
+  m.slots_count = map_topology->slots_count;
+  m.slots = rdim_push_array(arena, RDIM_BakeStringChunkList, m.slots_count);
+  m.slots_base_idxs = rdim_push_array(arena, RDI_U64, m.slots_count+1);
+  RDI_U64 total_count = 0;
+  RDI_U64 total_data_size = 0;
+  for(RDI_U64 idx = 0; idx < partitions_count; idx += 1)
+  {
+    partitions[idx].base_idx = total_count;
+    partitions[idx].base_data_off = total_data_size;
+    total_count += partitions[idx].string_count;
+    total_data_size += partitions[idx].string_data_size;
+  }
+  m.slots_base_idxs[m.slots_count] = total_count;
+  m.total_count = total_count;
+  return m;
+}
+
+RDI_PROC void
+rdim_bake_string_map_tight_fill_partition(RDIM_BakeStringMapTight *map, RDIM_BakeStringMapLoose *src_map, RDIM_BakeStringMapPartition *partition)
+{
+  RDI_U64 base_idx = partition->base_idx;
+  for(RDI_U64 slot_idx = partition->slot_idx_first; slot_idx < partition->slot_idx_opl; slot_idx += 1)
+  {
+    map->slots_base_idxs[slot_idx] = base_idx;
+    if(src_map->slots[slot_idx] != 0)
+    {
+      rdim_memcpy_struct(&map->slots[slot_idx], src_map->slots[slot_idx]);
+      base_idx += src_map->slots[slot_idx]->total_count;
+    }
+  }
+}
+
 RDI_PROC RDI_U32
 rdim_bake_idx_from_string(RDIM_BakeStringMapTight *map, RDIM_String8 string)
 {
@@ -2277,6 +2471,7 @@ rdim_bake_name_map(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings, RDIM_Bak
             node_ptr->string_idx = string_idx;
             node_ptr->match_count = match_count;
             node_ptr->match_idx_or_idx_run_first = idx;
+            node_ptr->hash_tag = (RDI_U32)rdi_hash(node->string.str, node->string.size);
             node_ptr += 1;
           }
         }
@@ -3511,7 +3706,7 @@ RDI_PROC RDIM_StringBakeResult
 rdim_bake_strings(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings)
 {
   RDIM_BakeSectionList sections = {0};
-  RDI_U32 *str_offs = rdim_push_array_no_zero(arena, RDI_U32, strings->total_count + 1);
+  RDI_U32 *str_offs = rdim_push_array_no_zero(arena, RDI_U32, strings->total_count + 2);
   RDI_U32 off_cursor = 0;
   {
     RDI_U32 *off_ptr = str_offs;
@@ -3530,6 +3725,7 @@ rdim_bake_strings(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings)
         }
       }
     }
+    *off_ptr = off_cursor;
   }
   RDI_U8 *buf = rdim_push_array(arena, RDI_U8, off_cursor);
   {
@@ -3549,12 +3745,51 @@ rdim_bake_strings(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings)
   }
   RDIM_StringBakeResult result = {0};
   result.string_offs = str_offs;
-  result.string_offs_count = strings->total_count+1;
+  result.string_offs_count = strings->total_count+2;
   result.string_data = buf;
   result.string_data_size = off_cursor;
   return result;
 }
 
+RDI_PROC RDIM_StringBakeResult
+rdim_bake_strings_make(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings, RDIM_BakeStringMapPartition *partitions, RDI_U64 partitions_count)
+{
+  RDI_U64 data_size = 0;
+  if(partitions_count != 0)
+  {
+    data_size = partitions[partitions_count-1].base_data_off + partitions[partitions_count-1].string_data_size;
+  }
+  RDIM_StringBakeResult result = {0};
+  result.string_offs_count = strings->total_count+2;
+  result.string_offs = rdim_push_array_no_zero(arena, RDI_U32, result.string_offs_count);
+  result.string_data_size = data_size;
+  result.string_data = rdim_push_array_no_zero(arena, RDI_U8, data_size);
+  result.string_offs[0] = 0;
+  result.string_offs[result.string_offs_count-1] = (RDI_U32)data_size;
+  return result;
+}
+
+RDI_PROC void
+rdim_bake_strings_partition(RDIM_StringBakeResult *dst, RDIM_BakeStringMapTight *strings, RDIM_BakeStringMapPartition *partition)
+{
+  RDI_U32 *off_ptr = dst->string_offs + 1 + partition->base_idx;
+  RDI_U64 off_cursor = partition->base_data_off;
+  for(RDI_U64 slot_idx = partition->slot_idx_first; slot_idx < partition->slot_idx_opl; slot_idx += 1)
+  {
+    for(RDIM_BakeStringChunkNode *n = strings->slots[slot_idx].first; n != 0; n = n->next)
+    {
+      for(RDI_U64 chunk_idx = 0; chunk_idx < n->count; chunk_idx += 1)
+      {
+        RDIM_BakeString *bake_string = &n->v[chunk_idx];
+        *off_ptr = (RDI_U32)off_cursor;
+        rdim_memcpy(dst->string_data + off_cursor, bake_string->string.str, bake_string->string.size);
+        off_cursor += bake_string->string.size;
+        off_ptr += 1;
+      }
+    }
+  }
+}
+
 RDI_PROC RDIM_IndexRunBakeResult
 rdim_bake_index_runs(RDIM_Arena *arena, RDIM_BakeIdxRunMap *idx_runs)
 {
@@ -3576,6 +3811,133 @@ rdim_bake_index_runs(RDIM_Arena *arena, RDIM_BakeIdxRunMap *idx_runs)
   return result;
 }
 
+//- rjf: dependent baking functions (run on already-baked results)
+
+RDI_PROC RDI_NameMap
+rdim_bake_nested_name_map(RDIM_NestedNameMapBakeResult *dst, RDIM_StringBakeResult *strings, RDI_U32 *string_idxs, RDI_U32 match_first, RDI_U32 count)
+{
+  RDI_NameMap map = {0};
+  map.bucket_base_idx = (RDI_U32)dst->buckets_count;
+  map.node_base_idx   = (RDI_U32)dst->nodes_count;
+  
+  //- rjf: count named elements; unnamed ones can't be looked up by name
+  RDI_U32 named_count = 0;
+  for(RDI_U32 idx = 0; idx < count; idx += 1)
+  {
+    named_count += (string_idxs[idx] != 0);
+  }
+  
+  //- rjf: bucket named elements; node order within a bucket matches element
+  // order, so a lookup finds the first element with a given name
+  if(named_count != 0)
+  {
+    RDI_NameMapBucket *buckets = dst->buckets + dst->buckets_count;
+    RDI_NameMapNode *nodes = dst->nodes + dst->nodes_count;
+    RDI_U32 bucket_count = named_count;
+    RDI_U32 *hash_tags = string_idxs + count;
+    RDI_U32 *bucket_idxs = string_idxs + count*2;
+    for(RDI_U32 idx = 0; idx < count; idx += 1)
+    {
+      RDI_U32 string_idx = string_idxs[idx];
+      if(string_idx != 0)
+      {
+        RDI_U32 off = strings->string_offs[string_idx];
+        RDI_U32 opl = strings->string_offs[string_idx+1];
+        RDI_U64 hash = rdi_hash(strings->string_data + off, opl - off);
+        hash_tags[idx] = (RDI_U32)hash;
+        bucket_idxs[idx] = (RDI_U32)(hash%bucket_count);
+        buckets[bucket_idxs[idx]].node_count += 1;
+      }
+    }
+    for(RDI_U32 bucket_idx = 0, node_off = 0; bucket_idx < bucket_count; bucket_idx += 1)
+    {
+      buckets[bucket_idx].first_node = node_off;
+      node_off += buckets[bucket_idx].node_count;
+      buckets[bucket_idx].node_count = 0;
+    }
+    for(RDI_U32 idx = 0; idx < count; idx += 1)
+    {
+      RDI_U32 string_idx = string_idxs[idx];
+      if(string_idx != 0)
+      {
+        RDI_NameMapBucket *bucket = &buckets[bucket_idxs[idx]];
+        RDI_NameMapNode *node = &nodes[bucket->first_node + bucket->node_count];
+        node->string_idx                 = string_idx;
+        node->match_count                = 1;
+        node->match_idx_or_idx_run_first = match_first + idx;
+        node->hash_tag                   = hash_tags[idx];
+        bucket->node_count += 1;
+      }
+    }
+    map.bucket_count = bucket_count;
+    map.node_count   = named_count;
+    dst->buckets_count += bucket_count;
+    dst->nodes_count   += named_count;
+  }
+  return map;
+}
+
+RDI_PROC RDIM_NestedNameMapBakeResult
+rdim_bake_nested_name_maps(RDIM_Arena *arena, RDIM_StringBakeResult *strings, RDIM_ScopeBakeResult *scopes, RDIM_UDTBakeResult *udts)
+{
+  RDIM_Temp scratch = rdim_scratch_begin(&arena, 1);
+  RDIM_NestedNameMapBakeResult result = {0};
+  
+  //- rjf: allocate outputs - each named local/member gets at most one bucket & one node
+  RDI_U64 elements_count_max = scopes->locals_count + udts->members_count + udts->enum_members_count;
+  result.scope_local_name_maps_count = scopes->scopes_count;
+  result.scope_local_name_maps       = rdim_push_array(arena, RDI_NameMap, result.scope_local_name_maps_count);
+  result.udt_member_name_maps_count  = udts->udts_count;
+  result.udt_member_name_maps        = rdim_push_array(arena, RDI_NameMap, result.udt_member_name_maps_count);
+  result.buckets                     = rdim_push_array(arena, RDI_NameMapBucket, elements_count_max);
+  result.nodes                       = rdim_push_array(arena, RDI_NameMapNode, elements_count_max);
+  
+  //- rjf: allocate scratch space for each map's string indices, hash tags, & bucket indices
+  RDI_U32 *string_idxs = rdim_push_array_no_zero(scratch.arena, RDI_U32, elements_count_max*3 + 1);
+  
+  //- rjf: scopes -> local name maps
+  RDIM_ProfScope("bake scope local name maps")
+  {
+    for(RDI_U64 scope_idx = 1; scope_idx < scopes->scopes_count; scope_idx += 1)
+    {
+      RDI_Scope *scope = &scopes->scopes[scope_idx];
+      if(scope->local_count == 0 || scope->local_first + scope->local_count > scopes->locals_count)
+      {
+        continue;
+      }
+      for(RDI_U32 idx = 0; idx < scope->local_count; idx += 1)
+      {
+        string_idxs[idx] = scopes->locals[scope->local_first + idx].name_string_idx;
+      }
+      result.scope_local_name_maps[scope_idx] = rdim_bake_nested_name_map(&result, strings, string_idxs, scope->local_first, scope->local_count);
+    }
+  }
+  
+  //- rjf: udts -> member name maps (enum udts map into enum members)
+  RDIM_ProfScope("bake udt member name maps")
+  {
+    for(RDI_U64 udt_idx = 1; udt_idx < udts->udts_count; udt_idx += 1)
+    {
+      RDI_UDT *udt = &udts->udts[udt_idx];
+      RDI_U64 members_count = (udt->flags & RDI_UDTFlag_EnumMembers) ? udts->enum_members_count : udts->members_count;
+      if(udt->member_count == 0 || udt->member_first + udt->member_count > members_count)
+      {
+        continue;
+      }
+      for(RDI_U32 idx = 0; idx < udt->member_count; idx += 1)
+      {
+        string_idxs[idx] = ((udt->flags & RDI_UDTFlag_EnumMembers)
+                            ? udts->enum_members[udt->member_first + idx].name_string_idx
+                            : udts->members[udt->member_first + idx].name_string_idx);
+      }
+      result.udt_member_name_maps[udt_idx] = rdim_bake_nested_name_map(&result, strings, string_idxs, udt->member_first, udt->member_count);
+    }
+  }
+  
+  rdim_scratch_end(scratch);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: [Serializing] Bake Results -> String Blobs
 
@@ -3630,6 +3992,13 @@ rdim_serialized_section_bundle_from_bake_results(RDIM_BakeResults *results)
   bundle.sections[RDI_SectionKind_NameMaps]             = rdim_serialized_section_make_unpacked_array(results->top_level_name_maps.name_maps, results->top_level_name_maps.name_maps_count);
   bundle.sections[RDI_SectionKind_NameMapBuckets]       = rdim_serialized_section_make_unpacked_array(results->name_maps.buckets, results->name_maps.buckets_count);
   bundle.sections[RDI_SectionKind_NameMapNodes]         = rdim_serialized_section_make_unpacked_array(results->name_maps.nodes, results->name_maps.nodes_count);
+  bundle.sections[RDI_SectionKind_UnitVMapPages]        = rdim_serialized_section_make_unpacked_array(results->unit_vmap.vmap.pages, results->unit_vmap.vmap.pages_count);
+  bundle.sections[RDI_SectionKind_GlobalVMapPages]      = rdim_serialized_section_make_unpacked_array(results->global_vmap.vmap.pages, results->global_vmap.vmap.pages_count);
+  bundle.sections[RDI_SectionKind_ScopeVMapPages]       = rdim_serialized_section_make_unpacked_array(results->scope_vmap.vmap.pages, results->scope_vmap.vmap.pages_count);
+  bundle.sections[RDI_SectionKind_ScopeLocalNameMaps]   = rdim_serialized_section_make_unpacked_array(results->nested_name_maps.scope_local_name_maps, results->nested_name_maps.scope_local_name_maps_count);
+  bundle.sections[RDI_SectionKind_UDTMemberNameMaps]    = rdim_serialized_section_make_unpacked_array(results->nested_name_maps.udt_member_name_maps, results->nested_name_maps.udt_member_name_maps_count);
+  bundle.sections[RDI_SectionKind_NestedNameMapBuckets] = rdim_serialized_section_make_unpacked_array(results->nested_name_maps.buckets, results->nested_name_maps.buckets_count);
+  bundle.sections[RDI_SectionKind_NestedNameMapNodes]   = rdim_serialized_section_make_unpacked_array(results->nested_name_maps.nodes, results->nested_name_maps.nodes_count);
   return bundle;
 }
 
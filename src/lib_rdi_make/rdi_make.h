@@ -945,6 +945,22 @@ struct RDIM_BakeStringMapLoose
   RDIM_BakeStringChunkList **slots;
 };
 
+// NOTE: A partition is a contiguous range of string map slots. Slots are
+// selected by hash, so partitions split strings by hash, & each partition can
+// be joined, deduplicated, sorted, & indexed independently of the others.
+// Base indices & string data offsets are assigned by a prefix sum over the
+// partitions' counts & sizes.
+typedef struct RDIM_BakeStringMapPartition RDIM_BakeStringMapPartition;
+struct RDIM_BakeStringMapPartition
+{
+  RDI_U64 slot_idx_first;
+  RDI_U64 slot_idx_opl;
+  RDI_U64 string_count;
+  RDI_U64 string_data_size;
+  RDI_U64 base_idx;
+  RDI_U64 base_data_off;
+};
+
 typedef struct RDIM_BakeStringMapTight RDIM_BakeStringMapTight;
 struct RDIM_BakeStringMapTight
 {
@@ -1048,6 +1064,8 @@ struct RDIM_BakeVMap
 {
   RDI_VMapEntry *vmap; // [count + 1]
   RDI_U32 count;
+  RDI_U32 *pages; // [pages_count], see RDI_VMAP_PAGE_SIZE_LOG2
+  RDI_U64 pages_count;
 };
 
 typedef struct RDIM_VMapMarker RDIM_VMapMarker;
@@ -1202,6 +1220,19 @@ struct RDIM_NameMapBakeResult
   RDI_U64 nodes_count;
 };
 
+typedef struct RDIM_NestedNameMapBakeResult RDIM_NestedNameMapBakeResult;
+struct RDIM_NestedNameMapBakeResult
+{
+  RDI_NameMap *scope_local_name_maps;
+  RDI_U64 scope_local_name_maps_count;
+  RDI_NameMap *udt_member_name_maps;
+  RDI_U64 udt_member_name_maps_count;
+  RDI_NameMapBucket *buckets;
+  RDI_U64 buckets_count;
+  RDI_NameMapNode *nodes;
+  RDI_U64 nodes_count;
+};
+
 typedef struct RDIM_FilePathBakeResult RDIM_FilePathBakeResult;
 struct RDIM_FilePathBakeResult
 {
@@ -1245,6 +1276,7 @@ struct RDIM_BakeResults
   RDIM_ScopeVMapBakeResult scope_vmap;
   RDIM_TopLevelNameMapBakeResult top_level_name_maps;
   RDIM_NameMapBakeResult name_maps;
+  RDIM_NestedNameMapBakeResult nested_name_maps;
   RDIM_FilePathBakeResult file_paths;
   RDIM_StringBakeResult strings;
   RDIM_IndexRunBakeResult idx_runs;
@@ -1413,6 +1445,8 @@ RDI_PROC RDIM_BakeVMap rdim_bake_vmap_from_markers(RDIM_Arena *arena, RDIM_VMapM
 RDI_PROC RDIM_BakeString *rdim_bake_string_chunk_list_push(RDIM_Arena *arena, RDIM_BakeStringChunkList *list, RDI_U64 cap);
 RDI_PROC void rdim_bake_string_chunk_list_concat_in_place(RDIM_BakeStringChunkList *dst, RDIM_BakeStringChunkList *to_push);
 RDI_PROC RDIM_BakeStringChunkList rdim_bake_string_chunk_list_sorted_from_unsorted(RDIM_Arena *arena, RDIM_BakeStringChunkList *src);
+RDI_PROC RDI_S32 rdim_bake_string_compare_from_off(RDIM_BakeString *a, RDIM_BakeString *b, RDI_U64 off);
+RDI_PROC void rdim_bake_string_array_sort_in_place(RDIM_BakeString *v, RDI_U64 count);
 
 //- rjf: bake string chunk list maps
 RDI_PROC RDIM_BakeStringMapLoose *rdim_bake_string_map_loose_make(RDIM_Arena *arena, RDIM_BakeStringMapTopology *top);
@@ -1420,8 +1454,14 @@ RDI_PROC void rdim_bake_string_map_loose_insert(RDIM_Arena *arena, RDIM_BakeStri
 RDI_PROC void rdim_bake_string_map_loose_join_in_place(RDIM_BakeStringMapTopology *map_topology, RDIM_BakeStringMapLoose *dst, RDIM_BakeStringMapLoose *src);
 RDI_PROC RDIM_BakeStringMapBaseIndices rdim_bake_string_map_base_indices_from_map_loose(RDIM_Arena *arena, RDIM_BakeStringMapTopology *map_topology, RDIM_BakeStringMapLoose *map);
 
+//- rjf: bake string map partitions
+RDI_PROC RDIM_BakeStringMapPartition *rdim_bake_string_map_partitions_make(RDIM_Arena *arena, RDIM_BakeStringMapTopology *map_topology, RDI_U64 slots_per_partition, RDI_U64 *count_out);
+RDI_PROC void rdim_bake_string_map_partition_join_sort(RDIM_Arena *arena, RDIM_BakeStringMapLoose **src_maps, RDI_U64 src_maps_count, RDIM_BakeStringMapLoose *dst_map, RDIM_BakeStringMapPartition *partition);
+
 //- rjf: finalized bake string map
 RDI_PROC RDIM_BakeStringMapTight rdim_bake_string_map_tight_from_loose(RDIM_Arena *arena, RDIM_BakeStringMapTopology *map_topology, RDIM_BakeStringMapBaseIndices *map_base_indices, RDIM_BakeStringMapLoose *map);
+RDI_PROC RDIM_BakeStringMapTight rdim_bake_string_map_tight_from_partitions(RDIM_Arena *arena, RDIM_BakeStringMapTopology *map_topology, RDIM_BakeStringMapPartition *partitions, RDI_U64 partitions_count);
+RDI_PROC void rdim_bake_string_map_tight_fill_partition(RDIM_BakeStringMapTight *map, RDIM_BakeStringMapLoose *src_map, RDIM_BakeStringMapPartition *partition);
 RDI_PROC RDI_U32 rdim_bake_idx_from_string(RDIM_BakeStringMapTight *map, RDIM_String8 string);
 
 //- rjf: bake idx run map reading/writing
@@ -1505,8 +1545,14 @@ RDI_PROC RDIM_InlineSiteBakeResult      rdim_bake_inline_sites(RDIM_Arena *arena
 RDI_PROC RDIM_TopLevelNameMapBakeResult rdim_bake_name_maps_top_level(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings, RDIM_BakeIdxRunMap *idx_runs, RDIM_BakeNameMap *name_maps[RDI_NameMapKind_COUNT]);
 RDI_PROC RDIM_FilePathBakeResult        rdim_bake_file_paths(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings, RDIM_BakePathTree *path_tree);
 RDI_PROC RDIM_StringBakeResult          rdim_bake_strings(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings);
+RDI_PROC RDIM_StringBakeResult          rdim_bake_strings_make(RDIM_Arena *arena, RDIM_BakeStringMapTight *strings, RDIM_BakeStringMapPartition *partitions, RDI_U64 partitions_count);
+RDI_PROC void                           rdim_bake_strings_partition(RDIM_StringBakeResult *dst, RDIM_BakeStringMapTight *strings, RDIM_BakeStringMapPartition *partition);
 RDI_PROC RDIM_IndexRunBakeResult        rdim_bake_index_runs(RDIM_Arena *arena, RDIM_BakeIdxRunMap *idx_runs);
 
+//- rjf: dependent baking functions (run on already-baked results)
+RDI_PROC RDI_NameMap                    rdim_bake_nested_name_map(RDIM_NestedNameMapBakeResult *dst, RDIM_StringBakeResult *strings, RDI_U32 *string_idxs, RDI_U32 match_first, RDI_U32 count);
+RDI_PROC RDIM_NestedNameMapBakeResult   rdim_bake_nested_name_maps(RDIM_Arena *arena, RDIM_StringBakeResult *strings, RDIM_ScopeBakeResult *scopes, RDIM_UDTBakeResult *udts);
+
 ////////////////////////////////
 //~ rjf: [Serializing] Bake Results -> String Blobs
 
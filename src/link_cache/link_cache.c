@@ -0,0 +1,503 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Parameter Type Functions
+
+internal B32
+lnk_params_match(LNK_Params *a, LNK_Params *b)
+{
+  B32 result = (a->machine_id == b->machine_id &&
+                dmn_handle_match(a->process, b->process) &&
+                a->first_vaddr == b->first_vaddr &&
+                a->link_off == b->link_off &&
+                a->link_size == b->link_size &&
+                a->mem_gen == b->mem_gen);
+  return result;
+}
+
+internal U64
+lnk_hash_from_params(LNK_Params *params)
+{
+  U64 buf[] =
+  {
+    params->machine_id,
+    params->process.u64[0],
+    params->first_vaddr,
+    params->link_off,
+    params->link_size,
+    params->mem_gen,
+  };
+  U64 hash = 5381;
+  for(U64 idx = 0; idx < ArrayCount(buf); idx += 1)
+  {
+    hash = ((hash << 5) + hash) + buf[idx];
+  }
+  return hash;
+}
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void
+lnk_init(void)
+{
+  Arena *arena = arena_alloc();
+  lnk_shared = push_array(arena, LNK_Shared, 1);
+  lnk_shared->arena = arena;
+  lnk_shared->slots_count = 1024;
+  lnk_shared->stripes_count = Min(lnk_shared->slots_count, os_logical_core_count());
+  lnk_shared->slots = push_array(arena, LNK_Slot, lnk_shared->slots_count);
+  lnk_shared->stripes = push_array(arena, LNK_Stripe, lnk_shared->stripes_count);
+  for(U64 idx = 0; idx < lnk_shared->stripes_count; idx += 1)
+  {
+    lnk_shared->stripes[idx].arena = arena_alloc();
+    lnk_shared->stripes[idx].rw_mutex = os_rw_mutex_alloc();
+    lnk_shared->stripes[idx].cv = os_condition_variable_alloc();
+  }
+  lnk_shared->u2w_ring_size = KB(64);
+  lnk_shared->u2w_ring_base = push_array_no_zero(arena, U8, lnk_shared->u2w_ring_size);
+  lnk_shared->u2w_ring_cv = os_condition_variable_alloc();
+  lnk_shared->u2w_ring_mutex = os_mutex_alloc();
+  lnk_shared->walk_thread_count = Clamp(1, os_logical_core_count()/4, 4);
+  lnk_shared->walk_threads = push_array(arena, OS_Handle, lnk_shared->walk_thread_count);
+  for(U64 idx = 0; idx < lnk_shared->walk_thread_count; idx += 1)
+  {
+    lnk_shared->walk_threads[idx] = os_launch_thread(lnk_walk_thread__entry_point, (void *)idx, 0);
+  }
+  lnk_shared->evictor_thread = os_launch_thread(lnk_evictor_thread__entry_point, 0, 0);
+}
+
+////////////////////////////////
+//~ rjf: User Clock
+
+internal void
+lnk_user_clock_tick(void)
+{
+  ins_atomic_u64_inc_eval(&lnk_shared->user_clock_idx);
+}
+
+internal U64
+lnk_user_clock_idx(void)
+{
+  U64 idx = ins_atomic_u64_eval(&lnk_shared->user_clock_idx);
+  return idx;
+}
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+internal LNK_Scope *
+lnk_scope_open(void)
+{
+  if(lnk_tctx == 0)
+  {
+    Arena *arena = arena_alloc();
+    lnk_tctx = push_array(arena, LNK_TCTX, 1);
+    lnk_tctx->arena = arena;
+  }
+  U64 base_pos = arena_pos(lnk_tctx->arena);
+  LNK_Scope *scope = push_array(lnk_tctx->arena, LNK_Scope, 1);
+  scope->base_pos = base_pos;
+  return scope;
+}
+
+internal void
+lnk_scope_close(LNK_Scope *scope)
+{
+  for(LNK_Touch *t = scope->top_touch, *next = 0; t != 0; t = next)
+  {
+    next = t->next;
+    U64 slot_idx = t->hash%lnk_shared->slots_count;
+    U64 stripe_idx = slot_idx%lnk_shared->stripes_count;
+    LNK_Slot *slot = &lnk_shared->slots[slot_idx];
+    LNK_Stripe *stripe = &lnk_shared->stripes[stripe_idx];
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(LNK_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(t->hash == n->hash && lnk_params_match(&t->params, &n->params))
+        {
+          ins_atomic_u64_dec_eval(&n->scope_ref_count);
+          break;
+        }
+      }
+    }
+  }
+  arena_pop_to(lnk_tctx->arena, scope->base_pos);
+}
+
+internal void
+lnk_scope_touch_node__stripe_r_guarded(LNK_Scope *scope, LNK_Node *node)
+{
+  LNK_Touch *touch = push_array(lnk_tctx->arena, LNK_Touch, 1);
+  ins_atomic_u64_inc_eval(&node->scope_ref_count);
+  ins_atomic_u64_eval_assign(&node->last_time_touched_us, os_now_microseconds());
+  ins_atomic_u64_eval_assign(&node->last_user_clock_idx_touched, lnk_user_clock_idx());
+  touch->hash = node->hash;
+  MemoryCopyStruct(&touch->params, &node->params);
+  SLLStackPush(scope->top_touch, touch);
+}
+
+////////////////////////////////
+//~ rjf: Cache Lookups
+
+internal LNK_Info
+lnk_info_from_params(LNK_Scope *scope, LNK_Params *params)
+{
+  LNK_Info info = {0};
+  if(params->first_vaddr != 0 && (params->link_size == 4 || params->link_size == 8))
+  {
+    U64 hash = lnk_hash_from_params(params);
+    U64 slot_idx = hash%lnk_shared->slots_count;
+    U64 stripe_idx = slot_idx%lnk_shared->stripes_count;
+    LNK_Slot *slot = &lnk_shared->slots[slot_idx];
+    LNK_Stripe *stripe = &lnk_shared->stripes[stripe_idx];
+    B32 found = 0;
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(LNK_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(hash == n->hash && lnk_params_match(params, &n->params))
+        {
+          info.count = ins_atomic_u64_eval(&n->count);
+          info.is_complete = n->is_complete;
+          found = 1;
+          lnk_scope_touch_node__stripe_r_guarded(scope, n);
+          break;
+        }
+      }
+    }
+    B32 node_is_new = 0;
+    if(!found)
+    {
+      OS_MutexScopeW(stripe->rw_mutex)
+      {
+        LNK_Node *node = 0;
+        for(LNK_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(hash == n->hash && lnk_params_match(params, &n->params))
+          {
+            node = n;
+            break;
+          }
+        }
+        if(node == 0)
+        {
+          node = stripe->free_node;
+          if(node)
+          {
+            SLLStackPop(stripe->free_node);
+          }
+          else
+          {
+            node = push_array_no_zero(stripe->arena, LNK_Node, 1);
+          }
+          MemoryZeroStruct(node);
+          DLLPushBack(slot->first, slot->last, node);
+          node->hash = hash;
+          MemoryCopyStruct(&node->params, params);
+          node->last_time_touched_us = os_now_microseconds();
+          node->last_user_clock_idx_touched = lnk_user_clock_idx();
+          node_is_new = 1;
+        }
+      }
+    }
+    if(node_is_new)
+    {
+      lnk_u2w_enqueue_req(params, max_U64);
+    }
+  }
+  return info;
+}
+
+internal LNK_VAddrArray
+lnk_vaddr_array_from_params_idx_range(Arena *arena, LNK_Scope *scope, LNK_Params *params, Rng1U64 idx_range)
+{
+  LNK_VAddrArray result = {0};
+  U64 hash = lnk_hash_from_params(params);
+  U64 slot_idx = hash%lnk_shared->slots_count;
+  U64 stripe_idx = slot_idx%lnk_shared->stripes_count;
+  LNK_Slot *slot = &lnk_shared->slots[slot_idx];
+  LNK_Stripe *stripe = &lnk_shared->stripes[stripe_idx];
+  OS_MutexScopeR(stripe->rw_mutex)
+  {
+    for(LNK_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(hash == n->hash && lnk_params_match(params, &n->params))
+      {
+        // NOTE: links below the published count are never rewritten, so
+        // they can be read while the walk is still appending past them.
+        U64 count = ins_atomic_u64_eval(&n->count);
+        Rng1U64 window = intersect_1u64(idx_range, r1u64(0, count));
+        result.count = dim_1u64(window);
+        result.v = push_array_no_zero(arena, U64, result.count);
+        for(U64 idx = window.min; idx < window.max;)
+        {
+          U64 chunk_idx = idx/LNK_CHUNK_CAP;
+          U64 chunk_off = idx%LNK_CHUNK_CAP;
+          U64 copy_count = Min(LNK_CHUNK_CAP - chunk_off, window.max - idx);
+          MemoryCopy(result.v + (idx - window.min), n->chunks[chunk_idx] + chunk_off, sizeof(U64)*copy_count);
+          idx += copy_count;
+        }
+        lnk_scope_touch_node__stripe_r_guarded(scope, n);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Walk Threads
+
+internal B32
+lnk_u2w_enqueue_req(LNK_Params *params, U64 endt_us)
+{
+  B32 good = 0;
+  OS_MutexScope(lnk_shared->u2w_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = lnk_shared->u2w_ring_write_pos - lnk_shared->u2w_ring_read_pos;
+    U64 available_size = lnk_shared->u2w_ring_size - unconsumed_size;
+    if(available_size >= sizeof(*params))
+    {
+      good = 1;
+      lnk_shared->u2w_ring_write_pos += ring_write_struct(lnk_shared->u2w_ring_base, lnk_shared->u2w_ring_size, lnk_shared->u2w_ring_write_pos, params);
+      break;
+    }
+    if(os_now_microseconds() >= endt_us)
+    {
+      break;
+    }
+    os_condition_variable_wait(lnk_shared->u2w_ring_cv, lnk_shared->u2w_ring_mutex, endt_us);
+  }
+  if(good)
+  {
+    os_condition_variable_broadcast(lnk_shared->u2w_ring_cv);
+  }
+  return good;
+}
+
+internal void
+lnk_u2w_dequeue_req(LNK_Params *params_out)
+{
+  OS_MutexScope(lnk_shared->u2w_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = lnk_shared->u2w_ring_write_pos - lnk_shared->u2w_ring_read_pos;
+    if(unconsumed_size >= sizeof(*params_out))
+    {
+      lnk_shared->u2w_ring_read_pos += ring_read_struct(lnk_shared->u2w_ring_base, lnk_shared->u2w_ring_size, lnk_shared->u2w_ring_read_pos, params_out);
+      break;
+    }
+    os_condition_variable_wait(lnk_shared->u2w_ring_cv, lnk_shared->u2w_ring_mutex, max_U64);
+  }
+  os_condition_variable_broadcast(lnk_shared->u2w_ring_cv);
+}
+
+internal void
+lnk_walk_thread__entry_point(void *p)
+{
+  ThreadNameF("[lnk] walk thread #%I64u", (U64)p);
+  for(;;)
+  {
+    //- rjf: get next request
+    LNK_Params params = {0};
+    lnk_u2w_dequeue_req(&params);
+    
+    //- rjf: unpack params
+    U64 hash = lnk_hash_from_params(&params);
+    U64 slot_idx = hash%lnk_shared->slots_count;
+    U64 stripe_idx = slot_idx%lnk_shared->stripes_count;
+    LNK_Slot *slot = &lnk_shared->slots[slot_idx];
+    LNK_Stripe *stripe = &lnk_shared->stripes[stripe_idx];
+    
+    //- rjf: take task; equip node with storage. the node cannot be evicted
+    // while it is marked as working, so it is safe to hold onto after this.
+    LNK_Node *node = 0;
+    OS_MutexScopeW(stripe->rw_mutex)
+    {
+      for(LNK_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(n->hash == hash && lnk_params_match(&n->params, &params))
+        {
+          if(!ins_atomic_u32_eval_cond_assign((U32 *)&n->is_working, 1, 0) && n->arena == 0)
+          {
+            node = n;
+            node->arena = arena_alloc();
+            node->chunks = push_array(node->arena, U64 *, LNK_CHUNKS_MAX);
+          }
+          break;
+        }
+      }
+    }
+    
+    //- rjf: walk chain
+    if(node != 0)
+    {
+      // rjf: reads are done a page at a time; links which share a page with
+      // the previous link (common for pool & arena allocators) do not need
+      // another read.
+      U8 page[LNK_PAGE_SIZE];
+      Rng1U64 page_vaddr_range = {0};
+      U64 page_read_size = 0;
+      U64 vaddr = params.first_vaddr;
+      U64 tortoise_vaddr = 0;
+      U64 tortoise_idx = 0;
+      U64 tortoise_power = 1;
+      U64 tortoise_lambda = 0;
+      U64 count = 0;
+      B32 cycle_found = 0;
+      B32 abandoned = 0;
+      for(;count < LNK_CHUNK_CAP*LNK_CHUNKS_MAX;)
+      {
+        // rjf: end of chain, or cycle detected (brent's) => done
+        if(vaddr == 0)
+        {
+          break;
+        }
+        if(vaddr == tortoise_vaddr)
+        {
+          cycle_found = 1;
+          break;
+        }
+        
+        // rjf: push link
+        U64 chunk_idx = count/LNK_CHUNK_CAP;
+        if(node->chunks[chunk_idx] == 0)
+        {
+          node->chunks[chunk_idx] = push_array_no_zero(node->arena, U64, LNK_CHUNK_CAP);
+        }
+        node->chunks[chunk_idx][count%LNK_CHUNK_CAP] = vaddr;
+        count += 1;
+        tortoise_lambda += 1;
+        if(tortoise_lambda == tortoise_power)
+        {
+          tortoise_vaddr = vaddr;
+          tortoise_idx = count-1;
+          tortoise_power *= 2;
+          tortoise_lambda = 0;
+        }
+        
+        // rjf: read next pointer
+        U64 next_vaddr = 0;
+        Rng1U64 link_vaddr_range = r1u64(vaddr + params.link_off, vaddr + params.link_off + params.link_size);
+        if(!(page_vaddr_range.min <= link_vaddr_range.min && link_vaddr_range.max <= page_vaddr_range.min+page_read_size))
+        {
+          page_vaddr_range.min = AlignDownPow2(link_vaddr_range.min, LNK_PAGE_SIZE);
+          page_vaddr_range.max = page_vaddr_range.min + LNK_PAGE_SIZE;
+          page_read_size = dmn_process_read(params.process, page_vaddr_range, page);
+        }
+        if(page_vaddr_range.min <= link_vaddr_range.min && link_vaddr_range.max <= page_vaddr_range.min+page_read_size)
+        {
+          MemoryCopy(&next_vaddr, page + (link_vaddr_range.min - page_vaddr_range.min), params.link_size);
+        }
+        else if(dmn_process_read(params.process, link_vaddr_range, &next_vaddr) != params.link_size)
+        {
+          next_vaddr = 0;
+        }
+        vaddr = next_vaddr;
+        
+        // rjf: periodically publish progress; stop if the process' memory has
+        // changed since this walk began, as this walk can no longer be used
+        if(count%1024 == 0)
+        {
+          ins_atomic_u64_eval_assign(&node->count, count);
+          if(ctrl_mem_gen() != params.mem_gen)
+          {
+            abandoned = 1;
+            break;
+          }
+        }
+      }
+      
+      // rjf: cycle found => the links pushed since the cycle's first link
+      // came around again are repeats; the cycle's length is the distance
+      // from the tortoise, so its first link is the first one which matches
+      // the link that many after it. trim everything past one full cycle.
+      if(cycle_found)
+      {
+        U64 lambda = count - tortoise_idx;
+        U64 mu = 0;
+        for(;mu < tortoise_idx; mu += 1)
+        {
+          U64 next_idx = mu + lambda;
+          U64 next_vaddr = (next_idx < count ? node->chunks[next_idx/LNK_CHUNK_CAP][next_idx%LNK_CHUNK_CAP] : vaddr);
+          if(node->chunks[mu/LNK_CHUNK_CAP][mu%LNK_CHUNK_CAP] == next_vaddr)
+          {
+            break;
+          }
+        }
+        count = mu + lambda;
+      }
+      
+      // rjf: publish final results; an abandoned walk is truncated & stale,
+      // so it is left incomplete
+      ins_atomic_u64_eval_assign(&node->count, count);
+      if(!abandoned)
+      {
+        ins_atomic_u32_eval_assign((U32 *)&node->is_complete, 1);
+      }
+      ins_atomic_u64_inc_eval(&node->load_count);
+      ins_atomic_u32_eval_assign((U32 *)&node->is_working, 0);
+    }
+  }
+}
+
+////////////////////////////////
+//~ rjf: Evictor Thread
+
+internal void
+lnk_evictor_thread__entry_point(void *p)
+{
+  ThreadNameF("[lnk] evictor thread");
+  for(;;)
+  {
+    U64 check_time_us = os_now_microseconds();
+    U64 check_time_user_clocks = lnk_user_clock_idx();
+    U64 evict_threshold_us = 10*1000000;
+    U64 evict_threshold_user_clocks = 10;
+    for(U64 slot_idx = 0; slot_idx < lnk_shared->slots_count; slot_idx += 1)
+    {
+      U64 stripe_idx = slot_idx%lnk_shared->stripes_count;
+      LNK_Slot *slot = &lnk_shared->slots[slot_idx];
+      LNK_Stripe *stripe = &lnk_shared->stripes[stripe_idx];
+      B32 slot_has_work = 0;
+      OS_MutexScopeR(stripe->rw_mutex)
+      {
+        for(LNK_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(n->scope_ref_count == 0 &&
+             n->last_time_touched_us+evict_threshold_us <= check_time_us &&
+             n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
+             n->load_count != 0 &&
+             n->is_working == 0)
+          {
+            slot_has_work = 1;
+            break;
+          }
+        }
+      }
+      if(slot_has_work) OS_MutexScopeW(stripe->rw_mutex)
+      {
+        for(LNK_Node *n = slot->first, *next = 0; n != 0; n = next)
+        {
+          next = n->next;
+          if(n->scope_ref_count == 0 &&
+             n->last_time_touched_us+evict_threshold_us <= check_time_us &&
+             n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
+             n->load_count != 0 &&
+             n->is_working == 0)
+          {
+            DLLRemove(slot->first, slot->last, n);
+            if(n->arena != 0)
+            {
+              arena_release(n->arena);
+            }
+            SLLStackPush(stripe->free_node, n);
+          }
+        }
+      }
+    }
+    os_sleep_milliseconds(100);
+  }
+}
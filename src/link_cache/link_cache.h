@@ -0,0 +1,207 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef LINK_CACHE_H
+#define LINK_CACHE_H
+
+// NOTE: This layer walks singly-linked chains in a process' memory
+// (intrusive linked lists, free lists, job queues, ...) on background
+// threads, & caches the vaddr of every link. A chain is identified by its
+// process, its first link's vaddr, the offset & size of the "next" pointer
+// within each link, and the memory generation it was walked in. Walks publish
+// partial results as they go, so users can display the first links of a very
+// long chain while the rest is still being walked, & only ever copy out the
+// window of links they need.
+
+////////////////////////////////
+//~ rjf: Limits
+
+#define LNK_CHUNK_CAP    (1<<12)
+#define LNK_CHUNKS_MAX   (1<<12)
+#define LNK_PAGE_SIZE    KB(4)
+
+////////////////////////////////
+//~ rjf: Parameters Bundle
+
+typedef struct LNK_Params LNK_Params;
+struct LNK_Params
+{
+  CTRL_MachineID machine_id;
+  DMN_Handle process;
+  U64 first_vaddr;
+  U64 link_off;
+  U64 link_size;
+  U64 mem_gen;
+};
+
+////////////////////////////////
+//~ rjf: Value Bundle Types
+
+typedef struct LNK_Info LNK_Info;
+struct LNK_Info
+{
+  U64 count;
+  B32 is_complete;
+};
+
+typedef struct LNK_VAddrArray LNK_VAddrArray;
+struct LNK_VAddrArray
+{
+  U64 *v;
+  U64 count;
+};
+
+////////////////////////////////
+//~ rjf: Cache Types
+
+typedef struct LNK_Node LNK_Node;
+struct LNK_Node
+{
+  // rjf: links
+  LNK_Node *next;
+  LNK_Node *prev;
+  
+  // rjf: key
+  U64 hash;
+  LNK_Params params;
+  
+  // rjf: value
+  Arena *arena;
+  U64 **chunks;
+  U64 count;
+  B32 is_complete;
+  
+  // rjf: metadata
+  B32 is_working;
+  U64 scope_ref_count;
+  U64 last_time_touched_us;
+  U64 last_user_clock_idx_touched;
+  U64 load_count;
+};
+
+typedef struct LNK_Slot LNK_Slot;
+struct LNK_Slot
+{
+  LNK_Node *first;
+  LNK_Node *last;
+};
+
+typedef struct LNK_Stripe LNK_Stripe;
+struct LNK_Stripe
+{
+  Arena *arena;
+  OS_Handle rw_mutex;
+  OS_Handle cv;
+  LNK_Node *free_node;
+};
+
+////////////////////////////////
+//~ rjf: Scoped Access Types
+
+typedef struct LNK_Touch LNK_Touch;
+struct LNK_Touch
+{
+  LNK_Touch *next;
+  U64 hash;
+  LNK_Params params;
+};
+
+typedef struct LNK_Scope LNK_Scope;
+struct LNK_Scope
+{
+  LNK_Scope *next;
+  LNK_Touch *top_touch;
+  U64 base_pos;
+};
+
+////////////////////////////////
+//~ rjf: Thread Context
+
+typedef struct LNK_TCTX LNK_TCTX;
+struct LNK_TCTX
+{
+  Arena *arena;
+};
+
+////////////////////////////////
+//~ rjf: Shared State
+
+typedef struct LNK_Shared LNK_Shared;
+struct LNK_Shared
+{
+  Arena *arena;
+  
+  // rjf: user clock
+  U64 user_clock_idx;
+  
+  // rjf: cache
+  U64 slots_count;
+  U64 stripes_count;
+  LNK_Slot *slots;
+  LNK_Stripe *stripes;
+  
+  // rjf: user -> walk thread
+  U64 u2w_ring_size;
+  U8 *u2w_ring_base;
+  U64 u2w_ring_write_pos;
+  U64 u2w_ring_read_pos;
+  OS_Handle u2w_ring_cv;
+  OS_Handle u2w_ring_mutex;
+  
+  // rjf: walk threads
+  U64 walk_thread_count;
+  OS_Handle *walk_threads;
+  
+  // rjf: evictor thread
+  OS_Handle evictor_thread;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+thread_static LNK_TCTX *lnk_tctx = 0;
+global LNK_Shared *lnk_shared = 0;
+
+////////////////////////////////
+//~ rjf: Parameter Type Functions
+
+internal B32 lnk_params_match(LNK_Params *a, LNK_Params *b);
+internal U64 lnk_hash_from_params(LNK_Params *params);
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void lnk_init(void);
+
+////////////////////////////////
+//~ rjf: User Clock
+
+internal void lnk_user_clock_tick(void);
+internal U64 lnk_user_clock_idx(void);
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+internal LNK_Scope *lnk_scope_open(void);
+internal void lnk_scope_close(LNK_Scope *scope);
+internal void lnk_scope_touch_node__stripe_r_guarded(LNK_Scope *scope, LNK_Node *node);
+
+////////////////////////////////
+//~ rjf: Cache Lookups
+
+internal LNK_Info lnk_info_from_params(LNK_Scope *scope, LNK_Params *params);
+internal LNK_VAddrArray lnk_vaddr_array_from_params_idx_range(Arena *arena, LNK_Scope *scope, LNK_Params *params, Rng1U64 idx_range);
+
+////////////////////////////////
+//~ rjf: Walk Threads
+
+internal B32 lnk_u2w_enqueue_req(LNK_Params *params, U64 endt_us);
+internal void lnk_u2w_dequeue_req(LNK_Params *params_out);
+internal void lnk_walk_thread__entry_point(void *p);
+
+////////////////////////////////
+//~ rjf: Evictor Thread
+
+internal void lnk_evictor_thread__entry_point(void *p);
+
+#endif // LINK_CACHE_H
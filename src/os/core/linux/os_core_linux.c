@@ -6,8 +6,11 @@
 
 global pthread_mutex_t lnx_mutex = {0};
 global Arena *lnx_perm_arena = 0;
-global LNX_Entity lnx_entity_buffer[1024];
-global LNX_Entity *lnx_entity_free = 0;
+global LNX_Entity *lnx_entity_array = 0;
+global U64 lnx_entity_array_count = 0;
+global U32 lnx_entity_chunk_states[LNX_ENTITY_CAP/LNX_ENTITY_CHUNK_SIZE] = {0};
+global U64 lnx_entity_free_head = 0;
+thread_static U32 lnx_thread_tid = 0;
 global String8 lnx_initial_path = {0};
 thread_static LNX_SafeCallChain *lnx_safe_call_chain = 0;
 
@@ -894,25 +897,359 @@ lnx_string_from_errno(int error_number){
   return(result);
 }
 
-// TODO: Marked as old / review
+// NOTE: Entities are allocated without any global lock. Freed entities
+// go on a lock-free stack, whose head packs a generation counter (high 32
+// bits) with the index+1 of the top entity (low 32 bits), so that a pop racing
+// against a pop & re-push of the same entity fails its compare-exchange. New
+// entities are bump-allocated out of a reserved array, which is committed in
+// chunks by whichever thread first reaches each chunk.
 internal LNX_Entity*
 lnx_alloc_entity(LNX_EntityKind kind){
-  pthread_mutex_lock(&lnx_mutex);
-  LNX_Entity *result = lnx_entity_free;
-  Assert(result != 0);
-  SLLStackPop(lnx_entity_free);
-  pthread_mutex_unlock(&lnx_mutex);
+  LNX_Entity *result = 0;
+  
+  // rjf: try to pop from free stack
+  U64 head = __atomic_load_n(&lnx_entity_free_head, __ATOMIC_ACQUIRE);
+  for(;(head & 0xffffffff) != 0;)
+  {
+    LNX_Entity *top = &lnx_entity_array[(head & 0xffffffff) - 1];
+    LNX_Entity *next = __atomic_load_n(&top->next, __ATOMIC_RELAXED);
+    U64 next_head = ((head >> 32) + 1) << 32;
+    if(next != 0)
+    {
+      next_head |= (U64)(next - lnx_entity_array) + 1;
+    }
+    if(__atomic_compare_exchange_n(&lnx_entity_free_head, &head, next_head, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+      result = top;
+      break;
+    }
+  }
+  
+  // rjf: free stack empty -> bump-allocate, committing the chunk if needed
+  if(result == 0)
+  {
+    U64 idx = __atomic_fetch_add(&lnx_entity_array_count, 1, __ATOMIC_RELAXED);
+    if(idx >= LNX_ENTITY_CAP)
+    {
+      abort();
+    }
+    U32 *chunk_state = &lnx_entity_chunk_states[idx/LNX_ENTITY_CHUNK_SIZE];
+    if(__atomic_load_n(chunk_state, __ATOMIC_ACQUIRE) != 2)
+    {
+      U32 expected = 0;
+      if(__atomic_compare_exchange_n(chunk_state, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      {
+        U64 chunk_size = sizeof(LNX_Entity)*LNX_ENTITY_CHUNK_SIZE;
+        U8 *chunk_base = (U8 *)&lnx_entity_array[idx - idx%LNX_ENTITY_CHUNK_SIZE];
+        U8 *commit_first = (U8 *)AlignDownPow2((U64)chunk_base, lnx_page_size);
+        U8 *commit_opl = (U8 *)AlignPow2((U64)(chunk_base + chunk_size), lnx_page_size);
+        os_commit(commit_first, (U64)(commit_opl - commit_first));
+        __atomic_store_n(chunk_state, 2, __ATOMIC_RELEASE);
+      }
+      else for(;__atomic_load_n(chunk_state, __ATOMIC_ACQUIRE) != 2;)
+      {
+        sched_yield();
+      }
+    }
+    result = &lnx_entity_array[idx];
+  }
+  
+  // rjf: fill
+  MemoryZeroStruct(result);
   result->kind = kind;
   return(result);
 }
 
-// TODO: Marked as old / review
 internal void
 lnx_free_entity(LNX_Entity *entity){
   entity->kind = LNX_EntityKind_Null;
-  pthread_mutex_lock(&lnx_mutex);
-  SLLStackPush(lnx_entity_free, entity);
-  pthread_mutex_unlock(&lnx_mutex);
+  U64 idx = (U64)(entity - lnx_entity_array);
+  U64 head = __atomic_load_n(&lnx_entity_free_head, __ATOMIC_ACQUIRE);
+  for(;;)
+  {
+    LNX_Entity *next = 0;
+    if((head & 0xffffffff) != 0)
+    {
+      next = &lnx_entity_array[(head & 0xffffffff) - 1];
+    }
+    __atomic_store_n(&entity->next, next, __ATOMIC_RELAXED);
+    U64 new_head = ((((head >> 32) + 1) << 32) | (idx + 1));
+    if(__atomic_compare_exchange_n(&lnx_entity_free_head, &head, new_head, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+      break;
+    }
+  }
+}
+
+internal B32
+lnx_process_wait_status(pid_t pid, U64 endt_us, int *status_out)
+{
+  B32 result = 0;
+  for(;;)
+  {
+    int status = 0;
+    pid_t wait_result = waitpid(pid, &status, (endt_us == max_U64) ? 0 : WNOHANG);
+    if(wait_result == pid)
+    {
+      *status_out = status;
+      result = 1;
+      break;
+    }
+    if(wait_result < 0 && errno != EINTR)
+    {
+      // NOTE: the child was already reaped (or never was ours) - report it as
+      // finished, with a status no clean exit can produce
+      *status_out = -1;
+      result = 1;
+      break;
+    }
+    if(wait_result == 0)
+    {
+      if(os_now_microseconds() >= endt_us)
+      {
+        break;
+      }
+      os_sleep_milliseconds(1);
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Futex Helpers
+
+internal B32
+lnx_futex_wait(U32 *addr, U32 expected, U64 endt_us)
+{
+  B32 result = 1;
+  if(endt_us == max_U64)
+  {
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, 0, 0, 0);
+  }
+  else
+  {
+    U64 now_us = os_now_microseconds();
+    if(now_us >= endt_us)
+    {
+      result = 0;
+    }
+    else
+    {
+      U64 wait_us = endt_us - now_us;
+      struct timespec timeout = {0};
+      timeout.tv_sec  = wait_us / Million(1);
+      timeout.tv_nsec = (wait_us % Million(1)) * Thousand(1);
+      long error = syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, &timeout, 0, 0);
+      if(error == -1 && errno == ETIMEDOUT)
+      {
+        result = 0;
+      }
+    }
+  }
+  return result;
+}
+
+internal void
+lnx_futex_wake(U32 *addr, S32 count)
+{
+  syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+}
+
+////////////////////////////////
+//~ rjf: Futex-Backed Primitive Implementations
+
+internal void
+lnx_sync_stats_record(LNX_Entity *entity, B32 contended, U64 wait_us)
+{
+#if OS_FEATURE_SYNC_STATS
+  __atomic_add_fetch(&entity->sync_stats.acquire_count, 1, __ATOMIC_RELAXED);
+  if(contended)
+  {
+    __atomic_add_fetch(&entity->sync_stats.contended_count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&entity->sync_stats.wait_us, wait_us, __ATOMIC_RELAXED);
+  }
+#endif
+}
+
+//- rjf: recursive mutexes
+
+internal void
+lnx_mutex_take(LNX_Entity *entity)
+{
+  LNX_Mutex *m = &entity->mutex;
+  if(lnx_thread_tid == 0)
+  {
+    lnx_thread_tid = (U32)os_get_tid();
+  }
+  
+  // rjf: already owned by this thread -> nest
+  if(__atomic_load_n(&m->owner_tid, __ATOMIC_RELAXED) == lnx_thread_tid)
+  {
+    m->depth += 1;
+  }
+  
+  // rjf: otherwise, 0 -> 1 on the fast path; on contention, mark as 2 (maybe
+  // waiters) & sleep until we observe 0 while swapping in 2
+  else
+  {
+    U32 c = 0;
+    if(__atomic_compare_exchange_n(&m->state, &c, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      lnx_sync_stats_record(entity, 0, 0);
+    }
+    else
+    {
+#if OS_FEATURE_SYNC_STATS
+      U64 begin_us = os_now_microseconds();
+#endif
+      if(c != 2)
+      {
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+      }
+      for(;c != 0;)
+      {
+        lnx_futex_wait(&m->state, 2, max_U64);
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+      }
+#if OS_FEATURE_SYNC_STATS
+      lnx_sync_stats_record(entity, 1, os_now_microseconds() - begin_us);
+#endif
+    }
+    __atomic_store_n(&m->owner_tid, lnx_thread_tid, __ATOMIC_RELAXED);
+    m->depth = 1;
+  }
+}
+
+internal void
+lnx_mutex_drop(LNX_Entity *entity)
+{
+  LNX_Mutex *m = &entity->mutex;
+  m->depth -= 1;
+  if(m->depth == 0)
+  {
+    __atomic_store_n(&m->owner_tid, 0, __ATOMIC_RELAXED);
+    if(__atomic_fetch_sub(&m->state, 1, __ATOMIC_RELEASE) != 1)
+    {
+      __atomic_store_n(&m->state, 0, __ATOMIC_RELEASE);
+      lnx_futex_wake(&m->state, 1);
+    }
+  }
+}
+
+//- rjf: reader/writer mutexes
+//
+// NOTE: Waiters register in waiters_count, then read wake_seq, then
+// recheck the lock state, before sleeping on wake_seq. Releasers change the
+// lock state, then bump wake_seq & wake everyone if waiters_count is nonzero.
+// With sequentially-consistent operations, either the waiter sees the release
+// in its recheck, or the releaser sees the waiter & bumps wake_seq before the
+// waiter's futex wait compares it.
+
+internal void
+lnx_rw_mutex_wake_waiters(LNX_RWMutex *m)
+{
+  if(__atomic_load_n(&m->waiters_count, __ATOMIC_SEQ_CST) != 0)
+  {
+    __atomic_add_fetch(&m->wake_seq, 1, __ATOMIC_SEQ_CST);
+    lnx_futex_wake(&m->wake_seq, max_S32);
+  }
+}
+
+internal void
+lnx_rw_mutex_take_r(LNX_Entity *entity)
+{
+  LNX_RWMutex *m = &entity->rw_mutex;
+  B32 contended = 0;
+#if OS_FEATURE_SYNC_STATS
+  U64 begin_us = 0;
+#endif
+  for(;;)
+  {
+    U32 state = __atomic_load_n(&m->state, __ATOMIC_SEQ_CST);
+    if(!(state & LNX_RW_MUTEX_WRITER_BIT) && __atomic_load_n(&m->writers_waiting, __ATOMIC_SEQ_CST) == 0)
+    {
+      if(__atomic_compare_exchange_n(&m->state, &state, state+1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+      {
+        break;
+      }
+      continue;
+    }
+#if OS_FEATURE_SYNC_STATS
+    if(!contended)
+    {
+      begin_us = os_now_microseconds();
+    }
+#endif
+    contended = 1;
+    __atomic_add_fetch(&m->waiters_count, 1, __ATOMIC_SEQ_CST);
+    U32 seq = __atomic_load_n(&m->wake_seq, __ATOMIC_SEQ_CST);
+    state = __atomic_load_n(&m->state, __ATOMIC_SEQ_CST);
+    if((state & LNX_RW_MUTEX_WRITER_BIT) || __atomic_load_n(&m->writers_waiting, __ATOMIC_SEQ_CST) != 0)
+    {
+      lnx_futex_wait(&m->wake_seq, seq, max_U64);
+    }
+    __atomic_sub_fetch(&m->waiters_count, 1, __ATOMIC_SEQ_CST);
+  }
+#if OS_FEATURE_SYNC_STATS
+  lnx_sync_stats_record(entity, contended, contended ? os_now_microseconds() - begin_us : 0);
+#endif
+}
+
+internal void
+lnx_rw_mutex_drop_r(LNX_Entity *entity)
+{
+  LNX_RWMutex *m = &entity->rw_mutex;
+  if(__atomic_sub_fetch(&m->state, 1, __ATOMIC_SEQ_CST) == 0)
+  {
+    lnx_rw_mutex_wake_waiters(m);
+  }
+}
+
+internal void
+lnx_rw_mutex_take_w(LNX_Entity *entity)
+{
+  LNX_RWMutex *m = &entity->rw_mutex;
+  B32 contended = 0;
+#if OS_FEATURE_SYNC_STATS
+  U64 begin_us = 0;
+#endif
+  __atomic_add_fetch(&m->writers_waiting, 1, __ATOMIC_SEQ_CST);
+  for(;;)
+  {
+    U32 state = 0;
+    if(__atomic_compare_exchange_n(&m->state, &state, LNX_RW_MUTEX_WRITER_BIT, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+      break;
+    }
+#if OS_FEATURE_SYNC_STATS
+    if(!contended)
+    {
+      begin_us = os_now_microseconds();
+    }
+#endif
+    contended = 1;
+    __atomic_add_fetch(&m->waiters_count, 1, __ATOMIC_SEQ_CST);
+    U32 seq = __atomic_load_n(&m->wake_seq, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&m->state, __ATOMIC_SEQ_CST) != 0)
+    {
+      lnx_futex_wait(&m->wake_seq, seq, max_U64);
+    }
+    __atomic_sub_fetch(&m->waiters_count, 1, __ATOMIC_SEQ_CST);
+  }
+  
+  // rjf: readers held back by this writer are woken when it drops the lock
+  __atomic_sub_fetch(&m->writers_waiting, 1, __ATOMIC_SEQ_CST);
+#if OS_FEATURE_SYNC_STATS
+  lnx_sync_stats_record(entity, contended, contended ? os_now_microseconds() - begin_us : 0);
+#endif
+}
+
+internal void
+lnx_rw_mutex_drop_w(LNX_Entity *entity)
+{
+  LNX_RWMutex *m = &entity->rw_mutex;
+  __atomic_store_n(&m->state, 0, __ATOMIC_SEQ_CST);
+  lnx_rw_mutex_wake_waiters(m);
 }
 
 // TODO: Marked as old / review
@@ -928,6 +1265,10 @@ lnx_thread_base(void *ptr){
   func(thread_ptr);
   tctx_release();
 
+  // signal waiters in os_thread_wait
+  __atomic_store_n(&entity->thread.is_done, 1, __ATOMIC_SEQ_CST);
+  lnx_futex_wake(&entity->thread.is_done, max_S32);
+  
   // remove my bit
   U32 result = __sync_fetch_and_and(&entity->reference_mask, ~0x2);
   // if the other bit is also gone, free entity
@@ -982,14 +1323,8 @@ os_init(void)
       abort();
     }
   }
-  MemoryZeroArray(lnx_entity_buffer);
-  {
-    LNX_Entity *ptr = lnx_entity_free = lnx_entity_buffer;
-    for (U64 i = 1; i < ArrayCount(lnx_entity_buffer); i += 1, ptr += 1){
-      ptr->next = ptr + 1;
-    }
-    ptr->next = 0;
-  }
+  // NOTE: Reserve entity storage; chunks are committed on first use
+  lnx_entity_array = (LNX_Entity *)os_reserve(sizeof(LNX_Entity)*LNX_ENTITY_CAP);
 
   // NOTE(allen): Permanent memory allocator for this layer
   Arena *perm_arena = arena_alloc();
@@ -1447,6 +1782,7 @@ os_file_open(OS_AccessFlags flags, String8 path)
 internal void
 os_file_close(OS_Handle file)
 {
+  if(os_handle_match(file, os_handle_zero())) { return; }
   S32 fd = *file.u64;
   close(fd);
 }
@@ -1589,6 +1925,19 @@ os_copy_file_path(String8 dst, String8 src)
   return success;
 }
 
+/* NOTE: rename replaces dst atomically - a concurrent reader of dst sees
+   either the old file or the new one, never a partial file. */
+internal B32
+os_move_file_path(String8 dst, String8 src)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String8 dst_copy = push_str8_copy(scratch.arena, dst);
+  String8 src_copy = push_str8_copy(scratch.arena, src);
+  B32 result = (rename((char*)src_copy.str, (char*)dst_copy.str) != -1);
+  scratch_end(scratch);
+  return result;
+}
+
 internal String8
 os_full_path_from_path(Arena *arena, String8 path)
 {
@@ -1639,11 +1988,17 @@ internal void
 os_file_map_close(OS_Handle map)
 {
   LNX_Entity* entity = lnx_entity_from_handle(map, LNX_EntityKind_MemoryMap);
-  msync(entity->map.data, entity->map.size, MS_SYNC);
-  B32 failure = munmap(entity->map.data, entity->map.size);
-  /* NOTE: It shouldn't be that important if filemap fails but it ideally shouldn't
-     happen particularly when dealing with gigabytes of memory. */
-  Assert(failure == 0);
+  /* NOTE: A view still open at close time is unmapped here; one already
+     closed has cleared its data, and must not be unmapped twice - the range
+     may have been handed out to another mapping since. */
+  if (entity->map.data != 0)
+  {
+    msync(entity->map.data, entity->map.size, MS_SYNC);
+    B32 failure = munmap(entity->map.data, entity->map.size);
+    /* NOTE: It shouldn't be that important if filemap fails but it ideally shouldn't
+       happen particularly when dealing with gigabytes of memory. */
+    Assert(failure == 0);
+  }
   lnx_free_entity(entity);
 }
 
@@ -1657,17 +2012,25 @@ os_file_map_close(OS_Handle map)
   If you would like to complete this function to work the way outlined above,
   then take the first page-boundary aligned boundary before offset.
   NOTE: You can try using MADV prefetch hints for performance. */
+// NOTE: views are not mapped with MAP_POPULATE unless asked for, via
+// OS_FileMapHintFlag_Populate - populating reads the entire range in
+// synchronously, which for a multi-GB debug info file is gigabytes of I/O
+// before the caller even looks at the header.
 internal void *
 os_file_map_view_open(OS_Handle map, OS_AccessFlags flags, Rng1U64 range)
+{
+  return os_file_map_view_open_hinted(map, flags, range, 0);
+}
+
+internal void *
+os_file_map_view_open_hinted(OS_Handle map, OS_AccessFlags flags, Rng1U64 range, OS_FileMapHintFlags hints)
 {
   LNX_Entity* entity = lnx_entity_from_handle(map, LNX_EntityKind_MemoryMap);
   if (entity == 0) { return NULL; }
 
   S32 fd = entity->map.fd;
-  struct stat file_info;
-  fstat(fd, &file_info);
-  U64 filesize = file_info.st_size;
   U64 range_size = range.max - range.min;
+  if (range_size == 0) { return NULL; }
   /* TODO(mallchad): I can't figure out how to get the exact huge page size, the
      mmap offset will just error if its not exact
   B32 use_huge = (size > os_large_page_size() && lnx_huge_page_enabled);
@@ -1677,36 +2040,77 @@ os_file_map_view_open(OS_Handle map, OS_AccessFlags flags, Rng1U64 range)
                    use_huge ?lnx_huge_sze : lnx_page_size );
   U64 page_flag = huge_use_1GB ? MAP_HUGE_1GB : MAP_HUGE_2MB;
   */
-  U64 page_size = lnx_page_size;
-  U32 page_flag = 0x0;
-  U32 map_flags = page_flag | MAP_POPULATE;
+  U32 map_flags = 0x0;
   map_flags |= (flags & OS_AccessFlag_ShareRead ? MAP_SHARED : MAP_PRIVATE);
   map_flags |= (flags & OS_AccessFlag_ShareWrite ? MAP_SHARED : MAP_PRIVATE);
+  map_flags |= (hints & OS_FileMapHintFlag_Populate ? MAP_POPULATE : 0);
 
   U32 prot_flags = lnx_prot_from_os_flags(flags);
   U64 aligned_offset = AlignDownPow2(range.min, lnx_page_size);
-  U64 view_start_from_offset = (aligned_offset % lnx_page_size);
+  U64 view_start_from_offset = (range.min - aligned_offset);
   U64 map_size = (view_start_from_offset + range_size);
 
   void *address = mmap(NULL, map_size, prot_flags, map_flags, fd, aligned_offset);
+  // Return NULL on error
+  if (address == MAP_FAILED) { return NULL; }
   entity->map.data = address;
   entity->map.size = map_size;
-  void* result = (address + view_start_from_offset);
-  // Return NULL on error
-  if (address == (void*)-1) { result = NULL; }
+  void* result = ((U8 *)address + view_start_from_offset);
+  os_file_map_view_hint(result, range_size, hints & ~OS_FileMapHintFlag_Populate);
 
   return result;
 }
 
+/* NOTE: madvise only works on page-aligned addresses, so the range is
+   widened out to page boundaries. All advice is best-effort; MADV_HUGEPAGE in
+   particular only applies to file mappings on file systems & kernels which
+   support read-only transparent huge pages, and fails harmlessly otherwise. */
+internal void
+os_file_map_view_hint(void *ptr, U64 size, OS_FileMapHintFlags hints)
+{
+  if (ptr == 0 || size == 0 || hints == 0) { return; }
+  U64 first = AlignDownPow2((U64)ptr, lnx_page_size);
+  U64 opl = AlignPow2((U64)ptr + size, lnx_page_size);
+  void *aligned_ptr = (void *)first;
+  U64 aligned_size = opl - first;
+  if (hints & OS_FileMapHintFlag_Sequential) { madvise(aligned_ptr, aligned_size, MADV_SEQUENTIAL); }
+  if (hints & OS_FileMapHintFlag_Random)     { madvise(aligned_ptr, aligned_size, MADV_RANDOM); }
+#if defined(MADV_HUGEPAGE)
+  if (hints & OS_FileMapHintFlag_LargePages) { madvise(aligned_ptr, aligned_size, MADV_HUGEPAGE); }
+#endif
+  if (hints & OS_FileMapHintFlag_WillNeed)   { madvise(aligned_ptr, aligned_size, MADV_WILLNEED); }
+  if (hints & OS_FileMapHintFlag_Populate)
+  {
+    /* MADV_POPULATE_READ (5.14+) faults the range in synchronously, like
+       MAP_POPULATE at map time; on older kernels, fall back to touching each
+       page */
+    B32 populated = 0;
+#if defined(MADV_POPULATE_READ)
+    populated = (madvise(aligned_ptr, aligned_size, MADV_POPULATE_READ) == 0);
+#endif
+    if (!populated)
+    {
+      volatile U8 sink = 0;
+      for (U64 off = 0; off < aligned_size; off += lnx_page_size)
+      {
+        sink ^= ((volatile U8 *)aligned_ptr)[off];
+      }
+      (void)sink;
+    }
+  }
+}
+
 internal void
 os_file_map_view_close(OS_Handle map, void *ptr)
 {
   LNX_Entity* entity = lnx_entity_from_handle(map, LNX_EntityKind_MemoryMap);
-  AssertAlways( entity->map.data && (entity->map.data != (void*)-1) );
+  if (entity->map.data == 0) { return; }
   /* NOTE: Make sure contents are synced with OS on the off chance the backing
      file isn't POSIX compliant. Use MS_ASYNC if you want performance. */
   msync(entity->map.data, entity->map.size, MS_SYNC);
   munmap(entity->map.data, entity->map.size);
+  entity->map.data = 0;
+  entity->map.size = 0;
 }
 
 //- rjf: directory iteration
@@ -1950,66 +2354,167 @@ os_sleep_milliseconds(U32 msec){
 ////////////////////////////////
 //~ rjf: @os_hooks Child Processes (Implemented Per-OS)
 
-/* NOTE: A terminal can be opened for any process but there is no default
- terminal emulator on Linux, so instead you Have to cycle through a bunch of
- common ones (there aren't that many). There is the XDG desktop specification
- but that's a little bit of a chore to parse and its not even always present.
-
-The environment is inhereited by default but is easy to change in the future
-with an execl variant. */
 internal B32
 os_launch_process(OS_LaunchOptions *options, OS_Handle *handle_out)
 {
   Temp scratch = scratch_begin(0, 0);
-  U8* buffer = (void*)mmap(NULL, 4096, PROT_READ | PROT_WRITE,
-                           MAP_SHARED | MAP_ANONYMOUS, -1, 0);
-  B32* success_shared = (B32*)buffer;
-  S32* child_pid = (S32*)buffer+4;
-  *success_shared = 1;
-  *child_pid = 0;
-  // TODO(allen): I want to redo this API before I bother implementing it here
-  // TODO(mallchad): Is this comment still relevant? gut says yes.
-  String8List cmdline_list = options->cmd_line;
-  char** cmdline = (char**)push_array(scratch.arena, char*, cmdline_list.node_count + 4);
-  String8Node* x_node = cmdline_list.first;
-  for (int i=0; i<cmdline_list.node_count; ++i)
+  B32 result = 0;
+  
+  //- rjf: build null-terminated argument & environment arrays
+  char **argv = push_array(scratch.arena, char *, options->cmd_line.node_count+1);
   {
-    cmdline[i] = (char*)x_node->string.str;
-    x_node = x_node->next;
+    U64 idx = 0;
+    for(String8Node *n = options->cmd_line.first; n != 0; n = n->next, idx += 1)
+    {
+      argv[idx] = (char *)push_str8_copy(scratch.arena, n->string).str;
+    }
   }
-
-  if (options->inherit_env) { NotImplemented; };
-  if (options->consoleless == 0) { NotImplemented; };
-  S32 pid = 0;
-  pid = fork();
-  // Child
-  if (pid)
+  String8List env_list = options->env;
+  if(options->inherit_env)
+  {
+    MemoryZeroStruct(&env_list);
+    for(String8Node *n = options->env.first; n != 0; n = n->next)
+    {
+      str8_list_push(scratch.arena, &env_list, n->string);
+    }
+    for(String8Node *n = lnx_environment.first; n != 0; n = n->next)
+    {
+      str8_list_push(scratch.arena, &env_list, n->string);
+    }
+  }
+  char **envp = push_array(scratch.arena, char *, env_list.node_count+1);
+  {
+    U64 idx = 0;
+    for(String8Node *n = env_list.first; n != 0; n = n->next, idx += 1)
+    {
+      envp[idx] = (char *)push_str8_copy(scratch.arena, n->string).str;
+    }
+  }
+  char *dir = (options->path.size != 0) ? (char *)push_str8_copy(scratch.arena, options->path).str : 0;
+  
+  //- rjf: resolve the executable - a bare name is looked up in the working
+  // directory first, then on PATH
+  String8 exe_path = {0};
+  if(argv[0] != 0)
+  {
+    String8 name = str8_cstring(argv[0]);
+    if(str8_find_needle(name, 0, str8_lit("/"), 0) < name.size)
+    {
+      exe_path = name;
+    }
+    else
+    {
+      String8List search_dirs = {0};
+      if(options->path.size != 0)
+      {
+        str8_list_push(scratch.arena, &search_dirs, options->path);
+      }
+      char *path_env = getenv("PATH");
+      if(path_env != 0)
+      {
+        U8 split_char = ':';
+        String8List path_dirs = str8_split(scratch.arena, str8_cstring(path_env), &split_char, 1, 0);
+        str8_list_concat_in_place(&search_dirs, &path_dirs);
+      }
+      for(String8Node *n = search_dirs.first; n != 0; n = n->next)
+      {
+        String8 candidate = push_str8f(scratch.arena, "%S/%S", n->string, name);
+        if(access((char *)candidate.str, X_OK) == 0)
+        {
+          exe_path = candidate;
+          break;
+        }
+      }
+    }
+  }
+  
+  //- rjf: fork & exec - the child reports an exec failure's errno over a
+  // close-on-exec pipe, so an empty read means the exec went through
+  int report_fds[2] = {-1, -1};
+  if(exe_path.size != 0 && pipe(report_fds) == 0)
   {
-    *child_pid = pid;
-    if (child_pid > 0) { *(handle_out->u64) = (U64)child_pid; }
-    execv(*cmdline, cmdline);
-    *success_shared = 0;
-    exit(0);
-  } // Parent
-  else { waitpid(*child_pid, NULL, 0x0); } // TODO: Heck? Can't figure out how to wait on 'exec'
-  os_sleep_milliseconds(20);              // Getto fix for no-wait issue
-  B32 success = *success_shared;
-  munmap(success_shared, 4096);
+    fcntl(report_fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(report_fds[1], F_SETFD, FD_CLOEXEC);
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+      int error = 0;
+      if(dir != 0 && chdir(dir) != 0)
+      {
+        error = errno;
+      }
+      else
+      {
+        execve((char *)exe_path.str, argv, envp);
+        error = errno;
+      }
+      write(report_fds[1], &error, sizeof(error));
+      _exit(127);
+    }
+    close(report_fds[1]);
+    if(pid > 0)
+    {
+      int error = 0;
+      ssize_t read_size = 0;
+      do
+      {
+        read_size = read(report_fds[0], &error, sizeof(error));
+      } while(read_size < 0 && errno == EINTR);
+      if(read_size == 0)
+      {
+        result = 1;
+        if(handle_out != 0)
+        {
+          handle_out->u64[0] = (U64)pid;
+        }
+      }
+      else
+      {
+        int status = 0;
+        waitpid(pid, &status, 0);
+      }
+    }
+    close(report_fds[0]);
+  }
+  
   scratch_end(scratch);
-  return success;
+  return result;
 }
 
 internal B32
 os_process_wait(OS_Handle handle, U64 endt_us)
 {
-  NotImplemented;
-  return 0;
+  int status = 0;
+  B32 result = lnx_process_wait_status((pid_t)handle.u64[0], endt_us, &status);
+  return result;
+}
+
+internal B32
+os_process_wait_exit_code(OS_Handle handle, U64 endt_us, U64 *exit_code_out)
+{
+  int status = 0;
+  B32 result = lnx_process_wait_status((pid_t)handle.u64[0], endt_us, &status);
+  if(result)
+  {
+    if(status != -1 && WIFEXITED(status))
+    {
+      *exit_code_out = WEXITSTATUS(status);
+    }
+    else
+    {
+      *exit_code_out = max_U64;
+    }
+  }
+  return result;
 }
 
 internal void
 os_process_release_handle(OS_Handle handle)
 {
-  NotImplemented;
+  // NOTE: reap the child if it already exited, so it does not linger as a
+  // zombie; one still running is left to run on
+  int status = 0;
+  waitpid((pid_t)handle.u64[0], &status, WNOHANG);
 }
 
 ////////////////////////////////
@@ -2043,10 +2548,25 @@ os_launch_thread(OS_ThreadFunctionType *func, void *ptr, void *params){
 internal B32
 os_thread_wait(OS_Handle handle, U64 endt_us)
 {
-  // TODO: Supposed to be thread sleep?
   LNX_Entity* entity = lnx_entity_from_handle(handle, LNX_EntityKind_Thread);
-  NotImplemented;
-  return 0;
+  
+  // wait for the thread function to return; only then join, which no longer
+  // blocks for long, so no timed (non-portable) join is needed
+  B32 result = 1;
+  for (;__atomic_load_n(&entity->thread.is_done, __ATOMIC_SEQ_CST) == 0;)
+  {
+    if (!lnx_futex_wait(&entity->thread.is_done, 0, endt_us))
+    {
+      result = (__atomic_load_n(&entity->thread.is_done, __ATOMIC_SEQ_CST) != 0);
+      break;
+    }
+  }
+  U32 expected = 1;
+  if (result && __atomic_compare_exchange_n(&entity->thread.is_done, &expected, 2, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+  {
+    pthread_join(entity->thread.handle, 0);
+  }
+  return result;
 }
 
 // TODO: Marked as old / review
@@ -2071,43 +2591,27 @@ os_release_thread_handle(OS_Handle thread){
 
 internal OS_Handle
 os_mutex_alloc(void){
-  // entity
   LNX_Entity *entity = lnx_alloc_entity(LNX_EntityKind_Mutex);
-
-  // pthread
-  pthread_mutexattr_t attr;
-  pthread_mutexattr_init(&attr);
-  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-  int pthread_result = pthread_mutex_init(&entity->mutex, &attr);
-  pthread_mutexattr_destroy(&attr);
-  if (pthread_result == -1){
-    lnx_free_entity(entity);
-    entity = 0;
-  }
-
-  // cast to opaque handle
-  OS_Handle result = {IntFromPtr(entity)};
+  OS_Handle result = lnx_handle_from_entity(entity);
   return(result);
 }
 
 internal void
 os_mutex_release(OS_Handle mutex){
-  LNX_Entity *entity = (LNX_Entity*)PtrFromInt(mutex.u64[0]);
-  pthread_mutex_destroy(&entity->mutex);
+  LNX_Entity *entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Mutex);
   lnx_free_entity(entity);
 }
 
 internal void
 os_mutex_take_(OS_Handle mutex){
-  LNX_Entity *entity = (LNX_Entity*)PtrFromInt(mutex.u64[0]);
-  S32 error = 0;
-  while(error = pthread_mutex_lock(&entity->mutex)) { }
+  LNX_Entity *entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Mutex);
+  lnx_mutex_take(entity);
 }
 
 internal void
 os_mutex_drop_(OS_Handle mutex){
-  LNX_Entity *entity = (LNX_Entity*)PtrFromInt(mutex.u64[0]);
-  pthread_mutex_unlock(&entity->mutex);
+  LNX_Entity *entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Mutex);
+  lnx_mutex_drop(entity);
 }
 
 //- rjf: reader/writer mutexes
@@ -2115,21 +2619,8 @@ os_mutex_drop_(OS_Handle mutex){
 internal OS_Handle
 os_rw_mutex_alloc(void)
 {
-  OS_Handle result = {0};
-  LNX_rwlock_attr attr;
-  pthread_rwlockattr_init(&attr);
-  pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_PRIVATE);
-  LNX_rwlock rwlock = {0};
-  int pthread_result = pthread_rwlock_init(&rwlock, &attr);
-  // This can be cleaned up now.
-  pthread_rwlockattr_destroy(&attr);
-
-  if (pthread_result == 0)
-  {
-      LNX_Entity *entity = lnx_alloc_entity(LNX_EntityKind_Rwlock);
-      entity->rwlock = rwlock;
-      *result.u64 = IntFromPtr(entity);
-  }
+  LNX_Entity *entity = lnx_alloc_entity(LNX_EntityKind_Rwlock);
+  OS_Handle result = lnx_handle_from_entity(entity);
   return result;
 }
 
@@ -2137,125 +2628,199 @@ internal void
 os_rw_mutex_release(OS_Handle rw_mutex)
 {
   LNX_Entity* entity = lnx_entity_from_handle(rw_mutex, LNX_EntityKind_Rwlock);
-  pthread_rwlock_destroy(&entity->rwlock);
+  lnx_free_entity(entity);
 }
 
 internal void
 os_rw_mutex_take_r_(OS_Handle mutex)
 {
-  // Is blocking varient
   LNX_Entity* entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Rwlock);
-  pthread_rwlock_rdlock(&entity->rwlock);
+  lnx_rw_mutex_take_r(entity);
 }
 
 internal void
 os_rw_mutex_drop_r_(OS_Handle mutex)
 {
-  // NOTE: Aparently it results in undefined behaviour if there is no pre-existing lock
-  // https://pubs.opengroup.org/onlinepubs/7908799/xsh/pthread_rwlock_unlock.html
   LNX_Entity* entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Rwlock);
-  pthread_rwlock_unlock(&entity->rwlock);
+  lnx_rw_mutex_drop_r(entity);
 }
 
 internal void
 os_rw_mutex_take_w_(OS_Handle mutex)
 {
-    LNX_Entity* entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Rwlock);
-  pthread_rwlock_wrlock(&(entity->rwlock));
+  LNX_Entity* entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Rwlock);
+  lnx_rw_mutex_take_w(entity);
 }
 
 internal void
 os_rw_mutex_drop_w_(OS_Handle mutex)
 {
   LNX_Entity* entity = lnx_entity_from_handle(mutex, LNX_EntityKind_Rwlock);
-  pthread_rwlock_unlock(&(entity->rwlock));
+  lnx_rw_mutex_drop_w(entity);
 }
 
 //- rjf: condition variables
+//
+// NOTE: Waiters register themselves & read the sequence number while
+// still holding the mutex, so a signal which follows a state change made under
+// the same mutex always either bumps the sequence number before the futex
+// wait (which then returns immediately) or wakes the waiter.
 
 internal OS_Handle
 os_condition_variable_alloc(void){
-  // entity
   LNX_Entity *entity = lnx_alloc_entity(LNX_EntityKind_ConditionVariable);
-
-  // pthread
-  pthread_condattr_t attr;
-  pthread_condattr_init(&attr);
-  // Make sure condition uses CPU clock time
-  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC_RAW);
-  pthread_condattr_setpshared(&attr, PTHREAD_PROCESS_PRIVATE);
-  pthread_condattr_destroy(&attr);
-  int pthread_result = pthread_cond_init(&entity->cond, &attr);
-  if (pthread_result == -1){
-    lnx_free_entity(entity);
-    entity = 0;
-  }
-
-  // cast to opaque handle
-  OS_Handle result = {IntFromPtr(entity)};
+  OS_Handle result = lnx_handle_from_entity(entity);
   return(result);
 }
 
 internal void
 os_condition_variable_release(OS_Handle cv){
-  LNX_Entity *entity = (LNX_Entity*)PtrFromInt(cv.u64[0]);
-  pthread_cond_destroy(&entity->cond);
+  LNX_Entity *entity = lnx_entity_from_handle(cv, LNX_EntityKind_ConditionVariable);
   lnx_free_entity(entity);
 }
 
 internal B32
 os_condition_variable_wait_(OS_Handle cv, OS_Handle mutex, U64 endt_us){
-  B32 result = 0;
   LNX_Entity *entity_cond = lnx_entity_from_handle(cv, LNX_EntityKind_ConditionVariable);
   LNX_Entity *entity_mutex = lnx_entity_from_handle(mutex, LNX_EntityKind_Mutex);
-  LNX_timespec timeout_stamp = lnx_now_precision_timespec();
-  timeout_stamp.tv_nsec += endt_us * 1000;
-
-  // The timeout is received as a system clock timespec of when to stop waiting
-  pthread_cond_timedwait(&entity_cond->cond, &entity_mutex->mutex, &timeout_stamp);
+  LNX_ConditionVariable *c = &entity_cond->cv;
+  __atomic_add_fetch(&c->waiters_count, 1, __ATOMIC_SEQ_CST);
+  U32 seq = __atomic_load_n(&c->seq, __ATOMIC_SEQ_CST);
+  
+  // rjf: fully unlock the (recursive) mutex, wait, then restore its depth
+  U32 depth = entity_mutex->mutex.depth;
+  entity_mutex->mutex.depth = 1;
+  lnx_mutex_drop(entity_mutex);
+  B32 result = lnx_futex_wait(&c->seq, seq, endt_us);
+  lnx_mutex_take(entity_mutex);
+  entity_mutex->mutex.depth = depth;
+  
+  __atomic_sub_fetch(&c->waiters_count, 1, __ATOMIC_SEQ_CST);
   return(result);
 }
 
 internal B32
 os_condition_variable_wait_rw_r_(OS_Handle cv, OS_Handle mutex_rw, U64 endt_us)
 {
-  B32 result = 0;
   LNX_Entity *entity_cond = lnx_entity_from_handle(cv, LNX_EntityKind_ConditionVariable);
-  LNX_Entity *entity_mutex = lnx_entity_from_handle(mutex_rw, LNX_EntityKind_Mutex);
-  LNX_timespec timeout_stamp = lnx_now_precision_timespec();
-  timeout_stamp.tv_nsec += endt_us * 1000;
-
-  // The timeout is received as a MONOTONIC_RAW clock timespec of when to stop waiting
-  pthread_cond_timedwait(&entity_cond->cond, &entity_mutex->mutex, &timeout_stamp);
-  return (result == 0);
+  LNX_Entity *entity_mutex = lnx_entity_from_handle(mutex_rw, LNX_EntityKind_Rwlock);
+  LNX_ConditionVariable *c = &entity_cond->cv;
+  __atomic_add_fetch(&c->waiters_count, 1, __ATOMIC_SEQ_CST);
+  U32 seq = __atomic_load_n(&c->seq, __ATOMIC_SEQ_CST);
+  lnx_rw_mutex_drop_r(entity_mutex);
+  B32 result = lnx_futex_wait(&c->seq, seq, endt_us);
+  lnx_rw_mutex_take_r(entity_mutex);
+  __atomic_sub_fetch(&c->waiters_count, 1, __ATOMIC_SEQ_CST);
+  return result;
 }
 
 internal B32
 os_condition_variable_wait_rw_w_(OS_Handle cv, OS_Handle mutex_rw, U64 endt_us)
 {
-   B32 result = 0;
   LNX_Entity *entity_cond = lnx_entity_from_handle(cv, LNX_EntityKind_ConditionVariable);
-  LNX_Entity *entity_mutex = lnx_entity_from_handle(mutex_rw, LNX_EntityKind_Mutex);
-  LNX_timespec timeout_stamp = lnx_now_precision_timespec();
-  timeout_stamp.tv_nsec += endt_us * 1000;
-
-  // The timeout is received as a MONOTONIC_RAW clock timespec of when to stop waiting
-  result = pthread_cond_timedwait(&entity_cond->cond, &entity_mutex->mutex, &timeout_stamp);
-  return (result == 0);
+  LNX_Entity *entity_mutex = lnx_entity_from_handle(mutex_rw, LNX_EntityKind_Rwlock);
+  LNX_ConditionVariable *c = &entity_cond->cv;
+  __atomic_add_fetch(&c->waiters_count, 1, __ATOMIC_SEQ_CST);
+  U32 seq = __atomic_load_n(&c->seq, __ATOMIC_SEQ_CST);
+  lnx_rw_mutex_drop_w(entity_mutex);
+  B32 result = lnx_futex_wait(&c->seq, seq, endt_us);
+  lnx_rw_mutex_take_w(entity_mutex);
+  __atomic_sub_fetch(&c->waiters_count, 1, __ATOMIC_SEQ_CST);
+  return result;
 }
 
 internal void
 os_condition_variable_signal_(OS_Handle cv)
 {
   LNX_Entity *entity = lnx_entity_from_handle(cv, LNX_EntityKind_ConditionVariable);
-  pthread_cond_signal(&entity->cond);
+  __atomic_add_fetch(&entity->cv.seq, 1, __ATOMIC_SEQ_CST);
+  if(__atomic_load_n(&entity->cv.waiters_count, __ATOMIC_SEQ_CST) != 0)
+  {
+    lnx_futex_wake(&entity->cv.seq, 1);
+  }
 }
 
 internal void
 os_condition_variable_broadcast_(OS_Handle cv)
 {
   LNX_Entity *entity = lnx_entity_from_handle(cv, LNX_EntityKind_ConditionVariable);
-  pthread_cond_broadcast(&entity->cond);
+  __atomic_add_fetch(&entity->cv.seq, 1, __ATOMIC_SEQ_CST);
+  if(__atomic_load_n(&entity->cv.waiters_count, __ATOMIC_SEQ_CST) != 0)
+  {
+    lnx_futex_wake(&entity->cv.seq, max_S32);
+  }
+}
+
+//- rjf: one-shot latches
+
+internal OS_Handle
+os_latch_alloc(void)
+{
+  LNX_Entity *entity = lnx_alloc_entity(LNX_EntityKind_Latch);
+  OS_Handle result = lnx_handle_from_entity(entity);
+  return result;
+}
+
+internal void
+os_latch_release(OS_Handle latch)
+{
+  LNX_Entity *entity = lnx_entity_from_handle(latch, LNX_EntityKind_Latch);
+  lnx_free_entity(entity);
+}
+
+internal void
+os_latch_signal(OS_Handle latch)
+{
+  LNX_Entity *entity = lnx_entity_from_handle(latch, LNX_EntityKind_Latch);
+  if(__atomic_exchange_n(&entity->latch.state, 1, __ATOMIC_SEQ_CST) == 0)
+  {
+    lnx_futex_wake(&entity->latch.state, max_S32);
+  }
+}
+
+internal B32
+os_latch_wait(OS_Handle latch, U64 endt_us)
+{
+  LNX_Entity *entity = lnx_entity_from_handle(latch, LNX_EntityKind_Latch);
+  B32 result = 1;
+  if(__atomic_load_n(&entity->latch.state, __ATOMIC_ACQUIRE) == 0)
+  {
+#if OS_FEATURE_SYNC_STATS
+    U64 begin_us = os_now_microseconds();
+#endif
+    for(;__atomic_load_n(&entity->latch.state, __ATOMIC_ACQUIRE) == 0;)
+    {
+      if(!lnx_futex_wait(&entity->latch.state, 0, endt_us))
+      {
+        result = (__atomic_load_n(&entity->latch.state, __ATOMIC_ACQUIRE) != 0);
+        break;
+      }
+    }
+#if OS_FEATURE_SYNC_STATS
+    lnx_sync_stats_record(entity, 1, os_now_microseconds() - begin_us);
+#endif
+  }
+  else
+  {
+    lnx_sync_stats_record(entity, 0, 0);
+  }
+  return result;
+}
+
+//- rjf: contention stats
+
+internal OS_SyncStats
+os_sync_stats_from_handle(OS_Handle handle)
+{
+  OS_SyncStats result = {0};
+  LNX_Entity *entity = (LNX_Entity *)PtrFromInt(handle.u64[0]);
+  if(entity != 0)
+  {
+    result.acquire_count   = __atomic_load_n(&entity->sync_stats.acquire_count, __ATOMIC_RELAXED);
+    result.contended_count = __atomic_load_n(&entity->sync_stats.contended_count, __ATOMIC_RELAXED);
+    result.wait_us         = __atomic_load_n(&entity->sync_stats.wait_us, __ATOMIC_RELAXED);
+  }
+  return result;
 }
 
 //- rjf: cross-process semaphores
@@ -2309,10 +2874,7 @@ os_semaphore_close(OS_Handle semaphore)
 internal B32
 os_semaphore_take(OS_Handle semaphore, U64 endt_us)
 {
-  U32 wait_result = 0;
-  LNX_timespec wait_until = lnx_now_precision_timespec();
-  wait_until.tv_nsec += endt_us;
-
+  S32 wait_result = 0;
   LNX_Entity* entity = lnx_entity_from_handle(semaphore, LNX_EntityKind_Semaphore);
   LNX_semaphore* _semaphore = entity->semaphore.handle;
   // We have to impliment max_count ourselves
@@ -2320,7 +2882,26 @@ os_semaphore_take(OS_Handle semaphore, U64 endt_us)
   sem_getvalue(_semaphore, &current_value);
   if (entity->semaphore.max_value > current_value)
   {
-    sem_timedwait(_semaphore, &wait_until);
+    if (endt_us == max_U64)
+    {
+      for (;(wait_result = sem_wait(_semaphore)) == -1 && errno == EINTR;) {}
+    }
+    else
+    {
+      // NOTE: sem_timedwait takes an absolute CLOCK_REALTIME deadline, but
+      // endt_us is in the os_now_microseconds (monotonic) timebase
+      U64 now_us = os_now_microseconds();
+      U64 wait_us = (endt_us > now_us ? endt_us - now_us : 0);
+      LNX_timespec wait_until = lnx_now_system_timespec();
+      wait_until.tv_sec += wait_us / Million(1);
+      wait_until.tv_nsec += (wait_us % Million(1)) * Thousand(1);
+      if (wait_until.tv_nsec >= Billion(1))
+      {
+        wait_until.tv_sec += 1;
+        wait_until.tv_nsec -= Billion(1);
+      }
+      for (;(wait_result = sem_timedwait(_semaphore, &wait_until)) == -1 && errno == EINTR;) {}
+    }
   }
   return (wait_result != -1);
 }
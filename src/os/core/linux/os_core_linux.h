@@ -11,6 +11,7 @@
 #include <dlfcn.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <linux/futex.h>
 #include <linux/limits.h>
 #include <linux/memfd.h>
 #include <linux/mman.h>
@@ -57,9 +58,52 @@ typedef pthread_t LNX_thread;
 typedef sem_t LNX_semaphore;
 typedef pthread_mutex_t LNX_mutex;
 typedef pthread_mutexattr_t LNX_mutex_attr;
-typedef pthread_rwlock_t LNX_rwlock;
-typedef pthread_rwlockattr_t LNX_rwlock_attr;
-typedef pthread_cond_t LNX_cond;
+
+////////////////////////////////
+//~ rjf: Futex-Backed Synchronization Primitives
+//
+// NOTE: All waits are on 32-bit futex words, with private (in-process)
+// futex operations. Timeouts are absolute deadlines in the os_now_microseconds
+// timebase, which are converted to a relative timeout before each wait.
+
+// rjf: recursive mutex - state is 0 (unlocked), 1 (locked, no waiters), or 2
+// (locked, maybe waiters)
+typedef struct LNX_Mutex LNX_Mutex;
+struct LNX_Mutex
+{
+  U32 state;
+  U32 owner_tid;
+  U32 depth;
+};
+
+// rjf: reader/writer mutex - state holds the reader count & a writer bit.
+// readers do not enter while writers are waiting, so writers are not starved.
+// waiters sleep on wake_seq, which is bumped by every release.
+#define LNX_RW_MUTEX_WRITER_BIT (1u<<31)
+typedef struct LNX_RWMutex LNX_RWMutex;
+struct LNX_RWMutex
+{
+  U32 state;
+  U32 writers_waiting;
+  U32 waiters_count;
+  U32 wake_seq;
+};
+
+// rjf: condition variable - waiters sleep on seq, which is bumped by every
+// signal/broadcast
+typedef struct LNX_ConditionVariable LNX_ConditionVariable;
+struct LNX_ConditionVariable
+{
+  U32 seq;
+  U32 waiters_count;
+};
+
+// rjf: one-shot latch - state is 0 until signaled, then 1 forever
+typedef struct LNX_Latch LNX_Latch;
+struct LNX_Latch
+{
+  U32 state;
+};
 
 ////////////////////////////////
 //~ NOTE(allen): Threading Entities
@@ -70,20 +114,26 @@ enum LNX_EntityKind{
   LNX_EntityKind_Mutex,
   LNX_EntityKind_Rwlock,
   LNX_EntityKind_ConditionVariable,
+  LNX_EntityKind_Latch,
   LNX_EntityKind_Semaphore,
   LNX_EntityKind_MemoryMap,
 };
 
+#define LNX_ENTITY_CAP        (1<<20)
+#define LNX_ENTITY_CHUNK_SIZE 4096
+
 typedef struct LNX_Entity LNX_Entity;
 struct LNX_Entity{
   LNX_Entity *next;
   LNX_EntityKind kind;
   volatile U32 reference_mask;
+  OS_SyncStats sync_stats;
   union{
     struct{
       OS_ThreadFunctionType *func;
       void *ptr;
       pthread_t handle;
+      U32 is_done; // 0: running, 1: returned, 2: returned & joined
     } thread;
     struct{
       sem_t* handle;
@@ -96,9 +146,10 @@ struct LNX_Entity{
       U64 size;
       String8 shm_name;
     } map;
-    LNX_mutex mutex;
-    LNX_rwlock rwlock;
-    LNX_cond cond;
+    LNX_Mutex mutex;
+    LNX_RWMutex rw_mutex;
+    LNX_ConditionVariable cv;
+    LNX_Latch latch;
   };
 };
 
@@ -167,6 +218,21 @@ internal String8 lnx_string_from_errno(int error_number);
 
 internal LNX_Entity* lnx_alloc_entity(LNX_EntityKind kind);
 internal void lnx_free_entity(LNX_Entity *entity);
+internal B32 lnx_process_wait_status(pid_t pid, U64 endt_us, int *status_out);
+
+// Futex helpers - waits return 0 on timeout, 1 otherwise
+internal B32 lnx_futex_wait(U32 *addr, U32 expected, U64 endt_us);
+internal void lnx_futex_wake(U32 *addr, S32 count);
+
+// Futex-backed primitive implementations
+internal void lnx_mutex_take(LNX_Entity *entity);
+internal void lnx_mutex_drop(LNX_Entity *entity);
+internal void lnx_rw_mutex_wake_waiters(LNX_RWMutex *m);
+internal void lnx_rw_mutex_take_r(LNX_Entity *entity);
+internal void lnx_rw_mutex_drop_r(LNX_Entity *entity);
+internal void lnx_rw_mutex_take_w(LNX_Entity *entity);
+internal void lnx_rw_mutex_drop_w(LNX_Entity *entity);
+internal void lnx_sync_stats_record(LNX_Entity *entity, B32 contended, U64 wait_us);
 internal void* lnx_thread_base(void *ptr);
 
 internal void lnx_safe_call_sig_handler(int _);
@@ -18,6 +18,24 @@ enum
   OS_AccessFlag_ShareWrite = (1<<5),
 };
 
+////////////////////////////////
+//~ rjf: File Map Hint Flags
+
+// NOTE: Hints for how a file map view will be accessed. They never change
+// what a view contains, only how eagerly & in what order its pages are read in.
+// With no hints, pages are faulted in on first touch, with the OS' default
+// readahead.
+
+typedef U32 OS_FileMapHintFlags;
+enum
+{
+  OS_FileMapHintFlag_Sequential = (1<<0), // aggressive readahead; pages behind the reader may be dropped early
+  OS_FileMapHintFlag_Random     = (1<<1), // no readahead; only touched pages are read
+  OS_FileMapHintFlag_WillNeed   = (1<<2), // start reading the whole range in asynchronously
+  OS_FileMapHintFlag_Populate   = (1<<3), // read the whole range in before returning
+  OS_FileMapHintFlag_LargePages = (1<<4), // back with large pages, if the OS & file system allow it
+};
+
 ////////////////////////////////
 //~ allen: Files
 
@@ -148,6 +166,19 @@ StaticAssert(sizeof(OS_Guid) == 16, os_guid_check);
 
 typedef void OS_ThreadFunctionType(void *ptr);
 
+////////////////////////////////
+//~ rjf: Synchronization Primitive Contention Stats
+
+// NOTE: Only gathered when OS_FEATURE_SYNC_STATS is enabled, and only on
+// backends which implement their own primitives; otherwise always zeroed.
+typedef struct OS_SyncStats OS_SyncStats;
+struct OS_SyncStats
+{
+  U64 acquire_count;
+  U64 contended_count;
+  U64 wait_us;
+};
+
 ////////////////////////////////
 //~ rjf: Handle Type Functions (Helpers, Implemented Once)
 
@@ -259,6 +290,7 @@ internal FileProperties os_properties_from_file(OS_Handle file);
 internal OS_FileID      os_id_from_file(OS_Handle file);
 internal B32            os_delete_file_at_path(String8 path);
 internal B32            os_copy_file_path(String8 dst, String8 src);
+internal B32            os_move_file_path(String8 dst, String8 src);
 internal String8        os_full_path_from_path(Arena *arena, String8 path);
 internal B32            os_file_path_exists(String8 path);
 internal FileProperties os_properties_from_file_path(String8 path);
@@ -267,6 +299,8 @@ internal FileProperties os_properties_from_file_path(String8 path);
 internal OS_Handle os_file_map_open(OS_AccessFlags flags, OS_Handle file);
 internal void      os_file_map_close(OS_Handle map);
 internal void *    os_file_map_view_open(OS_Handle map, OS_AccessFlags flags, Rng1U64 range);
+internal void *    os_file_map_view_open_hinted(OS_Handle map, OS_AccessFlags flags, Rng1U64 range, OS_FileMapHintFlags hints);
+internal void      os_file_map_view_hint(void *ptr, U64 size, OS_FileMapHintFlags hints);
 internal void      os_file_map_view_close(OS_Handle map, void *ptr);
 
 //- rjf: directory iteration
@@ -301,6 +335,7 @@ internal void        os_sleep_milliseconds(U32 msec);
 
 internal B32   os_launch_process(OS_LaunchOptions *options, OS_Handle *handle_out);
 internal B32   os_process_wait(OS_Handle handle, U64 endt_us);
+internal B32   os_process_wait_exit_code(OS_Handle handle, U64 endt_us, U64 *exit_code_out);
 internal void  os_process_release_handle(OS_Handle handle);
 
 ////////////////////////////////
@@ -340,6 +375,16 @@ internal B32       os_condition_variable_wait_rw_w_(OS_Handle cv, OS_Handle mute
 internal void      os_condition_variable_signal_(OS_Handle cv);
 internal void      os_condition_variable_broadcast_(OS_Handle cv);
 
+//- rjf: one-shot latches (signaled once, then stay signaled; waits return
+// false on timeout, true on signal, (endt_us = max_U64) -> no timeout)
+internal OS_Handle os_latch_alloc(void);
+internal void      os_latch_release(OS_Handle latch);
+internal void      os_latch_signal(OS_Handle latch);
+internal B32       os_latch_wait(OS_Handle latch, U64 endt_us);
+
+//- rjf: contention stats (for any of the above primitives)
+internal OS_SyncStats os_sync_stats_from_handle(OS_Handle handle);
+
 //- rjf: cross-process semaphores
 internal OS_Handle os_semaphore_alloc(U32 initial_count, U32 max_count, String8 name);
 internal void      os_semaphore_release(OS_Handle semaphore);
@@ -43,11 +43,22 @@ typedef PVOID W32_MapViewOfFile3_Type(HANDLE  FileMapping,
                                       ULONG   ParameterCount);
 typedef HRESULT W32_SetThreadDescription_Type(HANDLE hThread,
                                               PCWSTR lpThreadDescription);
+typedef struct W32_MemoryRangeEntry W32_MemoryRangeEntry;
+struct W32_MemoryRangeEntry
+{
+  PVOID  VirtualAddress;
+  SIZE_T NumberOfBytes;
+};
+typedef BOOL W32_PrefetchVirtualMemory_Type(HANDLE                Process,
+                                            ULONG_PTR             NumberOfEntries,
+                                            W32_MemoryRangeEntry *VirtualAddresses,
+                                            ULONG                 Flags);
 
 global W32_VirtualAlloc2_Type  *w32_VirtualAlloc2_func  = 0;
 global W32_MapViewOfFile3_Type *w32_MapViewOfFile3_func = 0;
 
 global W32_SetThreadDescription_Type *w32_SetThreadDescription_func = 0;
+global W32_PrefetchVirtualMemory_Type *w32_PrefetchVirtualMemory_func = 0;
 
 ////////////////////////////////
 //~ rjf: Globals
@@ -198,6 +209,7 @@ os_init(void)
       w32_VirtualAlloc2_func = (W32_VirtualAlloc2_Type*)GetProcAddress(module, "VirtualAlloc2");
       w32_MapViewOfFile3_func = (W32_MapViewOfFile3_Type*)GetProcAddress(module, "MapViewOfFile3");
       w32_SetThreadDescription_func = (W32_SetThreadDescription_Type*)GetProcAddress(module, "SetThreadDescription");
+      w32_PrefetchVirtualMemory_func = (W32_PrefetchVirtualMemory_Type*)GetProcAddress(module, "PrefetchVirtualMemory");
       
       FreeLibrary(module);
     }
@@ -825,6 +837,17 @@ os_copy_file_path(String8 dst, String8 src)
   return result;
 }
 
+internal B32
+os_move_file_path(String8 dst, String8 src)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String16 dst16 = str16_from_8(scratch.arena, dst);
+  String16 src16 = str16_from_8(scratch.arena, src);
+  B32 result = MoveFileExW((WCHAR*)src16.str, (WCHAR*)dst16.str, MOVEFILE_REPLACE_EXISTING);
+  scratch_end(scratch);
+  return result;
+}
+
 internal String8
 os_full_path_from_path(Arena *arena, String8 path)
 {
@@ -911,6 +934,12 @@ os_file_map_close(OS_Handle map)
 
 internal void *
 os_file_map_view_open(OS_Handle map, OS_AccessFlags flags, Rng1U64 range)
+{
+  return os_file_map_view_open_hinted(map, flags, range, 0);
+}
+
+internal void *
+os_file_map_view_open_hinted(OS_Handle map, OS_AccessFlags flags, Rng1U64 range, OS_FileMapHintFlags hints)
 {
   HANDLE handle = (HANDLE)map.u64[0];
   U32 off_lo = (U32)((range.min&0x00000000ffffffffull)>>0);
@@ -943,9 +972,35 @@ os_file_map_view_open(OS_Handle map, OS_AccessFlags flags, Rng1U64 range)
     }
   }
   void *result = MapViewOfFile(handle, access_flags, off_hi, off_lo, size);
+  os_file_map_view_hint(result, size, hints);
   return result;
 }
 
+internal void
+os_file_map_view_hint(void *ptr, U64 size, OS_FileMapHintFlags hints)
+{
+  // NOTE: readahead policy on Windows is chosen when the file is opened,
+  // not per-view, & file-backed views can't use large pages - so the only
+  // hints with an effect here are those which read pages in up front.
+  if(ptr != 0 && size != 0 && hints & (OS_FileMapHintFlag_WillNeed|OS_FileMapHintFlag_Populate))
+  {
+    if(w32_PrefetchVirtualMemory_func != 0)
+    {
+      W32_MemoryRangeEntry entry = {ptr, (SIZE_T)size};
+      w32_PrefetchVirtualMemory_func(GetCurrentProcess(), 1, &entry, 0);
+    }
+    if(hints & OS_FileMapHintFlag_Populate)
+    {
+      volatile U8 sink = 0;
+      for(U64 off = 0; off < size; off += os_page_size())
+      {
+        sink ^= ((volatile U8 *)ptr)[off];
+      }
+      (void)sink;
+    }
+  }
+}
+
 internal void
 os_file_map_view_close(OS_Handle map, void *ptr)
 {
@@ -1309,6 +1364,19 @@ os_process_wait(OS_Handle handle, U64 endt_us){
   return (result == WAIT_OBJECT_0);
 }
 
+internal B32
+os_process_wait_exit_code(OS_Handle handle, U64 endt_us, U64 *exit_code_out){
+  HANDLE process = (HANDLE)(handle.u64[0]);
+  DWORD sleep_ms = w32_sleep_ms_from_endt_us(endt_us);
+  DWORD result = WaitForSingleObject(process, sleep_ms);
+  DWORD exit_code = 0;
+  B32 good = (result == WAIT_OBJECT_0 && GetExitCodeProcess(process, &exit_code));
+  if(good){
+    *exit_code_out = exit_code;
+  }
+  return good;
+}
+
 internal void
 os_process_release_handle(OS_Handle handle){
   HANDLE process = (HANDLE)(handle.u64[0]);
@@ -1491,6 +1559,51 @@ os_condition_variable_broadcast_(OS_Handle cv){
   WakeAllConditionVariable(&entity->cv);
 }
 
+//- rjf: one-shot latches
+
+internal OS_Handle
+os_latch_alloc(void)
+{
+  HANDLE handle = CreateEventW(0, 1, 0, 0);
+  OS_Handle result = {(U64)handle};
+  return result;
+}
+
+internal void
+os_latch_release(OS_Handle latch)
+{
+  HANDLE handle = (HANDLE)latch.u64[0];
+  CloseHandle(handle);
+}
+
+internal void
+os_latch_signal(OS_Handle latch)
+{
+  HANDLE handle = (HANDLE)latch.u64[0];
+  SetEvent(handle);
+}
+
+internal B32
+os_latch_wait(OS_Handle latch, U64 endt_us)
+{
+  U32 sleep_ms = w32_sleep_ms_from_endt_us(endt_us);
+  HANDLE handle = (HANDLE)latch.u64[0];
+  DWORD wait_result = WaitForSingleObject(handle, sleep_ms);
+  B32 result = (wait_result == WAIT_OBJECT_0);
+  return result;
+}
+
+//- rjf: contention stats
+
+internal OS_SyncStats
+os_sync_stats_from_handle(OS_Handle handle)
+{
+  // NOTE: primitives here are thin wrappers over the OS's own, which do
+  // not expose contention information
+  OS_SyncStats result = {0};
+  return result;
+}
+
 //- rjf: cross-process semaphores
 
 internal OS_Handle
@@ -8,12 +8,18 @@
 //~ NOTE(allen): Negotiate the windows header include order
 
 #define WIN32_LEAN_AND_MEAN
+#if OS_FEATURE_SOCKET
+#include <winsock2.h>
+#endif
 #include <windows.h>
 #include <windowsx.h>
 #include <timeapi.h>
 #include <tlhelp32.h>
 #include <Shlobj.h>
 #include <processthreadsapi.h>
+#if OS_FEATURE_SOCKET
+#include <ws2tcpip.h>
+#endif
 
 ////////////////////////////////
 //~ NOTE(allen): File Iterator
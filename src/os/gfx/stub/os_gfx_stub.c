@@ -4,6 +4,10 @@
 internal void
 os_graphical_init(void)
 {
+  Arena *arena = arena_alloc();
+  os_stub_gfx_state = push_array(arena, OS_StubGfxState, 1);
+  os_stub_gfx_state->arena = arena_alloc();
+  os_stub_gfx_state->client_size = v2f32(500, 500);
 }
 
 ////////////////////////////////
@@ -53,7 +57,7 @@ os_window_focus(OS_Handle window)
 internal B32
 os_window_is_focused(OS_Handle window)
 {
-  return 0;
+  return 1;
 }
 
 internal B32
@@ -116,14 +120,14 @@ os_window_push_custom_title_bar_client_area(OS_Handle handle, Rng2F32 rect)
 internal Rng2F32
 os_rect_from_window(OS_Handle window)
 {
-  Rng2F32 rect = r2f32(v2f32(0, 0), v2f32(500, 500));
+  Rng2F32 rect = r2f32(v2f32(0, 0), os_stub_gfx_state->client_size);
   return rect;
 }
 
 internal Rng2F32
 os_client_rect_from_window(OS_Handle window)
 {
-  Rng2F32 rect = r2f32(v2f32(0, 0), v2f32(500, 500));
+  Rng2F32 rect = r2f32(v2f32(0, 0), os_stub_gfx_state->client_size);
   return rect;
 }
 
@@ -181,27 +185,51 @@ os_send_wakeup_event(void)
 internal OS_EventList
 os_get_events(Arena *arena, B32 wait)
 {
-  OS_EventList evts = {0};
+  // rjf: never block - queued events are all there will ever be
+  OS_EventList evts = os_event_list_copy(arena, &os_stub_gfx_state->events);
+  MemoryZeroStruct(&os_stub_gfx_state->events);
+  arena_clear(os_stub_gfx_state->arena);
+  
+  // rjf: apply handed-out events to the simulated input state
+  for(OS_Event *e = evts.first; e != 0; e = e->next)
+  {
+    switch(e->kind)
+    {
+      default:{}break;
+      case OS_EventKind_Press:
+      case OS_EventKind_Release:
+      if(e->key < OS_Key_COUNT)
+      {
+        os_stub_gfx_state->key_is_down[e->key] = (e->kind == OS_EventKind_Press);
+        os_stub_gfx_state->flags = e->flags;
+      }break;
+      case OS_EventKind_MouseMove:
+      {
+        os_stub_gfx_state->mouse = e->pos;
+      }break;
+    }
+  }
   return evts;
 }
 
 internal OS_EventFlags
 os_get_event_flags(void)
 {
-  OS_EventFlags f = 0;
+  OS_EventFlags f = os_stub_gfx_state->flags;
   return f;
 }
 
 internal B32
 os_key_is_down(OS_Key key)
 {
-  return 0;
+  B32 result = (key < OS_Key_COUNT && os_stub_gfx_state->key_is_down[key]);
+  return result;
 }
 
 internal Vec2F32
 os_mouse_from_window(OS_Handle window)
 {
-  return v2f32(0, 0);
+  return os_stub_gfx_state->mouse;
 }
 
 ////////////////////////////////
@@ -246,3 +274,19 @@ internal void
 os_graphical_message(B32 error, String8 title, String8 message)
 {
 }
+
+////////////////////////////////
+//~ rjf: Scripted Input API
+
+internal void
+os_stub_set_client_size(Vec2F32 size)
+{
+  os_stub_gfx_state->client_size = size;
+}
+
+internal void
+os_stub_push_events(OS_EventList *events)
+{
+  OS_EventList copy = os_event_list_copy(os_stub_gfx_state->arena, events);
+  os_event_list_concat_in_place(&os_stub_gfx_state->events, &copy);
+}
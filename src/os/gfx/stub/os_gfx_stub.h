@@ -4,4 +4,34 @@
 #ifndef OS_GFX_STUB_H
 #define OS_GFX_STUB_H
 
+////////////////////////////////
+//~ rjf: Scripted Input State
+//
+// The stub has no real windows or input devices. Headless drivers (e.g. the
+// UI frame benchmark) queue events with os_stub_push_events; those are then
+// handed out by os_get_events, which also updates the mouse position &
+// modifier/key state that the rest of the stub reports.
+
+typedef struct OS_StubGfxState OS_StubGfxState;
+struct OS_StubGfxState
+{
+  Arena *arena;
+  OS_EventList events;
+  Vec2F32 client_size;
+  Vec2F32 mouse;
+  OS_EventFlags flags;
+  B8 key_is_down[OS_Key_COUNT];
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global OS_StubGfxState *os_stub_gfx_state = 0;
+
+////////////////////////////////
+//~ rjf: Scripted Input API
+
+internal void os_stub_set_client_size(Vec2F32 size);
+internal void os_stub_push_events(OS_EventList *events);
+
 #endif // OS_GFX_STUB_H
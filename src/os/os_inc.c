@@ -24,6 +24,9 @@
 # endif
 #elif OS_LINUX
 # include "core/linux/os_core_linux.c"
+# if OS_FEATURE_SOCKET
+#  include "socket/linux/os_socket_linux.c"
+# endif
 #  if OS_FEATURE_GRAPHICAL && !OS_GFX_STUB
 #    ifndef WAYLAND_DISABLED
 #      include "gfx/linux/os_gfx_wayland.c"
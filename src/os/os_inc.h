@@ -12,6 +12,10 @@
 # define OS_FEATURE_GRAPHICAL 0
 #endif
 
+#if !defined(OS_FEATURE_SYNC_STATS)
+# define OS_FEATURE_SYNC_STATS 0
+#endif
+
 #if !defined(OS_GFX_STUB)
 # define OS_GFX_STUB 0
 #endif
@@ -36,6 +40,9 @@
 # endif
 #elif OS_LINUX
 # include "core/linux/os_core_linux.h"
+# if OS_FEATURE_SOCKET
+#  include "socket/linux/os_socket_linux.h"
+# endif
 #  if OS_FEATURE_GRAPHICAL && !OS_GFX_STUB
 #    ifndef WAYLAND_DISABLED
 #      include "gfx/linux/os_gfx_wayland.h"
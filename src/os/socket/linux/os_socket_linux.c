@@ -0,0 +1,402 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal void
+lnx_socket_set_error(LNX_Socket *socket, OS_SocketError error){
+  socket->error = error;
+  // NOTE: See w32_socket_set_error - the flag being set is not the bug.
+  Assert(!(socket->flags & LNX_SocketFlag_AssertOnError));
+}
+
+internal void
+lnx_socket_set_error_sys(LNX_Socket *socket, int sys_error){
+  socket->sys_error = sys_error;
+  lnx_socket_set_error(socket, OS_SocketError_WSAError);
+}
+
+internal B32
+lnx_socket_read_looped(LNX_Socket *lnx_socket, void *buffer, U32 size){
+  U32 p = 0;
+  U8 *ptr = (U8*)buffer;
+  for (;p < size;){
+    ssize_t amt = recv(lnx_socket->fd, ptr, size - p, 0);
+    if (amt < 0){
+      if (errno == EINTR){
+        continue;
+      }
+      lnx_socket_set_error_sys(lnx_socket, errno);
+      break;
+    }
+    if (amt == 0){
+      lnx_socket->flags |= LNX_SocketFlag_Closed;
+      break;
+    }
+    p += (U32)amt;
+    ptr += amt;
+  }
+  B32 result = (p == size);
+  return(result);
+}
+
+////////////////////////////////
+//~ rjf: Per-OS Hook Implementations
+
+internal void
+os_socket_init(void){
+  // NOTE: a peer closing mid-write must surface as an error, not kill
+  // the process.
+  signal(SIGPIPE, SIG_IGN);
+}
+
+internal void
+os_socket_listen(OS_Socket *s, String8 ip, String8 port){
+  LNX_Socket *lnx_socket = (LNX_Socket*)s->memory;
+  lnx_socket->fd = -1;
+  
+  // NOTE: check port string
+  char port_buffer[6];
+  if (port.size == 0 || port.size >= sizeof(port_buffer)){
+    lnx_socket_set_error(lnx_socket, OS_SocketError_BadPortArgument);
+    return;
+  }
+  MemoryCopy(port_buffer, port.str, port.size);
+  port_buffer[port.size] = 0;
+  
+  // NOTE: check ip string - empty -> all interfaces
+  char ip_buffer[KB(1)];
+  if (ip.size >= sizeof(ip_buffer)){
+    lnx_socket_set_error(lnx_socket, OS_SocketError_BadIPArgument);
+    return;
+  }
+  MemoryCopy(ip_buffer, ip.str, ip.size);
+  ip_buffer[ip.size] = 0;
+  
+  // NOTE: listen socket addrinfo
+  struct addrinfo listen_hint = {0};
+  listen_hint.ai_flags = AI_PASSIVE|AI_NUMERICSERV;
+  listen_hint.ai_family = AF_UNSPEC;
+  listen_hint.ai_socktype = SOCK_STREAM;
+  
+  struct addrinfo *addr = 0;
+  int error = getaddrinfo(ip.size != 0 ? ip_buffer : 0, port_buffer, &listen_hint, &addr);
+  if (error != 0){
+    lnx_socket_set_error_sys(lnx_socket, (error == EAI_SYSTEM) ? errno : EHOSTUNREACH);
+    return;
+  }
+  
+  // NOTE: init listen socket
+  int socket_listener = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+  int client_socket = -1;
+  B32 good = (socket_listener >= 0);
+  
+  // NOTE: reuseraddr
+  if (good){
+    int enable = 1;
+    good = (setsockopt(socket_listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == 0);
+  }
+  
+  // NOTE: bind
+  if (good){
+    good = (bind(socket_listener, addr->ai_addr, addr->ai_addrlen) == 0);
+  }
+  
+  // NOTE: listen
+  if (good){
+    good = (listen(socket_listener, 1) == 0);
+  }
+  
+  // NOTE: accept
+  if (good){
+    do{
+      client_socket = accept(socket_listener, 0, 0);
+    }while (client_socket < 0 && errno == EINTR);
+    good = (client_socket >= 0);
+  }
+  
+  // NOTE: TCP_NODELAY
+  if (good){
+    int enable = 1;
+    good = (setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) == 0);
+  }
+  
+  // NOTE: failure -> record error; the listener is never kept
+  if (!good){
+    lnx_socket_set_error_sys(lnx_socket, errno);
+    if (client_socket >= 0){
+      close(client_socket);
+    }
+  }
+  if (socket_listener >= 0){
+    close(socket_listener);
+  }
+  freeaddrinfo(addr);
+  
+  // NOTE: success
+  if (good){
+    lnx_socket->flags |= LNX_SocketFlag_Connected;
+    lnx_socket->fd = client_socket;
+    lnx_socket->error = OS_SocketError_None;
+  }
+}
+
+internal void
+os_socket_connect(OS_Socket *s, String8 ip, String8 port){
+  LNX_Socket *lnx_socket = (LNX_Socket*)s->memory;
+  lnx_socket->fd = -1;
+  
+  // NOTE: check port string
+  char port_buffer[6];
+  if (port.size == 0 || port.size >= sizeof(port_buffer)){
+    lnx_socket_set_error(lnx_socket, OS_SocketError_BadPortArgument);
+    return;
+  }
+  MemoryCopy(port_buffer, port.str, port.size);
+  port_buffer[port.size] = 0;
+  
+  // NOTE: check ip string
+  if (ip.size == 0){
+    ip = str8_lit("localhost");
+  }
+  char ip_buffer[KB(1)];
+  if (ip.size >= sizeof(ip_buffer)){
+    lnx_socket_set_error(lnx_socket, OS_SocketError_BadIPArgument);
+    return;
+  }
+  MemoryCopy(ip_buffer, ip.str, ip.size);
+  ip_buffer[ip.size] = 0;
+  
+  // NOTE: socket addrinfo
+  struct addrinfo hint = {0};
+  hint.ai_flags = AI_NUMERICSERV;
+  hint.ai_family = AF_UNSPEC;
+  hint.ai_socktype = SOCK_STREAM;
+  
+  struct addrinfo *addr = 0;
+  int error = getaddrinfo(ip_buffer, port_buffer, &hint, &addr);
+  if (error != 0){
+    lnx_socket_set_error_sys(lnx_socket, (error == EAI_SYSTEM) ? errno : EHOSTUNREACH);
+    return;
+  }
+  
+  // NOTE: init socket
+  int socket_server = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+  B32 good = (socket_server >= 0);
+  
+  // NOTE: TCP_NODELAY
+  if (good){
+    int enable = 1;
+    good = (setsockopt(socket_server, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) == 0);
+  }
+  
+  // NOTE: connect
+  if (good){
+    good = (connect(socket_server, addr->ai_addr, addr->ai_addrlen) == 0);
+  }
+  freeaddrinfo(addr);
+  
+  // NOTE: failure
+  if (!good){
+    lnx_socket_set_error_sys(lnx_socket, errno);
+    if (socket_server >= 0){
+      close(socket_server);
+    }
+  }
+  
+  // NOTE: success
+  else{
+    lnx_socket->flags |= LNX_SocketFlag_Connected;
+    lnx_socket->fd = socket_server;
+    lnx_socket->error = OS_SocketError_None;
+  }
+}
+
+internal void
+os_socket_shutdown(OS_Socket *socket){
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  if (lnx_socket->flags & LNX_SocketFlag_Connected){
+    shutdown(lnx_socket->fd, SHUT_RDWR);
+  }
+}
+
+internal void
+os_socket_close(OS_Socket *socket){
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  if (lnx_socket->flags & LNX_SocketFlag_Connected){
+    close(lnx_socket->fd);
+  }
+  MemoryZeroStruct(lnx_socket);
+}
+
+internal String8
+os_socket_read(Arena *arena, OS_Socket *socket, U64 max_size){
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  String8 result = {0};
+  U32 size = 0;
+  B32 size_good = lnx_socket_read_looped(lnx_socket, &size, sizeof(size));
+  if (size_good && size > max_size){
+    lnx_socket_set_error(lnx_socket, OS_SocketError_FrameTooLarge);
+    size_good = 0;
+  }
+  if (size_good){
+    Temp restore = temp_begin(arena);
+    result.str = push_array_no_zero(arena, U8, size);
+    if (lnx_socket_read_looped(lnx_socket, result.str, size)){
+      result.size = size;
+    }
+    else{
+      temp_end(restore);
+      result.str = 0;
+    }
+  }
+  return(result);
+}
+
+internal B32
+os_socket_write(OS_Socket *socket, String8List list){
+  U32 size = (U32)list.total_size;
+  String8Node size_node = {0};
+  str8_list_push_node_front_set_string(&list, &size_node, str8_struct(&size));
+  
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  
+  struct iovec iov[64];
+  Assert(list.node_count <= ArrayCount(iov));
+  
+  U64 iov_count = 0;
+  for (String8Node *node = list.first;
+       node != 0 && iov_count < ArrayCount(iov);
+       node = node->next){
+    iov[iov_count].iov_base = node->string.str;
+    iov[iov_count].iov_len = node->string.size;
+    iov_count += 1;
+  }
+  
+  // NOTE: unlike WSASend, sendmsg may write partially - keep going from
+  // wherever the last call stopped.
+  B32 result = 0;
+  U64 iov_idx = 0;
+  for (;;){
+    for (;iov_idx < iov_count && iov[iov_idx].iov_len == 0; iov_idx += 1);
+    if (iov_idx == iov_count){
+      result = 1;
+      break;
+    }
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov[iov_idx];
+    msg.msg_iovlen = iov_count - iov_idx;
+    ssize_t amt = sendmsg(lnx_socket->fd, &msg, MSG_NOSIGNAL);
+    if (amt < 0){
+      if (errno == EINTR){
+        continue;
+      }
+      if (errno == EPIPE || errno == ECONNRESET){
+        lnx_socket->flags |= LNX_SocketFlag_Closed;
+      }
+      else{
+        lnx_socket_set_error_sys(lnx_socket, errno);
+      }
+      break;
+    }
+    if (amt == 0){
+      lnx_socket->flags |= LNX_SocketFlag_Closed;
+      break;
+    }
+    for (U64 left = (U64)amt; left > 0 && iov_idx < iov_count;){
+      U64 take = Min(left, iov[iov_idx].iov_len);
+      iov[iov_idx].iov_base = (U8*)iov[iov_idx].iov_base + take;
+      iov[iov_idx].iov_len -= take;
+      left -= take;
+      if (iov[iov_idx].iov_len == 0){
+        iov_idx += 1;
+      }
+    }
+  }
+  
+  return(result);
+}
+
+internal B32
+os_socket_status(OS_Socket *socket, OS_SocketStatus status){
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  B32 result = 0;
+  switch (status){
+    case OS_SocketStatus_Uninitialized:
+    {
+      result = (((lnx_socket->flags & (LNX_SocketFlag_Connected|LNX_SocketFlag_Closed)) == 0) &&
+                (lnx_socket->error == 0));
+    }break;
+    
+    case OS_SocketStatus_Connected:
+    {
+      result = (((lnx_socket->flags & (LNX_SocketFlag_Connected|LNX_SocketFlag_Closed)) == LNX_SocketFlag_Connected) &&
+                (lnx_socket->error == 0));
+    }break;
+    
+    case OS_SocketStatus_GracefullyClosed:
+    {
+      result = (((lnx_socket->flags & LNX_SocketFlag_Closed) == LNX_SocketFlag_Closed) && (lnx_socket->error == 0));
+    }break;
+    
+    case OS_SocketStatus_Error:
+    {
+      result = (lnx_socket->error != 0);
+    }break;
+  }
+  return(result);
+}
+
+internal String8
+os_socket_error_string(Arena *arena, OS_Socket *socket){
+  String8 result = str8_lit("no error");
+  
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  switch (lnx_socket->error){
+    default:
+    {
+      result = str8_lit("Bad error code");
+    }break;
+    
+    case OS_SocketError_None:break;
+    
+    case OS_SocketError_SocketSystemNotInitialized:
+    {
+      result = str8_lit("Missing call to os_socket_init");
+    }break;
+    
+    case OS_SocketError_BadPortArgument:
+    {
+      result = str8_lit("Invalid port argument to socket API");
+    }break;
+    
+    case OS_SocketError_BadIPArgument:
+    {
+      result = str8_lit("Invalid ip argument to socket API");
+    }break;
+    
+    case OS_SocketError_WSAError:
+    {
+      result = push_str8_copy(arena, str8_cstring(strerror(lnx_socket->sys_error)));
+    }break;
+    
+    case OS_SocketError_FrameTooLarge:
+    {
+      result = str8_lit("Received message exceeds the maximum size");
+    }break;
+  }
+  
+  return(result);
+}
+
+internal void
+os_socket_assert_on_error(OS_Socket *socket, B32 assert_on_error){
+  LNX_Socket *lnx_socket = (LNX_Socket*)socket->memory;
+  if (assert_on_error){
+    lnx_socket->flags |= LNX_SocketFlag_AssertOnError;
+  }
+  else{
+    lnx_socket->flags &= ~LNX_SocketFlag_AssertOnError;
+  }
+}
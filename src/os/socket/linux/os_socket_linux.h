@@ -0,0 +1,43 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef LINUX_SOCKET_H
+#define LINUX_SOCKET_H
+
+////////////////////////////////
+//~ rjf: Includes
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+////////////////////////////////
+//~ rjf: Types
+
+typedef U16 LNX_SocketFlags;
+enum{
+  LNX_SocketFlag_Connected     = (1 << 0),
+  LNX_SocketFlag_Closed        = (1 << 1),
+  LNX_SocketFlag_AssertOnError = (1 << 2),
+};
+
+typedef struct LNX_Socket LNX_Socket;
+struct LNX_Socket{
+  LNX_SocketFlags flags;
+  OS_SocketError error;
+  int sys_error;
+  int fd;
+};
+
+StaticAssert(sizeof(Member(OS_Socket, memory)) >= sizeof(LNX_Socket), socket_memory_size);
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal void lnx_socket_set_error(LNX_Socket *socket, OS_SocketError error);
+internal void lnx_socket_set_error_sys(LNX_Socket *socket, int sys_error);
+internal B32 lnx_socket_read_looped(LNX_Socket *lnx_socket, void *buffer, U32 size);
+
+#endif // LINUX_SOCKET_H
@@ -5,12 +5,10 @@
 // NOTE(allen): Helper
 
 internal B32
-os_socket_write(OS_Socket *socket, String8 data){
+os_socket_write_string(OS_Socket *socket, String8 data){
   String8Node node = {0};
   String8List list = {0};
-  str8_list_push(&list, &node, data);
+  str8_list_push_node_set_string(&list, &node, data);
   B32 result = os_socket_write(socket, list);
   return(result);
 }
-
-#endif
@@ -4,12 +4,13 @@
 #ifndef OS_SOCKET_H
 #define OS_SOCKET_H
 
-enum OS_SocketStatus{
+typedef enum OS_SocketStatus{
   OS_SocketStatus_Uninitialized,
   OS_SocketStatus_Connected,
   OS_SocketStatus_GracefullyClosed,
   OS_SocketStatus_Error,
-};
+}
+OS_SocketStatus;
 
 typedef U16 OS_SocketError;
 enum{
@@ -18,8 +19,10 @@ enum{
   OS_SocketError_BadPortArgument,
   OS_SocketError_BadIPArgument,
   OS_SocketError_WSAError,
+  OS_SocketError_FrameTooLarge,
 };
 
+typedef struct OS_Socket OS_Socket;
 struct OS_Socket{
   U8 memory[32];
 };
@@ -30,11 +33,19 @@ struct OS_Socket{
 
 internal void os_socket_init(void);
 
-internal void os_socket_listen(OS_Socket *socket, String8 port);
+// NOTE: listen binds to the local address ip (e.g. "127.0.0.1"); an empty ip
+// binds to all interfaces.
+internal void os_socket_listen(OS_Socket *socket, String8 ip, String8 port);
 internal void os_socket_connect(OS_Socket *socket, String8 ip, String8 port);
+// NOTE: shutdown stops traffic in both directions but keeps the socket open,
+// so a thread blocked in os_socket_read on it returns; close still releases it.
+internal void os_socket_shutdown(OS_Socket *socket);
 internal void os_socket_close(OS_Socket *socket);
 
-internal String8 os_socket_read(Arena *arena, OS_Socket *socket);
+// NOTE: reads & writes are framed - each write sends one length-prefixed
+// message, each read returns exactly one message (empty on close/error).
+// A message longer than max_size is an error, and is never allocated.
+internal String8 os_socket_read(Arena *arena, OS_Socket *socket, U64 max_size);
 internal B32     os_socket_write(OS_Socket *socket, String8List list);
 
 internal B32     os_socket_status(OS_Socket *socket, OS_SocketStatus status);
@@ -44,6 +55,6 @@ internal void    os_socket_assert_on_error(OS_Socket *socket, B32 assert_on_erro
 ////////////////////////////////
 //~ NOTE(allen): Helpers - Portable Implementation
 
-internal B32 os_socket_write(OS_Socket *socket, String8 data);
+internal B32 os_socket_write_string(OS_Socket *socket, String8 data);
 
 #endif //OS_SOCKET_H
@@ -1,6 +1,8 @@
 // Copyright (c) 2024 Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
+#pragma comment(lib, "ws2_32")
+
 ////////////////////////////////
 //~ rjf: Helpers
 
@@ -64,7 +66,7 @@ os_socket_init(void){
 }
 
 internal void
-os_socket_listen(OS_Socket *s, String8 port){
+os_socket_listen(OS_Socket *s, String8 ip, String8 port){
   W32_Socket *w32_socket = (W32_Socket*)s->memory;
   
   // NOTE(allen): check port string
@@ -76,15 +78,24 @@ os_socket_listen(OS_Socket *s, String8 port){
   MemoryCopy(port_buffer, port.str, port.size);
   port_buffer[port.size] = 0;
   
+  // NOTE: check ip string - empty -> all interfaces
+  char ip_buffer[KB(1)];
+  if (ip.size >= sizeof(ip_buffer)){
+    w32_socket_set_error(w32_socket, OS_SocketError_BadIPArgument);
+    return;
+  }
+  MemoryCopy(ip_buffer, ip.str, ip.size);
+  ip_buffer[ip.size] = 0;
+  
   // NOTE(allen): listen socket addrinfo
-  addrinfo listen_hint = {0};
+  ADDRINFOA listen_hint = {0};
   listen_hint.ai_flags = AI_PASSIVE|AI_NUMERICSERV;
   listen_hint.ai_family = AF_UNSPEC;
   listen_hint.ai_socktype = SOCK_STREAM;
   listen_hint.ai_protocol = AF_UNSPEC;
   
-  addrinfo *addr = {0};
-  INT error = getaddrinfo(0, port_buffer, &listen_hint, &addr);
+  ADDRINFOA *addr = 0;
+  INT error = getaddrinfo(ip.size != 0 ? ip_buffer : 0, port_buffer, &listen_hint, &addr);
   if (error != 0){
     w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
     return;
@@ -92,49 +103,57 @@ os_socket_listen(OS_Socket *s, String8 port){
   
   // NOTE(allen): init listen socket
   SOCKET socket_listener = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-  W32_SocketCloser listener_closer(&socket_listener);
+  SOCKET client_socket = INVALID_SOCKET;
+  B32 good = (socket_listener != INVALID_SOCKET);
   
   // NOTE(allen): reuseraddr
-  {
+  if (good){
     union { B32 b; char c[1]; } enable;
-    enable.b = true;
-    if (setsockopt(socket_listener, SOL_SOCKET, SO_REUSEADDR, enable.c, sizeof(enable)) < 0){
-      w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
-      return;
-    }
+    enable.b = 1;
+    good = (setsockopt(socket_listener, SOL_SOCKET, SO_REUSEADDR, enable.c, sizeof(enable)) == 0);
   }
   
   // NOTE(allen): bind
-  if (bind(socket_listener, addr->ai_addr, (int)addr->ai_addrlen) < 0){
-    w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
-    return;
+  if (good){
+    good = (bind(socket_listener, addr->ai_addr, (int)addr->ai_addrlen) == 0);
   }
   
   // NOTE(allen): listen
-  if (listen(socket_listener, 1) < 0){
-    w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
-    return;
+  if (good){
+    good = (listen(socket_listener, 1) == 0);
   }
   
   // NOTE(allen): accept
-  SOCKET client_socket = accept(socket_listener, 0, 0);
-  W32_SocketCloser client_closer(&client_socket);
+  if (good){
+    client_socket = accept(socket_listener, 0, 0);
+    good = (client_socket != INVALID_SOCKET);
+  }
   
   // NOTE(allen): TCP_NODELAY
-  {
+  if (good){
     union { B32 b; char c[1]; } enable;
-    enable.b = true;
-    if (setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, enable.c, sizeof(enable)) < 0){
-      w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
-      return;
+    enable.b = 1;
+    good = (setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, enable.c, sizeof(enable)) == 0);
+  }
+  
+  // NOTE: failure -> record error; the listener is never kept
+  if (!good){
+    w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
+    if (client_socket != INVALID_SOCKET){
+      closesocket(client_socket);
     }
   }
+  if (socket_listener != INVALID_SOCKET){
+    closesocket(socket_listener);
+  }
+  freeaddrinfo(addr);
   
   // NOTE(allen): success
-  w32_socket->flags |= W32_SocketFlag_Connected;
-  w32_socket->socket = client_socket;
-  w32_socket->error = OS_SocketError_None;
-  client_closer.do_not_close();
+  if (good){
+    w32_socket->flags |= W32_SocketFlag_Connected;
+    w32_socket->socket = client_socket;
+    w32_socket->error = OS_SocketError_None;
+  }
 }
 
 internal void
@@ -163,13 +182,13 @@ os_socket_connect(OS_Socket *s, String8 ip, String8 port){
   ip_buffer[ip.size] = 0;
   
   // NOTE(allen): socket addrinfo
-  addrinfo hint = {0};
+  ADDRINFOA hint = {0};
   hint.ai_flags = AI_PASSIVE|AI_NUMERICSERV;
   hint.ai_family = AF_UNSPEC;
   hint.ai_socktype = SOCK_STREAM;
   hint.ai_protocol = AF_UNSPEC;
   
-  addrinfo *addr = {0};
+  ADDRINFOA *addr = 0;
   INT error = getaddrinfo(ip_buffer, port_buffer, &hint, &addr);
   if (error != 0){
     w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
@@ -178,29 +197,43 @@ os_socket_connect(OS_Socket *s, String8 ip, String8 port){
   
   // NOTE(allen): init socket
   SOCKET socket_server = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-  W32_SocketCloser closer(&socket_server);
+  B32 good = (socket_server != INVALID_SOCKET);
   
   // NOTE(allen): TCP_NODELAY
-  {
+  if (good){
     union { B32 b; char c[1]; } enable;
-    enable.b = true;
-    if (setsockopt(socket_server, IPPROTO_TCP, TCP_NODELAY, enable.c, sizeof(enable)) < 0){
-      w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
-      return;
-    }
+    enable.b = 1;
+    good = (setsockopt(socket_server, IPPROTO_TCP, TCP_NODELAY, enable.c, sizeof(enable)) == 0);
   }
   
   // NOTE(allen): connect
-  if (connect(socket_server, addr->ai_addr, (int)addr->ai_addrlen) < 0){
+  if (good){
+    good = (connect(socket_server, addr->ai_addr, (int)addr->ai_addrlen) == 0);
+  }
+  freeaddrinfo(addr);
+  
+  // NOTE: failure
+  if (!good){
     w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
-    return;
+    if (socket_server != INVALID_SOCKET){
+      closesocket(socket_server);
+    }
   }
   
   // NOTE(allen): success
-  w32_socket->flags |= W32_SocketFlag_Connected;
-  w32_socket->socket = socket_server;
-  w32_socket->error = OS_SocketError_None;
-  closer.do_not_close();
+  else{
+    w32_socket->flags |= W32_SocketFlag_Connected;
+    w32_socket->socket = socket_server;
+    w32_socket->error = OS_SocketError_None;
+  }
+}
+
+internal void
+os_socket_shutdown(OS_Socket *socket){
+  W32_Socket *w32_socket = (W32_Socket*)socket->memory;
+  if (w32_socket->flags & W32_SocketFlag_Connected){
+    shutdown(w32_socket->socket, SD_BOTH);
+  }
 }
 
 internal void
@@ -211,11 +244,16 @@ os_socket_close(OS_Socket *socket){
 }
 
 internal String8
-os_socket_read(Arena *arena, OS_Socket *socket){
+os_socket_read(Arena *arena, OS_Socket *socket, U64 max_size){
   W32_Socket *w32_socket = (W32_Socket*)socket->memory;
   String8 result = {0};
   U32 size = 0;
-  if (w32_socket_read_looped(w32_socket, &size, sizeof(size))){
+  B32 size_good = w32_socket_read_looped(w32_socket, &size, sizeof(size));
+  if (size_good && size > max_size){
+    w32_socket_set_error(w32_socket, OS_SocketError_FrameTooLarge);
+    size_good = 0;
+  }
+  if (size_good){
     Temp restore = temp_begin(arena);
     result.str = push_array_no_zero(arena, U8, size);
     if (w32_socket_read_looped(w32_socket, result.str, size)){
@@ -232,8 +270,8 @@ os_socket_read(Arena *arena, OS_Socket *socket){
 internal B32
 os_socket_write(OS_Socket *socket, String8List list){
   U32 size = (U32)list.total_size;
-  String8Node node = {0};
-  str8_list_push_front(&list, &node, str8_struct(&size));
+  String8Node size_node = {0};
+  str8_list_push_node_front_set_string(&list, &size_node, str8_struct(&size));
   
   W32_Socket *w32_socket = (W32_Socket*)socket->memory;
   
@@ -249,16 +287,16 @@ os_socket_write(OS_Socket *socket, String8List list){
     wsabuf_count += 1;
   }
   
-  B32 result = false;
+  B32 result = 0;
   DWORD amt = 0;
-  if (WSASend(w32_socket->socket, wsabuf, wsabuf_count, &amt, 0, 0, 0) != 0){
+  if (WSASend(w32_socket->socket, wsabuf, (DWORD)wsabuf_count, &amt, 0, 0, 0) != 0){
     w32_socket_set_error_wsa(w32_socket, WSAGetLastError());
   }
   else if (amt == 0){
-    w32_socket->flags |= W32_SocketFlag_Connected;
+    w32_socket->flags |= W32_SocketFlag_Closed;
   }
   else{
-    result = true;
+    result = 1;
   }
   
   return(result);
@@ -266,8 +304,8 @@ os_socket_write(OS_Socket *socket, String8List list){
 
 internal B32
 os_socket_status(OS_Socket *socket, OS_SocketStatus status){
-  W32_Socket *w32_socket = (W32_Socket*)socket;
-  B32 result = false;
+  W32_Socket *w32_socket = (W32_Socket*)socket->memory;
+  B32 result = 0;
   switch (status){
     case OS_SocketStatus_Uninitialized:
     {
@@ -298,7 +336,7 @@ internal String8
 os_socket_error_string(Arena *arena, OS_Socket *socket){
   String8 result = str8_lit("no error");
   
-  W32_Socket *w32_socket = (W32_Socket*)socket;
+  W32_Socket *w32_socket = (W32_Socket*)socket->memory;
   switch (w32_socket->error){
     default:
     {
@@ -336,6 +374,11 @@ os_socket_error_string(Arena *arena, OS_Socket *socket){
         LocalFree(message);
       }
     }break;
+    
+    case OS_SocketError_FrameTooLarge:
+    {
+      result = str8_lit("Received message exceeds the maximum size");
+    }break;
   }
   
   return(result);
@@ -343,7 +386,7 @@ os_socket_error_string(Arena *arena, OS_Socket *socket){
 
 internal void
 os_socket_assert_on_error(OS_Socket *socket, B32 assert_on_error){
-  W32_Socket *w32_socket = (W32_Socket*)socket;
+  W32_Socket *w32_socket = (W32_Socket*)socket->memory;
   if (assert_on_error){
     w32_socket->flags |= W32_SocketFlag_AssertOnError;
   }
@@ -14,6 +14,7 @@ enum{
   W32_SocketFlag_AssertOnError = (1 << 2),
 };
 
+typedef struct W32_Socket W32_Socket;
 struct W32_Socket{
   W32_SocketFlags flags;
   OS_SocketError error;
@@ -21,27 +22,6 @@ struct W32_Socket{
   SOCKET socket;
 };
 
-struct W32_SocketCloser{
-  B32 need_to_close;
-  SOCKET *socket;
-  W32_SocketCloser(SOCKET *s){
-    this->need_to_close = true;
-    this->socket = s;
-  }
-  ~W32_SocketCloser(){
-    this->close_now();
-  }
-  void close_now(){
-    if (this->need_to_close){
-      closesocket(*this->socket);
-      this->need_to_close = false;
-    }
-  }
-  void do_not_close(){
-    this->need_to_close = false;
-  }
-};
-
 StaticAssert(sizeof(Member(OS_Socket, memory)) >= sizeof(W32_Socket), socket_memory_size);
 
 ////////////////////////////////
@@ -31,6 +31,8 @@ update_and_render(OS_Handle repaint_window_handle, void *user_data)
   //
   txt_user_clock_tick();
   dasm_user_clock_tick();
+  flow_user_clock_tick();
+  lnk_user_clock_tick();
   geo_user_clock_tick();
   tex_user_clock_tick();
   
@@ -340,6 +342,7 @@ update_and_render(OS_Handle repaint_window_handle, void *user_data)
   //- rjf: update & render
   //
   {
+    f_begin_frame();
     d_begin_frame();
     for(DF_Window *w = df_gfx_state->first_window; w != 0; w = w->next)
     {
@@ -353,6 +356,14 @@ update_and_render(OS_Handle repaint_window_handle, void *user_data)
   df_gfx_end_frame();
   df_core_end_frame();
   
+  //////////////////////////////
+  //- rjf: glyphs still rasterizing -> keep frames coming until they land
+  //
+  if(f_pending_raster_count() != 0)
+  {
+    df_gfx_request_frame();
+  }
+  
   //////////////////////////////
   //- rjf: submit rendering to all windows
   //
@@ -360,9 +371,11 @@ update_and_render(OS_Handle repaint_window_handle, void *user_data)
     r_begin_frame();
     for(DF_Window *w = df_gfx_state->first_window; w != 0; w = w->next)
     {
+      U64 submit_begin_us = os_now_microseconds();
       r_window_begin_frame(w->os, w->r);
       d_submit_bucket(w->os, w->r, w->draw_bucket);
       r_window_end_frame(w->os, w->r);
+      w->last_submit_us = os_now_microseconds() - submit_begin_us;
     }
     r_end_frame();
   }
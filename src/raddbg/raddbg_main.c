@@ -48,13 +48,16 @@
 #include "rdi_from_pdb/rdi_from_pdb.h"
 #include "regs/regs.h"
 #include "regs/rdi/regs_rdi.h"
+#include "x64/x64.h"
 #include "type_graph/type_graph.h"
 #include "dbgi/dbgi.h"
 #include "dasm_cache/dasm_cache.h"
+#include "flow_cache/flow_cache.h"
 #include "fuzzy_search/fuzzy_search.h"
 #include "demon/demon_inc.h"
 #include "eval/eval_inc.h"
 #include "ctrl/ctrl_inc.h"
+#include "link_cache/link_cache.h"
 #include "font_provider/font_provider_inc.h"
 #include "render/render_inc.h"
 #include "texture_cache/texture_cache.h"
@@ -88,13 +91,16 @@
 #include "rdi_from_pdb/rdi_from_pdb.c"
 #include "regs/regs.c"
 #include "regs/rdi/regs_rdi.c"
+#include "x64/x64.c"
 #include "type_graph/type_graph.c"
 #include "dbgi/dbgi.c"
 #include "dasm_cache/dasm_cache.c"
+#include "flow_cache/flow_cache.c"
 #include "fuzzy_search/fuzzy_search.c"
 #include "demon/demon_inc.c"
 #include "eval/eval_inc.c"
 #include "ctrl/ctrl_inc.c"
+#include "link_cache/link_cache.c"
 #include "font_provider/font_provider_inc.c"
 #include "render/render_inc.c"
 #include "texture_cache/texture_cache.c"
@@ -543,12 +549,20 @@ entry_point(CmdLine *cmd_line)
           os_file_write(out_file, r1u64(off, off+n->string.size), n->string.str);
           off += n->string.size;
         }
+        out_file_is_good = (os_properties_from_file(out_file).size == off);
       }
       
       //- rjf: close output file
       os_file_close(out_file);
       
       scratch_end(scratch);
+      
+      //- rjf: failed -> exit with an error code, so that callers waiting on
+      // this conversion don't use an incomplete file
+      if(!out_file_is_good)
+      {
+        os_exit_process(1);
+      }
     }break;
     
     //- rjf: help message box
@@ -565,6 +579,8 @@ entry_point(CmdLine *cmd_line)
                                     "This will step into all targets after the debugger initially starts.\n\n"
                                     "--auto_run\n"
                                     "This will run all targets after the debugger initially starts.\n\n"
+                                    "--headless\n"
+                                    "When using the software renderer, frames are rasterized into memory only, and are never presented to a window. This is intended for automated testing & benchmarking on machines without a display or GPU.\n\n"
                                     "--ipc <command>\n"
                                     "This will launch the debugger in the non-graphical IPC mode, which is used to communicate with another running instance of the debugger. The debugger instance will launch, send the specified command, then immediately terminate. This may be used by editors or other programs to control the debugger.\n\n"));
     }break;
@@ -0,0 +1,386 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "The RAD Debugger - Remote Agent"
+#define BUILD_CONSOLE_INTERFACE 1
+#define OS_FEATURE_SOCKET 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "task_system/task_system.h"
+#include "rdi_format/rdi_format_local.h"
+#include "hash_store/hash_store.h"
+#include "path/path.h"
+#include "coff/coff.h"
+#include "pe/pe.h"
+#include "msf/msf.h"
+#include "regs/regs.h"
+#include "regs/rdi/regs_rdi.h"
+#include "type_graph/type_graph.h"
+#include "dbgi/dbgi.h"
+#include "demon/demon_inc.h"
+#include "eval/eval_inc.h"
+#include "ctrl/ctrl_inc.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "task_system/task_system.c"
+#include "rdi_format/rdi_format_local.c"
+#include "hash_store/hash_store.c"
+#include "path/path.c"
+#include "coff/coff.c"
+#include "pe/pe.c"
+#include "msf/msf.c"
+#include "regs/regs.c"
+#include "regs/rdi/regs_rdi.c"
+#include "type_graph/type_graph.c"
+#include "dbgi/dbgi.c"
+#include "demon/demon_inc.c"
+#include "eval/eval_inc.c"
+#include "ctrl/ctrl_inc.c"
+
+////////////////////////////////
+//~ rjf: Loopback Synthetic Target
+//
+// NOTE: loopback mode serves a synthetic target, so that the self-test covers
+// memory reads & register blocks without a live process: every process has a
+// few readable pages, followed by unreadable memory, & every thread is an x64
+// thread with a patterned register block. As with the demon, a read fails as
+// a whole if any of its bytes are unreadable.
+
+#define AGENT_LOOPBACK_MEM_BASE          0x10000
+#define AGENT_LOOPBACK_MEM_READABLE_SIZE (3*CTRL_REMOTE_PAGE_SIZE)
+#define AGENT_LOOPBACK_MEM_OPL           (AGENT_LOOPBACK_MEM_BASE + AGENT_LOOPBACK_MEM_READABLE_SIZE)
+
+internal U8
+agent_loopback_byte_from_vaddr(U64 vaddr)
+{
+  return (U8)(vaddr ^ (vaddr >> 8) ^ (vaddr >> 16));
+}
+
+internal U64
+agent_loopback_read_memory(DMN_Handle process, Rng1U64 range, void *dst)
+{
+  U64 result = 0;
+  if(AGENT_LOOPBACK_MEM_BASE <= range.min && range.min <= range.max && range.max <= AGENT_LOOPBACK_MEM_OPL)
+  {
+    for(U64 vaddr = range.min; vaddr < range.max; vaddr += 1)
+    {
+      ((U8 *)dst)[vaddr - range.min] = agent_loopback_byte_from_vaddr(vaddr);
+    }
+    result = dim_1u64(range);
+  }
+  return result;
+}
+
+internal Architecture
+agent_loopback_arch_from_thread(DMN_Handle thread)
+{
+  return Architecture_x64;
+}
+
+internal B32
+agent_loopback_read_reg_block(DMN_Handle thread, void *reg_block)
+{
+  U64 block_size = regs_block_size_from_architecture(Architecture_x64);
+  for(U64 idx = 0; idx < block_size; idx += 1)
+  {
+    ((U8 *)reg_block)[idx] = (U8)(idx + thread.u64[0]);
+  }
+  return 1;
+}
+
+internal B32
+agent_loopback_bytes_match(U8 *data, U64 vaddr, U64 size)
+{
+  B32 result = 1;
+  for(U64 idx = 0; result && idx < size; idx += 1)
+  {
+    result = (data[idx] == agent_loopback_byte_from_vaddr(vaddr + idx));
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Loopback Agent Thread
+
+typedef struct AgentLoopbackParams AgentLoopbackParams;
+struct AgentLoopbackParams
+{
+  String8 port;
+  String8 token;
+};
+
+internal void
+agent_loopback_thread__entry_point(void *p)
+{
+  AgentLoopbackParams *params = (AgentLoopbackParams *)p;
+  CTRL_RemoteAgentTarget target = {agent_loopback_read_memory, agent_loopback_arch_from_thread, agent_loopback_read_reg_block};
+  OS_Socket socket = {0};
+  os_socket_listen(&socket, str8_lit("127.0.0.1"), params->port);
+  if(os_socket_status(&socket, OS_SocketStatus_Connected))
+  {
+    ctrl_remote_agent_serve(&socket, params->token, &target);
+  }
+  os_socket_close(&socket);
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Temp scratch = scratch_begin(0, 0);
+  os_socket_init();
+  String8 port = cmd_line_string(cmd_line, str8_lit("port"));
+  if(port.size == 0)
+  {
+    port = str8_lit("7337");
+  }
+  String8 token = cmd_line_string(cmd_line, str8_lit("token"));
+  
+  //////////////////////////////
+  //- rjf: loopback mode - serve a synthetic target on a thread in this
+  // process, connect to it over the local network stack, & check & measure
+  // each kind of request
+  //
+  if(cmd_line_has_flag(cmd_line, str8_lit("loopback")))
+  {
+    AgentLoopbackParams params = {port, token};
+    if(params.token.size == 0)
+    {
+      params.token = push_str8f(scratch.arena, "loopback-%I64x-%x", os_now_microseconds(), os_get_pid());
+    }
+    OS_Handle agent_thread = os_launch_thread(agent_loopback_thread__entry_point, &params, 0);
+    CTRL_RemoteClient *client = 0;
+    for(U64 attempt_idx = 0; client == 0 && attempt_idx < 50; attempt_idx += 1)
+    {
+      client = ctrl_remote_client_connect(str8_lit("127.0.0.1"), port, params.token, CTRL_MachineID_Local+1, 0, os_now_microseconds()+1000000);
+      if(client == 0)
+      {
+        os_sleep_milliseconds(20);
+      }
+    }
+    if(client == 0)
+    {
+      fprintf(stderr, "error: could not connect to loopback agent on port %.*s\n", str8_varg(port));
+    }
+    else
+    {
+      String8List report = {0};
+      B32 all_good = 1;
+      DMN_Handle process = {1};
+      U8 *buffer = push_array(scratch.arena, U8, 4*CTRL_REMOTE_PAGE_SIZE);
+      
+      //- rjf: sequential round trips
+      {
+        U64 ping_count = 1000;
+        U64 pings_good = 0;
+        U64 begin_us = os_now_microseconds();
+        for(U64 idx = 0; idx < ping_count; idx += 1)
+        {
+          pings_good += !!ctrl_remote_client_ping(client, os_now_microseconds()+1000000);
+        }
+        U64 end_us = os_now_microseconds();
+        all_good = all_good && (pings_good == ping_count);
+        str8_list_pushf(scratch.arena, &report, "ping: %I64u/%I64u good, %.2f us per round trip\n", pings_good, ping_count, (F64)(end_us-begin_us)/ping_count);
+      }
+      
+      //- rjf: cached memory reads - an unaligned read over several pages is
+      // fetched as one request, & hits the page cache the second time; reads
+      // running into unreadable memory return the readable prefix
+      {
+        U64 endt_us = os_now_microseconds()+1000000;
+        Rng1U64 range = r1u64(AGENT_LOOPBACK_MEM_BASE + 100, AGENT_LOOPBACK_MEM_BASE + 100 + 2*CTRL_REMOTE_PAGE_SIZE);
+        CTRL_RemoteClientStats stats0 = ctrl_remote_client_stats(client);
+        U64 read0 = ctrl_remote_client_read_memory(client, process, range, buffer, endt_us);
+        B32 read0_good = (read0 == dim_1u64(range) && agent_loopback_bytes_match(buffer, range.min, read0));
+        CTRL_RemoteClientStats stats1 = ctrl_remote_client_stats(client);
+        MemoryZero(buffer, dim_1u64(range));
+        U64 read1 = ctrl_remote_client_read_memory(client, process, range, buffer, endt_us);
+        B32 read1_good = (read1 == dim_1u64(range) && agent_loopback_bytes_match(buffer, range.min, read1));
+        CTRL_RemoteClientStats stats2 = ctrl_remote_client_stats(client);
+        Rng1U64 tail_range = r1u64(AGENT_LOOPBACK_MEM_OPL - 50, AGENT_LOOPBACK_MEM_OPL + 50);
+        U64 tail_read = ctrl_remote_client_read_memory(client, process, tail_range, buffer, endt_us);
+        B32 tail_good = (tail_read == 50 && agent_loopback_bytes_match(buffer, tail_range.min, tail_read));
+        U64 bad_read = ctrl_remote_client_read_memory(client, process, r1u64(AGENT_LOOPBACK_MEM_OPL + 16, AGENT_LOOPBACK_MEM_OPL + 48), buffer, endt_us);
+        B32 cache_good = (stats1.mem_read_requests - stats0.mem_read_requests == 1 &&
+                          stats2.mem_read_requests == stats1.mem_read_requests &&
+                          stats2.page_hits - stats1.page_hits == 3);
+        B32 good = (read0_good && read1_good && tail_good && bad_read == 0 && cache_good);
+        all_good = all_good && good;
+        str8_list_pushf(scratch.arena, &report, "memory: %s (%I64u requests, %I64u page hits, %I64u page misses)\n", good ? "good" : "FAILED",
+                        stats2.mem_read_requests - stats0.mem_read_requests, stats2.page_hits - stats0.page_hits, stats2.page_misses - stats0.page_misses);
+      }
+      
+      //- rjf: uncached, unaligned memory reads - straight to the agent, whose
+      // page-by-page fallback must not start before the requested range
+      {
+        U64 endt_us = os_now_microseconds()+1000000;
+        CTRL_RemoteMemReadReq unreadable_req = {process, r1u64(AGENT_LOOPBACK_MEM_OPL + 0x10, AGENT_LOOPBACK_MEM_OPL + 0x30)};
+        CTRL_RemoteMemReadReq straddle_req = {process, r1u64(AGENT_LOOPBACK_MEM_OPL - 0x10, AGENT_LOOPBACK_MEM_OPL + 0x10)};
+        String8 unreadable = ctrl_remote_client_request_roundtrip(scratch.arena, client, CTRL_RemoteRecordKind_MemReadReq, str8_struct(&unreadable_req), endt_us);
+        String8 straddle = ctrl_remote_client_request_roundtrip(scratch.arena, client, CTRL_RemoteRecordKind_MemReadReq, str8_struct(&straddle_req), endt_us);
+        B32 good = (ctrl_remote_client_is_connected(client) && unreadable.size == 0 &&
+                    straddle.size == 0x10 && agent_loopback_bytes_match(straddle.str, straddle_req.vaddr_range.min, straddle.size));
+        all_good = all_good && good;
+        str8_list_pushf(scratch.arena, &report, "unaligned memory: %s (%I64u, %I64u bytes)\n", good ? "good" : "FAILED", unreadable.size, straddle.size);
+      }
+      
+      //- rjf: register blocks - the second fetch of a thread's block hits the
+      // cache
+      {
+        U64 endt_us = os_now_microseconds()+1000000;
+        DMN_Handle thread = {7};
+        U64 block_size = regs_block_size_from_architecture(Architecture_x64);
+        U8 *expected = push_array(scratch.arena, U8, block_size);
+        agent_loopback_read_reg_block(thread, expected);
+        CTRL_RemoteClientStats stats0 = ctrl_remote_client_stats(client);
+        Architecture arch0 = Architecture_Null;
+        Architecture arch1 = Architecture_Null;
+        void *block0 = ctrl_remote_client_reg_block_from_thread(scratch.arena, client, thread, &arch0, endt_us);
+        void *block1 = ctrl_remote_client_reg_block_from_thread(scratch.arena, client, thread, &arch1, endt_us);
+        CTRL_RemoteClientStats stats1 = ctrl_remote_client_stats(client);
+        B32 good = (block0 != 0 && block1 != 0 && arch0 == Architecture_x64 && arch1 == Architecture_x64 &&
+                    MemoryMatch(block0, expected, block_size) && MemoryMatch(block1, expected, block_size) &&
+                    stats1.reg_block_misses - stats0.reg_block_misses == 1 &&
+                    stats1.reg_block_hits - stats0.reg_block_hits == 1);
+        all_good = all_good && good;
+        str8_list_pushf(scratch.arena, &report, "registers: %s\n", good ? "good" : "FAILED");
+      }
+      
+      //- rjf: routing - the control layer's entry points send anything
+      // addressed to the client's machine through the client
+      {
+        CTRL_MachineID machine_id = CTRL_MachineID_Local+1;
+        DMN_Handle thread = {9};
+        U64 block_size = regs_block_size_from_architecture(Architecture_x64);
+        U8 *expected = push_array(scratch.arena, U8, block_size);
+        U8 *block = push_array(scratch.arena, U8, block_size);
+        agent_loopback_read_reg_block(thread, expected);
+        Rng1U64 range = r1u64(AGENT_LOOPBACK_MEM_BASE + 200, AGENT_LOOPBACK_MEM_BASE + 200 + 2*CTRL_REMOTE_PAGE_SIZE);
+        U64 read = ctrl_process_read(machine_id, process, range, buffer);
+        B32 read_good = (read == dim_1u64(range) && agent_loopback_bytes_match(buffer, range.min, read));
+        B32 regs_good = (ctrl_thread_read_reg_block(machine_id, thread, block) && MemoryMatch(block, expected, block_size));
+        CTRL_MsgList msgs = {0};
+        CTRL_Msg *msg = ctrl_msg_list_push(scratch.arena, &msgs);
+        msg->machine_id = machine_id;
+        U64 gen0 = ctrl_mem_gen_from_machine_id(machine_id);
+        CTRL_RemoteClientStats stats0 = ctrl_remote_client_stats(client);
+        B32 msgs_good = ctrl_u2c_push_msgs(&msgs, os_now_microseconds()+1000000);
+        CTRL_RemoteClientStats stats1 = ctrl_remote_client_stats(client);
+        U64 gen1 = ctrl_mem_gen_from_machine_id(machine_id);
+        B32 good = (read_good && regs_good && msgs_good &&
+                    stats1.frames_sent - stats0.frames_sent == 1 && gen1 != gen0);
+        all_good = all_good && good;
+        str8_list_pushf(scratch.arena, &report, "routing: %s\n", good ? "good" : "FAILED");
+      }
+      
+      //- rjf: messages - sending any invalidates the page cache
+      {
+        U64 endt_us = os_now_microseconds()+1000000;
+        CTRL_MsgList msgs = {0};
+        B32 msgs_good = ctrl_remote_client_push_msgs(client, &msgs);
+        CTRL_RemoteClientStats stats0 = ctrl_remote_client_stats(client);
+        U64 read = ctrl_remote_client_read_memory(client, process, r1u64(AGENT_LOOPBACK_MEM_BASE, AGENT_LOOPBACK_MEM_BASE + 64), buffer, endt_us);
+        CTRL_RemoteClientStats stats1 = ctrl_remote_client_stats(client);
+        B32 good = (msgs_good && read == 64 && stats1.mem_read_requests - stats0.mem_read_requests == 1);
+        all_good = all_good && good;
+        str8_list_pushf(scratch.arena, &report, "msgs: %s\n", good ? "good" : "FAILED");
+      }
+      
+      //- rjf: events - enough, with distinct strings, to span many batches &
+      // more than one frame
+      {
+        U64 event_count = 4096;
+        U64 string_size = 400;
+        CTRL_EventList events = {0};
+        for(U64 idx = 0; idx < event_count; idx += 1)
+        {
+          CTRL_Event *event = ctrl_event_list_push(scratch.arena, &events);
+          event->kind = CTRL_EventKind_DebugString;
+          event->u64_code = idx;
+          event->string = push_str8f(scratch.arena, "%0*I64u", (int)string_size, idx);
+        }
+        ctrl_c2u_push_events(&events);
+        U64 received_count = 0;
+        B32 events_good = 1;
+        U64 endt_us = os_now_microseconds()+5000000;
+        for(;received_count < event_count && os_now_microseconds() < endt_us;)
+        {
+          CTRL_EventList received = ctrl_remote_client_pop_events(scratch.arena, client);
+          for(CTRL_EventNode *n = received.first; n != 0; n = n->next, received_count += 1)
+          {
+            String8 expected = push_str8f(scratch.arena, "%0*I64u", (int)string_size, received_count);
+            events_good = (events_good && n->v.kind == CTRL_EventKind_DebugString && n->v.u64_code == received_count &&
+                           n->v.machine_id == CTRL_MachineID_Local+1 && str8_match(n->v.string, expected, 0));
+          }
+          if(received.count == 0)
+          {
+            os_sleep_milliseconds(1);
+          }
+        }
+        CTRL_RemoteClientStats stats = ctrl_remote_client_stats(client);
+        B32 good = (events_good && received_count == event_count);
+        all_good = all_good && good;
+        str8_list_pushf(scratch.arena, &report, "events: %s (%I64u/%I64u)\n", good ? "good" : "FAILED", received_count, event_count);
+        str8_list_pushf(scratch.arena, &report, "frames: %I64u sent, %I64u received\n", stats.frames_sent, stats.frames_received);
+      }
+      
+      str8_list_pushf(scratch.arena, &report, "loopback: %s\n", all_good ? "all checks passed" : "FAILED");
+      for(String8Node *n = report.first; n != 0; n = n->next)
+      {
+        fwrite(n->string.str, 1, n->string.size, stderr);
+      }
+      ctrl_remote_client_disconnect(client);
+    }
+    os_thread_wait(agent_thread, max_U64);
+    os_release_thread_handle(agent_thread);
+  }
+  
+  //////////////////////////////
+  //- rjf: agent mode - serve one client at a time, forever. the agent only
+  // listens on the loopback interface unless --listen-any is passed, & every
+  // client must present the token passed via --token
+  //
+  else if(token.size == 0 || token.size > CTRL_REMOTE_TOKEN_SIZE_MAX)
+  {
+    fprintf(stderr, "error: a token of at most %i bytes must be passed with --token:<token>; clients must present the same token\n", (int)CTRL_REMOTE_TOKEN_SIZE_MAX);
+  }
+  else for(;;)
+  {
+    String8 ip = cmd_line_has_flag(cmd_line, str8_lit("listen-any")) ? str8_zero() : str8_lit("127.0.0.1");
+    fprintf(stderr, "listening on %.*s:%.*s\n", str8_varg(ip.size != 0 ? ip : str8_lit("*")), str8_varg(port));
+    OS_Socket socket = {0};
+    os_socket_listen(&socket, ip, port);
+    if(!os_socket_status(&socket, OS_SocketStatus_Connected))
+    {
+      String8 error = os_socket_error_string(scratch.arena, &socket);
+      fprintf(stderr, "error: %.*s\n", str8_varg(error));
+      break;
+    }
+    fprintf(stderr, "client connected\n");
+    ctrl_remote_agent_serve(&socket, token, 0);
+    os_socket_close(&socket);
+    fprintf(stderr, "client disconnected\n");
+  }
+  
+  scratch_end(scratch);
+}
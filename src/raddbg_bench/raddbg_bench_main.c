@@ -0,0 +1,866 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "The RAD Debugger - UI Frame Benchmark"
+#define BUILD_CONSOLE_INTERFACE 1
+#define OS_FEATURE_GRAPHICAL 1
+#define OS_GFX_STUB 1
+#if !defined(R_BACKEND)
+# define R_BACKEND R_BACKEND_SOFTWARE
+#endif
+
+#define R_INIT_MANUAL 1
+#define TEX_INIT_MANUAL 1
+#define GEO_INIT_MANUAL 1
+#define F_INIT_MANUAL 1
+#define DF_INIT_MANUAL 1
+#define DF_GFX_INIT_MANUAL 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "task_system/task_system.h"
+#include "ico/ico.h"
+#include "rdi_format/rdi_format_local.h"
+#include "rdi_make/rdi_make_local.h"
+#include "mdesk/mdesk.h"
+#include "hash_store/hash_store.h"
+#include "file_stream/file_stream.h"
+#include "text_cache/text_cache.h"
+#include "path/path.h"
+#include "txti/txti.h"
+#include "coff/coff.h"
+#include "pe/pe.h"
+#include "codeview/codeview.h"
+#include "codeview/codeview_stringize.h"
+#include "msf/msf.h"
+#include "pdb/pdb.h"
+#include "pdb/pdb_stringize.h"
+#include "rdi_from_pdb/rdi_from_pdb.h"
+#include "regs/regs.h"
+#include "regs/rdi/regs_rdi.h"
+#include "x64/x64.h"
+#include "type_graph/type_graph.h"
+#include "dbgi/dbgi.h"
+#include "dasm_cache/dasm_cache.h"
+#include "flow_cache/flow_cache.h"
+#include "fuzzy_search/fuzzy_search.h"
+#include "demon/demon_inc.h"
+#include "eval/eval_inc.h"
+#include "ctrl/ctrl_inc.h"
+#include "link_cache/link_cache.h"
+#include "font_provider/font_provider_inc.h"
+#include "render/render_inc.h"
+#include "texture_cache/texture_cache.h"
+#include "geo_cache/geo_cache.h"
+#include "font_cache/font_cache.h"
+#include "draw/draw.h"
+#include "ui/ui_inc.h"
+#include "df/df_inc.h"
+#include "raddbg/raddbg.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "task_system/task_system.c"
+#include "ico/ico.c"
+#include "rdi_format/rdi_format_local.c"
+#include "rdi_make/rdi_make_local.c"
+#include "mdesk/mdesk.c"
+#include "hash_store/hash_store.c"
+#include "file_stream/file_stream.c"
+#include "text_cache/text_cache.c"
+#include "path/path.c"
+#include "txti/txti.c"
+#include "coff/coff.c"
+#include "pe/pe.c"
+#include "codeview/codeview.c"
+#include "codeview/codeview_stringize.c"
+#include "msf/msf.c"
+#include "pdb/pdb.c"
+#include "pdb/pdb_stringize.c"
+#include "rdi_from_pdb/rdi_from_pdb.c"
+#include "regs/regs.c"
+#include "regs/rdi/regs_rdi.c"
+#include "x64/x64.c"
+#include "type_graph/type_graph.c"
+#include "dbgi/dbgi.c"
+#include "dasm_cache/dasm_cache.c"
+#include "flow_cache/flow_cache.c"
+#include "fuzzy_search/fuzzy_search.c"
+#include "demon/demon_inc.c"
+#include "eval/eval_inc.c"
+#include "ctrl/ctrl_inc.c"
+#include "link_cache/link_cache.c"
+#include "font_provider/font_provider_inc.c"
+#include "render/render_inc.c"
+#include "texture_cache/texture_cache.c"
+#include "geo_cache/geo_cache.c"
+#include "font_cache/font_cache.c"
+#include "draw/draw.c"
+#include "ui/ui_inc.c"
+#include "df/df_inc.c"
+#include "raddbg/raddbg.c"
+
+////////////////////////////////
+//~ rjf: Benchmark Types
+
+typedef struct BENCH_Frame BENCH_Frame;
+struct BENCH_Frame
+{
+  OS_EventList events;
+};
+
+typedef struct BENCH_FrameArray BENCH_FrameArray;
+struct BENCH_FrameArray
+{
+  BENCH_Frame *v;
+  U64 count;
+};
+
+typedef struct BENCH_BucketCounts BENCH_BucketCounts;
+struct BENCH_BucketCounts
+{
+  U64 pass_count;
+  U64 batch_count;
+  U64 inst_count;
+};
+
+////////////////////////////////
+//~ rjf: Event Script Parsing
+//
+// Scripts are line-based; `#` starts a comment. Each line either adds an
+// event to the frame being built, or ends it:
+//
+//   move <x> <y>
+//   press <key> [ctrl] [shift] [alt]
+//   release <key> [ctrl] [shift] [alt]
+//   text <characters>
+//   scroll <dx> <dy>
+//   frame [repeat-count]
+//
+// Key names are those used in config files (os_g_key_cfg_string_table).
+
+internal OS_Key
+bench_key_from_string(String8 string)
+{
+  OS_Key result = OS_Key_Null;
+  for(OS_Key key = OS_Key_Null; key < OS_Key_COUNT; key = (OS_Key)(key+1))
+  {
+    if(str8_match(string, os_g_key_cfg_string_table[key], StringMatchFlag_CaseInsensitive))
+    {
+      result = key;
+      break;
+    }
+  }
+  return result;
+}
+
+internal BENCH_FrameArray
+bench_frame_array_from_script(Arena *arena, String8 script)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- rjf: parse lines into a list of per-frame event lists
+  typedef struct FrameNode FrameNode;
+  struct FrameNode
+  {
+    FrameNode *next;
+    BENCH_Frame v;
+  };
+  FrameNode *first_frame = 0;
+  FrameNode *last_frame = 0;
+  U64 frame_count = 0;
+  OS_EventList events = {0};
+  Vec2F32 mouse = {0};
+  U8 line_splits[] = {'\n', '\r'};
+  U8 word_splits[] = {' ', '\t'};
+  String8List lines = str8_split(scratch.arena, script, line_splits, ArrayCount(line_splits), 0);
+  for(String8Node *line_n = lines.first; line_n != 0; line_n = line_n->next)
+  {
+    String8 line = str8_skip_chop_whitespace(line_n->string);
+    if(line.size == 0 || line.str[0] == '#')
+    {
+      continue;
+    }
+    String8List words = str8_split(scratch.arena, line, word_splits, ArrayCount(word_splits), 0);
+    String8 cmd = words.first->string;
+    String8 arg0 = words.first->next ? words.first->next->string : str8_zero();
+    String8 arg1 = (words.first->next && words.first->next->next) ? words.first->next->next->string : str8_zero();
+    
+    //- rjf: end of frame
+    if(str8_match(cmd, str8_lit("frame"), 0))
+    {
+      U64 repeat_count = 1;
+      if(arg0.size != 0)
+      {
+        try_u64_from_str8_c_rules(arg0, &repeat_count);
+      }
+      for(U64 idx = 0; idx < repeat_count; idx += 1)
+      {
+        FrameNode *n = push_array(scratch.arena, FrameNode, 1);
+        if(idx == 0)
+        {
+          n->v.events = events;
+          MemoryZeroStruct(&events);
+        }
+        SLLQueuePush(first_frame, last_frame, n);
+        frame_count += 1;
+      }
+      continue;
+    }
+    
+    //- rjf: gather modifiers
+    OS_EventFlags flags = 0;
+    for(String8Node *n = words.first->next; n != 0; n = n->next)
+    {
+      if(str8_match(n->string, str8_lit("ctrl"), StringMatchFlag_CaseInsensitive))  { flags |= OS_EventFlag_Ctrl; }
+      if(str8_match(n->string, str8_lit("shift"), StringMatchFlag_CaseInsensitive)) { flags |= OS_EventFlag_Shift; }
+      if(str8_match(n->string, str8_lit("alt"), StringMatchFlag_CaseInsensitive))   { flags |= OS_EventFlag_Alt; }
+    }
+    
+    //- rjf: text -> one event per codepoint
+    if(str8_match(cmd, str8_lit("text"), 0))
+    {
+      String8 text = str8_skip_chop_whitespace(str8_skip(line, cmd.size));
+      String32 text32 = str32_from_8(scratch.arena, text);
+      for(U64 idx = 0; idx < text32.size; idx += 1)
+      {
+        OS_Event *e = push_array(arena, OS_Event, 1);
+        e->window = os_handle_zero();
+        e->kind = OS_EventKind_Text;
+        e->character = text32.str[idx];
+        e->pos = mouse;
+        DLLPushBack(events.first, events.last, e);
+        events.count += 1;
+      }
+      continue;
+    }
+    
+    //- rjf: everything else -> one event
+    OS_Event *e = push_array(arena, OS_Event, 1);
+    e->flags = flags;
+    if(str8_match(cmd, str8_lit("move"), 0))
+    {
+      mouse = v2f32((F32)f64_from_str8(arg0), (F32)f64_from_str8(arg1));
+      e->kind = OS_EventKind_MouseMove;
+    }
+    else if(str8_match(cmd, str8_lit("press"), 0))
+    {
+      e->kind = OS_EventKind_Press;
+      e->key = bench_key_from_string(arg0);
+    }
+    else if(str8_match(cmd, str8_lit("release"), 0))
+    {
+      e->kind = OS_EventKind_Release;
+      e->key = bench_key_from_string(arg0);
+    }
+    else if(str8_match(cmd, str8_lit("scroll"), 0))
+    {
+      e->kind = OS_EventKind_Scroll;
+      e->delta = v2f32((F32)f64_from_str8(arg0), (F32)f64_from_str8(arg1));
+    }
+    else
+    {
+      fprintf(stderr, "warning: unknown event script command \"%.*s\"\n", str8_varg(cmd));
+      continue;
+    }
+    e->pos = mouse;
+    DLLPushBack(events.first, events.last, e);
+    events.count += 1;
+  }
+  
+  //- rjf: trailing events with no `frame` -> implicit final frame
+  if(events.count != 0)
+  {
+    FrameNode *n = push_array(scratch.arena, FrameNode, 1);
+    n->v.events = events;
+    SLLQueuePush(first_frame, last_frame, n);
+    frame_count += 1;
+  }
+  
+  //- rjf: flatten
+  BENCH_FrameArray result = {0};
+  result.count = frame_count;
+  result.v = push_array(arena, BENCH_Frame, result.count);
+  {
+    U64 idx = 0;
+    for(FrameNode *n = first_frame; n != 0; n = n->next, idx += 1)
+    {
+      result.v[idx] = n->v;
+    }
+  }
+  
+  scratch_end(scratch);
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Draw Bucket Stats
+
+internal BENCH_BucketCounts
+bench_counts_from_bucket(D_Bucket *bucket)
+{
+  BENCH_BucketCounts counts = {0};
+  if(bucket != 0)
+  {
+    for(R_PassNode *n = bucket->passes.first; n != 0; n = n->next)
+    {
+      counts.pass_count += 1;
+      switch(n->v.kind)
+      {
+        default:{}break;
+        case R_PassKind_UI:
+        {
+          for(R_BatchGroup2DNode *group = n->v.params_ui->rects.first; group != 0; group = group->next)
+          {
+            counts.batch_count += group->batches.batch_count;
+            if(group->batches.bytes_per_inst != 0)
+            {
+              counts.inst_count += group->batches.byte_count / group->batches.bytes_per_inst;
+            }
+          }
+        }break;
+        case R_PassKind_Blur:
+        {
+          counts.batch_count += 1;
+          counts.inst_count += 1;
+        }break;
+      }
+    }
+  }
+  return counts;
+}
+
+////////////////////////////////
+//~ rjf: Synthetic Session
+//
+// NOTE: The session is one stopped x64 process on a synthetic ctrl machine,
+// with one module & one thread. The module's code, the thread's stack, & its
+// registers are generated here & served through ctrl's synthetic machine
+// callbacks; its debug info is a fixed RDI, built here & written next to a
+// matching source file. Each procedure calls the next, & the thread is
+// stopped BENCH_CALL_DEPTH calls deep, so every target view has content.
+
+#define BENCH_MACHINE_ID          (CTRL_MachineID_Local+1)
+#define BENCH_MODULE_BASE         0x140000000ull
+#define BENCH_CODE_VOFF           0x1000
+#define BENCH_PROC_COUNT          512
+#define BENCH_PROC_SIZE           64
+#define BENCH_LINE_SIZE           16
+#define BENCH_SRC_FIRST_PROC_LINE 3
+#define BENCH_SRC_LINES_PER_PROC  7
+#define BENCH_STACK_BASE          0x7ff000000000ull
+#define BENCH_STACK_SIZE          KB(64)
+#define BENCH_CALL_DEPTH          24
+
+typedef struct BENCH_Session BENCH_Session;
+struct BENCH_Session
+{
+  U8 *image;
+  U64 image_size;
+  U8 *stack;
+  REGS_RegBlockX64 regs;
+};
+
+global BENCH_Session *bench_session = 0;
+
+internal U64
+bench_proc_vaddr_from_idx(U64 idx)
+{
+  U64 result = BENCH_MODULE_BASE + BENCH_CODE_VOFF + (idx%BENCH_PROC_COUNT)*BENCH_PROC_SIZE;
+  return result;
+}
+
+internal U64
+bench_session_read_memory(DMN_Handle process, Rng1U64 range, void *dst)
+{
+  U64 result = 0;
+  Rng1U64 image_range = r1u64(BENCH_MODULE_BASE, BENCH_MODULE_BASE + bench_session->image_size);
+  Rng1U64 stack_range = r1u64(BENCH_STACK_BASE - BENCH_STACK_SIZE, BENCH_STACK_BASE);
+  if(contains_1u64(image_range, range.min))
+  {
+    result = Min(range.max, image_range.max) - range.min;
+    MemoryCopy(dst, bench_session->image + (range.min - image_range.min), result);
+  }
+  else if(contains_1u64(stack_range, range.min))
+  {
+    result = Min(range.max, stack_range.max) - range.min;
+    MemoryCopy(dst, bench_session->stack + (range.min - stack_range.min), result);
+  }
+  return result;
+}
+
+internal B32
+bench_session_read_reg_block(DMN_Handle thread, void *reg_block)
+{
+  MemoryCopyStruct((REGS_RegBlockX64 *)reg_block, &bench_session->regs);
+  return 1;
+}
+
+internal String8
+bench_source_text_from_proc_count(Arena *arena, U64 proc_count)
+{
+  String8List strings = {0};
+  str8_list_pushf(arena, &strings, "// raddbg_bench synthetic target\n\n");
+  for(U64 idx = 0; idx < proc_count; idx += 1)
+  {
+    str8_list_pushf(arena, &strings, "int proc_%I64u(void)\n{\n  int x = %I64u;\n  int z = proc_%I64u() + x + 1;\n  return z;\n}\n\n", idx, idx, (idx+1)%proc_count);
+  }
+  String8 result = str8_list_join(arena, &strings, 0);
+  return result;
+}
+
+internal String8List
+bench_rdi_blobs_from_source_path(Arena *arena, String8 src_path)
+{
+  P2R_Convert2Bake *c2b = push_array(arena, P2R_Convert2Bake, 1);
+  RDIM_BakeParams *p = &c2b->bake_params;
+  c2b->flags = P2R_ConvertFlag_All;
+  
+  //- rjf: top-level info & sections
+  U64 code_size = BENCH_PROC_COUNT*BENCH_PROC_SIZE;
+  p->top_level_info.arch = RDI_Arch_X64;
+  p->top_level_info.exe_name = str8_lit("bench_target.exe");
+  p->top_level_info.voff_max = BENCH_CODE_VOFF + code_size;
+  RDIM_BinarySection *text = rdim_binary_section_list_push(arena, &p->binary_sections);
+  text->name = str8_lit(".text");
+  text->flags = RDI_BinarySectionFlag_Read|RDI_BinarySectionFlag_Execute;
+  text->voff_first = BENCH_CODE_VOFF;
+  text->voff_opl = BENCH_CODE_VOFF + code_size;
+  RDIM_Type *int_type = rdim_type_chunk_list_push(arena, &p->types, 16);
+  int_type->kind = RDI_TypeKind_S32;
+  int_type->byte_size = 4;
+  int_type->name = str8_lit("int");
+  
+  //- rjf: unit, source file, & line table - each code line maps to the
+  // procedure's body line with the same index
+  RDIM_SrcFile *src = rdim_src_file_chunk_list_push(arena, &p->src_files, 1);
+  src->normal_full_path = lower_from_str8(arena, src_path);
+  RDIM_Unit *unit = rdim_unit_chunk_list_push(arena, &p->units, 1);
+  unit->unit_name = str8_lit("bench_target");
+  unit->source_file = src_path;
+  unit->line_table = rdim_line_table_chunk_list_push(arena, &p->line_tables, 1);
+  U64 lines_per_proc = BENCH_PROC_SIZE/BENCH_LINE_SIZE;
+  U64 line_count = BENCH_PROC_COUNT*lines_per_proc;
+  U64 *voffs = push_array(arena, U64, line_count+1);
+  U32 *line_nums = push_array(arena, U32, line_count);
+  for(U64 idx = 0; idx < line_count; idx += 1)
+  {
+    U64 proc_idx = idx/lines_per_proc;
+    voffs[idx] = BENCH_CODE_VOFF + idx*BENCH_LINE_SIZE;
+    line_nums[idx] = (U32)(BENCH_SRC_FIRST_PROC_LINE + proc_idx*BENCH_SRC_LINES_PER_PROC + 1 + idx%lines_per_proc);
+  }
+  voffs[line_count] = BENCH_CODE_VOFF + code_size;
+  RDIM_LineSequence *seq = rdim_line_table_push_sequence(arena, &p->line_tables, unit->line_table, src, voffs, line_nums, 0, line_count);
+  rdim_src_file_push_line_sequence(arena, &p->src_files, src, seq);
+  RDIM_Rng1U64 unit_voff_range = {BENCH_CODE_VOFF, BENCH_CODE_VOFF + code_size};
+  rdim_rng1u64_list_push(arena, &unit->voff_ranges, unit_voff_range);
+  
+  //- rjf: procedures
+  for(U64 idx = 0; idx < BENCH_PROC_COUNT; idx += 1)
+  {
+    RDIM_Symbol *proc = rdim_symbol_chunk_list_push(arena, &p->procedures, BENCH_PROC_COUNT);
+    proc->name = push_str8f(arena, "proc_%I64u", idx);
+    proc->link_name = proc->name;
+    proc->is_extern = 1;
+    RDIM_Scope *root_scope = rdim_scope_chunk_list_push(arena, &p->scopes, BENCH_PROC_COUNT);
+    root_scope->symbol = proc;
+    proc->root_scope = root_scope;
+    RDIM_Rng1U64 voff_range = {BENCH_CODE_VOFF + idx*BENCH_PROC_SIZE, BENCH_CODE_VOFF + (idx+1)*BENCH_PROC_SIZE};
+    rdim_scope_push_voff_range(arena, &p->scopes, root_scope, voff_range);
+    RDIM_Local *local = rdim_scope_push_local(arena, &p->scopes, root_scope);
+    local->kind = RDI_LocalKind_Variable;
+    local->name = str8_lit("x");
+    local->type = int_type;
+  }
+  
+  //- rjf: bake & serialize
+  P2R_Bake2Serialize *b2s = p2r_bake(arena, c2b);
+  RDIM_SerializedSectionBundle bundle = rdim_serialized_section_bundle_from_bake_results(&b2s->bake_results);
+  String8List blobs = rdim_file_blobs_from_section_bundle(arena, &bundle);
+  return blobs;
+}
+
+internal void
+bench_session_begin(Arena *arena)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  bench_session = push_array(arena, BENCH_Session, 1);
+  
+  //- rjf: write source & debug info
+  String8 dir_path = push_str8f(scratch.arena, "%S/raddbg", os_string_from_system_path(scratch.arena, OS_SystemPath_UserProgramData));
+  os_make_directory(dir_path);
+  dir_path = push_str8f(scratch.arena, "%S/bench", dir_path);
+  os_make_directory(dir_path);
+  String8 src_path = push_str8f(arena, "%S/bench_target.c", dir_path);
+  String8 rdi_path = push_str8f(arena, "%S/bench_target.rdi", dir_path);
+  os_write_data_to_file_path(src_path, bench_source_text_from_proc_count(scratch.arena, BENCH_PROC_COUNT));
+  os_write_data_list_to_file_path(rdi_path, bench_rdi_blobs_from_source_path(scratch.arena, src_path));
+  U64 rdi_timestamp = os_properties_from_file_path(rdi_path).modified;
+  
+  //- rjf: generate image - zeroed headers (disassembly reads whole aligned
+  // blocks, starting at the module's base), then code; every procedure is the
+  // same four lines: prologue, arithmetic on locals, call of the next
+  // procedure, epilogue
+  bench_session->image_size = BENCH_CODE_VOFF + BENCH_PROC_COUNT*BENCH_PROC_SIZE;
+  bench_session->image = push_array(arena, U8, bench_session->image_size);
+  for(U64 idx = 0; idx < BENCH_PROC_COUNT; idx += 1)
+  {
+    U8 *proc = bench_session->image + BENCH_CODE_VOFF + idx*BENCH_PROC_SIZE;
+    U64 call_vaddr = bench_proc_vaddr_from_idx(idx) + 2*BENCH_LINE_SIZE;
+    S32 call_rel = (S32)(bench_proc_vaddr_from_idx(idx+1) - (call_vaddr+5));
+    U8 lines[4][BENCH_LINE_SIZE] =
+    {
+      {0x55, 0x48, 0x89, 0xe5, 0x48, 0x83, 0xec, 0x20, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+      {0xc7, 0x45, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x45, 0xfc, 0x83, 0xc0, 0x01, 0x89, 0x45, 0xf8},
+      {0xe8, 0x00, 0x00, 0x00, 0x00, 0x89, 0x45, 0xf4, 0x8b, 0x45, 0xf4, 0x03, 0x45, 0xf8, 0x66, 0x90},
+      {0x48, 0x83, 0xc4, 0x20, 0x5d, 0xc3, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc},
+    };
+    U32 imm = (U32)idx;
+    MemoryCopy(&lines[1][3], &imm, sizeof(imm));
+    MemoryCopy(&lines[2][1], &call_rel, sizeof(call_rel));
+    MemoryCopy(proc, lines, sizeof(lines));
+  }
+  
+  //- rjf: generate stack - return addresses of each call in the chain, then
+  // a null return address to end unwinding; everything else is filler
+  bench_session->stack = push_array(arena, U8, BENCH_STACK_SIZE);
+  for(U64 idx = 0; idx < BENCH_STACK_SIZE; idx += 1)
+  {
+    bench_session->stack[idx] = (U8)(idx*31);
+  }
+  U64 rsp = BENCH_STACK_BASE - BENCH_STACK_SIZE/2;
+  {
+    U64 *slots = (U64 *)(bench_session->stack + (rsp - (BENCH_STACK_BASE - BENCH_STACK_SIZE)));
+    U64 slot_idx = 0;
+    for(U64 depth = BENCH_CALL_DEPTH-1; depth > 0; depth -= 1, slot_idx += 1)
+    {
+      slots[slot_idx] = bench_proc_vaddr_from_idx(depth-1) + 2*BENCH_LINE_SIZE + 5;
+    }
+    slots[slot_idx] = 0;
+  }
+  
+  //- rjf: generate registers - stopped in the deepest call's body
+  {
+    REGS_RegBlockX64 *regs = &bench_session->regs;
+    U64 *gprs[] = {&regs->rax.u64, &regs->rcx.u64, &regs->rdx.u64, &regs->rbx.u64, &regs->rsi.u64, &regs->rdi.u64,
+      &regs->r8.u64, &regs->r9.u64, &regs->r10.u64, &regs->r11.u64, &regs->r12.u64, &regs->r13.u64, &regs->r14.u64, &regs->r15.u64};
+    for(U64 idx = 0; idx < ArrayCount(gprs); idx += 1)
+    {
+      *gprs[idx] = 0x1111111111111111ull*(idx+1);
+    }
+    regs->rip.u64 = bench_proc_vaddr_from_idx(BENCH_CALL_DEPTH-1) + BENCH_LINE_SIZE;
+    regs->rsp.u64 = rsp;
+    regs->rbp.u64 = rsp + 0x20;
+    regs->rflags.u64 = 0x202;
+  }
+  
+  //- rjf: register synthetic machine
+  {
+    CTRL_SyntheticMachine machine = {BENCH_MACHINE_ID, bench_session_read_memory, bench_session_read_reg_block};
+    ctrl_set_synthetic_machine(&machine);
+  }
+  
+  //- rjf: introduce process, module, & thread; stop
+  {
+    DMN_Handle process = {1};
+    DMN_Handle thread = {2};
+    DMN_Handle module = {3};
+    CTRL_EventList events = {0};
+    CTRL_Event *event = 0;
+    event = ctrl_event_list_push(scratch.arena, &events);
+    event->kind       = CTRL_EventKind_NewProc;
+    event->machine_id = BENCH_MACHINE_ID;
+    event->entity     = process;
+    event->arch       = Architecture_x64;
+    event->entity_id  = 1;
+    event = ctrl_event_list_push(scratch.arena, &events);
+    event->kind       = CTRL_EventKind_NewModule;
+    event->machine_id = BENCH_MACHINE_ID;
+    event->entity     = module;
+    event->parent     = process;
+    event->arch       = Architecture_x64;
+    event->vaddr_rng  = r1u64(BENCH_MODULE_BASE, BENCH_MODULE_BASE + bench_session->image_size);
+    event->rip_vaddr  = BENCH_MODULE_BASE;
+    event->string     = str8_lit("bench_target.exe");
+    event->timestamp  = rdi_timestamp;
+    event = ctrl_event_list_push(scratch.arena, &events);
+    event->kind       = CTRL_EventKind_ModuleDebugInfoPathChange;
+    event->machine_id = BENCH_MACHINE_ID;
+    event->entity     = module;
+    event->parent     = process;
+    event->string     = rdi_path;
+    event->timestamp  = rdi_timestamp;
+    event = ctrl_event_list_push(scratch.arena, &events);
+    event->kind       = CTRL_EventKind_NewThread;
+    event->machine_id = BENCH_MACHINE_ID;
+    event->entity     = thread;
+    event->parent     = process;
+    event->arch       = Architecture_x64;
+    event->entity_id  = 2;
+    event->stack_base = BENCH_STACK_BASE;
+    event->rip_vaddr  = bench_session->regs.rip.u64;
+    event = ctrl_event_list_push(scratch.arena, &events);
+    event->kind       = CTRL_EventKind_Stopped;
+    event->cause      = CTRL_EventCause_InterruptedByHalt;
+    event->machine_id = BENCH_MACHINE_ID;
+    event->entity     = thread;
+    ctrl_c2u_push_events(&events);
+  }
+  
+  //- rjf: open debug info - normally the control thread does this on module load
+  {
+    DI_Key key = {rdi_path, rdi_timestamp};
+    di_open(&key);
+  }
+  
+  scratch_end(scratch);
+}
+
+internal void
+bench_session_focus_views(String8List view_names)
+{
+  //- rjf: snap code views to the stopped thread - it was selected before its
+  // debug info finished loading
+  {
+    DF_CmdParams params = df_cmd_params_from_gfx();
+    params.entity = df_state->ctrl_ctx.thread;
+    df_cmd_params_mark_slot(&params, DF_CmdParamSlot_Entity);
+    df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_FindThread));
+  }
+  
+  //- rjf: bring named tabs to front; point memory views at the stack
+  for(DF_Window *ws = df_gfx_state->first_window; ws != 0; ws = ws->next)
+  {
+    for(DF_Panel *panel = ws->root_panel; !df_panel_is_nil(panel); panel = df_panel_rec_df_pre(panel).next)
+    {
+      for(DF_View *view = panel->first_tab_view; !df_view_is_nil(view); view = view->next)
+      {
+        for(String8Node *n = view_names.first; n != 0; n = n->next)
+        {
+          if(str8_match(n->string, view->spec->info.name, StringMatchFlag_CaseInsensitive))
+          {
+            panel->selected_tab_view = df_handle_from_view(view);
+            break;
+          }
+        }
+        if(str8_match(view->spec->info.name, str8_lit("memory"), 0))
+        {
+          DF_CmdParams params = df_cmd_params_from_view(ws, panel, view);
+          params.vaddr = bench_session->regs.rsp.u64;
+          df_cmd_params_mark_slot(&params, DF_CmdParamSlot_VirtualAddr);
+          df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_GoToAddress));
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: unpack command line arguments
+  String8 script_path = cmd_line_string(cmd_line, str8_lit("script"));
+  String8 out_path = cmd_line_string(cmd_line, str8_lit("out"));
+  String8List open_paths = cmd_line_strings(cmd_line, str8_lit("open"));
+  String8List watch_exprs = cmd_line_strings(cmd_line, str8_lit("watch"));
+  String8List tab_names = cmd_line_strings(cmd_line, str8_lit("tabs"));
+  B32 keep_layout = cmd_line_has_flag(cmd_line, str8_lit("keep_layout"));
+  U64 warmup_frame_count = 8;
+  U64 settle_frame_count_max = 256;
+  U64 min_frame_count = 0;
+  U64 width = 1280;
+  U64 height = 720;
+  try_u64_from_str8_c_rules(cmd_line_string(cmd_line, str8_lit("warmup")), &warmup_frame_count);
+  try_u64_from_str8_c_rules(cmd_line_string(cmd_line, str8_lit("frames")), &min_frame_count);
+  try_u64_from_str8_c_rules(cmd_line_string(cmd_line, str8_lit("width")), &width);
+  try_u64_from_str8_c_rules(cmd_line_string(cmd_line, str8_lit("height")), &height);
+  if(cmd_line_has_flag(cmd_line, str8_lit("help")) || cmd_line_has_flag(cmd_line, str8_lit("?")))
+  {
+    fprintf(stderr, "--- raddbg_bench -----------------------------------------------------------\n\n");
+    fprintf(stderr, "Drives the debugger frontend headlessly from a recorded event script & reports\n");
+    fprintf(stderr, "per-frame timings as CSV. Usage: raddbg_bench [options] [target] [target args]\n\n");
+    fprintf(stderr, "--script:<path>  Event script to replay (see raddbg_bench_main.c for format)\n");
+    fprintf(stderr, "--out:<path>     Write CSV here, rather than to stdout\n");
+    fprintf(stderr, "--frames:<n>     Minimum number of measured frames (pads script with idle frames)\n");
+    fprintf(stderr, "--warmup:<n>     Unmeasured frames to run first (default: 8)\n");
+    fprintf(stderr, "--width:<n>      Window width in pixels (default: 1280)\n");
+    fprintf(stderr, "--height:<n>     Window height in pixels (default: 720)\n");
+    fprintf(stderr, "--open:<paths>   Source files to open before measuring\n");
+    fprintf(stderr, "--watch:<exprs>  Watch expressions to add before measuring\n");
+    fprintf(stderr, "--tabs:<names>   Views to bring to front (default: registers,memory - or\n");
+    fprintf(stderr, "                 watch,memory if --watch is given)\n");
+    fprintf(stderr, "--keep_layout    Keep the user config's panel layout, rather than resetting\n");
+    fprintf(stderr, "                 to the default one (which has all of the target views)\n");
+    fprintf(stderr, "--user:<path>    User config file to use (recommended, to not disturb your own)\n");
+    fprintf(stderr, "--project:<path> Project config file to use\n\n");
+    fprintf(stderr, "A stopped synthetic process is simulated, so that views which need a target\n");
+    fprintf(stderr, "(disassembly, registers, call stack, memory) are part of the measurement. Its\n");
+    fprintf(stderr, "source & debug info are written to the user's raddbg/bench data directory.\n");
+    return;
+  }
+  
+  //- rjf: load event script
+  BENCH_FrameArray frames = {0};
+  if(script_path.size != 0)
+  {
+    String8 script = os_data_from_file_path(scratch.arena, script_path);
+    if(script.size == 0)
+    {
+      fprintf(stderr, "error: could not read event script \"%.*s\"\n", str8_varg(script_path));
+      return;
+    }
+    frames = bench_frame_array_from_script(scratch.arena, script);
+  }
+  
+  //- rjf: set up layers
+  os_stub_set_client_size(v2f32((F32)width, (F32)height));
+  ctrl_set_wakeup_hook(wakeup_hook_ctrl);
+  r_init(cmd_line);
+  tex_init();
+  geo_init();
+  f_init();
+  DF_StateDeltaHistory *hist = df_state_delta_history_alloc();
+  df_core_init(cmd_line, hist);
+  df_gfx_init(update_and_render, df_state_delta_history());
+  
+  //- rjf: set up synthetic session - stopped process, target from command
+  // line, opened files, watches
+  bench_session_begin(scratch.arena);
+  {
+    String8List args = cmd_line->inputs;
+    if(args.node_count > 0 && args.first->string.size != 0)
+    {
+      String8 current_path = os_string_from_system_path(scratch.arena, OS_SystemPath_Current);
+      String8 exe_name = args.first->string;
+      if(path_style_from_str8(exe_name) == PathStyle_Relative)
+      {
+        exe_name = path_normalized_from_string(scratch.arena, push_str8f(scratch.arena, "%S/%S", current_path, exe_name));
+      }
+      DF_Entity *target = df_entity_alloc(0, df_entity_root(), DF_EntityKind_Target);
+      df_entity_equip_b32(target, 1);
+      df_entity_equip_cfg_src(target, DF_CfgSrc_CommandLine);
+      DF_Entity *exe = df_entity_alloc(0, target, DF_EntityKind_Executable);
+      df_entity_equip_name(0, exe, exe_name);
+    }
+    for(String8Node *n = open_paths.first; n != 0; n = n->next)
+    {
+      DF_CmdParams params = df_cmd_params_from_gfx();
+      params.file_path = n->string;
+      df_cmd_params_mark_slot(&params, DF_CmdParamSlot_FilePath);
+      df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_Open));
+    }
+    for(String8Node *n = watch_exprs.first; n != 0; n = n->next)
+    {
+      DF_CmdParams params = df_cmd_params_from_gfx();
+      params.string = n->string;
+      df_cmd_params_mark_slot(&params, DF_CmdParamSlot_String);
+      df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_ToggleWatchExpression));
+    }
+  }
+  
+  //- rjf: warm up - let windows open (from config, on the first frame), fonts
+  // rasterize, caches fill
+  for(U64 idx = 0; idx < Max(warmup_frame_count, 2); idx += 1)
+  {
+    update_and_render(os_handle_zero(), 0);
+    
+    //- rjf: windows are open after the first frame -> reset their layouts; the
+    // compact layout, picked for small monitors, has no registers/memory views
+    if(idx == 0 && !keep_layout)
+    {
+      for(DF_Window *ws = df_gfx_state->first_window; ws != 0; ws = ws->next)
+      {
+        DF_CmdParams params = df_cmd_params_from_window(ws);
+        df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_ResetToDefaultPanels));
+      }
+    }
+    
+    //- rjf: layouts are settled -> bring measured views to front (several
+    // share panels with other tabs in the default layout)
+    if(idx == 1)
+    {
+      if(tab_names.node_count == 0)
+      {
+        str8_list_push(scratch.arena, &tab_names, watch_exprs.node_count != 0 ? str8_lit("watch") : str8_lit("registers"));
+        str8_list_push(scratch.arena, &tab_names, str8_lit("memory"));
+      }
+      bench_session_focus_views(tab_names);
+    }
+  }
+  
+  //- rjf: settle - keep going while the frontend asks for frames (e.g. while
+  // the memory view animates its scroll to the stack), so measured frames are
+  // steady
+  for(U64 idx = 0; idx < settle_frame_count_max && df_gfx_state->num_frames_requested != 0; idx += 1)
+  {
+    update_and_render(os_handle_zero(), 0);
+  }
+  
+  //- rjf: measured frames
+  String8List csv = {0};
+  str8_list_pushf(scratch.arena, &csv, "frame,window,event_count,frame_us,build_us,layout_us,draw_us,submit_us,box_count,layout_reused_x,layout_reused_y,pass_count,batch_count,inst_count\n");
+  U64 frame_count = Max(frames.count, min_frame_count);
+  for(U64 frame_idx = 0; frame_idx < frame_count && df_gfx_state->first_window != 0; frame_idx += 1)
+  {
+    U64 event_count = 0;
+    if(frame_idx < frames.count)
+    {
+      OS_EventList *events = &frames.v[frame_idx].events;
+      for(OS_Event *e = events->first; e != 0; e = e->next)
+      {
+        e->window = df_gfx_state->first_window->os;
+        e->timestamp_us = os_now_microseconds();
+      }
+      os_stub_push_events(events);
+      event_count = events->count;
+    }
+    update_and_render(os_handle_zero(), 0);
+    U64 frame_us = frame_time_us_history[(frame_time_us_history_idx-1)%ArrayCount(frame_time_us_history)];
+    U64 window_idx = 0;
+    for(DF_Window *w = df_gfx_state->first_window; w != 0; w = w->next, window_idx += 1)
+    {
+      BENCH_BucketCounts counts = bench_counts_from_bucket(w->draw_bucket);
+      str8_list_pushf(scratch.arena, &csv, "%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u,%I64u\n",
+                      frame_idx, window_idx, event_count, frame_us,
+                      w->last_ui_build_us, w->ui->last_build_layout_us, w->last_draw_build_us, w->last_submit_us,
+                      w->ui->build_box_count, w->ui->last_build_layout_reused_box_count[Axis2_X], w->ui->last_build_layout_reused_box_count[Axis2_Y], counts.pass_count, counts.batch_count, counts.inst_count);
+    }
+  }
+  
+  //- rjf: write results
+  if(out_path.size != 0)
+  {
+    os_write_data_list_to_file_path(out_path, csv);
+  }
+  else
+  {
+    for(String8Node *n = csv.first; n != 0; n = n->next)
+    {
+      fwrite(n->string.str, 1, n->string.size, stdout);
+    }
+    fflush(stdout);
+  }
+  
+  scratch_end(scratch);
+}
@@ -0,0 +1,344 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "rdi_bench"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "rdi_format/rdi_format_local.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "rdi_format/rdi_format_local.c"
+
+////////////////////////////////
+//~ rjf: Random Numbers
+
+internal U64
+bench_rand_u64(U64 *state)
+{
+  U64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+////////////////////////////////
+//~ rjf: Reference Lookups
+//
+// NOTE: the textbook early-out binary searches, which the parsing library
+// used before its lookups were made branchless & page-directory-accelerated.
+// kept here as the baseline, & to check results against.
+
+internal U64
+bench_reference_vmap_idx_from_voff(RDI_VMapEntry *vmap, U64 vmap_count, U64 voff)
+{
+  U64 result = 0;
+  if(vmap_count > 0 && vmap[0].voff <= voff && voff < vmap[vmap_count - 1].voff)
+  {
+    U64 first = 0;
+    U64 opl   = vmap_count;
+    for(;;)
+    {
+      U64 mid = (first + opl)/2;
+      if(vmap[mid].voff < voff)
+      {
+        first = mid;
+      }
+      else if(vmap[mid].voff > voff)
+      {
+        opl = mid;
+      }
+      else
+      {
+        first = mid;
+        break;
+      }
+      if(opl - first <= 1)
+      {
+        break;
+      }
+    }
+    result = vmap[first].idx;
+  }
+  return result;
+}
+
+internal U64
+bench_reference_line_info_idx_from_voff(RDI_ParsedLineTable *line_info, U64 voff)
+{
+  U64 result = 0;
+  if(line_info->count > 0 && line_info->voffs[0] <= voff && voff < line_info->voffs[line_info->count - 1])
+  {
+    U64 first = 0;
+    U64 opl   = line_info->count;
+    for(;;)
+    {
+      U64 mid = (first + opl)/2;
+      if(line_info->voffs[mid] < voff)
+      {
+        first = mid;
+      }
+      else if(line_info->voffs[mid] > voff)
+      {
+        opl = mid;
+      }
+      else
+      {
+        first = mid;
+        break;
+      }
+      if(opl - first <= 1)
+      {
+        break;
+      }
+    }
+    result = first;
+    for(;result != 0 && line_info->voffs[result-1] == voff;)
+    {
+      result -= 1;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Arena *arena = arena_alloc();
+  
+  //////////////////////////////
+  //- rjf: extract command line parameters
+  //
+  String8 input_name = str8_list_first(&cmd_line->inputs);
+  U64 lookup_count = 1000000;
+  U64 seed = 0x9e3779b97f4a7c15ull;
+  {
+    String8 count_string = cmd_line_string(cmd_line, str8_lit("count"));
+    String8 seed_string = cmd_line_string(cmd_line, str8_lit("seed"));
+    if(count_string.size != 0) { try_u64_from_str8_c_rules(count_string, &lookup_count); }
+    if(seed_string.size != 0)  { try_u64_from_str8_c_rules(seed_string, &seed); }
+    lookup_count = Max(1, lookup_count);
+    seed = (seed == 0 ? 1 : seed);
+  }
+  if(input_name.size == 0 || cmd_line_has_flag(cmd_line, str8_lit("help")))
+  {
+    fprintf(stderr, "--- rdi_bench ----------------------------------------------------------------\n\n");
+    fprintf(stderr, "Measures voff -> vmap entry & voff -> line lookups per second against an RDI\n");
+    fprintf(stderr, "file, comparing the reference binary search, the branchless search, & the vmap\n");
+    fprintf(stderr, "page directories (when the file has them). Usage: rdi_bench [options] <path>\n\n");
+    fprintf(stderr, "--count:<n>  Number of random lookups per measurement (default: 1000000)\n");
+    fprintf(stderr, "--seed:<n>   Random seed for generated voffs\n");
+    return;
+  }
+  
+  //////////////////////////////
+  //- rjf: map & parse file
+  //
+  String8 input_data = {0};
+  {
+    OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, input_name);
+    FileProperties props = os_properties_from_file(file);
+    OS_Handle map = os_file_map_open(OS_AccessFlag_Read, file);
+    void *base = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size));
+    if(base != 0)
+    {
+      input_data = str8((U8 *)base, props.size);
+    }
+  }
+  RDI_Parsed rdi_ = {0};
+  RDI_Parsed *rdi = &rdi_;
+  RDI_ParseStatus status = rdi_parse(input_data.str, input_data.size, rdi);
+  {
+    U64 decompressed_size = rdi_decompressed_size_from_parsed(rdi);
+    if(status == RDI_ParseStatus_Good && decompressed_size > input_data.size)
+    {
+      U8 *decompressed_data = push_array_no_zero(arena, U8, decompressed_size);
+      rdi_decompress_parsed(decompressed_data, decompressed_size, rdi);
+      status = rdi_parse(decompressed_data, decompressed_size, rdi);
+    }
+  }
+  if(status != RDI_ParseStatus_Good)
+  {
+    fprintf(stderr, "error (input): Could not load \"%.*s\" as an RDI file.\n", str8_varg(input_name));
+    return;
+  }
+  
+  //////////////////////////////
+  //- rjf: benchmark vmap lookups
+  //
+  B32 mismatch = 0;
+  U64 *voffs = push_array_no_zero(arena, U64, lookup_count);
+  String8List out = {0};
+  str8_list_pushf(arena, &out, "%-12s %10s %10s %16s %16s %16s\n", "table", "entries", "pages", "reference (M/s)", "branchless (M/s)", "paged (M/s)");
+  {
+    struct
+    {
+      char *name;
+      RDI_SectionKind vmap_kind;
+      RDI_SectionKind pages_kind;
+    }
+    vmap_tables[] =
+    {
+      {"UnitVMap",   RDI_SectionKind_UnitVMap,   RDI_SectionKind_UnitVMapPages},
+      {"GlobalVMap", RDI_SectionKind_GlobalVMap, RDI_SectionKind_GlobalVMapPages},
+      {"ScopeVMap",  RDI_SectionKind_ScopeVMap,  RDI_SectionKind_ScopeVMapPages},
+    };
+    for(U64 table_idx = 0; table_idx < ArrayCount(vmap_tables); table_idx += 1)
+    {
+      U64 vmap_count = 0;
+      RDI_VMapEntry *vmap = rdi_section_raw_table_from_kind(rdi, vmap_tables[table_idx].vmap_kind, &vmap_count);
+      U64 pages_count = 0;
+      U32 *pages = 0;
+      if(vmap_tables[table_idx].pages_kind < rdi->sections_count)
+      {
+        pages = rdi_section_raw_table_from_kind(rdi, vmap_tables[table_idx].pages_kind, &pages_count);
+      }
+      if(vmap_count < 2 || vmap[vmap_count-1].voff <= vmap[0].voff)
+      {
+        continue;
+      }
+      
+      // rjf: generate voffs
+      U64 voff_min = vmap[0].voff;
+      U64 voff_span = vmap[vmap_count-1].voff - voff_min;
+      for(U64 idx = 0; idx < lookup_count; idx += 1)
+      {
+        voffs[idx] = voff_min + bench_rand_u64(&seed)%voff_span;
+      }
+      
+      // rjf: time each lookup strategy; sum results so nothing is optimized out
+      U64 sums[3] = {0};
+      F64 rates[3] = {0};
+      for(U64 strategy = 0; strategy < 3; strategy += 1)
+      {
+        if(strategy == 2 && pages_count == 0)
+        {
+          continue;
+        }
+        U64 sum = 0;
+        U64 begin_us = os_now_microseconds();
+        switch(strategy)
+        {
+          case 0:{for(U64 idx = 0; idx < lookup_count; idx += 1) { sum += bench_reference_vmap_idx_from_voff(vmap, vmap_count, voffs[idx]); }}break;
+          case 1:{for(U64 idx = 0; idx < lookup_count; idx += 1) { sum += rdi_vmap_idx_from_voff(vmap, vmap_count, voffs[idx]); }}break;
+          case 2:{for(U64 idx = 0; idx < lookup_count; idx += 1) { sum += rdi_vmap_idx_from_voff_pages(vmap, vmap_count, pages, pages_count, voffs[idx]); }}break;
+        }
+        U64 end_us = os_now_microseconds();
+        sums[strategy] = sum;
+        rates[strategy] = (F64)lookup_count / (F64)Max(1, end_us-begin_us);
+      }
+      if(sums[1] != sums[0] || (pages_count != 0 && sums[2] != sums[0]))
+      {
+        mismatch = 1;
+      }
+      str8_list_pushf(arena, &out, "%-12s %10I64u %10I64u %16.2f %16.2f ", vmap_tables[table_idx].name, vmap_count, pages_count, rates[0], rates[1]);
+      if(pages_count != 0)
+      {
+        str8_list_pushf(arena, &out, "%16.2f\n", rates[2]);
+      }
+      else
+      {
+        str8_list_pushf(arena, &out, "%16s\n", "-");
+      }
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: benchmark line lookups - voffs are drawn from each unit's line
+  // table, weighted by the table's size
+  //
+  {
+    U64 units_count = 0;
+    RDI_Unit *units = rdi_table_from_name(rdi, Units, &units_count);
+    RDI_ParsedLineTable *unit_line_tables = push_array(arena, RDI_ParsedLineTable, units_count);
+    U64 *unit_line_count_prefix = push_array(arena, U64, units_count+1);
+    for(U64 idx = 0; idx < units_count; idx += 1)
+    {
+      RDI_LineTable *line_table = rdi_line_table_from_unit(rdi, &units[idx]);
+      rdi_parsed_from_line_table(rdi, line_table, &unit_line_tables[idx]);
+      unit_line_count_prefix[idx+1] = unit_line_count_prefix[idx] + unit_line_tables[idx].count;
+    }
+    U64 total_lines_count = unit_line_count_prefix[units_count];
+    if(total_lines_count != 0)
+    {
+      // rjf: generate (unit, voff) pairs
+      U32 *lookup_units = push_array_no_zero(arena, U32, lookup_count);
+      for(U64 idx = 0; idx < lookup_count; idx += 1)
+      {
+        U64 line_num = bench_rand_u64(&seed)%total_lines_count;
+        U64 first = 0;
+        U64 opl = units_count;
+        for(;opl - first > 1;)
+        {
+          U64 mid = (first + opl)/2;
+          if(unit_line_count_prefix[mid] <= line_num) { first = mid; } else { opl = mid; }
+        }
+        RDI_ParsedLineTable *lt = &unit_line_tables[first];
+        U64 voff_min = lt->voffs[0];
+        U64 voff_span = lt->voffs[lt->count-1] - voff_min;
+        lookup_units[idx] = (U32)first;
+        voffs[idx] = voff_min + (voff_span ? bench_rand_u64(&seed)%voff_span : 0);
+      }
+      
+      // rjf: time reference & branchless searches
+      U64 sums[2] = {0};
+      F64 rates[2] = {0};
+      for(U64 strategy = 0; strategy < 2; strategy += 1)
+      {
+        U64 sum = 0;
+        U64 begin_us = os_now_microseconds();
+        if(strategy == 0)
+        {
+          for(U64 idx = 0; idx < lookup_count; idx += 1) { sum += bench_reference_line_info_idx_from_voff(&unit_line_tables[lookup_units[idx]], voffs[idx]); }
+        }
+        else
+        {
+          for(U64 idx = 0; idx < lookup_count; idx += 1) { sum += rdi_line_info_idx_range_from_voff(&unit_line_tables[lookup_units[idx]], voffs[idx], 0); }
+        }
+        U64 end_us = os_now_microseconds();
+        sums[strategy] = sum;
+        rates[strategy] = (F64)lookup_count / (F64)Max(1, end_us-begin_us);
+      }
+      if(sums[1] != sums[0])
+      {
+        mismatch = 1;
+      }
+      str8_list_pushf(arena, &out, "%-12s %10I64u %10s %16.2f %16.2f %16s\n", "LineTables", total_lines_count, "-", rates[0], rates[1], "-");
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: write results, report mismatches
+  //
+  for(String8Node *n = out.first; n != 0; n = n->next)
+  {
+    fwrite(n->string.str, 1, n->string.size, stdout);
+  }
+  if(mismatch)
+  {
+    fprintf(stderr, "error: lookup results differ from the reference search.\n");
+  }
+}
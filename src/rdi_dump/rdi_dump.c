@@ -786,3 +786,373 @@ rdi_stringize_inline_site(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_I
   str8_list_pushf(arena, out, "%.*sowner_type_idx=%u\n", indent_level, rdi_stringize_spaces, inline_site->owner_type_idx);
   str8_list_pushf(arena, out, "%.*sline_table_idx=%u\n", indent_level, rdi_stringize_spaces, inline_site->line_table_idx);
 }
+
+////////////////////////////////
+//~ rjf: Dump Section Functions
+
+read_only global RDI_DumpSectionInfo rdi_dump_section_info_table[] =
+{
+  {str8_lit_comp("data_sections"),    str8_lit_comp("# DATA SECTIONS:\n"),      1},
+  {str8_lit_comp("top_level_info"),   str8_lit_comp("# TOP LEVEL INFO:\n"),     1},
+  {str8_lit_comp("binary_sections"),  str8_lit_comp("# BINARY SECTIONS:\n"),    4096},
+  {str8_lit_comp("file_paths"),       str8_lit_comp("# FILE PATHS\n"),          4096},
+  {str8_lit_comp("source_files"),     str8_lit_comp("# SOURCE FILES\n"),        4096},
+  {str8_lit_comp("line_tables"),      str8_lit_comp("# LINE TABLES\n"),         256},
+  {str8_lit_comp("source_line_maps"), str8_lit_comp("# SOURCE LINE MAPS\n"),    256},
+  {str8_lit_comp("units"),            str8_lit_comp("# UNITS\n"),               4096},
+  {str8_lit_comp("unit_vmap"),        str8_lit_comp("# UNIT VMAP\n"),           65536},
+  {str8_lit_comp("type_nodes"),       str8_lit_comp("# TYPE NODES:\n"),         4096},
+  {str8_lit_comp("udt_data"),         str8_lit_comp("# UDTS:\n"),               4096},
+  {str8_lit_comp("global_variables"), str8_lit_comp("# GLOBAL VARIABLES:\n"),   4096},
+  {str8_lit_comp("global_vmap"),      str8_lit_comp("# GLOBAL VMAP:\n"),        65536},
+  {str8_lit_comp("thread_variables"), str8_lit_comp("# THREAD VARIABLES:\n"),   4096},
+  {str8_lit_comp("procedures"),       str8_lit_comp("# PROCEDURES:\n"),         4096},
+  {str8_lit_comp("scopes"),           str8_lit_comp("# SCOPES:\n"),             4096},
+  {str8_lit_comp("scope_vmap"),       str8_lit_comp("# SCOPE VMAP:\n"),         65536},
+  {str8_lit_comp("inline_sites"),     str8_lit_comp("# INLINE SITES:\n"),       4096},
+  {str8_lit_comp("name_maps"),        str8_lit_comp("# NAME MAP:\n"),           1},
+  {str8_lit_comp("strings"),          str8_lit_comp("# STRINGS:\n"),            65536},
+};
+
+internal RDI_DumpSection
+rdi_dump_section_from_string(String8 string)
+{
+  RDI_DumpSection result = RDI_DumpSection_COUNT;
+  for(RDI_DumpSection section = (RDI_DumpSection)0; section < RDI_DumpSection_COUNT; section = (RDI_DumpSection)(section+1))
+  {
+    if(str8_match(string, rdi_dump_section_info_table[section].name, StringMatchFlag_CaseInsensitive))
+    {
+      result = section;
+      break;
+    }
+  }
+  return result;
+}
+
+internal U64
+rdi_dump_element_count_from_section(RDI_Parsed *rdi, RDI_DumpSection section)
+{
+  U64 count = 0;
+  switch(section)
+  {
+    default:{}break;
+    case RDI_DumpSection_DataSections:
+    case RDI_DumpSection_TopLevelInfo:   {count = 1;}break;
+    case RDI_DumpSection_BinarySections: {rdi_table_from_name(rdi, BinarySections, &count);}break;
+    case RDI_DumpSection_FilePaths:      {rdi_table_from_name(rdi, FilePathNodes, &count);}break;
+    case RDI_DumpSection_SourceFiles:    {rdi_table_from_name(rdi, SourceFiles, &count);}break;
+    case RDI_DumpSection_LineTables:     {rdi_table_from_name(rdi, LineTables, &count);}break;
+    case RDI_DumpSection_SourceLineMaps: {rdi_table_from_name(rdi, SourceLineMaps, &count);}break;
+    case RDI_DumpSection_Units:          {rdi_table_from_name(rdi, Units, &count);}break;
+    case RDI_DumpSection_UnitVMap:       {rdi_table_from_name(rdi, UnitVMap, &count);}break;
+    case RDI_DumpSection_TypeNodes:      {rdi_table_from_name(rdi, TypeNodes, &count);}break;
+    case RDI_DumpSection_UDTs:           {rdi_table_from_name(rdi, UDTs, &count);}break;
+    case RDI_DumpSection_GlobalVariables:{rdi_table_from_name(rdi, GlobalVariables, &count);}break;
+    case RDI_DumpSection_GlobalVMap:     {rdi_table_from_name(rdi, GlobalVMap, &count);}break;
+    case RDI_DumpSection_ThreadVariables:{rdi_table_from_name(rdi, ThreadVariables, &count);}break;
+    case RDI_DumpSection_Procedures:     {rdi_table_from_name(rdi, Procedures, &count);}break;
+    case RDI_DumpSection_Scopes:         {rdi_table_from_name(rdi, Scopes, &count);}break;
+    case RDI_DumpSection_ScopeVMap:      {rdi_table_from_name(rdi, ScopeVMap, &count);}break;
+    case RDI_DumpSection_InlineSites:    {rdi_table_from_name(rdi, InlineSites, &count);}break;
+    case RDI_DumpSection_NameMaps:       {rdi_table_from_name(rdi, NameMaps, &count);}break;
+    case RDI_DumpSection_Strings:        {rdi_table_from_name(rdi, StringTable, &count); count = count ? count-1 : 0;}break; // NOTE: last offset only terminates the last string
+  }
+  return count;
+}
+
+internal void
+rdi_stringize_section_elements(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_DumpSection section, Rng1U64 range, B32 whole_trees)
+{
+  U64 count = rdi_dump_element_count_from_section(rdi, section);
+  range.max = Min(range.max, count);
+  switch(section)
+  {
+    default:{}break;
+    
+    //- rjf: DATA SECTIONS
+    case RDI_DumpSection_DataSections:
+    if(range.min < range.max)
+    {
+      rdi_stringize_data_sections(arena, out, rdi, 1);
+    }break;
+    
+    //- rjf: TOP LEVEL INFO
+    case RDI_DumpSection_TopLevelInfo:
+    if(range.min < range.max)
+    {
+      RDI_TopLevelInfo *tli = rdi_element_from_name_idx(rdi, TopLevelInfo, 0);
+      rdi_stringize_top_level_info(arena, out, rdi, tli, 1);
+    }break;
+    
+    //- rjf: BINARY SECTIONS
+    case RDI_DumpSection_BinarySections:
+    {
+      RDI_BinarySection *v = rdi_table_from_name(rdi, BinarySections, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " section[%I64u]:\n", idx);
+        rdi_stringize_binary_section(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: FILE PATHS
+    case RDI_DumpSection_FilePaths:
+    {
+      RDI_FilePathBundle file_path_bundle = {0};
+      file_path_bundle.file_paths = rdi_table_from_name(rdi, FilePathNodes, &file_path_bundle.file_path_count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        RDI_FilePathNode *ptr = &file_path_bundle.file_paths[idx];
+        if(whole_trees)
+        {
+          if(ptr->parent_path_node == 0)
+          {
+            rdi_stringize_file_path(arena, out, rdi, &file_path_bundle, ptr, 1);
+          }
+        }
+        else
+        {
+          String8 name = {0};
+          name.str = rdi_string_from_idx(rdi, ptr->name_string_idx, &name.size);
+          str8_list_pushf(arena, out, " [%I64u] '%.*s'; parent=%u", idx, str8_varg(name), ptr->parent_path_node);
+          if(ptr->source_file_idx != 0)
+          {
+            str8_list_pushf(arena, out, "; source_file=%u", ptr->source_file_idx);
+          }
+          str8_list_pushf(arena, out, "\n");
+        }
+      }
+    }break;
+    
+    //- rjf: SOURCE FILES
+    case RDI_DumpSection_SourceFiles:
+    {
+      RDI_SourceFile *v = rdi_table_from_name(rdi, SourceFiles, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " source_file[%I64u]:\n", idx);
+        rdi_stringize_source_file(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: LINE TABLES
+    case RDI_DumpSection_LineTables:
+    {
+      RDI_LineTable *v = rdi_table_from_name(rdi, LineTables, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " line_table[%I64u]:\n", idx);
+        rdi_stringize_line_table(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: SOURCE LINE MAPS
+    case RDI_DumpSection_SourceLineMaps:
+    {
+      RDI_SourceLineMap *v = rdi_table_from_name(rdi, SourceLineMaps, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " source_line_map[%I64u]:\n", idx);
+        rdi_stringize_source_line_map(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: UNITS
+    case RDI_DumpSection_Units:
+    {
+      RDI_Unit *v = rdi_table_from_name(rdi, Units, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " unit[%I64u]:\n", idx);
+        rdi_stringize_unit(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: VMAPS
+    case RDI_DumpSection_UnitVMap:
+    case RDI_DumpSection_GlobalVMap:
+    case RDI_DumpSection_ScopeVMap:
+    {
+      RDI_VMapEntry *v = (section == RDI_DumpSection_UnitVMap   ? rdi_table_from_name(rdi, UnitVMap, &count) :
+                          section == RDI_DumpSection_GlobalVMap ? rdi_table_from_name(rdi, GlobalVMap, &count) :
+                          rdi_table_from_name(rdi, ScopeVMap, &count));
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " 0x%08x: %llu\n", v[idx].voff, v[idx].idx);
+      }
+    }break;
+    
+    //- rjf: TYPE NODES
+    case RDI_DumpSection_TypeNodes:
+    {
+      RDI_TypeNode *v = rdi_table_from_name(rdi, TypeNodes, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " type[%I64u]:\n", idx);
+        rdi_stringize_type_node(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: UDT DATA
+    case RDI_DumpSection_UDTs:
+    {
+      U64 all_members_count = 0;
+      RDI_Member *all_members = rdi_table_from_name(rdi, Members, &all_members_count);
+      U64 all_enum_members_count = 0;
+      RDI_EnumMember *all_enum_members = rdi_table_from_name(rdi, EnumMembers, &all_enum_members_count);
+      RDI_UDT *all_udts = rdi_table_from_name(rdi, UDTs, &count);
+      RDI_UDTMemberBundle member_bundle = {0};
+      {
+        member_bundle.members = all_members;
+        member_bundle.enum_members = all_enum_members;
+        member_bundle.member_count = (RDI_U32)all_members_count;
+        member_bundle.enum_member_count = (RDI_U32)all_enum_members_count;
+      }
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " udt[%I64u]:\n", idx);
+        rdi_stringize_udt(arena, out, rdi, &member_bundle, &all_udts[idx], 2);
+      }
+    }break;
+    
+    //- rjf: GLOBAL VARIABLES
+    case RDI_DumpSection_GlobalVariables:
+    {
+      RDI_GlobalVariable *v = rdi_table_from_name(rdi, GlobalVariables, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " global_variable[%I64u]:\n", idx);
+        rdi_stringize_global_variable(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: THREAD LOCAL VARIABLES
+    case RDI_DumpSection_ThreadVariables:
+    {
+      RDI_ThreadVariable *v = rdi_table_from_name(rdi, ThreadVariables, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " thread_variable[%I64u]:\n", idx);
+        rdi_stringize_thread_variable(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: PROCEDURES
+    case RDI_DumpSection_Procedures:
+    {
+      RDI_Procedure *v = rdi_table_from_name(rdi, Procedures, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " procedure[%I64u]:\n", idx);
+        rdi_stringize_procedure(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: SCOPES
+    case RDI_DumpSection_Scopes:
+    {
+      U64 scopes_count = 0;
+      RDI_Scope *scopes = rdi_table_from_name(rdi, Scopes, &scopes_count);
+      U64 scopes_voffs_count = 0;
+      U64 *scopes_voffs = rdi_table_from_name(rdi, ScopeVOffData, &scopes_voffs_count);
+      U64 locals_count = 0;
+      RDI_Local *locals = rdi_table_from_name(rdi, Locals, &locals_count);
+      U64 location_block_count = 0;
+      RDI_LocationBlock *location_blocks = rdi_table_from_name(rdi, LocationBlocks, &location_block_count);
+      U64 location_data_size = 0;
+      RDI_U8 *location_data = rdi_table_from_name(rdi, LocationData, &location_data_size);
+      RDI_ScopeBundle scope_bundle = {0};
+      {
+        scope_bundle.scopes = scopes;
+        scope_bundle.scope_count = scopes_count;
+        scope_bundle.scope_voffs = scopes_voffs;
+        scope_bundle.scope_voff_count = scopes_voffs_count;
+        scope_bundle.locals = locals;
+        scope_bundle.local_count = locals_count;
+        scope_bundle.location_blocks = location_blocks;
+        scope_bundle.location_block_count = location_block_count;
+        scope_bundle.location_data = location_data;
+        scope_bundle.location_data_size = location_data_size;
+      }
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        if(scopes[idx].parent_scope_idx == 0)
+        {
+          rdi_stringize_scope(arena, out, rdi, &scope_bundle, &scopes[idx], 1);
+        }
+      }
+    }break;
+    
+    //- rjf: INLINE SITES
+    case RDI_DumpSection_InlineSites:
+    {
+      RDI_InlineSite *v = rdi_table_from_name(rdi, InlineSites, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        str8_list_pushf(arena, out, " inline_site[%I64u]:\n", idx);
+        rdi_stringize_inline_site(arena, out, rdi, &v[idx], 2);
+      }
+    }break;
+    
+    //- rjf: NAME MAPS
+    case RDI_DumpSection_NameMaps:
+    {
+      RDI_NameMap *v = rdi_table_from_name(rdi, NameMaps, &count);
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        RDI_ParsedNameMap name_map = {0};
+        rdi_parsed_from_name_map(rdi, &v[idx], &name_map);
+        str8_list_pushf(arena, out, " name_map[%I64u]:\n", idx);
+        RDI_NameMapBucket *bucket = name_map.buckets;
+        for(U32 j = 0; j < name_map.bucket_count; j += 1, bucket += 1)
+        {
+          if(bucket->node_count > 0)
+          {
+            str8_list_pushf(arena, out, "  bucket[%u]:\n", j);
+            RDI_NameMapNode *node = name_map.nodes + bucket->first_node;
+            RDI_NameMapNode *node_opl = node + bucket->node_count;
+            for(;node < node_opl; node += 1)
+            {
+              String8 string = {0};
+              string.str = rdi_string_from_idx(rdi, node->string_idx, &string.size);
+              str8_list_pushf(arena, out, "   match \"%.*s\": ", str8_varg(string));
+              if(node->match_count == 1)
+              {
+                str8_list_pushf(arena, out, "%u", node->match_idx_or_idx_run_first);
+              }
+              else
+              {
+                RDI_U32 idx_count = 0;
+                RDI_U32 *idx_run =
+                  rdi_idx_run_from_first_count(rdi, node->match_idx_or_idx_run_first,
+                                               node->match_count, &idx_count);
+                if(idx_count > 0)
+                {
+                  RDI_U32 last = idx_count - 1;
+                  for(U32 k = 0; k < last; k += 1)
+                  {
+                    str8_list_pushf(arena, out, "%u, ", idx_run[k]);
+                  }
+                  str8_list_pushf(arena, out, "%u", idx_run[last]);
+                }
+              }
+              str8_list_pushf(arena, out, "\n");
+            }
+          }
+        }
+        str8_list_push(arena, out, str8_lit("\n"));
+      }
+    }break;
+    
+    //- rjf: STRINGS
+    case RDI_DumpSection_Strings:
+    {
+      for(U64 idx = range.min; idx < range.max; idx += 1)
+      {
+        String8 string = {0};
+        string.str = rdi_string_from_idx(rdi, (RDI_U32)idx, &string.size);
+        str8_list_pushf(arena, out, " string[%I64u]: \"%S\"\n", idx, string);
+      }
+    }break;
+  }
+}
@@ -38,6 +38,43 @@ struct RDI_ScopeBundle
   U32 location_data_size;
 };
 
+////////////////////////////////
+//~ rjf: Dump Section Types
+
+typedef enum RDI_DumpSection
+{
+  RDI_DumpSection_DataSections,
+  RDI_DumpSection_TopLevelInfo,
+  RDI_DumpSection_BinarySections,
+  RDI_DumpSection_FilePaths,
+  RDI_DumpSection_SourceFiles,
+  RDI_DumpSection_LineTables,
+  RDI_DumpSection_SourceLineMaps,
+  RDI_DumpSection_Units,
+  RDI_DumpSection_UnitVMap,
+  RDI_DumpSection_TypeNodes,
+  RDI_DumpSection_UDTs,
+  RDI_DumpSection_GlobalVariables,
+  RDI_DumpSection_GlobalVMap,
+  RDI_DumpSection_ThreadVariables,
+  RDI_DumpSection_Procedures,
+  RDI_DumpSection_Scopes,
+  RDI_DumpSection_ScopeVMap,
+  RDI_DumpSection_InlineSites,
+  RDI_DumpSection_NameMaps,
+  RDI_DumpSection_Strings,
+  RDI_DumpSection_COUNT
+}
+RDI_DumpSection;
+
+typedef struct RDI_DumpSectionInfo RDI_DumpSectionInfo;
+struct RDI_DumpSectionInfo
+{
+  String8 name;
+  String8 header;
+  U64 elements_per_task;
+};
+
 ////////////////////////////////
 //~ rjf: RDI Enum -> String Functions
 
@@ -75,4 +112,14 @@ internal void rdi_stringize_procedure(Arena *arena, String8List *out, RDI_Parsed
 internal void rdi_stringize_scope(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_ScopeBundle *bundle, RDI_Scope *scope, U32 indent_level);
 internal void rdi_stringize_inline_site(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_InlineSite *inline_site, U32 indent_level);
 
+////////////////////////////////
+//~ rjf: Dump Section Functions
+
+internal RDI_DumpSection rdi_dump_section_from_string(String8 string);
+internal U64 rdi_dump_element_count_from_section(RDI_Parsed *rdi, RDI_DumpSection section);
+// NOTE: whole_trees -> tree-shaped sections (file paths) print each root in
+// range along with its entire subtree; otherwise, each element in range is
+// printed by itself.
+internal void rdi_stringize_section_elements(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_DumpSection section, Rng1U64 range, B32 whole_trees);
+
 #endif // RDI_DUMP_H
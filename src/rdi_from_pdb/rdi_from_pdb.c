@@ -113,6 +113,7 @@ Case("procedure_name_map",  ProcedureNameMap)\
 Case("type_name_map",       TypeNameMap)\
 Case("link_name_map",       LinkNameProcedureNameMap)\
 Case("source_path_name_map",NormalSourcePathNameMap)\
+Case("nested_name_maps",    NestedNameMaps)\
   
   //- rjf: get flags
   {
@@ -4082,6 +4083,7 @@ p2r_convert(Arena *arena, P2R_User2Convert *in)
   //
   P2R_Convert2Bake *out = push_array(arena, P2R_Convert2Bake, 1);
   {
+    out->flags                        = in->flags;
     out->bake_params.top_level_info   = top_level_info;
     out->bake_params.binary_sections  = binary_sections;
     out->bake_params.units            = all_units;
@@ -4189,56 +4191,31 @@ internal TS_TASK_FUNCTION_DEF(p2r_bake_line_tables_task__entry_point)
 
 #undef p2r_make_string_map_if_needed
 
-//- rjf: bake string map joining
+//- rjf: bake string map partition joining/sorting
 
-internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_join_task__entry_point)
+internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_join_sort_task__entry_point)
 {
-  P2R_JoinBakeStringMapSlotsIn *in = (P2R_JoinBakeStringMapSlotsIn *)p;
-  ProfScope("join bake string maps")
+  P2R_JoinSortBakeStringMapPartitionsIn *in = (P2R_JoinSortBakeStringMapPartitionsIn *)p;
+  ProfScope("join/sort bake string map partitions")
   {
-    for(U64 src_map_idx = 0; src_map_idx < in->src_maps_count; src_map_idx += 1)
+    for(U64 partition_idx = in->partition_idx_range.min; partition_idx < in->partition_idx_range.max; partition_idx += 1)
     {
-      for(U64 slot_idx = in->slot_idx_range.min; slot_idx < in->slot_idx_range.max; slot_idx += 1)
-      {
-        B32 src_slots_good = (in->src_maps[src_map_idx] != 0 && in->src_maps[src_map_idx]->slots != 0);
-        B32 dst_slot_is_zero = (in->dst_map->slots[slot_idx] == 0);
-        if(src_slots_good && dst_slot_is_zero)
-        {
-          in->dst_map->slots[slot_idx] = in->src_maps[src_map_idx]->slots[slot_idx];
-        }
-        else if(src_slots_good && in->src_maps[src_map_idx]->slots[slot_idx] != 0)
-        {
-          rdim_bake_string_chunk_list_concat_in_place(in->dst_map->slots[slot_idx], in->src_maps[src_map_idx]->slots[slot_idx]);
-        }
-      }
+      rdim_bake_string_map_partition_join_sort(arena, in->src_maps, in->src_maps_count, in->dst_map, &in->partitions[partition_idx]);
     }
   }
   return 0;
 }
 
-//- rjf: bake string map sorting
+//- rjf: finalized bake string map filling
 
-internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_sort_task__entry_point)
+internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_fill_task__entry_point)
 {
-  P2R_SortBakeStringMapSlotsIn *in = (P2R_SortBakeStringMapSlotsIn *)p;
-  ProfScope("sort bake string chunk list map range")
+  P2R_FillBakeStringMapPartitionsIn *in = (P2R_FillBakeStringMapPartitionsIn *)p;
+  ProfScope("fill finalized bake string map partitions")
   {
-    for(U64 slot_idx = in->slot_idx;
-        slot_idx < in->slot_idx+in->slot_count;
-        slot_idx += 1)
+    for(U64 partition_idx = in->partition_idx_range.min; partition_idx < in->partition_idx_range.max; partition_idx += 1)
     {
-      if(in->src_map->slots[slot_idx] != 0)
-      {
-        if(in->src_map->slots[slot_idx]->total_count > 1)
-        {
-          in->dst_map->slots[slot_idx] = push_array(arena, RDIM_BakeStringChunkList, 1);
-          *in->dst_map->slots[slot_idx] = rdim_bake_string_chunk_list_sorted_from_unsorted(arena, in->src_map->slots[slot_idx]);
-        }
-        else
-        {
-          in->dst_map->slots[slot_idx] = in->src_map->slots[slot_idx];
-        }
-      }
+      rdim_bake_string_map_tight_fill_partition(in->dst_map, in->src_map, &in->partitions[partition_idx]);
     }
   }
   return 0;
@@ -4355,9 +4332,14 @@ internal TS_TASK_FUNCTION_DEF(p2r_bake_file_paths_task__entry_point)
 internal TS_TASK_FUNCTION_DEF(p2r_bake_strings_task__entry_point)
 {
   P2R_BakeStringsIn *in = (P2R_BakeStringsIn *)p;
-  RDIM_StringBakeResult *out = push_array(arena, RDIM_StringBakeResult, 1);
-  ProfScope("bake strings") *out = rdim_bake_strings(arena, in->strings);
-  return out;
+  ProfScope("bake strings")
+  {
+    for(U64 partition_idx = in->partition_idx_range.min; partition_idx < in->partition_idx_range.max; partition_idx += 1)
+    {
+      rdim_bake_strings_partition(in->dst, in->strings, &in->partitions[partition_idx]);
+    }
+  }
+  return 0;
 }
 
 //- rjf: pass 3: idx-run-map-dependent debug info stream builds
@@ -4419,10 +4401,10 @@ p2r_bake(Arena *arena, P2R_Convert2Bake *in)
   //////////////////////////////
   //- rjf: kick off string map building tasks
   //
-  RDIM_BakeStringMapTopology bake_string_map_topology = {(in_params->procedures.total_count*1 +
-                                                          in_params->global_variables.total_count*1 +
-                                                          in_params->thread_variables.total_count*1 +
-                                                          in_params->types.total_count/2)};
+  RDIM_BakeStringMapTopology bake_string_map_topology = {Max(1, (in_params->procedures.total_count*1 +
+                                                                 in_params->global_variables.total_count*1 +
+                                                                 in_params->thread_variables.total_count*1 +
+                                                                 in_params->types.total_count/2))};
   RDIM_BakeStringMapLoose **bake_string_maps__in_progress = push_array(scratch.arena, RDIM_BakeStringMapLoose *, ts_thread_count());
   TS_TicketList bake_string_map_build_tickets = {0};
   {
@@ -4610,87 +4592,90 @@ p2r_bake(Arena *arena, P2R_Convert2Bake *in)
   }
   
   //////////////////////////////
-  //- rjf: produce joined string map
+  //- rjf: build small top-level string map
   //
-  RDIM_BakeStringMapLoose *unsorted_bake_string_map = rdim_bake_string_map_loose_make(arena, &bake_string_map_topology);
-  ProfScope("produce joined string map")
+  RDIM_BakeStringMapLoose *top_level_bake_string_map = rdim_bake_string_map_loose_make(arena, &bake_string_map_topology);
+  ProfScope("build small top-level string map")
   {
-    U64 slots_per_task = 16384;
-    U64 num_tasks = (bake_string_map_topology.slots_count+slots_per_task-1)/slots_per_task;
-    TS_Ticket *task_tickets = push_array(scratch.arena, TS_Ticket, num_tasks);
-    
-    // rjf: kickoff tasks
-    for(U64 task_idx = 0; task_idx < num_tasks; task_idx += 1)
-    {
-      P2R_JoinBakeStringMapSlotsIn *in = push_array(scratch.arena, P2R_JoinBakeStringMapSlotsIn, 1);
-      in->top = &bake_string_map_topology;
-      in->src_maps = bake_string_maps__in_progress;
-      in->src_maps_count = ts_thread_count();
-      in->dst_map = unsorted_bake_string_map;
-      in->slot_idx_range = r1u64(task_idx*slots_per_task, task_idx*slots_per_task + slots_per_task);
-      in->slot_idx_range.max = Min(in->slot_idx_range.max, in->top->slots_count);
-      task_tickets[task_idx] = ts_kickoff(p2r_bake_string_map_join_task__entry_point, 0, in);
-    }
-    
-    // rjf: join tasks
-    for(U64 task_idx = 0; task_idx < num_tasks; task_idx += 1)
-    {
-      ts_join(task_tickets[task_idx], max_U64);
-    }
-    
-    // rjf: insert small top-level stuff
-    rdim_bake_string_map_loose_push_top_level_info(arena, &bake_string_map_topology, unsorted_bake_string_map, &in_params->top_level_info);
-    rdim_bake_string_map_loose_push_binary_sections(arena, &bake_string_map_topology, unsorted_bake_string_map, &in_params->binary_sections);
-    rdim_bake_string_map_loose_push_path_tree(arena, &bake_string_map_topology, unsorted_bake_string_map, path_tree);
+    rdim_bake_string_map_loose_push_top_level_info(arena, &bake_string_map_topology, top_level_bake_string_map, &in_params->top_level_info);
+    rdim_bake_string_map_loose_push_binary_sections(arena, &bake_string_map_topology, top_level_bake_string_map, &in_params->binary_sections);
+    rdim_bake_string_map_loose_push_path_tree(arena, &bake_string_map_topology, top_level_bake_string_map, path_tree);
   }
   
   //////////////////////////////
-  //- rjf: kick off string map sorting tasks
+  //- rjf: gather all string maps to join
   //
-  TS_TicketList sort_bake_string_map_task_tickets = {0};
-  RDIM_BakeStringMapLoose *sorted_bake_string_map__in_progress = rdim_bake_string_map_loose_make(arena, &bake_string_map_topology);
+  U64 src_bake_string_maps_count = 0;
+  RDIM_BakeStringMapLoose **src_bake_string_maps = push_array(scratch.arena, RDIM_BakeStringMapLoose *, ts_thread_count()+1);
   {
-    U64 slots_per_task = 4096;
-    U64 num_tasks = (bake_string_map_topology.slots_count+slots_per_task-1)/slots_per_task;
-    for(U64 task_idx = 0; task_idx < num_tasks; task_idx += 1)
+    for(U64 thread_idx = 0; thread_idx < ts_thread_count(); thread_idx += 1)
     {
-      P2R_SortBakeStringMapSlotsIn *in = push_array(scratch.arena, P2R_SortBakeStringMapSlotsIn, 1);
+      if(bake_string_maps__in_progress[thread_idx] != 0)
       {
-        in->top = &bake_string_map_topology;
-        in->src_map = unsorted_bake_string_map;
-        in->dst_map = sorted_bake_string_map__in_progress;
-        in->slot_idx = task_idx*slots_per_task;
-        in->slot_count = slots_per_task;
-        if(in->slot_idx+in->slot_count > bake_string_map_topology.slots_count)
-        {
-          in->slot_count = bake_string_map_topology.slots_count - in->slot_idx;
-        }
+        src_bake_string_maps[src_bake_string_maps_count] = bake_string_maps__in_progress[thread_idx];
+        src_bake_string_maps_count += 1;
       }
-      ts_ticket_list_push(scratch.arena, &sort_bake_string_map_task_tickets, ts_kickoff(p2r_bake_string_map_sort_task__entry_point, 0, in));
     }
+    src_bake_string_maps[src_bake_string_maps_count] = top_level_bake_string_map;
+    src_bake_string_maps_count += 1;
   }
   
   //////////////////////////////
-  //- rjf: join string map sorting tasks
+  //- rjf: partition string map slots - each partition is joined, deduplicated,
+  // sorted, filled, & baked independently, so every step past this point runs
+  // in parallel, except for a prefix sum over the per-partition counts
   //
-  ProfScope("join string map sorting tasks")
+  U64 bake_string_map_partitions_count = 0;
+  RDIM_BakeStringMapPartition *bake_string_map_partitions = rdim_bake_string_map_partitions_make(arena, &bake_string_map_topology, 4096, &bake_string_map_partitions_count);
+  U64 partitions_per_task = 4;
+  U64 partition_tasks_count = (bake_string_map_partitions_count+partitions_per_task-1)/partitions_per_task;
+  
+  //////////////////////////////
+  //- rjf: kick off & join string map partition joining/sorting tasks
+  //
+  RDIM_BakeStringMapLoose *sorted_bake_string_map = rdim_bake_string_map_loose_make(arena, &bake_string_map_topology);
+  ProfScope("join/sort string map partitions")
   {
-    for(TS_TicketNode *n = sort_bake_string_map_task_tickets.first; n != 0; n = n->next)
+    TS_Ticket *task_tickets = push_array(scratch.arena, TS_Ticket, partition_tasks_count);
+    for(U64 task_idx = 0; task_idx < partition_tasks_count; task_idx += 1)
     {
-      ts_join(n->v, max_U64);
+      P2R_JoinSortBakeStringMapPartitionsIn *in = push_array(scratch.arena, P2R_JoinSortBakeStringMapPartitionsIn, 1);
+      in->src_maps = src_bake_string_maps;
+      in->src_maps_count = src_bake_string_maps_count;
+      in->dst_map = sorted_bake_string_map;
+      in->partitions = bake_string_map_partitions;
+      in->partition_idx_range = r1u64(task_idx*partitions_per_task, Min((task_idx+1)*partitions_per_task, bake_string_map_partitions_count));
+      task_tickets[task_idx] = ts_kickoff(p2r_bake_string_map_join_sort_task__entry_point, 0, in);
+    }
+    for(U64 task_idx = 0; task_idx < partition_tasks_count; task_idx += 1)
+    {
+      ts_join(task_tickets[task_idx], max_U64);
     }
   }
-  RDIM_BakeStringMapLoose *sorted_bake_string_map = sorted_bake_string_map__in_progress;
   
   //////////////////////////////
   //- rjf: build finalized string map
   //
   ProfBegin("build finalized string map base indices");
-  RDIM_BakeStringMapBaseIndices bake_string_map_base_idxes = rdim_bake_string_map_base_indices_from_map_loose(arena, &bake_string_map_topology, sorted_bake_string_map);
-  ProfEnd();
-  ProfBegin("build finalized string map");
-  RDIM_BakeStringMapTight bake_strings = rdim_bake_string_map_tight_from_loose(arena, &bake_string_map_topology, &bake_string_map_base_idxes, sorted_bake_string_map);
+  RDIM_BakeStringMapTight bake_strings = rdim_bake_string_map_tight_from_partitions(arena, &bake_string_map_topology, bake_string_map_partitions, bake_string_map_partitions_count);
   ProfEnd();
+  ProfScope("build finalized string map")
+  {
+    TS_Ticket *task_tickets = push_array(scratch.arena, TS_Ticket, partition_tasks_count);
+    for(U64 task_idx = 0; task_idx < partition_tasks_count; task_idx += 1)
+    {
+      P2R_FillBakeStringMapPartitionsIn *in = push_array(scratch.arena, P2R_FillBakeStringMapPartitionsIn, 1);
+      in->dst_map = &bake_strings;
+      in->src_map = sorted_bake_string_map;
+      in->partitions = bake_string_map_partitions;
+      in->partition_idx_range = r1u64(task_idx*partitions_per_task, Min((task_idx+1)*partitions_per_task, bake_string_map_partitions_count));
+      task_tickets[task_idx] = ts_kickoff(p2r_bake_string_map_fill_task__entry_point, 0, in);
+    }
+    for(U64 task_idx = 0; task_idx < partition_tasks_count; task_idx += 1)
+    {
+      ts_join(task_tickets[task_idx], max_U64);
+    }
+  }
   
   //////////////////////////////
   //- rjf: kick off pass 2 tasks
@@ -4719,8 +4704,18 @@ p2r_bake(Arena *arena, P2R_Convert2Bake *in)
   TS_Ticket bake_inline_sites_ticket = ts_kickoff(p2r_bake_inline_sites_task__entry_point, 0, &bake_inline_sites_in);
   P2R_BakeFilePathsIn bake_file_paths_in = {&bake_strings, path_tree};
   TS_Ticket bake_file_paths_ticket = ts_kickoff(p2r_bake_file_paths_task__entry_point, 0, &bake_file_paths_in);
-  P2R_BakeStringsIn bake_strings_in = {&bake_strings};
-  TS_Ticket bake_strings_ticket = ts_kickoff(p2r_bake_strings_task__entry_point, 0, &bake_strings_in);
+  RDIM_StringBakeResult *bake_strings_result = push_array(arena, RDIM_StringBakeResult, 1);
+  *bake_strings_result = rdim_bake_strings_make(arena, &bake_strings, bake_string_map_partitions, bake_string_map_partitions_count);
+  TS_Ticket *bake_strings_tickets = push_array(scratch.arena, TS_Ticket, partition_tasks_count);
+  for(U64 task_idx = 0; task_idx < partition_tasks_count; task_idx += 1)
+  {
+    P2R_BakeStringsIn *in = push_array(scratch.arena, P2R_BakeStringsIn, 1);
+    in->strings = &bake_strings;
+    in->dst = bake_strings_result;
+    in->partitions = bake_string_map_partitions;
+    in->partition_idx_range = r1u64(task_idx*partitions_per_task, Min((task_idx+1)*partitions_per_task, bake_string_map_partitions_count));
+    bake_strings_tickets[task_idx] = ts_kickoff(p2r_bake_strings_task__entry_point, 0, in);
+  }
   
   //////////////////////////////
   //- rjf: join name map building tasks
@@ -4791,11 +4786,26 @@ p2r_bake(Arena *arena, P2R_Convert2Bake *in)
   ProfScope("scope vmap")                   out_results->scope_vmap            = *ts_join_struct(bake_scope_vmap_ticket, max_U64, RDIM_ScopeVMapBakeResult);
   ProfScope("inline sites")                 out_results->inline_sites          = *ts_join_struct(bake_inline_sites_ticket, max_U64, RDIM_InlineSiteBakeResult);
   ProfScope("file paths")                   out_results->file_paths            = *ts_join_struct(bake_file_paths_ticket, max_U64, RDIM_FilePathBakeResult);
-  ProfScope("strings")                      out_results->strings               = *ts_join_struct(bake_strings_ticket, max_U64, RDIM_StringBakeResult);
+  ProfScope("strings")
+  {
+    for(U64 task_idx = 0; task_idx < partition_tasks_count; task_idx += 1)
+    {
+      ts_join(bake_strings_tickets[task_idx], max_U64);
+    }
+    out_results->strings = *bake_strings_result;
+  }
   ProfScope("type nodes")                   out_results->type_nodes            = *ts_join_struct(bake_type_nodes_ticket, max_U64, RDIM_TypeNodeBakeResult);
   ProfScope("idx runs")                     out_results->idx_runs              = *ts_join_struct(bake_idx_runs_ticket, max_U64, RDIM_IndexRunBakeResult);
   ProfScope("line tables")                  out_results->line_tables           = *ts_join_struct(bake_line_tables_ticket, max_U64, RDIM_LineTableBakeResult);
   
+  //////////////////////////////
+  //- rjf: bake per-scope local & per-UDT member name maps from joined results
+  //
+  if(in->flags & P2R_ConvertFlag_NestedNameMaps) ProfScope("nested name maps")
+  {
+    out_results->nested_name_maps = rdim_bake_nested_name_maps(arena, &out_results->strings, &out_results->scopes, &out_results->udts);
+  }
+  
   //////////////////////////////
   //- rjf: join individual name map bakes
   //
@@ -28,6 +28,7 @@ enum
   P2R_ConvertFlag_TypeNameMap             = (1<<15),
   P2R_ConvertFlag_LinkNameProcedureNameMap= (1<<16),
   P2R_ConvertFlag_NormalSourcePathNameMap = (1<<17),
+  P2R_ConvertFlag_NestedNameMaps          = (1<<18),
   P2R_ConvertFlag_All = 0xffffffff,
 };
 
@@ -49,6 +50,7 @@ struct P2R_User2Convert
 typedef struct P2R_Convert2Bake P2R_Convert2Bake;
 struct P2R_Convert2Bake
 {
+  P2R_ConvertFlags flags;
   RDIM_BakeParams bake_params;
 };
 
@@ -369,28 +371,27 @@ struct P2R_BakeScopesStringsIn
   P2R_BakeScopesStringsInNode *last;
 };
 
-//- rjf: string map joining task types
+//- rjf: string map partition joining/sorting task types
 
-typedef struct P2R_JoinBakeStringMapSlotsIn P2R_JoinBakeStringMapSlotsIn;
-struct P2R_JoinBakeStringMapSlotsIn
+typedef struct P2R_JoinSortBakeStringMapPartitionsIn P2R_JoinSortBakeStringMapPartitionsIn;
+struct P2R_JoinSortBakeStringMapPartitionsIn
 {
-  RDIM_BakeStringMapTopology *top;
   RDIM_BakeStringMapLoose **src_maps;
   U64 src_maps_count;
   RDIM_BakeStringMapLoose *dst_map;
-  Rng1U64 slot_idx_range;
+  RDIM_BakeStringMapPartition *partitions;
+  Rng1U64 partition_idx_range;
 };
 
-//- rjf: string map sorting task types
+//- rjf: finalized string map filling task types
 
-typedef struct P2R_SortBakeStringMapSlotsIn P2R_SortBakeStringMapSlotsIn;
-struct P2R_SortBakeStringMapSlotsIn
+typedef struct P2R_FillBakeStringMapPartitionsIn P2R_FillBakeStringMapPartitionsIn;
+struct P2R_FillBakeStringMapPartitionsIn
 {
-  RDIM_BakeStringMapTopology *top;
+  RDIM_BakeStringMapTight *dst_map;
   RDIM_BakeStringMapLoose *src_map;
-  RDIM_BakeStringMapLoose *dst_map;
-  U64 slot_idx;
-  U64 slot_count;
+  RDIM_BakeStringMapPartition *partitions;
+  Rng1U64 partition_idx_range;
 };
 
 //- rjf: OLD string map baking types
@@ -498,6 +499,9 @@ typedef struct P2R_BakeStringsIn P2R_BakeStringsIn;
 struct P2R_BakeStringsIn
 {
   RDIM_BakeStringMapTight *strings;
+  RDIM_StringBakeResult *dst;
+  RDIM_BakeStringMapPartition *partitions;
+  Rng1U64 partition_idx_range;
 };
 
 typedef struct P2R_BakeTypeNodesIn P2R_BakeTypeNodesIn;
@@ -609,11 +613,11 @@ internal TS_TASK_FUNCTION_DEF(p2r_bake_symbols_strings_task__entry_point);
 internal TS_TASK_FUNCTION_DEF(p2r_bake_scopes_strings_task__entry_point);
 internal TS_TASK_FUNCTION_DEF(p2r_bake_line_tables_task__entry_point);
 
-//- rjf: bake string map joining
-internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_join_task__entry_point);
+//- rjf: bake string map partition joining/sorting
+internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_join_sort_task__entry_point);
 
-//- rjf: bake string map sorting
-internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_sort_task__entry_point);
+//- rjf: finalized bake string map filling
+internal TS_TASK_FUNCTION_DEF(p2r_bake_string_map_fill_task__entry_point);
 
 //- rjf: pass 1: interner/deduper map builds
 internal TS_TASK_FUNCTION_DEF(p2r_build_bake_name_map_task__entry_point);
@@ -0,0 +1,246 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: VMap Helpers
+
+internal U64
+rsym_vmap_pos_from_voff(RDI_VMapEntry *vmap, U64 vmap_count, U64 hint_pos, U64 voff)
+{
+  U64 result = vmap_count;
+  if(vmap_count > 1 && vmap[0].voff <= voff && voff < vmap[vmap_count-1].voff)
+  {
+    // rjf: try the hinted entry & its successor first; sorted lookups almost
+    // always land in one of them
+    for(U64 pos = hint_pos; pos < hint_pos+2 && pos+1 < vmap_count; pos += 1)
+    {
+      if(vmap[pos].voff <= voff && voff < vmap[pos+1].voff)
+      {
+        result = pos;
+        break;
+      }
+    }
+    
+    // rjf: otherwise, find pos such that: (vmap[pos].voff <= voff) && (voff < vmap[pos+1].voff)
+    if(result == vmap_count)
+    {
+      U64 first = 0;
+      U64 opl = vmap_count-1;
+      for(;opl - first > 1;)
+      {
+        U64 mid = (first + opl)/2;
+        if(vmap[mid].voff <= voff)
+        {
+          first = mid;
+        }
+        else
+        {
+          opl = mid;
+        }
+      }
+      result = first;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Cursor Functions
+
+internal void
+rsym_cursor_init(RSYM_Cursor *cursor, RDI_Parsed *rdi)
+{
+  MemoryZeroStruct(cursor);
+  cursor->rdi = rdi;
+  cursor->unit_vmap = rdi_table_from_name(rdi, UnitVMap, &cursor->unit_vmap_count);
+  cursor->scope_vmap = rdi_table_from_name(rdi, ScopeVMap, &cursor->scope_vmap_count);
+}
+
+internal RSYM_Symbolization
+rsym_symbolization_from_cursor_voff(Arena *arena, RSYM_Cursor *cursor, U64 voff)
+{
+  RDI_Parsed *rdi = cursor->rdi;
+  RSYM_Symbolization result = {0};
+  result.voff = voff;
+  
+  //- rjf: voff outside of cached unit range -> find new unit, parse its line table
+  if(!contains_1u64(cursor->unit_voff_range, voff))
+  {
+    U64 pos = rsym_vmap_pos_from_voff(cursor->unit_vmap, cursor->unit_vmap_count, cursor->unit_vmap_pos, voff);
+    MemoryZeroStruct(&cursor->unit_line_table);
+    MemoryZeroStruct(&cursor->unit_line_voff_range);
+    if(pos < cursor->unit_vmap_count)
+    {
+      RDI_Unit *unit = rdi_element_from_name_idx(rdi, Units, cursor->unit_vmap[pos].idx);
+      RDI_LineTable *line_table = rdi_line_table_from_unit(rdi, unit);
+      rdi_parsed_from_line_table(rdi, line_table, &cursor->unit_line_table);
+      cursor->unit_vmap_pos = pos;
+      cursor->unit_voff_range = r1u64(cursor->unit_vmap[pos].voff, cursor->unit_vmap[pos+1].voff);
+    }
+    else
+    {
+      cursor->unit_voff_range = r1u64(voff, voff+1);
+    }
+  }
+  
+  //- rjf: voff outside of cached scope range -> find new scope, gather procedure & inline sites
+  if(!contains_1u64(cursor->scope_voff_range, voff))
+  {
+    U64 pos = rsym_vmap_pos_from_voff(cursor->scope_vmap, cursor->scope_vmap_count, cursor->scope_vmap_pos, voff);
+    cursor->has_procedure = 0;
+    cursor->inline_frames_count = 0;
+    if(pos < cursor->scope_vmap_count)
+    {
+      RDI_Scope *scope = rdi_element_from_name_idx(rdi, Scopes, cursor->scope_vmap[pos].idx);
+      RDI_Procedure *procedure = rdi_procedure_from_scope(rdi, scope);
+      cursor->scope_vmap_pos = pos;
+      cursor->scope_voff_range = r1u64(cursor->scope_vmap[pos].voff, cursor->scope_vmap[pos+1].voff);
+      if(scope->proc_idx != 0)
+      {
+        cursor->has_procedure = 1;
+        cursor->procedure_name.str = rdi_name_from_procedure(rdi, procedure, &cursor->procedure_name.size);
+        cursor->procedure_first_voff = rdi_first_voff_from_procedure(rdi, procedure);
+      }
+      for(RDI_Scope *s = scope;
+          s->inline_site_idx != 0 && cursor->inline_frames_count < RSYM_INLINE_DEPTH_MAX;
+          s = rdi_element_from_name_idx(rdi, Scopes, s->parent_scope_idx))
+      {
+        RDI_InlineSite *site = rdi_element_from_name_idx(rdi, InlineSites, s->inline_site_idx);
+        RSYM_InlineFrameInfo *info = &cursor->inline_frames[cursor->inline_frames_count];
+        MemoryZeroStruct(info);
+        info->name.str = rdi_string_from_idx(rdi, site->name_string_idx, &info->name.size);
+        if(site->line_table_idx != 0)
+        {
+          RDI_LineTable *line_table = rdi_element_from_name_idx(rdi, LineTables, site->line_table_idx);
+          rdi_parsed_from_line_table(rdi, line_table, &info->line_table);
+        }
+        cursor->inline_frames_count += 1;
+      }
+    }
+    else
+    {
+      cursor->scope_voff_range = r1u64(voff, voff+1);
+    }
+  }
+  
+  //- rjf: fill frames
+  if(cursor->has_procedure)
+  {
+    result.frames_count = cursor->inline_frames_count+1;
+    result.frames = push_array(arena, RSYM_Frame, result.frames_count);
+    for(U64 idx = 0; idx < result.frames_count; idx += 1)
+    {
+      RSYM_Frame *frame = &result.frames[idx];
+      RDI_ParsedLineTable *line_table = 0;
+      U64 line_info_idx = 0;
+      if(idx < cursor->inline_frames_count)
+      {
+        // rjf: inline site => look up line in the site's own (small) line table
+        RSYM_InlineFrameInfo *info = &cursor->inline_frames[idx];
+        frame->name = info->name;
+        frame->is_inline = 1;
+        line_table = &info->line_table;
+        line_info_idx = line_table->count;
+        if(line_table->count > 0 && line_table->voffs[0] <= voff && voff < line_table->voffs[line_table->count-1])
+        {
+          line_info_idx = rdi_line_info_idx_from_voff(line_table, voff);
+        }
+      }
+      else
+      {
+        // rjf: concrete procedure => look up line in unit's line table; reuse
+        // the last line if the voff lands strictly inside of its range
+        frame->name = cursor->procedure_name;
+        frame->off = voff - cursor->procedure_first_voff;
+        line_table = &cursor->unit_line_table;
+        line_info_idx = line_table->count;
+        if(contains_1u64(cursor->unit_line_voff_range, voff))
+        {
+          line_info_idx = cursor->unit_line_info_idx;
+        }
+        else if(line_table->count > 0 && line_table->voffs[0] <= voff && voff < line_table->voffs[line_table->count-1])
+        {
+          line_info_idx = rdi_line_info_idx_from_voff(line_table, voff);
+          if(line_info_idx < line_table->count && line_table->voffs[line_info_idx] < voff)
+          {
+            cursor->unit_line_info_idx = line_info_idx;
+            cursor->unit_line_voff_range = r1u64(line_table->voffs[line_info_idx]+1, line_table->voffs[line_info_idx+1]);
+          }
+        }
+      }
+      if(line_info_idx < line_table->count)
+      {
+        RDI_Line *line = &line_table->lines[line_info_idx];
+        RDI_SourceFile *file = rdi_source_file_from_line(rdi, line);
+        frame->file_path.str = rdi_string_from_idx(rdi, file->normal_full_path_string_idx, &frame->file_path.size);
+        frame->line_num = line->line_num;
+        if(line_info_idx < line_table->col_count)
+        {
+          frame->col_num = line_table->cols[line_info_idx].col_first;
+        }
+      }
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Sorted Address Batch Functions
+
+internal int
+rsym_qsort_compare_sorted_voffs(RSYM_SortedVOff *a, RSYM_SortedVOff *b)
+{
+  int result = 0;
+  if(a->voff < b->voff)
+  {
+    result = -1;
+  }
+  else if(a->voff > b->voff)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal RSYM_SortedVOff *
+rsym_sorted_voffs_from_voffs(Arena *arena, U64 *voffs, U64 count)
+{
+  RSYM_SortedVOff *sorted = push_array_no_zero(arena, RSYM_SortedVOff, count);
+  for(U64 idx = 0; idx < count; idx += 1)
+  {
+    sorted[idx].voff = voffs[idx];
+    sorted[idx].idx = idx;
+  }
+  qsort(sorted, count, sizeof(RSYM_SortedVOff), (int (*)(const void *, const void *))rsym_qsort_compare_sorted_voffs);
+  return sorted;
+}
+
+////////////////////////////////
+//~ rjf: Stringification
+
+internal void
+rsym_str8_list_push_symbolization(Arena *arena, String8List *out, U64 addr, RSYM_Symbolization *symbolization)
+{
+  str8_list_pushf(arena, out, "0x%I64x", addr);
+  if(symbolization->frames_count == 0)
+  {
+    str8_list_push(arena, out, str8_lit("\t??"));
+  }
+  for(U64 idx = 0; idx < symbolization->frames_count; idx += 1)
+  {
+    RSYM_Frame *frame = &symbolization->frames[idx];
+    if(frame->is_inline)
+    {
+      str8_list_pushf(arena, out, "\t[inline] %S", frame->name);
+    }
+    else
+    {
+      str8_list_pushf(arena, out, "\t%S+0x%I64x", frame->name, frame->off);
+    }
+    if(frame->file_path.size != 0)
+    {
+      str8_list_pushf(arena, out, " %S:%u", frame->file_path, frame->line_num);
+    }
+  }
+  str8_list_push(arena, out, str8_lit("\n"));
+}
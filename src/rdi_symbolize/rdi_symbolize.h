@@ -0,0 +1,112 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef RDI_SYMBOLIZE_H
+#define RDI_SYMBOLIZE_H
+
+// NOTE: This layer resolves virtual offsets into symbolized frames -
+// the containing procedure, the chain of inline sites at that offset, and the
+// file & line for each - against a parsed RDI. Lookups go through a cursor,
+// which remembers the unit, scope, & line-table state from the last lookup.
+// When offsets are fed in ascending order (e.g. after sorting a batch of
+// profiler samples), neighboring lookups usually fall into the same vmap
+// ranges & line ranges, and skip almost all of the searching.
+
+////////////////////////////////
+//~ rjf: Limits
+
+#define RSYM_INLINE_DEPTH_MAX 64
+
+////////////////////////////////
+//~ rjf: Symbolization Types
+
+typedef struct RSYM_Frame RSYM_Frame;
+struct RSYM_Frame
+{
+  String8 name;
+  String8 file_path;
+  U32 line_num;
+  U32 col_num;
+  U64 off;
+  B32 is_inline;
+};
+
+typedef struct RSYM_Symbolization RSYM_Symbolization;
+struct RSYM_Symbolization
+{
+  U64 voff;
+  RSYM_Frame *frames; // NOTE: innermost inline site first; concrete procedure last
+  U64 frames_count;
+};
+
+////////////////////////////////
+//~ rjf: Lookup Cursor
+
+typedef struct RSYM_InlineFrameInfo RSYM_InlineFrameInfo;
+struct RSYM_InlineFrameInfo
+{
+  String8 name;
+  RDI_ParsedLineTable line_table;
+};
+
+typedef struct RSYM_Cursor RSYM_Cursor;
+struct RSYM_Cursor
+{
+  RDI_Parsed *rdi;
+  
+  // rjf: vmaps
+  RDI_VMapEntry *unit_vmap;
+  U64 unit_vmap_count;
+  RDI_VMapEntry *scope_vmap;
+  U64 scope_vmap_count;
+  
+  // rjf: unit state
+  U64 unit_vmap_pos;
+  Rng1U64 unit_voff_range;
+  RDI_ParsedLineTable unit_line_table;
+  Rng1U64 unit_line_voff_range;
+  U64 unit_line_info_idx;
+  
+  // rjf: scope state
+  U64 scope_vmap_pos;
+  Rng1U64 scope_voff_range;
+  String8 procedure_name;
+  U64 procedure_first_voff;
+  B32 has_procedure;
+  RSYM_InlineFrameInfo inline_frames[RSYM_INLINE_DEPTH_MAX];
+  U64 inline_frames_count;
+};
+
+////////////////////////////////
+//~ rjf: Sorted Address Batches
+
+typedef struct RSYM_SortedVOff RSYM_SortedVOff;
+struct RSYM_SortedVOff
+{
+  U64 voff;
+  U64 idx;
+};
+
+////////////////////////////////
+//~ rjf: VMap Helpers
+
+internal U64 rsym_vmap_pos_from_voff(RDI_VMapEntry *vmap, U64 vmap_count, U64 hint_pos, U64 voff);
+
+////////////////////////////////
+//~ rjf: Cursor Functions
+
+internal void rsym_cursor_init(RSYM_Cursor *cursor, RDI_Parsed *rdi);
+internal RSYM_Symbolization rsym_symbolization_from_cursor_voff(Arena *arena, RSYM_Cursor *cursor, U64 voff);
+
+////////////////////////////////
+//~ rjf: Sorted Address Batch Functions
+
+internal int rsym_qsort_compare_sorted_voffs(RSYM_SortedVOff *a, RSYM_SortedVOff *b);
+internal RSYM_SortedVOff *rsym_sorted_voffs_from_voffs(Arena *arena, U64 *voffs, U64 count);
+
+////////////////////////////////
+//~ rjf: Stringification
+
+internal void rsym_str8_list_push_symbolization(Arena *arena, String8List *out, U64 addr, RSYM_Symbolization *symbolization);
+
+#endif // RDI_SYMBOLIZE_H
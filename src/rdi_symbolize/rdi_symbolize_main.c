@@ -0,0 +1,333 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "rdi_symbolize"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "task_system/task_system.h"
+#include "rdi_format/rdi_format_local.h"
+#include "rdi_symbolize/rdi_symbolize.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "task_system/task_system.c"
+#include "rdi_format/rdi_format_local.c"
+#include "rdi_symbolize/rdi_symbolize.c"
+
+////////////////////////////////
+//~ rjf: Symbolization Tasks
+
+// NOTE: addresses are symbolized in blocks, so that memory use stays
+// bounded for arbitrarily large inputs, and so that results can be streamed
+// out as each block finishes. within a block, addresses are sorted, then
+// split into contiguous ranges of the sorted order - one per task - so that
+// each task's cursor walks forward through the RDI.
+#define RSYM_ADDRS_PER_BLOCK (1<<20)
+#define RSYM_ADDRS_PER_TASK_MIN (1<<12)
+
+typedef struct RSYM_SymbolizeTaskIn RSYM_SymbolizeTaskIn;
+struct RSYM_SymbolizeTaskIn
+{
+  RDI_Parsed *rdi;
+  U64 *addrs;
+  RSYM_SortedVOff *sorted_voffs;
+  U64 sorted_voffs_count;
+  String8 *strings_out;
+};
+
+internal TS_TASK_FUNCTION_DEF(rsym_symbolize_task__entry_point)
+{
+  RSYM_SymbolizeTaskIn *in = (RSYM_SymbolizeTaskIn *)p;
+  RSYM_Cursor cursor = {0};
+  rsym_cursor_init(&cursor, in->rdi);
+  U64 last_voff = 0;
+  RSYM_Symbolization last_symbolization = {0};
+  for(U64 idx = 0; idx < in->sorted_voffs_count; idx += 1)
+  {
+    RSYM_SortedVOff *v = &in->sorted_voffs[idx];
+    if(idx == 0 || v->voff != last_voff)
+    {
+      last_voff = v->voff;
+      last_symbolization = rsym_symbolization_from_cursor_voff(arena, &cursor, v->voff);
+    }
+    Temp scratch = scratch_begin(&arena, 1);
+    String8List strings = {0};
+    rsym_str8_list_push_symbolization(scratch.arena, &strings, in->addrs[v->idx], &last_symbolization);
+    in->strings_out[v->idx] = str8_list_join(arena, &strings, 0);
+    scratch_end(scratch);
+  }
+  return 0;
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  //////////////////////////////
+  //- rjf: set up
+  //
+  Arena *arena = arena_alloc();
+  String8List errors = {0};
+  
+  //////////////////////////////
+  //- rjf: extract command line parameters
+  //
+  B32 do_help = (cmd_line_has_flag(cmd_line, str8_lit("help")) ||
+                 cmd_line_has_flag(cmd_line, str8_lit("h")) ||
+                 cmd_line_has_flag(cmd_line, str8_lit("?")));
+  String8 rdi_name = str8_list_first(&cmd_line->inputs);
+  String8 in_name = cmd_line_string(cmd_line, str8_lit("in"));
+  String8 out_name = cmd_line_string(cmd_line, str8_lit("out"));
+  U64 module_base = 0;
+  {
+    String8 module_base_string = cmd_line_string(cmd_line, str8_lit("base"));
+    if(module_base_string.size != 0 && !try_u64_from_str8_c_rules(module_base_string, &module_base))
+    {
+      str8_list_pushf(arena, &errors, "error (input): Could not parse module base \"%S\".", module_base_string);
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: display help
+  //
+  if(do_help || rdi_name.size == 0)
+  {
+    fprintf(stderr, "--- rdi_symbolize --------------------------------------------------------------\n\n");
+    
+    fprintf(stderr, "This utility resolves addresses into procedures, inline site chains, and source\n");
+    fprintf(stderr, "locations, using a RAD Debug Info file. Addresses are read as whitespace-\n");
+    fprintf(stderr, "separated numbers (0x-prefixed for hexadecimal). Each address produces one line\n");
+    fprintf(stderr, "of output, in input order:\n\n");
+    fprintf(stderr, "<address> [\\t[inline] <name> <file>:<line>]... \\t<procedure>+<offset> <file>:<line>\n\n");
+    fprintf(stderr, "Usage: rdi_symbolize [options] <path>\n\n");
+    fprintf(stderr, "The following options are accepted, and must precede the path:\n\n");
+    
+    fprintf(stderr, "<path>                  Specifies the path of the RDI file to use.\n");
+    fprintf(stderr, "--in:<path> [optional]  Specifies the path of a file containing addresses. If\n");
+    fprintf(stderr, "                        omitted, addresses are read from stdin.\n");
+    fprintf(stderr, "--out:<path> [optional] Specifies the path at which the output will be written.\n");
+    fprintf(stderr, "                        If omitted, output is written to stdout.\n");
+    fprintf(stderr, "--base:<addr> [optional]\n");
+    fprintf(stderr, "                        Specifies the module's base address. If provided,\n");
+    fprintf(stderr, "                        addresses are virtual addresses; otherwise, they are\n");
+    fprintf(stderr, "                        module-relative virtual offsets.\n\n");
+    os_exit_process(0);
+  }
+  
+  //////////////////////////////
+  //- rjf: map rdi file
+  //
+  String8 rdi_data = {0};
+  {
+    OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, rdi_name);
+    FileProperties props = os_properties_from_file(file);
+    OS_Handle map = os_file_map_open(OS_AccessFlag_Read, file);
+    void *base = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size));
+    if(base != 0)
+    {
+      rdi_data = str8((U8 *)base, props.size);
+    }
+  }
+  if(rdi_data.size == 0)
+  {
+    str8_list_pushf(arena, &errors, "error (input): No input RDI file successfully loaded; either the path or file contents are invalid.");
+  }
+  
+  //////////////////////////////
+  //- rjf: parse & decompress rdi if necessary
+  //
+  RDI_Parsed rdi_ = {0};
+  RDI_Parsed *rdi = &rdi_;
+  RDI_ParseStatus status = rdi_parse(rdi_data.str, rdi_data.size, rdi);
+  {
+    U64 decompressed_size = rdi_decompressed_size_from_parsed(rdi);
+    if(decompressed_size > rdi_data.size)
+    {
+      U8 *decompressed_data = push_array_no_zero(arena, U8, decompressed_size);
+      rdi_decompress_parsed(decompressed_data, decompressed_size, rdi);
+      status = rdi_parse(decompressed_data, decompressed_size, rdi);
+    }
+  }
+  if(rdi_data.size != 0 && status != RDI_ParseStatus_Good)
+  {
+    str8_list_pushf(arena, &errors, "error (input): RDI file could not be successfully decoded.");
+  }
+  
+  //////////////////////////////
+  //- rjf: read address text
+  //
+  String8 in_data = {0};
+  if(errors.node_count == 0)
+  {
+    if(in_name.size != 0)
+    {
+      in_data = os_data_from_file_path(arena, in_name);
+    }
+    else
+    {
+      String8List in_chunks = {0};
+      for(;;)
+      {
+        U64 chunk_cap = MB(1);
+        U8 *chunk = push_array_no_zero(arena, U8, chunk_cap);
+        U64 chunk_size = fread(chunk, 1, chunk_cap, stdin);
+        str8_list_push(arena, &in_chunks, str8(chunk, chunk_size));
+        if(chunk_size < chunk_cap)
+        {
+          break;
+        }
+      }
+      in_data = str8_list_join(arena, &in_chunks, 0);
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: parse addresses
+  //
+  U64 addrs_count = 0;
+  U64 *addrs = 0;
+  if(errors.node_count == 0)
+  {
+    U64 addrs_cap = in_data.size/2 + 1;
+    addrs = push_array_no_zero(arena, U64, addrs_cap);
+    for(U64 off = 0; off < in_data.size;)
+    {
+      U64 token_first = off;
+      for(;token_first < in_data.size && char_is_space(in_data.str[token_first]); token_first += 1);
+      U64 token_opl = token_first;
+      for(;token_opl < in_data.size && !char_is_space(in_data.str[token_opl]); token_opl += 1);
+      if(token_opl > token_first)
+      {
+        String8 token = str8_substr(in_data, r1u64(token_first, token_opl));
+        U64 addr = 0;
+        if(try_u64_from_str8_c_rules(token, &addr))
+        {
+          addrs[addrs_count] = addr;
+          addrs_count += 1;
+        }
+        else
+        {
+          str8_list_pushf(arena, &errors, "error (input): Could not parse address \"%S\".", token);
+          break;
+        }
+      }
+      off = token_opl;
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: output error strings to stderr
+  //
+  for(String8Node *n = errors.first; n != 0; n = n->next)
+  {
+    fwrite(n->string.str, 1, n->string.size, stderr);
+    fprintf(stderr, "\n");
+  }
+  
+  //////////////////////////////
+  //- rjf: symbolize & write, block by block
+  //
+  if(errors.node_count == 0)
+  {
+    OS_Handle out_file = {0};
+    U64 out_off = 0;
+    if(out_name.size != 0)
+    {
+      // NOTE: opening for write does not truncate on all platforms - clear
+      // out any existing file first, so a shorter output leaves no stale tail
+      os_delete_file_at_path(out_name);
+      out_file = os_file_open(OS_AccessFlag_Write, out_name);
+    }
+    for(U64 block_first = 0; block_first < addrs_count; block_first += RSYM_ADDRS_PER_BLOCK)
+    {
+      Temp scratch = scratch_begin(0, 0);
+      U64 block_count = Min(addrs_count - block_first, RSYM_ADDRS_PER_BLOCK);
+      U64 *block_addrs = addrs + block_first;
+      
+      //- rjf: addresses -> sorted voffs
+      U64 *block_voffs = push_array_no_zero(scratch.arena, U64, block_count);
+      for(U64 idx = 0; idx < block_count; idx += 1)
+      {
+        block_voffs[idx] = block_addrs[idx] - module_base;
+      }
+      RSYM_SortedVOff *sorted_voffs = rsym_sorted_voffs_from_voffs(scratch.arena, block_voffs, block_count);
+      
+      //- rjf: kick off tasks over contiguous ranges of sorted voffs
+      U64 task_count = Clamp(1, block_count/RSYM_ADDRS_PER_TASK_MIN, ts_thread_count()*4);
+      U64 voffs_per_task = (block_count + task_count - 1) / task_count;
+      String8 *strings = push_array(scratch.arena, String8, block_count);
+      Arena **task_arenas = push_array(scratch.arena, Arena *, task_count);
+      RSYM_SymbolizeTaskIn *task_ins = push_array(scratch.arena, RSYM_SymbolizeTaskIn, task_count);
+      TS_Ticket *task_tickets = push_array(scratch.arena, TS_Ticket, task_count);
+      for(U64 task_idx = 0; task_idx < task_count; task_idx += 1)
+      {
+        U64 first = task_idx*voffs_per_task;
+        U64 opl = Min(first + voffs_per_task, block_count);
+        task_ins[task_idx].rdi                = rdi;
+        task_ins[task_idx].addrs              = block_addrs;
+        task_ins[task_idx].sorted_voffs       = sorted_voffs + first;
+        task_ins[task_idx].sorted_voffs_count = (opl > first) ? (opl - first) : 0;
+        task_ins[task_idx].strings_out        = strings;
+        task_arenas[task_idx] = arena_alloc();
+        Arena *task_arena = task_arenas[task_idx];
+        task_tickets[task_idx] = ts_kickoff(rsym_symbolize_task__entry_point, &task_arena, &task_ins[task_idx]);
+      }
+      
+      //- rjf: join tasks
+      for(U64 task_idx = 0; task_idx < task_count; task_idx += 1)
+      {
+        ts_join(task_tickets[task_idx], max_U64);
+      }
+      
+      //- rjf: write results in input order
+      {
+        String8List block_strings = {0};
+        for(U64 idx = 0; idx < block_count; idx += 1)
+        {
+          str8_list_push(scratch.arena, &block_strings, strings[idx]);
+        }
+        String8 block_text = str8_list_join(scratch.arena, &block_strings, 0);
+        if(out_name.size != 0)
+        {
+          os_file_write(out_file, r1u64(out_off, out_off+block_text.size), block_text.str);
+          out_off += block_text.size;
+        }
+        else
+        {
+          fwrite(block_text.str, 1, block_text.size, stdout);
+        }
+      }
+      
+      //- rjf: release task storage
+      for(U64 task_idx = 0; task_idx < task_count; task_idx += 1)
+      {
+        arena_release(task_arenas[task_idx]);
+      }
+      scratch_end(scratch);
+    }
+    if(out_name.size != 0)
+    {
+      os_file_close(out_file);
+    }
+  }
+}
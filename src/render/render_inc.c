@@ -7,6 +7,8 @@
 # include "stub/render_stub.c"
 #elif R_BACKEND == R_BACKEND_D3D11
 # include "d3d11/render_d3d11.c"
+#elif R_BACKEND == R_BACKEND_SOFTWARE
+# include "software/render_software.c"
 #else
 # error Renderer backend not specified.
 #endif
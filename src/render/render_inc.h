@@ -9,14 +9,15 @@
 
 #define R_BACKEND_STUB 0
 #define R_BACKEND_D3D11 1
+#define R_BACKEND_SOFTWARE 2
 
 ////////////////////////////////
 //~ rjf: Decide On Backend
 
 #if !defined(R_BACKEND) && OS_WINDOWS
   #define R_BACKEND R_BACKEND_D3D11
-#else
-  #define R_BACKEND R_BACKEND_STUB
+#elif !defined(R_BACKEND)
+  #define R_BACKEND R_BACKEND_SOFTWARE
 #endif
 
 ////////////////////////////////
@@ -31,6 +32,8 @@
 # include "stub/render_stub.h"
 #elif R_BACKEND == R_BACKEND_D3D11
 # include "d3d11/render_d3d11.h"
+#elif R_BACKEND == R_BACKEND_SOFTWARE
+# include "software/render_software.h"
 #else
 # error Renderer backend not specified.
 #endif
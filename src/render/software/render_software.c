@@ -0,0 +1,1258 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#undef RADDBG_LAYER_COLOR
+#define RADDBG_LAYER_COLOR 0.80f, 0.60f, 0.20f
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal R_SW_Window *
+r_sw_window_from_handle(R_Handle handle)
+{
+  R_SW_Window *window = (R_SW_Window *)handle.u64[0];
+  if(window == 0 || window->generation != handle.u64[1])
+  {
+    window = &r_sw_window_nil;
+  }
+  return window;
+}
+
+internal R_Handle
+r_sw_handle_from_window(R_SW_Window *window)
+{
+  R_Handle handle = {0};
+  handle.u64[0] = (U64)window;
+  handle.u64[1] = window->generation;
+  return handle;
+}
+
+internal R_SW_Tex2D *
+r_sw_tex2d_from_handle(R_Handle handle)
+{
+  R_SW_Tex2D *texture = (R_SW_Tex2D *)handle.u64[0];
+  if(texture == 0 || texture->generation != handle.u64[1])
+  {
+    texture = &r_sw_tex2d_nil;
+  }
+  return texture;
+}
+
+internal R_Handle
+r_sw_handle_from_tex2d(R_SW_Tex2D *texture)
+{
+  R_Handle handle = {0};
+  handle.u64[0] = (U64)texture;
+  handle.u64[1] = texture->generation;
+  return handle;
+}
+
+internal U32
+r_sw_texel_from_format_data(R_Tex2DFormat format, U8 *data)
+{
+  U32 r = 0, g = 0, b = 0, a = 255;
+  switch(format)
+  {
+    default:{}break;
+    case R_Tex2DFormat_R8:    {r = g = b = a = data[0];}break;
+    case R_Tex2DFormat_RG8:   {r = data[0]; g = data[1];}break;
+    case R_Tex2DFormat_RGBA8: {r = data[0]; g = data[1]; b = data[2]; a = data[3];}break;
+    case R_Tex2DFormat_BGRA8: {b = data[0]; g = data[1]; r = data[2]; a = data[3];}break;
+    case R_Tex2DFormat_R16:   {r = ((U16 *)data)[0]>>8;}break;
+    case R_Tex2DFormat_RGBA16:{r = ((U16 *)data)[0]>>8; g = ((U16 *)data)[1]>>8; b = ((U16 *)data)[2]>>8; a = ((U16 *)data)[3]>>8;}break;
+    case R_Tex2DFormat_R32:   {r = (U32)(Clamp(0.f, ((F32 *)data)[0], 1.f)*255.f);}break;
+    case R_Tex2DFormat_RG32:  {r = (U32)(Clamp(0.f, ((F32 *)data)[0], 1.f)*255.f); g = (U32)(Clamp(0.f, ((F32 *)data)[1], 1.f)*255.f);}break;
+    case R_Tex2DFormat_RGBA32:
+    {
+      r = (U32)(Clamp(0.f, ((F32 *)data)[0], 1.f)*255.f);
+      g = (U32)(Clamp(0.f, ((F32 *)data)[1], 1.f)*255.f);
+      b = (U32)(Clamp(0.f, ((F32 *)data)[2], 1.f)*255.f);
+      a = (U32)(Clamp(0.f, ((F32 *)data)[3], 1.f)*255.f);
+    }break;
+  }
+  U32 texel = (r) | (g<<8) | (b<<16) | (a<<24);
+  return texel;
+}
+
+internal Vec4F32
+r_sw_sample_tex2d(R_SW_Tex2D *texture, F32 u, F32 v, B32 linear)
+{
+  Vec4F32 result = {1, 1, 1, 1};
+  if(texture->texels != 0)
+  {
+    S32 w = texture->size.x;
+    S32 h = texture->size.y;
+    if(!linear)
+    {
+      // rjf: nearest, wrapping addressing (matches the gpu samplers)
+      S32 x = (S32)floor_f32(u) % w;
+      S32 y = (S32)floor_f32(v) % h;
+      x += (x < 0) ? w : 0;
+      y += (y < 0) ? h : 0;
+      U32 texel = texture->texels[y*w + x];
+      result.x = (F32)((texel>> 0)&0xff) * (1.f/255.f);
+      result.y = (F32)((texel>> 8)&0xff) * (1.f/255.f);
+      result.z = (F32)((texel>>16)&0xff) * (1.f/255.f);
+      result.w = (F32)((texel>>24)&0xff) * (1.f/255.f);
+    }
+    else
+    {
+      // rjf: bilinear, wrapping addressing
+      F32 fu = u - 0.5f;
+      F32 fv = v - 0.5f;
+      F32 fu_floor = floor_f32(fu);
+      F32 fv_floor = floor_f32(fv);
+      F32 tu = fu - fu_floor;
+      F32 tv = fv - fv_floor;
+      S32 x0 = (S32)fu_floor % w;
+      S32 y0 = (S32)fv_floor % h;
+      x0 += (x0 < 0) ? w : 0;
+      y0 += (y0 < 0) ? h : 0;
+      S32 x1 = (x0+1) % w;
+      S32 y1 = (y0+1) % h;
+      U32 texels[4] =
+      {
+        texture->texels[y0*w + x0],
+        texture->texels[y0*w + x1],
+        texture->texels[y1*w + x0],
+        texture->texels[y1*w + x1],
+      };
+      F32 weights[4] =
+      {
+        (1-tu)*(1-tv),
+        (  tu)*(1-tv),
+        (1-tu)*(  tv),
+        (  tu)*(  tv),
+      };
+      result = v4f32(0, 0, 0, 0);
+      for(U64 idx = 0; idx < 4; idx += 1)
+      {
+        F32 weight = weights[idx] * (1.f/255.f);
+        result.x += weight*(F32)((texels[idx]>> 0)&0xff);
+        result.y += weight*(F32)((texels[idx]>> 8)&0xff);
+        result.z += weight*(F32)((texels[idx]>>16)&0xff);
+        result.w += weight*(F32)((texels[idx]>>24)&0xff);
+      }
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Job Dispatch
+
+internal void
+r_sw_job_run(R_SW_Job *job)
+{
+  for(;;)
+  {
+    U64 idx = ins_atomic_u64_inc_eval(&job->next_idx) - 1;
+    if(idx >= job->count)
+    {
+      break;
+    }
+    job->func(job->params, idx);
+  }
+}
+
+internal void
+r_sw_parallel_for(R_SW_JobFunctionType *func, void *params, U64 count)
+{
+  if(count == 0)
+  {
+    return;
+  }
+
+  //- rjf: single item / no workers -> just run inline
+  if(count == 1 || r_sw_state->worker_count == 0)
+  {
+    for(U64 idx = 0; idx < count; idx += 1)
+    {
+      func(params, idx);
+    }
+    return;
+  }
+
+  //- rjf: publish job to workers
+  R_SW_Job job = {func, params, count};
+  OS_MutexScope(r_sw_state->job_mutex)
+  {
+    r_sw_state->job = &job;
+    r_sw_state->job_gen += 1;
+  }
+  os_condition_variable_broadcast(r_sw_state->job_cv);
+
+  //- rjf: participate
+  r_sw_job_run(&job);
+
+  //- rjf: wait for all workers that picked up this job to leave it. once all
+  // items are claimed, & no worker is still holding the job, every item is
+  // complete, & the job can be safely retired from the stack.
+  OS_MutexScope(r_sw_state->job_mutex) for(;;)
+  {
+    if(job.active_worker_count == 0)
+    {
+      r_sw_state->job = 0;
+      break;
+    }
+    os_condition_variable_wait(r_sw_state->job_done_cv, r_sw_state->job_mutex, max_U64);
+  }
+}
+
+internal void
+r_sw_worker_thread__entry_point(void *p)
+{
+  ThreadNameF("[r] sw raster worker #%I64u", (U64)p);
+  U64 seen_gen = 0;
+  for(;;)
+  {
+    R_SW_Job *job = 0;
+    OS_MutexScope(r_sw_state->job_mutex) for(;;)
+    {
+      if(r_sw_state->job_gen != seen_gen)
+      {
+        seen_gen = r_sw_state->job_gen;
+        job = r_sw_state->job;
+        if(job != 0)
+        {
+          job->active_worker_count += 1;
+        }
+        break;
+      }
+      os_condition_variable_wait(r_sw_state->job_cv, r_sw_state->job_mutex, max_U64);
+    }
+    if(job != 0)
+    {
+      r_sw_job_run(job);
+      OS_MutexScope(r_sw_state->job_mutex)
+      {
+        job->active_worker_count -= 1;
+      }
+      os_condition_variable_broadcast(r_sw_state->job_done_cv);
+    }
+  }
+}
+
+////////////////////////////////
+//~ rjf: Rasterization
+
+internal F32
+r_sw_rect_sdf(F32 x, F32 y, F32 half_size_x, F32 half_size_y, F32 r)
+{
+  F32 qx = Max(abs_f32(x) - half_size_x + r, 0.f);
+  F32 qy = Max(abs_f32(y) - half_size_y + r, 0.f);
+  F32 result = sqrt_f32(qx*qx + qy*qy) - r;
+  return result;
+}
+
+internal F32
+r_sw_smoothstep01(F32 t)
+{
+  t = Clamp(0.f, t, 1.f);
+  F32 result = t*t*(3.f - 2.f*t);
+  return result;
+}
+
+internal R_SW_RowParams
+r_sw_row_params_from_rect(R_SW_Rect *rect, F32 pct_y)
+{
+  R_SW_RowParams p = {0};
+  Vec4F32 tint_left  = mix_4f32(rect->colors[Corner_00], rect->colors[Corner_01], pct_y);
+  Vec4F32 tint_right = mix_4f32(rect->colors[Corner_10], rect->colors[Corner_11], pct_y);
+  p.tint_left    = tint_left;
+  p.tint_delta   = sub_4f32(tint_right, tint_left);
+  p.sdf_y        = (2.f*pct_y - 1.f)*rect->half_size.y;
+  p.radius_left  = (pct_y < 0.5f) ? rect->corner_radii[Corner_00] : rect->corner_radii[Corner_01];
+  p.radius_right = (pct_y < 0.5f) ? rect->corner_radii[Corner_10] : rect->corner_radii[Corner_11];
+  p.src_v        = rect->src_p0.y + pct_y*rect->src_size.y;
+  return p;
+}
+
+internal void
+r_sw_rect_fill_row__scalar(R_SW_Rect *rect, U32 *row, S32 x_min, S32 x_max, F32 pct_y)
+{
+  R_SW_RowParams p = r_sw_row_params_from_rect(rect, pct_y);
+  F32 softness_2x = 2.f*rect->softness;
+  F32 softness_2x_inv = 1.f/Max(softness_2x, 0.00001f);
+  B32 linear = !!(rect->flags & R_SW_RectFlag_Linear);
+  for(S32 x = x_min; x < x_max; x += 1)
+  {
+    F32 pct_x = ((F32)x + 0.5f - rect->origin.x)*rect->pct_per_px.x;
+
+    // rjf: tint * albedo
+    Vec4F32 color = add_4f32(p.tint_left, scale_4f32(p.tint_delta, pct_x));
+    if(rect->flags & R_SW_RectFlag_Textured)
+    {
+      Vec4F32 albedo = r_sw_sample_tex2d(rect->texture, rect->src_p0.x + pct_x*rect->src_size.x, p.src_v, linear);
+      color = mul_4f32(color, albedo);
+    }
+    F32 alpha = color.w*rect->opacity;
+
+    // rjf: borders & corners
+    if(rect->flags & (R_SW_RectFlag_Border|R_SW_RectFlag_CornerSDF))
+    {
+      F32 sdf_x = (2.f*pct_x - 1.f)*rect->half_size.x;
+      F32 radius = (pct_x < 0.5f) ? p.radius_left : p.radius_right;
+      if(rect->flags & R_SW_RectFlag_Border)
+      {
+        F32 shrink = softness_2x + rect->border_thickness;
+        F32 s = r_sw_rect_sdf(sdf_x, p.sdf_y, rect->half_size.x - shrink, rect->half_size.y - shrink, Max(radius - rect->border_thickness, 0.f));
+        alpha *= r_sw_smoothstep01(s*softness_2x_inv);
+      }
+      if(rect->flags & R_SW_RectFlag_CornerSDF)
+      {
+        F32 s = r_sw_rect_sdf(sdf_x, p.sdf_y, rect->half_size.x - softness_2x, rect->half_size.y - softness_2x, radius);
+        alpha *= 1.f - r_sw_smoothstep01(s*softness_2x_inv);
+      }
+    }
+
+    // rjf: blend
+    alpha = Clamp(0.f, alpha, 1.f);
+    if(alpha > 0.f)
+    {
+      U32 dst = row[x];
+      F32 db = (F32)((dst>> 0)&0xff);
+      F32 dg = (F32)((dst>> 8)&0xff);
+      F32 dr = (F32)((dst>>16)&0xff);
+      F32 o_b = db + (Clamp(0.f, color.z, 1.f)*255.f - db)*alpha;
+      F32 o_g = dg + (Clamp(0.f, color.y, 1.f)*255.f - dg)*alpha;
+      F32 o_r = dr + (Clamp(0.f, color.x, 1.f)*255.f - dr)*alpha;
+      row[x] = 0xff000000 | ((U32)(o_r + 0.5f)<<16) | ((U32)(o_g + 0.5f)<<8) | ((U32)(o_b + 0.5f));
+    }
+  }
+}
+
+#if R_SW_SIMD_SSE2
+
+internal __m128
+r_sw_smoothstep01__sse2(__m128 t)
+{
+  t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.f));
+  __m128 result = _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.f), _mm_add_ps(t, t)));
+  return result;
+}
+
+internal __m128
+r_sw_rect_sdf__sse2(__m128 x, F32 y, F32 half_size_x, F32 half_size_y, __m128 r)
+{
+  __m128 zero = _mm_setzero_ps();
+  __m128 abs_x = _mm_andnot_ps(_mm_set1_ps(-0.f), x);
+  __m128 qx = _mm_max_ps(_mm_add_ps(_mm_sub_ps(abs_x, _mm_set1_ps(half_size_x)), r), zero);
+  __m128 qy = _mm_max_ps(_mm_add_ps(_mm_set1_ps(abs_f32(y) - half_size_y), r), zero);
+  __m128 result = _mm_sub_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy))), r);
+  return result;
+}
+
+internal void
+r_sw_rect_fill_row__sse2(R_SW_Rect *rect, U32 *row, S32 x_min, S32 x_max, F32 pct_y)
+{
+  R_SW_RowParams p = r_sw_row_params_from_rect(rect, pct_y);
+  F32 softness_2x = 2.f*rect->softness;
+  __m128 softness_2x_inv = _mm_set1_ps(1.f/Max(softness_2x, 0.00001f));
+  B32 linear = !!(rect->flags & R_SW_RectFlag_Linear);
+  __m128 zero = _mm_setzero_ps();
+  __m128 one = _mm_set1_ps(1.f);
+  __m128 half = _mm_set1_ps(0.5f);
+  __m128 c255 = _mm_set1_ps(255.f);
+  __m128 lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+  __m128 pct_per_px_x = _mm_set1_ps(rect->pct_per_px.x);
+  __m128i byte_mask = _mm_set1_epi32(0xff);
+  for(S32 x = x_min; x+4 <= x_max; x += 4)
+  {
+    __m128 pct_x = _mm_mul_ps(_mm_add_ps(_mm_set1_ps((F32)x - rect->origin.x), lane_offsets), pct_per_px_x);
+
+    // rjf: tint
+    __m128 r = _mm_add_ps(_mm_set1_ps(p.tint_left.x), _mm_mul_ps(_mm_set1_ps(p.tint_delta.x), pct_x));
+    __m128 g = _mm_add_ps(_mm_set1_ps(p.tint_left.y), _mm_mul_ps(_mm_set1_ps(p.tint_delta.y), pct_x));
+    __m128 b = _mm_add_ps(_mm_set1_ps(p.tint_left.z), _mm_mul_ps(_mm_set1_ps(p.tint_delta.z), pct_x));
+    __m128 a = _mm_add_ps(_mm_set1_ps(p.tint_left.w), _mm_mul_ps(_mm_set1_ps(p.tint_delta.w), pct_x));
+
+    // rjf: albedo - texel fetches are scalar gathers, the math around them is not
+    if(rect->flags & R_SW_RectFlag_Textured)
+    {
+      F32 u[4];
+      _mm_storeu_ps(u, _mm_add_ps(_mm_set1_ps(rect->src_p0.x), _mm_mul_ps(pct_x, _mm_set1_ps(rect->src_size.x))));
+      Vec4F32 s0 = r_sw_sample_tex2d(rect->texture, u[0], p.src_v, linear);
+      Vec4F32 s1 = r_sw_sample_tex2d(rect->texture, u[1], p.src_v, linear);
+      Vec4F32 s2 = r_sw_sample_tex2d(rect->texture, u[2], p.src_v, linear);
+      Vec4F32 s3 = r_sw_sample_tex2d(rect->texture, u[3], p.src_v, linear);
+      r = _mm_mul_ps(r, _mm_set_ps(s3.x, s2.x, s1.x, s0.x));
+      g = _mm_mul_ps(g, _mm_set_ps(s3.y, s2.y, s1.y, s0.y));
+      b = _mm_mul_ps(b, _mm_set_ps(s3.z, s2.z, s1.z, s0.z));
+      a = _mm_mul_ps(a, _mm_set_ps(s3.w, s2.w, s1.w, s0.w));
+    }
+    a = _mm_mul_ps(a, _mm_set1_ps(rect->opacity));
+
+    // rjf: borders & corners
+    if(rect->flags & (R_SW_RectFlag_Border|R_SW_RectFlag_CornerSDF))
+    {
+      __m128 sdf_x = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(pct_x, pct_x), one), _mm_set1_ps(rect->half_size.x));
+      __m128 left_mask = _mm_cmplt_ps(pct_x, half);
+      __m128 radius = _mm_or_ps(_mm_and_ps(left_mask, _mm_set1_ps(p.radius_left)), _mm_andnot_ps(left_mask, _mm_set1_ps(p.radius_right)));
+      if(rect->flags & R_SW_RectFlag_Border)
+      {
+        F32 shrink = softness_2x + rect->border_thickness;
+        __m128 border_radius = _mm_max_ps(_mm_sub_ps(radius, _mm_set1_ps(rect->border_thickness)), zero);
+        __m128 s = r_sw_rect_sdf__sse2(sdf_x, p.sdf_y, rect->half_size.x - shrink, rect->half_size.y - shrink, border_radius);
+        a = _mm_mul_ps(a, r_sw_smoothstep01__sse2(_mm_mul_ps(s, softness_2x_inv)));
+      }
+      if(rect->flags & R_SW_RectFlag_CornerSDF)
+      {
+        __m128 s = r_sw_rect_sdf__sse2(sdf_x, p.sdf_y, rect->half_size.x - softness_2x, rect->half_size.y - softness_2x, radius);
+        a = _mm_mul_ps(a, _mm_sub_ps(one, r_sw_smoothstep01__sse2(_mm_mul_ps(s, softness_2x_inv))));
+      }
+    }
+
+    // rjf: skip fully transparent spans (glyph padding, border interiors)
+    a = _mm_min_ps(_mm_max_ps(a, zero), one);
+    if(_mm_movemask_ps(_mm_cmpgt_ps(a, zero)) == 0)
+    {
+      continue;
+    }
+
+    // rjf: blend
+    __m128i dst = _mm_loadu_si128((__m128i *)(row + x));
+    __m128 db = _mm_cvtepi32_ps(_mm_and_si128(dst, byte_mask));
+    __m128 dg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dst, 8), byte_mask));
+    __m128 dr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dst, 16), byte_mask));
+    __m128 sr = _mm_mul_ps(_mm_min_ps(_mm_max_ps(r, zero), one), c255);
+    __m128 sg = _mm_mul_ps(_mm_min_ps(_mm_max_ps(g, zero), one), c255);
+    __m128 sb = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, zero), one), c255);
+    __m128i out_r = _mm_cvtps_epi32(_mm_add_ps(dr, _mm_mul_ps(_mm_sub_ps(sr, dr), a)));
+    __m128i out_g = _mm_cvtps_epi32(_mm_add_ps(dg, _mm_mul_ps(_mm_sub_ps(sg, dg), a)));
+    __m128i out_b = _mm_cvtps_epi32(_mm_add_ps(db, _mm_mul_ps(_mm_sub_ps(sb, db), a)));
+    __m128i out = _mm_or_si128(_mm_set1_epi32((int)0xff000000),
+                               _mm_or_si128(_mm_slli_epi32(out_r, 16),
+                                            _mm_or_si128(_mm_slli_epi32(out_g, 8), out_b)));
+    _mm_storeu_si128((__m128i *)(row + x), out);
+  }
+}
+
+#endif // R_SW_SIMD_SSE2
+
+internal void
+r_sw_rect_fill_row(R_SW_Rect *rect, U32 *row, S32 x_min, S32 x_max, F32 pct_y)
+{
+#if R_SW_SIMD_SSE2
+  S32 x_simd_max = x_min + ((x_max - x_min)/4)*4;
+  r_sw_rect_fill_row__sse2(rect, row, x_min, x_simd_max, pct_y);
+  r_sw_rect_fill_row__scalar(rect, row, x_simd_max, x_max, pct_y);
+#else
+  r_sw_rect_fill_row__scalar(rect, row, x_min, x_max, pct_y);
+#endif
+}
+
+internal void
+r_sw_ui_pass_tile_job(void *params, U64 idx)
+{
+  R_SW_UIPassJob *job = (R_SW_UIPassJob *)params;
+  R_SW_Window *window = job->window;
+  S32 tile_x = (S32)(idx % job->tile_count_x);
+  S32 tile_y = (S32)(idx / job->tile_count_x);
+  Rng2S32 tile = r2s32p(tile_x*R_SW_TILE_SIZE_PX, tile_y*R_SW_TILE_SIZE_PX,
+                        Min((tile_x+1)*R_SW_TILE_SIZE_PX, window->resolution.x),
+                        Min((tile_y+1)*R_SW_TILE_SIZE_PX, window->resolution.y));
+  for(U32 off = job->tile_rect_offs[idx]; off < job->tile_rect_offs[idx+1]; off += 1)
+  {
+    R_SW_Rect *rect = &job->rects[job->tile_rect_idxs[off]];
+    Rng2S32 span = intersect_2s32(rect->bounds, tile);
+    for(S32 y = span.y0; y < span.y1; y += 1)
+    {
+      F32 pct_y = ((F32)y + 0.5f - rect->origin.y)*rect->pct_per_px.y;
+      r_sw_rect_fill_row(rect, window->color + (U64)y*window->resolution.x, span.x0, span.x1, pct_y);
+    }
+  }
+}
+
+internal void
+r_sw_blur_pass_h_job(void *params, U64 idx)
+{
+  R_SW_BlurPassJob *job = (R_SW_BlurPassJob *)params;
+  R_SW_Window *window = job->window;
+  S32 y_min = job->src_rect.y0 + (S32)idx*R_SW_BLUR_BAND_SIZE_PX;
+  S32 y_max = Min(y_min + R_SW_BLUR_BAND_SIZE_PX, job->src_rect.y1);
+  S32 x_last = window->resolution.x-1;
+  S32 taps = (S32)job->weights_count;
+  for(S32 y = y_min; y < y_max; y += 1)
+  {
+    U32 *src_row = window->color + (U64)y*window->resolution.x;
+    U32 *dst_row = window->scratch + (U64)y*window->resolution.x;
+    for(S32 x = job->rect.x0; x < job->rect.x1; x += 1)
+    {
+#if R_SW_SIMD_SSE2
+      __m128i zero = _mm_setzero_si128();
+      __m128 acc = _mm_setzero_ps();
+      for(S32 tap = -(taps-1); tap < taps; tap += 1)
+      {
+        S32 sx = Clamp(0, x+tap, x_last);
+        __m128 c = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)src_row[sx]), zero), zero));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(job->weights[tap < 0 ? -tap : tap]), c));
+      }
+      __m128i packed = _mm_cvtps_epi32(acc);
+      packed = _mm_packs_epi32(packed, packed);
+      packed = _mm_packus_epi16(packed, packed);
+      dst_row[x] = 0xff000000 | ((U32)_mm_cvtsi128_si32(packed) & 0x00ffffff);
+#else
+      F32 acc[3] = {0};
+      for(S32 tap = -(taps-1); tap < taps; tap += 1)
+      {
+        S32 sx = Clamp(0, x+tap, x_last);
+        F32 w = job->weights[tap < 0 ? -tap : tap];
+        U32 c = src_row[sx];
+        acc[0] += w*(F32)((c>> 0)&0xff);
+        acc[1] += w*(F32)((c>> 8)&0xff);
+        acc[2] += w*(F32)((c>>16)&0xff);
+      }
+      U32 b = (U32)Clamp(0.f, acc[0] + 0.5f, 255.f);
+      U32 g = (U32)Clamp(0.f, acc[1] + 0.5f, 255.f);
+      U32 r = (U32)Clamp(0.f, acc[2] + 0.5f, 255.f);
+      dst_row[x] = 0xff000000 | (r<<16) | (g<<8) | b;
+#endif
+    }
+  }
+}
+
+internal void
+r_sw_blur_pass_v_job(void *params, U64 idx)
+{
+  R_SW_BlurPassJob *job = (R_SW_BlurPassJob *)params;
+  R_SW_Window *window = job->window;
+  S32 y_min = job->rect.y0 + (S32)idx*R_SW_BLUR_BAND_SIZE_PX;
+  S32 y_max = Min(y_min + R_SW_BLUR_BAND_SIZE_PX, job->rect.y1);
+  S32 taps = (S32)job->weights_count;
+  F32 rect_w = (F32)(job->rect.x1 - job->rect.x0);
+  F32 rect_h = (F32)(job->rect.y1 - job->rect.y0);
+  F32 half_size_x = rect_w/2;
+  F32 half_size_y = rect_h/2;
+  for(S32 y = y_min; y < y_max; y += 1)
+  {
+    U32 *dst_row = window->color + (U64)y*window->resolution.x;
+    F32 pct_y = ((F32)(y - job->rect.y0) + 0.5f)/rect_h;
+    F32 sdf_y = (2.f*pct_y - 1.f)*half_size_y;
+    for(S32 x = job->rect.x0; x < job->rect.x1; x += 1)
+    {
+      // rjf: mask by rounded rect - only leave blurring where mostly opaque
+      F32 pct_x = ((F32)(x - job->rect.x0) + 0.5f)/rect_w;
+      F32 sdf_x = (2.f*pct_x - 1.f)*half_size_x;
+      F32 radius = job->corner_radii[pct_x < 0.5f ? (pct_y < 0.5f ? Corner_00 : Corner_01) : (pct_y < 0.5f ? Corner_10 : Corner_11)];
+      F32 corner_sdf_s = r_sw_rect_sdf(sdf_x, sdf_y, half_size_x - 2.f, half_size_y - 2.f, radius);
+      if(1.f - r_sw_smoothstep01(corner_sdf_s*0.5f) < 0.9f)
+      {
+        continue;
+      }
+
+      // rjf: accumulate
+#if R_SW_SIMD_SSE2
+      __m128i zero = _mm_setzero_si128();
+      __m128 acc = _mm_setzero_ps();
+      for(S32 tap = -(taps-1); tap < taps; tap += 1)
+      {
+        S32 sy = Clamp(job->src_rect.y0, y+tap, job->src_rect.y1-1);
+        U32 src = window->scratch[(U64)sy*window->resolution.x + x];
+        __m128 c = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)src), zero), zero));
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(job->weights[tap < 0 ? -tap : tap]), c));
+      }
+      __m128i packed = _mm_cvtps_epi32(acc);
+      packed = _mm_packs_epi32(packed, packed);
+      packed = _mm_packus_epi16(packed, packed);
+      dst_row[x] = 0xff000000 | ((U32)_mm_cvtsi128_si32(packed) & 0x00ffffff);
+#else
+      F32 acc[3] = {0};
+      for(S32 tap = -(taps-1); tap < taps; tap += 1)
+      {
+        S32 sy = Clamp(job->src_rect.y0, y+tap, job->src_rect.y1-1);
+        F32 w = job->weights[tap < 0 ? -tap : tap];
+        U32 c = window->scratch[(U64)sy*window->resolution.x + x];
+        acc[0] += w*(F32)((c>> 0)&0xff);
+        acc[1] += w*(F32)((c>> 8)&0xff);
+        acc[2] += w*(F32)((c>>16)&0xff);
+      }
+      U32 b = (U32)Clamp(0.f, acc[0] + 0.5f, 255.f);
+      U32 g = (U32)Clamp(0.f, acc[1] + 0.5f, 255.f);
+      U32 r = (U32)Clamp(0.f, acc[2] + 0.5f, 255.f);
+      dst_row[x] = 0xff000000 | (r<<16) | (g<<8) | b;
+#endif
+    }
+  }
+}
+
+////////////////////////////////
+//~ rjf: Headless Readback
+
+internal R_SW_Framebuffer
+r_sw_framebuffer_from_window(Arena *arena, R_Handle window_equip)
+{
+  R_SW_Framebuffer result = {0};
+  OS_MutexScopeR(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Window *window = r_sw_window_from_handle(window_equip);
+    if(window->color != 0)
+    {
+      U64 pixel_count = (U64)window->resolution.x*(U64)window->resolution.y;
+      result.size = window->resolution;
+      result.frame_idx = window->frame_idx;
+      result.pixels = push_array_no_zero(arena, U32, pixel_count);
+      MemoryCopy(result.pixels, window->color, pixel_count*sizeof(U32));
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Backend Hook Implementations
+
+//- rjf: top-level layer initialization
+
+r_hook void
+r_init(CmdLine *cmdln)
+{
+  ProfBeginFunction();
+  Arena *arena = arena_alloc();
+  r_sw_state = push_array(arena, R_SW_State, 1);
+  r_sw_state->arena = arena;
+  r_sw_state->device_rw_mutex = os_rw_mutex_alloc();
+  r_sw_state->headless = cmd_line_has_flag(cmdln, str8_lit("headless"));
+
+  //- rjf: create backup texture
+  {
+    U32 backup_texture_data[] =
+    {
+      0xff00ffff, 0x330033ff,
+      0x330033ff, 0xff00ffff,
+    };
+    r_sw_state->backup_texture = r_tex2d_alloc(R_ResourceKind_Static, v2s32(2, 2), R_Tex2DFormat_RGBA8, backup_texture_data);
+  }
+
+  //- rjf: launch raster workers
+  {
+    r_sw_state->job_mutex = os_mutex_alloc();
+    r_sw_state->job_cv = os_condition_variable_alloc();
+    r_sw_state->job_done_cv = os_condition_variable_alloc();
+    r_sw_state->worker_count = Clamp(0, os_logical_core_count()-1, R_SW_MAX_WORKER_COUNT);
+    r_sw_state->workers = push_array(arena, OS_Handle, r_sw_state->worker_count);
+    for(U64 idx = 0; idx < r_sw_state->worker_count; idx += 1)
+    {
+      r_sw_state->workers[idx] = os_launch_thread(r_sw_worker_thread__entry_point, (void *)idx, 0);
+    }
+  }
+  ProfEnd();
+}
+
+//- rjf: window setup/teardown
+
+r_hook R_Handle
+r_window_equip(OS_Handle handle)
+{
+  ProfBeginFunction();
+  R_Handle result = {0};
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Window *window = r_sw_state->first_free_window;
+    if(window == 0)
+    {
+      window = push_array(r_sw_state->arena, R_SW_Window, 1);
+    }
+    else
+    {
+      U64 gen = window->generation;
+      SLLStackPop(r_sw_state->first_free_window);
+      MemoryZeroStruct(window);
+      window->generation = gen;
+    }
+    window->generation += 1;
+    window->os_window = handle;
+    result = r_sw_handle_from_window(window);
+  }
+  ProfEnd();
+  return result;
+}
+
+r_hook void
+r_window_unequip(OS_Handle handle, R_Handle equip_handle)
+{
+  ProfBeginFunction();
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Window *window = r_sw_window_from_handle(equip_handle);
+#if R_SW_PRESENT_X11
+    if(window->x11_image != 0)
+    {
+      window->x11_image->data = 0;
+      XDestroyImage(window->x11_image);
+    }
+    if(window->x11_gc != 0)
+    {
+      XFreeGC(x11_server, window->x11_gc);
+    }
+#endif
+    if(window->color != 0)
+    {
+      os_release(window->color, window->target_size);
+      os_release(window->scratch, window->target_size);
+    }
+    window->generation += 1;
+    SLLStackPush(r_sw_state->first_free_window, window);
+  }
+  ProfEnd();
+}
+
+//- rjf: textures
+
+r_hook R_Handle
+r_tex2d_alloc(R_ResourceKind kind, Vec2S32 size, R_Tex2DFormat format, void *data)
+{
+  ProfBeginFunction();
+
+  //- rjf: allocate
+  R_SW_Tex2D *texture = 0;
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    texture = r_sw_state->first_free_tex2d;
+    if(texture == 0)
+    {
+      texture = push_array(r_sw_state->arena, R_SW_Tex2D, 1);
+    }
+    else
+    {
+      U64 gen = texture->generation;
+      SLLStackPop(r_sw_state->first_free_tex2d);
+      MemoryZeroStruct(texture);
+      texture->generation = gen;
+    }
+    texture->generation += 1;
+  }
+  if(kind == R_ResourceKind_Static)
+  {
+    Assert(data != 0 && "static texture must have initial data provided");
+  }
+
+  //- rjf: fill basics
+  texture->kind = kind;
+  texture->size = size;
+  texture->format = format;
+
+  //- rjf: allocate & fill texels
+  if(size.x > 0 && size.y > 0)
+  {
+    texture->texels_size = (U64)size.x*(U64)size.y*sizeof(U32);
+    texture->texels = (U32 *)os_reserve(texture->texels_size);
+    os_commit(texture->texels, texture->texels_size);
+    if(data != 0)
+    {
+      U64 bytes_per_pixel = r_tex2d_format_bytes_per_pixel_table[format];
+      U64 texel_count = (U64)size.x*(U64)size.y;
+      for(U64 idx = 0; idx < texel_count; idx += 1)
+      {
+        texture->texels[idx] = r_sw_texel_from_format_data(format, (U8 *)data + idx*bytes_per_pixel);
+      }
+    }
+  }
+
+  R_Handle result = r_sw_handle_from_tex2d(texture);
+  ProfEnd();
+  return result;
+}
+
+r_hook void
+r_tex2d_release(R_Handle handle)
+{
+  ProfBeginFunction();
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Tex2D *texture = r_sw_tex2d_from_handle(handle);
+    if(texture != &r_sw_tex2d_nil)
+    {
+      SLLStackPush(r_sw_state->first_to_free_tex2d, texture);
+    }
+  }
+  ProfEnd();
+}
+
+r_hook R_ResourceKind
+r_kind_from_tex2d(R_Handle handle)
+{
+  R_SW_Tex2D *texture = r_sw_tex2d_from_handle(handle);
+  return texture->kind;
+}
+
+r_hook Vec2S32
+r_size_from_tex2d(R_Handle handle)
+{
+  R_SW_Tex2D *texture = r_sw_tex2d_from_handle(handle);
+  return texture->size;
+}
+
+r_hook R_Tex2DFormat
+r_format_from_tex2d(R_Handle handle)
+{
+  R_SW_Tex2D *texture = r_sw_tex2d_from_handle(handle);
+  return texture->format;
+}
+
+r_hook void
+r_fill_tex2d_region(R_Handle handle, Rng2S32 subrect, void *data)
+{
+  ProfBeginFunction();
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Tex2D *texture = r_sw_tex2d_from_handle(handle);
+    Assert(texture->kind == R_ResourceKind_Dynamic && "only dynamic texture can update region");
+    if(texture->texels != 0)
+    {
+      U64 bytes_per_pixel = r_tex2d_format_bytes_per_pixel_table[texture->format];
+      Vec2S32 dim = v2s32(subrect.x1 - subrect.x0, subrect.y1 - subrect.y0);
+      for(S32 y = 0; y < dim.y; y += 1)
+      {
+        U8 *src_row = (U8 *)data + (U64)y*dim.x*bytes_per_pixel;
+        U32 *dst_row = texture->texels + (U64)(subrect.y0 + y)*texture->size.x + subrect.x0;
+        if(texture->format == R_Tex2DFormat_RGBA8)
+        {
+          MemoryCopy(dst_row, src_row, dim.x*sizeof(U32));
+        }
+        else for(S32 x = 0; x < dim.x; x += 1)
+        {
+          dst_row[x] = r_sw_texel_from_format_data(texture->format, src_row + x*bytes_per_pixel);
+        }
+      }
+    }
+  }
+  ProfEnd();
+}
+
+//- rjf: buffers
+
+r_hook R_Handle
+r_buffer_alloc(R_ResourceKind kind, U64 size, void *data)
+{
+  // NOTE: geo3d passes are not rasterized by the software backend, so
+  // buffers are never read back - just hand out a non-zero handle.
+  R_Handle handle = {0};
+  handle.u64[0] = 1;
+  return handle;
+}
+
+r_hook void
+r_buffer_release(R_Handle buffer)
+{
+}
+
+//- rjf: frame markers
+
+r_hook void
+r_begin_frame(void)
+{
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    // NOTE: no-op
+  }
+}
+
+r_hook void
+r_end_frame(void)
+{
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    for(R_SW_Tex2D *tex = r_sw_state->first_to_free_tex2d, *next = 0;
+        tex != 0;
+        tex = next)
+    {
+      next = tex->next;
+      if(tex->texels != 0)
+      {
+        os_release(tex->texels, tex->texels_size);
+      }
+      tex->generation += 1;
+      SLLStackPush(r_sw_state->first_free_tex2d, tex);
+    }
+    r_sw_state->first_to_free_tex2d = 0;
+  }
+}
+
+r_hook void
+r_window_begin_frame(OS_Handle window, R_Handle window_equip)
+{
+  ProfBeginFunction();
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Window *wnd = r_sw_window_from_handle(window_equip);
+
+    //- rjf: get resolution
+    Rng2F32 client_rect = os_client_rect_from_window(window);
+    Vec2S32 resolution = {(S32)(client_rect.x1 - client_rect.x0), (S32)(client_rect.y1 - client_rect.y0)};
+    resolution.x = Max(resolution.x, 1);
+    resolution.y = Max(resolution.y, 1);
+
+    //- rjf: resolution change -> reallocate color targets
+    if(wnd->resolution.x != resolution.x ||
+       wnd->resolution.y != resolution.y)
+    {
+      if(wnd->color != 0)
+      {
+        os_release(wnd->color, wnd->target_size);
+        os_release(wnd->scratch, wnd->target_size);
+      }
+#if R_SW_PRESENT_X11
+      if(wnd->x11_image != 0)
+      {
+        wnd->x11_image->data = 0;
+        XDestroyImage(wnd->x11_image);
+        wnd->x11_image = 0;
+      }
+#endif
+      wnd->resolution = resolution;
+      wnd->target_size = (U64)resolution.x*(U64)resolution.y*sizeof(U32);
+      wnd->color = (U32 *)os_reserve(wnd->target_size);
+      wnd->scratch = (U32 *)os_reserve(wnd->target_size);
+      os_commit(wnd->color, wnd->target_size);
+      os_commit(wnd->scratch, wnd->target_size);
+    }
+
+    //- rjf: clear
+    {
+      U64 pixel_count = (U64)resolution.x*(U64)resolution.y;
+      for(U64 idx = 0; idx < pixel_count; idx += 1)
+      {
+        wnd->color[idx] = 0xff000000;
+      }
+    }
+    wnd->last_rect_count = 0;
+    wnd->last_submit_us = 0;
+  }
+  ProfEnd();
+}
+
+r_hook void
+r_window_end_frame(OS_Handle window, R_Handle window_equip)
+{
+  ProfBeginFunction();
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    R_SW_Window *wnd = r_sw_window_from_handle(window_equip);
+    wnd->frame_idx += 1;
+
+    ////////////////////////////
+    //- rjf: present - in headless mode, frames only live in memory, and are
+    // read back via r_sw_framebuffer_from_window.
+    //
+    if(!r_sw_state->headless && wnd->color != 0)
+    {
+#if R_SW_PRESENT_GDI
+      HWND hwnd = w32_hwnd_from_window(w32_window_from_os_window(window));
+      HDC dc = GetDC(hwnd);
+      BITMAPINFO bmi = {0};
+      bmi.bmiHeader.biSize        = sizeof(bmi.bmiHeader);
+      bmi.bmiHeader.biWidth       = wnd->resolution.x;
+      bmi.bmiHeader.biHeight      = -wnd->resolution.y;
+      bmi.bmiHeader.biPlanes      = 1;
+      bmi.bmiHeader.biBitCount    = 32;
+      bmi.bmiHeader.biCompression = BI_RGB;
+      SetDIBitsToDevice(dc, 0, 0, wnd->resolution.x, wnd->resolution.y, 0, 0, 0, wnd->resolution.y, wnd->color, &bmi, DIB_RGB_COLORS);
+      ReleaseDC(hwnd, dc);
+#elif R_SW_PRESENT_X11
+      GFX_LinuxWindow *lnx_window = gfx_window_from_handle(window);
+      if(lnx_window != 0 && !lnx_window->wayland_native && x11_server != 0)
+      {
+        X11_Window x11_window_handle = (X11_Window)lnx_window->handle;
+        if(wnd->x11_gc == 0)
+        {
+          wnd->x11_gc = XCreateGC(x11_server, x11_window_handle, 0, 0);
+        }
+        if(wnd->x11_image == 0)
+        {
+          S32 screen = DefaultScreen(x11_server);
+          wnd->x11_image = XCreateImage(x11_server, DefaultVisual(x11_server, screen), DefaultDepth(x11_server, screen), ZPixmap, 0,
+                                        (char *)wnd->color, wnd->resolution.x, wnd->resolution.y, 32, wnd->resolution.x*sizeof(U32));
+        }
+        if(wnd->x11_image != 0)
+        {
+          XPutImage(x11_server, x11_window_handle, wnd->x11_gc, wnd->x11_image, 0, 0, 0, 0, wnd->resolution.x, wnd->resolution.y);
+          XFlush(x11_server);
+        }
+      }
+#endif
+    }
+  }
+  ProfEnd();
+}
+
+//- rjf: render pass submission
+
+r_hook void
+r_window_submit(OS_Handle window, R_Handle window_equip, R_PassList *passes)
+{
+  ProfBeginFunction();
+  OS_MutexScopeW(r_sw_state->device_rw_mutex)
+  {
+    ////////////////////////////
+    //- rjf: unpack arguments
+    //
+    R_SW_Window *wnd = r_sw_window_from_handle(window_equip);
+    Vec2S32 resolution = wnd->resolution;
+    Rng2S32 viewport = r2s32p(0, 0, resolution.x, resolution.y);
+    U64 submit_start_us = os_now_microseconds();
+
+    ////////////////////////////
+    //- rjf: do passes
+    //
+    for(R_PassNode *pass_n = passes->first; pass_n != 0 && wnd->color != 0; pass_n = pass_n->next)
+    {
+      Temp scratch = scratch_begin(0, 0);
+      R_Pass *pass = &pass_n->v;
+      switch(pass->kind)
+      {
+        default:{}break;
+
+        ////////////////////////
+        //- rjf: ui rendering pass
+        //
+        case R_PassKind_UI:
+        {
+          R_PassParams_UI *params = pass->params_ui;
+          R_BatchGroup2DList *rect_batch_groups = &params->rects;
+
+          //- rjf: count instances
+          U64 inst_count = 0;
+          for(R_BatchGroup2DNode *group_n = rect_batch_groups->first; group_n != 0; group_n = group_n->next)
+          {
+            inst_count += group_n->batches.byte_count / Max(group_n->batches.bytes_per_inst, 1);
+          }
+
+          //- rjf: transform & clip instances into screen-space rects
+          R_SW_Rect *rects = push_array_no_zero(scratch.arena, R_SW_Rect, inst_count);
+          U64 rect_count = 0;
+          for(R_BatchGroup2DNode *group_n = rect_batch_groups->first; group_n != 0; group_n = group_n->next)
+          {
+            R_BatchList *batches = &group_n->batches;
+            R_BatchGroup2DParams *group_params = &group_n->params;
+
+            // rjf: unpack texture
+            R_Handle texture_handle = group_params->tex;
+            if(r_handle_match(texture_handle, r_handle_zero()))
+            {
+              texture_handle = r_sw_state->backup_texture;
+            }
+            R_SW_Tex2D *texture = r_sw_tex2d_from_handle(texture_handle);
+
+            // rjf: unpack xform
+            Mat3x3F32 xform = group_params->xform;
+            Vec2F32 xform_scale =
+            {
+              length_2f32(v2f32(xform.v[0][0], xform.v[0][1])),
+              length_2f32(v2f32(xform.v[1][0], xform.v[1][1])),
+            };
+
+            // rjf: unpack clip (same rules as the gpu scissor)
+            Rng2S32 clip = viewport;
+            {
+              Rng2F32 c = group_params->clip;
+              if(c.x0 == 0 && c.y0 == 0 && c.x1 == 0 && c.y1 == 0)
+              {
+                clip = viewport;
+              }
+              else if(c.x0 > c.x1 || c.y0 > c.y1)
+              {
+                clip = r2s32p(0, 0, 0, 0);
+              }
+              else
+              {
+                clip = intersect_2s32(viewport, r2s32p((S32)c.x0, (S32)c.y0, (S32)c.x1, (S32)c.y1));
+              }
+            }
+            if(clip.x1 <= clip.x0 || clip.y1 <= clip.y0)
+            {
+              continue;
+            }
+
+            // rjf: build rects
+            for(R_BatchNode *batch_n = batches->first; batch_n != 0; batch_n = batch_n->next)
+            {
+              R_Rect2DInst *insts = (R_Rect2DInst *)batch_n->v.v;
+              U64 batch_inst_count = batch_n->v.byte_count / sizeof(R_Rect2DInst);
+              for(U64 inst_idx = 0; inst_idx < batch_inst_count; inst_idx += 1)
+              {
+                R_Rect2DInst *inst = &insts[inst_idx];
+
+                // NOTE: ui xforms are scales & translations, so the
+                // transformed rect stays axis-aligned.
+                Vec2F32 p0 = v2f32(xform.v[0][0]*inst->dst.x0 + xform.v[1][0]*inst->dst.y0 + xform.v[2][0],
+                                   xform.v[0][1]*inst->dst.x0 + xform.v[1][1]*inst->dst.y0 + xform.v[2][1]);
+                Vec2F32 p1 = v2f32(xform.v[0][0]*inst->dst.x1 + xform.v[1][0]*inst->dst.y1 + xform.v[2][0],
+                                   xform.v[0][1]*inst->dst.x1 + xform.v[1][1]*inst->dst.y1 + xform.v[2][1]);
+                if(p0.x == p1.x || p0.y == p1.y)
+                {
+                  continue;
+                }
+
+                // rjf: pixel coverage follows pixel centers, like the gpu rasterizer
+                Rng2S32 bounds =
+                {
+                  (S32)ceil_f32(Min(p0.x, p1.x) - 0.5f),
+                  (S32)ceil_f32(Min(p0.y, p1.y) - 0.5f),
+                  (S32)ceil_f32(Max(p0.x, p1.x) - 0.5f),
+                  (S32)ceil_f32(Max(p0.y, p1.y) - 0.5f),
+                };
+                bounds = intersect_2s32(bounds, clip);
+                if(bounds.x1 <= bounds.x0 || bounds.y1 <= bounds.y0)
+                {
+                  continue;
+                }
+
+                // rjf: fill
+                R_SW_Rect *rect = &rects[rect_count];
+                rect_count += 1;
+                rect->bounds           = bounds;
+                rect->origin           = p0;
+                rect->pct_per_px       = v2f32(1.f/(p1.x - p0.x), 1.f/(p1.y - p0.y));
+                rect->half_size        = v2f32(abs_f32(inst->dst.x1 - inst->dst.x0)/2.f * xform_scale.x,
+                                               abs_f32(inst->dst.y1 - inst->dst.y0)/2.f * xform_scale.y);
+                rect->src_p0           = inst->src.p0;
+                rect->src_size         = sub_2f32(inst->src.p1, inst->src.p0);
+                MemoryCopyArray(rect->colors, inst->colors);
+                MemoryCopyArray(rect->corner_radii, inst->corner_radii);
+                rect->border_thickness = inst->border_thickness;
+                rect->softness         = inst->edge_softness;
+                rect->opacity          = 1-group_params->transparency;
+                rect->texture          = texture;
+                rect->flags            = 0;
+                if(inst->white_texture_override < 1.f)
+                {
+                  rect->flags |= R_SW_RectFlag_Textured;
+                }
+                if(group_params->tex_sample_kind == R_Tex2DSampleKind_Linear)
+                {
+                  rect->flags |= R_SW_RectFlag_Linear;
+                }
+                if(inst->border_thickness > 0)
+                {
+                  rect->flags |= R_SW_RectFlag_Border;
+                }
+                if(inst->corner_radii[Corner_00] > 0 || inst->corner_radii[Corner_01] > 0 ||
+                   inst->corner_radii[Corner_10] > 0 || inst->corner_radii[Corner_11] > 0 ||
+                   inst->edge_softness > 0.75f)
+                {
+                  rect->flags |= R_SW_RectFlag_CornerSDF;
+                }
+              }
+            }
+          }
+
+          //- rjf: bin rects into tiles, preserving submission order per tile
+          U64 tile_count_x = ((U64)resolution.x + R_SW_TILE_SIZE_PX-1) / R_SW_TILE_SIZE_PX;
+          U64 tile_count_y = ((U64)resolution.y + R_SW_TILE_SIZE_PX-1) / R_SW_TILE_SIZE_PX;
+          U64 tile_count = tile_count_x*tile_count_y;
+          U32 *tile_rect_offs = push_array(scratch.arena, U32, tile_count+1);
+          for(U64 rect_idx = 0; rect_idx < rect_count; rect_idx += 1)
+          {
+            Rng2S32 bounds = rects[rect_idx].bounds;
+            for(S32 ty = bounds.y0/R_SW_TILE_SIZE_PX; ty <= (bounds.y1-1)/R_SW_TILE_SIZE_PX; ty += 1)
+            {
+              for(S32 tx = bounds.x0/R_SW_TILE_SIZE_PX; tx <= (bounds.x1-1)/R_SW_TILE_SIZE_PX; tx += 1)
+              {
+                tile_rect_offs[ty*tile_count_x + tx + 1] += 1;
+              }
+            }
+          }
+          for(U64 tile_idx = 0; tile_idx < tile_count; tile_idx += 1)
+          {
+            tile_rect_offs[tile_idx+1] += tile_rect_offs[tile_idx];
+          }
+          U32 *tile_rect_idxs = push_array_no_zero(scratch.arena, U32, tile_rect_offs[tile_count]);
+          U32 *tile_cursors = push_array_no_zero(scratch.arena, U32, tile_count);
+          MemoryCopy(tile_cursors, tile_rect_offs, sizeof(U32)*tile_count);
+          for(U64 rect_idx = 0; rect_idx < rect_count; rect_idx += 1)
+          {
+            Rng2S32 bounds = rects[rect_idx].bounds;
+            for(S32 ty = bounds.y0/R_SW_TILE_SIZE_PX; ty <= (bounds.y1-1)/R_SW_TILE_SIZE_PX; ty += 1)
+            {
+              for(S32 tx = bounds.x0/R_SW_TILE_SIZE_PX; tx <= (bounds.x1-1)/R_SW_TILE_SIZE_PX; tx += 1)
+              {
+                U64 tile_idx = ty*tile_count_x + tx;
+                tile_rect_idxs[tile_cursors[tile_idx]] = (U32)rect_idx;
+                tile_cursors[tile_idx] += 1;
+              }
+            }
+          }
+
+          //- rjf: rasterize tiles
+          R_SW_UIPassJob job = {0};
+          job.window         = wnd;
+          job.rects          = rects;
+          job.tile_count_x   = tile_count_x;
+          job.tile_count_y   = tile_count_y;
+          job.tile_rect_offs = tile_rect_offs;
+          job.tile_rect_idxs = tile_rect_idxs;
+          r_sw_parallel_for(r_sw_ui_pass_tile_job, &job, tile_count);
+          wnd->last_rect_count += rect_count;
+        }break;
+
+        ////////////////////////
+        //- rjf: blur rendering pass
+        //
+        case R_PassKind_Blur:
+        {
+          R_PassParams_Blur *params = pass->params_blur;
+          R_SW_BlurPassJob job = {0};
+          job.window = wnd;
+          MemoryCopyArray(job.corner_radii, params->corner_radii);
+
+          //- rjf: build kernel (same gaussian as the gpu path, without the
+          // bilinear tap folding)
+          {
+            F32 blur_size = Min(params->blur_size, ArrayCount(job.weights));
+            U64 blur_count = (U64)round_f32(blur_size);
+            F32 stdev = (blur_size-1.f)/2.f;
+            F32 one_over_root_2pi_stdev2 = 1/sqrt_f32(2*pi32*stdev*stdev);
+            F32 euler32 = 2.718281828459045f;
+            job.weights[0] = 1.f;
+            job.weights_count = 1;
+            if(stdev > 0.f)
+            {
+              for(U64 idx = 0; idx < blur_count; idx += 1)
+              {
+                F32 kernel_x = (F32)idx;
+                job.weights[idx] = one_over_root_2pi_stdev2*pow_f32(euler32, -kernel_x*kernel_x/(2.f*stdev*stdev));
+              }
+              job.weights_count = Max(blur_count, 1);
+            }
+            if(job.weights[0] > 1.f)
+            {
+              MemoryZeroArray(job.weights);
+              job.weights[0] = 1.f;
+              job.weights_count = 1;
+            }
+          }
+
+          //- rjf: compute covered pixels; horizontal pass covers enough rows
+          // for the vertical pass' taps
+          job.rect = r2s32p((S32)ceil_f32(params->rect.x0 - 0.5f), (S32)ceil_f32(params->rect.y0 - 0.5f),
+                            (S32)ceil_f32(params->rect.x1 - 0.5f), (S32)ceil_f32(params->rect.y1 - 0.5f));
+          job.rect = intersect_2s32(job.rect, viewport);
+          if(job.rect.x1 <= job.rect.x0 || job.rect.y1 <= job.rect.y0)
+          {
+            break;
+          }
+          job.src_rect = intersect_2s32(pad_2s32(job.rect, (S32)job.weights_count), viewport);
+          job.src_rect.x0 = job.rect.x0;
+          job.src_rect.x1 = job.rect.x1;
+
+          //- rjf: dispatch
+          U64 h_band_count = ((U64)(job.src_rect.y1 - job.src_rect.y0) + R_SW_BLUR_BAND_SIZE_PX-1) / R_SW_BLUR_BAND_SIZE_PX;
+          U64 v_band_count = ((U64)(job.rect.y1 - job.rect.y0) + R_SW_BLUR_BAND_SIZE_PX-1) / R_SW_BLUR_BAND_SIZE_PX;
+          r_sw_parallel_for(r_sw_blur_pass_h_job, &job, h_band_count);
+          r_sw_parallel_for(r_sw_blur_pass_v_job, &job, v_band_count);
+        }break;
+
+        ////////////////////////
+        //- rjf: geo3d rendering pass
+        //
+        case R_PassKind_Geo3D:
+        {
+          // NOTE: not supported by the software backend.
+        }break;
+      }
+      scratch_end(scratch);
+    }
+    wnd->last_submit_us += os_now_microseconds() - submit_start_us;
+  }
+  ProfEnd();
+}
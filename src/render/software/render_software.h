@@ -0,0 +1,241 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef RENDER_SOFTWARE_H
+#define RENDER_SOFTWARE_H
+
+////////////////////////////////
+//~ rjf: SIMD Selection
+
+#if !defined(R_SW_SIMD_SSE2) && ARCH_X64
+# define R_SW_SIMD_SSE2 1
+#endif
+#if !defined(R_SW_SIMD_SSE2)
+# define R_SW_SIMD_SSE2 0
+#endif
+
+#if R_SW_SIMD_SSE2
+# include <emmintrin.h>
+#endif
+
+////////////////////////////////
+//~ rjf: Presentation Selection
+
+#if OS_WINDOWS && !OS_GFX_STUB
+# define R_SW_PRESENT_GDI 1
+# pragma comment(lib, "gdi32")
+#elif OS_LINUX && !OS_GFX_STUB
+# define R_SW_PRESENT_X11 1
+#endif
+#if !defined(R_SW_PRESENT_GDI)
+# define R_SW_PRESENT_GDI 0
+#endif
+#if !defined(R_SW_PRESENT_X11)
+# define R_SW_PRESENT_X11 0
+#endif
+
+////////////////////////////////
+//~ rjf: Constants
+
+#define R_SW_TILE_SIZE_PX 64
+#define R_SW_BLUR_BAND_SIZE_PX 16
+#define R_SW_MAX_WORKER_COUNT 15
+
+////////////////////////////////
+//~ rjf: Main State Types
+
+typedef struct R_SW_Tex2D R_SW_Tex2D;
+struct R_SW_Tex2D
+{
+  R_SW_Tex2D *next;
+  U64 generation;
+  R_ResourceKind kind;
+  Vec2S32 size;
+  R_Tex2DFormat format;
+
+  // rjf: texels are stored as RGBA8, with the channel mapping of `format`
+  // already applied (e.g. R8 -> RRRR), so the rasterizer only has one path
+  U32 *texels;
+  U64 texels_size;
+};
+
+typedef struct R_SW_Window R_SW_Window;
+struct R_SW_Window
+{
+  R_SW_Window *next;
+  U64 generation;
+  OS_Handle os_window;
+
+  // rjf: color targets - BGRA8 (0xAARRGGBB), which is what both GDI & X11
+  // TrueColor visuals take directly for presentation
+  Vec2S32 resolution;
+  U32 *color;
+  U32 *scratch;
+  U64 target_size;
+
+  // rjf: platform presentation state
+#if R_SW_PRESENT_X11
+  GC x11_gc;
+  XImage *x11_image;
+#endif
+
+  // rjf: stats
+  U64 frame_idx;
+  U64 last_rect_count;
+  U64 last_submit_us;
+};
+
+typedef struct R_SW_Framebuffer R_SW_Framebuffer;
+struct R_SW_Framebuffer
+{
+  Vec2S32 size;
+  U64 frame_idx;
+  U32 *pixels;
+};
+
+////////////////////////////////
+//~ rjf: Rasterization Types
+
+typedef U32 R_SW_RectFlags;
+enum
+{
+  R_SW_RectFlag_Textured  = (1<<0),
+  R_SW_RectFlag_Border    = (1<<1),
+  R_SW_RectFlag_CornerSDF = (1<<2),
+  R_SW_RectFlag_Linear    = (1<<3),
+};
+
+typedef struct R_SW_Rect R_SW_Rect;
+struct R_SW_Rect
+{
+  Rng2S32 bounds;
+  Vec2F32 origin;
+  Vec2F32 pct_per_px;
+  Vec2F32 half_size;
+  Vec2F32 src_p0;
+  Vec2F32 src_size;
+  Vec4F32 colors[Corner_COUNT];
+  F32 corner_radii[Corner_COUNT];
+  F32 border_thickness;
+  F32 softness;
+  F32 opacity;
+  R_SW_RectFlags flags;
+  R_SW_Tex2D *texture;
+};
+
+typedef struct R_SW_RowParams R_SW_RowParams;
+struct R_SW_RowParams
+{
+  Vec4F32 tint_left;
+  Vec4F32 tint_delta;
+  F32 sdf_y;
+  F32 radius_left;
+  F32 radius_right;
+  F32 src_v;
+};
+
+typedef struct R_SW_UIPassJob R_SW_UIPassJob;
+struct R_SW_UIPassJob
+{
+  R_SW_Window *window;
+  R_SW_Rect *rects;
+  U64 tile_count_x;
+  U64 tile_count_y;
+  U32 *tile_rect_offs;
+  U32 *tile_rect_idxs;
+};
+
+typedef struct R_SW_BlurPassJob R_SW_BlurPassJob;
+struct R_SW_BlurPassJob
+{
+  R_SW_Window *window;
+  Rng2S32 rect;
+  Rng2S32 src_rect;
+  F32 corner_radii[Corner_COUNT];
+  F32 weights[64];
+  U64 weights_count;
+};
+
+////////////////////////////////
+//~ rjf: Job Dispatch Types
+
+typedef void R_SW_JobFunctionType(void *params, U64 idx);
+
+typedef struct R_SW_Job R_SW_Job;
+struct R_SW_Job
+{
+  R_SW_JobFunctionType *func;
+  void *params;
+  U64 count;
+  U64 next_idx;
+  U64 active_worker_count;
+};
+
+typedef struct R_SW_State R_SW_State;
+struct R_SW_State
+{
+  Arena *arena;
+  R_SW_Window *first_free_window;
+  R_SW_Tex2D *first_free_tex2d;
+  R_SW_Tex2D *first_to_free_tex2d;
+  OS_Handle device_rw_mutex;
+  B32 headless;
+
+  // rjf: backups
+  R_Handle backup_texture;
+
+  // rjf: workers
+  U64 worker_count;
+  OS_Handle *workers;
+  OS_Handle job_mutex;
+  OS_Handle job_cv;
+  OS_Handle job_done_cv;
+  U64 job_gen;
+  R_SW_Job *job;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global R_SW_State *r_sw_state = 0;
+global R_SW_Window r_sw_window_nil = {&r_sw_window_nil};
+global R_SW_Tex2D r_sw_tex2d_nil = {&r_sw_tex2d_nil};
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal R_SW_Window *r_sw_window_from_handle(R_Handle handle);
+internal R_Handle r_sw_handle_from_window(R_SW_Window *window);
+internal R_SW_Tex2D *r_sw_tex2d_from_handle(R_Handle handle);
+internal R_Handle r_sw_handle_from_tex2d(R_SW_Tex2D *texture);
+internal U32 r_sw_texel_from_format_data(R_Tex2DFormat format, U8 *data);
+internal Vec4F32 r_sw_sample_tex2d(R_SW_Tex2D *texture, F32 u, F32 v, B32 linear);
+
+////////////////////////////////
+//~ rjf: Job Dispatch
+
+internal void r_sw_job_run(R_SW_Job *job);
+internal void r_sw_parallel_for(R_SW_JobFunctionType *func, void *params, U64 count);
+internal void r_sw_worker_thread__entry_point(void *p);
+
+////////////////////////////////
+//~ rjf: Rasterization
+
+internal F32 r_sw_rect_sdf(F32 x, F32 y, F32 half_size_x, F32 half_size_y, F32 r);
+internal F32 r_sw_smoothstep01(F32 t);
+internal R_SW_RowParams r_sw_row_params_from_rect(R_SW_Rect *rect, F32 pct_y);
+internal void r_sw_rect_fill_row(R_SW_Rect *rect, U32 *row, S32 x_min, S32 x_max, F32 pct_y);
+internal void r_sw_rect_fill_row__scalar(R_SW_Rect *rect, U32 *row, S32 x_min, S32 x_max, F32 pct_y);
+#if R_SW_SIMD_SSE2
+internal void r_sw_rect_fill_row__sse2(R_SW_Rect *rect, U32 *row, S32 x_min, S32 x_max, F32 pct_y);
+#endif
+internal void r_sw_ui_pass_tile_job(void *params, U64 idx);
+internal void r_sw_blur_pass_h_job(void *params, U64 idx);
+internal void r_sw_blur_pass_v_job(void *params, U64 idx);
+
+////////////////////////////////
+//~ rjf: Headless Readback
+
+internal R_SW_Framebuffer r_sw_framebuffer_from_window(Arena *arena, R_Handle window_equip);
+
+#endif // RENDER_SOFTWARE_H
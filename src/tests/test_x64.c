@@ -0,0 +1,361 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_TITLE "test_x64"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "coff/coff.h"
+#include "pe/pe.h"
+#include "rdi_from_dwarf/rdi_elf.h"
+#include "x64/x64.h"
+#include "third_party/udis86/config.h"
+#include "third_party/udis86/udis86.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "x64/x64.c"
+#include "third_party/udis86/libudis86/decode.c"
+#include "third_party/udis86/libudis86/itab.c"
+#include "third_party/udis86/libudis86/syn-att.c"
+#include "third_party/udis86/libudis86/syn-intel.c"
+#include "third_party/udis86/libudis86/syn.c"
+#include "third_party/udis86/libudis86/udis86.c"
+
+// NOTE: Differential test & throughput benchmark for the x64 layer's
+// decoder, against udis86 (which it replaced in the debugger's stepping
+// paths). Runs over the executable sections of any PE or ELF files passed on
+// the command line (or over their raw bytes, for other files):
+//
+//   test_x64 [--every_offset] [--iterations:N] [--max_mismatches:N] <files...>
+//
+// --every_offset decodes starting at every byte, rather than linearly sweeping
+// over instruction boundaries, which mostly exercises garbage encodings.
+
+////////////////////////////////
+//~ rjf: Corpus Types
+
+typedef struct T_CodeRange T_CodeRange;
+struct T_CodeRange
+{
+  T_CodeRange *next;
+  String8 name;
+  String8 data;
+};
+
+typedef struct T_CodeRangeList T_CodeRangeList;
+struct T_CodeRangeList
+{
+  T_CodeRange *first;
+  T_CodeRange *last;
+  U64 count;
+  U64 total_size;
+};
+
+////////////////////////////////
+//~ rjf: Corpus Loading
+
+internal void
+t_code_range_list_push(Arena *arena, T_CodeRangeList *list, String8 name, String8 data)
+{
+  T_CodeRange *n = push_array(arena, T_CodeRange, 1);
+  n->name = name;
+  n->data = data;
+  SLLQueuePush(list->first, list->last, n);
+  list->count += 1;
+  list->total_size += data.size;
+}
+
+internal T_CodeRangeList
+t_code_ranges_from_file_data(Arena *arena, String8 path, String8 data)
+{
+  T_CodeRangeList list = {0};
+  
+  //- rjf: PE => executable sections
+  PE_DosHeader *dos_header = (PE_DosHeader *)data.str;
+  if(data.size >= sizeof(PE_DosHeader) && dos_header->magic == PE_DOS_MAGIC &&
+     dos_header->coff_file_offset + sizeof(U32) + sizeof(COFF_Header) <= data.size &&
+     *(U32 *)(data.str + dos_header->coff_file_offset) == PE_MAGIC)
+  {
+    U64 coff_header_off = dos_header->coff_file_offset + sizeof(U32);
+    COFF_Header *coff_header = (COFF_Header *)(data.str + coff_header_off);
+    U64 sections_off = coff_header_off + sizeof(COFF_Header) + coff_header->optional_header_size;
+    for(U64 idx = 0; idx < coff_header->section_count; idx += 1)
+    {
+      U64 section_off = sections_off + idx*sizeof(COFF_SectionHeader);
+      if(section_off + sizeof(COFF_SectionHeader) > data.size)
+      {
+        break;
+      }
+      COFF_SectionHeader *section = (COFF_SectionHeader *)(data.str + section_off);
+      if(section->flags & COFF_SectionFlag_MEM_EXECUTE)
+      {
+        Rng1U64 range = r1u64(section->foff, section->foff + Min(section->fsize, section->vsize));
+        String8 section_name = str8_cstring_capped(section->name, section->name + sizeof(section->name));
+        String8 name = push_str8f(arena, "%S:%S", path, section_name);
+        t_code_range_list_push(arena, &list, name, str8_substr(data, range));
+      }
+    }
+  }
+  
+  //- rjf: ELF64 => executable sections
+  else if(data.size >= sizeof(ELF_Ehdr64) && MemoryMatch(data.str, "\x7f" "ELF", 4) && data.str[4] == 2)
+  {
+    ELF_Ehdr64 *header = (ELF_Ehdr64 *)data.str;
+    for(U64 idx = 0; idx < header->e_shnum; idx += 1)
+    {
+      U64 section_off = header->e_shoff + idx*header->e_shentsize;
+      if(section_off + sizeof(ELF_Shdr64) > data.size)
+      {
+        break;
+      }
+      ELF_Shdr64 *section = (ELF_Shdr64 *)(data.str + section_off);
+      if(section->sh_flags & ELF_SectionAttributeFlag_EXECINSTR && section->sh_type != ELF_SectionType_NOBITS)
+      {
+        Rng1U64 range = r1u64(section->sh_offset, section->sh_offset + section->sh_size);
+        String8 name = push_str8f(arena, "%S:section_%I64u", path, idx);
+        t_code_range_list_push(arena, &list, name, str8_substr(data, range));
+      }
+    }
+  }
+  
+  //- rjf: anything else => raw bytes
+  else
+  {
+    t_code_range_list_push(arena, &list, path, data);
+  }
+  
+  return list;
+}
+
+////////////////////////////////
+//~ rjf: udis86 Reference
+
+internal X64_Inst
+t_inst_from_udis86(struct ud *ud, U64 start_voff, String8 code)
+{
+  ud_init(ud);
+  ud_set_mode(ud, 64);
+  ud_set_pc(ud, start_voff);
+  ud_set_input_buffer(ud, code.str, code.size);
+  ud_set_vendor(ud, UD_VENDOR_ANY);
+  ud_set_syntax(ud, UD_SYN_INTEL);
+  X64_Inst inst = {0};
+  inst.size = ud_disassemble(ud);
+  enum ud_mnemonic_code mnemonic = ud_insn_mnemonic(ud);
+  
+  //- rjf: flow kind
+  switch(mnemonic)
+  {
+    default:{inst.flags |= X64_InstFlag_NonFlow;}break;
+    case UD_Iinvalid:{inst.flags |= X64_InstFlag_NonFlow|X64_InstFlag_Invalid;}break;
+    case UD_Icall:{inst.flags |= X64_InstFlag_Call;}break;
+    case UD_Ijmp:{inst.flags |= X64_InstFlag_UnconditionalJump;}break;
+    case UD_Iret: case UD_Iretf:{inst.flags |= X64_InstFlag_Return;}break;
+    case UD_Ija: case UD_Ijae: case UD_Ijb: case UD_Ijbe: case UD_Ijcxz: case UD_Ijecxz:
+    case UD_Ijg: case UD_Ijge: case UD_Ijl: case UD_Ijle: case UD_Ijno: case UD_Ijnp:
+    case UD_Ijns: case UD_Ijnz: case UD_Ijo: case UD_Ijp: case UD_Ijrcxz: case UD_Ijs:
+    case UD_Ijz: case UD_Iloop: case UD_Iloope: case UD_Iloopne:
+    {
+      inst.flags |= X64_InstFlag_Branch;
+    }break;
+  }
+  
+  //- rjf: relative targets
+  struct ud_operand *op0 = (struct ud_operand *)ud_insn_opr(ud, 0);
+  struct ud_operand *op1 = (struct ud_operand *)ud_insn_opr(ud, 1);
+  if(op0 != 0 && op0->type == UD_OP_JIMM)
+  {
+    inst.rel_voff = ud_syn_rel_target(ud, op0);
+  }
+  
+  //- rjf: stack pointer changes; note that, unlike the debugger's original
+  // udis86 path, this sign-extends 8-bit immediates, & only considers rep
+  // prefixes on string instructions, as the x64 decoder does
+  if(op0 != 0 && op1 != 0 && op0->type == UD_OP_REG && op0->base == UD_R_RSP)
+  {
+    inst.flags |= X64_InstFlag_ChangesStackPointer;
+    if(op1->type == UD_OP_IMM && (mnemonic == UD_Iadd || mnemonic == UD_Isub))
+    {
+      S64 imm = (op1->size == 8) ? (S64)op1->lval.sbyte : (op1->size == 16) ? (S64)op1->lval.sword : (S64)op1->lval.sdword;
+      inst.sp_delta = (mnemonic == UD_Iadd) ? +imm : -imm;
+    }
+    else
+    {
+      inst.flags |= X64_InstFlag_ChangesStackPointerVariably;
+    }
+  }
+  if(mnemonic == UD_Ipush)
+  {
+    inst.flags |= X64_InstFlag_ChangesStackPointer;
+    inst.sp_delta = -8;
+  }
+  else if(mnemonic == UD_Ipop)
+  {
+    inst.flags |= X64_InstFlag_ChangesStackPointer;
+    inst.sp_delta = +8;
+  }
+  if(ud->pfx_rep != 0 || ud->pfx_repe != 0 || ud->pfx_repne != 0)
+  {
+    switch(mnemonic)
+    {
+      default:{}break;
+      case UD_Imovsb: case UD_Imovsw: case UD_Imovsd: case UD_Imovsq:
+      case UD_Istosb: case UD_Istosw: case UD_Istosd: case UD_Istosq:
+      case UD_Ilodsb: case UD_Ilodsw: case UD_Ilodsd: case UD_Ilodsq:
+      case UD_Iscasb: case UD_Iscasw: case UD_Iscasd: case UD_Iscasq:
+      case UD_Icmpsb: case UD_Icmpsw: case UD_Icmpsd: case UD_Icmpsq:
+      case UD_Iinsb:  case UD_Iinsw:  case UD_Iinsd:
+      case UD_Ioutsb: case UD_Ioutsw: case UD_Ioutsd:
+      {
+        inst.flags |= X64_InstFlag_Repeats;
+      }break;
+    }
+  }
+  return inst;
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Arena *arena = arena_alloc();
+  B32 every_offset = cmd_line_has_flag(cmd_line, str8_lit("every_offset"));
+  U64 iterations = 8;
+  U64 max_mismatches = 32;
+  try_u64_from_str8_c_rules(cmd_line_string(cmd_line, str8_lit("iterations")), &iterations);
+  try_u64_from_str8_c_rules(cmd_line_string(cmd_line, str8_lit("max_mismatches")), &max_mismatches);
+  
+  String8List out = {0};
+  String8List errors = {0};
+  
+  //- rjf: gather corpus
+  T_CodeRangeList ranges = {0};
+  for(String8Node *n = cmd_line->inputs.first; n != 0; n = n->next)
+  {
+    String8 data = os_data_from_file_path(arena, n->string);
+    if(data.size == 0)
+    {
+      str8_list_pushf(arena, &errors, "could not read %S\n", n->string);
+      continue;
+    }
+    T_CodeRangeList file_ranges = t_code_ranges_from_file_data(arena, n->string, data);
+    for(T_CodeRange *r = file_ranges.first; r != 0; r = r->next)
+    {
+      t_code_range_list_push(arena, &ranges, r->name, r->data);
+    }
+  }
+  if(ranges.count == 0)
+  {
+    str8_list_pushf(arena, &errors, "usage: test_x64 [--every_offset] [--iterations:N] [--max_mismatches:N] <files...>\n");
+  }
+  
+  //- rjf: differential test
+  struct ud ud = {0};
+  U64 compared_count = 0;
+  U64 skipped_count = 0;
+  U64 mismatch_count = 0;
+  for(T_CodeRange *r = ranges.first; r != 0; r = r->next)
+  {
+    for(U64 off = 0; off < r->data.size;)
+    {
+      String8 code = str8_skip(r->data, off);
+      X64_Inst ref = t_inst_from_udis86(&ud, off, code);
+      X64_Inst inst = x64_inst_from_machine_code(off, code);
+      
+      // rjf: udis86 does not know newer encodings (BMI, AVX-512, ...), so
+      // only compare where it produced a valid instruction
+      if(ref.flags & X64_InstFlag_Invalid)
+      {
+        skipped_count += 1;
+      }
+      else
+      {
+        compared_count += 1;
+        if(ref.size != inst.size || ref.flags != inst.flags || ref.rel_voff != inst.rel_voff || ref.sp_delta != inst.sp_delta)
+        {
+          mismatch_count += 1;
+          if(mismatch_count <= max_mismatches)
+          {
+            String8List bytes_strs = {0};
+            for(U64 idx = 0; idx < Min(code.size, 15); idx += 1)
+            {
+              str8_list_pushf(arena, &bytes_strs, "%02x", code.str[idx]);
+            }
+            StringJoin join = {0};
+            join.sep = str8_lit(" ");
+            String8 bytes_str = str8_list_join(arena, &bytes_strs, &join);
+            str8_list_pushf(arena, &errors, "mismatch at %S+0x%I64x [%S] `%s`\n", r->name, off, bytes_str, ud_insn_asm(&ud));
+            str8_list_pushf(arena, &errors, "  udis86: size=%I64u flags=0x%x rel=0x%I64x sp=%I64d\n", ref.size, ref.flags, ref.rel_voff, ref.sp_delta);
+            str8_list_pushf(arena, &errors, "  x64:    size=%I64u flags=0x%x rel=0x%I64x sp=%I64d\n", inst.size, inst.flags, inst.rel_voff, inst.sp_delta);
+          }
+        }
+      }
+      off += every_offset ? 1 : Max(ref.size, 1);
+    }
+  }
+  str8_list_pushf(arena, &out, "differential: %I64u compared, %I64u skipped (invalid to udis86), %I64u mismatched\n", compared_count, skipped_count, mismatch_count);
+  
+  //- rjf: throughput benchmark - linear sweeps, decoding as the stepping paths do
+  {
+    U64 inst_count = 0;
+    U64 x64_begin_us = os_now_microseconds();
+    for(U64 iteration_idx = 0; iteration_idx < iterations; iteration_idx += 1)
+    {
+      for(T_CodeRange *r = ranges.first; r != 0; r = r->next)
+      {
+        for(U64 off = 0; off < r->data.size;)
+        {
+          X64_Inst inst = x64_inst_from_machine_code(off, str8_skip(r->data, off));
+          off += inst.size;
+          inst_count += 1;
+        }
+      }
+    }
+    U64 x64_us = os_now_microseconds() - x64_begin_us;
+    U64 ud_inst_count = 0;
+    U64 ud_begin_us = os_now_microseconds();
+    for(U64 iteration_idx = 0; iteration_idx < iterations; iteration_idx += 1)
+    {
+      for(T_CodeRange *r = ranges.first; r != 0; r = r->next)
+      {
+        for(U64 off = 0; off < r->data.size;)
+        {
+          X64_Inst inst = t_inst_from_udis86(&ud, off, str8_skip(r->data, off));
+          off += Max(inst.size, 1);
+          ud_inst_count += 1;
+        }
+      }
+    }
+    U64 ud_us = os_now_microseconds() - ud_begin_us;
+    F64 total_mb = (F64)(ranges.total_size*iterations) / (F64)MB(1);
+    str8_list_pushf(arena, &out, "x64:    %I64u insts in %I64u us (%.2f ns/inst, %.1f MB/s)\n", inst_count, x64_us, 1000.0*x64_us/Max(inst_count, 1), total_mb/((F64)Max(x64_us, 1)/1000000.0));
+    str8_list_pushf(arena, &out, "udis86: %I64u insts in %I64u us (%.2f ns/inst, %.1f MB/s)\n", ud_inst_count, ud_us, 1000.0*ud_us/Max(ud_inst_count, 1), total_mb/((F64)Max(ud_us, 1)/1000000.0));
+  }
+  
+  //- rjf: dump output
+  for(String8Node *n = errors.first; n != 0; n = n->next)
+  {
+    fwrite(n->string.str, 1, n->string.size, stderr);
+  }
+  for(String8Node *n = out.first; n != 0; n = n->next)
+  {
+    fwrite(n->string.str, 1, n->string.size, stdout);
+  }
+  os_exit_process((ranges.count != 0 && mismatch_count == 0) ? 0 : 1);
+}
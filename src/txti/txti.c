@@ -90,6 +90,136 @@ txti_msg_list_deep_copy(Arena *arena, TXTI_MsgList *src)
   return dst;
 }
 
+internal void
+txti_msg_list_coalesce_appends_in_place(Arena *arena, TXTI_MsgList *msgs)
+{
+  for(TXTI_MsgNode *n = msgs->first; n != 0; n = n->next)
+  {
+    if(n->v.kind == TXTI_MsgKind_Append &&
+       n->next != 0 &&
+       n->next->v.kind == TXTI_MsgKind_Append &&
+       MemoryMatchStruct(&n->v.handle, &n->next->v.handle))
+    {
+      String8List strings = {0};
+      str8_list_push(arena, &strings, n->v.string);
+      for(;n->next != 0 &&
+          n->next->v.kind == TXTI_MsgKind_Append &&
+          MemoryMatchStruct(&n->v.handle, &n->next->v.handle);)
+      {
+        str8_list_push(arena, &strings, n->next->v.string);
+        if(msgs->last == n->next)
+        {
+          msgs->last = n;
+        }
+        n->next = n->next->next;
+        msgs->count -= 1;
+      }
+      n->v.string = str8_list_join(arena, &strings, 0);
+    }
+  }
+}
+
+////////////////////////////////
+//~ rjf: Buffer Analysis Functions
+
+internal void
+txti_buffer_parse_lines_from_line_idx(TXTI_Buffer *buffer, U64 line_idx, U64 *bytes_processed_counter)
+{
+  //- rjf: drop line ranges at & after line_idx
+  U64 start_off = 0;
+  if(line_idx < buffer->lines_count)
+  {
+    start_off = buffer->lines_ranges[line_idx].min;
+    arena_put_back(buffer->lines_arena, sizeof(Rng1U64)*(buffer->lines_count-line_idx));
+    buffer->lines_count = line_idx;
+  }
+  if(buffer->lines_count == 0)
+  {
+    arena_clear(buffer->lines_arena);
+    buffer->lines_ranges = 0;
+    buffer->lines_max_size = 0;
+    start_off = 0;
+  }
+  
+  //- rjf: parse & push line ranges for the rest of the data
+  U64 line_start_idx = start_off;
+  U64 byte_process_start_idx = start_off;
+  for(U64 idx = start_off; idx <= buffer->data.size; idx += 1)
+  {
+    if(bytes_processed_counter != 0 && idx-byte_process_start_idx >= 1000)
+    {
+      ins_atomic_u64_add_eval(bytes_processed_counter, (idx-byte_process_start_idx));
+      byte_process_start_idx = idx;
+    }
+    if(idx == buffer->data.size || buffer->data.str[idx] == '\n' || buffer->data.str[idx] == '\r')
+    {
+      Rng1U64 *line_range = push_array_no_zero(buffer->lines_arena, Rng1U64, 1);
+      if(buffer->lines_ranges == 0)
+      {
+        buffer->lines_ranges = line_range;
+      }
+      *line_range = r1u64(line_start_idx, idx);
+      buffer->lines_count += 1;
+      buffer->lines_max_size = Max(buffer->lines_max_size, dim_1u64(*line_range));
+      if(idx+1 < buffer->data.size && buffer->data.str[idx] == '\r' && buffer->data.str[idx+1] == '\n')
+      {
+        idx += 1;
+      }
+      line_start_idx = idx+1;
+    }
+  }
+  if(bytes_processed_counter != 0)
+  {
+    ins_atomic_u64_add_eval(bytes_processed_counter, (buffer->data.size-byte_process_start_idx));
+  }
+}
+
+internal void
+txti_buffer_lex_from_off(TXTI_Buffer *buffer, U64 off, TXT_LangLexFunctionType *lex_function, U64 *bytes_processed_counter)
+{
+  //- rjf: drop tokens which end at or after off - a token ending exactly at
+  // off may be extended by the new data, and lexing restarts at the earliest
+  // dropped token, so that tokens spanning lines (e.g. block comments) which
+  // were unterminated in the old data are lexed again whole
+  U64 lex_off = off;
+  U64 keep_count = buffer->tokens.count;
+  for(;keep_count != 0; keep_count -= 1)
+  {
+    TXT_Token *token = &buffer->tokens.v[keep_count-1];
+    if(token->range.max < off)
+    {
+      break;
+    }
+    lex_off = Min(lex_off, token->range.min);
+  }
+  arena_put_back(buffer->tokens_arena, sizeof(TXT_Token)*(buffer->tokens.count-keep_count));
+  buffer->tokens.count = keep_count;
+  if(buffer->tokens.count == 0)
+  {
+    arena_clear(buffer->tokens_arena);
+    buffer->tokens.v = 0;
+  }
+  
+  //- rjf: lex the rest of the data, push rebased tokens
+  if(lex_function != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    TXT_TokenArray tokens = lex_function(scratch.arena, bytes_processed_counter, str8_skip(buffer->data, lex_off));
+    TXT_Token *dst = push_array_no_zero(buffer->tokens_arena, TXT_Token, tokens.count);
+    for(U64 idx = 0; idx < tokens.count; idx += 1)
+    {
+      dst[idx].kind  = tokens.v[idx].kind;
+      dst[idx].range = shift_1u64(tokens.v[idx].range, lex_off);
+    }
+    if(buffer->tokens.v == 0)
+    {
+      buffer->tokens.v = dst;
+    }
+    buffer->tokens.count += tokens.count;
+    scratch_end(scratch);
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Entities API
 
@@ -147,7 +277,8 @@ txti_handle_from_path(String8 path)
         {
           TXTI_Buffer *buffer = &entity->buffers[idx];
           buffer->data_arena = arena_alloc__sized(GB(32), KB(64));
-          buffer->analysis_arena = arena_alloc__sized(GB(32), KB(64));
+          buffer->lines_arena = arena_alloc__sized(GB(32), KB(64));
+          buffer->tokens_arena = arena_alloc__sized(GB(32), KB(64));
           buffer->data_arena->align = 1;
         }
         SLLQueuePush(slot->first, slot->last, entity);
@@ -588,6 +719,10 @@ txti_mut_thread_entry_point(void *p)
       os_condition_variable_wait(mut_thread->msg_cv, mut_thread->msg_mutex, max_U64);
     }
     
+    //- rjf: coalesce bursts of appends to the same buffer, so that each burst
+    // is applied (and analyzed) once
+    txti_msg_list_coalesce_appends_in_place(scratch.arena, &msgs);
+    
     //- rjf: process msgs
     for(TXTI_MsgNode *msg_n = msgs.first; msg_n != 0; msg_n = msg_n->next) ProfScope("process msg")
     {
@@ -671,6 +806,10 @@ txti_mut_thread_entry_point(void *p)
             ins_atomic_u64_eval_assign(&entity->bytes_processed, 0);
             ins_atomic_u64_eval_assign(&entity->bytes_to_process, file_contents.size + !!lex_function*file_contents.size);
           }
+          if(msg->kind == TXTI_MsgKind_Append)
+          {
+            lex_function = txt_lex_function_from_lang_kind(entity->lang_kind);
+          }
         }
       }
       
@@ -740,12 +879,22 @@ txti_mut_thread_entry_point(void *p)
             {
               TXTI_Buffer *buffer = &entity->buffers[(initial_buffer_apply_gen+1+buffer_apply_idx)%TXTI_ENTITY_BUFFER_COUNT];
               
-              // rjf: clear old analysis data
-              arena_clear(buffer->analysis_arena);
-              buffer->lines_count = 0;
-              buffer->lines_ranges = 0;
-              buffer->lines_max_size = 0;
-              MemoryZeroStruct(&buffer->tokens);
+              U64 *bytes_processed_counter = (buffer_apply_idx == 0 ? &entity->bytes_processed : 0);
+              
+              // rjf: determine first line to re-analyze - appends only touch
+              // the last (unterminated) line of the old data, & the line
+              // before it if the old data ended with a '\r', which may now
+              // begin a '\r\n'
+              U64 reparse_line_idx = 0;
+              if(msg->kind == TXTI_MsgKind_Append && buffer->lines_count != 0)
+              {
+                reparse_line_idx = buffer->lines_count-1;
+                if(reparse_line_idx != 0 && buffer->data.size != 0 && buffer->data.str[buffer->data.size-1] == '\r')
+                {
+                  reparse_line_idx -= 1;
+                }
+              }
+              U64 reparse_off = (reparse_line_idx < buffer->lines_count ? buffer->lines_ranges[reparse_line_idx].min : 0);
               
               // rjf: perform edit to buffer data
               switch(msg->kind)
@@ -782,57 +931,13 @@ txti_mut_thread_entry_point(void *p)
               // rjf: parse & store line range info
               ProfScope("parse & store line range info")
               {
-                // rjf: count # of lines
-                U64 line_count = 1;
-                U64 byte_process_start_idx = 0;
-                for(U64 idx = 0; idx < buffer->data.size; idx += 1)
-                {
-                  if(buffer_apply_idx == 0 && idx-byte_process_start_idx >= 1000)
-                  {
-                    ins_atomic_u64_add_eval(&entity->bytes_processed, (idx-byte_process_start_idx));
-                    byte_process_start_idx = idx;
-                  }
-                  if(buffer->data.str[idx] == '\n' || buffer->data.str[idx] == '\r')
-                  {
-                    line_count += 1;
-                    if(buffer->data.str[idx] == '\r')
-                    {
-                      idx += 1;
-                    }
-                  }
-                }
-                
-                // rjf: allocate & store line ranges
-                ProfScope("allocate & store line ranges")
-                {
-                  buffer->lines_count = line_count;
-                  buffer->lines_ranges = push_array_no_zero(buffer->analysis_arena, Rng1U64, buffer->lines_count);
-                  U64 line_idx = 0;
-                  U64 line_start_idx = 0;
-                  for(U64 idx = 0; idx <= buffer->data.size; idx += 1)
-                  {
-                    if(idx == buffer->data.size || buffer->data.str[idx] == '\n' || buffer->data.str[idx] == '\r')
-                    {
-                      Rng1U64 line_range = r1u64(line_start_idx, idx);
-                      U64 line_size = dim_1u64(line_range);
-                      buffer->lines_ranges[line_idx] = line_range;
-                      buffer->lines_max_size = Max(buffer->lines_max_size, line_size);
-                      line_idx += 1;
-                      line_start_idx = idx+1;
-                      if(idx < buffer->data.size && buffer->data.str[idx] == '\r')
-                      {
-                        line_start_idx += 1;
-                        idx += 1;
-                      }
-                    }
-                  }
-                }
+                txti_buffer_parse_lines_from_line_idx(buffer, reparse_line_idx, bytes_processed_counter);
               }
               
               // rjf: lex file contents
-              if(lex_function != 0) ProfScope("lex text")
+              ProfScope("lex text")
               {
-                buffer->tokens = lex_function(buffer->analysis_arena, buffer_apply_idx == 0 ? &entity->bytes_processed : 0, buffer->data);
+                txti_buffer_lex_from_off(buffer, reparse_off, lex_function, bytes_processed_counter);
               }
               
               // rjf: mark final process counter
@@ -65,8 +65,12 @@ typedef struct TXTI_Buffer TXTI_Buffer;
 struct TXTI_Buffer
 {
   // rjf: arenas
+  // NOTE: lines_arena & tokens_arena only hold the lines_ranges & tokens
+  // arrays, so both arrays can be extended (or truncated) in place when text
+  // is appended, rather than being rebuilt from scratch.
   Arena *data_arena;
-  Arena *analysis_arena;
+  Arena *lines_arena;
+  Arena *tokens_arena;
   
   // rjf: raw textual data
   String8 data;
@@ -251,6 +255,13 @@ internal U64 txti_hash_from_string(String8 string);
 internal void txti_msg_list_push(Arena *arena, TXTI_MsgList *msgs, TXTI_Msg *msg);
 internal void txti_msg_list_concat_in_place(TXTI_MsgList *dst, TXTI_MsgList *src);
 internal TXTI_MsgList txti_msg_list_deep_copy(Arena *arena, TXTI_MsgList *src);
+internal void txti_msg_list_coalesce_appends_in_place(Arena *arena, TXTI_MsgList *msgs);
+
+////////////////////////////////
+//~ rjf: Buffer Analysis Functions
+
+internal void txti_buffer_parse_lines_from_line_idx(TXTI_Buffer *buffer, U64 line_idx, U64 *bytes_processed_counter);
+internal void txti_buffer_lex_from_off(TXTI_Buffer *buffer, U64 off, TXT_LangLexFunctionType *lex_function, U64 *bytes_processed_counter);
 
 ////////////////////////////////
 //~ rjf: Entities API
@@ -1120,10 +1120,17 @@ ui_end_build(void)
   //- rjf: layout box tree
   {
     ProfBegin("ui box tree layout");
+    U64 layout_begin_us = os_now_microseconds();
+    ui_layout_hash_finish(ui_state->root);
     for(Axis2 axis = (Axis2)0; axis < Axis2_COUNT; axis = (Axis2)(axis + 1))
     {
+      ui_state->layout_reused_box_count[axis] = 0;
+      ui_state->last_layout_cache[axis] = ui_state->layout_cache[axis];
+      ui_state->layout_cache[axis] = 0;
       ui_layout_root(ui_state->root, axis);
+      ui_state->last_build_layout_reused_box_count[axis] = ui_state->layout_reused_box_count[axis];
     }
+    ui_state->last_build_layout_us = os_now_microseconds() - layout_begin_us;
     ProfEnd();
   }
   
@@ -1506,8 +1513,8 @@ ui_calc_sizes_standalone__in_place_rec(UI_Box *root, Axis2 axis)
     }break;
   }
   
-  //- rjf: recurse
-  for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+  //- rjf: recurse (unless this subtree may take the last build's sizes)
+  for(UI_Box *child = root->first; !ui_box_is_nil(child) && root->layout_reuse[axis] == 0; child = child->next)
   {
     ui_calc_sizes_standalone__in_place_rec(child, axis);
   }
@@ -1550,8 +1557,24 @@ ui_calc_sizes_upwards_dependent__in_place_rec(UI_Box *root, Axis2 axis)
     }break;
   }
   
-  //- rjf: recurse
-  for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+  //- rjf: retained layout: if the subtree's children size off of root, and
+  // root's size changed since the last build, the subtree must be resolved
+  if(root->layout_reuse[axis] != 0 &&
+     (root->flags & (UI_BoxFlag_FixedWidth<<axis) ||
+      root->pref_size[axis].kind == UI_SizeKind_Pixels ||
+      root->pref_size[axis].kind == UI_SizeKind_TextContent ||
+      root->pref_size[axis].kind == UI_SizeKind_ParentPct) &&
+     root->fixed_size.v[axis] != root->layout_reuse[axis]->pre_size)
+  {
+    root->layout_reuse[axis] = 0;
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+    {
+      ui_calc_sizes_standalone__in_place_rec(child, axis);
+    }
+  }
+  
+  //- rjf: recurse (unless this subtree may take the last build's sizes)
+  for(UI_Box *child = root->first; !ui_box_is_nil(child) && root->layout_reuse[axis] == 0; child = child->next)
   {
     ui_calc_sizes_upwards_dependent__in_place_rec(child, axis);
   }
@@ -1562,6 +1585,14 @@ ui_calc_sizes_upwards_dependent__in_place_rec(UI_Box *root, Axis2 axis)
 internal void
 ui_calc_sizes_downwards_dependent__in_place_rec(UI_Box *root, Axis2 axis)
 {
+  //- rjf: retained layout: subtree may take the last build's sizes -> take
+  // root's pre-constraint size from it, & skip the subtree
+  if(root->layout_reuse[axis] != 0)
+  {
+    root->fixed_size.v[axis] = root->layout_pre_size = root->layout_reuse[axis]->pre_size;
+    return;
+  }
+  
   ProfBeginFunction();
   
   //- rjf: recurse first. we may depend on children that have
@@ -1600,12 +1631,22 @@ ui_calc_sizes_downwards_dependent__in_place_rec(UI_Box *root, Axis2 axis)
     }break;
   }
   
+  //- rjf: store pre-constraint size, for the retained layout cache
+  root->layout_pre_size = root->fixed_size.v[axis];
+  
   ProfEnd();
 }
 
 internal void
 ui_layout_enforce_constraints__in_place_rec(UI_Box *root, Axis2 axis)
 {
+  //- rjf: retained layout: subtree given same size as in the last build ->
+  // it takes all of the last build's final sizes, so skip it
+  if(root->layout_reuse[axis] != 0 && ui_layout_cache_reuse(root, axis))
+  {
+    return;
+  }
+  
   ProfBeginFunction();
   Temp scratch = scratch_begin(0, 0);
   
@@ -1712,8 +1753,21 @@ ui_layout_enforce_constraints__in_place_rec(UI_Box *root, Axis2 axis)
 internal void
 ui_layout_position__in_place_rec(UI_Box *root, Axis2 axis)
 {
+  //- rjf: retained layout: subtree took the last build's sizes -> take its
+  // positions too
+  if(root->layout_apply != 0)
+  {
+    UI_LayoutCacheNode *node = root->layout_apply;
+    root->layout_apply = 0;
+    ui_state->layout_reused_box_count[axis] += node->box_count;
+    ui_layout_cache_apply__in_place_rec(root, axis, ui_state->last_layout_cache[axis]->boxes, node->first_box_idx);
+    return;
+  }
+  
   ProfBeginFunction();
   F32 layout_position = 0;
+  root->layout_reuse[axis] = 0;
+  UI_LayoutCacheBox *record = ui_layout_cache_record(root, axis);
   
   //- rjf: lay out children
   F32 bounds = 0;
@@ -1766,6 +1820,10 @@ ui_layout_position__in_place_rec(UI_Box *root, Axis2 axis)
   //- rjf: store view bounds
   {
     root->view_bounds.v[axis] = bounds;
+    if(record != 0)
+    {
+      record->view_bounds = bounds;
+    }
   }
   
   //- rjf: recurse
@@ -1777,15 +1835,273 @@ ui_layout_position__in_place_rec(UI_Box *root, Axis2 axis)
   ProfEnd();
 }
 
+internal void
+ui_layout_hash_finish(UI_Box *box)
+{
+  if(ui_box_is_nil(box) || box->layout_hash_done)
+  {
+    return;
+  }
+  
+  //- rjf: finish last child first - earlier children were finished as their
+  // next siblings were built, & are already folded into box's children hash
+  ui_layout_hash_finish(box->last);
+  
+  //- rjf: fold in everything the sizing & constraint passes read from box
+  for(Axis2 axis = (Axis2)0; axis < Axis2_COUNT; axis = (Axis2)(axis + 1))
+  {
+    UI_Size size = box->pref_size[axis];
+    B32 box_is_fixed = (box->flags & (UI_BoxFlag_FixedWidth<<axis) ||
+                        size.kind == UI_SizeKind_Pixels ||
+                        size.kind == UI_SizeKind_TextContent ||
+                        size.kind == UI_SizeKind_ParentPct);
+    U64 hash = box->layout_children_hash[axis];
+    {
+      struct
+      {
+        U64 flags;
+        U64 child_count;
+        U32 size_kind;
+        F32 size_value;
+        F32 size_strictness;
+        F32 incoming_size;
+        F32 text_size;
+        B32 is_layout_axis;
+      }
+      inputs;
+      MemoryZeroStruct(&inputs);
+      inputs.flags           = box->flags & ((UI_BoxFlag_FixedWidth|UI_BoxFlag_FloatingX|UI_BoxFlag_AllowOverflowX)<<axis);
+      inputs.child_count     = box->child_count;
+      inputs.size_kind       = size.kind;
+      inputs.size_value      = size.value;
+      inputs.size_strictness = size.strictness;
+      inputs.incoming_size   = (size.kind == UI_SizeKind_Null) ? box->fixed_size.v[axis] : 0;
+      inputs.text_size       = (size.kind == UI_SizeKind_TextContent) ? box->display_string_runs.dim.x : 0;
+      inputs.is_layout_axis  = (box->child_layout_axis == axis);
+      hash = ui_hash_from_string(hash, str8_struct(&inputs));
+    }
+    
+    // NOTE: a subtree is "open" if a parent-percentage size within it
+    // searches for its fixed-size parent above the subtree's root. only closed
+    // subtrees can be cached, as their sizes depend only on their own inputs &
+    // the size their root is given.
+    B32 escapes = (box->layout_children_open[axis] && !box_is_fixed);
+    B32 open = (size.kind == UI_SizeKind_ParentPct || escapes);
+    
+    //- rjf: store; find the last build's results for this subtree, if any
+    box->layout_hash[axis] = hash;
+    box->layout_cacheable[axis] = (!escapes && !box->layout_hash_invalid &&
+                                   box->layout_box_count >= UI_LAYOUT_CACHE_MIN_BOX_COUNT &&
+                                   !ui_key_match(box->key, ui_key_zero()));
+    UI_LayoutCache *last_cache = ui_state->layout_cache[axis];
+    if(box->layout_cacheable[axis] && last_cache != 0)
+    {
+      U64 slot_idx = box->key.u64[0] % last_cache->slots_count;
+      for(UI_LayoutCacheNode *n = last_cache->slots[slot_idx].first; n != 0; n = n->hash_next)
+      {
+        if(ui_key_match(n->key, box->key))
+        {
+          if(n->hash == hash && n->box_count == box->layout_box_count)
+          {
+            box->layout_reuse[axis] = n;
+          }
+          break;
+        }
+      }
+    }
+    
+    //- rjf: fold into parent
+    if(!ui_box_is_nil(box->parent))
+    {
+      box->parent->layout_children_hash[axis] = ui_hash_from_string(box->parent->layout_children_hash[axis], str8_struct(&hash));
+      box->parent->layout_children_open[axis] = (box->parent->layout_children_open[axis] || open);
+    }
+  }
+  if(!ui_box_is_nil(box->parent))
+  {
+    box->parent->layout_box_count += box->layout_box_count;
+  }
+  box->layout_hash_done = 1;
+}
+
+internal void
+ui_layout_hash_invalidate(UI_Box *box)
+{
+  for(UI_Box *b = box; !ui_box_is_nil(b) && !b->layout_hash_invalid; b = b->parent)
+  {
+    b->layout_hash_invalid = 1;
+    MemoryZeroArray(b->layout_cacheable);
+    MemoryZeroArray(b->layout_reuse);
+  }
+}
+
+internal void
+ui_layout_cache_apply_sizes__in_place_rec(UI_Box *root, Axis2 axis, UI_LayoutCacheBox *boxes, U64 *box_idx)
+{
+  root->fixed_size.v[axis] = boxes[*box_idx].final_size;
+  root->layout_pre_size = boxes[*box_idx].pre_size;
+  root->layout_reuse[axis] = 0;
+  *box_idx += 1;
+  for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+  {
+    ui_layout_cache_apply_sizes__in_place_rec(child, axis, boxes, box_idx);
+  }
+}
+
+internal void
+ui_layout_cache_apply__in_place_rec(UI_Box *root, Axis2 axis, UI_LayoutCacheBox *boxes, U64 box_idx)
+{
+  UI_LayoutCacheBox *src = &boxes[box_idx];
+  root->layout_pre_size = src->pre_size;
+  root->layout_reuse[axis] = 0;
+  
+  //- rjf: take children's sizes; check whether their positions relative to
+  // root are unchanged - they are, unless root scrolled or a child moves on
+  // its own
+  B32 positions_match = (root->view_off.v[axis] == src->view_off);
+  {
+    U64 child_idx = box_idx+1;
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child_idx += child->layout_box_count, child = child->next)
+    {
+      UI_LayoutCacheBox *child_src = &boxes[child_idx];
+      child->fixed_size.v[axis] = child_src->final_size;
+      if(child->flags & (UI_BoxFlag_AnimatePosX<<axis) ||
+         (child->flags & (UI_BoxFlag_FloatingX<<axis) && child->fixed_position.v[axis] != child_src->fixed_position))
+      {
+        positions_match = 0;
+      }
+    }
+  }
+  
+  //- rjf: positions changed -> take the rest of the subtree's sizes, & position
+  // it normally
+  if(!positions_match)
+  {
+    U64 sizes_idx = box_idx;
+    ui_layout_cache_apply_sizes__in_place_rec(root, axis, boxes, &sizes_idx);
+    ui_layout_position__in_place_rec(root, axis);
+  }
+  
+  //- rjf: positions unchanged -> move children's last-build rects along with
+  // root, & do the same within each child
+  else
+  {
+    F32 shift = root->rect.p0.v[axis] - src->p0;
+    root->view_bounds.v[axis] = src->view_bounds;
+    ui_layout_cache_record(root, axis);
+    U64 child_idx = box_idx+1;
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child_idx += child->layout_box_count, child = child->next)
+    {
+      UI_LayoutCacheBox *child_src = &boxes[child_idx];
+      F32 original_position = Min(child->rect.p0.v[axis], child->rect.p1.v[axis]);
+      child->fixed_position.v[axis] = child_src->fixed_position;
+      child->rect.p0.v[axis] = child_src->p0 + shift;
+      child->rect.p1.v[axis] = child_src->p1 + shift;
+      F32 new_position = Min(child->rect.p0.v[axis], child->rect.p1.v[axis]);
+      child->position_delta.v[axis] = new_position - original_position;
+    }
+    child_idx = box_idx+1;
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child_idx += child->layout_box_count, child = child->next)
+    {
+      ui_layout_cache_apply__in_place_rec(child, axis, boxes, child_idx);
+    }
+  }
+}
+
+internal B32
+ui_layout_cache_reuse(UI_Box *root, Axis2 axis)
+{
+  B32 reused = 0;
+  UI_LayoutCacheNode *node = root->layout_reuse[axis];
+  root->layout_reuse[axis] = 0;
+  
+  //- rjf: same size as last build -> all sizes in subtree are the same; they
+  // are taken from the last build, along with positions, when positioning
+  if(root->fixed_size.v[axis] == node->final_size)
+  {
+    root->layout_apply = node;
+    reused = 1;
+  }
+  
+  //- rjf: different size -> the subtree's sizing passes were skipped, so run
+  // them now, with root at its pre-constraint size, before enforcing constraints
+  else
+  {
+    F32 final_size = root->fixed_size.v[axis];
+    root->fixed_size.v[axis] = node->pre_size;
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+    {
+      ui_calc_sizes_standalone__in_place_rec(child, axis);
+    }
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+    {
+      ui_calc_sizes_upwards_dependent__in_place_rec(child, axis);
+    }
+    for(UI_Box *child = root->first; !ui_box_is_nil(child); child = child->next)
+    {
+      ui_calc_sizes_downwards_dependent__in_place_rec(child, axis);
+    }
+    root->fixed_size.v[axis] = final_size;
+  }
+  
+  return reused;
+}
+
+internal UI_LayoutCacheBox *
+ui_layout_cache_record(UI_Box *box, Axis2 axis)
+{
+  UI_LayoutCacheBox *result = 0;
+  UI_LayoutCache *cache = ui_state->layout_record_cache;
+  if(cache != 0 && cache->boxes_count < cache->boxes_cap)
+  {
+    U64 box_idx = cache->boxes_count;
+    cache->boxes_count += 1;
+    result = &cache->boxes[box_idx];
+    result->pre_size       = box->layout_pre_size;
+    result->final_size     = box->fixed_size.v[axis];
+    result->fixed_position = box->fixed_position.v[axis];
+    result->p0             = box->rect.p0.v[axis];
+    result->p1             = box->rect.p1.v[axis];
+    result->view_off       = box->view_off.v[axis];
+    result->view_bounds    = box->view_bounds.v[axis];
+    if(box->layout_cacheable[axis] && box_idx + box->layout_box_count <= cache->boxes_cap)
+    {
+      UI_LayoutCacheNode *node = push_array(ui_build_arena(), UI_LayoutCacheNode, 1);
+      U64 slot_idx = box->key.u64[0] % cache->slots_count;
+      SLLStackPush_N(cache->slots[slot_idx].first, node, hash_next);
+      node->key           = box->key;
+      node->hash          = box->layout_hash[axis];
+      node->box_count     = box->layout_box_count;
+      node->first_box_idx = box_idx;
+      node->pre_size      = box->layout_pre_size;
+      node->final_size    = box->fixed_size.v[axis];
+    }
+  }
+  return result;
+}
+
 internal void
 ui_layout_root(UI_Box *root, Axis2 axis)
 {
   ProfBegin("ui layout pass (%s)", axis == Axis2_X ? "x" : "y");
+  
+  //- rjf: begin recording this build's results, for the next build
+  UI_LayoutCache *cache = push_array(ui_build_arena(), UI_LayoutCache, 1);
+  cache->slots_count = ui_state->build_box_count/UI_LAYOUT_CACHE_MIN_BOX_COUNT + 1;
+  cache->slots = push_array(ui_build_arena(), UI_LayoutCacheSlot, cache->slots_count);
+  cache->boxes_cap = ui_state->build_box_count + 1;
+  cache->boxes = push_array_no_zero(ui_build_arena(), UI_LayoutCacheBox, cache->boxes_cap);
+  ui_state->layout_record_cache = cache;
+  
+  //- rjf: lay out, skipping & reusing retained subtrees
   ui_calc_sizes_standalone__in_place_rec(root, axis);
   ui_calc_sizes_upwards_dependent__in_place_rec(root, axis);
   ui_calc_sizes_downwards_dependent__in_place_rec(root, axis);
   ui_layout_enforce_constraints__in_place_rec(root, axis);
   ui_layout_position__in_place_rec(root, axis);
+  
+  ui_state->layout_record_cache = 0;
+  ui_state->layout_cache[axis] = cache;
   ProfEnd();
 }
 
@@ -2048,6 +2364,20 @@ ui_build_box_from_key(UI_BoxFlags flags, UI_Key key)
   //- rjf: grab active parent
   UI_Box *parent = ui_top_parent();
   
+  //- rjf: retained layout: new child -> parent's last child is done; or, if
+  // parent itself is done, it was re-entered, so its layout hash is stale
+  if(!ui_box_is_nil(parent))
+  {
+    if(parent->layout_hash_done)
+    {
+      ui_layout_hash_invalidate(parent);
+    }
+    else
+    {
+      ui_layout_hash_finish(parent->last);
+    }
+  }
+  
   //- rjf: try to get box
   UI_BoxFlags last_flags = 0;
   UI_Box *box = ui_box_from_key(key);
@@ -2089,6 +2419,14 @@ ui_build_box_from_key(UI_BoxFlags flags, UI_Key key)
     box->hover_cursor = OS_Cursor_Pointer;
     MemoryZeroArray(box->pref_size);
     MemoryZeroStruct(&box->draw_bucket);
+    box->layout_children_hash[Axis2_X] = box->layout_children_hash[Axis2_Y] = 5381;
+    MemoryZeroArray(box->layout_children_open);
+    MemoryZeroArray(box->layout_cacheable);
+    MemoryZeroArray(box->layout_reuse);
+    box->layout_box_count = 1;
+    box->layout_hash_done = 0;
+    box->layout_hash_invalid = 0;
+    box->layout_apply = 0;
   }
   
   //- rjf: hook into persistent state table
@@ -2265,6 +2603,49 @@ ui_build_box_from_stringf(UI_BoxFlags flags, char *fmt, ...)
 
 //- rjf: box node equipment
 
+internal void
+ui_box_equip_display_string_runs_from_fancy_strings(UI_Box *box, F32 tab_size, String8 string, D_FancyStringList *strings)
+{
+  ProfBeginFunction();
+  
+  //- rjf: fill in missing piece hashes - reuse the last build's if the string &
+  // its pieces are unchanged, so static text isn't rehashed every build
+  B32 string_is_unchanged = (box->hashed_display_string_build_index+1 >= ui_state->build_index &&
+                             box->hashed_display_string_piece_count == strings->node_count &&
+                             box->hashed_display_string.size == string.size &&
+                             MemoryMatch(box->hashed_display_string.str, string.str, string.size));
+  U64 *piece_sizes = push_array_no_zero(ui_build_arena(), U64, strings->node_count);
+  U64 *piece_hashes = push_array_no_zero(ui_build_arena(), U64, strings->node_count);
+  {
+    U64 idx = 0;
+    for(D_FancyStringNode *n = strings->first; n != 0; n = n->next, idx += 1)
+    {
+      if(n->v.string_hash == 0)
+      {
+        B32 piece_is_unchanged = (string_is_unchanged && box->hashed_display_string_piece_sizes[idx] == n->v.string.size);
+        n->v.string_hash = piece_is_unchanged ? box->hashed_display_string_piece_hashes[idx] : f_run_cache_hash_from_string(n->v.string);
+      }
+      piece_sizes[idx] = n->v.string.size;
+      piece_hashes[idx] = n->v.string_hash;
+    }
+  }
+  box->hashed_display_string = string;
+  box->hashed_display_string_build_index = ui_state->build_index;
+  box->hashed_display_string_piece_count = strings->node_count;
+  box->hashed_display_string_piece_sizes = piece_sizes;
+  box->hashed_display_string_piece_hashes = piece_hashes;
+  
+  //- rjf: build runs - their size is a layout input, so if box's layout hash
+  // was already finished, it is stale
+  box->display_string_runs = d_fancy_run_list_from_fancy_string_list(ui_build_arena(), tab_size, strings);
+  if(box->layout_hash_done)
+  {
+    ui_layout_hash_invalidate(box);
+  }
+  
+  ProfEnd();
+}
+
 internal void
 ui_box_equip_display_string(UI_Box *box, String8 string)
 {
@@ -2276,7 +2657,7 @@ ui_box_equip_display_string(UI_Box *box, String8 string)
     String8 display_string = ui_box_display_string(box);
     D_FancyStringNode fancy_string_n = {0, {box->font, display_string, box->text_color, box->font_size, 0, 0}};
     D_FancyStringList fancy_strings = {&fancy_string_n, &fancy_string_n, 1};
-    box->display_string_runs = d_fancy_run_list_from_fancy_string_list(ui_build_arena(), box->tab_size, &fancy_strings);
+    ui_box_equip_display_string_runs_from_fancy_strings(box, box->tab_size, display_string, &fancy_strings);
   }
   else if(box->flags & UI_BoxFlag_DrawText && box->flags & UI_BoxFlag_DrawTextFastpathCodepoint && box->fastpath_codepoint != 0)
   {
@@ -2291,13 +2672,13 @@ ui_box_equip_display_string(UI_Box *box, String8 string)
       D_FancyStringNode cdp_fancy_string_n = {&pst_fancy_string_n, {box->font, str8_substr(display_string, r1u64(fpcp_pos, fpcp_pos+fpcp.size)), box->text_color, box->font_size, 4.f, 0}};
       D_FancyStringNode pre_fancy_string_n = {&cdp_fancy_string_n, {box->font, str8_prefix(display_string, fpcp_pos), box->text_color, box->font_size, 0, 0}};
       D_FancyStringList fancy_strings = {&pre_fancy_string_n, &pst_fancy_string_n, 3};
-      box->display_string_runs = d_fancy_run_list_from_fancy_string_list(ui_build_arena(), box->tab_size, &fancy_strings);
+      ui_box_equip_display_string_runs_from_fancy_strings(box, box->tab_size, display_string, &fancy_strings);
     }
     else
     {
       D_FancyStringNode fancy_string_n = {0, {box->font, display_string, box->text_color, box->font_size, 0, 0}};
       D_FancyStringList fancy_strings = {&fancy_string_n, &fancy_string_n, 1};
-      box->display_string_runs = d_fancy_run_list_from_fancy_string_list(ui_build_arena(), box->tab_size, &fancy_strings);
+      ui_box_equip_display_string_runs_from_fancy_strings(box, box->tab_size, display_string, &fancy_strings);
     }
     scratch_end(scratch);
   }
@@ -2309,7 +2690,7 @@ ui_box_equip_display_fancy_strings(UI_Box *box, F32 tab_size, D_FancyStringList
 {
   box->flags |= UI_BoxFlag_HasDisplayString;
   box->string = d_string_from_fancy_string_list(ui_build_arena(), strings);
-  box->display_string_runs = d_fancy_run_list_from_fancy_string_list(ui_build_arena(), tab_size, strings);
+  ui_box_equip_display_string_runs_from_fancy_strings(box, tab_size, box->string, strings);
 }
 
 internal inline void
@@ -2318,6 +2699,10 @@ ui_box_equip_display_string_fancy_runs(UI_Box *box, String8 string, D_FancyRunLi
   box->flags |= UI_BoxFlag_HasDisplayString;
   box->string = push_str8_copy(ui_build_arena(), string);
   box->display_string_runs = d_fancy_run_list_copy(ui_build_arena(), runs);
+  if(box->layout_hash_done)
+  {
+    ui_layout_hash_invalidate(box);
+  }
 }
 
 internal inline void
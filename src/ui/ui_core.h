@@ -216,6 +216,58 @@ union UI_ScrollPt2
   };
 };
 
+////////////////////////////////
+//~ rjf: Retained Layout Types
+//
+// Each build records, per axis, the sizes & positions it resolved for every
+// box, plus a node for each large keyed subtree which does not depend on sizes
+// outside of it. The next build reuses a node's results for a subtree whose
+// layout inputs hash the same, so long as the subtree's root is given the same
+// size. Positions are reused relative to the subtree's root, for boxes whose
+// view offset & floating children are unchanged.
+
+#define UI_LAYOUT_CACHE_MIN_BOX_COUNT 16
+
+typedef struct UI_LayoutCacheBox UI_LayoutCacheBox;
+struct UI_LayoutCacheBox
+{
+  F32 pre_size;
+  F32 final_size;
+  F32 fixed_position;
+  F32 p0;
+  F32 p1;
+  F32 view_off;
+  F32 view_bounds;
+};
+
+typedef struct UI_LayoutCacheNode UI_LayoutCacheNode;
+struct UI_LayoutCacheNode
+{
+  UI_LayoutCacheNode *hash_next;
+  UI_Key key;
+  U64 hash;
+  U64 box_count;
+  U64 first_box_idx;
+  F32 pre_size;
+  F32 final_size;
+};
+
+typedef struct UI_LayoutCacheSlot UI_LayoutCacheSlot;
+struct UI_LayoutCacheSlot
+{
+  UI_LayoutCacheNode *first;
+};
+
+typedef struct UI_LayoutCache UI_LayoutCache;
+struct UI_LayoutCache
+{
+  U64 slots_count;
+  UI_LayoutCacheSlot *slots;
+  U64 boxes_count;
+  U64 boxes_cap;
+  UI_LayoutCacheBox *boxes;
+};
+
 ////////////////////////////////
 //~ rjf: Box Types
 
@@ -350,6 +402,18 @@ struct UI_Box
   Vec2F32 position_delta;
   FuzzyMatchRangeList fuzzy_match_ranges;
   
+  //- rjf: per-build retained layout info
+  U64 layout_hash[Axis2_COUNT];
+  U64 layout_children_hash[Axis2_COUNT];
+  B32 layout_children_open[Axis2_COUNT];
+  B32 layout_cacheable[Axis2_COUNT];
+  U64 layout_box_count;
+  B32 layout_hash_done;
+  B32 layout_hash_invalid;
+  F32 layout_pre_size;
+  UI_LayoutCacheNode *layout_reuse[Axis2_COUNT];
+  UI_LayoutCacheNode *layout_apply;
+  
   //- rjf: persistent data
   U64 first_touched_build_index;
   U64 last_touched_build_index;
@@ -367,6 +431,14 @@ struct UI_Box
   UI_Key default_nav_focus_active_key;
   UI_Key default_nav_focus_next_hot_key;
   UI_Key default_nav_focus_next_active_key;
+  
+  //- rjf: retained display string piece hashes - reused while the string is
+  // unchanged (it is only kept alive for one build afterwards)
+  String8 hashed_display_string;
+  U64 hashed_display_string_build_index;
+  U64 hashed_display_string_piece_count;
+  U64 *hashed_display_string_piece_sizes;
+  U64 *hashed_display_string_piece_hashes;
 };
 
 typedef struct UI_BoxRec UI_BoxRec;
@@ -519,6 +591,14 @@ struct UI_State
   UI_Key default_nav_root_key;
   U64 build_box_count;
   U64 last_build_box_count;
+  U64 last_build_layout_us;
+  U64 last_build_layout_reused_box_count[Axis2_COUNT];
+  
+  //- rjf: retained layout caches (allocated in build arenas; last = previous build's)
+  UI_LayoutCache *layout_cache[Axis2_COUNT];
+  UI_LayoutCache *last_layout_cache[Axis2_COUNT];
+  UI_LayoutCache *layout_record_cache;
+  U64 layout_reused_box_count[Axis2_COUNT];
   B32 ctx_menu_touched_this_frame;
   B32 is_animating;
   
@@ -691,6 +771,12 @@ internal void ui_calc_sizes_upwards_dependent__in_place_rec(UI_Box *root, Axis2
 internal void ui_calc_sizes_downwards_dependent__in_place_rec(UI_Box *root, Axis2 axis);
 internal void ui_layout_enforce_constraints__in_place_rec(UI_Box *root, Axis2 axis);
 internal void ui_layout_position__in_place_rec(UI_Box *root, Axis2 axis);
+internal void ui_layout_hash_finish(UI_Box *box);
+internal void ui_layout_hash_invalidate(UI_Box *box);
+internal void ui_layout_cache_apply_sizes__in_place_rec(UI_Box *root, Axis2 axis, UI_LayoutCacheBox *boxes, U64 *box_idx);
+internal void ui_layout_cache_apply__in_place_rec(UI_Box *root, Axis2 axis, UI_LayoutCacheBox *boxes, U64 box_idx);
+internal B32  ui_layout_cache_reuse(UI_Box *root, Axis2 axis);
+internal UI_LayoutCacheBox *ui_layout_cache_record(UI_Box *box, Axis2 axis);
 internal void ui_layout_root(UI_Box *root, Axis2 axis);
 
 ////////////////////////////////
@@ -727,6 +813,7 @@ internal UI_Box *          ui_build_box_from_string(UI_BoxFlags flags, String8 s
 internal UI_Box *          ui_build_box_from_stringf(UI_BoxFlags flags, char *fmt, ...);
 
 //- rjf: box node equipment
+internal void              ui_box_equip_display_string_runs_from_fancy_strings(UI_Box *box, F32 tab_size, String8 string, D_FancyStringList *strings);
 internal inline void       ui_box_equip_display_string(UI_Box *box, String8 string);
 internal inline void       ui_box_equip_display_fancy_strings(UI_Box *box, F32 tab_size, D_FancyStringList *strings);
 internal inline void       ui_box_equip_display_string_fancy_runs(UI_Box *box, String8 string, D_FancyRunList *runs);
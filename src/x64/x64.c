@@ -0,0 +1,456 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Opcode Tables
+
+#define M_   X64_OpFlag_ModRM
+#define DRM  (X64_OpFlag_ModRM|X64_OpFlag_DstRM|X64_OpFlag_Src)
+#define DRG  (X64_OpFlag_ModRM|X64_OpFlag_DstReg|X64_OpFlag_Src)
+#define DOR  (X64_OpFlag_DstOpReg|X64_OpFlag_Src)
+#define GRP  (X64_OpFlag_ModRM|X64_OpFlag_Group)
+#define PSH  X64_OpFlag_Push
+#define POP  X64_OpFlag_Pop
+#define STR  X64_OpFlag_String
+#define D64  X64_OpFlag_Def64
+#define INV  X64_OpFlag_Invalid
+#define IB   X64_ImmKind_B
+#define IW   X64_ImmKind_W
+#define IZ   X64_ImmKind_Z
+#define IV   X64_ImmKind_V
+#define IWB  X64_ImmKind_WB
+#define MOF  X64_ImmKind_MOff
+#define JB   X64_ImmKind_RelB
+#define JZ   X64_ImmKind_RelZ
+#define CAL  X64_FlowKind_Call
+#define BRA  X64_FlowKind_Branch
+#define JMP  X64_FlowKind_Jump
+#define RET  X64_FlowKind_Return
+
+// NOTE: one-byte opcode map, in 64-bit mode. prefixes, REX, & VEX/EVEX/XOP
+// escapes are consumed before this table is consulted, so their entries are
+// empty.
+read_only global X64_OpInfo x64_op_table_1b[256] =
+{
+  /* 00 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {INV}, {INV},
+  /* 08 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {INV}, {0},
+  /* 10 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {INV}, {INV},
+  /* 18 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {INV}, {INV},
+  /* 20 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {0}, {INV},
+  /* 28 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {0}, {INV},
+  /* 30 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {0}, {INV},
+  /* 38 */ {M_}, {DRM}, {M_}, {DRG}, {0,IB}, {0,IZ}, {0}, {INV},
+  /* 40 */ {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0},
+  /* 48 */ {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0},
+  /* 50 */ {PSH|D64}, {PSH|D64}, {PSH|D64}, {PSH|D64}, {PSH|D64}, {PSH|D64}, {PSH|D64}, {PSH|D64},
+  /* 58 */ {POP|D64}, {POP|D64}, {POP|D64}, {POP|D64}, {POP|D64}, {POP|D64}, {POP|D64}, {POP|D64},
+  /* 60 */ {INV}, {INV}, {0}, {DRG|X64_OpFlag_Dst64}, {0}, {0}, {0}, {0},
+  /* 68 */ {PSH|D64,IZ}, {DRG,IZ}, {PSH|D64,IB}, {DRG,IB}, {STR}, {STR}, {STR}, {STR},
+  /* 70 */ {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA},
+  /* 78 */ {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA},
+  /* 80 */ {M_,IB}, {DRM|GRP,IZ}, {INV}, {DRM|GRP,IB}, {M_}, {DRM}, {M_}, {DRM},
+  /* 88 */ {M_}, {DRM}, {M_}, {DRG}, {DRM}, {DRG}, {M_}, {GRP},
+  /* 90 */ {DOR}, {DOR}, {DOR}, {DOR}, {DOR}, {DOR}, {DOR}, {DOR},
+  /* 98 */ {0}, {0}, {INV}, {0}, {0}, {0}, {0}, {0},
+  /* A0 */ {0,MOF}, {0,MOF}, {0,MOF}, {0,MOF}, {STR}, {STR}, {STR}, {STR},
+  /* A8 */ {0,IB}, {0,IZ}, {STR}, {STR}, {STR}, {STR}, {STR}, {STR},
+  /* B0 */ {0,IB}, {0,IB}, {0,IB}, {0,IB}, {0,IB}, {0,IB}, {0,IB}, {0,IB},
+  /* B8 */ {DOR,IV}, {DOR,IV}, {DOR,IV}, {DOR,IV}, {DOR,IV}, {DOR,IV}, {DOR,IV}, {DOR,IV},
+  /* C0 */ {M_,IB}, {DRM,IB}, {0,IW,RET}, {0,0,RET}, {0}, {0}, {M_,IB}, {DRM,IZ},
+  /* C8 */ {0,IWB}, {0}, {0,IW,RET}, {0,0,RET}, {0}, {0,IB}, {INV}, {0},
+  /* D0 */ {M_}, {DRM}, {M_}, {DRM}, {INV}, {INV}, {INV}, {0},
+  /* D8 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* E0 */ {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,JB,BRA}, {0,IB}, {0,IB}, {0,IB}, {0,IB},
+  /* E8 */ {D64,JZ,CAL}, {D64,JZ,JMP}, {INV}, {D64,JB,JMP}, {0}, {0}, {0}, {0},
+  /* F0 */ {0}, {0}, {0}, {0}, {0}, {0}, {GRP}, {GRP},
+  /* F8 */ {0}, {0}, {0}, {0}, {0}, {0}, {M_}, {GRP},
+};
+
+// NOTE: two-byte (0F xx) opcode map. 0F 38 & 0F 3A are uniform (always
+// modrm; 0F 3A always has an 8-bit immediate), so they do not have tables.
+read_only global X64_OpInfo x64_op_table_0f[256] =
+{
+  /* 00 */ {M_}, {M_}, {DRG}, {DRG}, {INV}, {0}, {0}, {0},
+  /* 08 */ {0}, {0}, {INV}, {0}, {INV}, {M_}, {0}, {M_,IB},
+  /* 10 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 18 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 20 */ {DRM|X64_OpFlag_Dst64}, {DRM|X64_OpFlag_Dst64}, {M_}, {M_}, {INV}, {INV}, {INV}, {INV},
+  /* 28 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 30 */ {0}, {0}, {0}, {0}, {0}, {0}, {INV}, {0},
+  /* 38 */ {0}, {INV}, {0}, {INV}, {INV}, {INV}, {INV}, {INV},
+  /* 40 */ {DRG}, {DRG}, {DRG}, {DRG}, {DRG}, {DRG}, {DRG}, {DRG},
+  /* 48 */ {DRG}, {DRG}, {DRG}, {DRG}, {DRG}, {DRG}, {DRG}, {DRG},
+  /* 50 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 58 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 60 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 68 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 70 */ {M_,IB}, {M_,IB}, {M_,IB}, {M_,IB}, {M_}, {M_}, {M_}, {0},
+  /* 78 */ {M_}, {M_}, {INV}, {INV}, {M_}, {M_}, {M_}, {M_},
+  /* 80 */ {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA},
+  /* 88 */ {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA}, {D64,JZ,BRA},
+  /* 90 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* 98 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* A0 */ {PSH|D64}, {POP|D64}, {0}, {DRM}, {DRM,IB}, {DRM}, {INV}, {INV},
+  /* A8 */ {PSH|D64}, {POP|D64}, {0}, {DRM}, {DRM,IB}, {DRM}, {M_}, {DRG},
+  /* B0 */ {M_}, {DRM}, {M_}, {DRM}, {M_}, {M_}, {DRG}, {DRG},
+  /* B8 */ {DRG}, {M_}, {DRM,IB}, {DRM}, {DRG}, {DRG}, {DRG}, {DRG},
+  /* C0 */ {M_}, {DRM}, {M_,IB}, {M_}, {M_,IB}, {M_,IB}, {M_,IB}, {M_},
+  /* C8 */ {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0},
+  /* D0 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* D8 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* E0 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* E8 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* F0 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+  /* F8 */ {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_}, {M_},
+};
+
+#undef M_
+#undef DRM
+#undef DRG
+#undef DOR
+#undef GRP
+#undef PSH
+#undef POP
+#undef STR
+#undef D64
+#undef INV
+#undef IB
+#undef IW
+#undef IZ
+#undef IV
+#undef IWB
+#undef MOF
+#undef JB
+#undef JZ
+#undef CAL
+#undef BRA
+#undef JMP
+#undef RET
+
+////////////////////////////////
+//~ rjf: Decoding Functions
+
+internal X64_Inst
+x64_inst_from_machine_code(U64 start_voff, String8 code)
+{
+  X64_Inst inst = {0};
+  U64 max_size = Min(code.size, 15);
+  U64 off = 0;
+  B32 good = (max_size != 0);
+  
+  //- rjf: legacy prefixes & REX (REX is only in effect if it is the last prefix)
+  B32 pfx_opr = 0;
+  B32 pfx_adr = 0;
+  U8 pfx_str = 0;
+  U8 rex = 0;
+  for(;off < max_size; off += 1)
+  {
+    U8 byte = code.str[off];
+    B32 is_prefix = 1;
+    switch(byte)
+    {
+      default:
+      {
+        is_prefix = ((byte & 0xf0) == 0x40);
+      }break;
+      case 0x26: case 0x2e: case 0x36: case 0x3e: case 0x64: case 0x65: case 0xf0:{}break;
+      case 0x66:{pfx_opr = 1;}break;
+      case 0x67:{pfx_adr = 1;}break;
+      case 0xf2: case 0xf3:{pfx_str = byte;}break;
+    }
+    if(!is_prefix)
+    {
+      break;
+    }
+    rex = ((byte & 0xf0) == 0x40) ? byte : 0;
+  }
+  good = good && (off < max_size);
+  
+  //- rjf: opcode => opcode info
+  X64_OpInfo op = {0};
+  U8 opcode = 0;
+  B32 opcode_is_1b = 0;
+  B32 vex_w = 0;
+  if(good)
+  {
+    U8 byte = code.str[off];
+    off += 1;
+    B32 byte1_is_available = (off < max_size);
+    U8 byte1 = byte1_is_available ? code.str[off] : 0;
+    
+    // rjf: VEX (c4/c5), EVEX (62), & XOP (8f, if not `pop`) - prefix bytes,
+    // then an opcode in one of a handful of maps
+    U64 map = 0;
+    U64 map_prefix_size = 0;
+    if(byte == 0xc5)
+    {
+      map = 1;
+      map_prefix_size = 2;
+    }
+    else if(byte == 0xc4)
+    {
+      map = byte1 & 0x1f;
+      map_prefix_size = 3;
+      vex_w = (off+1 < max_size) && (code.str[off+1] & 0x80);
+      good = good && (1 <= map && map <= 3);
+    }
+    else if(byte == 0x62)
+    {
+      map = byte1 & 0x7;
+      map_prefix_size = 4;
+      vex_w = (off+1 < max_size) && (code.str[off+1] & 0x80);
+      good = good && (map == 1 || map == 2 || map == 3 || map == 5 || map == 6);
+    }
+    else if(byte == 0x8f && (byte1 & 0x1f) >= 8)
+    {
+      map = byte1 & 0x1f;
+      map_prefix_size = 3;
+      good = good && (8 <= map && map <= 10);
+    }
+    if(map_prefix_size != 0)
+    {
+      off += map_prefix_size-1;
+      good = good && (off < max_size);
+      opcode = good ? code.str[off] : 0;
+      off += 1;
+      switch(map)
+      {
+        default:{op.flags = X64_OpFlag_ModRM;}break;
+        case 1:
+        {
+          op = x64_op_table_0f[opcode];
+          op.flags &= ~(X64_OpFlag_DstRM|X64_OpFlag_DstReg|X64_OpFlag_Src|X64_OpFlag_Push|X64_OpFlag_Pop);
+          op.flags |= (opcode != 0x77) ? X64_OpFlag_ModRM : 0; // vzeroupper/vzeroall
+          op.flow_kind = X64_FlowKind_None;
+          if(op.imm_kind != X64_ImmKind_B)
+          {
+            op.imm_kind = X64_ImmKind_None;
+          }
+        }break;
+        case 3:
+        case 8:{op.flags = X64_OpFlag_ModRM; op.imm_kind = X64_ImmKind_B;}break;
+        case 10:{op.flags = X64_OpFlag_ModRM; op.imm_kind = X64_ImmKind_Z;}break;
+      }
+    }
+    
+    // rjf: two/three-byte legacy maps
+    else if(byte == 0x0f)
+    {
+      good = good && byte1_is_available;
+      opcode = byte1;
+      off += 1;
+      if(opcode == 0x38 || opcode == 0x3a)
+      {
+        good = good && (off < max_size);
+        U8 opcode2 = good ? code.str[off] : 0;
+        off += 1;
+        op.flags = X64_OpFlag_ModRM;
+        op.imm_kind = (opcode == 0x3a) ? X64_ImmKind_B : X64_ImmKind_None;
+        
+        // rjf: movbe/crc32 Gv, Ev
+        if(opcode == 0x38 && (opcode2 == 0xf0 || (opcode2 == 0xf1 && pfx_str == 0xf2)))
+        {
+          op.flags |= X64_OpFlag_DstReg|X64_OpFlag_Src;
+        }
+      }
+      else
+      {
+        op = x64_op_table_0f[opcode];
+        
+        // rjf: SSE4a extrq/insertq take two 8-bit immediates
+        if(opcode == 0x78 && (pfx_opr || pfx_str == 0xf2))
+        {
+          op.imm_kind = X64_ImmKind_W;
+        }
+      }
+    }
+    
+    // rjf: one-byte map
+    else
+    {
+      opcode = byte;
+      opcode_is_1b = 1;
+      op = x64_op_table_1b[opcode];
+    }
+  }
+  good = good && !(op.flags & X64_OpFlag_Invalid);
+  
+  //- rjf: modrm, sib, displacement
+  U8 modrm = 0;
+  if(good && op.flags & X64_OpFlag_ModRM)
+  {
+    good = (off < max_size);
+    modrm = good ? code.str[off] : 0;
+    off += 1;
+    U8 mod = (modrm >> 6);
+    U8 rm  = (modrm & 0x7);
+    U64 disp_size = 0;
+    if(mod != 3)
+    {
+      if(rm == 4)
+      {
+        good = good && (off < max_size);
+        U8 sib = good ? code.str[off] : 0;
+        off += 1;
+        if(mod == 0 && (sib & 0x7) == 5)
+        {
+          disp_size = 4;
+        }
+      }
+      if(mod == 0 && rm == 5) { disp_size = 4; }
+      if(mod == 1)            { disp_size = 1; }
+      if(mod == 2)            { disp_size = 4; }
+    }
+    off += disp_size;
+  }
+  U8 modrm_reg = (modrm >> 3) & 0x7;
+  
+  //- rjf: resolve groups, whose meanings depend on modrm.reg
+  if(good && opcode_is_1b && op.flags & X64_OpFlag_Group)
+  {
+    switch(opcode)
+    {
+      default:{}break;
+      case 0x8f:
+      {
+        good = (modrm_reg == 0);
+        op.flags |= X64_OpFlag_Pop;
+      }break;
+      case 0xf6:
+      case 0xf7:
+      {
+        if(modrm_reg <= 1)
+        {
+          op.imm_kind = (opcode == 0xf6) ? X64_ImmKind_B : X64_ImmKind_Z;
+          op.flags |= (opcode == 0xf7) ? (X64_OpFlag_DstRM|X64_OpFlag_Src) : 0;
+        }
+      }break;
+      case 0xff:
+      {
+        B32 is_far = (modrm_reg == 3 || modrm_reg == 5);
+        good = (modrm_reg != 7) && !(is_far && (modrm >> 6) == 3);
+        switch(modrm_reg)
+        {
+          default:{}break;
+          case 2: case 3:{op.flow_kind = X64_FlowKind_Call;}break;
+          case 4: case 5:{op.flow_kind = X64_FlowKind_Jump;}break;
+          case 6:{op.flags |= X64_OpFlag_Push;}break;
+        }
+      }break;
+    }
+  }
+  
+  //- rjf: immediate
+  B32 opr_size_64 = (vex_w || (rex & 0x8));
+  B32 opr_size_16 = (pfx_opr && !opr_size_64);
+  U64 imm_size = 0;
+  switch(op.imm_kind)
+  {
+    default:{}break;
+    case X64_ImmKind_B:    {imm_size = 1;}break;
+    case X64_ImmKind_W:    {imm_size = 2;}break;
+    case X64_ImmKind_WB:   {imm_size = 3;}break;
+    case X64_ImmKind_Z:    {imm_size = opr_size_16 ? 2 : 4;}break;
+    case X64_ImmKind_V:    {imm_size = opr_size_64 ? 8 : opr_size_16 ? 2 : 4;}break;
+    case X64_ImmKind_MOff: {imm_size = pfx_adr ? 4 : 8;}break;
+    case X64_ImmKind_RelB: {imm_size = 1;}break;
+    case X64_ImmKind_RelZ: {imm_size = opr_size_16 ? 2 : 4;}break;
+  }
+  U64 imm_off = off;
+  off += imm_size;
+  good = good && (off <= max_size);
+  S64 imm = 0;
+  if(good)
+  {
+    switch(imm_size)
+    {
+      default:{}break;
+      case 1:{imm = (S64)*(S8 *)(code.str+imm_off);}break;
+      case 2:{S16 v = 0; MemoryCopy(&v, code.str+imm_off, sizeof(v)); imm = (S64)v;}break;
+      case 4:{S32 v = 0; MemoryCopy(&v, code.str+imm_off, sizeof(v)); imm = (S64)v;}break;
+      case 8:{S64 v = 0; MemoryCopy(&v, code.str+imm_off, sizeof(v)); imm = v;}break;
+    }
+  }
+  
+  //- rjf: invalid/truncated -> single-byte non-flow instruction, so that
+  // linear sweeps always make progress
+  if(!good)
+  {
+    inst.flags = X64_InstFlag_NonFlow|X64_InstFlag_Invalid;
+    inst.size = (code.size != 0);
+    return inst;
+  }
+  inst.size = off;
+  
+  //- rjf: control flow
+  switch(op.flow_kind)
+  {
+    default:{inst.flags |= X64_InstFlag_NonFlow;}break;
+    case X64_FlowKind_Call:  {inst.flags |= X64_InstFlag_Call;}break;
+    case X64_FlowKind_Branch:{inst.flags |= X64_InstFlag_Branch;}break;
+    case X64_FlowKind_Jump:  {inst.flags |= X64_InstFlag_UnconditionalJump;}break;
+    case X64_FlowKind_Return:{inst.flags |= X64_InstFlag_Return;}break;
+  }
+  
+  //- rjf: relative branch targets, truncated to the operand size
+  if(op.imm_kind == X64_ImmKind_RelB || op.imm_kind == X64_ImmKind_RelZ)
+  {
+    U64 target = start_voff + inst.size + (U64)imm;
+    U64 opr_size_bits = opr_size_64 ? 64 : opr_size_16 ? 16 : (op.flags & X64_OpFlag_Def64) ? 64 : 32;
+    U64 mask = max_U64 >> (64 - opr_size_bits);
+    inst.rel_voff = target & mask;
+  }
+  
+  //- rjf: repeated string instructions
+  if(pfx_str != 0 && op.flags & X64_OpFlag_String)
+  {
+    inst.flags |= X64_InstFlag_Repeats;
+  }
+  
+  //- rjf: stack pointer changes
+  if(op.flags & X64_OpFlag_Push)
+  {
+    inst.flags |= X64_InstFlag_ChangesStackPointer;
+    inst.sp_delta = -8;
+  }
+  else if(op.flags & X64_OpFlag_Pop)
+  {
+    inst.flags |= X64_InstFlag_ChangesStackPointer;
+    inst.sp_delta = +8;
+  }
+  else if(op.flags & X64_OpFlag_Src && (opr_size_64 || op.flags & X64_OpFlag_Dst64))
+  {
+    B32 dst_is_rsp = 0;
+    if(op.flags & X64_OpFlag_DstRM)
+    {
+      dst_is_rsp = ((modrm >> 6) == 3 && (modrm & 0x7) == 4 && !(rex & 0x1));
+    }
+    else if(op.flags & X64_OpFlag_DstReg)
+    {
+      dst_is_rsp = (modrm_reg == 4 && !(rex & 0x4));
+    }
+    else if(op.flags & X64_OpFlag_DstOpReg)
+    {
+      dst_is_rsp = ((opcode & 0x7) == 4 && !(rex & 0x1));
+    }
+    if(dst_is_rsp)
+    {
+      B32 is_add_sub_imm = (opcode_is_1b && (opcode == 0x81 || opcode == 0x83));
+      inst.flags |= X64_InstFlag_ChangesStackPointer;
+      if(is_add_sub_imm && modrm_reg == 0)
+      {
+        inst.sp_delta = +imm;
+      }
+      else if(is_add_sub_imm && modrm_reg == 5)
+      {
+        inst.sp_delta = -imm;
+      }
+      else
+      {
+        inst.flags |= X64_InstFlag_ChangesStackPointerVariably;
+      }
+    }
+  }
+  
+  return inst;
+}
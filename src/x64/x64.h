@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef X64_H
+#define X64_H
+
+// NOTE: This is not a disassembler. It only decodes the facts about an
+// x64 instruction which stepping & control flow analysis need - its length,
+// whether & how it transfers control, its relative branch target, and its
+// effect on the stack pointer. It is table-driven & does not allocate, so it
+// is suitable for running over every instruction of a line. Textual
+// disassembly is still produced by udis86, in the dasm_cache layer.
+
+////////////////////////////////
+//~ rjf: Decoded Instruction Types
+
+typedef U32 X64_InstFlags;
+enum
+{
+  X64_InstFlag_Call                        = (1<<0),
+  X64_InstFlag_Branch                      = (1<<1),
+  X64_InstFlag_UnconditionalJump           = (1<<2),
+  X64_InstFlag_Return                      = (1<<3),
+  X64_InstFlag_NonFlow                     = (1<<4),
+  X64_InstFlag_Repeats                     = (1<<5),
+  X64_InstFlag_ChangesStackPointer         = (1<<6),
+  X64_InstFlag_ChangesStackPointerVariably = (1<<7),
+  X64_InstFlag_Invalid                     = (1<<8),
+};
+
+typedef struct X64_Inst X64_Inst;
+struct X64_Inst
+{
+  X64_InstFlags flags;
+  U64 size;
+  U64 rel_voff;
+  S64 sp_delta;
+};
+
+////////////////////////////////
+//~ rjf: Opcode Table Types
+
+typedef U16 X64_OpFlags;
+enum
+{
+  X64_OpFlag_ModRM     = (1<<0),
+  X64_OpFlag_DstRM     = (1<<1),  // first operand is a gpr in modrm.rm
+  X64_OpFlag_DstReg    = (1<<2),  // first operand is a gpr in modrm.reg
+  X64_OpFlag_DstOpReg  = (1<<3),  // first operand is a gpr in the opcode's low 3 bits
+  X64_OpFlag_Src       = (1<<4),  // has a second (source) operand
+  X64_OpFlag_Dst64     = (1<<5),  // destination gpr is 64-bit, regardless of REX.W
+  X64_OpFlag_Def64     = (1<<6),  // operand size defaults to 64-bit
+  X64_OpFlag_Push      = (1<<7),
+  X64_OpFlag_Pop       = (1<<8),
+  X64_OpFlag_String    = (1<<9),
+  X64_OpFlag_Group     = (1<<10), // meaning depends on modrm.reg
+  X64_OpFlag_Invalid   = (1<<11),
+};
+
+typedef U8 X64_ImmKind;
+enum
+{
+  X64_ImmKind_None,
+  X64_ImmKind_B,      // 1 byte
+  X64_ImmKind_W,      // 2 bytes
+  X64_ImmKind_Z,      // 2 or 4 bytes, by operand size
+  X64_ImmKind_V,      // 2, 4, or 8 bytes, by operand size
+  X64_ImmKind_WB,     // 2 bytes + 1 byte (enter)
+  X64_ImmKind_MOff,   // 4 or 8 bytes, by address size
+  X64_ImmKind_RelB,   // 1 byte relative displacement
+  X64_ImmKind_RelZ,   // 2 or 4 byte relative displacement, by operand size
+  X64_ImmKind_COUNT
+};
+
+typedef U8 X64_FlowKind;
+enum
+{
+  X64_FlowKind_None,
+  X64_FlowKind_Call,
+  X64_FlowKind_Branch,
+  X64_FlowKind_Jump,
+  X64_FlowKind_Return,
+  X64_FlowKind_COUNT
+};
+
+typedef struct X64_OpInfo X64_OpInfo;
+struct X64_OpInfo
+{
+  X64_OpFlags flags;
+  X64_ImmKind imm_kind;
+  X64_FlowKind flow_kind;
+};
+
+////////////////////////////////
+//~ rjf: Decoding Functions
+
+internal X64_Inst x64_inst_from_machine_code(U64 start_voff, String8 code);
+
+#endif // X64_H